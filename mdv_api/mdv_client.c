@@ -14,10 +14,18 @@
 #include <mdv_serialization.h>
 #include <mdv_router.h>
 #include <mdv_safeptr.h>
+#include <mdv_condvar.h>
+#include <mdv_list.h>
+#include <mdv_time.h>
 #include <signal.h>
+#include <stdatomic.h>
 
 
-enum { MDV_FETCH_SIZE = 64 };       // limit for rows fetching
+enum { MDV_FETCH_SIZE = 64 };       // initial limit for rows fetching
+enum { MDV_FETCH_SIZE_MAX = 64 * 1024 };    // maximum limit for rows fetching
+enum { MDV_STREAM_WAIT = 10 };      // rows batches waiting interval (in milliseconds)
+enum { MDV_BULK_CHUNK = 1024 * 1024 };      // bulk loading chunk size (in bytes)
+enum { MDV_BULK_WINDOW = 8 };       // maximum number of unacknowledged bulk loading chunks
 
 
 bool mdv_initialize()
@@ -42,6 +50,10 @@ struct mdv_client
     mdv_chaman         *chaman;             ///< Channels manager
     mdv_safeptr        *connection;         ///< Connection context
     uint32_t            response_timeout;   ///< Temeout for responses (in milliseconds)
+    uint32_t            fetch_window;       ///< Number of rows batches server pushes ahead of reading
+    uint32_t            fetch_bytes;        ///< Rows batch size limit (in bytes)
+    atomic_uint_fast32_t requests;          ///< Number of asynchronous requests in flight
+    mdv_condvar         requests_cv;        ///< Asynchronous requests completion notification
 };
 
 
@@ -75,6 +87,34 @@ static mdv_errno mdv_client_send(mdv_client *client, mdv_msg *req, mdv_msg *resp
 }
 
 
+/// Asynchronous request completion notification
+static void mdv_client_async_done(mdv_client *client)
+{
+    if (atomic_fetch_sub_explicit(&client->requests, 1, memory_order_release) == 1)
+        mdv_condvar_signal(&client->requests_cv);
+}
+
+
+static mdv_errno mdv_client_send_async(mdv_client *client, mdv_msg *req, mdv_dispatcher_response_fn fn, void *arg)
+{
+    mdv_connection *con = mdv_client_channel_retain(client);
+
+    if (!con)
+        return MDV_FAILED;
+
+    atomic_fetch_add_explicit(&client->requests, 1, memory_order_acquire);
+
+    mdv_errno err = mdv_connection_send_async(con, req, client->response_timeout, fn, arg);
+
+    if (err != MDV_OK)
+        mdv_client_async_done(client);
+
+    mdv_connection_release(con);
+
+    return err;
+}
+
+
 /// Connection handshake
 static mdv_errno mdv_client_handshake_impl(mdv_descriptor fd, void *userdata)
 {
@@ -209,7 +249,7 @@ static mdv_errno mdv_client_status_handler(mdv_msg const *msg, mdv_errno *err)
 }
 
 
-static mdv_rowset * mdv_client_rowset_handler(mdv_msg const *msg, mdv_table *table, mdv_errno *err)
+static mdv_rowset * mdv_client_rowset_handler(mdv_msg const *msg, mdv_table *table, uint32_t *count, uint32_t *bytes, mdv_errno *err)
 {
     mdv_msg_rowset rowset_msg;
 
@@ -231,6 +271,9 @@ static mdv_rowset * mdv_client_rowset_handler(mdv_msg const *msg, mdv_table *tab
 
     mdv_rowset *rowset = mdv_unbinn_rowset(rowset_msg.rows, table);
 
+    *count = binn_count(rowset_msg.rows);
+    *bytes = rowset_msg.bytes;
+
     if (rowset)
         *err = MDV_OK;
     else
@@ -269,7 +312,7 @@ static mdv_errno mdv_client_topology_handler(mdv_msg const *msg, mdv_topology **
 
 mdv_client * mdv_client_connect(mdv_client_config const *config)
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(4);
 
     // Allocate memory for client
 
@@ -287,6 +330,19 @@ mdv_client * mdv_client_connect(mdv_client_config const *config)
     memset(client, 0, sizeof *client);
 
     client->response_timeout = config->connection.response_timeout * 1000;
+    client->fetch_window = config->connection.fetch_window;
+    client->fetch_bytes = config->connection.fetch_bytes;
+
+    atomic_init(&client->requests, 0);
+
+    if (mdv_condvar_create(&client->requests_cv) != MDV_OK)
+    {
+        MDV_LOGE("Conditional variable creation failed");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_condvar_free, &client->requests_cv);
 
     client->connection = mdv_safeptr_create(0,
                                             (mdv_safeptr_retain_fn)mdv_connection_retain,
@@ -380,11 +436,30 @@ void mdv_client_close(mdv_client *client)
     {
         mdv_chaman_free(client->chaman);
         mdv_safeptr_free(client->connection);
+        mdv_condvar_free(&client->requests_cv);
         mdv_free(client);
     }
 }
 
 
+void mdv_client_wait(mdv_client *client)
+{
+    while(atomic_load_explicit(&client->requests, memory_order_acquire))
+    {
+        mdv_connection *con = mdv_client_channel_retain(client);
+
+        if (con)
+        {
+            mdv_connection_expire(con);
+            mdv_connection_release(con);
+        }
+
+        // Waiting interval is limited because the signal may come before waiting
+        mdv_condvar_timedwait(&client->requests_cv, MDV_STREAM_WAIT);
+    }
+}
+
+
 mdv_table * mdv_create_table(mdv_client *client, mdv_table_desc *desc)
 {
     mdv_msg_create_table create_table =
@@ -597,31 +672,61 @@ mdv_hashmap * mdv_get_routes(mdv_client *client)
 }
 
 
-mdv_errno mdv_insert(mdv_client *client, mdv_rowset *rowset)
+/// Serializes insert request
+static bool mdv_insert_msg_binn(mdv_rowset *rowset, binn *msg)
 {
     binn serialized_rows;
 
     if (!mdv_binn_rowset(rowset, &serialized_rows))
-        return MDV_FAILED;
+        return false;
 
     mdv_table *table = mdv_rowset_table(rowset);
 
-    mdv_msg_insert_into insert_msg =
+    mdv_msg_insert_into const insert_msg =
     {
         .table = *mdv_table_uuid(table),
         .rows = &serialized_rows
     };
 
-    binn insert_into_msg;
+    bool const ret = mdv_msg_insert_into_binn(&insert_msg, msg);
+
+    binn_free(&serialized_rows);
+    mdv_table_release(table);
+
+    return ret;
+}
 
-    if (!mdv_msg_insert_into_binn(&insert_msg, &insert_into_msg))
+
+/// Handles insert response
+static mdv_errno mdv_insert_response(mdv_msg const *resp)
+{
+    mdv_errno err = MDV_FAILED;
+
+    switch(resp->hdr.id)
     {
-        binn_free(&serialized_rows);
-        mdv_table_release(table);
-        return MDV_FAILED;
+        case mdv_message_id(status):
+        {
+            if (mdv_client_status_handler(resp, &err) == MDV_OK)
+                break;
+            // fallthrough
+        }
+
+        default:
+            err = MDV_FAILED;
+            MDV_LOGE("Unexpected response");
+            break;
     }
 
-    binn_free(&serialized_rows);
+    return err;
+}
+
+
+mdv_errno mdv_insert(mdv_client *client, mdv_rowset *rowset)
+{
+    binn insert_into_msg;
+
+    if (!mdv_insert_msg_binn(rowset, &insert_into_msg))
+        return MDV_FAILED;
 
     mdv_msg req =
     {
@@ -639,6 +744,113 @@ mdv_errno mdv_insert(mdv_client *client, mdv_rowset *rowset)
 
     binn_free(&insert_into_msg);
 
+    if (err == MDV_OK)
+    {
+        err = mdv_insert_response(&resp);
+        mdv_free_msg(&resp);
+    }
+
+    return err;
+}
+
+
+/// Asynchronous insert context
+typedef struct
+{
+    mdv_client     *client;     ///< DB client
+    mdv_insert_fn   fn;         ///< Insertion completion handler
+    void           *arg;        ///< Handler argument
+} mdv_insert_async_context;
+
+
+static void mdv_insert_async_handler(mdv_errno err, mdv_msg const *resp, void *arg)
+{
+    mdv_insert_async_context *context = arg;
+    mdv_client *client = context->client;
+
+    if (err == MDV_OK)
+        err = mdv_insert_response(resp);
+
+    context->fn(err, context->arg);
+
+    mdv_free(context);
+
+    mdv_client_async_done(client);
+}
+
+
+mdv_errno mdv_insert_async(mdv_client *client, mdv_rowset *rowset, mdv_insert_fn fn, void *arg)
+{
+    mdv_insert_async_context *context = mdv_alloc(sizeof(mdv_insert_async_context));
+
+    if (!context)
+    {
+        MDV_LOGE("No memory for insert request");
+        return MDV_NO_MEM;
+    }
+
+    context->client = client;
+    context->fn = fn;
+    context->arg = arg;
+
+    binn insert_into_msg;
+
+    if (!mdv_insert_msg_binn(rowset, &insert_into_msg))
+    {
+        mdv_free(context);
+        return MDV_FAILED;
+    }
+
+    mdv_msg req =
+    {
+        .hdr =
+        {
+            .id   = mdv_msg_insert_into_id,
+            .size = binn_size(&insert_into_msg)
+        },
+        .payload = binn_ptr(&insert_into_msg)
+    };
+
+    mdv_errno err = mdv_client_send_async(client, &req, mdv_insert_async_handler, context);
+
+    binn_free(&insert_into_msg);
+
+    if (err != MDV_OK)
+        mdv_free(context);
+
+    return err;
+}
+
+
+mdv_errno mdv_delete(mdv_client *client, mdv_table *table, char const *filter)
+{
+    mdv_msg_delete_from const delete_msg =
+    {
+        .table = *mdv_table_uuid(table),
+        .filter = filter ? filter : ""
+    };
+
+    binn delete_from_msg;
+
+    if (!mdv_msg_delete_from_binn(&delete_msg, &delete_from_msg))
+        return MDV_FAILED;
+
+    mdv_msg req =
+    {
+        .hdr =
+        {
+            .id   = mdv_msg_delete_from_id,
+            .size = binn_size(&delete_from_msg)
+        },
+        .payload = binn_ptr(&delete_from_msg)
+    };
+
+    mdv_msg resp;
+
+    mdv_errno err = mdv_client_send(client, &req, &resp, client->response_timeout);
+
+    binn_free(&delete_from_msg);
+
     if (err == MDV_OK)
     {
         switch(resp.hdr.id)
@@ -659,8 +871,6 @@ mdv_errno mdv_insert(mdv_client *client, mdv_rowset *rowset)
         mdv_free_msg(&resp);
     }
 
-    mdv_table_release(table);
-
     return err;
 }
 
@@ -673,6 +883,14 @@ typedef struct
     uint32_t                view_id;            ///< View identifier
     mdv_client             *client;             ///< Client descriptor
     mdv_table              *table;              ///< Table descriptor (slice)
+    mdv_connection         *con;                ///< Connection rows are streamed from (NULL if rows are fetched by requests)
+    mdv_mutex               mutex;              ///< Mutex for received rows batches guard
+    mdv_condvar             cv;                 ///< Conditional variable for rows batches waiting
+    mdv_list                batches;            ///< Received rows batches (list<stream_rowset message payload>)
+    mdv_errno               err;                ///< Rows batches receiving status
+    uint32_t                consumed;           ///< Number of consumed rows batches which are not credited yet
+    bool                    eof;                ///< Flag indicates that all rows are received
+    uint32_t                batch_rows;         ///< Rows number limit for batch (tuned by received batches sizes)
 } mdv_rowset_impl;
 
 
@@ -724,24 +942,37 @@ static mdv_errno mdv_rowset_enumerator_impl_reset(mdv_enumerator *enumerator)
 }
 
 
-static mdv_errno mdv_rowset_enumerator_impl_next(mdv_enumerator *enumerator)
+/**
+ * @brief Tunes rows number limit for the next batches
+ * @details Rows number limit is chosen to fill the batch size limit using the average row size reported by server.
+ */
+static void mdv_rowset_impl_batch_tune(mdv_rowset_impl *rowset, uint32_t count, uint32_t bytes)
 {
-    mdv_rowset_enumerator_impl *impl = (mdv_rowset_enumerator_impl *)enumerator;
-    mdv_client                 *client = impl->rowset->client;
+    uint32_t const batch_bytes = rowset->client->fetch_bytes;
 
-    if(impl->fset_enumerator
-        && mdv_enumerator_next(impl->fset_enumerator) == MDV_OK)
-        return MDV_OK;
+    if (!batch_bytes || !count || !bytes)
+        return;
 
-    mdv_enumerator_release(impl->fset_enumerator);
-    mdv_rowset_release(impl->fset);
+    uint32_t const row_size = (bytes + count - 1) / count;
 
-    impl->fset_enumerator = 0;
-    impl->fset = 0;
+    uint32_t const batch_rows = batch_bytes / row_size;
+
+    rowset->batch_rows = batch_rows < 1 ? 1
+                        : batch_rows > MDV_FETCH_SIZE_MAX ? MDV_FETCH_SIZE_MAX
+                        : batch_rows;
+}
+
+
+/// Fetches next rows batch by request
+static mdv_errno mdv_rowset_impl_fetch(mdv_rowset_impl *rowset, mdv_rowset **fset)
+{
+    mdv_client *client = rowset->client;
 
     mdv_msg_fetch const msg =
     {
-        .id = impl->rowset->view_id
+        .id = rowset->view_id,
+        .count = rowset->batch_rows,
+        .bytes = client->fetch_bytes
     };
 
     binn binn_msg;
@@ -771,21 +1002,9 @@ static mdv_errno mdv_rowset_enumerator_impl_next(mdv_enumerator *enumerator)
         {
             case mdv_message_id(rowset):
             {
-                impl->fset = mdv_client_rowset_handler(&resp, impl->rowset->table, &err);
-
-                if (impl->fset)
-                {
-                    impl->fset_enumerator = mdv_rowset_enumerator(impl->fset);
-
-                    if (impl->fset_enumerator)
-                        err = mdv_enumerator_next(impl->fset_enumerator);
-                    else
-                    {
-                        mdv_rowset_release(impl->fset);
-                        impl->fset = 0;
-                    }
-                }
-
+                uint32_t count = 0, bytes = 0;
+                *fset = mdv_client_rowset_handler(&resp, rowset->table, &count, &bytes, &err);
+                mdv_rowset_impl_batch_tune(rowset, count, bytes);
                 break;
             }
 
@@ -809,121 +1028,327 @@ static mdv_errno mdv_rowset_enumerator_impl_next(mdv_enumerator *enumerator)
 }
 
 
-static void * mdv_rowset_enumerator_impl_current(mdv_enumerator *enumerator)
-{
-    mdv_rowset_enumerator_impl *impl = (mdv_rowset_enumerator_impl *)enumerator;
-    return impl->fset_enumerator ? mdv_enumerator_current(impl->fset_enumerator) : 0;
-}
-
-
-static mdv_enumerator * mdv_rowset_enumerator_impl_create(mdv_rowset_impl *rowset)
+/// Grants credits for rows batches pushing
+static mdv_errno mdv_rowset_impl_stream_credit(mdv_rowset_impl *rowset, uint32_t credits)
 {
-    mdv_rowset_enumerator_impl *enumerator =
-                mdv_alloc(sizeof(mdv_rowset_enumerator_impl));
-
-    if (!enumerator)
+    mdv_msg_stream const msg =
     {
-        MDV_LOGE("No memory for rows iterator");
-        return 0;
-    }
+        .id = rowset->view_id,
+        .credits = credits,
+        .count = rowset->batch_rows,
+        .bytes = rowset->client->fetch_bytes
+    };
 
-    memset(enumerator, 0, sizeof *enumerator);
+    binn binn_msg;
 
-    atomic_init(&enumerator->base.rc, 1);
+    if (!mdv_msg_stream_binn(&msg, &binn_msg))
+        return MDV_FAILED;
 
-    static mdv_ienumerator const vtbl =
+    mdv_msg req =
     {
-        .retain  = mdv_rowset_enumerator_impl_retain,
-        .release = mdv_rowset_enumerator_impl_release,
-        .reset   = mdv_rowset_enumerator_impl_reset,
-        .next    = mdv_rowset_enumerator_impl_next,
-        .current = mdv_rowset_enumerator_impl_current
+        .hdr =
+        {
+            .id   = mdv_msg_stream_id,
+            .size = binn_size(&binn_msg)
+        },
+        .payload = binn_ptr(&binn_msg)
     };
 
-    enumerator->base.vptr = &vtbl;
-
-    mdv_rowset_retain(&rowset->base);
+    mdv_errno err = mdv_connection_post(rowset->con, &req);
 
-    enumerator->rowset = rowset;
+    binn_free(&binn_msg);
 
-    return &enumerator->base;
+    return err;
 }
 
 
-static mdv_rowset * mdv_rowset_impl_retain(mdv_rowset *rowset)
+/// Rows batches handler. Batches are only queued here and decoded by reader.
+static void mdv_rowset_impl_stream_handler(mdv_msg const *msg, void *arg)
 {
-    mdv_rowset_impl *impl = (mdv_rowset_impl *)rowset;
-    atomic_fetch_add_explicit(&impl->rc, 1, memory_order_acquire);
-    return rowset;
+    mdv_rowset_impl *rowset = arg;
+
+    if (mdv_mutex_lock(&rowset->mutex) != MDV_OK)
+        return;
+
+    if (!mdv_list_push_back_data(&rowset->batches, msg->payload, msg->hdr.size))
+    {
+        MDV_LOGE("No memory for rows batch");
+        rowset->err = MDV_NO_MEM;
+    }
+
+    mdv_mutex_unlock(&rowset->mutex);
+
+    mdv_condvar_signal(&rowset->cv);
 }
 
 
-static uint32_t mdv_rowset_impl_release(mdv_rowset *rowset)
+/// Takes the next received rows batch
+static mdv_list_entry_base * mdv_rowset_impl_stream_pop(mdv_rowset_impl *rowset, mdv_errno *err)
 {
-    uint32_t rc = 0;
+    mdv_list_entry_base *batch = 0;
 
-    if (rowset)
+    size_t const timeout = rowset->client->response_timeout;
+    size_t const start = mdv_gettime();
+
+    do
     {
-        mdv_rowset_impl *impl = (mdv_rowset_impl *)rowset;
+        *err = mdv_mutex_lock(&rowset->mutex);
 
-        rc = atomic_fetch_sub_explicit(&impl->rc, 1, memory_order_release) - 1;
+        if (*err != MDV_OK)
+            return 0;
 
-        if (!rc)
-        {
-            mdv_table_release(impl->table);
-            mdv_free(impl);
-        }
-    }
+        batch = rowset->batches.next;
 
-    return rc;
+        if (batch)
+            mdv_list_exclude(&rowset->batches, batch);
+        else
+            *err = rowset->err;
 
-}
+        mdv_mutex_unlock(&rowset->mutex);
 
+        if (batch || *err != MDV_OK)
+            return batch;
 
-static mdv_table * mdv_rowset_impl_table(mdv_rowset *rowset)
-{
-    mdv_rowset_impl *impl = (mdv_rowset_impl *)rowset;
-    return mdv_table_retain(impl->table);
-}
+        // Waiting interval is limited because the signal may come before waiting
+        mdv_condvar_timedwait(&rowset->cv, MDV_STREAM_WAIT);
+    }
+    while(mdv_gettime() - start < timeout);
 
+    MDV_LOGE("Rows batch waiting timeout");
 
-static size_t mdv_rowset_impl_append(mdv_rowset *rowset, mdv_data const **rows, size_t count)
-{
-    (void)rowset;
-    (void)rows;
-    (void)count;
-    return MDV_NO_IMPL;
+    *err = MDV_ETIMEDOUT;
+
+    return 0;
 }
 
 
-static void mdv_rowset_impl_emplace(mdv_rowset *rowset, mdv_rowlist_entry *entry)
+/**
+ * @brief Reads next rows batch pushed by server
+ * @details Credits for the next batches are granted before decoding, so
+ *          the server keeps pushing rows while the current batch is decoded.
+ */
+static mdv_errno mdv_rowset_impl_stream_next(mdv_rowset_impl *rowset, mdv_rowset **fset)
 {
-    (void)rowset;
-    (void)entry;
-}
+    if (rowset->eof)
+        return MDV_FAILED;
 
+    mdv_errno err = MDV_FAILED;
 
-static mdv_enumerator * mdv_rowset_impl_enumerator(mdv_rowset *rowset)
-{
-    mdv_rowset_impl *impl = (mdv_rowset_impl *)rowset;
-    return mdv_rowset_enumerator_impl_create(impl);
-}
+    mdv_list_entry_base *batch = mdv_rowset_impl_stream_pop(rowset, &err);
 
+    if (!batch)
+        return err;
 
-static mdv_rowset * mdv_rowset_impl_create(mdv_client *client, mdv_table *table, uint32_t view_id)
-{
-    mdv_rowset_impl *rowset = mdv_alloc(sizeof(mdv_rowset_impl));
+    binn binn_msg;
+    mdv_msg_stream_rowset msg;
 
-    if (!rowset)
+    if(!binn_load(batch->data, &binn_msg))
     {
-        MDV_LOGE("No memory for rows set");
-        return 0;
+        mdv_free(batch);
+        return MDV_FAILED;
     }
 
-    static mdv_irowset const vtbl =
+    if (mdv_msg_stream_rowset_unbinn(&binn_msg, &msg))
     {
-        .retain = mdv_rowset_impl_retain,
-        .release = mdv_rowset_impl_release,
+        uint32_t const count = binn_count(msg.rows);
+
+        rowset->eof = count == 0;
+
+        mdv_rowset_impl_batch_tune(rowset, count, msg.bytes);
+
+        uint32_t const window = rowset->client->fetch_window;
+
+        if (!rowset->eof
+            && ++rowset->consumed >= (window + 1) / 2)
+        {
+            err = mdv_rowset_impl_stream_credit(rowset, rowset->consumed);
+            rowset->consumed = 0;
+        }
+        else
+            err = MDV_OK;
+
+        if (err == MDV_OK)
+        {
+            *fset = mdv_unbinn_rowset(msg.rows, rowset->table);
+
+            if (!*fset)
+            {
+                MDV_LOGE("Invalid serialized rows set");
+                err = MDV_FAILED;
+            }
+        }
+    }
+    else
+        MDV_LOGE("Invalid rows batch");
+
+    binn_free(&binn_msg);
+
+    mdv_free(batch);
+
+    return err;
+}
+
+
+static mdv_errno mdv_rowset_enumerator_impl_next(mdv_enumerator *enumerator)
+{
+    mdv_rowset_enumerator_impl *impl = (mdv_rowset_enumerator_impl *)enumerator;
+
+    if(impl->fset_enumerator
+        && mdv_enumerator_next(impl->fset_enumerator) == MDV_OK)
+        return MDV_OK;
+
+    mdv_enumerator_release(impl->fset_enumerator);
+    mdv_rowset_release(impl->fset);
+
+    impl->fset_enumerator = 0;
+    impl->fset = 0;
+
+    mdv_errno err = impl->rowset->con
+                        ? mdv_rowset_impl_stream_next(impl->rowset, &impl->fset)
+                        : mdv_rowset_impl_fetch(impl->rowset, &impl->fset);
+
+    if (impl->fset)
+    {
+        impl->fset_enumerator = mdv_rowset_enumerator(impl->fset);
+
+        if (impl->fset_enumerator)
+            err = mdv_enumerator_next(impl->fset_enumerator);
+        else
+        {
+            mdv_rowset_release(impl->fset);
+            impl->fset = 0;
+            err = MDV_FAILED;
+        }
+    }
+
+    return err;
+}
+
+
+static void * mdv_rowset_enumerator_impl_current(mdv_enumerator *enumerator)
+{
+    mdv_rowset_enumerator_impl *impl = (mdv_rowset_enumerator_impl *)enumerator;
+    return impl->fset_enumerator ? mdv_enumerator_current(impl->fset_enumerator) : 0;
+}
+
+
+static mdv_enumerator * mdv_rowset_enumerator_impl_create(mdv_rowset_impl *rowset)
+{
+    mdv_rowset_enumerator_impl *enumerator =
+                mdv_alloc(sizeof(mdv_rowset_enumerator_impl));
+
+    if (!enumerator)
+    {
+        MDV_LOGE("No memory for rows iterator");
+        return 0;
+    }
+
+    memset(enumerator, 0, sizeof *enumerator);
+
+    atomic_init(&enumerator->base.rc, 1);
+
+    static mdv_ienumerator const vtbl =
+    {
+        .retain  = mdv_rowset_enumerator_impl_retain,
+        .release = mdv_rowset_enumerator_impl_release,
+        .reset   = mdv_rowset_enumerator_impl_reset,
+        .next    = mdv_rowset_enumerator_impl_next,
+        .current = mdv_rowset_enumerator_impl_current
+    };
+
+    enumerator->base.vptr = &vtbl;
+
+    mdv_rowset_retain(&rowset->base);
+
+    enumerator->rowset = rowset;
+
+    return &enumerator->base;
+}
+
+
+static mdv_rowset * mdv_rowset_impl_retain(mdv_rowset *rowset)
+{
+    mdv_rowset_impl *impl = (mdv_rowset_impl *)rowset;
+    atomic_fetch_add_explicit(&impl->rc, 1, memory_order_acquire);
+    return rowset;
+}
+
+
+static uint32_t mdv_rowset_impl_release(mdv_rowset *rowset)
+{
+    uint32_t rc = 0;
+
+    if (rowset)
+    {
+        mdv_rowset_impl *impl = (mdv_rowset_impl *)rowset;
+
+        rc = atomic_fetch_sub_explicit(&impl->rc, 1, memory_order_release) - 1;
+
+        if (!rc)
+        {
+            if (impl->con)
+            {
+                mdv_connection_stream_unreg(impl->con, impl->view_id);
+                mdv_connection_release(impl->con);
+                mdv_list_clear(&impl->batches);
+                mdv_condvar_free(&impl->cv);
+                mdv_mutex_free(&impl->mutex);
+            }
+
+            mdv_table_release(impl->table);
+            mdv_free(impl);
+        }
+    }
+
+    return rc;
+
+}
+
+
+static mdv_table * mdv_rowset_impl_table(mdv_rowset *rowset)
+{
+    mdv_rowset_impl *impl = (mdv_rowset_impl *)rowset;
+    return mdv_table_retain(impl->table);
+}
+
+
+static size_t mdv_rowset_impl_append(mdv_rowset *rowset, mdv_data const **rows, size_t count)
+{
+    (void)rowset;
+    (void)rows;
+    (void)count;
+    return MDV_NO_IMPL;
+}
+
+
+static void mdv_rowset_impl_emplace(mdv_rowset *rowset, mdv_rowlist_entry *entry)
+{
+    (void)rowset;
+    (void)entry;
+}
+
+
+static mdv_enumerator * mdv_rowset_impl_enumerator(mdv_rowset *rowset)
+{
+    mdv_rowset_impl *impl = (mdv_rowset_impl *)rowset;
+    return mdv_rowset_enumerator_impl_create(impl);
+}
+
+
+static mdv_rowset * mdv_rowset_impl_create(mdv_client *client, mdv_table *table, uint32_t view_id)
+{
+    mdv_rowset_impl *rowset = mdv_alloc(sizeof(mdv_rowset_impl));
+
+    if (!rowset)
+    {
+        MDV_LOGE("No memory for rows set");
+        return 0;
+    }
+
+    static mdv_irowset const vtbl =
+    {
+        .retain = mdv_rowset_impl_retain,
+        .release = mdv_rowset_impl_release,
         .table = mdv_rowset_impl_table,
         .append = mdv_rowset_impl_append,
         .emplace = mdv_rowset_impl_emplace,
@@ -937,16 +1362,85 @@ static mdv_rowset * mdv_rowset_impl_create(mdv_client *client, mdv_table *table,
     rowset->view_id = view_id;
     rowset->client = client;
     rowset->table = mdv_table_retain(table);
+    rowset->con = 0;
+    rowset->batch_rows = client->fetch_bytes ? MDV_FETCH_SIZE : 0;
 
     return &rowset->base;
 }
 
 
-static mdv_errno mdv_select_request(mdv_client *client,
-                                    mdv_table  *table,
-                                    mdv_bitset *fields,
-                                    char const *filter,
-                                    uint32_t   *view_id)
+/**
+ * @brief Starts rows streaming
+ * @details Server pushes rows batches while credits are available.
+ */
+static mdv_errno mdv_rowset_impl_stream_open(mdv_rowset *base)
+{
+    mdv_rowset_impl *rowset = (mdv_rowset_impl *)base;
+
+    mdv_connection *con = mdv_client_channel_retain(rowset->client);
+
+    if (!con)
+        return MDV_CLOSED;
+
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(4);
+
+    mdv_rollbacker_push(rollbacker, mdv_connection_release, con);
+
+    if (mdv_mutex_create(&rowset->mutex) != MDV_OK)
+    {
+        MDV_LOGE("Mutex creation failed");
+        mdv_rollback(rollbacker);
+        return MDV_FAILED;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_mutex_free, &rowset->mutex);
+
+    if (mdv_condvar_create(&rowset->cv) != MDV_OK)
+    {
+        MDV_LOGE("Conditional variable creation failed");
+        mdv_rollback(rollbacker);
+        return MDV_FAILED;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_condvar_free, &rowset->cv);
+
+    memset(&rowset->batches, 0, sizeof rowset->batches);
+    rowset->err = MDV_OK;
+    rowset->consumed = 0;
+    rowset->eof = false;
+
+    mdv_errno err = mdv_connection_stream_reg(con, rowset->view_id, mdv_rowset_impl_stream_handler, rowset);
+
+    if (err != MDV_OK)
+    {
+        mdv_rollback(rollbacker);
+        return err;
+    }
+
+    rowset->con = con;
+
+    err = mdv_rowset_impl_stream_credit(rowset, rowset->client->fetch_window);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Rows streaming failed");
+        mdv_connection_stream_unreg(con, rowset->view_id);
+        rowset->con = 0;
+        mdv_rollback(rollbacker);
+        return err;
+    }
+
+    mdv_rollbacker_free(rollbacker);
+
+    return MDV_OK;
+}
+
+
+/// Serializes select request
+static bool mdv_select_msg_binn(mdv_table  *table,
+                                mdv_bitset *fields,
+                                char const *filter,
+                                binn       *msg)
 {
     mdv_msg_select const select =
     {
@@ -955,9 +1449,66 @@ static mdv_errno mdv_select_request(mdv_client *client,
         .filter = filter
     };
 
+    return mdv_msg_select_binn(&select, msg);
+}
+
+
+/// Handles select response
+static mdv_errno mdv_select_response(mdv_msg const *resp, uint32_t *view_id)
+{
+    mdv_errno err = MDV_FAILED;
+
+    switch(resp->hdr.id)
+    {
+        case mdv_message_id(view):
+        {
+            err = mdv_client_view_handler(resp, view_id);
+            break;
+        }
+
+        case mdv_message_id(status):
+        {
+            if (mdv_client_status_handler(resp, &err) == MDV_OK)
+                break;
+            // fallthrough
+        }
+
+        default:
+            err = MDV_FAILED;
+            MDV_LOGE("Unexpected response");
+            break;
+    }
+
+    return err;
+}
+
+
+/// Creates result set for the view
+static mdv_rowset * mdv_select_rowset(mdv_client *client, mdv_table *table_slice, uint32_t view_id)
+{
+    mdv_rowset *rowset = mdv_rowset_impl_create(client, table_slice, view_id);
+
+    if (rowset
+        && client->fetch_window
+        && mdv_rowset_impl_stream_open(rowset) != MDV_OK)
+    {
+        mdv_rowset_release(rowset);
+        rowset = 0;
+    }
+
+    return rowset;
+}
+
+
+static mdv_errno mdv_select_request(mdv_client *client,
+                                    mdv_table  *table,
+                                    mdv_bitset *fields,
+                                    char const *filter,
+                                    uint32_t   *view_id)
+{
     binn select_msg;
 
-    if (!mdv_msg_select_binn(&select, &select_msg))
+    if (!mdv_select_msg_binn(table, fields, filter, &select_msg))
         return MDV_FAILED;
 
     mdv_msg req =
@@ -978,27 +1529,7 @@ static mdv_errno mdv_select_request(mdv_client *client,
 
     if (err == MDV_OK)
     {
-        switch(resp.hdr.id)
-        {
-            case mdv_message_id(view):
-            {
-                err = mdv_client_view_handler(&resp, view_id);
-                break;
-            }
-
-            case mdv_message_id(status):
-            {
-                if (mdv_client_status_handler(&resp, &err) == MDV_OK)
-                    break;
-                // fallthrough
-            }
-
-            default:
-                err = MDV_FAILED;
-                MDV_LOGE("Unexpected response");
-                break;
-        }
-
+        err = mdv_select_response(&resp, view_id);
         mdv_free_msg(&resp);
     }
 
@@ -1033,9 +1564,401 @@ mdv_rowset * mdv_select(mdv_client *client,
         return 0;
     }
 
-    mdv_rowset *rowset = mdv_rowset_impl_create(client, table_slice, view_id);
+    mdv_rowset *rowset = mdv_select_rowset(client, table_slice, view_id);
 
     mdv_table_release(table_slice);
 
     return rowset;
 }
+
+
+/// Asynchronous select context
+typedef struct
+{
+    mdv_client     *client;     ///< DB client
+    mdv_table      *table;      ///< Result table descriptor
+    mdv_select_fn   fn;         ///< Selection completion handler
+    void           *arg;        ///< Handler argument
+} mdv_select_async_context;
+
+
+static void mdv_select_async_handler(mdv_errno err, mdv_msg const *resp, void *arg)
+{
+    mdv_select_async_context *context = arg;
+    mdv_client *client = context->client;
+    mdv_rowset *rowset = 0;
+
+    uint32_t view_id = 0;
+
+    if (err == MDV_OK)
+        err = mdv_select_response(resp, &view_id);
+
+    if (err == MDV_OK)
+    {
+        rowset = mdv_select_rowset(client, context->table, view_id);
+
+        if (!rowset)
+            err = MDV_FAILED;
+    }
+
+    context->fn(err, rowset, context->arg);
+
+    mdv_table_release(context->table);
+    mdv_free(context);
+
+    mdv_client_async_done(client);
+}
+
+
+mdv_errno mdv_select_async(mdv_client *client,
+                           mdv_table  *table,
+                           mdv_bitset *fields,
+                           char const *filter,
+                           mdv_select_fn fn,
+                           void       *arg)
+{
+    mdv_select_async_context *context = mdv_alloc(sizeof(mdv_select_async_context));
+
+    if (!context)
+    {
+        MDV_LOGE("No memory for select request");
+        return MDV_NO_MEM;
+    }
+
+    context->client = client;
+    context->fn = fn;
+    context->arg = arg;
+    context->table = mdv_table_slice(table, fields);
+
+    if (!context->table)
+    {
+        MDV_LOGE("Table descriptor slice failed");
+        mdv_free(context);
+        return MDV_FAILED;
+    }
+
+    binn select_msg;
+
+    if (!mdv_select_msg_binn(table, fields, filter, &select_msg))
+    {
+        mdv_table_release(context->table);
+        mdv_free(context);
+        return MDV_FAILED;
+    }
+
+    mdv_msg req =
+    {
+        .hdr =
+        {
+            .id   = mdv_msg_select_id,
+            .size = binn_size(&select_msg)
+        },
+        .payload = binn_ptr(&select_msg)
+    };
+
+    mdv_errno err = mdv_client_send_async(client, &req, mdv_select_async_handler, context);
+
+    binn_free(&select_msg);
+
+    if (err != MDV_OK)
+    {
+        mdv_table_release(context->table);
+        mdv_free(context);
+    }
+
+    return err;
+}
+
+
+/// @cond Doxygen_Suppress
+
+
+/// Bulk rows loader
+struct mdv_bulk
+{
+    mdv_client     *client;         ///< DB client
+    mdv_table      *table;          ///< Table descriptor
+    binn            chunk;          ///< Current rows chunk
+    uint32_t        rows;           ///< Number of rows in current chunk
+    mdv_mutex       mutex;          ///< Mutex for acknowledgments state guard
+    mdv_condvar     cv;             ///< Chunks acknowledgments notification
+    uint32_t        inflight;       ///< Number of unacknowledged chunks
+    mdv_errno       err;            ///< First chunk insertion error
+};
+
+
+/// @endcond
+
+
+static mdv_errno mdv_bulk_open_request(mdv_client *client, mdv_table *table)
+{
+    mdv_msg_bulk_open const bulk_open =
+    {
+        .table = *mdv_table_uuid(table)
+    };
+
+    binn bulk_open_msg;
+
+    if (!mdv_msg_bulk_open_binn(&bulk_open, &bulk_open_msg))
+        return MDV_FAILED;
+
+    mdv_msg req =
+    {
+        .hdr =
+        {
+            .id   = mdv_msg_bulk_open_id,
+            .size = binn_size(&bulk_open_msg)
+        },
+        .payload = binn_ptr(&bulk_open_msg)
+    };
+
+    mdv_msg resp;
+
+    mdv_errno err = mdv_client_send(client, &req, &resp, client->response_timeout);
+
+    binn_free(&bulk_open_msg);
+
+    if (err == MDV_OK)
+    {
+        err = mdv_insert_response(&resp);
+        mdv_free_msg(&resp);
+    }
+
+    return err;
+}
+
+
+mdv_bulk * mdv_bulk_open(mdv_client *client, mdv_table *table)
+{
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(5);
+
+    mdv_bulk *bulk = mdv_alloc(sizeof(mdv_bulk));
+
+    if (!bulk)
+    {
+        MDV_LOGE("No memory for bulk rows loader");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_free, bulk);
+
+    bulk->client = client;
+    bulk->table = mdv_table_retain(table);
+    bulk->rows = 0;
+    bulk->inflight = 0;
+    bulk->err = MDV_OK;
+
+    mdv_rollbacker_push(rollbacker, mdv_table_release, bulk->table);
+
+    if (mdv_mutex_create(&bulk->mutex) != MDV_OK)
+    {
+        MDV_LOGE("Mutex creation failed");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_mutex_free, &bulk->mutex);
+
+    if (mdv_condvar_create(&bulk->cv) != MDV_OK)
+    {
+        MDV_LOGE("Conditional variable creation failed");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_condvar_free, &bulk->cv);
+
+    if (!binn_create_list(&bulk->chunk))
+    {
+        MDV_LOGE("No memory for rows chunk");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, binn_free, &bulk->chunk);
+
+    if (mdv_bulk_open_request(client, table) != MDV_OK)
+    {
+        MDV_LOGE("Bulk rows loading failed");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_free(rollbacker);
+
+    return bulk;
+}
+
+
+/**
+ * @brief Waits until the number of unacknowledged chunks is less than or equal to given value
+ *
+ * @return First chunk insertion error
+ */
+static mdv_errno mdv_bulk_wait(mdv_bulk *bulk, uint32_t inflight)
+{
+    for(;;)
+    {
+        mdv_errno err = mdv_mutex_lock(&bulk->mutex);
+
+        if (err != MDV_OK)
+            return err;
+
+        bool const ready = bulk->inflight <= inflight;
+        err = bulk->err;
+
+        mdv_mutex_unlock(&bulk->mutex);
+
+        if (ready)
+            return err;
+
+        mdv_connection *con = mdv_client_channel_retain(bulk->client);
+
+        if (con)
+        {
+            mdv_connection_expire(con);
+            mdv_connection_release(con);
+        }
+
+        // Waiting interval is limited because the signal may come before waiting
+        mdv_condvar_timedwait(&bulk->cv, MDV_STREAM_WAIT);
+    }
+}
+
+
+/// Chunk acknowledgment handler
+static void mdv_bulk_ack_handler(mdv_errno err, mdv_msg const *resp, void *arg)
+{
+    mdv_bulk *bulk = arg;
+    mdv_client *client = bulk->client;
+
+    if (err == MDV_OK)
+        err = mdv_insert_response(resp);
+
+    if (mdv_mutex_lock(&bulk->mutex) == MDV_OK)
+    {
+        --bulk->inflight;
+
+        if (bulk->err == MDV_OK)
+            bulk->err = err;
+
+        mdv_condvar_signal(&bulk->cv);
+
+        mdv_mutex_unlock(&bulk->mutex);
+    }
+
+    mdv_client_async_done(client);
+}
+
+
+/// Sends current rows chunk without acknowledgment waiting
+static mdv_errno mdv_bulk_flush(mdv_bulk *bulk)
+{
+    if (!bulk->rows)
+        return MDV_OK;
+
+    mdv_errno err = mdv_bulk_wait(bulk, MDV_BULK_WINDOW - 1);
+
+    if (err != MDV_OK)
+        return err;
+
+    mdv_msg req =
+    {
+        .hdr =
+        {
+            .id   = mdv_msg_bulk_rows_id,
+            .size = binn_size(&bulk->chunk)
+        },
+        .payload = binn_ptr(&bulk->chunk)
+    };
+
+    err = mdv_mutex_lock(&bulk->mutex);
+
+    if (err != MDV_OK)
+        return err;
+
+    ++bulk->inflight;
+
+    mdv_mutex_unlock(&bulk->mutex);
+
+    err = mdv_client_send_async(bulk->client, &req, mdv_bulk_ack_handler, bulk);
+
+    if (err != MDV_OK)
+    {
+        if (mdv_mutex_lock(&bulk->mutex) == MDV_OK)
+        {
+            --bulk->inflight;
+            mdv_mutex_unlock(&bulk->mutex);
+        }
+
+        return err;
+    }
+
+    binn_free(&bulk->chunk);
+
+    bulk->rows = 0;
+
+    if (!binn_create_list(&bulk->chunk))
+    {
+        MDV_LOGE("No memory for rows chunk");
+        return MDV_NO_MEM;
+    }
+
+    return MDV_OK;
+}
+
+
+mdv_errno mdv_bulk_insert(mdv_bulk *bulk, mdv_data const **rows, size_t count)
+{
+    mdv_table_desc const *desc = mdv_table_description(bulk->table);
+
+    for(size_t i = 0; i < count; ++i)
+    {
+        binn fields;
+
+        if (!mdv_binn_row((mdv_row const *)rows[i], desc, &fields))
+            return MDV_FAILED;
+
+        if (!binn_list_add_list(&bulk->chunk, &fields))
+        {
+            MDV_LOGE("No memory for rows chunk");
+            binn_free(&fields);
+            return MDV_NO_MEM;
+        }
+
+        binn_free(&fields);
+
+        ++bulk->rows;
+
+        if (binn_size(&bulk->chunk) >= MDV_BULK_CHUNK)
+        {
+            mdv_errno err = mdv_bulk_flush(bulk);
+
+            if (err != MDV_OK)
+                return err;
+        }
+    }
+
+    return MDV_OK;
+}
+
+
+mdv_errno mdv_bulk_close(mdv_bulk *bulk)
+{
+    mdv_errno err = mdv_bulk_flush(bulk);
+
+    // All sent chunks should be acknowledged before the loader freeing
+    mdv_errno const ack_err = mdv_bulk_wait(bulk, 0);
+
+    if (err == MDV_OK)
+        err = ack_err;
+
+    binn_free(&bulk->chunk);
+    mdv_condvar_free(&bulk->cv);
+    mdv_mutex_free(&bulk->mutex);
+    mdv_table_release(bulk->table);
+    mdv_free(bulk);
+
+    return err;
+}
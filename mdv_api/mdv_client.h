@@ -17,6 +17,18 @@
 typedef struct mdv_client mdv_client;
 
 
+/// Bulk rows loader
+typedef struct mdv_bulk mdv_bulk;
+
+
+/// Asynchronous insertion completion handler
+typedef void (*mdv_insert_fn)(mdv_errno err, void *arg);
+
+
+/// Asynchronous selection completion handler. On success, handler owns the result set and should release it.
+typedef void (*mdv_select_fn)(mdv_errno err, mdv_rowset *rowset, void *arg);
+
+
 /**
  * @brief Client library initialization
  */
@@ -48,6 +60,15 @@ mdv_client * mdv_client_connect(mdv_client_config const *config);
 void mdv_client_close(mdv_client *client);
 
 
+/**
+ * @brief Waits completion of all asynchronous requests
+ * @details Requests which responses weren't received in time are completed with MDV_ETIMEDOUT error.
+ *
+ * @param client [in] DB client
+ */
+void mdv_client_wait(mdv_client *client);
+
+
 /**
  * @brief Create new table
  *
@@ -111,6 +132,37 @@ mdv_hashmap * mdv_get_routes(mdv_client *client);
 mdv_errno mdv_insert(mdv_client *client, mdv_rowset *rowset);
 
 
+/**
+ * @brief Insert rows to given table without response waiting
+ * @details Requests are pipelined, so many insertions may be in flight via single connection.
+ *          Completion handler is called from the connection reading thread,
+ *          so it shouldn't call synchronous client functions.
+ *
+ * @param client [in]    DB client
+ * @param rowset [in]    Set of rows for insert
+ * @param fn [in]        insertion completion handler
+ * @param arg [in]       completion handler argument
+ *
+ * @return On success, return MDV_OK and completion handler is called exactly once.
+ * @return On error, return non zero value and completion handler isn't called.
+ */
+mdv_errno mdv_insert_async(mdv_client *client, mdv_rowset *rowset, mdv_insert_fn fn, void *arg);
+
+
+/**
+ * @brief Deletes rows from given table
+ * @details Rows satisfying the filter are deleted. Deletion is replicated to other nodes.
+ *
+ * @param client [in]    DB client
+ * @param table [in]     table descriptor
+ * @param filter [in]    predicate for rows filtering
+ *
+ * @return On success, return MDV_OK.
+ * @return On error, return non zero value
+ */
+mdv_errno mdv_delete(mdv_client *client, mdv_table *table, char const *filter);
+
+
 /**
  * @brief Creates table rows iterator
  *
@@ -127,3 +179,65 @@ mdv_rowset * mdv_select(mdv_client *client,
                         mdv_table  *table,
                         mdv_bitset *fields,
                         char const *filter);
+
+
+/**
+ * @brief Creates table rows iterator without response waiting
+ * @details Completion handler is called from the connection reading thread,
+ *          so it shouldn't call synchronous client functions. Rows may be read after handler returns.
+ *
+ * @param client [in]           DB client
+ * @param table [in]            table descriptor
+ * @param fields [in]           fields mask for reading
+ * @param filter [in]           predicate for rows filtering
+ * @param fn [in]               selection completion handler
+ * @param arg [in]              completion handler argument
+ *
+ * @return On success, return MDV_OK and completion handler is called exactly once.
+ * @return On error, return non zero value and completion handler isn't called.
+ */
+mdv_errno mdv_select_async(mdv_client *client,
+                           mdv_table  *table,
+                           mdv_bitset *fields,
+                           char const *filter,
+                           mdv_select_fn fn,
+                           void       *arg);
+
+
+/**
+ * @brief Opens bulk rows loading into the given table
+ * @details Rows are serialized into chunks which are streamed to the server without waiting
+ *          the acknowledgment of each chunk. Chunk rows are written to the transaction log as is.
+ *
+ * @param client [in]           DB client
+ * @param table [in]            table descriptor
+ *
+ * @return On success, return nonzero pointer to bulk rows loader
+ * @return On error, return NULL pointer
+ */
+mdv_bulk * mdv_bulk_open(mdv_client *client, mdv_table *table);
+
+
+/**
+ * @brief Appends rows to the bulk loading
+ * @details Full chunks are sent to the server. Caller is blocked while too many chunks are unacknowledged.
+ *
+ * @param bulk [in]             bulk rows loader
+ * @param rows [in]             rows (each row is the array of fields values)
+ * @param count [in]            rows count
+ *
+ * @return On success, return MDV_OK.
+ * @return On error, return non zero value
+ */
+mdv_errno mdv_bulk_insert(mdv_bulk *bulk, mdv_data const **rows, size_t count);
+
+
+/**
+ * @brief Sends remaining rows, waits acknowledgment of all chunks and frees bulk rows loader
+ *
+ * @param bulk [in]             bulk rows loader
+ *
+ * @return On success, return MDV_OK.
+ * @return On error, return first error of rows loading
+ */
+mdv_errno mdv_bulk_close(mdv_bulk *bulk);
@@ -24,6 +24,8 @@ typedef struct mdv_client_connection_config
     uint32_t    keepcnt;            ///< Number of keepalives before death
     uint32_t    keepintvl;          ///< Interval between keepalives (in seconds)
     uint32_t    response_timeout;   ///< Timeout for responses (in seconds)
+    uint32_t    fetch_window;       ///< Number of rows batches server pushes ahead of reading (zero disables rows streaming)
+    uint32_t    fetch_bytes;        ///< Rows batch size limit (in bytes). Zero means server defaults.
 } mdv_client_connection_config;
 
 
@@ -7,6 +7,8 @@
 #include <mdv_socket.h>
 #include <mdv_rollbacker.h>
 #include <mdv_version.h>
+#include <mdv_hashmap.h>
+#include <mdv_mutex.h>
 #include <stdatomic.h>
 
 
@@ -18,9 +20,24 @@ struct mdv_connection
     atomic_uint_fast32_t    rc;             ///< references counter
     mdv_uuid                uuid;           ///< server uuid
     mdv_dispatcher         *dispatcher;     ///< Messages dispatcher
+    mdv_mutex               streams_mutex;  ///< Mutex for streams guard
+    mdv_hashmap            *streams;        ///< Rows streams handlers (hashmap<mdv_connection_stream>)
 };
 
 
+/// Rows stream handler
+typedef struct
+{
+    uint32_t                    view_id;    ///< View identifier
+    mdv_connection_stream_fn    fn;         ///< Rows batches handler
+    void                       *arg;        ///< Handler argument
+} mdv_connection_stream;
+
+
+static size_t mdv_u32_hash(uint32_t const *v)                   { return *v; }
+static int mdv_u32_cmp(uint32_t const *a, uint32_t const *b)    { return (int)*a - *b; }
+
+
 static mdv_channel * mdv_connection_retain_impl(mdv_channel *channel)
 {
     mdv_connection *con = (mdv_connection*)channel;
@@ -32,6 +49,8 @@ static mdv_channel * mdv_connection_retain_impl(mdv_channel *channel)
 static void mdv_connection_free(mdv_connection *con)
 {
     mdv_dispatcher_free(con->dispatcher);
+    mdv_hashmap_release(con->streams);
+    mdv_mutex_free(&con->streams_mutex);
     mdv_free(con);
     MDV_LOGD("Connection %p freed", con);
 }
@@ -84,9 +103,47 @@ static mdv_errno mdv_channel_status_handler(mdv_msg const *msg, void *arg)
 }
 
 
+static mdv_errno mdv_channel_stream_rowset_handler(mdv_msg const *msg, void *arg)
+{
+    mdv_connection *con = arg;
+
+    binn binn_msg;
+
+    if(!binn_load(msg->payload, &binn_msg))
+        return MDV_FAILED;
+
+    mdv_msg_stream_rowset rowset;
+
+    if (!mdv_msg_stream_rowset_unbinn(&binn_msg, &rowset))
+    {
+        MDV_LOGE("Invalid '%s' message", mdv_msg_name(msg->hdr.id));
+        binn_free(&binn_msg);
+        return MDV_FAILED;
+    }
+
+    binn_free(&binn_msg);
+
+    mdv_errno err = mdv_mutex_lock(&con->streams_mutex);
+
+    if (err == MDV_OK)
+    {
+        mdv_connection_stream *stream = mdv_hashmap_find(con->streams, &rowset.id);
+
+        if (stream)
+            stream->fn(msg, stream->arg);
+        else
+            MDV_LOGW("Rows batch is discarded due to stream %u not found", rowset.id);
+
+        mdv_mutex_unlock(&con->streams_mutex);
+    }
+
+    return err;
+}
+
+
 mdv_connection * mdv_connection_create(mdv_descriptor fd, mdv_uuid const *uuid)
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(2);
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(4);
 
     mdv_connection *con = mdv_alloc(sizeof(mdv_connection));
 
@@ -117,6 +174,28 @@ mdv_connection * mdv_connection_create(mdv_descriptor fd, mdv_uuid const *uuid)
 
     con->uuid = *uuid;
 
+    if (mdv_mutex_create(&con->streams_mutex) != MDV_OK)
+    {
+        MDV_LOGE("Mutex creation failed");
+        mdv_rollback(rollbacker);
+        mdv_socket_shutdown(fd, MDV_SOCK_SHUT_RD | MDV_SOCK_SHUT_WR);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_mutex_free, &con->streams_mutex);
+
+    con->streams = mdv_hashmap_create(mdv_connection_stream, view_id, 4, mdv_u32_hash, mdv_u32_cmp);
+
+    if (!con->streams)
+    {
+        MDV_LOGE("Streams map creation failed");
+        mdv_rollback(rollbacker);
+        mdv_socket_shutdown(fd, MDV_SOCK_SHUT_RD | MDV_SOCK_SHUT_WR);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_hashmap_release, con->streams);
+
     con->dispatcher = mdv_dispatcher_create(fd);
 
     if (!con->dispatcher)
@@ -131,7 +210,8 @@ mdv_connection * mdv_connection_create(mdv_descriptor fd, mdv_uuid const *uuid)
 
     mdv_dispatcher_handler const handlers[] =
     {
-        { mdv_message_id(status),   &mdv_channel_status_handler, con }
+        { mdv_message_id(status),           &mdv_channel_status_handler,        con },
+        { mdv_message_id(stream_rowset),    &mdv_channel_stream_rowset_handler, con },
     };
 
     for(size_t i = 0; i < sizeof handlers / sizeof *handlers; ++i)
@@ -189,6 +269,30 @@ mdv_errno mdv_connection_send(mdv_connection *con, mdv_msg *req, mdv_msg *resp,
 }
 
 
+mdv_errno mdv_connection_send_async(mdv_connection *con, mdv_msg *req, size_t timeout, mdv_dispatcher_response_fn fn, void *arg)
+{
+    MDV_LOGI(">>>>> '%s'", mdv_msg_name(req->hdr.id));
+
+    mdv_errno err = MDV_CLOSED;
+
+    con = mdv_connection_retain(con);
+
+    if (con)
+    {
+        err = mdv_dispatcher_send_async(con->dispatcher, req, timeout, fn, arg);
+        mdv_connection_release(con);
+    }
+
+    return err;
+}
+
+
+void mdv_connection_expire(mdv_connection *con)
+{
+    mdv_dispatcher_expire(con->dispatcher);
+}
+
+
 mdv_errno mdv_connection_post(mdv_connection *con, mdv_msg *msg)
 {
     MDV_LOGI(">>>>> '%s'", mdv_msg_name(msg->hdr.id));
@@ -205,3 +309,39 @@ mdv_errno mdv_connection_post(mdv_connection *con, mdv_msg *msg)
 
     return err;
 }
+
+
+mdv_errno mdv_connection_stream_reg(mdv_connection *con, uint32_t view_id, mdv_connection_stream_fn fn, void *arg)
+{
+    mdv_connection_stream const stream =
+    {
+        .view_id = view_id,
+        .fn = fn,
+        .arg = arg
+    };
+
+    mdv_errno err = mdv_mutex_lock(&con->streams_mutex);
+
+    if (err == MDV_OK)
+    {
+        if (!mdv_hashmap_insert(con->streams, &stream, sizeof stream))
+        {
+            MDV_LOGE("No memory for rows stream");
+            err = MDV_NO_MEM;
+        }
+
+        mdv_mutex_unlock(&con->streams_mutex);
+    }
+
+    return err;
+}
+
+
+void mdv_connection_stream_unreg(mdv_connection *con, uint32_t view_id)
+{
+    if (mdv_mutex_lock(&con->streams_mutex) == MDV_OK)
+    {
+        mdv_hashmap_erase(con->streams, &view_id);
+        mdv_mutex_unlock(&con->streams_mutex);
+    }
+}
@@ -5,6 +5,7 @@
 #pragma once
 #include <mdv_def.h>
 #include <mdv_msg.h>
+#include <mdv_dispatcher.h>
 #include <mdv_uuid.h>
 #include <mdv_channel.h>
 
@@ -14,6 +15,10 @@
 typedef struct mdv_connection mdv_connection;
 
 
+/// Handler for rows batches pushed by server
+typedef void (*mdv_connection_stream_fn)(mdv_msg const *msg, void *arg);
+
+
 /**
  * @brief Initialize user
  *
@@ -62,6 +67,31 @@ mdv_uuid const * mdv_connection_uuid(mdv_connection *con);
 mdv_errno mdv_connection_send(mdv_connection *con, mdv_msg *req, mdv_msg *resp, size_t timeout);
 
 
+/**
+ * @brief Send message without response waiting.
+ * @details Response handler is called from the connection reading thread
+ *          and it shouldn't wait responses synchronously.
+ *
+ * @param con [in]      user connection context
+ * @param req [in]      request to be sent
+ * @param timeout [in]  timeout for response wait (in milliseconds)
+ * @param fn [in]       response handler
+ * @param arg [in]      argument which passed to response handler
+ *
+ * @return MDV_OK if message is successfully sent. Response handler is called exactly once in this case.
+ * @return On error return nonzero error code and response handler isn't called.
+ */
+mdv_errno mdv_connection_send_async(mdv_connection *con, mdv_msg *req, size_t timeout, mdv_dispatcher_response_fn fn, void *arg);
+
+
+/**
+ * @brief Completes asynchronous requests which responses weren't received in time.
+ *
+ * @param con [in]      user connection context
+ */
+void mdv_connection_expire(mdv_connection *con);
+
+
 /**
  * @brief Send message but response isn't required.
  *
@@ -72,3 +102,27 @@ mdv_errno mdv_connection_send(mdv_connection *con, mdv_msg *req, mdv_msg *resp,
  * @return On error return nonzero error code.
  */
 mdv_errno mdv_connection_post(mdv_connection *con, mdv_msg *msg);
+
+
+/**
+ * @brief Registers handler for rows batches pushed by server for given view.
+ *
+ * @param con [in]      user connection context
+ * @param view_id [in]  view identifier
+ * @param fn [in]       rows batches handler. Handler is called from the connection reading thread.
+ * @param arg [in]      handler argument
+ *
+ * @return On success returns MDV_OK
+ * @return On error return nonzero error code.
+ */
+mdv_errno mdv_connection_stream_reg(mdv_connection *con, uint32_t view_id, mdv_connection_stream_fn fn, void *arg);
+
+
+/**
+ * @brief Unregisters handler for rows batches pushed by server.
+ * @details After this call the handler is never called.
+ *
+ * @param con [in]      user connection context
+ * @param view_id [in]  view identifier
+ */
+void mdv_connection_stream_unreg(mdv_connection *con, uint32_t view_id);
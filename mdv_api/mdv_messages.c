@@ -20,6 +20,10 @@ char const * mdv_msg_name(uint32_t id)
         case mdv_message_id(fetch):         return "FETCH";
         case mdv_message_id(rowset):        return "ROWSET";
         case mdv_message_id(delete_from):   return "DELETE FROM";
+        case mdv_message_id(stream):        return "STREAM";
+        case mdv_message_id(stream_rowset): return "STREAM ROWSET";
+        case mdv_message_id(bulk_open):     return "BULK OPEN";
+        case mdv_message_id(bulk_rows):     return "BULK ROWS";
     }
     return "UNKOWN";
 }
@@ -335,7 +339,10 @@ bool mdv_msg_fetch_binn(mdv_msg_fetch const *msg, binn *obj)
         return false;
     }
 
-    if (!binn_object_set_uint32(obj, "V", msg->id))
+    if (0
+        || !binn_object_set_uint32(obj, "V", msg->id)
+        || !binn_object_set_uint32(obj, "N", msg->count)
+        || !binn_object_set_uint32(obj, "B", msg->bytes))
     {
         MDV_LOGE("mdv_msg_fetch_binn failed");
         binn_free(obj);
@@ -354,6 +361,13 @@ bool mdv_msg_fetch_unbinn(binn const * obj, mdv_msg_fetch *msg)
         return false;
     }
 
+    // Limits are optional. Zero means server defaults.
+    if (!binn_object_get_uint32((void*)obj, "N", &msg->count))
+        msg->count = 0;
+
+    if (!binn_object_get_uint32((void*)obj, "B", &msg->bytes))
+        msg->bytes = 0;
+
     return true;
 }
 
@@ -366,7 +380,9 @@ bool mdv_msg_rowset_binn(mdv_msg_rowset const *msg, binn *obj)
         return false;
     }
 
-    if (!binn_object_set_list(obj, "R", (void *)msg->rows))
+    if (0
+        || !binn_object_set_uint32(obj, "B", msg->bytes)
+        || !binn_object_set_list(obj, "R", (void *)msg->rows))
     {
         MDV_LOGE("mdv_msg_rowset_binn failed");
         binn_free(obj);
@@ -379,7 +395,9 @@ bool mdv_msg_rowset_binn(mdv_msg_rowset const *msg, binn *obj)
 
 bool mdv_msg_rowset_unbinn(binn const * obj, mdv_msg_rowset *msg)
 {
-    if(!binn_object_get_list((void*)obj, "R", (void**)&msg->rows))
+    if (0
+        || !binn_object_get_uint32((void*)obj, "B", &msg->bytes)
+        || !binn_object_get_list((void*)obj, "R", (void**)&msg->rows))
     {
         MDV_LOGE("mdv_msg_rowset_unbinn failed");
         return false;
@@ -426,3 +444,114 @@ bool mdv_msg_delete_from_unbinn(binn const * obj, mdv_msg_delete_from *msg)
 
     return true;
 }
+
+
+bool mdv_msg_stream_binn(mdv_msg_stream const *msg, binn *obj)
+{
+    if (!binn_create_object(obj))
+    {
+        MDV_LOGE("mdv_msg_stream_binn failed");
+        return false;
+    }
+
+    if (0
+        || !binn_object_set_uint32(obj, "V", msg->id)
+        || !binn_object_set_uint32(obj, "C", msg->credits)
+        || !binn_object_set_uint32(obj, "N", msg->count)
+        || !binn_object_set_uint32(obj, "B", msg->bytes))
+    {
+        MDV_LOGE("mdv_msg_stream_binn failed");
+        binn_free(obj);
+        return false;
+    }
+
+    return true;
+}
+
+
+bool mdv_msg_stream_unbinn(binn const * obj, mdv_msg_stream *msg)
+{
+    if (0
+        || !binn_object_get_uint32((void*)obj, "V", &msg->id)
+        || !binn_object_get_uint32((void*)obj, "C", &msg->credits)
+        || !binn_object_get_uint32((void*)obj, "N", &msg->count)
+        || !binn_object_get_uint32((void*)obj, "B", &msg->bytes))
+    {
+        MDV_LOGE("mdv_msg_stream_unbinn failed");
+        return false;
+    }
+
+    return true;
+}
+
+
+bool mdv_msg_stream_rowset_binn(mdv_msg_stream_rowset const *msg, binn *obj)
+{
+    if (!binn_create_object(obj))
+    {
+        MDV_LOGE("mdv_msg_stream_rowset_binn failed");
+        return false;
+    }
+
+    if (0
+        || !binn_object_set_uint32(obj, "V", msg->id)
+        || !binn_object_set_uint32(obj, "B", msg->bytes)
+        || !binn_object_set_list(obj, "R", (void *)msg->rows))
+    {
+        MDV_LOGE("mdv_msg_stream_rowset_binn failed");
+        binn_free(obj);
+        return false;
+    }
+
+    return true;
+}
+
+
+bool mdv_msg_stream_rowset_unbinn(binn const * obj, mdv_msg_stream_rowset *msg)
+{
+    if (0
+        || !binn_object_get_uint32((void*)obj, "V", &msg->id)
+        || !binn_object_get_uint32((void*)obj, "B", &msg->bytes)
+        || !binn_object_get_list((void*)obj, "R", (void**)&msg->rows))
+    {
+        MDV_LOGE("mdv_msg_stream_rowset_unbinn failed");
+        return false;
+    }
+
+    return true;
+}
+
+
+bool mdv_msg_bulk_open_binn(mdv_msg_bulk_open const *msg, binn *obj)
+{
+    if (!binn_create_object(obj))
+    {
+        MDV_LOGE("binn_bulk_open failed");
+        return false;
+    }
+
+    if (0
+        || !binn_object_set_uint64(obj, "U0", msg->table.u64[0])
+        || !binn_object_set_uint64(obj, "U1", msg->table.u64[1]))
+    {
+        binn_free(obj);
+        MDV_LOGE("binn_bulk_open failed");
+        return false;
+    }
+
+    return true;
+}
+
+
+bool mdv_msg_bulk_open_unbinn(binn const * obj, mdv_msg_bulk_open *msg)
+{
+    if (0
+        || !binn_object_get_uint64((void*)obj, "U0", (uint64 *)(msg->table.u64 + 0))
+        || !binn_object_get_uint64((void*)obj, "U1", (uint64 *)(msg->table.u64 + 1)))
+    {
+        MDV_LOGE("unbinn_bulk_open failed");
+        return false;
+    }
+
+    return true;
+}
@@ -33,6 +33,23 @@
      |                                  |
      | DELETE FROM >>>>>                |
      |                     <<<<< STATUS |
+     |                                  |
+     | STREAM >>>>>                     |
+     |              <<<<< STREAM ROWSET |
+     |              <<<<< STREAM ROWSET |
+     |                    ...           |
+     | STREAM >>>>>                     |
+     |              <<<<< STREAM ROWSET |
+     |                    ...           |
+     |   <<<<< STREAM ROWSET (no rows)  |
+     |                                  |
+     | BULK OPEN >>>>>                  |
+     |                     <<<<< STATUS |
+     | BULK ROWS >>>>>                  |
+     | BULK ROWS >>>>>                  |
+     |                     <<<<< STATUS |
+     |                     <<<<< STATUS |
+     |                    ...           |
  */
 
 
@@ -106,10 +123,13 @@ mdv_message_def(view, 11,
 
 mdv_message_def(fetch, 12,
     uint32_t    id;
+    uint32_t    count;
+    uint32_t    bytes;
 );
 
 
 mdv_message_def(rowset, 13,
+    uint32_t    bytes;
     binn       *rows;
 );
 
@@ -119,6 +139,30 @@ mdv_message_def(delete_from, 14,
     char const *filter;
 );
 
+
+mdv_message_def(stream, 15,
+    uint32_t    id;
+    uint32_t    credits;
+    uint32_t    count;
+    uint32_t    bytes;
+);
+
+
+mdv_message_def(stream_rowset, 16,
+    uint32_t    id;
+    uint32_t    bytes;
+    binn       *rows;
+);
+
+
+mdv_message_def(bulk_open, 17,
+    mdv_uuid    table;
+);
+
+
+// Payload is the serialized rows list which is inserted into the table of the last BULK OPEN
+mdv_message_id_def(bulk_rows, 18);
+
 char const *                mdv_msg_name                    (uint32_t id);
 
 
@@ -170,3 +214,15 @@ bool                        mdv_msg_rowset_unbinn           (binn const * obj, m
 
 bool                        mdv_msg_delete_from_binn        (mdv_msg_delete_from const *msg, binn *obj);
 bool                        mdv_msg_delete_from_unbinn      (binn const * obj, mdv_msg_delete_from *msg);
+
+
+bool                        mdv_msg_stream_binn             (mdv_msg_stream const *msg, binn *obj);
+bool                        mdv_msg_stream_unbinn           (binn const * obj, mdv_msg_stream *msg);
+
+
+bool                        mdv_msg_stream_rowset_binn      (mdv_msg_stream_rowset const *msg, binn *obj);
+bool                        mdv_msg_stream_rowset_unbinn    (binn const * obj, mdv_msg_stream_rowset *msg);
+
+
+bool                        mdv_msg_bulk_open_binn          (mdv_msg_bulk_open const *msg, binn *obj);
+bool                        mdv_msg_bulk_open_unbinn        (binn const * obj, mdv_msg_bulk_open *msg);
@@ -653,6 +653,8 @@ SWIGINTERN mdv_client_config *new_mdv_client_config(char const *addr){
         cfg->connection.keepcnt          = 10;
         cfg->connection.keepintvl        = 5;
         cfg->connection.response_timeout = 5;
+        cfg->connection.fetch_window     = 8;
+        cfg->connection.fetch_bytes      = 256 * 1024;
         cfg->threadpool.size             = 4;
 
         return cfg;
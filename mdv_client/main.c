@@ -396,7 +396,9 @@ static mdv_client * mdv_connect(char const *addr)
             .keepidle           = 5,
             .keepcnt            = 10,
             .keepintvl          = 5,
-            .response_timeout   = 5
+            .response_timeout   = 5,
+            .fetch_window       = 8,
+            .fetch_bytes        = 256 * 1024
         },
         .threadpool =
         {
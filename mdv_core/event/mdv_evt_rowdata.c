@@ -1,6 +1,7 @@
 #include "mdv_evt_rowdata.h"
 #include "mdv_evt_types.h"
 #include <mdv_alloc.h>
+#include <string.h>
 
 
 mdv_evt_rowdata_ins_req * mdv_evt_rowdata_ins_req_create(mdv_uuid const *table_id, binn *rows)
@@ -32,6 +33,128 @@ uint32_t mdv_evt_rowdata_ins_req_release(mdv_evt_rowdata_ins_req *evt)
 }
 
 
+mdv_evt_rowdata_del_req * mdv_evt_rowdata_del_req_create(mdv_uuid const *table_id, char const *filter)
+{
+    mdv_evt_rowdata_del_req *event = (mdv_evt_rowdata_del_req*)
+                                mdv_event_create(
+                                    MDV_EVT_ROWDATA_DELETE,
+                                    sizeof(mdv_evt_rowdata_del_req));
+
+    if (event)
+    {
+        event->table_id = *table_id;
+        event->filter = filter;
+    }
+
+    return event;
+}
+
+
+mdv_evt_rowdata_del_req * mdv_evt_rowdata_del_req_retain(mdv_evt_rowdata_del_req *evt)
+{
+    return (mdv_evt_rowdata_del_req*)evt->base.vptr->retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_rowdata_del_req_release(mdv_evt_rowdata_del_req *evt)
+{
+    return evt->base.vptr->release(&evt->base);
+}
+
+
+mdv_evt_rowdata_del_remote * mdv_evt_rowdata_del_remote_create(mdv_uuid const *from,
+                                                               mdv_uuid const *to,
+                                                               uint32_t        id,
+                                                               mdv_uuid const *table,
+                                                               mdv_bitset     *partitions,
+                                                               char const     *filter)
+{
+    size_t const filter_len = strlen(filter);
+
+    static mdv_ievent vtbl =
+    {
+        .retain = (mdv_event_retain_fn)mdv_evt_rowdata_del_remote_retain,
+        .release = (mdv_event_release_fn)mdv_evt_rowdata_del_remote_release
+    };
+
+    mdv_evt_rowdata_del_remote *event = (mdv_evt_rowdata_del_remote*)
+                                mdv_event_create(
+                                    MDV_EVT_ROWDATA_DELETE_REMOTE,
+                                    sizeof(mdv_evt_rowdata_del_remote) + filter_len + 1);
+
+    if (event)
+    {
+        char *data_space = (char*)(event + 1);
+
+        memcpy(data_space, filter, filter_len + 1);
+
+        event->base.vptr    = &vtbl;
+        event->from         = *from;
+        event->to           = *to;
+        event->id           = id;
+        event->table        = *table;
+        event->partitions   = mdv_bitset_retain(partitions);
+        event->filter       = data_space;
+        event->sent         = false;
+    }
+
+    return event;
+}
+
+
+mdv_evt_rowdata_del_remote * mdv_evt_rowdata_del_remote_retain(mdv_evt_rowdata_del_remote *evt)
+{
+    return (mdv_evt_rowdata_del_remote*)mdv_event_retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_rowdata_del_remote_release(mdv_evt_rowdata_del_remote *evt)
+{
+    mdv_bitset *partitions = evt->partitions;
+
+    uint32_t rc = mdv_event_release(&evt->base);
+
+    if (!rc)
+        mdv_bitset_release(partitions);
+
+    return rc;
+}
+
+
+mdv_evt_rowdata_del_status * mdv_evt_rowdata_del_status_create(mdv_uuid const *from,
+                                                               mdv_uuid const *to,
+                                                               uint32_t        id,
+                                                               mdv_errno       err)
+{
+    mdv_evt_rowdata_del_status *event = (mdv_evt_rowdata_del_status*)
+                                mdv_event_create(
+                                    MDV_EVT_ROWDATA_DELETE_STATUS,
+                                    sizeof(mdv_evt_rowdata_del_status));
+
+    if (event)
+    {
+        event->from = *from;
+        event->to   = *to;
+        event->id   = id;
+        event->err  = err;
+    }
+
+    return event;
+}
+
+
+mdv_evt_rowdata_del_status * mdv_evt_rowdata_del_status_retain(mdv_evt_rowdata_del_status *evt)
+{
+    return (mdv_evt_rowdata_del_status*)mdv_event_retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_rowdata_del_status_release(mdv_evt_rowdata_del_status *evt)
+{
+    return mdv_event_release(&evt->base);
+}
+
+
 mdv_evt_rowdata * mdv_evt_rowdata_create(mdv_uuid const *table)
 {
     static mdv_ievent vtbl =
@@ -73,3 +196,75 @@ uint32_t mdv_evt_rowdata_release(mdv_evt_rowdata *evt)
 
     return rc;
 }
+
+
+mdv_evt_placement * mdv_evt_placement_create()
+{
+    static mdv_ievent vtbl =
+    {
+        .retain = (mdv_event_retain_fn)mdv_evt_placement_retain,
+        .release = (mdv_event_release_fn)mdv_evt_placement_release
+    };
+
+    mdv_evt_placement *event = (mdv_evt_placement*)
+                                mdv_event_create(
+                                    MDV_EVT_PLACEMENT_GET,
+                                    sizeof(mdv_evt_placement));
+
+    if (event)
+    {
+        event->base.vptr  = &vtbl;
+        event->placement  = 0;
+    }
+
+    return event;
+}
+
+
+mdv_evt_placement * mdv_evt_placement_retain(mdv_evt_placement *evt)
+{
+    return (mdv_evt_placement*)evt->base.vptr->retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_placement_release(mdv_evt_placement *evt)
+{
+    mdv_placement *placement = evt->placement;
+
+    uint32_t rc = mdv_event_release(&evt->base);
+
+    if (!rc)
+        mdv_placement_release(placement);
+
+    return rc;
+}
+
+
+mdv_evt_rowdata_compact * mdv_evt_rowdata_compact_create(uint32_t limit, bool shrink)
+{
+    mdv_evt_rowdata_compact *event = (mdv_evt_rowdata_compact*)
+                                mdv_event_create(
+                                    MDV_EVT_ROWDATA_COMPACT,
+                                    sizeof(mdv_evt_rowdata_compact));
+
+    if (event)
+    {
+        event->limit  = limit;
+        event->shrink = shrink;
+        event->purged = 0;
+    }
+
+    return event;
+}
+
+
+mdv_evt_rowdata_compact * mdv_evt_rowdata_compact_retain(mdv_evt_rowdata_compact *evt)
+{
+    return (mdv_evt_rowdata_compact*)evt->base.vptr->retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_rowdata_compact_release(mdv_evt_rowdata_compact *evt)
+{
+    return evt->base.vptr->release(&evt->base);
+}
@@ -15,6 +15,7 @@
 #include <mdv_binn.h>
 #include <mdv_bitset.h>
 #include "../storage/mdv_rowdata.h"
+#include "../storage/mdv_placement.h"
 
 
 typedef struct
@@ -29,6 +30,57 @@ mdv_evt_rowdata_ins_req * mdv_evt_rowdata_ins_req_retain(mdv_evt_rowdata_ins_req
 uint32_t                  mdv_evt_rowdata_ins_req_release(mdv_evt_rowdata_ins_req *evt);
 
 
+typedef struct
+{
+    mdv_event       base;
+    mdv_uuid        table_id;   ///< Table identifier
+    char const     *filter;     ///< Predicate for rows filtering
+} mdv_evt_rowdata_del_req;
+
+mdv_evt_rowdata_del_req * mdv_evt_rowdata_del_req_create(mdv_uuid const *table_id, char const *filter);
+mdv_evt_rowdata_del_req * mdv_evt_rowdata_del_req_retain(mdv_evt_rowdata_del_req *evt);
+uint32_t                  mdv_evt_rowdata_del_req_release(mdv_evt_rowdata_del_req *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    mdv_uuid        from;       ///< Node which requests the rows deletion
+    mdv_uuid        to;         ///< Node which stores the partitions
+    uint32_t        id;         ///< Deletion request identifier on the requesting node
+    mdv_uuid        table;      ///< Table identifier
+    mdv_bitset     *partitions; ///< Partitions mask
+    char const     *filter;     ///< Predicate for rows filtering
+    bool            sent;       ///< Flag indicates that the request is sent to the partitions owner (out)
+} mdv_evt_rowdata_del_remote;
+
+mdv_evt_rowdata_del_remote * mdv_evt_rowdata_del_remote_create(mdv_uuid const *from,
+                                                               mdv_uuid const *to,
+                                                               uint32_t        id,
+                                                               mdv_uuid const *table,
+                                                               mdv_bitset     *partitions,
+                                                               char const     *filter);
+mdv_evt_rowdata_del_remote * mdv_evt_rowdata_del_remote_retain(mdv_evt_rowdata_del_remote *evt);
+uint32_t                     mdv_evt_rowdata_del_remote_release(mdv_evt_rowdata_del_remote *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    mdv_uuid        from;       ///< Node which stores the partitions
+    mdv_uuid        to;         ///< Node which requests the rows deletion
+    uint32_t        id;         ///< Deletion request identifier on the requesting node
+    mdv_errno       err;        ///< Rows deletion result
+} mdv_evt_rowdata_del_status;
+
+mdv_evt_rowdata_del_status * mdv_evt_rowdata_del_status_create(mdv_uuid const *from,
+                                                               mdv_uuid const *to,
+                                                               uint32_t        id,
+                                                               mdv_errno       err);
+mdv_evt_rowdata_del_status * mdv_evt_rowdata_del_status_retain(mdv_evt_rowdata_del_status *evt);
+uint32_t                     mdv_evt_rowdata_del_status_release(mdv_evt_rowdata_del_status *evt);
+
+
 typedef struct
 {
     mdv_event       base;
@@ -39,3 +91,27 @@ typedef struct
 mdv_evt_rowdata * mdv_evt_rowdata_create(mdv_uuid const *table);
 mdv_evt_rowdata * mdv_evt_rowdata_retain(mdv_evt_rowdata *evt);
 uint32_t          mdv_evt_rowdata_release(mdv_evt_rowdata *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    mdv_placement  *placement;  ///< Partitioned tables rows placement (out)
+} mdv_evt_placement;
+
+mdv_evt_placement * mdv_evt_placement_create();
+mdv_evt_placement * mdv_evt_placement_retain(mdv_evt_placement *evt);
+uint32_t            mdv_evt_placement_release(mdv_evt_placement *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    uint32_t        limit;      ///< Maximum number of purged tombstones (in)
+    bool            shrink;     ///< Flag indicates that storage files should be compacted (in)
+    uint32_t        purged;     ///< Number of purged tombstones (out)
+} mdv_evt_rowdata_compact;
+
+mdv_evt_rowdata_compact * mdv_evt_rowdata_compact_create(uint32_t limit, bool shrink);
+mdv_evt_rowdata_compact * mdv_evt_rowdata_compact_retain(mdv_evt_rowdata_compact *evt);
+uint32_t                  mdv_evt_rowdata_compact_release(mdv_evt_rowdata_compact *evt);
@@ -0,0 +1,233 @@
+#include "mdv_evt_snapshot.h"
+#include "mdv_evt_types.h"
+#include <mdv_table.h>
+
+
+mdv_evt_snapshot_required * mdv_evt_snapshot_required_create()
+{
+    mdv_evt_snapshot_required *event = (mdv_evt_snapshot_required*)
+                                mdv_event_create(
+                                    MDV_EVT_SNAPSHOT_REQUIRED,
+                                    sizeof(mdv_evt_snapshot_required));
+
+    if (event)
+        event->required = false;
+
+    return event;
+}
+
+
+mdv_evt_snapshot_required * mdv_evt_snapshot_required_retain(mdv_evt_snapshot_required *evt)
+{
+    return (mdv_evt_snapshot_required*)evt->base.vptr->retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_snapshot_required_release(mdv_evt_snapshot_required *evt)
+{
+    return evt->base.vptr->release(&evt->base);
+}
+
+
+mdv_evt_create_snapshot * mdv_evt_create_snapshot_create()
+{
+    static mdv_ievent vtbl =
+    {
+        .retain = (mdv_event_retain_fn)mdv_evt_create_snapshot_retain,
+        .release = (mdv_event_release_fn)mdv_evt_create_snapshot_release
+    };
+
+    mdv_evt_create_snapshot *event = (mdv_evt_create_snapshot*)
+                                mdv_event_create(
+                                    MDV_EVT_SNAPSHOT_CREATE,
+                                    sizeof(mdv_evt_create_snapshot));
+
+    if (event)
+    {
+        event->base.vptr = &vtbl;
+        event->positions = 0;
+        event->tables    = 0;
+        event->files     = 0;
+        event->ids       = 0;
+    }
+
+    return event;
+}
+
+
+mdv_evt_create_snapshot * mdv_evt_create_snapshot_retain(mdv_evt_create_snapshot *evt)
+{
+    return (mdv_evt_create_snapshot*)mdv_event_retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_create_snapshot_release(mdv_evt_create_snapshot *evt)
+{
+    mdv_vector *positions = evt->positions;
+    mdv_vector *tables = evt->tables;
+    mdv_vector *files = evt->files;
+    mdv_vector *ids = evt->ids;
+
+    uint32_t rc = mdv_event_release(&evt->base);
+
+    if (!rc)
+    {
+        if (tables)
+        {
+            mdv_vector_foreach(tables, mdv_table_ptr, table)
+                mdv_table_release(*table);
+            mdv_vector_release(tables);
+        }
+
+        if (files)
+        {
+            mdv_vector_foreach(files, mdv_snapshot_file, file)
+                mdv_descriptor_close(file->fd);
+            mdv_vector_release(files);
+        }
+
+        mdv_vector_release(positions);
+        mdv_vector_release(ids);
+    }
+
+    return rc;
+}
+
+
+mdv_evt_snapshot_install * mdv_evt_snapshot_install_create(mdv_vector *tables, mdv_vector *positions, mdv_vector *ids)
+{
+    mdv_evt_snapshot_install *event = (mdv_evt_snapshot_install*)
+                                mdv_event_create(
+                                    MDV_EVT_SNAPSHOT_INSTALL,
+                                    sizeof(mdv_evt_snapshot_install));
+
+    if (event)
+    {
+        event->tables    = tables;
+        event->positions = positions;
+        event->ids       = ids;
+    }
+
+    return event;
+}
+
+
+mdv_evt_snapshot_install * mdv_evt_snapshot_install_retain(mdv_evt_snapshot_install *evt)
+{
+    return (mdv_evt_snapshot_install*)evt->base.vptr->retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_snapshot_install_release(mdv_evt_snapshot_install *evt)
+{
+    return evt->base.vptr->release(&evt->base);
+}
+
+
+mdv_evt_snapshot_request * mdv_evt_snapshot_request_create(mdv_uuid const *from, mdv_uuid const *to)
+{
+    mdv_evt_snapshot_request *event = (mdv_evt_snapshot_request*)
+                                mdv_event_create(
+                                    MDV_EVT_SNAPSHOT_REQUEST,
+                                    sizeof(mdv_evt_snapshot_request));
+
+    if (event)
+    {
+        event->from      = *from;
+        event->to        = *to;
+        event->supported = false;
+        event->sent      = false;
+    }
+
+    return event;
+}
+
+
+mdv_evt_snapshot_request * mdv_evt_snapshot_request_retain(mdv_evt_snapshot_request *evt)
+{
+    return (mdv_evt_snapshot_request*)evt->base.vptr->retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_snapshot_request_release(mdv_evt_snapshot_request *evt)
+{
+    return evt->base.vptr->release(&evt->base);
+}
+
+
+mdv_evt_snapshot_data * mdv_evt_snapshot_data_create(mdv_uuid const *from,
+                                                     mdv_uuid const *to,
+                                                     mdv_uuid const *table,
+                                                     uint64_t offset,
+                                                     uint64_t total,
+                                                     uint32_t size,
+                                                     void const *data)
+{
+    mdv_evt_snapshot_data *event = (mdv_evt_snapshot_data*)
+                                mdv_event_create(
+                                    MDV_EVT_SNAPSHOT_DATA,
+                                    sizeof(mdv_evt_snapshot_data));
+
+    if (event)
+    {
+        event->from   = *from;
+        event->to     = *to;
+        event->table  = *table;
+        event->offset = offset;
+        event->total  = total;
+        event->size   = size;
+        event->data   = data;
+    }
+
+    return event;
+}
+
+
+mdv_evt_snapshot_data * mdv_evt_snapshot_data_retain(mdv_evt_snapshot_data *evt)
+{
+    return (mdv_evt_snapshot_data*)evt->base.vptr->retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_snapshot_data_release(mdv_evt_snapshot_data *evt)
+{
+    return evt->base.vptr->release(&evt->base);
+}
+
+
+mdv_evt_snapshot * mdv_evt_snapshot_create(mdv_uuid const *from,
+                                           mdv_uuid const *to,
+                                           int err,
+                                           mdv_vector *tables,
+                                           mdv_vector *positions,
+                                           mdv_vector *ids)
+{
+    mdv_evt_snapshot *event = (mdv_evt_snapshot*)
+                                mdv_event_create(
+                                    MDV_EVT_SNAPSHOT,
+                                    sizeof(mdv_evt_snapshot));
+
+    if (event)
+    {
+        event->from      = *from;
+        event->to        = *to;
+        event->err       = err;
+        event->tables    = tables;
+        event->positions = positions;
+        event->ids       = ids;
+    }
+
+    return event;
+}
+
+
+mdv_evt_snapshot * mdv_evt_snapshot_retain(mdv_evt_snapshot *evt)
+{
+    return (mdv_evt_snapshot*)evt->base.vptr->retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_snapshot_release(mdv_evt_snapshot *evt)
+{
+    return evt->base.vptr->release(&evt->base);
+}
@@ -0,0 +1,120 @@
+/**
+ * @file mdv_evt_snapshot.h
+ * @author Vladislav Volkov (wwwvladislav@gmail.com)
+ * @brief Tables storages snapshot events definitions
+ * @version 0.1
+ * @date 2020-05-18
+ *
+ * @copyright Copyright (c) 2020, Vladislav Volkov
+ *
+ */
+#pragma once
+#include <mdv_ebus.h>
+#include <mdv_uuid.h>
+#include <mdv_vector.h>
+#include <mdv_def.h>
+
+
+/// Table storage copy
+typedef struct
+{
+    mdv_uuid        table;      ///< Table UUID
+    mdv_descriptor  fd;         ///< Temporary file with the table storage copy
+    size_t          size;       ///< Table storage copy size
+} mdv_snapshot_file;
+
+
+typedef struct
+{
+    mdv_event       base;
+    bool            required;   ///< Flag indicates that the node is empty and it should be bootstrapped from snapshot (out)
+} mdv_evt_snapshot_required;
+
+mdv_evt_snapshot_required * mdv_evt_snapshot_required_create();
+mdv_evt_snapshot_required * mdv_evt_snapshot_required_retain(mdv_evt_snapshot_required *evt);
+uint32_t                    mdv_evt_snapshot_required_release(mdv_evt_snapshot_required *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    mdv_vector     *positions;  ///< Transaction logs positions covered by snapshot (vector<mdv_trlog_pos>) (out)
+    mdv_vector     *tables;     ///< Tables descriptors (vector<mdv_table*>) (out)
+    mdv_vector     *files;      ///< Tables storages copies (vector<mdv_snapshot_file>) (out)
+    mdv_vector     *ids;        ///< Storage identifiers used in the tables storages (vector<mdv_storage_id>) (out)
+} mdv_evt_create_snapshot;
+
+mdv_evt_create_snapshot * mdv_evt_create_snapshot_create();
+mdv_evt_create_snapshot * mdv_evt_create_snapshot_retain(mdv_evt_create_snapshot *evt);
+uint32_t                  mdv_evt_create_snapshot_release(mdv_evt_create_snapshot *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    mdv_vector     *tables;     ///< Tables descriptors (vector<mdv_table*>) (event doesn't own the vector)
+    mdv_vector     *positions;  ///< Transaction logs positions covered by snapshot (vector<mdv_trlog_pos>) (event doesn't own the vector)
+    mdv_vector     *ids;        ///< Sender storage identifiers used in the tables storages (vector<mdv_storage_id>) (event doesn't own the vector)
+} mdv_evt_snapshot_install;
+
+mdv_evt_snapshot_install * mdv_evt_snapshot_install_create(mdv_vector *tables, mdv_vector *positions, mdv_vector *ids);
+mdv_evt_snapshot_install * mdv_evt_snapshot_install_retain(mdv_evt_snapshot_install *evt);
+uint32_t                   mdv_evt_snapshot_install_release(mdv_evt_snapshot_install *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    mdv_uuid        from;       ///< Source peer UUID
+    mdv_uuid        to;         ///< Destination peer UUID
+    bool            supported;  ///< Flag indicates that the destination peer sends snapshots (out)
+    bool            sent;       ///< Flag indicates that the request is sent to the destination peer (out)
+} mdv_evt_snapshot_request;
+
+mdv_evt_snapshot_request * mdv_evt_snapshot_request_create(mdv_uuid const *from, mdv_uuid const *to);
+mdv_evt_snapshot_request * mdv_evt_snapshot_request_retain(mdv_evt_snapshot_request *evt);
+uint32_t                   mdv_evt_snapshot_request_release(mdv_evt_snapshot_request *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    mdv_uuid        from;       ///< Source peer UUID
+    mdv_uuid        to;         ///< Destination peer UUID
+    mdv_uuid        table;      ///< Table UUID
+    uint64_t        offset;     ///< Chunk offset in the table storage copy
+    uint64_t        total;      ///< Table storage copy size
+    uint32_t        size;       ///< Chunk size
+    void const     *data;       ///< Chunk data (event doesn't own the data)
+} mdv_evt_snapshot_data;
+
+mdv_evt_snapshot_data * mdv_evt_snapshot_data_create(mdv_uuid const *from,
+                                                     mdv_uuid const *to,
+                                                     mdv_uuid const *table,
+                                                     uint64_t offset,
+                                                     uint64_t total,
+                                                     uint32_t size,
+                                                     void const *data);
+mdv_evt_snapshot_data * mdv_evt_snapshot_data_retain(mdv_evt_snapshot_data *evt);
+uint32_t                mdv_evt_snapshot_data_release(mdv_evt_snapshot_data *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    mdv_uuid        from;       ///< Source peer UUID
+    mdv_uuid        to;         ///< Destination peer UUID
+    int             err;        ///< Snapshot creation result
+    mdv_vector     *tables;     ///< Tables descriptors (vector<mdv_table*>) (event doesn't own the vector)
+    mdv_vector     *positions;  ///< Transaction logs positions covered by snapshot (vector<mdv_trlog_pos>) (event doesn't own the vector)
+    mdv_vector     *ids;        ///< Sender storage identifiers used in the tables storages (vector<mdv_storage_id>) (event doesn't own the vector)
+} mdv_evt_snapshot;
+
+mdv_evt_snapshot * mdv_evt_snapshot_create(mdv_uuid const *from,
+                                           mdv_uuid const *to,
+                                           int err,
+                                           mdv_vector *tables,
+                                           mdv_vector *positions,
+                                           mdv_vector *ids);
+mdv_evt_snapshot * mdv_evt_snapshot_retain(mdv_evt_snapshot *evt);
+uint32_t           mdv_evt_snapshot_release(mdv_evt_snapshot *evt);
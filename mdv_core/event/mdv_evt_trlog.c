@@ -72,7 +72,7 @@ uint32_t mdv_evt_trlog_changed_release(mdv_evt_trlog_changed *evt)
 }
 
 
-mdv_evt_trlog_apply * mdv_evt_trlog_apply_create(mdv_uuid const *trlog)
+mdv_evt_trlog_apply * mdv_evt_trlog_apply_create(mdv_uuid const *trlog, mdv_jobber *jobber)
 {
     mdv_evt_trlog_apply *event = (mdv_evt_trlog_apply*)
                                 mdv_event_create(
@@ -80,7 +80,10 @@ mdv_evt_trlog_apply * mdv_evt_trlog_apply_create(mdv_uuid const *trlog)
                                     sizeof(mdv_evt_trlog_apply));
 
     if (event)
+    {
         event->trlog = *trlog;
+        event->jobber = jobber;
+    }
 
     return event;
 }
@@ -159,7 +162,7 @@ uint32_t mdv_evt_trlog_state_release(mdv_evt_trlog_state *evt)
 }
 
 
-mdv_evt_trlog_data * mdv_evt_trlog_data_create(mdv_uuid const *trlog, mdv_uuid const *from, mdv_uuid const *to, mdv_list *rows, uint32_t count)
+mdv_evt_trlog_data * mdv_evt_trlog_data_create(mdv_uuid const *trlog, mdv_uuid const *from, mdv_uuid const *to, uint64_t start, mdv_list *rows, uint32_t count)
 {
     static mdv_ievent vtbl =
     {
@@ -178,6 +181,7 @@ mdv_evt_trlog_data * mdv_evt_trlog_data_create(mdv_uuid const *trlog, mdv_uuid c
         event->from      = *from;
         event->to        = *to;
         event->trlog     = *trlog;
+        event->start     = start;
         event->count     = count;
         event->rows      = mdv_list_move(rows);
     }
@@ -203,3 +207,62 @@ uint32_t mdv_evt_trlog_data_release(mdv_evt_trlog_data *evt)
 
     return rc;
 }
+
+
+mdv_evt_trlog_truncate * mdv_evt_trlog_truncate_create(uint32_t batch_size, uint64_t keep)
+{
+    mdv_evt_trlog_truncate *event = (mdv_evt_trlog_truncate*)
+                                mdv_event_create(
+                                    MDV_EVT_TRLOG_TRUNCATE,
+                                    sizeof(mdv_evt_trlog_truncate));
+
+    if (event)
+    {
+        event->batch_size = batch_size;
+        event->keep       = keep;
+        event->truncated  = 0;
+    }
+
+    return event;
+}
+
+
+mdv_evt_trlog_truncate * mdv_evt_trlog_truncate_retain(mdv_evt_trlog_truncate *evt)
+{
+    return (mdv_evt_trlog_truncate*)evt->base.vptr->retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_trlog_truncate_release(mdv_evt_trlog_truncate *evt)
+{
+    return evt->base.vptr->release(&evt->base);
+}
+
+
+mdv_evt_trlog_filter * mdv_evt_trlog_filter_create(mdv_uuid const *to, mdv_list *rows)
+{
+    mdv_evt_trlog_filter *event = (mdv_evt_trlog_filter*)
+                                mdv_event_create(
+                                    MDV_EVT_TRLOG_FILTER,
+                                    sizeof(mdv_evt_trlog_filter));
+
+    if (event)
+    {
+        event->to   = *to;
+        event->rows = rows;
+    }
+
+    return event;
+}
+
+
+mdv_evt_trlog_filter * mdv_evt_trlog_filter_retain(mdv_evt_trlog_filter *evt)
+{
+    return (mdv_evt_trlog_filter*)evt->base.vptr->retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_trlog_filter_release(mdv_evt_trlog_filter *evt)
+{
+    return evt->base.vptr->release(&evt->base);
+}
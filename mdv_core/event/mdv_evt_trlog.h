@@ -11,6 +11,7 @@
 #pragma once
 #include <mdv_ebus.h>
 #include <mdv_uuid.h>
+#include <mdv_jobber.h>
 #include "../storage/mdv_trlog.h"
 
 
@@ -42,9 +43,10 @@ typedef struct
 {
     mdv_event       base;
     mdv_uuid        trlog;      ///< Transaction log UUID
+    mdv_jobber     *jobber;     ///< Jobs scheduler for concurrent tables updating (may be NULL)
 } mdv_evt_trlog_apply;
 
-mdv_evt_trlog_apply * mdv_evt_trlog_apply_create(mdv_uuid const *trlog);
+mdv_evt_trlog_apply * mdv_evt_trlog_apply_create(mdv_uuid const *trlog, mdv_jobber *jobber);
 mdv_evt_trlog_apply * mdv_evt_trlog_apply_retain(mdv_evt_trlog_apply *evt);
 uint32_t              mdv_evt_trlog_apply_release(mdv_evt_trlog_apply *evt);
 
@@ -82,10 +84,36 @@ typedef struct
     mdv_uuid        from;       ///< Source peer UUID
     mdv_uuid        to;         ///< Destination peer UUID for synchronization
     mdv_uuid        trlog;      ///< Transaction log UUID
+    uint64_t        start;      ///< First transaction log position covered by records
     uint32_t        count;      ///< log records count
     mdv_list        rows;       ///< transaction log data (list<mdv_trlog_data>)
 } mdv_evt_trlog_data;
 
-mdv_evt_trlog_data * mdv_evt_trlog_data_create(mdv_uuid const *trlog, mdv_uuid const *from, mdv_uuid const *to, mdv_list *rows, uint32_t count);
+mdv_evt_trlog_data * mdv_evt_trlog_data_create(mdv_uuid const *trlog, mdv_uuid const *from, mdv_uuid const *to, uint64_t start, mdv_list *rows, uint32_t count);
 mdv_evt_trlog_data * mdv_evt_trlog_data_retain(mdv_evt_trlog_data *evt);
 uint32_t             mdv_evt_trlog_data_release(mdv_evt_trlog_data *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    uint32_t        batch_size; ///< Maximum number of records deleted in one transaction (in)
+    uint64_t        keep;       ///< Number of records which are kept for late joiners (in)
+    uint64_t        truncated;  ///< Number of deleted records (out)
+} mdv_evt_trlog_truncate;
+
+mdv_evt_trlog_truncate * mdv_evt_trlog_truncate_create(uint32_t batch_size, uint64_t keep);
+mdv_evt_trlog_truncate * mdv_evt_trlog_truncate_retain(mdv_evt_trlog_truncate *evt);
+uint32_t                 mdv_evt_trlog_truncate_release(mdv_evt_trlog_truncate *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    mdv_uuid        to;         ///< Destination peer UUID (in)
+    mdv_list       *rows;       ///< Transaction log data (list<mdv_trlog_data>). Operations which aren't required by peer are emptied. (event doesn't own the list)
+} mdv_evt_trlog_filter;
+
+mdv_evt_trlog_filter * mdv_evt_trlog_filter_create(mdv_uuid const *to, mdv_list *rows);
+mdv_evt_trlog_filter * mdv_evt_trlog_filter_retain(mdv_evt_trlog_filter *evt);
+uint32_t               mdv_evt_trlog_filter_release(mdv_evt_trlog_filter *evt);
@@ -23,18 +23,36 @@ enum
     MDV_EVT_TABLE_GET,
     MDV_EVT_TABLES_GET,
     MDV_EVT_ROWDATA_INSERT,
+    MDV_EVT_ROWDATA_DELETE,
+    MDV_EVT_ROWDATA_DELETE_REMOTE,
+    MDV_EVT_ROWDATA_DELETE_STATUS,
     MDV_EVT_ROWDATA_GET,
+    MDV_EVT_ROWDATA_COMPACT,
+    MDV_EVT_PLACEMENT_GET,
     MDV_EVT_TRLOG_GET,
     MDV_EVT_TRLOG_CHANGED,
     MDV_EVT_TRLOG_APPLY,
     MDV_EVT_TRLOG_SYNC,
     MDV_EVT_TRLOG_STATE,
     MDV_EVT_TRLOG_DATA,
+    MDV_EVT_TRLOG_TRUNCATE,
+    MDV_EVT_TRLOG_FILTER,
     MDV_EVT_SELECT,
     MDV_EVT_VIEW,
     MDV_EVT_VIEW_FETCH,
     MDV_EVT_VIEW_DATA,
+    MDV_EVT_VIEW_STREAM,
+    MDV_EVT_VIEW_STREAM_DATA,
+    MDV_EVT_VIEW_OPEN,
+    MDV_EVT_VIEW_READ,
+    MDV_EVT_VIEW_ROWS,
     MDV_EVT_STATUS,
+    MDV_EVT_SNAPSHOT_REQUIRED,
+    MDV_EVT_SNAPSHOT_CREATE,
+    MDV_EVT_SNAPSHOT_INSTALL,
+    MDV_EVT_SNAPSHOT_REQUEST,
+    MDV_EVT_SNAPSHOT_DATA,
+    MDV_EVT_SNAPSHOT,
     MDV_EVT_COUNT
 };
 
@@ -94,7 +94,9 @@ uint32_t mdv_evt_view_release(mdv_evt_view *evt)
 
 mdv_evt_view_fetch * mdv_evt_view_fetch_create(mdv_uuid const  *session,
                                                uint16_t         request_id,
-                                               uint32_t         view_id)
+                                               uint32_t         view_id,
+                                               uint32_t         count,
+                                               uint32_t         bytes)
 {
     mdv_evt_view_fetch *event = (mdv_evt_view_fetch*)
                                 mdv_event_create(
@@ -106,6 +108,8 @@ mdv_evt_view_fetch * mdv_evt_view_fetch_create(mdv_uuid const  *session,
         event->session    = *session;
         event->request_id = request_id;
         event->view_id    = view_id;
+        event->count      = count;
+        event->bytes      = bytes;
     }
 
     return event;
@@ -154,3 +158,219 @@ uint32_t mdv_evt_view_data_release(mdv_evt_view_data *evt)
 {
     return mdv_event_release(&evt->base);
 }
+
+
+mdv_evt_view_stream * mdv_evt_view_stream_create(mdv_uuid const  *session,
+                                                 uint16_t         request_id,
+                                                 uint32_t         view_id,
+                                                 uint32_t         credits,
+                                                 uint32_t         count,
+                                                 uint32_t         bytes)
+{
+    mdv_evt_view_stream *event = (mdv_evt_view_stream*)
+                                mdv_event_create(
+                                    MDV_EVT_VIEW_STREAM,
+                                    sizeof(mdv_evt_view_stream));
+
+    if (event)
+    {
+        event->session    = *session;
+        event->request_id = request_id;
+        event->view_id    = view_id;
+        event->credits    = credits;
+        event->count      = count;
+        event->bytes      = bytes;
+    }
+
+    return event;
+}
+
+
+mdv_evt_view_stream * mdv_evt_view_stream_retain(mdv_evt_view_stream *evt)
+{
+    return (mdv_evt_view_stream*)mdv_event_retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_view_stream_release(mdv_evt_view_stream *evt)
+{
+    return mdv_event_release(&evt->base);
+}
+
+
+mdv_evt_view_stream_data * mdv_evt_view_stream_data_create(mdv_uuid const  *session,
+                                                           uint16_t         request_id,
+                                                           uint32_t         view_id,
+                                                           binn            *rows)
+{
+    mdv_evt_view_stream_data *event = (mdv_evt_view_stream_data*)
+                                mdv_event_create(
+                                    MDV_EVT_VIEW_STREAM_DATA,
+                                    sizeof(mdv_evt_view_stream_data));
+
+    if (event)
+    {
+        event->session    = *session;
+        event->request_id = request_id;
+        event->view_id    = view_id;
+        event->rows       = rows;
+    }
+
+    return event;
+}
+
+
+mdv_evt_view_stream_data * mdv_evt_view_stream_data_retain(mdv_evt_view_stream_data *evt)
+{
+    return (mdv_evt_view_stream_data*)mdv_event_retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_view_stream_data_release(mdv_evt_view_stream_data *evt)
+{
+    return mdv_event_release(&evt->base);
+}
+
+
+mdv_evt_view_open * mdv_evt_view_open_create(mdv_uuid const  *from,
+                                             mdv_uuid const  *to,
+                                             uint32_t         id,
+                                             mdv_uuid const  *table,
+                                             mdv_bitset      *fields,
+                                             mdv_bitset      *partitions,
+                                             char const      *filter,
+                                             uint32_t         count,
+                                             uint32_t         bytes)
+{
+    size_t const filter_len = strlen(filter);
+
+    static mdv_ievent vtbl =
+    {
+        .retain = (mdv_event_retain_fn)mdv_evt_view_open_retain,
+        .release = (mdv_event_release_fn)mdv_evt_view_open_release
+    };
+
+    mdv_evt_view_open *event = (mdv_evt_view_open*)
+                                mdv_event_create(
+                                    MDV_EVT_VIEW_OPEN,
+                                    sizeof(mdv_evt_view_open) + filter_len + 1);
+
+    if (event)
+    {
+        char *data_space = (char*)(event + 1);
+
+        memcpy(data_space, filter, filter_len + 1);
+
+        event->base.vptr    = &vtbl;
+        event->from         = *from;
+        event->to           = *to;
+        event->id           = id;
+        event->table        = *table;
+        event->fields       = mdv_bitset_retain(fields);
+        event->partitions   = mdv_bitset_retain(partitions);
+        event->filter       = data_space;
+        event->count        = count;
+        event->bytes        = bytes;
+    }
+
+    return event;
+}
+
+
+mdv_evt_view_open * mdv_evt_view_open_retain(mdv_evt_view_open *evt)
+{
+    return (mdv_evt_view_open*)mdv_event_retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_view_open_release(mdv_evt_view_open *evt)
+{
+    mdv_bitset *fields = evt->fields;
+    mdv_bitset *partitions = evt->partitions;
+
+    uint32_t rc = mdv_event_release(&evt->base);
+
+    if (!rc)
+    {
+        mdv_bitset_release(fields);
+        mdv_bitset_release(partitions);
+    }
+
+    return rc;
+}
+
+
+mdv_evt_view_read * mdv_evt_view_read_create(mdv_uuid const  *from,
+                                             mdv_uuid const  *to,
+                                             uint32_t         id,
+                                             uint32_t         view_id,
+                                             uint32_t         count,
+                                             uint32_t         bytes)
+{
+    mdv_evt_view_read *event = (mdv_evt_view_read*)
+                                mdv_event_create(
+                                    MDV_EVT_VIEW_READ,
+                                    sizeof(mdv_evt_view_read));
+
+    if (event)
+    {
+        event->from       = *from;
+        event->to         = *to;
+        event->id         = id;
+        event->view_id    = view_id;
+        event->count      = count;
+        event->bytes      = bytes;
+    }
+
+    return event;
+}
+
+
+mdv_evt_view_read * mdv_evt_view_read_retain(mdv_evt_view_read *evt)
+{
+    return (mdv_evt_view_read*)mdv_event_retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_view_read_release(mdv_evt_view_read *evt)
+{
+    return mdv_event_release(&evt->base);
+}
+
+
+mdv_evt_view_rows * mdv_evt_view_rows_create(mdv_uuid const  *from,
+                                             mdv_uuid const  *to,
+                                             uint32_t         id,
+                                             uint32_t         view_id,
+                                             mdv_errno        err,
+                                             binn            *rows)
+{
+    mdv_evt_view_rows *event = (mdv_evt_view_rows*)
+                                mdv_event_create(
+                                    MDV_EVT_VIEW_ROWS,
+                                    sizeof(mdv_evt_view_rows));
+
+    if (event)
+    {
+        event->from       = *from;
+        event->to         = *to;
+        event->id         = id;
+        event->view_id    = view_id;
+        event->err        = err;
+        event->rows       = rows;
+    }
+
+    return event;
+}
+
+
+mdv_evt_view_rows * mdv_evt_view_rows_retain(mdv_evt_view_rows *evt)
+{
+    return (mdv_evt_view_rows*)mdv_event_retain(&evt->base);
+}
+
+
+uint32_t mdv_evt_view_rows_release(mdv_evt_view_rows *evt)
+{
+    return mdv_event_release(&evt->base);
+}
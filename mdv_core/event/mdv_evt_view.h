@@ -55,11 +55,15 @@ typedef struct
     mdv_uuid        session;    ///< Session identifier
     uint16_t        request_id; ///< Request identifier (used to associate requests and responses)
     uint32_t        view_id;    ///< View identifier
+    uint32_t        count;      ///< Rows number limit (zero means default limit)
+    uint32_t        bytes;      ///< Serialized rows size limit (zero means default limit)
 } mdv_evt_view_fetch;
 
 mdv_evt_view_fetch * mdv_evt_view_fetch_create(mdv_uuid const  *session,
                                                uint16_t         request_id,
-                                               uint32_t         view_id);
+                                               uint32_t         view_id,
+                                               uint32_t         count,
+                                               uint32_t         bytes);
 mdv_evt_view_fetch * mdv_evt_view_fetch_retain(mdv_evt_view_fetch *evt);
 uint32_t             mdv_evt_view_fetch_release(mdv_evt_view_fetch *evt);
 
@@ -78,3 +82,110 @@ mdv_evt_view_data * mdv_evt_view_data_create(mdv_uuid const  *session,
                                              binn            *rows);
 mdv_evt_view_data * mdv_evt_view_data_retain(mdv_evt_view_data *evt);
 uint32_t            mdv_evt_view_data_release(mdv_evt_view_data *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    mdv_uuid        session;    ///< Session identifier
+    uint16_t        request_id; ///< Request identifier (used to associate requests and responses)
+    uint32_t        view_id;    ///< View identifier
+    uint32_t        credits;    ///< Number of rows batches which can be pushed to the client
+    uint32_t        count;      ///< Rows number limit (zero means default limit)
+    uint32_t        bytes;      ///< Serialized rows size limit (zero means default limit)
+} mdv_evt_view_stream;
+
+mdv_evt_view_stream * mdv_evt_view_stream_create(mdv_uuid const  *session,
+                                                 uint16_t         request_id,
+                                                 uint32_t         view_id,
+                                                 uint32_t         credits,
+                                                 uint32_t         count,
+                                                 uint32_t         bytes);
+mdv_evt_view_stream * mdv_evt_view_stream_retain(mdv_evt_view_stream *evt);
+uint32_t              mdv_evt_view_stream_release(mdv_evt_view_stream *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    mdv_uuid        session;    ///< Session identifier
+    uint16_t        request_id; ///< Request identifier (used to associate requests and responses)
+    uint32_t        view_id;    ///< View identifier
+    binn           *rows;       ///< Serialized rows (empty list is the end of stream)
+} mdv_evt_view_stream_data;
+
+mdv_evt_view_stream_data * mdv_evt_view_stream_data_create(mdv_uuid const  *session,
+                                                           uint16_t         request_id,
+                                                           uint32_t         view_id,
+                                                           binn            *rows);
+mdv_evt_view_stream_data * mdv_evt_view_stream_data_retain(mdv_evt_view_stream_data *evt);
+uint32_t                   mdv_evt_view_stream_data_release(mdv_evt_view_stream_data *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    mdv_uuid        from;       ///< Node which requests the rows
+    mdv_uuid        to;         ///< Node which stores the partitions
+    uint32_t        id;         ///< Remote view identifier on the requesting node
+    mdv_uuid        table;      ///< Table identifier
+    mdv_bitset     *fields;     ///< Fields mask
+    mdv_bitset     *partitions; ///< Partitions mask
+    char const     *filter;     ///< Predicate for rows filtering
+    uint32_t        count;      ///< Rows number limit for the first batch
+    uint32_t        bytes;      ///< Serialized rows size limit for the first batch
+} mdv_evt_view_open;
+
+mdv_evt_view_open * mdv_evt_view_open_create(mdv_uuid const  *from,
+                                             mdv_uuid const  *to,
+                                             uint32_t         id,
+                                             mdv_uuid const  *table,
+                                             mdv_bitset      *fields,
+                                             mdv_bitset      *partitions,
+                                             char const      *filter,
+                                             uint32_t         count,
+                                             uint32_t         bytes);
+mdv_evt_view_open * mdv_evt_view_open_retain(mdv_evt_view_open *evt);
+uint32_t            mdv_evt_view_open_release(mdv_evt_view_open *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    mdv_uuid        from;       ///< Node which requests the rows
+    mdv_uuid        to;         ///< Node which stores the partitions
+    uint32_t        id;         ///< Remote view identifier on the requesting node
+    uint32_t        view_id;    ///< View identifier on the partitions owner
+    uint32_t        count;      ///< Rows number limit
+    uint32_t        bytes;      ///< Serialized rows size limit
+} mdv_evt_view_read;
+
+mdv_evt_view_read * mdv_evt_view_read_create(mdv_uuid const  *from,
+                                             mdv_uuid const  *to,
+                                             uint32_t         id,
+                                             uint32_t         view_id,
+                                             uint32_t         count,
+                                             uint32_t         bytes);
+mdv_evt_view_read * mdv_evt_view_read_retain(mdv_evt_view_read *evt);
+uint32_t            mdv_evt_view_read_release(mdv_evt_view_read *evt);
+
+
+typedef struct
+{
+    mdv_event       base;
+    mdv_uuid        from;       ///< Node which stores the partitions
+    mdv_uuid        to;         ///< Node which requests the rows
+    uint32_t        id;         ///< Remote view identifier on the requesting node
+    uint32_t        view_id;    ///< View identifier on the partitions owner
+    mdv_errno       err;        ///< Rows reading result
+    binn           *rows;       ///< Serialized rows (empty list is the end of view)
+} mdv_evt_view_rows;
+
+mdv_evt_view_rows * mdv_evt_view_rows_create(mdv_uuid const  *from,
+                                             mdv_uuid const  *to,
+                                             uint32_t         id,
+                                             uint32_t         view_id,
+                                             mdv_errno        err,
+                                             binn            *rows);
+mdv_evt_view_rows * mdv_evt_view_rows_retain(mdv_evt_view_rows *evt);
+uint32_t            mdv_evt_view_rows_release(mdv_evt_view_rows *evt);
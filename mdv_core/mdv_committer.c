@@ -53,7 +53,7 @@ static void mdv_committer_fn(mdv_job_base *job)
 
     do
     {
-        mdv_evt_trlog_apply *apply = mdv_evt_trlog_apply_create(&ctx->log_committer->trlog);
+        mdv_evt_trlog_apply *apply = mdv_evt_trlog_apply_create(&ctx->log_committer->trlog, committer->jobber);
 
         if (apply)
         {
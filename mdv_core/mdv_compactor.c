@@ -0,0 +1,273 @@
+#include "mdv_compactor.h"
+#include "mdv_config.h"
+#include "event/mdv_evt_types.h"
+#include "event/mdv_evt_rowdata.h"
+#include "event/mdv_evt_trlog.h"
+#include <stdatomic.h>
+#include <mdv_alloc.h>
+#include <mdv_log.h>
+#include <mdv_rollbacker.h>
+#include <mdv_threads.h>
+#include <mdv_time.h>
+
+
+/// Tombstones compactor
+struct mdv_compactor
+{
+    atomic_uint             rc;             ///< References counter
+    mdv_ebus               *ebus;           ///< Event bus
+    mdv_jobber             *jobber;         ///< Jobs scheduler
+    atomic_size_t           active_jobs;    ///< Active jobs counter
+    atomic_size_t           last_run;       ///< Last compaction time (in milliseconds)
+
+    struct
+    {
+        atomic_uint_fast64_t runs;          ///< Number of compactions
+        atomic_uint_fast64_t purged;        ///< Number of purged tombstones
+        atomic_uint_fast64_t truncated;     ///< Number of deleted transaction log records
+    } stat;                                 ///< Compaction statistics
+};
+
+
+typedef struct mdv_compactor_context
+{
+    mdv_compactor     *compactor;       ///< Tombstones compactor
+} mdv_compactor_context;
+
+
+typedef mdv_job(mdv_compactor_context)     mdv_compactor_job;
+
+
+static void mdv_compactor_tombstones_purge(mdv_compactor *compactor)
+{
+    mdv_evt_rowdata_compact *compact = mdv_evt_rowdata_compact_create(MDV_CONFIG.compactor.batch_size,
+                                                                      MDV_CONFIG.compactor.shrink);
+
+    if (!compact)
+    {
+        MDV_LOGE("No memory for 'Rowdata compact' message");
+        return;
+    }
+
+    if (mdv_ebus_publish(compactor->ebus, &compact->base, MDV_EVT_SYNC) != MDV_OK)
+        MDV_LOGE("Tombstones compaction failed");
+
+    uint64_t const purged = atomic_fetch_add_explicit(&compactor->stat.purged, compact->purged, memory_order_relaxed) + compact->purged;
+
+    if (compact->purged)
+        MDV_LOGI("Tombstones compaction: %u purged (total purged: %llu)",
+                 compact->purged,
+                 (unsigned long long)purged);
+
+    mdv_evt_rowdata_compact_release(compact);
+}
+
+
+static void mdv_compactor_trlogs_truncate(mdv_compactor *compactor)
+{
+    mdv_evt_trlog_truncate *truncate = mdv_evt_trlog_truncate_create(MDV_CONFIG.compactor.batch_size,
+                                                                     MDV_CONFIG.compactor.trlog_keep);
+
+    if (!truncate)
+    {
+        MDV_LOGE("No memory for 'TR log truncate' message");
+        return;
+    }
+
+    if (mdv_ebus_publish(compactor->ebus, &truncate->base, MDV_EVT_SYNC) != MDV_OK)
+        MDV_LOGE("Transaction logs truncation failed");
+
+    uint64_t const truncated = atomic_fetch_add_explicit(&compactor->stat.truncated, truncate->truncated, memory_order_relaxed) + truncate->truncated;
+
+    if (truncate->truncated)
+        MDV_LOGI("Transaction logs truncation: %llu records deleted (total deleted: %llu)",
+                 (unsigned long long)truncate->truncated,
+                 (unsigned long long)truncated);
+
+    mdv_evt_trlog_truncate_release(truncate);
+}
+
+
+static void mdv_compactor_fn(mdv_job_base *job)
+{
+    mdv_compactor_context *ctx       = (mdv_compactor_context *)job->data;
+    mdv_compactor         *compactor = ctx->compactor;
+
+    mdv_compactor_tombstones_purge(compactor);
+
+    mdv_compactor_trlogs_truncate(compactor);
+
+    atomic_fetch_add_explicit(&compactor->stat.runs, 1, memory_order_relaxed);
+}
+
+
+static void mdv_compactor_finalize(mdv_job_base *job)
+{
+    mdv_compactor_context *ctx = (mdv_compactor_context *)job->data;
+    mdv_compactor         *compactor = ctx->compactor;
+    atomic_store_explicit(&compactor->last_run, mdv_gettime(), memory_order_relaxed);
+    atomic_fetch_sub_explicit(&compactor->active_jobs, 1, memory_order_relaxed);
+    mdv_compactor_release(compactor);
+    mdv_free(job);
+}
+
+
+static mdv_errno mdv_compactor_job_emit(mdv_compactor *compactor)
+{
+    mdv_compactor_job *job = mdv_alloc(sizeof(mdv_compactor_job));
+
+    if (!job)
+    {
+        MDV_LOGE("No memory for compaction job");
+        return MDV_NO_MEM;
+    }
+
+    job->fn             = mdv_compactor_fn;
+    job->finalize       = mdv_compactor_finalize;
+    job->data.compactor = mdv_compactor_retain(compactor);
+
+    atomic_fetch_add_explicit(&compactor->active_jobs, 1, memory_order_relaxed);
+
+    mdv_errno err = mdv_jobber_push(compactor->jobber, (mdv_job_base*)job);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Compaction job failed");
+        atomic_fetch_sub_explicit(&compactor->active_jobs, 1, memory_order_relaxed);
+        mdv_compactor_release(compactor);
+        mdv_free(job);
+    }
+
+    return err;
+}
+
+
+static mdv_errno mdv_compactor_start(mdv_compactor *compactor)
+{
+    size_t const now = mdv_gettime();
+    size_t last_run = atomic_load_explicit(&compactor->last_run, memory_order_relaxed);
+
+    if (now < last_run + MDV_CONFIG.compactor.interval * 1000ull)
+        return MDV_OK;
+
+    // Only one compaction job is started per interval
+    if (!atomic_compare_exchange_strong(&compactor->last_run, &last_run, now))
+        return MDV_OK;
+
+    return mdv_compactor_job_emit(compactor);
+}
+
+
+static mdv_errno mdv_compactor_evt_trlog_apply(void *arg, mdv_event *event)
+{
+    (void)event;
+    return mdv_compactor_start(arg);
+}
+
+
+static mdv_errno mdv_compactor_evt_trlog_state(void *arg, mdv_event *event)
+{
+    (void)event;
+    return mdv_compactor_start(arg);
+}
+
+
+static const mdv_event_handler_type mdv_compactor_handlers[] =
+{
+    { MDV_EVT_TRLOG_APPLY,      mdv_compactor_evt_trlog_apply },
+    { MDV_EVT_TRLOG_STATE,      mdv_compactor_evt_trlog_state },
+};
+
+
+mdv_compactor * mdv_compactor_create(mdv_ebus *ebus, mdv_jobber_config const *jconfig)
+{
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
+
+    mdv_compactor *compactor = mdv_alloc(sizeof(mdv_compactor));
+
+    if (!compactor)
+    {
+        MDV_LOGE("No memory for new compactor");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_free, compactor);
+
+    atomic_init(&compactor->rc, 1);
+    atomic_init(&compactor->active_jobs, 0);
+    atomic_init(&compactor->last_run, mdv_gettime());
+    atomic_init(&compactor->stat.runs, 0);
+    atomic_init(&compactor->stat.purged, 0);
+    atomic_init(&compactor->stat.truncated, 0);
+
+    compactor->ebus = mdv_ebus_retain(ebus);
+
+    mdv_rollbacker_push(rollbacker, mdv_ebus_release, compactor->ebus);
+
+    compactor->jobber = mdv_jobber_create(jconfig);
+
+    if (!compactor->jobber)
+    {
+        MDV_LOGE("Jobs scheduler creation failed");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_jobber_release, compactor->jobber);
+
+    if (mdv_ebus_subscribe_all(compactor->ebus,
+                               compactor,
+                               mdv_compactor_handlers,
+                               sizeof mdv_compactor_handlers / sizeof *mdv_compactor_handlers) != MDV_OK)
+    {
+        MDV_LOGE("Ebus subscription failed");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_free(rollbacker);
+
+    return compactor;
+}
+
+
+static void mdv_compactor_free(mdv_compactor *compactor)
+{
+    mdv_ebus_unsubscribe_all(compactor->ebus,
+                             compactor,
+                             mdv_compactor_handlers,
+                             sizeof mdv_compactor_handlers / sizeof *mdv_compactor_handlers);
+
+    mdv_ebus_release(compactor->ebus);
+
+    while(atomic_load_explicit(&compactor->active_jobs, memory_order_relaxed) > 0)
+        mdv_sleep(100);
+
+    mdv_jobber_release(compactor->jobber);
+
+    memset(compactor, 0, sizeof(*compactor));
+
+    mdv_free(compactor);
+}
+
+
+mdv_compactor * mdv_compactor_retain(mdv_compactor *compactor)
+{
+    atomic_fetch_add_explicit(&compactor->rc, 1, memory_order_acquire);
+    return compactor;
+}
+
+
+uint32_t mdv_compactor_release(mdv_compactor *compactor)
+{
+    if (!compactor)
+        return 0;
+
+    uint32_t rc = atomic_fetch_sub_explicit(&compactor->rc, 1, memory_order_release) - 1;
+
+    if (!rc)
+        mdv_compactor_free(compactor);
+
+    return rc;
+}
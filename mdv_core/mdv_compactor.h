@@ -0,0 +1,47 @@
+/**
+ * @file mdv_compactor.h
+ * @author Vladislav Volkov (wwwvladislav@gmail.com)
+ * @brief Tombstones compactor
+ * @details Compactor purges tombstones of removed rows when all known cluster nodes received the deletion.
+ *          Transaction logs records which are applied and received by all known cluster nodes are deleted too.
+ *          Compaction is started after the transaction logs applying or the peers synchronization
+ *          but not more often than once per compactor.interval seconds.
+ * @version 0.1
+ * @date 2021-04-02
+ *
+ * @copyright Copyright (c) 2021, Vladislav Volkov
+ *
+ */
+#pragma once
+#include <mdv_ebus.h>
+#include <mdv_jobber.h>
+
+
+/// Tombstones compactor
+typedef struct mdv_compactor mdv_compactor;
+
+
+/**
+ * @brief Creates tombstones compactor
+ *
+ * @param ebus [in]         Events bus
+ * @param jconfig [in]      Jobs scheduler configuration
+ *
+ * @return Tombstones compactor
+ */
+mdv_compactor * mdv_compactor_create(mdv_ebus *ebus, mdv_jobber_config const *jconfig);
+
+
+/**
+ * @brief Retains tombstones compactor.
+ * @details Reference counter is increased by one.
+ */
+mdv_compactor * mdv_compactor_retain(mdv_compactor *compactor);
+
+
+/**
+ * @brief Releases tombstones compactor.
+ * @details Reference counter is decreased by one.
+ *          When the reference counter reaches zero, the tombstones compactor is stopped and freed.
+ */
+uint32_t mdv_compactor_release(mdv_compactor *compactor);
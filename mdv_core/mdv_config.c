@@ -76,8 +76,18 @@ static int mdv_cfg_handler(void* user, const char* section, const char* name, co
     }
     else if (MDV_CFG_MATCH("storage", "shared_buffers"))
     {
-        config->storage.shared_buffers = mdv_str2size(value);
-        MDV_LOGI("Storage shared buffers size: %zu", config->storage.shared_buffers);
+        // Rowdata pages are cached by the OS page cache through the LMDB memory map
+        MDV_LOGW("Storage shared buffers size is ignored");
+    }
+    else if (MDV_CFG_MATCH("storage", "group_commit_window"))
+    {
+        config->storage.group_commit_window = atoi(value);
+        MDV_LOGI("Storage group commit window: %u ms", config->storage.group_commit_window);
+    }
+    else if (MDV_CFG_MATCH("storage", "group_commit_size"))
+    {
+        config->storage.group_commit_size = mdv_str2size(value);
+        MDV_LOGI("Storage group commit size: %zu", config->storage.group_commit_size);
     }
 
     else if (MDV_CFG_MATCH("ebus", "workers"))
@@ -107,6 +117,37 @@ static int mdv_cfg_handler(void* user, const char* section, const char* name, co
         MDV_LOGI("Committer batch size: %u", config->committer.batch_size);
     }
 
+    else if (MDV_CFG_MATCH("compactor", "workers"))
+    {
+        config->compactor.workers = atoi(value);
+        MDV_LOGI("Compactor workers: %u", config->compactor.workers);
+    }
+    else if (MDV_CFG_MATCH("compactor", "queues"))
+    {
+        config->compactor.queues = atoi(value);
+        MDV_LOGI("Compactor queues: %u", config->compactor.queues);
+    }
+    else if (MDV_CFG_MATCH("compactor", "interval"))
+    {
+        config->compactor.interval = atoi(value);
+        MDV_LOGI("Compactor interval: %u seconds", config->compactor.interval);
+    }
+    else if (MDV_CFG_MATCH("compactor", "batch_size"))
+    {
+        config->compactor.batch_size = atoi(value);
+        MDV_LOGI("Compactor batch size: %u", config->compactor.batch_size);
+    }
+    else if (MDV_CFG_MATCH("compactor", "trlog_keep"))
+    {
+        config->compactor.trlog_keep = strtoull(value, 0, 10);
+        MDV_LOGI("Compactor transaction log keep window: %llu records", (unsigned long long)config->compactor.trlog_keep);
+    }
+    else if (MDV_CFG_MATCH("compactor", "shrink"))
+    {
+        config->compactor.shrink = atoi(value) != 0;
+        MDV_LOGI("Compactor storage files shrinking: %s", config->compactor.shrink ? "on" : "off");
+    }
+
     else if (MDV_CFG_MATCH("log", "level"))
     {
         config->log.level = mdv_str_pdup(config->mempool, value).ptr;
@@ -129,6 +170,31 @@ static int mdv_cfg_handler(void* user, const char* section, const char* name, co
         config->datasync.batch_size = atoi(value);
         MDV_LOGI("Datasync batch size: %u", config->datasync.batch_size);
     }
+    else if (MDV_CFG_MATCH("datasync", "batch_bytes"))
+    {
+        config->datasync.batch_bytes = atoi(value);
+        MDV_LOGI("Datasync batch bytes: %u", config->datasync.batch_bytes);
+    }
+    else if (MDV_CFG_MATCH("datasync", "window"))
+    {
+        config->datasync.window = atoi(value);
+        MDV_LOGI("Datasync window: %u batches", config->datasync.window);
+    }
+    else if (MDV_CFG_MATCH("datasync", "snapshot"))
+    {
+        config->datasync.snapshot = atoi(value) != 0;
+        MDV_LOGI("Datasync bootstrap from snapshot: %s", config->datasync.snapshot ? "on" : "off");
+    }
+    else if (MDV_CFG_MATCH("datasync", "snapshot_chunk"))
+    {
+        config->datasync.snapshot_chunk = atoi(value);
+        MDV_LOGI("Datasync snapshot chunk: %u bytes", config->datasync.snapshot_chunk);
+    }
+    else if (MDV_CFG_MATCH("datasync", "replicas"))
+    {
+        config->datasync.replicas = atoi(value);
+        MDV_LOGI("Datasync replicas: %u", config->datasync.replicas);
+    }
 
     else if (MDV_CFG_MATCH("fetcher", "workers"))
     {
@@ -145,6 +211,11 @@ static int mdv_cfg_handler(void* user, const char* section, const char* name, co
         config->fetcher.batch_size = atoi(value);
         MDV_LOGI("Fetcher batch size: %u", config->fetcher.batch_size);
     }
+    else if (MDV_CFG_MATCH("fetcher", "batch_bytes"))
+    {
+        config->fetcher.batch_bytes = atoi(value);
+        MDV_LOGI("Fetcher batch bytes: %u", config->fetcher.batch_bytes);
+    }
     else if (MDV_CFG_MATCH("fetcher", "vm_stack"))
     {
         config->fetcher.vm_stack = atoi(value);
@@ -155,6 +226,16 @@ static int mdv_cfg_handler(void* user, const char* section, const char* name, co
         config->fetcher.views_lifetime = atoi(value);
         MDV_LOGI("Fetcher inactive views lifetime: %u seconds", config->fetcher.views_lifetime);
     }
+    else if (MDV_CFG_MATCH("fetcher", "remote_timeout"))
+    {
+        config->fetcher.remote_timeout = atoi(value);
+        MDV_LOGI("Fetcher remote rows waiting timeout: %u ms", config->fetcher.remote_timeout);
+    }
+    else if (MDV_CFG_MATCH("fetcher", "scan_replicas"))
+    {
+        config->fetcher.scan_replicas = atoi(value);
+        MDV_LOGI("Fetcher scan replicas: %u", config->fetcher.scan_replicas);
+    }
 
     else if (MDV_CFG_MATCH("cluster", "node"))
     {
@@ -189,6 +270,16 @@ static int mdv_cfg_handler(void* user, const char* section, const char* name, co
         MDV_CONFIG.connection.keep_interval = atoi(value);
         MDV_LOGI("Interval between keepalives: %u seconds", MDV_CONFIG.connection.keep_interval);
     }
+    else if (MDV_CFG_MATCH("connection", "compression"))
+    {
+        MDV_CONFIG.connection.compression = atoi(value) != 0;
+        MDV_LOGI("Transaction log data compression: %s", MDV_CONFIG.connection.compression ? "on" : "off");
+    }
+    else if (MDV_CFG_MATCH("connection", "compression_threshold"))
+    {
+        MDV_CONFIG.connection.compression_threshold = atoi(value);
+        MDV_LOGI("Transaction log data compression threshold: %u bytes", MDV_CONFIG.connection.compression_threshold);
+    }
 
     else
     {
@@ -214,12 +305,15 @@ static void mdv_set_config_defaults()
     MDV_CONFIG.connection.keep_idle         = 5;
     MDV_CONFIG.connection.keep_count        = 10;
     MDV_CONFIG.connection.keep_interval     = 5;
+    MDV_CONFIG.connection.compression       = true;
+    MDV_CONFIG.connection.compression_threshold = 1024;
 
     MDV_CONFIG.storage.path                 = "./data";
     MDV_CONFIG.storage.trlog                = "./data/trlog";
     MDV_CONFIG.storage.rowdata              = "./data/rowdata";
-    MDV_CONFIG.storage.shared_buffers       = 33554432u;
     MDV_CONFIG.storage.max_size             = 4294963200u;
+    MDV_CONFIG.storage.group_commit_window  = 0;
+    MDV_CONFIG.storage.group_commit_size    = 1048576u;
 
     MDV_CONFIG.ebus.workers                 = 4;
     MDV_CONFIG.ebus.queues                  = 4;
@@ -228,15 +322,30 @@ static void mdv_set_config_defaults()
     MDV_CONFIG.committer.queues             = 4;
     MDV_CONFIG.committer.batch_size         = 32;
 
+    MDV_CONFIG.compactor.workers            = 1;
+    MDV_CONFIG.compactor.queues             = 1;
+    MDV_CONFIG.compactor.interval           = 60;
+    MDV_CONFIG.compactor.batch_size         = 1024;
+    MDV_CONFIG.compactor.trlog_keep         = 65536;
+    MDV_CONFIG.compactor.shrink             = false;
+
     MDV_CONFIG.datasync.workers             = 4;
     MDV_CONFIG.datasync.queues              = 4;
-    MDV_CONFIG.datasync.batch_size          = 32;
+    MDV_CONFIG.datasync.batch_size          = 1024;
+    MDV_CONFIG.datasync.batch_bytes         = 256 * 1024;
+    MDV_CONFIG.datasync.window              = 8;
+    MDV_CONFIG.datasync.snapshot            = true;
+    MDV_CONFIG.datasync.snapshot_chunk      = 1024 * 1024;
+    MDV_CONFIG.datasync.replicas            = 0;
 
     MDV_CONFIG.fetcher.workers              = 4;
     MDV_CONFIG.fetcher.queues               = 4;
     MDV_CONFIG.fetcher.batch_size           = 32;
-    MDV_CONFIG.fetcher.vm_stack             = 64;
+    MDV_CONFIG.fetcher.batch_bytes          = 1024 * 1024;
+    MDV_CONFIG.fetcher.vm_stack             = 1024;
     MDV_CONFIG.fetcher.views_lifetime       = 30;
+    MDV_CONFIG.fetcher.remote_timeout       = 5000;
+    MDV_CONFIG.fetcher.scan_replicas        = 1;
 
     MDV_CONFIG.cluster.size                 = 0;
 }
@@ -35,6 +35,8 @@ typedef struct
         uint32_t keep_idle;         ///< Start keeplives after this period (in seconds)
         uint32_t keep_count;        ///< Number of keepalives before death
         uint32_t keep_interval;     ///< Interval between keepalives (in seconds)
+        bool     compression;       ///< LZ4 compression of transaction log data sent to peers
+        uint32_t compression_threshold; ///< Minimal transaction log data size for compression (in bytes)
     } connection;                   ///< Connection settings
 
     struct
@@ -42,8 +44,9 @@ typedef struct
         char const *path;           ///< Directory where the database is placed
         char const *trlog;          ///< Directory where the database transaction logs are placed
         char const *rowdata;        ///< Directory where the database rowdata is placed
-        size_t      shared_buffers; ///< Amount of memory the database uses for shared memory buffers
         size_t      max_size;       ///< The maximum size of the LMDB map size.
+        uint32_t    group_commit_window;    ///< Time for transaction log operations grouping (in milliseconds)
+        size_t      group_commit_size;      ///< Maximum size of transaction log operations group (in bytes)
     } storage;                      ///< Storage settings
 
     struct
@@ -59,11 +62,26 @@ typedef struct
         uint32_t   batch_size;      ///< Batch size for data commit
     } committer;
 
+    struct
+    {
+        uint32_t   workers;         ///< Number of thread pool workers for tombstones compaction
+        uint32_t   queues;          ///< Number of event queues
+        uint32_t   interval;        ///< Minimal interval between compactions (in seconds)
+        uint32_t   batch_size;      ///< Maximum number of tombstones purged (or TR log records deleted) in one transaction
+        uint64_t   trlog_keep;      ///< Number of the last transaction log records which are kept for late joiners
+        bool       shrink;          ///< Compact storage files when they are closed
+    } compactor;                    ///< Tombstones compactor settings
+
     struct
     {
         uint32_t   workers;         ///< Number of thread pool workers for data synchronization
         uint32_t   queues;          ///< Number of event queues
-        uint32_t   batch_size;      ///< Batch size for data synchronization
+        uint32_t   batch_size;      ///< Maximum number of records in batch for data synchronization
+        uint32_t   batch_bytes;     ///< Maximum size of batch for data synchronization (in bytes)
+        uint32_t   window;          ///< Maximum number of unacknowledged batches sent to peer
+        bool       snapshot;        ///< Bootstrap empty node from the tables storages snapshot
+        uint32_t   snapshot_chunk;  ///< Size of the snapshot chunk sent to peer (in bytes)
+        uint32_t   replicas;        ///< Number of nodes which store each partition of the partitioned tables (0 - all nodes)
     } datasync;                     ///< Data synchronizer settings
 
     struct
@@ -71,8 +89,11 @@ typedef struct
         uint32_t   workers;         ///< Number of thread pool workers for data fetching from database
         uint32_t   queues;          ///< Number of event queues
         uint32_t   batch_size;      ///< Batch size for data fetching
-        uint32_t   vm_stack;        ///< VM stack size
+        uint32_t   batch_bytes;     ///< Maximum serialized batch size for data fetching (in bytes)
+        uint32_t   vm_stack;        ///< VM stack size (in bytes)
         uint32_t   views_lifetime;  ///< Inactive views lifetime (in seconds)
+        uint32_t   remote_timeout;  ///< Waiting time for rows batch from remote node (in milliseconds)
+        uint32_t   scan_replicas;   ///< Maximum number of replicas which scan the table rows in parallel
     } fetcher;                      ///< Data fetcher settings
 
     struct
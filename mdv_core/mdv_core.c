@@ -5,6 +5,7 @@
 #include "mdv_p2pmsg.h"
 #include "mdv_syncer.h"
 #include "mdv_committer.h"
+#include "mdv_compactor.h"
 #include "mdv_fetcher.h"
 #include "mdv_conman.h"
 #include "mdv_tracker.h"
@@ -27,6 +28,7 @@ struct mdv_core
     mdv_metainf     metainf;            ///< Metainformation (DB version, node UUID etc.)
     mdv_syncer     *syncer;             ///< Data synchronizer
     mdv_committer  *committer;          ///< Data committer
+    mdv_compactor  *compactor;          ///< Tombstones compactor
     mdv_fetcher    *fetcher;            ///< Data fetcher
 
     struct
@@ -39,7 +41,7 @@ struct mdv_core
 
 mdv_core * mdv_core_create()
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(10);
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(11);
 
     mdv_core *core = mdv_alloc(sizeof(mdv_core));
 
@@ -201,6 +203,37 @@ mdv_core * mdv_core_create()
     mdv_rollbacker_push(rollbacker, mdv_committer_release, core->committer);
 
 
+    // Tombstones compactor
+    {
+        mdv_jobber_config const jconfig =
+        {
+            .threadpool =
+            {
+                .size = MDV_CONFIG.compactor.workers,
+                .thread_attrs =
+                {
+                    .stack_size = MDV_THREAD_STACK_SIZE
+                }
+            },
+            .queue =
+            {
+                .count = MDV_CONFIG.compactor.queues
+            }
+        };
+
+        core->compactor = mdv_compactor_create(core->ebus, &jconfig);
+    }
+
+    if (!core->compactor)
+    {
+        MDV_LOGE("Tombstones compactor creation failed");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_compactor_release, core->compactor);
+
+
     // Data fetcher
     {
         mdv_jobber_config const jconfig =
@@ -219,7 +252,7 @@ mdv_core * mdv_core_create()
             }
         };
 
-        core->fetcher = mdv_fetcher_create(core->ebus, &jconfig);
+        core->fetcher = mdv_fetcher_create(&core->metainf.uuid.value, core->ebus, &jconfig);
     }
 
     if (!core->fetcher)
@@ -288,6 +321,7 @@ void mdv_core_free(mdv_core *core)
         mdv_syncer_release(core->syncer);
         mdv_conman_free(core->conman);
         mdv_committer_release(core->committer);
+        mdv_compactor_release(core->compactor);
         mdv_fetcher_release(core->fetcher);
         mdv_storage_release(core->storage.metainf);
         mdv_tablespace_close(core->storage.tablespace);
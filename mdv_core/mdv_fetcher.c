@@ -8,6 +8,9 @@
 #include "event/mdv_evt_status.h"
 #include "storage/mdv_rowdata_view.h"
 #include "storage/mdv_tables_view.h"
+#include "storage/mdv_remote_view.h"
+#include "storage/mdv_gather_view.h"
+#include "storage/mdv_placement.h"
 #include <mdv_table.h>
 #include <mdv_serialization.h>
 #include <mdv_alloc.h>
@@ -17,6 +20,7 @@
 #include <mdv_mutex.h>
 #include <mdv_time.h>
 #include <mdv_systbls.h>
+#include <mdv_index.h>
 #include <stdatomic.h>
 
 
@@ -24,6 +28,7 @@
 struct mdv_fetcher
 {
     atomic_uint_fast32_t    rc;             ///< References counter
+    mdv_uuid                uuid;           ///< Current node UUID
     mdv_ebus               *ebus;           ///< Event bus
     mdv_jobber             *jobber;         ///< Jobs scheduler
     atomic_size_t           active_jobs;    ///< Active jobs counter
@@ -38,6 +43,12 @@ typedef struct
     uint32_t     id;                        ///< View identifier
     mdv_view    *view;                      ///< Table view
     size_t       last_access_time;          ///< Last access time
+    uint32_t     credits;                   ///< Number of rows batches which can be pushed to the client
+    bool         streaming;                 ///< Flag indicates that streaming job is active
+    mdv_uuid     session;                   ///< Session identifier of streaming client
+    uint16_t     request_id;                ///< Last streaming request identifier
+    uint32_t     count;                     ///< Rows number limit for pushed batches
+    uint32_t     bytes;                     ///< Serialized rows size limit for pushed batches
 } mdv_fetcher_view;
 
 
@@ -55,12 +66,32 @@ typedef struct mdv_fetcher_context
     uint16_t        request_id;     ///< Request identifier (used to associate requests and responses)
     mdv_view       *view;           ///< View
     uint32_t        view_id;        ///< View identifier
+    bool            stream;         ///< Flag indicates that rows are pushed while credits are available
+    bool            remote;         ///< Flag indicates that rows are requested by another node
+    mdv_uuid        peer;           ///< Node which requests the rows
+    uint32_t        remote_id;      ///< Remote view identifier on the requesting node
+    uint32_t        count;          ///< Rows number limit for batch
+    uint32_t        bytes;          ///< Serialized rows size limit for batch
 } mdv_fetcher_context;
 
 
 typedef mdv_job(mdv_fetcher_context)     mdv_fetcher_job;
 
 
+/**
+ * @brief Resolves rows batch limits requested by client
+ * @details Zero limits are replaced by defaults. Batch size can't exceed the configured maximum.
+ */
+static void mdv_fetcher_batch_limits(uint32_t *count, uint32_t *bytes)
+{
+    if (!*count)
+        *count = MDV_CONFIG.fetcher.batch_size;
+
+    if (!*bytes || *bytes > MDV_CONFIG.fetcher.batch_bytes)
+        *bytes = MDV_CONFIG.fetcher.batch_bytes;
+}
+
+
 static mdv_rowdata * mdv_fetcher_rowdata(mdv_fetcher *fetcher, mdv_uuid const *table_id)
 {
     mdv_rowdata *rowdata = 0;
@@ -103,6 +134,27 @@ static mdv_table * mdv_fetcher_table(mdv_fetcher *fetcher, mdv_uuid const *table
 }
 
 
+static mdv_placement * mdv_fetcher_placement(mdv_fetcher *fetcher)
+{
+    mdv_placement *placement = 0;
+
+    mdv_evt_placement *evt = mdv_evt_placement_create();
+
+    if (evt)
+    {
+        if (mdv_ebus_publish(fetcher->ebus, &evt->base, MDV_EVT_SYNC) == MDV_OK)
+        {
+            placement = evt->placement;
+            evt->placement = 0;
+        }
+
+        mdv_evt_placement_release(evt);
+    }
+
+    return placement;
+}
+
+
 static mdv_tables * mdv_fetcher_tables(mdv_fetcher *fetcher)
 {
     mdv_tables *tables = 0;
@@ -124,16 +176,52 @@ static mdv_tables * mdv_fetcher_tables(mdv_fetcher *fetcher)
 }
 
 
+/**
+ * @brief Unregisters views which weren't accessed longer than the inactive views lifetime
+ * @details Views hold storage snapshots, so abandoned views shouldn't live forever.
+ *          Fetcher mutex should be locked.
+ */
+static void mdv_fetcher_views_expire(mdv_fetcher *fetcher, size_t now)
+{
+    size_t const lifetime = MDV_CONFIG.fetcher.views_lifetime * 1000u;
+
+    for(bool expired = true; expired;)
+    {
+        expired = false;
+
+        mdv_hashmap_foreach(fetcher->views, mdv_fetcher_view, entry)
+        {
+            if (now - entry->last_access_time > lifetime)
+            {
+                uint32_t const view_id = entry->id;
+                MDV_LOGI("View %u is expired", view_id);
+                mdv_view_release(entry->view);
+                mdv_hashmap_erase(fetcher->views, &view_id);
+                expired = true;
+                break;
+            }
+        }
+    }
+}
+
+
 static mdv_view * mdv_fetcher_view_find(mdv_fetcher *fetcher, uint32_t view_id)
 {
     mdv_view *view = 0;
 
     if(mdv_mutex_lock(&fetcher->mutex) == MDV_OK)
     {
+        size_t const now = mdv_gettime();
+
+        mdv_fetcher_views_expire(fetcher, now);
+
         mdv_fetcher_view *fetcher_view = mdv_hashmap_find(fetcher->views, &view_id);
 
         if (fetcher_view)
+        {
+            fetcher_view->last_access_time = now;
             view = mdv_view_retain(fetcher_view->view);
+        }
 
         mdv_mutex_unlock(&fetcher->mutex);
     }
@@ -144,46 +232,216 @@ static mdv_view * mdv_fetcher_view_find(mdv_fetcher *fetcher, uint32_t view_id)
 }
 
 
-static void mdv_fetcher_fn(mdv_job_base *job)
+static mdv_errno mdv_fetcher_stream_push(mdv_fetcher        *fetcher,
+                                         mdv_uuid const     *session,
+                                         uint16_t            request_id,
+                                         uint32_t            view_id,
+                                         binn               *rows)
 {
-    mdv_fetcher_context *ctx     = (mdv_fetcher_context *)job->data;
-    mdv_fetcher         *fetcher = ctx->fetcher;
+    mdv_errno err = MDV_NO_MEM;
 
-    mdv_errno err = MDV_FAILED;
-    char const *err_msg = "";
+    mdv_evt_view_stream_data *evt = mdv_evt_view_stream_data_create(
+                                        session,
+                                        request_id,
+                                        view_id,
+                                        rows);
 
-    mdv_rowset *rowset = mdv_view_fetch(ctx->view, MDV_CONFIG.fetcher.batch_size);
+    if (evt)
+    {
+        err = mdv_ebus_publish(fetcher->ebus, &evt->base, MDV_EVT_SYNC);
+        mdv_evt_view_stream_data_release(evt);
+    }
 
-    if(rowset)
+    return err;
+}
+
+
+/// Pushes empty rows batch which finishes the stream on the client side
+static mdv_errno mdv_fetcher_stream_end(mdv_fetcher        *fetcher,
+                                        mdv_uuid const     *session,
+                                        uint16_t            request_id,
+                                        uint32_t            view_id)
+{
+    binn rows;
+
+    if (!binn_create_list(&rows))
+        return MDV_NO_MEM;
+
+    mdv_errno const err = mdv_fetcher_stream_push(fetcher, session, request_id, view_id, &rows);
+
+    binn_free(&rows);
+
+    return err;
+}
+
+
+/**
+ * @brief Takes one credit for rows batch pushing
+ * @details If there are no credits, the streaming job is finished and
+ *          the next credits will start the new one.
+ *
+ * @return true if the next rows batch can be pushed
+ */
+static bool mdv_fetcher_stream_credit_take(mdv_fetcher *fetcher, mdv_fetcher_context *ctx)
+{
+    bool taken = false;
+
+    if(mdv_mutex_lock(&fetcher->mutex) == MDV_OK)
     {
-        mdv_table *view_desc = mdv_view_desc(ctx->view);
+        mdv_fetcher_view *fetcher_view = mdv_hashmap_find(fetcher->views, &ctx->view_id);
+
+        if (fetcher_view)
+        {
+            if (fetcher_view->credits)
+            {
+                fetcher_view->credits--;
+                fetcher_view->last_access_time = mdv_gettime();
+                ctx->session = fetcher_view->session;
+                ctx->request_id = fetcher_view->request_id;
+                ctx->count = fetcher_view->count;
+                ctx->bytes = fetcher_view->bytes;
+                taken = true;
+            }
+            else
+                fetcher_view->streaming = false;
+        }
 
+        mdv_mutex_unlock(&fetcher->mutex);
+    }
+    else
+        MDV_LOGE("Mutex lock failed");
+
+    return taken;
+}
+
+
+static void mdv_fetcher_stream_fn(mdv_fetcher_context *ctx)
+{
+    mdv_fetcher *fetcher = ctx->fetcher;
+
+    while(mdv_fetcher_stream_credit_take(fetcher, ctx))
+    {
         binn list;
 
+        if (mdv_view_fetch(ctx->view, ctx->count, ctx->bytes, &list) != MDV_OK)
+        {
+            // Rows are exhausted
+            mdv_fetcher_view_unregister(fetcher, ctx->view_id);
+            mdv_fetcher_stream_end(fetcher, &ctx->session, ctx->request_id, ctx->view_id);
+            break;
+        }
+
+        bool const eof = binn_count(&list) == 0;
 
-        if (mdv_binn_rowset(rowset, &list))
+        mdv_errno const err = mdv_fetcher_stream_push(fetcher, &ctx->session, ctx->request_id, ctx->view_id, &list);
+
+        binn_free(&list);
+
+        if (err != MDV_OK || eof)
         {
-            mdv_evt_view_data *evt = mdv_evt_view_data_create(
-                                            &ctx->session,
-                                            ctx->request_id,
-                                            &list);
+            mdv_fetcher_view_unregister(fetcher, ctx->view_id);
+            break;
+        }
+    }
+}
 
-            if (evt)
-            {
-                err = mdv_ebus_publish(fetcher->ebus, &evt->base, MDV_EVT_SYNC);
-                mdv_evt_view_data_release(evt);
-            }
 
+static mdv_errno mdv_fetcher_remote_rows(mdv_fetcher     *fetcher,
+                                         mdv_uuid const  *peer,
+                                         uint32_t         remote_id,
+                                         uint32_t         view_id,
+                                         mdv_errno        err,
+                                         binn            *rows)
+{
+    mdv_evt_view_rows *evt = mdv_evt_view_rows_create(&fetcher->uuid,
+                                                      peer,
+                                                      remote_id,
+                                                      view_id,
+                                                      err,
+                                                      rows);
+
+    if (!evt)
+        return MDV_NO_MEM;
+
+    err = mdv_ebus_publish(fetcher->ebus, &evt->base, MDV_EVT_SYNC);
+
+    mdv_evt_view_rows_release(evt);
+
+    return err;
+}
+
+
+/// Sends rows batch to the node which reads the partitions
+static void mdv_fetcher_remote_fn(mdv_fetcher_context *ctx)
+{
+    mdv_fetcher *fetcher = ctx->fetcher;
+
+    binn list;
+
+    if (mdv_view_fetch(ctx->view, ctx->count, ctx->bytes, &list) != MDV_OK)
+    {
+        // Rows are exhausted. Empty list finishes the remote view.
+        mdv_fetcher_view_unregister(fetcher, ctx->view_id);
+
+        if (binn_create_list(&list))
+        {
+            mdv_fetcher_remote_rows(fetcher, &ctx->peer, ctx->remote_id, ctx->view_id, MDV_OK, &list);
             binn_free(&list);
         }
         else
+            mdv_fetcher_remote_rows(fetcher, &ctx->peer, ctx->remote_id, ctx->view_id, MDV_NO_MEM, 0);
+
+        return;
+    }
+
+    bool const eof = binn_count(&list) == 0;
+
+    mdv_errno const err = mdv_fetcher_remote_rows(fetcher, &ctx->peer, ctx->remote_id, ctx->view_id, MDV_OK, &list);
+
+    binn_free(&list);
+
+    if (err != MDV_OK || eof)
+        mdv_fetcher_view_unregister(fetcher, ctx->view_id);
+}
+
+
+static void mdv_fetcher_fn(mdv_job_base *job)
+{
+    mdv_fetcher_context *ctx     = (mdv_fetcher_context *)job->data;
+    mdv_fetcher         *fetcher = ctx->fetcher;
+
+    if (ctx->stream)
+    {
+        mdv_fetcher_stream_fn(ctx);
+        return;
+    }
+
+    if (ctx->remote)
+    {
+        mdv_fetcher_remote_fn(ctx);
+        return;
+    }
+
+    mdv_errno err = MDV_FAILED;
+    char const *err_msg = "";
+
+    binn list;
+
+    if (mdv_view_fetch(ctx->view, ctx->count, ctx->bytes, &list) == MDV_OK)
+    {
+        // Rows are already serialized and forwarded as is
+        mdv_evt_view_data *evt = mdv_evt_view_data_create(
+                                        &ctx->session,
+                                        ctx->request_id,
+                                        &list);
+
+        if (evt)
         {
-            err_msg = "Rowset serialization failed";
-            MDV_LOGE("Rowset serialization failed");
+            err = mdv_ebus_publish(fetcher->ebus, &evt->base, MDV_EVT_SYNC);
+            mdv_evt_view_data_release(evt);
         }
 
-        mdv_table_release(view_desc);
-        mdv_rowset_release(rowset);
+        binn_free(&list);
     }
     else
         mdv_fetcher_view_unregister(fetcher, ctx->view_id);
@@ -216,41 +474,37 @@ static void mdv_fetcher_finalize(mdv_job_base *job)
 }
 
 
-static mdv_errno mdv_fetcher_job_emit(mdv_fetcher *fetcher, mdv_evt_view_fetch const *fetch, char const **err_msg)
+/**
+ * @brief Schedules rows fetching job for the given context
+ * @details View is released by the job or on failure.
+ */
+static mdv_errno mdv_fetcher_job_push(mdv_fetcher                 *fetcher,
+                                      mdv_fetcher_context const   *ctx,
+                                      char const                 **err_msg)
 {
-    mdv_view *view = mdv_fetcher_view_find(fetcher, fetch->view_id);
-
-    if (!view)
-    {
-        MDV_LOGE("View %u not found", fetch->view_id);
-        *err_msg = "View not found";
-        return MDV_FAILED;
-    }
-
     mdv_fetcher_job *job = mdv_alloc(sizeof(mdv_fetcher_job));
 
     if (!job)
     {
         MDV_LOGE("No memory for data fetcher job");
-        mdv_view_release(view);
+        mdv_view_release(ctx->view);
         *err_msg = "No memory for new data fetcher job";
         return MDV_NO_MEM;
     }
 
     job->fn                 = mdv_fetcher_fn;
     job->finalize           = mdv_fetcher_finalize;
+    job->data               = *ctx;
     job->data.fetcher       = mdv_fetcher_retain(fetcher);
-    job->data.session       = fetch->session;
-    job->data.request_id    = fetch->request_id;
-    job->data.view          = view;
-    job->data.view_id       = fetch->view_id;
+
+    mdv_fetcher_batch_limits(&job->data.count, &job->data.bytes);
 
     mdv_errno err = mdv_jobber_push(fetcher->jobber, (mdv_job_base*)job);
 
     if (err != MDV_OK)
     {
         MDV_LOGE("Data fetch job failed");
-        mdv_view_release(view);
+        mdv_view_release(ctx->view);
         mdv_fetcher_release(fetcher);
         mdv_free(job);
         *err_msg = "Data fetch job failed";
@@ -262,6 +516,64 @@ static mdv_errno mdv_fetcher_job_emit(mdv_fetcher *fetcher, mdv_evt_view_fetch c
 }
 
 
+/**
+ * @brief Schedules rows fetching job
+ * @details View is released by the job or on failure.
+ */
+static mdv_errno mdv_fetcher_job_emit(mdv_fetcher       *fetcher,
+                                      mdv_view          *view,
+                                      mdv_uuid const    *session,
+                                      uint16_t           request_id,
+                                      uint32_t           view_id,
+                                      bool               stream,
+                                      uint32_t           count,
+                                      uint32_t           bytes,
+                                      char const       **err_msg)
+{
+    mdv_fetcher_context const ctx =
+    {
+        .session    = *session,
+        .request_id = request_id,
+        .view       = view,
+        .view_id    = view_id,
+        .stream     = stream,
+        .count      = count,
+        .bytes      = bytes
+    };
+
+    return mdv_fetcher_job_push(fetcher, &ctx, err_msg);
+}
+
+
+/**
+ * @brief Schedules rows fetching job for the node which reads the partitions
+ * @details View is released by the job or on failure.
+ */
+static mdv_errno mdv_fetcher_remote_job_emit(mdv_fetcher       *fetcher,
+                                             mdv_view          *view,
+                                             mdv_uuid const    *peer,
+                                             uint32_t           remote_id,
+                                             uint32_t           view_id,
+                                             uint32_t           count,
+                                             uint32_t           bytes)
+{
+    mdv_fetcher_context const ctx =
+    {
+        .view       = view,
+        .view_id    = view_id,
+        .remote     = true,
+        .peer       = *peer,
+        .remote_id  = remote_id,
+        .count      = count,
+        .bytes      = bytes
+    };
+
+    char const *err_msg = "";
+
+    return mdv_fetcher_job_push(fetcher, &ctx, &err_msg);
+}
+
+
 static mdv_errno mdv_fetcher_view_register(mdv_fetcher  *fetcher,
                                            mdv_view     *view,
                                            uint32_t     *view_id)
@@ -270,11 +582,15 @@ static mdv_errno mdv_fetcher_view_register(mdv_fetcher  *fetcher,
 
     if(err == MDV_OK)
     {
+        size_t const now = mdv_gettime();
+
+        mdv_fetcher_views_expire(fetcher, now);
+
         mdv_fetcher_view const reg_view =
         {
             .id = atomic_fetch_add_explicit(&fetcher->idgen, 1, memory_order_relaxed),
             .view = mdv_view_retain(view),
-            .last_access_time = mdv_gettime(),
+            .last_access_time = now,
         };
 
         if (!mdv_hashmap_insert(fetcher->views, &reg_view, sizeof reg_view))
@@ -311,9 +627,69 @@ static void mdv_fetcher_view_unregister(mdv_fetcher  *fetcher, uint32_t view_id)
 }
 
 
+/**
+ * @brief Chooses the secondary index for rows reading
+ * @details Equality conditions are preferred over ranges and bounded ranges are preferred over half-bounded ones.
+ *
+ * @param desc [in]         Table description
+ * @param predicate [in]    Predicate for rows filtering
+ * @param range [out]       Secondary index keys range
+ * @param from [out]        Buffer for lower bound (MDV_INDEX_KEY_MAX bytes)
+ * @param to [out]          Buffer for upper bound (MDV_INDEX_KEY_MAX bytes)
+ *
+ * @return true if the secondary index should be used
+ */
+static bool mdv_fetcher_plan(mdv_table_desc const   *desc,
+                             mdv_predicate const    *predicate,
+                             mdv_rowdata_range      *range,
+                             uint8_t                *from,
+                             uint8_t                *to)
+{
+    int best_score = 0;
+    mdv_predicate_range best = {};
+
+    for(uint32_t i = 0; i < desc->indexes_size; ++i)
+    {
+        mdv_predicate_range field_range;
+
+        if (!mdv_predicate_field_range(predicate, desc->indexes[i], &field_range))
+            continue;
+
+        int const score = field_range.from.ptr && field_range.from.ptr == field_range.to.ptr ? 3
+                            : field_range.from.ptr && field_range.to.ptr ? 2
+                            : 1;
+
+        if (score > best_score)
+        {
+            best_score = score;
+            best = field_range;
+            range->index = i;
+        }
+    }
+
+    if (!best_score)
+        return false;
+
+    mdv_field_type const type = desc->fields[desc->indexes[range->index]].type;
+
+    range->from.ptr = from;
+    range->from.size = best.from.ptr
+                        ? mdv_index_key(type, best.from.ptr, best.from.size, from)
+                        : 0;
+
+    range->to.ptr = to;
+    range->to.size = best.to.ptr
+                        ? mdv_index_key(type, best.to.ptr, best.to.size, to)
+                        : 0;
+
+    return true;
+}
+
+
 static mdv_view * mdv_fetcher_rowdata_view_create(mdv_fetcher    *fetcher,
                                                   mdv_table      *table,
                                                   mdv_bitset     *fields,
+                                                  mdv_bitset     *partitions,
                                                   mdv_predicate  *predicate,
                                                   char const    **err_msg)
 {
@@ -323,7 +699,13 @@ static mdv_view * mdv_fetcher_rowdata_view_create(mdv_fetcher    *fetcher,
 
     if(rowdata)
     {
-        view = mdv_rowdata_view_create(rowdata, table, fields, predicate);
+        uint8_t from[MDV_INDEX_KEY_MAX], to[MDV_INDEX_KEY_MAX];
+
+        mdv_rowdata_range range;
+
+        bool const indexed = mdv_fetcher_plan(mdv_table_description(table), predicate, &range, from, to);
+
+        view = mdv_rowdata_view_create(rowdata, table, fields, partitions, predicate, indexed ? &range : 0);
 
         if(!view)
             *err_msg = "View creation failed";
@@ -337,6 +719,144 @@ static mdv_view * mdv_fetcher_rowdata_view_create(mdv_fetcher    *fetcher,
 }
 
 
+/**
+ * @brief Creates view over the table rows which are scanned by several cluster nodes
+ * @details Partitions are grouped by the nodes which are preferred for reading.
+ *          Partitions of the current node are read locally, other rows are requested from the remote nodes.
+ *          If scanners count is zero, partitions are read from the owners. Otherwise the table
+ *          is stored by all nodes and partitions are distributed between the given number of scanners.
+ */
+static mdv_view * mdv_fetcher_scatter_view_create(mdv_fetcher    *fetcher,
+                                                  mdv_placement  *placement,
+                                                  uint32_t        scanners,
+                                                  mdv_table      *table,
+                                                  mdv_bitset     *fields,
+                                                  mdv_predicate  *predicate,
+                                                  char const     *filter,
+                                                  char const    **err_msg)
+{
+    mdv_uuid    readers[MDV_PARTITIONS];
+    mdv_bitset *partitions[MDV_PARTITIONS];
+    mdv_view   *views[MDV_PARTITIONS];
+
+    size_t count = 0;
+
+    bool ok = true;
+
+    for(uint32_t partition = 0; ok && partition < MDV_PARTITIONS; ++partition)
+    {
+        mdv_uuid const *reader = scanners
+                                    ? mdv_placement_scanner(placement, partition, scanners)
+                                    : mdv_placement_reader(placement, mdv_table_description(table), partition);
+
+        size_t i = 0;
+
+        while(i < count && mdv_uuid_cmp(readers + i, reader) != 0)
+            ++i;
+
+        if (i == count)
+        {
+            partitions[i] = mdv_bitset_create(MDV_PARTITIONS, &mdv_default_allocator);
+
+            if (!partitions[i])
+            {
+                *err_msg = "No memory for partitions mask";
+                ok = false;
+                break;
+            }
+
+            readers[i] = *reader;
+            ++count;
+        }
+
+        mdv_bitset_set(partitions[i], partition);
+    }
+
+    // All partitions are read locally, so the partitions mask isn't required
+    bool const local = count == 1 && mdv_uuid_cmp(readers, &fetcher->uuid) == 0;
+
+    size_t views_count = 0;
+
+    for(; ok && views_count < count; ++views_count)
+    {
+        mdv_view *view = mdv_uuid_cmp(readers + views_count, &fetcher->uuid) == 0
+                            ? mdv_fetcher_rowdata_view_create(fetcher, table, fields, local ? 0 : partitions[views_count], predicate, err_msg)
+                            : mdv_remote_view_create(fetcher->ebus,
+                                                     &fetcher->uuid,
+                                                     readers + views_count,
+                                                     table,
+                                                     fields,
+                                                     partitions[views_count],
+                                                     filter);
+        if (!view)
+        {
+            *err_msg = "View creation failed";
+            ok = false;
+            break;
+        }
+
+        views[views_count] = view;
+    }
+
+    mdv_view *view = ok
+                        ? (views_count == 1
+                            ? mdv_view_retain(views[0])
+                            : mdv_gather_view_create(views, views_count))
+                        : 0;
+
+    if (ok && !view)
+        *err_msg = "View creation failed";
+
+    for(size_t i = 0; i < views_count; ++i)
+        mdv_view_release(views[i]);
+
+    for(size_t i = 0; i < count; ++i)
+        mdv_bitset_release(partitions[i]);
+
+    return view;
+}
+
+
+/**
+ * @brief Creates view over the table rows
+ * @details If the partitioned table rows are distributed between cluster nodes, the rows are gathered from partitions owners.
+ *          Otherwise the table scan may be split between directly connected replicas (fetcher.scan_replicas).
+ */
+static mdv_view * mdv_fetcher_table_view_create(mdv_fetcher    *fetcher,
+                                                mdv_table      *table,
+                                                mdv_bitset     *fields,
+                                                mdv_predicate  *predicate,
+                                                char const     *filter,
+                                                char const    **err_msg)
+{
+    bool const partitioned = mdv_placement_enabled(mdv_table_description(table));
+
+    if (!partitioned && MDV_CONFIG.fetcher.scan_replicas <= 1)
+        return mdv_fetcher_rowdata_view_create(fetcher, table, fields, 0, predicate, err_msg);
+
+    mdv_placement *placement = mdv_fetcher_placement(fetcher);
+
+    if (!placement)
+    {
+        *err_msg = "Rows placement not found";
+        return 0;
+    }
+
+    mdv_view *view = 0;
+
+    if (partitioned)
+        view = mdv_fetcher_scatter_view_create(fetcher, placement, 0, table, fields, predicate, filter, err_msg);
+    else if (MDV_CONFIG.fetcher.scan_replicas > 1)
+        view = mdv_fetcher_scatter_view_create(fetcher, placement, MDV_CONFIG.fetcher.scan_replicas, table, fields, predicate, filter, err_msg);
+    else
+        view = mdv_fetcher_rowdata_view_create(fetcher, table, fields, 0, predicate, err_msg);
+
+    mdv_placement_release(placement);
+
+    return view;
+}
+
+
 static mdv_view * mdv_fetcher_tables_view_create(mdv_fetcher    *fetcher,
                                                  mdv_table      *table,
                                                  mdv_bitset     *fields,
@@ -376,7 +896,7 @@ static mdv_errno mdv_fetcher_view_create(mdv_fetcher    *fetcher,
 
     if(table)
     {
-        mdv_predicate * predicate = mdv_predicate_parse(filter);
+        mdv_predicate * predicate = mdv_predicate_parse(mdv_table_description(table), filter);
 
         if (predicate)
         {
@@ -385,7 +905,7 @@ static mdv_errno mdv_fetcher_view_create(mdv_fetcher    *fetcher,
             if(mdv_uuid_cmp(&MDV_SYSTBL_TABLES, table_id) == 0)
                 view = mdv_fetcher_tables_view_create(fetcher, table, fields, predicate, err_msg);
             else
-                view = mdv_fetcher_rowdata_view_create(fetcher, table, fields, predicate, err_msg);
+                view = mdv_fetcher_table_view_create(fetcher, table, fields, predicate, filter, err_msg);
 
             if (view)
             {
@@ -471,7 +991,25 @@ static mdv_errno mdv_fetcher_evt_view_fetch(void *arg, mdv_event *event)
 
     char const *err_msg = "";
 
-    mdv_errno err = mdv_fetcher_job_emit(fetcher, fetch, &err_msg);
+    mdv_errno err = MDV_FAILED;
+
+    mdv_view *view = mdv_fetcher_view_find(fetcher, fetch->view_id);
+
+    if (view)
+        err = mdv_fetcher_job_emit(fetcher,
+                                   view,
+                                   &fetch->session,
+                                   fetch->request_id,
+                                   fetch->view_id,
+                                   false,
+                                   fetch->count,
+                                   fetch->bytes,
+                                   &err_msg);
+    else
+    {
+        MDV_LOGE("View %u not found", fetch->view_id);
+        err_msg = "View not found";
+    }
 
     if (err != MDV_OK)
     {
@@ -492,14 +1030,214 @@ static mdv_errno mdv_fetcher_evt_view_fetch(void *arg, mdv_event *event)
 }
 
 
+/**
+ * @brief Adds credits for rows pushing
+ * @details If the streaming job isn't active, the new one is started and
+ *          the view is returned.
+ */
+static mdv_errno mdv_fetcher_stream_credit_add(mdv_fetcher                 *fetcher,
+                                               mdv_evt_view_stream const   *stream,
+                                               mdv_view                   **view)
+{
+    mdv_errno err = mdv_mutex_lock(&fetcher->mutex);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Mutex lock failed");
+        return err;
+    }
+
+    size_t const now = mdv_gettime();
+
+    mdv_fetcher_views_expire(fetcher, now);
+
+    mdv_fetcher_view *fetcher_view = mdv_hashmap_find(fetcher->views, &stream->view_id);
+
+    if (fetcher_view)
+    {
+        fetcher_view->last_access_time = now;
+        fetcher_view->credits += stream->credits;
+        fetcher_view->session = stream->session;
+        fetcher_view->request_id = stream->request_id;
+        fetcher_view->count = stream->count;
+        fetcher_view->bytes = stream->bytes;
+
+        mdv_fetcher_batch_limits(&fetcher_view->count, &fetcher_view->bytes);
+
+        if (!fetcher_view->streaming && fetcher_view->credits)
+        {
+            fetcher_view->streaming = true;
+            *view = mdv_view_retain(fetcher_view->view);
+        }
+    }
+    else
+        err = MDV_FAILED;
+
+    mdv_mutex_unlock(&fetcher->mutex);
+
+    return err;
+}
+
+
+static mdv_errno mdv_fetcher_evt_view_stream(void *arg, mdv_event *event)
+{
+    mdv_fetcher *fetcher = arg;
+    mdv_evt_view_stream *stream = (mdv_evt_view_stream *)event;
+
+    mdv_view *view = 0;
+
+    mdv_errno err = mdv_fetcher_stream_credit_add(fetcher, stream, &view);
+
+    if (err != MDV_OK)
+        MDV_LOGE("View %u not found", stream->view_id);
+    else if (view)
+    {
+        char const *err_msg = "";
+
+        err = mdv_fetcher_job_emit(fetcher,
+                                   view,
+                                   &stream->session,
+                                   stream->request_id,
+                                   stream->view_id,
+                                   true,
+                                   stream->count,
+                                   stream->bytes,
+                                   &err_msg);
+
+        if (err != MDV_OK)
+            mdv_fetcher_view_unregister(fetcher, stream->view_id);
+    }
+
+    if (err != MDV_OK)
+        err = mdv_fetcher_stream_end(fetcher, &stream->session, stream->request_id, stream->view_id);
+
+    return err;
+}
+
+
+/**
+ * @brief Creates and registers the view over the local partitions which are requested by another node
+ */
+static mdv_errno mdv_fetcher_partitions_view_create(mdv_fetcher               *fetcher,
+                                                    mdv_evt_view_open const   *open,
+                                                    char const               **err_msg,
+                                                    mdv_view                 **view,
+                                                    uint32_t                  *view_id)
+{
+    mdv_errno err = MDV_FAILED;
+
+    mdv_table *table = mdv_fetcher_table(fetcher, &open->table);
+
+    if(table)
+    {
+        mdv_predicate * predicate = mdv_predicate_parse(mdv_table_description(table), open->filter);
+
+        if (predicate)
+        {
+            *view = mdv_fetcher_rowdata_view_create(fetcher, table, open->fields, open->partitions, predicate, err_msg);
+
+            if (*view)
+            {
+                err = mdv_fetcher_view_register(fetcher, *view, view_id);
+
+                if (err != MDV_OK)
+                {
+                    *err_msg = "View registration failed";
+                    mdv_view_release(*view);
+                    *view = 0;
+                }
+            }
+
+            mdv_predicate_release(predicate);
+        }
+        else
+            *err_msg = "Rows filter is incorrect";
+
+        mdv_table_release(table);
+    }
+    else
+        *err_msg = "Table not found";
+
+    return err;
+}
+
+
+static mdv_errno mdv_fetcher_evt_view_open(void *arg, mdv_event *event)
+{
+    mdv_fetcher *fetcher = arg;
+    mdv_evt_view_open *open = (mdv_evt_view_open *)event;
+
+    if (mdv_uuid_cmp(&open->to, &fetcher->uuid) != 0)
+        return MDV_OK;
+
+    char const *err_msg = "";
+
+    mdv_view *view = 0;
+    uint32_t view_id = ~0u;
+
+    mdv_errno err = mdv_fetcher_partitions_view_create(fetcher, open, &err_msg, &view, &view_id);
+
+    if (err == MDV_OK)
+    {
+        err = mdv_fetcher_remote_job_emit(fetcher, view, &open->from, open->id, view_id, open->count, open->bytes);
+
+        if (err != MDV_OK)
+        {
+            err_msg = "Data fetch job failed";
+            mdv_fetcher_view_unregister(fetcher, view_id);
+        }
+    }
+
+    if (err != MDV_OK)
+    {
+        char uuid_str[MDV_UUID_STR_LEN];
+
+        MDV_LOGE("Partitions view opening failed for table '%s' with error '%s'",
+                    mdv_uuid_to_str(&open->table, uuid_str),
+                    err_msg);
+
+        mdv_fetcher_remote_rows(fetcher, &open->from, open->id, view_id, err, 0);
+    }
+
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_fetcher_evt_view_read(void *arg, mdv_event *event)
+{
+    mdv_fetcher *fetcher = arg;
+    mdv_evt_view_read *read = (mdv_evt_view_read *)event;
+
+    if (mdv_uuid_cmp(&read->to, &fetcher->uuid) != 0)
+        return MDV_OK;
+
+    mdv_errno err = MDV_ENOENT;
+
+    mdv_view *view = mdv_fetcher_view_find(fetcher, read->view_id);
+
+    if (view)
+        err = mdv_fetcher_remote_job_emit(fetcher, view, &read->from, read->id, read->view_id, read->count, read->bytes);
+    else
+        MDV_LOGE("View %u not found", read->view_id);
+
+    if (err != MDV_OK)
+        mdv_fetcher_remote_rows(fetcher, &read->from, read->id, read->view_id, err, 0);
+
+    return MDV_OK;
+}
+
+
 static const mdv_event_handler_type mdv_fetcher_handlers[] =
 {
     { MDV_EVT_SELECT,       mdv_fetcher_evt_select },
     { MDV_EVT_VIEW_FETCH,   mdv_fetcher_evt_view_fetch },
+    { MDV_EVT_VIEW_STREAM,  mdv_fetcher_evt_view_stream },
+    { MDV_EVT_VIEW_OPEN,    mdv_fetcher_evt_view_open },
+    { MDV_EVT_VIEW_READ,    mdv_fetcher_evt_view_read },
 };
 
 
-mdv_fetcher * mdv_fetcher_create(mdv_ebus *ebus, mdv_jobber_config const *jconfig)
+mdv_fetcher * mdv_fetcher_create(mdv_uuid const *uuid, mdv_ebus *ebus, mdv_jobber_config const *jconfig)
 {
     mdv_rollbacker *rollbacker = mdv_rollbacker_create(5);
 
@@ -518,6 +1256,7 @@ mdv_fetcher * mdv_fetcher_create(mdv_ebus *ebus, mdv_jobber_config const *jconfi
     atomic_init(&fetcher->active_jobs, 0);
     atomic_init(&fetcher->idgen, 0);
 
+    fetcher->uuid = *uuid;
     fetcher->ebus = mdv_ebus_retain(ebus);
 
     mdv_rollbacker_push(rollbacker, mdv_ebus_release, fetcher->ebus);
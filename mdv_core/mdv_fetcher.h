@@ -11,6 +11,7 @@
 #pragma once
 #include <mdv_ebus.h>
 #include <mdv_jobber.h>
+#include <mdv_uuid.h>
 
 
 /// Data fetcher
@@ -20,12 +21,13 @@ typedef struct mdv_fetcher mdv_fetcher;
 /**
  * @brief Creates data fetcher
  *
+ * @param uuid [in]         Current node UUID
  * @param ebus [in]         Events bus
  * @param jconfig [in]      Jobs scheduler configuration
  *
  * @return Data fetcher
  */
-mdv_fetcher * mdv_fetcher_create(mdv_ebus *ebus, mdv_jobber_config const *jconfig);
+mdv_fetcher * mdv_fetcher_create(mdv_uuid const *uuid, mdv_ebus *ebus, mdv_jobber_config const *jconfig);
 
 
 /**
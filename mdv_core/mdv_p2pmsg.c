@@ -1,6 +1,9 @@
 #include "mdv_p2pmsg.h"
 #include <mdv_log.h>
 #include <mdv_serialization.h>
+#include <mdv_alloc.h>
+#include <mdv_limits.h>
+#include <lz4.h>
 #include <assert.h>
 #include <string.h>
 
@@ -18,6 +21,14 @@ char const * mdv_p2p_msg_name(uint32_t id)
         case mdv_message_id(p2p_trlog_state):   return "P2P TRLOG STATE";
         case mdv_message_id(p2p_trlog_data):    return "P2P TRLOG DATA";
         case mdv_message_id(p2p_broadcast):     return "P2P BROADCAST";
+        case mdv_message_id(p2p_snapshot_req):  return "P2P SNAPSHOT REQUEST";
+        case mdv_message_id(p2p_snapshot_data): return "P2P SNAPSHOT DATA";
+        case mdv_message_id(p2p_snapshot):      return "P2P SNAPSHOT";
+        case mdv_message_id(p2p_view_open):     return "P2P VIEW OPEN";
+        case mdv_message_id(p2p_view_read):     return "P2P VIEW READ";
+        case mdv_message_id(p2p_view_rows):     return "P2P VIEW ROWS";
+        case mdv_message_id(p2p_delete):        return "P2P DELETE";
+        case mdv_message_id(p2p_delete_status): return "P2P DELETE STATUS";
     }
 
     return "P2P UNKOWN";
@@ -32,7 +43,9 @@ bool mdv_binn_p2p_hello(mdv_msg_p2p_hello const *msg, binn *obj)
         return false;
     }
 
-    if (!binn_object_set_str(obj, "L", (char*)msg->listen))
+    if (0
+        || !binn_object_set_str(obj, "L", (char*)msg->listen)
+        || !binn_object_set_uint32(obj, "F", msg->features))
     {
         binn_free(obj);
         MDV_LOGE("binn_p2p_hello failed");
@@ -55,6 +68,10 @@ bool mdv_unbinn_p2p_hello(binn const *obj, mdv_msg_p2p_hello *msg)
 
     msg->listen = listen;
 
+    // Features aren't advertised by old peers
+    if (!binn_object_get_uint32((void*)obj, "F", &msg->features))
+        msg->features = 0;
+
     return true;
 }
 
@@ -254,7 +271,7 @@ bool mdv_unbinn_p2p_trlog_state(binn const *obj, mdv_msg_p2p_trlog_state *msg)
 }
 
 
-bool mdv_binn_p2p_trlog_data(mdv_msg_p2p_trlog_data const *msg, binn *obj)
+bool mdv_binn_p2p_trlog_data(mdv_msg_p2p_trlog_data const *msg, size_t threshold, binn *obj, mdv_p2p_trlog_data_stat *stat)
 {
     binn rows;
 
@@ -303,8 +320,55 @@ bool mdv_binn_p2p_trlog_data(mdv_msg_p2p_trlog_data const *msg, binn *obj)
     if (0
         || !binn_object_set_uint64(obj, "U0", msg->trlog.u64[0])
         || !binn_object_set_uint64(obj, "U1", msg->trlog.u64[1])
-        || !binn_object_set_uint32(obj, "C",  msg->count)
-        || !binn_object_set_list  (obj, "R", &rows))
+        || !binn_object_set_uint64(obj, "P",  msg->start)
+        || !binn_object_set_uint32(obj, "C",  msg->count))
+    {
+        binn_free(&rows);
+        binn_free(obj);
+        MDV_LOGE("binn_p2p_cfslog_data failed");
+        return false;
+    }
+
+    int const rows_size = binn_size(&rows);
+
+    stat->raw_size = rows_size;
+    stat->size = rows_size;
+
+    if (threshold && (size_t)rows_size >= threshold)
+    {
+        int const bound = LZ4_compressBound(rows_size);
+
+        char *packed = bound > 0 ? mdv_alloc(bound) : 0;
+
+        if (packed)
+        {
+            int const packed_size = LZ4_compress_default(binn_ptr(&rows), packed, rows_size, bound);
+
+            // Records are sent as is if compression doesn't reduce the size
+            if (packed_size > 0 && packed_size < rows_size)
+            {
+                if (0
+                    || !binn_object_set_uint32(obj, "ZS", rows_size)
+                    || !binn_object_set_blob  (obj, "Z", packed, packed_size))
+                {
+                    mdv_free(packed);
+                    binn_free(&rows);
+                    binn_free(obj);
+                    MDV_LOGE("binn_p2p_cfslog_data failed");
+                    return false;
+                }
+
+                stat->size = packed_size;
+            }
+
+            mdv_free(packed);
+        }
+        else
+            MDV_LOGW("No memory for transaction log data compression");
+    }
+
+    if (stat->size == stat->raw_size
+        && !binn_object_set_list(obj, "R", &rows))
     {
         binn_free(&rows);
         binn_free(obj);
@@ -318,20 +382,83 @@ bool mdv_binn_p2p_trlog_data(mdv_msg_p2p_trlog_data const *msg, binn *obj)
 }
 
 
+/**
+ * @brief Decompresses LZ4 compressed transaction log records list
+ *
+ * @return On success, returns pointer to the serialized records list which should be freed by mdv_free()
+ * @return On error, returns NULL pointer
+ */
+static void * mdv_p2p_trlog_data_unpack(void const *packed, int packed_size, uint32_t raw_size)
+{
+    // Raw size is received from the peer, so it's limited by the maximum message size
+    if (!raw_size || raw_size > MDV_MSG_SIZE_MAX || raw_size > LZ4_MAX_INPUT_SIZE)
+    {
+        MDV_LOGE("Invalid transaction log data size: %u", raw_size);
+        return 0;
+    }
+
+    void *rows = mdv_alloc(raw_size);
+
+    if (!rows)
+    {
+        MDV_LOGE("No memory for transaction log data decompression");
+        return 0;
+    }
+
+    int type = 0, count = 0, size = 0;
+
+    if (LZ4_decompress_safe(packed, rows, packed_size, raw_size) != (int)raw_size
+        || !binn_is_valid_ex(rows, &type, &count, &size)
+        || type != BINN_LIST
+        || size != (int)raw_size)
+    {
+        MDV_LOGE("Transaction log data decompression failed");
+        mdv_free(rows);
+        return 0;
+    }
+
+    return rows;
+}
+
+
 bool mdv_unbinn_p2p_trlog_data(binn const *obj, mdv_msg_p2p_trlog_data *msg)
 {
     binn *rows = 0;
+    void *unpacked = 0;
 
     if (0
         || !binn_object_get_uint64((void*)obj, "U0", (uint64*)&msg->trlog.u64[0])
         || !binn_object_get_uint64((void*)obj, "U1", (uint64*)&msg->trlog.u64[1])
-        || !binn_object_get_uint32((void*)obj, "C",  &msg->count)
-        || !binn_object_get_list  ((void*)obj, "R", (void **)&rows))
+        || !binn_object_get_uint32((void*)obj, "C",  &msg->count))
     {
         MDV_LOGE("unbinn_p2p_trlog_data failed");
         return false;
     }
 
+    bool const has_start = binn_object_get_uint64((void*)obj, "P", (uint64*)&msg->start);
+
+    if (!binn_object_get_list((void*)obj, "R", (void **)&rows))
+    {
+        uint32_t raw_size = 0;
+        void *packed = 0;
+        int packed_size = 0;
+
+        if (0
+            || !binn_object_get_uint32((void*)obj, "ZS", &raw_size)
+            || !binn_object_get_blob  ((void*)obj, "Z", &packed, &packed_size))
+        {
+            MDV_LOGE("unbinn_p2p_trlog_data failed");
+            return false;
+        }
+
+        unpacked = mdv_p2p_trlog_data_unpack(packed, packed_size, raw_size);
+
+        if (!unpacked)
+            return false;
+
+        rows = unpacked;
+    }
+
     bool ret = true;
 
     binn_iter iter = {};
@@ -383,6 +510,15 @@ bool mdv_unbinn_p2p_trlog_data(binn const *obj, mdv_msg_p2p_trlog_data *msg)
         mdv_list_emplace_back(&msg->rows, (mdv_list_entry_base *)op);
     }
 
+    mdv_free(unpacked);
+
+    // Old peers don't send the records start position
+    if (!has_start)
+    {
+        mdv_trlog_data const *first = msg->rows.next ? (mdv_trlog_data const *)msg->rows.next->data : 0;
+        msg->start = first ? first->id : 0;
+    }
+
     if (!ret)
         mdv_list_clear(&msg->rows);
 
@@ -513,3 +649,628 @@ bool mdv_unbinn_p2p_broadcast(binn const *obj, mdv_msg_p2p_broadcast *msg)
 
     return true;
 }
+
+
+bool mdv_binn_p2p_snapshot_req(mdv_msg_p2p_snapshot_req const *msg, binn *obj)
+{
+    (void)msg;
+
+    if (!binn_create_object(obj))
+    {
+        MDV_LOGE("binn_p2p_snapshot_req failed");
+        return false;
+    }
+
+    return true;
+}
+
+
+bool mdv_unbinn_p2p_snapshot_req(binn const *obj, mdv_msg_p2p_snapshot_req *msg)
+{
+    (void)obj;
+    (void)msg;
+    return true;
+}
+
+
+bool mdv_binn_p2p_snapshot_data(mdv_msg_p2p_snapshot_data const *msg, binn *obj)
+{
+    if (!binn_create_object(obj))
+    {
+        MDV_LOGE("binn_p2p_snapshot_data failed");
+        return false;
+    }
+
+    if (0
+        || !binn_object_set_uint64(obj, "U0", msg->table.u64[0])
+        || !binn_object_set_uint64(obj, "U1", msg->table.u64[1])
+        || !binn_object_set_uint64(obj, "O",  msg->offset)
+        || !binn_object_set_uint64(obj, "S",  msg->total)
+        || !binn_object_set_blob(obj,   "D",  (void*)msg->data, (int)msg->size))
+    {
+        binn_free(obj);
+        MDV_LOGE("binn_p2p_snapshot_data failed");
+        return false;
+    }
+
+    return true;
+}
+
+
+bool mdv_unbinn_p2p_snapshot_data(binn const *obj, mdv_msg_p2p_snapshot_data *msg)
+{
+    void *data = 0;
+    int size = 0;
+
+    if (0
+        || !binn_object_get_uint64((void*)obj, "U0", (uint64*)&msg->table.u64[0])
+        || !binn_object_get_uint64((void*)obj, "U1", (uint64*)&msg->table.u64[1])
+        || !binn_object_get_uint64((void*)obj, "O",  (uint64*)&msg->offset)
+        || !binn_object_get_uint64((void*)obj, "S",  (uint64*)&msg->total)
+        || !binn_object_get_blob((void*)obj,   "D",  &data, &size)
+        || size < 0)
+    {
+        MDV_LOGE("unbinn_p2p_snapshot_data failed");
+        return false;
+    }
+
+    msg->size = (uint32_t)size;
+    msg->data = data;
+
+    return true;
+}
+
+
+bool mdv_binn_p2p_snapshot(mdv_msg_p2p_snapshot const *msg, binn *obj)
+{
+    binn tables, positions, ids;
+
+    if (!binn_create_list(&tables))
+    {
+        MDV_LOGE("binn_p2p_snapshot failed");
+        return false;
+    }
+
+    if (!binn_create_list(&positions))
+    {
+        MDV_LOGE("binn_p2p_snapshot failed");
+        binn_free(&tables);
+        return false;
+    }
+
+    if (!binn_create_list(&ids))
+    {
+        MDV_LOGE("binn_p2p_snapshot failed");
+        binn_free(&positions);
+        binn_free(&tables);
+        return false;
+    }
+
+    if (msg->tables)
+    {
+        mdv_vector_foreach(msg->tables, mdv_table_ptr, table)
+        {
+            binn desc;
+
+            if (!mdv_binn_table(*table, &desc))
+            {
+                MDV_LOGE("binn_p2p_snapshot failed");
+                binn_free(&ids);
+                binn_free(&positions);
+                binn_free(&tables);
+                return false;
+            }
+
+            if (!binn_list_add_object(&tables, &desc))
+            {
+                MDV_LOGE("binn_p2p_snapshot failed");
+                binn_free(&desc);
+                binn_free(&ids);
+                binn_free(&positions);
+                binn_free(&tables);
+                return false;
+            }
+
+            binn_free(&desc);
+        }
+    }
+
+    if (msg->positions)
+    {
+        mdv_vector_foreach(msg->positions, mdv_trlog_pos, entry)
+        {
+            binn pos;
+            uint8_t tmp[64];
+
+            if (!binn_create(&pos, BINN_OBJECT, sizeof tmp, tmp))
+            {
+                MDV_LOGE("binn_p2p_snapshot failed");
+                binn_free(&ids);
+                binn_free(&positions);
+                binn_free(&tables);
+                return false;
+            }
+
+            if (0
+                || !binn_object_set_uint64(&pos, "U0", entry->trlog.u64[0])
+                || !binn_object_set_uint64(&pos, "U1", entry->trlog.u64[1])
+                || !binn_object_set_uint64(&pos, "P",  entry->pos)
+                || !binn_list_add_object(&positions, &pos))
+            {
+                MDV_LOGE("binn_p2p_snapshot failed");
+                binn_free(&pos);
+                binn_free(&ids);
+                binn_free(&positions);
+                binn_free(&tables);
+                return false;
+            }
+
+            binn_free(&pos);
+        }
+    }
+
+    if (msg->ids)
+    {
+        mdv_vector_foreach(msg->ids, mdv_storage_id, entry)
+        {
+            binn id;
+            uint8_t tmp[64];
+
+            if (!binn_create(&id, BINN_OBJECT, sizeof tmp, tmp))
+            {
+                MDV_LOGE("binn_p2p_snapshot failed");
+                binn_free(&ids);
+                binn_free(&positions);
+                binn_free(&tables);
+                return false;
+            }
+
+            if (0
+                || !binn_object_set_uint64(&id, "U0", entry->uuid.u64[0])
+                || !binn_object_set_uint64(&id, "U1", entry->uuid.u64[1])
+                || !binn_object_set_uint32(&id, "I",  entry->id)
+                || !binn_list_add_object(&ids, &id))
+            {
+                MDV_LOGE("binn_p2p_snapshot failed");
+                binn_free(&id);
+                binn_free(&ids);
+                binn_free(&positions);
+                binn_free(&tables);
+                return false;
+            }
+
+            binn_free(&id);
+        }
+    }
+
+    if (!binn_create_object(obj))
+    {
+        MDV_LOGE("binn_p2p_snapshot failed");
+        binn_free(&ids);
+        binn_free(&positions);
+        binn_free(&tables);
+        return false;
+    }
+
+    if (0
+        || !binn_object_set_int32(obj, "E", msg->err)
+        || !binn_object_set_list(obj,  "T", &tables)
+        || !binn_object_set_list(obj,  "P", &positions)
+        || !binn_object_set_list(obj,  "N", &ids))
+    {
+        MDV_LOGE("binn_p2p_snapshot failed");
+        binn_free(obj);
+        binn_free(&ids);
+        binn_free(&positions);
+        binn_free(&tables);
+        return false;
+    }
+
+    binn_free(&ids);
+    binn_free(&positions);
+    binn_free(&tables);
+
+    return true;
+}
+
+
+bool mdv_unbinn_p2p_snapshot(binn const *obj, mdv_msg_p2p_snapshot *msg)
+{
+    binn *tables = 0;
+    binn *positions = 0;
+    binn *ids = 0;
+
+    msg->tables = 0;
+    msg->positions = 0;
+    msg->ids = 0;
+
+    if (0
+        || !binn_object_get_int32((void*)obj, "E", &msg->err)
+        || !binn_object_get_list((void*)obj,  "T", (void**)&tables)
+        || !binn_object_get_list((void*)obj,  "P", (void**)&positions)
+        || !binn_object_get_list((void*)obj,  "N", (void**)&ids))
+    {
+        MDV_LOGE("unbinn_p2p_snapshot failed");
+        return false;
+    }
+
+    msg->tables = mdv_vector_create(8, sizeof(mdv_table*), &mdv_default_allocator);
+    msg->positions = mdv_vector_create(8, sizeof(mdv_trlog_pos), &mdv_default_allocator);
+    msg->ids = mdv_vector_create(8, sizeof(mdv_storage_id), &mdv_default_allocator);
+
+    if (!msg->tables || !msg->positions || !msg->ids)
+    {
+        MDV_LOGE("unbinn_p2p_snapshot failed. No memory.");
+        mdv_p2p_snapshot_free(msg);
+        return false;
+    }
+
+    binn_iter iter = {};
+    binn value = {};
+
+    binn_list_foreach(tables, value)
+    {
+        mdv_table *table = mdv_unbinn_table(&value);
+
+        if (!table)
+        {
+            MDV_LOGE("unbinn_p2p_snapshot failed");
+            mdv_p2p_snapshot_free(msg);
+            return false;
+        }
+
+        if (!mdv_vector_push_back(msg->tables, &table))
+        {
+            MDV_LOGE("unbinn_p2p_snapshot failed. No memory.");
+            mdv_table_release(table);
+            mdv_p2p_snapshot_free(msg);
+            return false;
+        }
+    }
+
+    binn_list_foreach(positions, value)
+    {
+        mdv_trlog_pos pos;
+
+        if (0
+            || !binn_object_get_uint64((void*)&value, "U0", (uint64*)&pos.trlog.u64[0])
+            || !binn_object_get_uint64((void*)&value, "U1", (uint64*)&pos.trlog.u64[1])
+            || !binn_object_get_uint64((void*)&value, "P",  (uint64*)&pos.pos))
+        {
+            MDV_LOGE("unbinn_p2p_snapshot failed");
+            mdv_p2p_snapshot_free(msg);
+            return false;
+        }
+
+        if (!mdv_vector_push_back(msg->positions, &pos))
+        {
+            MDV_LOGE("unbinn_p2p_snapshot failed. No memory.");
+            mdv_p2p_snapshot_free(msg);
+            return false;
+        }
+    }
+
+    binn_list_foreach(ids, value)
+    {
+        mdv_storage_id id;
+
+        if (0
+            || !binn_object_get_uint64((void*)&value, "U0", (uint64*)&id.uuid.u64[0])
+            || !binn_object_get_uint64((void*)&value, "U1", (uint64*)&id.uuid.u64[1])
+            || !binn_object_get_uint32((void*)&value, "I",  &id.id))
+        {
+            MDV_LOGE("unbinn_p2p_snapshot failed");
+            mdv_p2p_snapshot_free(msg);
+            return false;
+        }
+
+        if (!mdv_vector_push_back(msg->ids, &id))
+        {
+            MDV_LOGE("unbinn_p2p_snapshot failed. No memory.");
+            mdv_p2p_snapshot_free(msg);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+void mdv_p2p_snapshot_free(mdv_msg_p2p_snapshot *msg)
+{
+    if (msg->tables)
+    {
+        mdv_vector_foreach(msg->tables, mdv_table_ptr, table)
+            mdv_table_release(*table);
+        mdv_vector_release(msg->tables);
+        msg->tables = 0;
+    }
+
+    mdv_vector_release(msg->positions);
+    msg->positions = 0;
+
+    mdv_vector_release(msg->ids);
+    msg->ids = 0;
+}
+
+
+bool mdv_binn_p2p_view_open(mdv_msg_p2p_view_open const *msg, binn *obj)
+{
+    binn fields, partitions;
+
+    if (!mdv_binn_bitset(msg->fields, &fields))
+    {
+        MDV_LOGE("binn_p2p_view_open failed");
+        return false;
+    }
+
+    if (!mdv_binn_bitset(msg->partitions, &partitions))
+    {
+        MDV_LOGE("binn_p2p_view_open failed");
+        binn_free(&fields);
+        return false;
+    }
+
+    if (!binn_create_object(obj))
+    {
+        MDV_LOGE("binn_p2p_view_open failed");
+        binn_free(&partitions);
+        binn_free(&fields);
+        return false;
+    }
+
+    if (0
+        || !binn_object_set_uint32(obj, "I",  msg->id)
+        || !binn_object_set_uint64(obj, "T0", msg->table.u64[0])
+        || !binn_object_set_uint64(obj, "T1", msg->table.u64[1])
+        || !binn_object_set_list(obj,   "F",  &fields)
+        || !binn_object_set_list(obj,   "P",  &partitions)
+        || !binn_object_set_str(obj,    "S",  (char*)msg->filter)
+        || !binn_object_set_uint32(obj, "C",  msg->count)
+        || !binn_object_set_uint32(obj, "B",  msg->bytes))
+    {
+        MDV_LOGE("binn_p2p_view_open failed");
+        binn_free(obj);
+        binn_free(&partitions);
+        binn_free(&fields);
+        return false;
+    }
+
+    binn_free(&partitions);
+    binn_free(&fields);
+
+    return true;
+}
+
+
+bool mdv_unbinn_p2p_view_open(binn const *obj, mdv_msg_p2p_view_open *msg)
+{
+    binn *fields = 0;
+    binn *partitions = 0;
+
+    msg->fields = 0;
+    msg->partitions = 0;
+
+    if (0
+        || !binn_object_get_uint32((void*)obj, "I",  &msg->id)
+        || !binn_object_get_uint64((void*)obj, "T0", (uint64*)&msg->table.u64[0])
+        || !binn_object_get_uint64((void*)obj, "T1", (uint64*)&msg->table.u64[1])
+        || !binn_object_get_list((void*)obj,   "F",  (void**)&fields)
+        || !binn_object_get_list((void*)obj,   "P",  (void**)&partitions)
+        || !binn_object_get_str((void*)obj,    "S",  (char**)&msg->filter)
+        || !binn_object_get_uint32((void*)obj, "C",  &msg->count)
+        || !binn_object_get_uint32((void*)obj, "B",  &msg->bytes))
+    {
+        MDV_LOGE("unbinn_p2p_view_open failed");
+        return false;
+    }
+
+    msg->fields = mdv_unbinn_bitset(fields);
+    msg->partitions = mdv_unbinn_bitset(partitions);
+
+    if (!msg->fields || !msg->partitions)
+    {
+        MDV_LOGE("unbinn_p2p_view_open failed");
+        mdv_p2p_view_open_free(msg);
+        return false;
+    }
+
+    return true;
+}
+
+
+void mdv_p2p_view_open_free(mdv_msg_p2p_view_open *msg)
+{
+    mdv_bitset_release(msg->fields);
+    mdv_bitset_release(msg->partitions);
+    msg->fields = 0;
+    msg->partitions = 0;
+}
+
+
+bool mdv_binn_p2p_view_read(mdv_msg_p2p_view_read const *msg, binn *obj)
+{
+    if (!binn_create_object(obj))
+    {
+        MDV_LOGE("binn_p2p_view_read failed");
+        return false;
+    }
+
+    if (0
+        || !binn_object_set_uint32(obj, "I", msg->id)
+        || !binn_object_set_uint32(obj, "V", msg->view_id)
+        || !binn_object_set_uint32(obj, "C", msg->count)
+        || !binn_object_set_uint32(obj, "B", msg->bytes))
+    {
+        MDV_LOGE("binn_p2p_view_read failed");
+        binn_free(obj);
+        return false;
+    }
+
+    return true;
+}
+
+
+bool mdv_unbinn_p2p_view_read(binn const *obj, mdv_msg_p2p_view_read *msg)
+{
+    if (0
+        || !binn_object_get_uint32((void*)obj, "I", &msg->id)
+        || !binn_object_get_uint32((void*)obj, "V", &msg->view_id)
+        || !binn_object_get_uint32((void*)obj, "C", &msg->count)
+        || !binn_object_get_uint32((void*)obj, "B", &msg->bytes))
+    {
+        MDV_LOGE("unbinn_p2p_view_read failed");
+        return false;
+    }
+
+    return true;
+}
+
+
+bool mdv_binn_p2p_view_rows(mdv_msg_p2p_view_rows const *msg, binn *obj)
+{
+    if (!binn_create_object(obj))
+    {
+        MDV_LOGE("binn_p2p_view_rows failed");
+        return false;
+    }
+
+    if (0
+        || !binn_object_set_uint32(obj, "I", msg->id)
+        || !binn_object_set_uint32(obj, "V", msg->view_id)
+        || !binn_object_set_int32(obj,  "E", msg->err)
+        || (msg->rows && !binn_object_set_list(obj, "R", msg->rows)))
+    {
+        MDV_LOGE("binn_p2p_view_rows failed");
+        binn_free(obj);
+        return false;
+    }
+
+    return true;
+}
+
+
+bool mdv_unbinn_p2p_view_rows(binn const *obj, mdv_msg_p2p_view_rows *msg)
+{
+    if (0
+        || !binn_object_get_uint32((void*)obj, "I", &msg->id)
+        || !binn_object_get_uint32((void*)obj, "V", &msg->view_id)
+        || !binn_object_get_int32((void*)obj,  "E", &msg->err))
+    {
+        MDV_LOGE("unbinn_p2p_view_rows failed");
+        return false;
+    }
+
+    // Rows aren't sent on error
+    if (!binn_object_get_list((void*)obj, "R", (void**)&msg->rows))
+        msg->rows = 0;
+
+    return true;
+}
+
+
+bool mdv_binn_p2p_delete(mdv_msg_p2p_delete const *msg, binn *obj)
+{
+    binn partitions;
+
+    if (!mdv_binn_bitset(msg->partitions, &partitions))
+    {
+        MDV_LOGE("binn_p2p_delete failed");
+        return false;
+    }
+
+    if (!binn_create_object(obj))
+    {
+        MDV_LOGE("binn_p2p_delete failed");
+        binn_free(&partitions);
+        return false;
+    }
+
+    if (0
+        || !binn_object_set_uint32(obj, "I",  msg->id)
+        || !binn_object_set_uint64(obj, "T0", msg->table.u64[0])
+        || !binn_object_set_uint64(obj, "T1", msg->table.u64[1])
+        || !binn_object_set_list(obj,   "P",  &partitions)
+        || !binn_object_set_str(obj,    "S",  (char*)msg->filter))
+    {
+        MDV_LOGE("binn_p2p_delete failed");
+        binn_free(obj);
+        binn_free(&partitions);
+        return false;
+    }
+
+    binn_free(&partitions);
+
+    return true;
+}
+
+
+bool mdv_unbinn_p2p_delete(binn const *obj, mdv_msg_p2p_delete *msg)
+{
+    binn *partitions = 0;
+
+    msg->partitions = 0;
+
+    if (0
+        || !binn_object_get_uint32((void*)obj, "I",  &msg->id)
+        || !binn_object_get_uint64((void*)obj, "T0", (uint64*)&msg->table.u64[0])
+        || !binn_object_get_uint64((void*)obj, "T1", (uint64*)&msg->table.u64[1])
+        || !binn_object_get_list((void*)obj,   "P",  (void**)&partitions)
+        || !binn_object_get_str((void*)obj,    "S",  (char**)&msg->filter))
+    {
+        MDV_LOGE("unbinn_p2p_delete failed");
+        return false;
+    }
+
+    msg->partitions = mdv_unbinn_bitset(partitions);
+
+    if (!msg->partitions)
+    {
+        MDV_LOGE("unbinn_p2p_delete failed");
+        return false;
+    }
+
+    return true;
+}
+
+
+void mdv_p2p_delete_free(mdv_msg_p2p_delete *msg)
+{
+    mdv_bitset_release(msg->partitions);
+    msg->partitions = 0;
+}
+
+
+bool mdv_binn_p2p_delete_status(mdv_msg_p2p_delete_status const *msg, binn *obj)
+{
+    if (!binn_create_object(obj))
+    {
+        MDV_LOGE("binn_p2p_delete_status failed");
+        return false;
+    }
+
+    if (0
+        || !binn_object_set_uint32(obj, "I", msg->id)
+        || !binn_object_set_int32(obj,  "E", msg->err))
+    {
+        MDV_LOGE("binn_p2p_delete_status failed");
+        binn_free(obj);
+        return false;
+    }
+
+    return true;
+}
+
+
+bool mdv_unbinn_p2p_delete_status(binn const *obj, mdv_msg_p2p_delete_status *msg)
+{
+    if (0
+        || !binn_object_get_uint32((void*)obj, "I", &msg->id)
+        || !binn_object_get_int32((void*)obj,  "E", &msg->err))
+    {
+        MDV_LOGE("unbinn_p2p_delete_status failed");
+        return false;
+    }
+
+    return true;
+}
@@ -3,7 +3,10 @@
 #include <mdv_topology.h>
 #include <mdv_list.h>
 #include <mdv_hashmap.h>
+#include <mdv_vector.h>
+#include <mdv_bitset.h>
 #include "storage/mdv_trlog.h"
+#include "storage/mdv_idmap.h"
 
 
 /*
@@ -19,13 +22,42 @@
     |                                     |
     | TRLOG SYNC >>>>>                    |   Transaction log synchronization request.
     |          <<<<< TRLOG STATE / STATUS |   Last transaction log record identifier.
-    | CFSLOG DATA >>>>>                   |   Transaction log records.
-    |          <<<<< TRLOG STATE / STATUS |
+    | TRLOG DATA >>>>>                    |   Transaction log records. Several batches are sent
+    | TRLOG DATA >>>>>                    |   without waiting for acknowledgements (datasync.window).
+    |                   <<<<< TRLOG STATE |   Each batch is acknowledged by the transaction log top.
+    |                   <<<<< TRLOG STATE |   Records are sent again from the top if a batch isn't accepted.
+    |                                     |
+    |                                     |
+    | SNAPSHOT REQUEST >>>>>              |   Empty node bootstrapping. Tables storages snapshot request.
+    |               <<<<< SNAPSHOT DATA   |   Tables storages copies are sent by chunks.
+    |               <<<<< SNAPSHOT DATA   |
+    |                    <<<<< SNAPSHOT   |   Tables descriptors, transaction logs positions covered by snapshot
+    |                                     |   and storage identifiers used in the tables storages.
+    |                                     |
+    |                                     |
+    | VIEW OPEN >>>>>                     |   Partitioned table rows selection. View is opened on the partitions owner.
+    |                   <<<<< VIEW ROWS   |   First rows batch and the remote view identifier.
+    | VIEW READ >>>>>                     |   Next rows batch request.
+    |                   <<<<< VIEW ROWS   |   Rows batch. Empty batch or error finishes the view.
+    |                                     |
+    |                                     |
+    | DELETE >>>>>                        |   Partitioned table rows deletion. Rows are deleted by the partitions owner.
+    |                 <<<<< DELETE STATUS |   Rows deletion result.
  */
 
 
+/// Peer features advertised in handshake
+enum
+{
+    MDV_P2P_FEATURE_LZ4         = 1 << 0,   ///< Peer accepts LZ4 compressed transaction log data
+    MDV_P2P_FEATURE_SNAPSHOT    = 1 << 1,   ///< Peer sends the tables storages snapshot on request
+    MDV_P2P_FEATURE_DELETE      = 1 << 2,   ///< Peer deletes rows of its partitions on request
+};
+
+
 mdv_message_def(p2p_hello, 1000 + 0,
     char const *listen;             ///< Listening address
+    uint32_t    features;           ///< Peer features (MDV_P2P_FEATURE_*)
 );
 
 
@@ -65,6 +97,7 @@ mdv_message_def(p2p_trlog_state, 1000 + 6,
 
 mdv_message_def(p2p_trlog_data, 1000 + 7,
     mdv_uuid    trlog;              ///< Transaction log storage unique identifier
+    uint64_t    start;              ///< First transaction log position covered by records
     uint32_t    count;              ///< log records count
     mdv_list    rows;               ///< transaction log data (list<mdv_trlog_data>)
 );
@@ -78,6 +111,68 @@ mdv_message_def(p2p_broadcast, 1000 + 8,
 );
 
 
+mdv_message_def(p2p_snapshot_req, 1000 + 9,
+);
+
+
+mdv_message_def(p2p_snapshot_data, 1000 + 10,
+    mdv_uuid    table;              ///< Table unique identifier
+    uint64_t    offset;             ///< Chunk offset in the table storage copy
+    uint64_t    total;              ///< Table storage copy size
+    uint32_t    size;               ///< Chunk size
+    void const *data;               ///< Chunk data
+);
+
+
+mdv_message_def(p2p_snapshot, 1000 + 11,
+    int         err;                ///< Snapshot creation result
+    mdv_vector *tables;             ///< Tables descriptors (vector<mdv_table*>)
+    mdv_vector *positions;          ///< Transaction logs positions covered by snapshot (vector<mdv_trlog_pos>)
+    mdv_vector *ids;                ///< Storage identifiers used in the tables storages (vector<mdv_storage_id>)
+);
+
+
+mdv_message_def(p2p_view_open, 1000 + 12,
+    uint32_t    id;                 ///< Remote view identifier on the requesting node
+    mdv_uuid    table;              ///< Table unique identifier
+    mdv_bitset *fields;             ///< Fields mask
+    mdv_bitset *partitions;         ///< Partitions mask
+    char const *filter;             ///< Predicate for rows filtering
+    uint32_t    count;              ///< Rows number limit for the first batch
+    uint32_t    bytes;              ///< Serialized rows size limit for the first batch
+);
+
+
+mdv_message_def(p2p_view_read, 1000 + 13,
+    uint32_t    id;                 ///< Remote view identifier on the requesting node
+    uint32_t    view_id;            ///< View identifier on the partitions owner
+    uint32_t    count;              ///< Rows number limit
+    uint32_t    bytes;              ///< Serialized rows size limit
+);
+
+
+mdv_message_def(p2p_view_rows, 1000 + 14,
+    uint32_t    id;                 ///< Remote view identifier on the requesting node
+    uint32_t    view_id;            ///< View identifier on the partitions owner
+    int         err;                ///< Rows reading result
+    binn       *rows;               ///< Serialized rows (NULL on error)
+);
+
+
+mdv_message_def(p2p_delete, 1000 + 15,
+    uint32_t    id;                 ///< Deletion request identifier on the requesting node
+    mdv_uuid    table;              ///< Table unique identifier
+    mdv_bitset *partitions;         ///< Partitions mask
+    char const *filter;             ///< Predicate for rows filtering
+);
+
+
+mdv_message_def(p2p_delete_status, 1000 + 16,
+    uint32_t    id;                 ///< Deletion request identifier on the requesting node
+    int         err;                ///< Rows deletion result
+);
+
+
 char const *    mdv_p2p_msg_name                        (uint32_t id);
 
 
@@ -111,10 +206,63 @@ bool            mdv_binn_p2p_trlog_state                (mdv_msg_p2p_trlog_state
 bool            mdv_unbinn_p2p_trlog_state              (binn const *obj, mdv_msg_p2p_trlog_state *msg);
 
 
-bool            mdv_binn_p2p_trlog_data                 (mdv_msg_p2p_trlog_data const *msg, binn *obj);
+/// Transaction log data compression statistics
+typedef struct
+{
+    size_t raw_size;                ///< Serialized records size
+    size_t size;                    ///< Transmitted records size
+} mdv_p2p_trlog_data_stat;
+
+
+/**
+ * @brief Serializes transaction log data message.
+ * @details Records list is compressed by LZ4 if its serialized size is not less than threshold
+ *          and compression reduces the size. Otherwise the records are serialized as is.
+ *
+ * @param msg [in]          transaction log data message
+ * @param threshold [in]    minimal records size for compression (in bytes). Zero disables compression.
+ * @param obj [out]         serialized message
+ * @param stat [out]        records size before and after compression
+ */
+bool            mdv_binn_p2p_trlog_data                 (mdv_msg_p2p_trlog_data const *msg, size_t threshold, binn *obj, mdv_p2p_trlog_data_stat *stat);
 bool            mdv_unbinn_p2p_trlog_data               (binn const *obj, mdv_msg_p2p_trlog_data *msg);
 void            mdv_p2p_trlog_data_free                 (mdv_msg_p2p_trlog_data *msg);
 
 
 bool            mdv_binn_p2p_broadcast                  (mdv_msg_p2p_broadcast const *msg, binn *obj);
 bool            mdv_unbinn_p2p_broadcast                (binn const *obj, mdv_msg_p2p_broadcast *msg);
+
+
+bool            mdv_binn_p2p_snapshot_req               (mdv_msg_p2p_snapshot_req const *msg, binn *obj);
+bool            mdv_unbinn_p2p_snapshot_req             (binn const *obj, mdv_msg_p2p_snapshot_req *msg);
+
+
+bool            mdv_binn_p2p_snapshot_data              (mdv_msg_p2p_snapshot_data const *msg, binn *obj);
+bool            mdv_unbinn_p2p_snapshot_data            (binn const *obj, mdv_msg_p2p_snapshot_data *msg);
+
+
+bool            mdv_binn_p2p_snapshot                   (mdv_msg_p2p_snapshot const *msg, binn *obj);
+bool            mdv_unbinn_p2p_snapshot                 (binn const *obj, mdv_msg_p2p_snapshot *msg);
+void            mdv_p2p_snapshot_free                   (mdv_msg_p2p_snapshot *msg);
+
+
+bool            mdv_binn_p2p_view_open                  (mdv_msg_p2p_view_open const *msg, binn *obj);
+bool            mdv_unbinn_p2p_view_open                (binn const *obj, mdv_msg_p2p_view_open *msg);
+void            mdv_p2p_view_open_free                  (mdv_msg_p2p_view_open *msg);
+
+
+bool            mdv_binn_p2p_view_read                  (mdv_msg_p2p_view_read const *msg, binn *obj);
+bool            mdv_unbinn_p2p_view_read                (binn const *obj, mdv_msg_p2p_view_read *msg);
+
+
+bool            mdv_binn_p2p_view_rows                  (mdv_msg_p2p_view_rows const *msg, binn *obj);
+bool            mdv_unbinn_p2p_view_rows                (binn const *obj, mdv_msg_p2p_view_rows *msg);
+
+
+bool            mdv_binn_p2p_delete                     (mdv_msg_p2p_delete const *msg, binn *obj);
+bool            mdv_unbinn_p2p_delete                   (binn const *obj, mdv_msg_p2p_delete *msg);
+void            mdv_p2p_delete_free                     (mdv_msg_p2p_delete *msg);
+
+
+bool            mdv_binn_p2p_delete_status              (mdv_msg_p2p_delete_status const *msg, binn *obj);
+bool            mdv_unbinn_p2p_delete_status            (binn const *obj, mdv_msg_p2p_delete_status *msg);
@@ -6,6 +6,9 @@
 #include "event/mdv_evt_topology.h"
 #include "event/mdv_evt_broadcast.h"
 #include "event/mdv_evt_trlog.h"
+#include "event/mdv_evt_snapshot.h"
+#include "event/mdv_evt_view.h"
+#include "event/mdv_evt_rowdata.h"
 #include <mdv_alloc.h>
 #include <mdv_threads.h>
 #include <mdv_log.h>
@@ -26,6 +29,9 @@ typedef struct
     mdv_uuid                uuid;           ///< current node uuid
     mdv_uuid                peer_uuid;      ///< peer global uuid
     char                   *peer_addr;      ///< peer address
+    atomic_uint             peer_features;  ///< peer features (MDV_P2P_FEATURE_*)
+    atomic_size_t           trlog_raw;      ///< transaction log data size before compression
+    atomic_size_t           trlog_sent;     ///< transaction log data size after compression
     mdv_dispatcher         *dispatcher;     ///< Messages dispatcher
     mdv_ebus               *ebus;           ///< Events bus
 } mdv_peer;
@@ -197,6 +203,8 @@ static mdv_errno mdv_peer_hello_handler(mdv_msg const *msg, void *arg)
 
     MDV_LOGI("<<<<< %s '%s'", mdv_uuid_to_str(&peer->peer_uuid, uuid_str), mdv_p2p_msg_name(msg->hdr.id));
 
+    atomic_store_explicit(&peer->peer_features, req.features, memory_order_relaxed);
+
     mdv_free(peer->peer_addr);
 
     peer->peer_addr = mdv_string_dup(req.listen);
@@ -372,150 +380,888 @@ static mdv_errno mdv_peer_trlog_state_handler(mdv_msg const *msg, void *arg)
 {
     mdv_peer *peer = arg;
 
-    char uuid_str[MDV_UUID_STR_LEN];
+    char uuid_str[MDV_UUID_STR_LEN];
+
+    MDV_LOGI("<<<<< %s '%s'", mdv_uuid_to_str(&peer->peer_uuid, uuid_str), mdv_p2p_msg_name(msg->hdr.id));
+
+    binn binn_msg;
+
+    if(!binn_load(msg->payload, &binn_msg))
+    {
+        MDV_LOGW("Message '%s' reading failed", mdv_p2p_msg_name(msg->hdr.id));
+        return MDV_FAILED;
+    }
+
+    mdv_msg_p2p_trlog_state req;
+
+    if (!mdv_unbinn_p2p_trlog_state(&binn_msg, &req))
+    {
+        MDV_LOGE("Transaction log state processing failed");
+        binn_free(&binn_msg);
+        return MDV_FAILED;
+    }
+
+    MDV_LOGI("RECV %s '%s': TR log top: %" PRId64,
+             mdv_uuid_to_str(&peer->peer_uuid, uuid_str),
+             mdv_p2p_msg_name(msg->hdr.id),
+             req.trlog_top);
+
+    binn_free(&binn_msg);
+
+    mdv_evt_trlog_state *state = mdv_evt_trlog_state_create(&req.trlog, &peer->peer_uuid, &peer->uuid, req.trlog_top);
+
+    if (state)
+    {
+        // Acknowledgements are handled in order of receiving
+        if (mdv_ebus_publish(peer->ebus, &state->base, MDV_EVT_SYNC) != MDV_OK)
+            MDV_LOGE("Transaction log state notification failed");
+        mdv_evt_trlog_state_release(state);
+    }
+    else
+    {
+        MDV_LOGE("Transaction log state notification failed. No memory.");
+        return MDV_NO_MEM;
+    }
+
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_peer_trlog_data_handler(mdv_msg const *msg, void *arg)
+{
+    mdv_peer *peer = arg;
+
+    char uuid_str[MDV_UUID_STR_LEN];
+
+    MDV_LOGI("<<<<< %s '%s'", mdv_uuid_to_str(&peer->peer_uuid, uuid_str), mdv_p2p_msg_name(msg->hdr.id));
+
+    binn binn_msg;
+
+    if(!binn_load(msg->payload, &binn_msg))
+    {
+        MDV_LOGW("Message '%s' reading failed", mdv_p2p_msg_name(msg->hdr.id));
+        return MDV_FAILED;
+    }
+
+    mdv_msg_p2p_trlog_data req = {};
+
+    if (!mdv_unbinn_p2p_trlog_data(&binn_msg, &req))
+    {
+        MDV_LOGE("Transaction log data processing failed");
+        binn_free(&binn_msg);
+        return MDV_FAILED;
+    }
+
+    MDV_LOGI("RECV %s '%s': start: %" PRIu64 ", count: %u",
+             mdv_uuid_to_str(&peer->peer_uuid, uuid_str),
+             mdv_p2p_msg_name(msg->hdr.id),
+             req.start,
+             req.count);
+
+    binn_free(&binn_msg);
+
+    mdv_evt_trlog_data *data = mdv_evt_trlog_data_create(&req.trlog, &peer->peer_uuid, &peer->uuid, req.start, &req.rows, req.count);
+
+    if (data)
+    {
+        // Records batches are queued for saving in order of receiving
+        if (mdv_ebus_publish(peer->ebus, &data->base, MDV_EVT_SYNC) != MDV_OK)
+            MDV_LOGE("Transaction log data processing failed");
+        mdv_evt_trlog_data_release(data);
+    }
+    else
+    {
+        MDV_LOGE("Transaction log data processing failed. No memory.");
+        return MDV_NO_MEM;
+    }
+
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_peer_snapshot_req_handler(mdv_msg const *msg, void *arg)
+{
+    mdv_peer *peer = arg;
+
+    char uuid_str[MDV_UUID_STR_LEN];
+
+    MDV_LOGI("<<<<< %s '%s'", mdv_uuid_to_str(&peer->peer_uuid, uuid_str), mdv_p2p_msg_name(msg->hdr.id));
+
+    mdv_evt_snapshot_request *req = mdv_evt_snapshot_request_create(&peer->peer_uuid, &peer->uuid);
+
+    if (req)
+    {
+        if (mdv_ebus_publish(peer->ebus, &req->base, MDV_EVT_DEFAULT) != MDV_OK)
+            MDV_LOGE("Snapshot request processing failed");
+        mdv_evt_snapshot_request_release(req);
+    }
+    else
+    {
+        MDV_LOGE("Snapshot request processing failed. No memory.");
+        return MDV_NO_MEM;
+    }
+
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_peer_snapshot_data_handler(mdv_msg const *msg, void *arg)
+{
+    mdv_peer *peer = arg;
+
+    char uuid_str[MDV_UUID_STR_LEN];
+
+    binn binn_msg;
+
+    if(!binn_load(msg->payload, &binn_msg))
+    {
+        MDV_LOGW("Message '%s' reading failed", mdv_p2p_msg_name(msg->hdr.id));
+        return MDV_FAILED;
+    }
+
+    mdv_msg_p2p_snapshot_data req;
+
+    if (!mdv_unbinn_p2p_snapshot_data(&binn_msg, &req))
+    {
+        MDV_LOGE("Snapshot data processing failed");
+        binn_free(&binn_msg);
+        return MDV_FAILED;
+    }
+
+    MDV_LOGD("RECV %s '%s': offset: %" PRIu64 ", size: %u",
+             mdv_uuid_to_str(&peer->peer_uuid, uuid_str),
+             mdv_p2p_msg_name(msg->hdr.id),
+             req.offset,
+             req.size);
+
+    mdv_errno err = MDV_OK;
+
+    mdv_evt_snapshot_data *data = mdv_evt_snapshot_data_create(&peer->peer_uuid,
+                                                               &peer->uuid,
+                                                               &req.table,
+                                                               req.offset,
+                                                               req.total,
+                                                               req.size,
+                                                               req.data);
+
+    if (data)
+    {
+        // Chunks are written in order of receiving
+        err = mdv_ebus_publish(peer->ebus, &data->base, MDV_EVT_SYNC);
+        if (err != MDV_OK)
+            MDV_LOGE("Snapshot data processing failed");
+        mdv_evt_snapshot_data_release(data);
+    }
+    else
+    {
+        MDV_LOGE("Snapshot data processing failed. No memory.");
+        err = MDV_NO_MEM;
+    }
+
+    binn_free(&binn_msg);
+
+    return err;
+}
+
+
+static mdv_errno mdv_peer_snapshot_handler(mdv_msg const *msg, void *arg)
+{
+    mdv_peer *peer = arg;
+
+    char uuid_str[MDV_UUID_STR_LEN];
+
+    MDV_LOGI("<<<<< %s '%s'", mdv_uuid_to_str(&peer->peer_uuid, uuid_str), mdv_p2p_msg_name(msg->hdr.id));
+
+    binn binn_msg;
+
+    if(!binn_load(msg->payload, &binn_msg))
+    {
+        MDV_LOGW("Message '%s' reading failed", mdv_p2p_msg_name(msg->hdr.id));
+        return MDV_FAILED;
+    }
+
+    mdv_msg_p2p_snapshot req;
+
+    if (!mdv_unbinn_p2p_snapshot(&binn_msg, &req))
+    {
+        MDV_LOGE("Snapshot processing failed");
+        binn_free(&binn_msg);
+        return MDV_FAILED;
+    }
+
+    binn_free(&binn_msg);
+
+    mdv_errno err = MDV_OK;
+
+    mdv_evt_snapshot *snapshot = mdv_evt_snapshot_create(&peer->peer_uuid,
+                                                         &peer->uuid,
+                                                         req.err,
+                                                         req.tables,
+                                                         req.positions,
+                                                         req.ids);
+
+    if (snapshot)
+    {
+        // Snapshot is installed after all chunks are written
+        err = mdv_ebus_publish(peer->ebus, &snapshot->base, MDV_EVT_SYNC);
+        if (err != MDV_OK)
+            MDV_LOGE("Snapshot processing failed");
+        mdv_evt_snapshot_release(snapshot);
+    }
+    else
+    {
+        MDV_LOGE("Snapshot processing failed. No memory.");
+        err = MDV_NO_MEM;
+    }
+
+    mdv_p2p_snapshot_free(&req);
+
+    return err;
+}
+
+
+static mdv_errno mdv_peer_view_open_handler(mdv_msg const *msg, void *arg)
+{
+    mdv_peer *peer = arg;
+
+    char uuid_str[MDV_UUID_STR_LEN];
+
+    MDV_LOGI("<<<<< %s '%s'", mdv_uuid_to_str(&peer->peer_uuid, uuid_str), mdv_p2p_msg_name(msg->hdr.id));
+
+    binn binn_msg;
+
+    if(!binn_load(msg->payload, &binn_msg))
+    {
+        MDV_LOGW("Message '%s' reading failed", mdv_p2p_msg_name(msg->hdr.id));
+        return MDV_FAILED;
+    }
+
+    mdv_msg_p2p_view_open req;
+
+    if (!mdv_unbinn_p2p_view_open(&binn_msg, &req))
+    {
+        MDV_LOGE("View opening failed");
+        binn_free(&binn_msg);
+        return MDV_FAILED;
+    }
+
+    mdv_errno err = MDV_OK;
+
+    mdv_evt_view_open *open = mdv_evt_view_open_create(&peer->peer_uuid,
+                                                       &peer->uuid,
+                                                       req.id,
+                                                       &req.table,
+                                                       req.fields,
+                                                       req.partitions,
+                                                       req.filter,
+                                                       req.count,
+                                                       req.bytes);
+
+    if (open)
+    {
+        err = mdv_ebus_publish(peer->ebus, &open->base, MDV_EVT_SYNC);
+        if (err != MDV_OK)
+            MDV_LOGE("View opening failed");
+        mdv_evt_view_open_release(open);
+    }
+    else
+    {
+        MDV_LOGE("View opening failed. No memory.");
+        err = MDV_NO_MEM;
+    }
+
+    mdv_p2p_view_open_free(&req);
+
+    binn_free(&binn_msg);
+
+    return err;
+}
+
+
+static mdv_errno mdv_peer_view_read_handler(mdv_msg const *msg, void *arg)
+{
+    mdv_peer *peer = arg;
+
+    char uuid_str[MDV_UUID_STR_LEN];
+
+    MDV_LOGD("<<<<< %s '%s'", mdv_uuid_to_str(&peer->peer_uuid, uuid_str), mdv_p2p_msg_name(msg->hdr.id));
+
+    binn binn_msg;
+
+    if(!binn_load(msg->payload, &binn_msg))
+    {
+        MDV_LOGW("Message '%s' reading failed", mdv_p2p_msg_name(msg->hdr.id));
+        return MDV_FAILED;
+    }
+
+    mdv_msg_p2p_view_read req;
+
+    if (!mdv_unbinn_p2p_view_read(&binn_msg, &req))
+    {
+        MDV_LOGE("View reading failed");
+        binn_free(&binn_msg);
+        return MDV_FAILED;
+    }
+
+    binn_free(&binn_msg);
+
+    mdv_errno err = MDV_OK;
+
+    mdv_evt_view_read *read = mdv_evt_view_read_create(&peer->peer_uuid,
+                                                       &peer->uuid,
+                                                       req.id,
+                                                       req.view_id,
+                                                       req.count,
+                                                       req.bytes);
+
+    if (read)
+    {
+        err = mdv_ebus_publish(peer->ebus, &read->base, MDV_EVT_SYNC);
+        if (err != MDV_OK)
+            MDV_LOGE("View reading failed");
+        mdv_evt_view_read_release(read);
+    }
+    else
+    {
+        MDV_LOGE("View reading failed. No memory.");
+        err = MDV_NO_MEM;
+    }
+
+    return err;
+}
+
+
+static mdv_errno mdv_peer_view_rows_handler(mdv_msg const *msg, void *arg)
+{
+    mdv_peer *peer = arg;
+
+    char uuid_str[MDV_UUID_STR_LEN];
+
+    MDV_LOGD("<<<<< %s '%s'", mdv_uuid_to_str(&peer->peer_uuid, uuid_str), mdv_p2p_msg_name(msg->hdr.id));
+
+    binn binn_msg;
+
+    if(!binn_load(msg->payload, &binn_msg))
+    {
+        MDV_LOGW("Message '%s' reading failed", mdv_p2p_msg_name(msg->hdr.id));
+        return MDV_FAILED;
+    }
+
+    mdv_msg_p2p_view_rows req;
+
+    if (!mdv_unbinn_p2p_view_rows(&binn_msg, &req))
+    {
+        MDV_LOGE("View rows processing failed");
+        binn_free(&binn_msg);
+        return MDV_FAILED;
+    }
+
+    mdv_errno err = MDV_OK;
+
+    // Rows are copied by the remote view before the message is released
+    mdv_evt_view_rows *rows = mdv_evt_view_rows_create(&peer->peer_uuid,
+                                                       &peer->uuid,
+                                                       req.id,
+                                                       req.view_id,
+                                                       req.err,
+                                                       req.rows);
+
+    if (rows)
+    {
+        err = mdv_ebus_publish(peer->ebus, &rows->base, MDV_EVT_SYNC);
+        if (err != MDV_OK)
+            MDV_LOGE("View rows processing failed");
+        mdv_evt_view_rows_release(rows);
+    }
+    else
+    {
+        MDV_LOGE("View rows processing failed. No memory.");
+        err = MDV_NO_MEM;
+    }
+
+    binn_free(&binn_msg);
+
+    return err;
+}
+
+
+static mdv_errno mdv_peer_delete_handler(mdv_msg const *msg, void *arg)
+{
+    mdv_peer *peer = arg;
+
+    char uuid_str[MDV_UUID_STR_LEN];
+
+    MDV_LOGI("<<<<< %s '%s'", mdv_uuid_to_str(&peer->peer_uuid, uuid_str), mdv_p2p_msg_name(msg->hdr.id));
+
+    binn binn_msg;
+
+    if(!binn_load(msg->payload, &binn_msg))
+    {
+        MDV_LOGW("Message '%s' reading failed", mdv_p2p_msg_name(msg->hdr.id));
+        return MDV_FAILED;
+    }
+
+    mdv_msg_p2p_delete req;
+
+    if (!mdv_unbinn_p2p_delete(&binn_msg, &req))
+    {
+        MDV_LOGE("Rows deletion failed");
+        binn_free(&binn_msg);
+        return MDV_FAILED;
+    }
+
+    mdv_errno err = MDV_OK;
+
+    mdv_evt_rowdata_del_remote *del = mdv_evt_rowdata_del_remote_create(&peer->peer_uuid,
+                                                                        &peer->uuid,
+                                                                        req.id,
+                                                                        &req.table,
+                                                                        req.partitions,
+                                                                        req.filter);
+
+    if (del)
+    {
+        err = mdv_ebus_publish(peer->ebus, &del->base, MDV_EVT_SYNC);
+        if (err != MDV_OK)
+            MDV_LOGE("Rows deletion failed");
+        mdv_evt_rowdata_del_remote_release(del);
+    }
+    else
+    {
+        MDV_LOGE("Rows deletion failed. No memory.");
+        err = MDV_NO_MEM;
+    }
+
+    mdv_p2p_delete_free(&req);
+
+    binn_free(&binn_msg);
+
+    return err;
+}
+
+
+static mdv_errno mdv_peer_delete_status_handler(mdv_msg const *msg, void *arg)
+{
+    mdv_peer *peer = arg;
+
+    char uuid_str[MDV_UUID_STR_LEN];
+
+    MDV_LOGI("<<<<< %s '%s'", mdv_uuid_to_str(&peer->peer_uuid, uuid_str), mdv_p2p_msg_name(msg->hdr.id));
+
+    binn binn_msg;
+
+    if(!binn_load(msg->payload, &binn_msg))
+    {
+        MDV_LOGW("Message '%s' reading failed", mdv_p2p_msg_name(msg->hdr.id));
+        return MDV_FAILED;
+    }
+
+    mdv_msg_p2p_delete_status req;
+
+    if (!mdv_unbinn_p2p_delete_status(&binn_msg, &req))
+    {
+        MDV_LOGE("Rows deletion status processing failed");
+        binn_free(&binn_msg);
+        return MDV_FAILED;
+    }
+
+    mdv_errno err = MDV_OK;
+
+    mdv_evt_rowdata_del_status *status = mdv_evt_rowdata_del_status_create(&peer->peer_uuid,
+                                                                          &peer->uuid,
+                                                                          req.id,
+                                                                          req.err);
+
+    if (status)
+    {
+        err = mdv_ebus_publish(peer->ebus, &status->base, MDV_EVT_SYNC);
+        if (err != MDV_OK)
+            MDV_LOGE("Rows deletion status processing failed");
+        mdv_evt_rowdata_del_status_release(status);
+    }
+    else
+    {
+        MDV_LOGE("Rows deletion status processing failed. No memory.");
+        err = MDV_NO_MEM;
+    }
+
+    binn_free(&binn_msg);
+
+    return err;
+}
+
+
+/**
+ * @brief Post hello message
+ */
+static mdv_errno mdv_peer_hello(mdv_peer *peer)
+{
+    mdv_msg_p2p_hello hello =
+    {
+        .listen   = MDV_CONFIG.server.listen,
+        .features = (MDV_CONFIG.connection.compression ? MDV_P2P_FEATURE_LZ4 : 0)
+                    | MDV_P2P_FEATURE_SNAPSHOT
+                    | MDV_P2P_FEATURE_DELETE
+    };
+
+    binn hey;
+
+    if (!mdv_binn_p2p_hello(&hello, &hey))
+        return MDV_FAILED;
+
+    mdv_msg message =
+    {
+        .hdr =
+        {
+            .id = mdv_message_id(p2p_hello),
+            .size = binn_size(&hey)
+        },
+        .payload = binn_ptr(&hey)
+    };
+
+    mdv_errno err = mdv_peer_post(peer, &message);
+
+    binn_free(&hey);
+
+    return err;
+}
+
+
+/**
+ * @brief Post topology synchronization message
+ */
+static mdv_errno mdv_peer_toposync(mdv_peer *peer, mdv_topology *topology)
+{
+    mdv_msg_p2p_toposync const toposync =
+    {
+        .topology = topology
+    };
+
+    binn obj;
+
+    if (!mdv_binn_p2p_toposync(&toposync, &obj))
+    {
+        MDV_LOGE("Topology synchronization request failed");
+        return MDV_FAILED;
+    }
+
+    mdv_msg message =
+    {
+        .hdr =
+        {
+            .id = mdv_message_id(p2p_toposync),
+            .size = binn_size(&obj)
+        },
+        .payload = binn_ptr(&obj)
+    };
+
+    mdv_errno err = mdv_peer_post(peer, &message);
+
+    binn_free(&obj);
+
+    return err;
+}
+
+
+/**
+ * @brief Post trlog synchronization message
+ */
+static mdv_errno mdv_peer_trlog_sync(mdv_peer *peer, mdv_uuid const *trlog)
+{
+    mdv_msg_p2p_trlog_sync const trlog_sync =
+    {
+        .trlog = *trlog
+    };
+
+    binn obj;
+
+    if (!mdv_binn_p2p_trlog_sync(&trlog_sync, &obj))
+    {
+        MDV_LOGE("Transaction log synchronization request failed");
+        return MDV_FAILED;
+    }
+
+    mdv_msg message =
+    {
+        .hdr =
+        {
+            .id = mdv_message_id(p2p_trlog_sync),
+            .size = binn_size(&obj)
+        },
+        .payload = binn_ptr(&obj)
+    };
+
+    mdv_errno err = mdv_peer_post(peer, &message);
+
+    binn_free(&obj);
+
+    return err;
+}
+
+
+/**
+ * @brief Post trlog state message
+ */
+static mdv_errno mdv_peer_trlog_state(mdv_peer *peer, mdv_uuid const *trlog, uint64_t top)
+{
+    mdv_msg_p2p_trlog_state const trlog_state =
+    {
+        .trlog = *trlog,
+        .trlog_top = top
+    };
+
+    binn obj;
+
+    if (!mdv_binn_p2p_trlog_state(&trlog_state, &obj))
+    {
+        MDV_LOGE("Transaction log state notification failed");
+        return MDV_FAILED;
+    }
+
+    mdv_msg message =
+    {
+        .hdr =
+        {
+            .id = mdv_message_id(p2p_trlog_state),
+            .size = binn_size(&obj)
+        },
+        .payload = binn_ptr(&obj)
+    };
+
+    mdv_errno err = mdv_peer_post(peer, &message);
+
+    binn_free(&obj);
+
+    return err;
+}
+
+
+/**
+ * @brief Post trlog data message
+ */
+static mdv_errno mdv_peer_trlog_data(mdv_peer *peer, mdv_uuid const *trlog, uint64_t start, mdv_list const *rows, uint32_t count)
+{
+    mdv_msg_p2p_trlog_data const trlog_data =
+    {
+        .trlog = *trlog,
+        .start = start,
+        .count = count,
+        .rows = *rows
+    };
+
+    // Data is compressed only if the peer advertised LZ4 support
+    uint32_t const features = atomic_load_explicit(&peer->peer_features, memory_order_relaxed);
+
+    size_t threshold = 0;
 
-    MDV_LOGI("<<<<< %s '%s'", mdv_uuid_to_str(&peer->peer_uuid, uuid_str), mdv_p2p_msg_name(msg->hdr.id));
+    if (MDV_CONFIG.connection.compression && (features & MDV_P2P_FEATURE_LZ4))
+        threshold = MDV_CONFIG.connection.compression_threshold ? MDV_CONFIG.connection.compression_threshold : 1;
 
-    binn binn_msg;
+    binn obj;
+    mdv_p2p_trlog_data_stat stat;
 
-    if(!binn_load(msg->payload, &binn_msg))
+    if (!mdv_binn_p2p_trlog_data(&trlog_data, threshold, &obj, &stat))
     {
-        MDV_LOGW("Message '%s' reading failed", mdv_p2p_msg_name(msg->hdr.id));
+        MDV_LOGE("Transaction log data posting failed");
         return MDV_FAILED;
     }
 
-    mdv_msg_p2p_trlog_state req;
+    atomic_fetch_add_explicit(&peer->trlog_raw, stat.raw_size, memory_order_relaxed);
+    atomic_fetch_add_explicit(&peer->trlog_sent, stat.size, memory_order_relaxed);
 
-    if (!mdv_unbinn_p2p_trlog_state(&binn_msg, &req))
+    if (stat.size != stat.raw_size)
+        MDV_LOGD("Transaction log data compressed: %zu -> %zu bytes", stat.raw_size, stat.size);
+
+    mdv_msg message =
     {
-        MDV_LOGE("Transaction log state processing failed");
-        binn_free(&binn_msg);
-        return MDV_FAILED;
-    }
+        .hdr =
+        {
+            .id = mdv_message_id(p2p_trlog_data),
+            .size = binn_size(&obj)
+        },
+        .payload = binn_ptr(&obj)
+    };
 
-    MDV_LOGI("RECV %s '%s': TR log top: %" PRId64,
-             mdv_uuid_to_str(&peer->peer_uuid, uuid_str),
-             mdv_p2p_msg_name(msg->hdr.id),
-             req.trlog_top);
+    mdv_errno err = mdv_peer_post(peer, &message);
 
-    binn_free(&binn_msg);
+    binn_free(&obj);
 
-    mdv_evt_trlog_state *state = mdv_evt_trlog_state_create(&req.trlog, &peer->peer_uuid, &peer->uuid, req.trlog_top);
+    return err;
+}
 
-    if (state)
+
+/**
+ * @brief Post snapshot request message
+ */
+static mdv_errno mdv_peer_snapshot_req(mdv_peer *peer)
+{
+    mdv_msg_p2p_snapshot_req const snapshot_req = {};
+
+    binn obj;
+
+    if (!mdv_binn_p2p_snapshot_req(&snapshot_req, &obj))
     {
-        if (mdv_ebus_publish(peer->ebus, &state->base, MDV_EVT_DEFAULT) != MDV_OK)
-            MDV_LOGE("Transaction log state notification failed");
-        mdv_evt_trlog_state_release(state);
+        MDV_LOGE("Snapshot request failed");
+        return MDV_FAILED;
     }
-    else
+
+    mdv_msg message =
     {
-        MDV_LOGE("Transaction log state notification failed. No memory.");
-        return MDV_NO_MEM;
-    }
+        .hdr =
+        {
+            .id = mdv_message_id(p2p_snapshot_req),
+            .size = binn_size(&obj)
+        },
+        .payload = binn_ptr(&obj)
+    };
 
-    return MDV_OK;
-}
+    mdv_errno err = mdv_peer_post(peer, &message);
 
+    binn_free(&obj);
 
-static mdv_errno mdv_peer_trlog_data_handler(mdv_msg const *msg, void *arg)
-{
-    mdv_peer *peer = arg;
+    return err;
+}
 
-    char uuid_str[MDV_UUID_STR_LEN];
 
-    MDV_LOGI("<<<<< %s '%s'", mdv_uuid_to_str(&peer->peer_uuid, uuid_str), mdv_p2p_msg_name(msg->hdr.id));
+/**
+ * @brief Post snapshot data message
+ */
+static mdv_errno mdv_peer_snapshot_data(mdv_peer *peer, mdv_evt_snapshot_data const *data)
+{
+    mdv_msg_p2p_snapshot_data const snapshot_data =
+    {
+        .table  = data->table,
+        .offset = data->offset,
+        .total  = data->total,
+        .size   = data->size,
+        .data   = data->data
+    };
 
-    binn binn_msg;
+    binn obj;
 
-    if(!binn_load(msg->payload, &binn_msg))
+    if (!mdv_binn_p2p_snapshot_data(&snapshot_data, &obj))
     {
-        MDV_LOGW("Message '%s' reading failed", mdv_p2p_msg_name(msg->hdr.id));
+        MDV_LOGE("Snapshot data posting failed");
         return MDV_FAILED;
     }
 
-    mdv_msg_p2p_trlog_data req = {};
-
-    if (!mdv_unbinn_p2p_trlog_data(&binn_msg, &req))
+    mdv_msg message =
     {
-        MDV_LOGE("Transaction log data processing failed");
-        binn_free(&binn_msg);
-        return MDV_FAILED;
-    }
+        .hdr =
+        {
+            .id = mdv_message_id(p2p_snapshot_data),
+            .size = binn_size(&obj)
+        },
+        .payload = binn_ptr(&obj)
+    };
 
-    MDV_LOGI("RECV %s '%s': count: %u",
-             mdv_uuid_to_str(&peer->peer_uuid, uuid_str),
-             mdv_p2p_msg_name(msg->hdr.id),
-             req.count);
+    mdv_errno err = mdv_peer_post(peer, &message);
 
-    binn_free(&binn_msg);
+    binn_free(&obj);
+
+    return err;
+}
 
-    mdv_evt_trlog_data *data = mdv_evt_trlog_data_create(&req.trlog, &peer->peer_uuid, &peer->uuid, &req.rows, req.count);
 
-    if (data)
+/**
+ * @brief Post snapshot message
+ */
+static mdv_errno mdv_peer_snapshot(mdv_peer *peer, mdv_evt_snapshot const *snapshot)
+{
+    mdv_msg_p2p_snapshot const msg =
     {
-        if (mdv_ebus_publish(peer->ebus, &data->base, MDV_EVT_DEFAULT) != MDV_OK)
-            MDV_LOGE("Transaction log data processing failed");
-        mdv_evt_trlog_data_release(data);
-    }
-    else
+        .err       = snapshot->err,
+        .tables    = snapshot->tables,
+        .positions = snapshot->positions,
+        .ids       = snapshot->ids
+    };
+
+    binn obj;
+
+    if (!mdv_binn_p2p_snapshot(&msg, &obj))
     {
-        MDV_LOGE("Transaction log data processing failed. No memory.");
-        return MDV_NO_MEM;
+        MDV_LOGE("Snapshot posting failed");
+        return MDV_FAILED;
     }
 
-    return MDV_OK;
+    mdv_msg message =
+    {
+        .hdr =
+        {
+            .id = mdv_message_id(p2p_snapshot),
+            .size = binn_size(&obj)
+        },
+        .payload = binn_ptr(&obj)
+    };
+
+    mdv_errno err = mdv_peer_post(peer, &message);
+
+    binn_free(&obj);
+
+    return err;
 }
 
 
 /**
- * @brief Post hello message
+ * @brief Post view opening message
  */
-static mdv_errno mdv_peer_hello(mdv_peer *peer)
+static mdv_errno mdv_peer_view_open(mdv_peer *peer, mdv_evt_view_open const *open)
 {
-    mdv_msg_p2p_hello hello =
+    mdv_msg_p2p_view_open const msg =
     {
-        .listen  = MDV_CONFIG.server.listen
+        .id         = open->id,
+        .table      = open->table,
+        .fields     = open->fields,
+        .partitions = open->partitions,
+        .filter     = open->filter,
+        .count      = open->count,
+        .bytes      = open->bytes
     };
 
-    binn hey;
+    binn obj;
 
-    if (!mdv_binn_p2p_hello(&hello, &hey))
+    if (!mdv_binn_p2p_view_open(&msg, &obj))
+    {
+        MDV_LOGE("View opening message posting failed");
         return MDV_FAILED;
+    }
 
     mdv_msg message =
     {
         .hdr =
         {
-            .id = mdv_message_id(p2p_hello),
-            .size = binn_size(&hey)
+            .id = mdv_message_id(p2p_view_open),
+            .size = binn_size(&obj)
         },
-        .payload = binn_ptr(&hey)
+        .payload = binn_ptr(&obj)
     };
 
     mdv_errno err = mdv_peer_post(peer, &message);
 
-    binn_free(&hey);
+    binn_free(&obj);
 
     return err;
 }
 
 
 /**
- * @brief Post topology synchronization message
+ * @brief Post view reading message
  */
-static mdv_errno mdv_peer_toposync(mdv_peer *peer, mdv_topology *topology)
+static mdv_errno mdv_peer_view_read(mdv_peer *peer, mdv_evt_view_read const *read)
 {
-    mdv_msg_p2p_toposync const toposync =
+    mdv_msg_p2p_view_read const msg =
     {
-        .topology = topology
+        .id      = read->id,
+        .view_id = read->view_id,
+        .count   = read->count,
+        .bytes   = read->bytes
     };
 
     binn obj;
 
-    if (!mdv_binn_p2p_toposync(&toposync, &obj))
+    if (!mdv_binn_p2p_view_read(&msg, &obj))
     {
-        MDV_LOGE("Topology synchronization request failed");
+        MDV_LOGE("View reading message posting failed");
         return MDV_FAILED;
     }
 
@@ -523,7 +1269,7 @@ static mdv_errno mdv_peer_toposync(mdv_peer *peer, mdv_topology *topology)
     {
         .hdr =
         {
-            .id = mdv_message_id(p2p_toposync),
+            .id = mdv_message_id(p2p_view_read),
             .size = binn_size(&obj)
         },
         .payload = binn_ptr(&obj)
@@ -538,20 +1284,23 @@ static mdv_errno mdv_peer_toposync(mdv_peer *peer, mdv_topology *topology)
 
 
 /**
- * @brief Post trlog synchronization message
+ * @brief Post view rows message
  */
-static mdv_errno mdv_peer_trlog_sync(mdv_peer *peer, mdv_uuid const *trlog)
+static mdv_errno mdv_peer_view_rows(mdv_peer *peer, mdv_evt_view_rows const *rows)
 {
-    mdv_msg_p2p_trlog_sync const trlog_sync =
+    mdv_msg_p2p_view_rows const msg =
     {
-        .trlog = *trlog
+        .id      = rows->id,
+        .view_id = rows->view_id,
+        .err     = rows->err,
+        .rows    = rows->rows
     };
 
     binn obj;
 
-    if (!mdv_binn_p2p_trlog_sync(&trlog_sync, &obj))
+    if (!mdv_binn_p2p_view_rows(&msg, &obj))
     {
-        MDV_LOGE("Transaction log synchronization request failed");
+        MDV_LOGE("View rows message posting failed");
         return MDV_FAILED;
     }
 
@@ -559,7 +1308,7 @@ static mdv_errno mdv_peer_trlog_sync(mdv_peer *peer, mdv_uuid const *trlog)
     {
         .hdr =
         {
-            .id = mdv_message_id(p2p_trlog_sync),
+            .id = mdv_message_id(p2p_view_rows),
             .size = binn_size(&obj)
         },
         .payload = binn_ptr(&obj)
@@ -574,21 +1323,23 @@ static mdv_errno mdv_peer_trlog_sync(mdv_peer *peer, mdv_uuid const *trlog)
 
 
 /**
- * @brief Post trlog state message
+ * @brief Post rows deletion message
  */
-static mdv_errno mdv_peer_trlog_state(mdv_peer *peer, mdv_uuid const *trlog, uint64_t top)
+static mdv_errno mdv_peer_delete(mdv_peer *peer, mdv_evt_rowdata_del_remote const *del)
 {
-    mdv_msg_p2p_trlog_state const trlog_state =
+    mdv_msg_p2p_delete const msg =
     {
-        .trlog = *trlog,
-        .trlog_top = top
+        .id         = del->id,
+        .table      = del->table,
+        .partitions = del->partitions,
+        .filter     = del->filter
     };
 
     binn obj;
 
-    if (!mdv_binn_p2p_trlog_state(&trlog_state, &obj))
+    if (!mdv_binn_p2p_delete(&msg, &obj))
     {
-        MDV_LOGE("Transaction log state notification failed");
+        MDV_LOGE("Rows deletion message posting failed");
         return MDV_FAILED;
     }
 
@@ -596,7 +1347,7 @@ static mdv_errno mdv_peer_trlog_state(mdv_peer *peer, mdv_uuid const *trlog, uin
     {
         .hdr =
         {
-            .id = mdv_message_id(p2p_trlog_state),
+            .id = mdv_message_id(p2p_delete),
             .size = binn_size(&obj)
         },
         .payload = binn_ptr(&obj)
@@ -611,22 +1362,21 @@ static mdv_errno mdv_peer_trlog_state(mdv_peer *peer, mdv_uuid const *trlog, uin
 
 
 /**
- * @brief Post trlog data message
+ * @brief Post rows deletion status message
  */
-static mdv_errno mdv_peer_trlog_data(mdv_peer *peer, mdv_uuid const *trlog, mdv_list const *rows, uint32_t count)
+static mdv_errno mdv_peer_delete_status(mdv_peer *peer, mdv_evt_rowdata_del_status const *status)
 {
-    mdv_msg_p2p_trlog_data const trlog_data =
+    mdv_msg_p2p_delete_status const msg =
     {
-        .trlog = *trlog,
-        .count = count,
-        .rows = *rows
+        .id  = status->id,
+        .err = status->err
     };
 
     binn obj;
 
-    if (!mdv_binn_p2p_trlog_data(&trlog_data, &obj))
+    if (!mdv_binn_p2p_delete_status(&msg, &obj))
     {
-        MDV_LOGE("Transaction log data posting failed");
+        MDV_LOGE("Rows deletion status message posting failed");
         return MDV_FAILED;
     }
 
@@ -634,7 +1384,7 @@ static mdv_errno mdv_peer_trlog_data(mdv_peer *peer, mdv_uuid const *trlog, mdv_
     {
         .hdr =
         {
-            .id = mdv_message_id(p2p_trlog_data),
+            .id = mdv_message_id(p2p_delete_status),
             .size = binn_size(&obj)
         },
         .payload = binn_ptr(&obj)
@@ -740,7 +1490,125 @@ static mdv_errno mdv_peer_evt_trlog_data(void *arg, mdv_event *event)
     mdv_evt_trlog_data *data = (mdv_evt_trlog_data *)event;
 
     if(mdv_uuid_cmp(&peer->peer_uuid, &data->to) == 0)
-        return mdv_peer_trlog_data(peer, &data->trlog, &data->rows, data->count);
+        return mdv_peer_trlog_data(peer, &data->trlog, data->start, &data->rows, data->count);
+
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_peer_evt_snapshot_request(void *arg, mdv_event *event)
+{
+    mdv_peer *peer = arg;
+    mdv_evt_snapshot_request *req = (mdv_evt_snapshot_request *)event;
+
+    if(mdv_uuid_cmp(&peer->peer_uuid, &req->to) != 0)
+        return MDV_OK;
+
+    uint32_t const features = atomic_load_explicit(&peer->peer_features, memory_order_relaxed);
+
+    // Old peers don't handle the snapshot requests
+    req->supported = (features & MDV_P2P_FEATURE_SNAPSHOT) != 0;
+
+    if (!req->supported)
+        return MDV_OK;
+
+    mdv_errno err = mdv_peer_snapshot_req(peer);
+
+    req->sent = err == MDV_OK;
+
+    return err;
+}
+
+
+static mdv_errno mdv_peer_evt_snapshot_data(void *arg, mdv_event *event)
+{
+    mdv_peer *peer = arg;
+    mdv_evt_snapshot_data *data = (mdv_evt_snapshot_data *)event;
+
+    if(mdv_uuid_cmp(&peer->peer_uuid, &data->to) == 0)
+        return mdv_peer_snapshot_data(peer, data);
+
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_peer_evt_snapshot(void *arg, mdv_event *event)
+{
+    mdv_peer *peer = arg;
+    mdv_evt_snapshot *snapshot = (mdv_evt_snapshot *)event;
+
+    if(mdv_uuid_cmp(&peer->peer_uuid, &snapshot->to) == 0)
+        return mdv_peer_snapshot(peer, snapshot);
+
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_peer_evt_view_open(void *arg, mdv_event *event)
+{
+    mdv_peer *peer = arg;
+    mdv_evt_view_open *open = (mdv_evt_view_open *)event;
+
+    if(mdv_uuid_cmp(&peer->peer_uuid, &open->to) == 0)
+        return mdv_peer_view_open(peer, open);
+
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_peer_evt_view_read(void *arg, mdv_event *event)
+{
+    mdv_peer *peer = arg;
+    mdv_evt_view_read *read = (mdv_evt_view_read *)event;
+
+    if(mdv_uuid_cmp(&peer->peer_uuid, &read->to) == 0)
+        return mdv_peer_view_read(peer, read);
+
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_peer_evt_view_rows(void *arg, mdv_event *event)
+{
+    mdv_peer *peer = arg;
+    mdv_evt_view_rows *rows = (mdv_evt_view_rows *)event;
+
+    if(mdv_uuid_cmp(&peer->peer_uuid, &rows->to) == 0)
+        return mdv_peer_view_rows(peer, rows);
+
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_peer_evt_delete(void *arg, mdv_event *event)
+{
+    mdv_peer *peer = arg;
+    mdv_evt_rowdata_del_remote *del = (mdv_evt_rowdata_del_remote *)event;
+
+    if(mdv_uuid_cmp(&peer->peer_uuid, &del->to) != 0)
+        return MDV_OK;
+
+    uint32_t const features = atomic_load_explicit(&peer->peer_features, memory_order_relaxed);
+
+    // Old peers don't handle the rows deletion requests
+    if (!(features & MDV_P2P_FEATURE_DELETE))
+        return MDV_OK;
+
+    mdv_errno err = mdv_peer_delete(peer, del);
+
+    del->sent = err == MDV_OK;
+
+    return err;
+}
+
+
+static mdv_errno mdv_peer_evt_delete_status(void *arg, mdv_event *event)
+{
+    mdv_peer *peer = arg;
+    mdv_evt_rowdata_del_status *status = (mdv_evt_rowdata_del_status *)event;
+
+    if(mdv_uuid_cmp(&peer->peer_uuid, &status->to) == 0)
+        return mdv_peer_delete_status(peer, status);
 
     return MDV_OK;
 }
@@ -753,6 +1621,14 @@ static const mdv_event_handler_type mdv_peer_handlers[] =
     { MDV_EVT_TRLOG_SYNC,       mdv_peer_evt_trlog_sync },
     { MDV_EVT_TRLOG_STATE,      mdv_peer_evt_trlog_state },
     { MDV_EVT_TRLOG_DATA,       mdv_peer_evt_trlog_data },
+    { MDV_EVT_SNAPSHOT_REQUEST, mdv_peer_evt_snapshot_request },
+    { MDV_EVT_SNAPSHOT_DATA,    mdv_peer_evt_snapshot_data },
+    { MDV_EVT_SNAPSHOT,         mdv_peer_evt_snapshot },
+    { MDV_EVT_VIEW_OPEN,        mdv_peer_evt_view_open },
+    { MDV_EVT_VIEW_READ,        mdv_peer_evt_view_read },
+    { MDV_EVT_VIEW_ROWS,        mdv_peer_evt_view_rows },
+    { MDV_EVT_ROWDATA_DELETE_REMOTE, mdv_peer_evt_delete },
+    { MDV_EVT_ROWDATA_DELETE_STATUS, mdv_peer_evt_delete_status },
 };
 
 
@@ -797,6 +1673,10 @@ mdv_channel * mdv_peer_create(mdv_descriptor  fd,
     peer->peer_uuid = *peer_uuid;
     peer->peer_addr = 0;
 
+    atomic_init(&peer->peer_features, 0);
+    atomic_init(&peer->trlog_raw, 0);
+    atomic_init(&peer->trlog_sent, 0);
+
     peer->ebus = mdv_ebus_retain(ebus);
 
     mdv_rollbacker_push(rollbacker, mdv_ebus_release, peer->ebus);
@@ -814,12 +1694,20 @@ mdv_channel * mdv_peer_create(mdv_descriptor  fd,
 
     mdv_dispatcher_handler const handlers[] =
     {
-        { mdv_message_id(p2p_hello),        &mdv_peer_hello_handler,        peer },
-        { mdv_message_id(p2p_toposync),     &mdv_peer_toposync_handler,     peer },
-        { mdv_message_id(p2p_broadcast),    &mdv_peer_broadcast_handler,    peer },
-        { mdv_message_id(p2p_trlog_sync),   &mdv_peer_trlog_sync_handler,   peer },
-        { mdv_message_id(p2p_trlog_state),  &mdv_peer_trlog_state_handler,  peer },
-        { mdv_message_id(p2p_trlog_data),   &mdv_peer_trlog_data_handler,   peer },
+        { mdv_message_id(p2p_hello),         &mdv_peer_hello_handler,           peer },
+        { mdv_message_id(p2p_toposync),      &mdv_peer_toposync_handler,        peer },
+        { mdv_message_id(p2p_broadcast),     &mdv_peer_broadcast_handler,       peer },
+        { mdv_message_id(p2p_trlog_sync),    &mdv_peer_trlog_sync_handler,      peer },
+        { mdv_message_id(p2p_trlog_state),   &mdv_peer_trlog_state_handler,     peer },
+        { mdv_message_id(p2p_trlog_data),    &mdv_peer_trlog_data_handler,      peer },
+        { mdv_message_id(p2p_snapshot_req),  &mdv_peer_snapshot_req_handler,    peer },
+        { mdv_message_id(p2p_snapshot_data), &mdv_peer_snapshot_data_handler,   peer },
+        { mdv_message_id(p2p_snapshot),      &mdv_peer_snapshot_handler,        peer },
+        { mdv_message_id(p2p_view_open),     &mdv_peer_view_open_handler,       peer },
+        { mdv_message_id(p2p_view_read),     &mdv_peer_view_read_handler,       peer },
+        { mdv_message_id(p2p_view_rows),     &mdv_peer_view_rows_handler,       peer },
+        { mdv_message_id(p2p_delete),        &mdv_peer_delete_handler,          peer },
+        { mdv_message_id(p2p_delete_status), &mdv_peer_delete_status_handler,   peer },
     };
 
     for(size_t i = 0; i < sizeof handlers / sizeof *handlers; ++i)
@@ -870,6 +1758,18 @@ static void mdv_peer_free(mdv_peer *peer)
                                  mdv_peer_handlers,
                                  sizeof mdv_peer_handlers / sizeof *mdv_peer_handlers);
         mdv_peer_disconnected(peer);
+
+        size_t const trlog_raw = atomic_load(&peer->trlog_raw);
+        size_t const trlog_sent = atomic_load(&peer->trlog_sent);
+
+        if (trlog_raw)
+        {
+            char uuid_str[MDV_UUID_STR_LEN];
+            MDV_LOGI("Transaction log data sent to %s: %zu bytes, compressed to %zu bytes (ratio %.2f)",
+                     mdv_uuid_to_str(&peer->peer_uuid, uuid_str),
+                     trlog_raw, trlog_sent, (double)trlog_raw / trlog_sent);
+        }
+
         mdv_dispatcher_free(peer->dispatcher);
         mdv_ebus_release(peer->ebus);
         mdv_free(peer->peer_addr);
@@ -3,6 +3,8 @@
 #include "event/mdv_evt_types.h"
 #include "event/mdv_evt_topology.h"
 #include "event/mdv_evt_trlog.h"
+#include "event/mdv_evt_snapshot.h"
+#include "mdv_config.h"
 #include <mdv_alloc.h>
 #include <mdv_log.h>
 #include <mdv_rollbacker.h>
@@ -10,11 +12,25 @@
 #include <mdv_safeptr.h>
 #include <mdv_router.h>
 #include <mdv_mutex.h>
+#include <mdv_condvar.h>
 #include <mdv_hashmap.h>
 #include <mdv_vector.h>
+#include <mdv_file.h>
+#include <mdv_time.h>
 #include <stdatomic.h>
 
 
+/// @cond Doxygen_Suppress
+
+enum
+{
+    MDV_SYNCER_TIMER_INTERVAL   = 1000,         ///< Synchronization state checking interval (in milliseconds)
+    MDV_SYNCER_SNAPSHOT_TIMEOUT = 2 * 60 * 1000 ///< Time after which the silent snapshot sender is considered lost (in milliseconds)
+};
+
+/// @endcond
+
+
 /// Data synchronizer
 struct mdv_syncer
 {
@@ -24,10 +40,29 @@ struct mdv_syncer
     mdv_uuid        uuid;           ///< Current node UUID
     mdv_mutex       mutex;          ///< Mutex for peers synchronizers guard
     mdv_hashmap    *peers;          ///< Current synchronizing peers (hashmap<mdv_syncer_peer>)
+    mdv_mutex       inbox_mutex;    ///< Mutex for received data guard
+    mdv_hashmap    *inboxes;        ///< Received data waiting for saving (hashmap<mdv_syncer_inbox>)
     atomic_size_t   active_jobs;    ///< Active jobs counter
+    mdv_mutex       snapshot_mutex; ///< Mutex for bootstrapping state guard
+    bool            bootstrap;      ///< Flag indicates that the node is bootstrapped from snapshot
+    bool            requested;      ///< Flag indicates that the snapshot is requested
+    mdv_uuid        snapshot_peer;  ///< Peer which sends the snapshot
+    size_t          snapshot_time;  ///< Last snapshot request or data receiving time
+    mdv_vector     *deferred;       ///< Synchronization requests deferred until snapshot is installed (vector<mdv_syncer_deferred>)
+    mdv_thread      timer;          ///< Background thread for periodic synchronization state checking
+    mdv_condvar     timer_cv;       ///< Conditional variable for background timer stopping
+    atomic_bool     active;         ///< Flag indicates that the background timer is active
 };
 
 
+/// Synchronization request deferred until snapshot is installed
+typedef struct
+{
+    mdv_uuid        peer;           ///< Peer UUID
+    mdv_uuid        trlog;          ///< Transaction log UUID
+} mdv_syncer_deferred;
+
+
 /// Synchronizing peer
 typedef struct
 {
@@ -56,22 +91,70 @@ static mdv_trlog * mdv_syncer_trlog(mdv_syncer *syncer, mdv_uuid const *uuid, bo
 }
 
 
+/// Transaction log records batch received from peer
+typedef struct
+{
+    mdv_uuid        peer;           ///< Peer UUID
+    uint64_t        start;          ///< First transaction log position covered by records
+    uint32_t        count;          ///< log records count
+    mdv_list        rows;           ///< transaction log data (list<mdv_trlog_data>)
+} mdv_syncer_batch;
+
+
+typedef mdv_list_entry(mdv_syncer_batch) mdv_syncer_batch_entry;
+
+
+/// Received transaction log data waiting for saving
+typedef struct
+{
+    mdv_uuid        trlog;          ///< Transaction log UUID
+    mdv_list        batches;        ///< Received records batches (list<mdv_syncer_batch>)
+    bool            active;         ///< Flag indicates that the data saving job is scheduled
+} mdv_syncer_inbox;
+
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // Job for data saving
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 typedef struct mdv_syncer_data_save_context
 {
     mdv_syncer     *syncer;                 ///< Data synchronizer
-    mdv_uuid        peer;                   ///< Peer UUID
     mdv_uuid        trlog;                  ///< transaction log UUID
-    mdv_list        rows;                   ///< transaction log data (list<mdv_trlog_data>)
-    uint32_t        count;                  ///< log records count
 } mdv_syncer_data_save_context;
 
 
 typedef mdv_job(mdv_syncer_data_save_context)    mdv_syncer_data_save_job;
 
 
+/**
+ * @brief Takes the next received batch for the transaction log.
+ * @details If there are no batches, saving job is marked as finished.
+ */
+static mdv_syncer_batch_entry * mdv_syncer_inbox_pop(mdv_syncer *syncer, mdv_uuid const *trlog)
+{
+    mdv_syncer_batch_entry *entry = 0;
+
+    if (mdv_mutex_lock(&syncer->inbox_mutex) == MDV_OK)
+    {
+        mdv_syncer_inbox *inbox = mdv_hashmap_find(syncer->inboxes, trlog);
+
+        if (inbox)
+        {
+            entry = (mdv_syncer_batch_entry *)inbox->batches.next;
+
+            if (entry)
+                mdv_list_exclude(&inbox->batches, (mdv_list_entry_base *)entry);
+            else
+                inbox->active = false;
+        }
+
+        mdv_mutex_unlock(&syncer->inbox_mutex);
+    }
+
+    return entry;
+}
+
+
 static void mdv_syncer_data_save_fn(mdv_job_base *job)
 {
     mdv_syncer_data_save_context *ctx = (mdv_syncer_data_save_context *)job->data;
@@ -79,28 +162,38 @@ static void mdv_syncer_data_save_fn(mdv_job_base *job)
 
     mdv_trlog *trlog = mdv_syncer_trlog(syncer, &ctx->trlog, true);
 
-    uint64_t trlog_top = 0;
-
-    if (trlog)
+    // Batches are saved in order of receiving
+    for(mdv_syncer_batch_entry *entry; (entry = mdv_syncer_inbox_pop(syncer, &ctx->trlog)) != 0;)
     {
-        if (!mdv_trlog_add(trlog, &ctx->rows))
-            MDV_LOGE("Transaction synchronization failed. Rows count: %u", ctx->count);
+        mdv_syncer_batch *batch = &entry->data;
 
-        trlog_top = mdv_trlog_top(trlog);
+        uint64_t trlog_top = 0;
 
-        mdv_trlog_release(trlog);
-    }
-    else
-        MDV_LOGE("Transaction synchronization failed. Rows count: %u", ctx->count);
+        if (trlog)
+        {
+            if (mdv_trlog_add(trlog, batch->start, &batch->rows) == MDV_FAILED)
+                MDV_LOGE("Transaction synchronization failed. Rows count: %u", batch->count);
 
-    mdv_evt_trlog_state *evt = mdv_evt_trlog_state_create(&ctx->trlog, &syncer->uuid, &ctx->peer, trlog_top);
+            trlog_top = mdv_trlog_top(trlog);
+        }
+        else
+            MDV_LOGE("Transaction synchronization failed. Rows count: %u", batch->count);
 
-    if (evt)
-    {
-        if (mdv_ebus_publish(syncer->ebus, &evt->base, MDV_EVT_DEFAULT) != MDV_OK)
-            MDV_LOGE("Transaction synchronization failed. Rows count: %u", ctx->count);
-        mdv_evt_trlog_state_release(evt);
+        // Each batch is acknowledged by the transaction log top. Acknowledgements are sent in order.
+        mdv_evt_trlog_state *evt = mdv_evt_trlog_state_create(&ctx->trlog, &syncer->uuid, &batch->peer, trlog_top);
+
+        if (evt)
+        {
+            if (mdv_ebus_publish(syncer->ebus, &evt->base, MDV_EVT_SYNC) != MDV_OK)
+                MDV_LOGE("Transaction synchronization failed. Rows count: %u", batch->count);
+            mdv_evt_trlog_state_release(evt);
+        }
+
+        mdv_list_clear(&batch->rows);
+        mdv_free(entry);
     }
+
+    mdv_trlog_release(trlog);
 }
 
 
@@ -108,14 +201,13 @@ static void mdv_syncer_data_save_finalize(mdv_job_base *job)
 {
     mdv_syncer_data_save_context *ctx = (mdv_syncer_data_save_context *)job->data;
     mdv_syncer                   *syncer = ctx->syncer;
-    mdv_list_clear(&ctx->rows);
     atomic_fetch_sub_explicit(&syncer->active_jobs, 1, memory_order_relaxed);
     mdv_syncer_release(syncer);
     mdv_free(job);
 }
 
 
-static mdv_errno mdv_syncer_data_save_job_emit(mdv_syncer *syncer, mdv_uuid const *peer, mdv_uuid const *trlog, mdv_list *rows, uint32_t count)
+static mdv_errno mdv_syncer_data_save_job_emit(mdv_syncer *syncer, mdv_uuid const *trlog)
 {
     mdv_syncer_data_save_job *job = mdv_alloc(sizeof(mdv_syncer_data_save_job));
 
@@ -128,10 +220,7 @@ static mdv_errno mdv_syncer_data_save_job_emit(mdv_syncer *syncer, mdv_uuid cons
     job->fn             = mdv_syncer_data_save_fn;
     job->finalize       = mdv_syncer_data_save_finalize;
     job->data.syncer    = mdv_syncer_retain(syncer);
-    job->data.peer      = *peer;
     job->data.trlog     = *trlog;
-    job->data.rows      = mdv_list_move(rows);
-    job->data.count     = count;
 
     mdv_errno err = mdv_jobber_push(syncer->jobber, (mdv_job_base*)job);
 
@@ -139,7 +228,6 @@ static mdv_errno mdv_syncer_data_save_job_emit(mdv_syncer *syncer, mdv_uuid cons
     {
         MDV_LOGE("Data synchronization job failed");
         mdv_syncer_release(syncer);
-        *rows = mdv_list_move(&job->data.rows);
         mdv_free(job);
     }
     else
@@ -149,6 +237,541 @@ static mdv_errno mdv_syncer_data_save_job_emit(mdv_syncer *syncer, mdv_uuid cons
 }
 
 
+/**
+ * @brief Queues received batch for saving.
+ * @details Batches of the same transaction log are saved one by one by single job.
+ */
+static mdv_errno mdv_syncer_inbox_push(mdv_syncer *syncer, mdv_evt_trlog_data *data)
+{
+    mdv_syncer_batch_entry *entry = mdv_alloc(sizeof(mdv_syncer_batch_entry));
+
+    if (!entry)
+    {
+        MDV_LOGE("No memory for transaction log data");
+        return MDV_NO_MEM;
+    }
+
+    entry->data.peer  = data->from;
+    entry->data.start = data->start;
+    entry->data.count = data->count;
+    entry->data.rows  = mdv_list_move(&data->rows);
+
+    mdv_errno err = mdv_mutex_lock(&syncer->inbox_mutex);
+
+    if (err != MDV_OK)
+    {
+        data->rows = mdv_list_move(&entry->data.rows);
+        mdv_free(entry);
+        return err;
+    }
+
+    mdv_syncer_inbox *inbox = mdv_hashmap_find(syncer->inboxes, &data->trlog);
+
+    if (!inbox)
+    {
+        mdv_syncer_inbox const new_inbox =
+        {
+            .trlog = data->trlog,
+            .batches = {},
+            .active = false
+        };
+
+        inbox = mdv_hashmap_insert(syncer->inboxes, &new_inbox, sizeof new_inbox);
+    }
+
+    if (inbox)
+    {
+        mdv_list_emplace_back(&inbox->batches, (mdv_list_entry_base *)entry);
+
+        if (!inbox->active)
+        {
+            err = mdv_syncer_data_save_job_emit(syncer, &data->trlog);
+            inbox->active = err == MDV_OK;
+        }
+    }
+    else
+    {
+        MDV_LOGE("No memory for transaction log data");
+        data->rows = mdv_list_move(&entry->data.rows);
+        mdv_free(entry);
+        err = MDV_NO_MEM;
+    }
+
+    mdv_mutex_unlock(&syncer->inbox_mutex);
+
+    return err;
+}
+
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Job for snapshot sending
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+typedef struct mdv_syncer_snapshot_context
+{
+    mdv_syncer     *syncer;                 ///< Data synchronizer
+    mdv_uuid        peer;                   ///< Peer which requested the snapshot
+} mdv_syncer_snapshot_context;
+
+
+typedef mdv_job(mdv_syncer_snapshot_context)    mdv_syncer_snapshot_job;
+
+
+static mdv_errno mdv_syncer_snapshot_file_send(mdv_syncer *syncer, mdv_uuid const *peer, mdv_snapshot_file const *file, void *buf, size_t buf_size)
+{
+    size_t offset = 0;
+
+    // At least one chunk is sent for each file
+    do
+    {
+        size_t const size = file->size - offset < buf_size
+                                ? file->size - offset
+                                : buf_size;
+
+        mdv_errno err = size
+                            ? mdv_file_read_at(file->fd, buf, size, offset)
+                            : MDV_OK;
+
+        if (err != MDV_OK)
+        {
+            MDV_LOGE("Snapshot reading failed");
+            return err;
+        }
+
+        mdv_evt_snapshot_data *evt = mdv_evt_snapshot_data_create(&syncer->uuid, peer, &file->table,
+                                                                  offset, file->size, (uint32_t)size, buf);
+
+        if (!evt)
+        {
+            MDV_LOGE("No memory for snapshot data");
+            return MDV_NO_MEM;
+        }
+
+        err = mdv_ebus_publish(syncer->ebus, &evt->base, MDV_EVT_SYNC);
+
+        mdv_evt_snapshot_data_release(evt);
+
+        if (err != MDV_OK)
+        {
+            MDV_LOGE("Snapshot sending failed");
+            return err;
+        }
+
+        offset += size;
+    }
+    while(offset < file->size);
+
+    return MDV_OK;
+}
+
+
+static void mdv_syncer_snapshot_fn(mdv_job_base *job)
+{
+    mdv_syncer_snapshot_context *ctx = (mdv_syncer_snapshot_context *)job->data;
+    mdv_syncer                  *syncer = ctx->syncer;
+
+    mdv_evt_create_snapshot *snapshot = mdv_evt_create_snapshot_create();
+
+    if (!snapshot)
+    {
+        MDV_LOGE("No memory for snapshot");
+        return;
+    }
+
+    mdv_errno err = mdv_ebus_publish(syncer->ebus, &snapshot->base, MDV_EVT_SYNC);
+
+    if (err == MDV_OK)
+    {
+        size_t const buf_size = MDV_CONFIG.datasync.snapshot_chunk ? MDV_CONFIG.datasync.snapshot_chunk : 64 * 1024;
+
+        void *buf = mdv_alloc(buf_size);
+
+        if (buf)
+        {
+            mdv_vector_foreach(snapshot->files, mdv_snapshot_file, file)
+            {
+                err = mdv_syncer_snapshot_file_send(syncer, &ctx->peer, file, buf, buf_size);
+
+                if (err != MDV_OK)
+                    break;
+            }
+
+            mdv_free(buf);
+        }
+        else
+        {
+            MDV_LOGE("No memory for snapshot chunk");
+            err = MDV_NO_MEM;
+        }
+    }
+    else
+        MDV_LOGE("Snapshot creation failed with error %d", err);
+
+    mdv_evt_snapshot *evt = mdv_evt_snapshot_create(&syncer->uuid, &ctx->peer, err,
+                                                    err == MDV_OK ? snapshot->tables : 0,
+                                                    err == MDV_OK ? snapshot->positions : 0,
+                                                    err == MDV_OK ? snapshot->ids : 0);
+
+    if (evt)
+    {
+        if (mdv_ebus_publish(syncer->ebus, &evt->base, MDV_EVT_SYNC) != MDV_OK)
+            MDV_LOGE("Snapshot sending failed");
+        mdv_evt_snapshot_release(evt);
+    }
+    else
+        MDV_LOGE("No memory for snapshot");
+
+    if (err == MDV_OK)
+    {
+        char uuid_str[MDV_UUID_STR_LEN];
+        MDV_LOGI("Snapshot sent to '%s'. Tables: %zu",
+                 mdv_uuid_to_str(&ctx->peer, uuid_str),
+                 mdv_vector_size(snapshot->files));
+    }
+
+    mdv_evt_create_snapshot_release(snapshot);
+}
+
+
+static void mdv_syncer_snapshot_finalize(mdv_job_base *job)
+{
+    mdv_syncer_snapshot_context *ctx = (mdv_syncer_snapshot_context *)job->data;
+    mdv_syncer                  *syncer = ctx->syncer;
+    atomic_fetch_sub_explicit(&syncer->active_jobs, 1, memory_order_relaxed);
+    mdv_syncer_release(syncer);
+    mdv_free(job);
+}
+
+
+static mdv_errno mdv_syncer_snapshot_job_emit(mdv_syncer *syncer, mdv_uuid const *peer)
+{
+    mdv_syncer_snapshot_job *job = mdv_alloc(sizeof(mdv_syncer_snapshot_job));
+
+    if (!job)
+    {
+        MDV_LOGE("No memory for snapshot sending job");
+        return MDV_NO_MEM;
+    }
+
+    job->fn             = mdv_syncer_snapshot_fn;
+    job->finalize       = mdv_syncer_snapshot_finalize;
+    job->data.syncer    = mdv_syncer_retain(syncer);
+    job->data.peer      = *peer;
+
+    mdv_errno err = mdv_jobber_push(syncer->jobber, (mdv_job_base*)job);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Snapshot sending job failed");
+        mdv_syncer_release(syncer);
+        mdv_free(job);
+    }
+    else
+        atomic_fetch_add_explicit(&syncer->active_jobs, 1, memory_order_relaxed);
+
+    return err;
+}
+
+
+/**
+ * @brief Checks that the node is empty and it should be bootstrapped from snapshot
+ */
+static bool mdv_syncer_snapshot_required(mdv_syncer *syncer)
+{
+    mdv_evt_snapshot_required *evt = mdv_evt_snapshot_required_create();
+
+    if (!evt)
+    {
+        MDV_LOGE("No memory for snapshot request");
+        return false;
+    }
+
+    bool required = mdv_ebus_publish(syncer->ebus, &evt->base, MDV_EVT_SYNC) == MDV_OK
+                    && evt->required;
+
+    mdv_evt_snapshot_required_release(evt);
+
+    return required;
+}
+
+
+/**
+ * @brief Defers the synchronization request if the node is bootstrapped from snapshot
+ *
+ * @return true if the request is deferred
+ */
+static bool mdv_syncer_snapshot_defer(mdv_syncer *syncer, mdv_uuid const *peer, mdv_uuid const *trlog)
+{
+    if (mdv_mutex_lock(&syncer->snapshot_mutex) != MDV_OK)
+        return false;
+
+    bool const deferred = syncer->bootstrap;
+
+    if (deferred)
+    {
+        bool found = false;
+
+        mdv_vector_foreach(syncer->deferred, mdv_syncer_deferred, req)
+        {
+            if (mdv_uuid_cmp(&req->peer, peer) == 0
+                && mdv_uuid_cmp(&req->trlog, trlog) == 0)
+            {
+                found = true;
+                break;
+            }
+        }
+
+        mdv_syncer_deferred const req =
+        {
+            .peer = *peer,
+            .trlog = *trlog
+        };
+
+        if (!found && !mdv_vector_push_back(syncer->deferred, &req))
+            MDV_LOGE("No memory for deferred synchronization request");
+    }
+
+    mdv_mutex_unlock(&syncer->snapshot_mutex);
+
+    return deferred;
+}
+
+
+static bool mdv_syncer_bootstrapping(mdv_syncer *syncer)
+{
+    bool bootstrap = false;
+
+    if (mdv_mutex_lock(&syncer->snapshot_mutex) == MDV_OK)
+    {
+        bootstrap = syncer->bootstrap;
+        mdv_mutex_unlock(&syncer->snapshot_mutex);
+    }
+
+    return bootstrap;
+}
+
+
+static mdv_errno mdv_syncer_trlog_state_reply(mdv_syncer *syncer, mdv_uuid const *peer, mdv_uuid const *trlog_id)
+{
+    mdv_errno err = MDV_FAILED;
+
+    mdv_trlog *trlog = mdv_syncer_trlog(syncer, trlog_id, false);
+
+    mdv_evt_trlog_state *evt = mdv_evt_trlog_state_create(trlog_id, &syncer->uuid, peer, trlog ? mdv_trlog_top(trlog) : 0);
+
+    if (evt)
+    {
+        err = mdv_ebus_publish(syncer->ebus, &evt->base, MDV_EVT_DEFAULT);
+        mdv_evt_trlog_state_release(evt);
+    }
+
+    mdv_trlog_release(trlog);
+
+    return err;
+}
+
+
+/**
+ * @brief Finishes bootstrapping.
+ * @details Deferred synchronization requests are answered by the transaction logs positions.
+ */
+static void mdv_syncer_bootstrap_finish(mdv_syncer *syncer)
+{
+    mdv_vector *deferred = 0;
+
+    if (mdv_mutex_lock(&syncer->snapshot_mutex) == MDV_OK)
+    {
+        syncer->bootstrap = false;
+        syncer->requested = false;
+        syncer->snapshot_time = 0;
+        deferred = syncer->deferred;
+        syncer->deferred = 0;
+        mdv_mutex_unlock(&syncer->snapshot_mutex);
+    }
+
+    if (deferred)
+    {
+        mdv_vector_foreach(deferred, mdv_syncer_deferred, req)
+            mdv_syncer_trlog_state_reply(syncer, &req->peer, &req->trlog);
+        mdv_vector_release(deferred);
+    }
+}
+
+
+/**
+ * @brief Sends the snapshot request to the peer.
+ *
+ * @return true if the request is sent
+ */
+static bool mdv_syncer_snapshot_request_send(mdv_syncer *syncer, mdv_uuid const *peer, bool *supported)
+{
+    *supported = true;
+
+    if (mdv_mutex_lock(&syncer->snapshot_mutex) != MDV_OK)
+        return false;
+
+    bool const request = syncer->bootstrap && !syncer->requested;
+
+    if (request)
+    {
+        syncer->requested = true;
+        syncer->snapshot_peer = *peer;
+        syncer->snapshot_time = mdv_gettime();
+    }
+
+    mdv_mutex_unlock(&syncer->snapshot_mutex);
+
+    if (!request)
+        return false;
+
+    bool sent = false;
+
+    mdv_evt_snapshot_request *evt = mdv_evt_snapshot_request_create(&syncer->uuid, peer);
+
+    if (evt)
+    {
+        if (mdv_ebus_publish(syncer->ebus, &evt->base, MDV_EVT_SYNC) != MDV_OK)
+            MDV_LOGE("Snapshot request failed");
+        *supported = evt->supported;
+        sent = evt->sent;
+        mdv_evt_snapshot_request_release(evt);
+    }
+    else
+        MDV_LOGE("No memory for snapshot request");
+
+    char uuid_str[MDV_UUID_STR_LEN];
+
+    if (sent)
+        MDV_LOGI("Snapshot is requested from '%s'", mdv_uuid_to_str(peer, uuid_str));
+    else if (!*supported)
+        MDV_LOGI("Peer '%s' doesn't send snapshots", mdv_uuid_to_str(peer, uuid_str));
+
+    if (!sent && mdv_mutex_lock(&syncer->snapshot_mutex) == MDV_OK)
+    {
+        if (mdv_uuid_cmp(&syncer->snapshot_peer, peer) == 0)
+            syncer->requested = false;
+        mdv_mutex_unlock(&syncer->snapshot_mutex);
+    }
+
+    return sent;
+}
+
+
+/**
+ * @brief Requests the snapshot from the neighbour node.
+ * @details Snapshot is requested again if the peer which sends the snapshot is disconnected.
+ *          Only peers advertising the snapshots support are asked. If no neighbour sends
+ *          the snapshot, the bootstrapping is finished and the transaction logs are replayed.
+ */
+static void mdv_syncer_snapshot_request(mdv_syncer *syncer, mdv_hashmap *routes)
+{
+    // Local data might be written since the node start
+    if (mdv_syncer_bootstrapping(syncer)
+        && !mdv_syncer_snapshot_required(syncer))
+    {
+        MDV_LOGI("Node isn't empty. Bootstrapping is finished.");
+        mdv_syncer_bootstrap_finish(syncer);
+        return;
+    }
+
+    if (mdv_mutex_lock(&syncer->snapshot_mutex) != MDV_OK)
+        return;
+
+    bool request = false;
+
+    if (syncer->bootstrap)
+    {
+        if (syncer->requested
+            && !mdv_hashmap_find(routes, &syncer->snapshot_peer))
+            syncer->requested = false;
+
+        request = !syncer->requested;
+    }
+
+    mdv_mutex_unlock(&syncer->snapshot_mutex);
+
+    if (!request)
+        return;
+
+    size_t peers = 0;
+    size_t unsupported = 0;
+
+    mdv_hashmap_foreach(routes, mdv_route, route)
+    {
+        bool supported = true;
+
+        ++peers;
+
+        if (mdv_syncer_snapshot_request_send(syncer, &route->uuid, &supported))
+            return;
+
+        if (!supported)
+            ++unsupported;
+    }
+
+    if (peers && peers == unsupported)
+    {
+        MDV_LOGW("Neighbours don't send snapshots. Transaction logs are replayed.");
+        mdv_syncer_bootstrap_finish(syncer);
+    }
+}
+
+
+/**
+ * @brief Finishes bootstrapping if the snapshot isn't received for a long time.
+ * @details The transaction logs are replayed from the beginning.
+ */
+static void mdv_syncer_snapshot_check(mdv_syncer *syncer)
+{
+    bool expired = false;
+
+    if (mdv_mutex_lock(&syncer->snapshot_mutex) == MDV_OK)
+    {
+        expired = syncer->bootstrap
+                    && syncer->snapshot_time
+                    && mdv_gettime() - syncer->snapshot_time > MDV_SYNCER_SNAPSHOT_TIMEOUT;
+        mdv_mutex_unlock(&syncer->snapshot_mutex);
+    }
+
+    if (expired)
+    {
+        MDV_LOGW("Snapshot isn't received. Transaction logs are replayed.");
+        mdv_syncer_bootstrap_finish(syncer);
+    }
+}
+
+
+/**
+ * @brief Installs received snapshot and finishes bootstrapping.
+ * @details If the snapshot isn't installed, the transaction logs are replayed from the beginning.
+ */
+static mdv_errno mdv_syncer_snapshot_install(mdv_syncer *syncer, mdv_evt_snapshot *snapshot)
+{
+    mdv_errno err = snapshot->err;
+
+    if (err == MDV_OK)
+    {
+        mdv_evt_snapshot_install *install = mdv_evt_snapshot_install_create(snapshot->tables,
+                                                                                  snapshot->positions,
+                                                                                  snapshot->ids);
+
+        if (install)
+        {
+            err = mdv_ebus_publish(syncer->ebus, &install->base, MDV_EVT_SYNC);
+            mdv_evt_snapshot_install_release(install);
+        }
+        else
+            err = MDV_NO_MEM;
+    }
+
+    if (err != MDV_OK)
+        MDV_LOGW("Snapshot wasn't installed (%d). Transaction logs are replayed.", err);
+
+    mdv_syncer_bootstrap_finish(syncer);
+
+    return err;
+}
+
+
 static void mdv_syncerino_start4all_storages(mdv_syncerino *syncerino, mdv_topology *topology)
 {
     mdv_vector *nodes = mdv_topology_nodes(topology);
@@ -246,6 +869,8 @@ static mdv_errno mdv_syncer_topology_changed(mdv_syncer *syncer, mdv_topology *t
             mdv_mutex_unlock(&syncer->mutex);
         }
 
+        mdv_syncer_snapshot_request(syncer, routes);
+
         mdv_hashmap_release(routes);
     }
     else
@@ -271,43 +896,210 @@ static mdv_errno mdv_syncer_evt_trlog_sync(void *arg, mdv_event *event)
     if(mdv_uuid_cmp(&syncer->uuid, &sync->to) != 0)
         return MDV_OK;
 
-    mdv_errno err = MDV_FAILED;
+    // Transaction logs positions are unknown until the snapshot is installed
+    if (mdv_syncer_snapshot_defer(syncer, &sync->from, &sync->trlog))
+        return MDV_OK;
 
-    mdv_trlog *trlog = mdv_syncer_trlog(syncer, &sync->trlog, false);
+    return mdv_syncer_trlog_state_reply(syncer, &sync->from, &sync->trlog);
+}
 
-    mdv_evt_trlog_state *evt = mdv_evt_trlog_state_create(&sync->trlog, &sync->to, &sync->from, trlog ? mdv_trlog_top(trlog) : 0);
 
-    if (evt)
+static mdv_errno mdv_syncer_evt_trlog_data(void *arg, mdv_event *event)
+{
+    mdv_syncer *syncer = arg;
+    mdv_evt_trlog_data *data = (mdv_evt_trlog_data *)event;
+
+    if(mdv_uuid_cmp(&syncer->uuid, &data->to) != 0)
+        return MDV_OK;
+
+    if (mdv_syncer_bootstrapping(syncer))
     {
-        err = mdv_ebus_publish(syncer->ebus, &evt->base, MDV_EVT_DEFAULT);
-        mdv_evt_trlog_state_release(evt);
+        MDV_LOGD("Transaction log data is skipped until the snapshot is installed");
+        return MDV_OK;
     }
 
-    mdv_trlog_release(trlog);
+    return mdv_syncer_inbox_push(syncer, data);
+}
+
+
+static mdv_errno mdv_syncer_evt_snapshot_request(void *arg, mdv_event *event)
+{
+    mdv_syncer *syncer = arg;
+    mdv_evt_snapshot_request *req = (mdv_evt_snapshot_request *)event;
+
+    if(mdv_uuid_cmp(&syncer->uuid, &req->to) != 0)
+        return MDV_OK;
+
+    mdv_errno err = mdv_syncer_snapshot_job_emit(syncer, &req->from);
+
+    if (err != MDV_OK)
+    {
+        // Requester replays the transaction logs without waiting for the snapshot
+        mdv_evt_snapshot *evt = mdv_evt_snapshot_create(&syncer->uuid, &req->from, err, 0, 0, 0);
+
+        if (evt)
+        {
+            if (mdv_ebus_publish(syncer->ebus, &evt->base, MDV_EVT_SYNC) != MDV_OK)
+                MDV_LOGE("Snapshot sending failed");
+            mdv_evt_snapshot_release(evt);
+        }
+        else
+            MDV_LOGE("No memory for snapshot");
+    }
 
     return err;
 }
 
 
-static mdv_errno mdv_syncer_evt_trlog_data(void *arg, mdv_event *event)
+static mdv_errno mdv_syncer_evt_snapshot_data(void *arg, mdv_event *event)
 {
     mdv_syncer *syncer = arg;
-    mdv_evt_trlog_data *data = (mdv_evt_trlog_data *)event;
+    mdv_evt_snapshot_data *data = (mdv_evt_snapshot_data *)event;
 
     if(mdv_uuid_cmp(&syncer->uuid, &data->to) != 0)
         return MDV_OK;
 
-    mdv_errno err = mdv_syncer_data_save_job_emit(syncer, &data->from, &data->trlog, &data->rows, data->count);
+    // Snapshot deadline is extended while the data is received
+    if (mdv_mutex_lock(&syncer->snapshot_mutex) == MDV_OK)
+    {
+        if (syncer->bootstrap
+            && mdv_uuid_cmp(&syncer->snapshot_peer, &data->from) == 0)
+            syncer->snapshot_time = mdv_gettime();
+        mdv_mutex_unlock(&syncer->snapshot_mutex);
+    }
+
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_syncer_evt_snapshot(void *arg, mdv_event *event)
+{
+    mdv_syncer *syncer = arg;
+    mdv_evt_snapshot *snapshot = (mdv_evt_snapshot *)event;
+
+    if(mdv_uuid_cmp(&syncer->uuid, &snapshot->to) != 0)
+        return MDV_OK;
+
+    bool expected = false;
+
+    if (mdv_mutex_lock(&syncer->snapshot_mutex) == MDV_OK)
+    {
+        expected = syncer->bootstrap
+                    && mdv_uuid_cmp(&syncer->snapshot_peer, &snapshot->from) == 0;
+        mdv_mutex_unlock(&syncer->snapshot_mutex);
+    }
+
+    if (!expected)
+        return MDV_OK;
+
+    return mdv_syncer_snapshot_install(syncer, snapshot);
+}
+
+
+static void mdv_syncer_check(mdv_syncer *syncer)
+{
+    mdv_vector *syncerinos = mdv_vector_create(8, sizeof(mdv_syncerino*), &mdv_default_allocator);
+
+    if (!syncerinos)
+    {
+        MDV_LOGE("No memory for peers synchronizers list");
+        return;
+    }
+
+    if (mdv_mutex_lock(&syncer->mutex) == MDV_OK)
+    {
+        mdv_hashmap_foreach(syncer->peers, mdv_syncer_peer, peer)
+        {
+            mdv_syncerino *syncerino = mdv_syncerino_retain(peer->syncerino);
+
+            if (!mdv_vector_push_back(syncerinos, &syncerino))
+            {
+                MDV_LOGE("No memory for peers synchronizers list");
+                mdv_syncerino_release(syncerino);
+            }
+        }
+
+        mdv_mutex_unlock(&syncer->mutex);
+    }
+
+    mdv_syncerino **syncerinos_list = mdv_vector_data(syncerinos);
+
+    for(size_t i = 0; i < mdv_vector_size(syncerinos); ++i)
+    {
+        mdv_syncerino_check(syncerinos_list[i]);
+        mdv_syncerino_release(syncerinos_list[i]);
+    }
+
+    mdv_vector_release(syncerinos);
+}
+
+
+static void * mdv_syncer_timer(void *arg)
+{
+    mdv_syncer *syncer = arg;
+
+    while(atomic_load_explicit(&syncer->active, memory_order_relaxed))
+    {
+        mdv_condvar_timedwait(&syncer->timer_cv, MDV_SYNCER_TIMER_INTERVAL);
+
+        if (!atomic_load_explicit(&syncer->active, memory_order_relaxed))
+            break;
+
+        // Bootstrapping is finished if the snapshot isn't received
+        mdv_syncer_snapshot_check(syncer);
+
+        // Silent peers positions are requested again even if the transaction logs are idle
+        mdv_syncer_check(syncer);
+    }
+
+    return 0;
+}
+
+
+static mdv_errno mdv_syncer_timer_start(mdv_syncer *syncer)
+{
+    if (mdv_condvar_create(&syncer->timer_cv) != MDV_OK)
+    {
+        MDV_LOGE("Conditional variable creation failed");
+        return MDV_FAILED;
+    }
+
+    atomic_init(&syncer->active, true);
+
+    mdv_thread_attrs const attrs =
+    {
+        .stack_size = MDV_THREAD_STACK_SIZE
+    };
+
+    mdv_errno err = mdv_thread_create(&syncer->timer, &attrs, mdv_syncer_timer, syncer);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Background timer thread creation failed");
+        mdv_condvar_free(&syncer->timer_cv);
+    }
 
     return err;
 }
 
 
+static void mdv_syncer_timer_stop(mdv_syncer *syncer)
+{
+    atomic_store_explicit(&syncer->active, false, memory_order_relaxed);
+    mdv_condvar_signal(&syncer->timer_cv);
+    mdv_thread_join(syncer->timer);
+    mdv_condvar_free(&syncer->timer_cv);
+}
+
+
 static const mdv_event_handler_type mdv_syncer_handlers[] =
 {
     { MDV_EVT_TOPOLOGY,         mdv_syncer_evt_topology },
     { MDV_EVT_TRLOG_SYNC,       mdv_syncer_evt_trlog_sync },
     { MDV_EVT_TRLOG_DATA,       mdv_syncer_evt_trlog_data },
+    { MDV_EVT_SNAPSHOT_REQUEST, mdv_syncer_evt_snapshot_request },
+    { MDV_EVT_SNAPSHOT_DATA,    mdv_syncer_evt_snapshot_data },
+    { MDV_EVT_SNAPSHOT,         mdv_syncer_evt_snapshot },
 };
 
 
@@ -316,7 +1108,7 @@ mdv_syncer * mdv_syncer_create(mdv_uuid const *uuid,
                                mdv_jobber_config const *jconfig,
                                mdv_topology *topology)
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(7);
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(11);
 
     mdv_syncer *syncer = mdv_alloc(sizeof(mdv_syncer));
 
@@ -361,6 +1153,57 @@ mdv_syncer * mdv_syncer_create(mdv_uuid const *uuid,
 
     mdv_rollbacker_push(rollbacker, mdv_hashmap_release, syncer->peers);
 
+    if (mdv_mutex_create(&syncer->inbox_mutex) != MDV_OK)
+    {
+        MDV_LOGE("Mutex for received data not created");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_mutex_free, &syncer->inbox_mutex);
+
+    syncer->inboxes = mdv_hashmap_create(mdv_syncer_inbox,
+                                         trlog,
+                                         4,
+                                         mdv_uuid_hash,
+                                         mdv_uuid_cmp);
+    if (!syncer->inboxes)
+    {
+        MDV_LOGE("There is no memory for received data hashmap");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_hashmap_release, syncer->inboxes);
+
+    if (mdv_mutex_create(&syncer->snapshot_mutex) != MDV_OK)
+    {
+        MDV_LOGE("Mutex for bootstrapping state not created");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_mutex_free, &syncer->snapshot_mutex);
+
+    syncer->deferred = mdv_vector_create(8, sizeof(mdv_syncer_deferred), &mdv_default_allocator);
+
+    if (!syncer->deferred)
+    {
+        MDV_LOGE("There is no memory for deferred synchronization requests");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_vector_release, syncer->deferred);
+
+    // Empty node is bootstrapped from the neighbour node snapshot
+    syncer->bootstrap = MDV_CONFIG.datasync.snapshot && mdv_syncer_snapshot_required(syncer);
+    syncer->requested = false;
+    syncer->snapshot_time = 0;
+
+    if (syncer->bootstrap)
+        MDV_LOGI("Node is empty. It is bootstrapped from snapshot.");
+
     if (mdv_syncer_topology_changed(syncer, topology) != MDV_OK)
     {
         MDV_LOGE("Peers synchronizeers creation failed");
@@ -381,6 +1224,15 @@ mdv_syncer * mdv_syncer_create(mdv_uuid const *uuid,
 
     mdv_rollbacker_push(rollbacker, mdv_syncer_cancel, syncer);
 
+    if (mdv_syncer_timer_start(syncer) != MDV_OK)
+    {
+        MDV_LOGE("Synchronization timer creation failed");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_syncer_timer_stop, syncer);
+
     if (mdv_ebus_subscribe_all(syncer->ebus,
                                syncer,
                                mdv_syncer_handlers,
@@ -410,6 +1262,8 @@ void mdv_syncer_cancel(mdv_syncer *syncer)
 
 static void mdv_syncer_free(mdv_syncer *syncer)
 {
+    mdv_syncer_timer_stop(syncer);
+
     mdv_syncer_cancel(syncer);
 
     mdv_ebus_unsubscribe_all(syncer->ebus,
@@ -428,7 +1282,19 @@ static void mdv_syncer_free(mdv_syncer *syncer)
         mdv_syncerino_release(peer->syncerino);
     mdv_hashmap_release(syncer->peers);
 
+    mdv_hashmap_foreach(syncer->inboxes, mdv_syncer_inbox, inbox)
+    {
+        mdv_list_foreach(&inbox->batches, mdv_syncer_batch, batch)
+            mdv_list_clear(&batch->rows);
+        mdv_list_clear(&inbox->batches);
+    }
+    mdv_hashmap_release(syncer->inboxes);
+
+    mdv_vector_release(syncer->deferred);
+
     mdv_mutex_free(&syncer->mutex);
+    mdv_mutex_free(&syncer->inbox_mutex);
+    mdv_mutex_free(&syncer->snapshot_mutex);
 
     memset(syncer, 0, sizeof(*syncer));
     mdv_free(syncer);
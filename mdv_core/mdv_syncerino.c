@@ -4,6 +4,7 @@
 #include <mdv_log.h>
 #include <mdv_mutex.h>
 #include <mdv_hashmap.h>
+#include <mdv_vector.h>
 #include <mdv_rollbacker.h>
 #include <stdatomic.h>
 
@@ -184,3 +185,42 @@ mdv_errno mdv_syncerino_start(mdv_syncerino *syncerino, mdv_uuid const *trlog)
 
     return MDV_FAILED;
 }
+
+
+void mdv_syncerino_check(mdv_syncerino *syncerino)
+{
+    mdv_vector *syncerlogs = mdv_vector_create(8, sizeof(mdv_syncerlog*), &mdv_default_allocator);
+
+    if (!syncerlogs)
+    {
+        MDV_LOGE("No memory for transaction logs synchronizers list");
+        return;
+    }
+
+    if (mdv_mutex_lock(&syncerino->mutex) == MDV_OK)
+    {
+        mdv_hashmap_foreach(syncerino->trlogs, mdv_syncerlog_ref, ref)
+        {
+            mdv_syncerlog *syncerlog = mdv_syncerlog_retain(ref->syncerlog);
+
+            if (!mdv_vector_push_back(syncerlogs, &syncerlog))
+            {
+                MDV_LOGE("No memory for transaction logs synchronizers list");
+                mdv_syncerlog_release(syncerlog);
+            }
+        }
+
+        mdv_mutex_unlock(&syncerino->mutex);
+    }
+
+    // Synchronizers are checked without lock because the synchronization events are published
+    mdv_syncerlog **syncerlogs_list = mdv_vector_data(syncerlogs);
+
+    for(size_t i = 0; i < mdv_vector_size(syncerlogs); ++i)
+    {
+        mdv_syncerlog_check(syncerlogs_list[i]);
+        mdv_syncerlog_release(syncerlogs_list[i]);
+    }
+
+    mdv_vector_release(syncerlogs);
+}
@@ -61,3 +61,11 @@ void mdv_syncerino_cancel(mdv_syncerino *syncerino);
  * @param trlog [in] transaction log UUID
  */
 mdv_errno mdv_syncerino_start(mdv_syncerino *syncerino, mdv_uuid const *trlog);
+
+
+/**
+ * @brief Checks the synchronization state of all transaction logs
+ *
+ * @param syncerino [in] transaction logs synchronizer with specific node
+ */
+void mdv_syncerino_check(mdv_syncerino *syncerino);
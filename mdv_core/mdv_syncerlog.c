@@ -7,11 +7,18 @@
 #include <mdv_mutex.h>
 #include <mdv_hashmap.h>
 #include <mdv_rollbacker.h>
+#include <mdv_time.h>
 #include <stdatomic.h>
 #include <assert.h>
 #include <inttypes.h>
 
 
+enum
+{
+    MDV_SYNCERLOG_ACK_TIMEOUT = 30 * 1000,  ///< Time after which unacknowledged data is considered lost (in milliseconds)
+};
+
+
 /// Data synchronizer with specific node
 struct mdv_syncerlog
 {
@@ -19,9 +26,17 @@ struct mdv_syncerlog
     mdv_uuid                uuid;           ///< Current node UUID
     mdv_uuid                peer;           ///< Global unique identifier for peer
     mdv_uuid                trlog;          ///< Global unique identifier for transaction log
-    atomic_size_t           requests;       ///< TR log synchronization requests counter
     atomic_size_t           active_jobs;    ///< Active jobs counter
-    atomic_uint_fast64_t    synced;         ///< The last synchronized log record
+    atomic_bool             lost;           ///< Flag indicates that records required by peer are truncated
+    mdv_mutex               mutex;          ///< Mutex for sending window guard
+    bool                    known;          ///< Flag indicates that the peer transaction log position is known
+    bool                    syncing;        ///< Flag indicates that the peer transaction log position is requested
+    bool                    sending;        ///< Flag indicates that the data sending job is scheduled
+    uint64_t                sent;           ///< Next transaction log position for sending
+    uint64_t                acked;          ///< Transaction log position acknowledged by peer
+    uint64_t                recover;        ///< Position which should be acknowledged to finish retransmission (0 if there is no retransmission)
+    uint32_t                inflight;       ///< Number of unacknowledged batches
+    size_t                  ack_time;       ///< Time of the last request or acknowledgement (in milliseconds)
     mdv_ebus               *ebus;           ///< Event bus
     mdv_jobber             *jobber;         ///< Jobs scheduler
 };
@@ -50,6 +65,105 @@ static mdv_trlog * mdv_syncerlog_get(mdv_syncerlog *syncerlog, bool create)
 }
 
 
+static uint32_t mdv_syncerlog_window()
+{
+    return MDV_CONFIG.datasync.window ? MDV_CONFIG.datasync.window : 1;
+}
+
+
+static bool mdv_syncerlog_data_send(mdv_syncerlog *syncer, mdv_trlog *trlog, uint64_t start, uint64_t *end)
+{
+    uint64_t const top = mdv_trlog_top(trlog);
+
+    *end = top;
+
+    if (*end > start + MDV_CONFIG.datasync.batch_size)
+        *end = start + MDV_CONFIG.datasync.batch_size;
+
+    // Truncated records can't be sent. The batch covering them would leave a hole in the peer transaction log.
+    if (start < mdv_trlog_begin(trlog))
+    {
+        if (!atomic_exchange_explicit(&syncer->lost, true, memory_order_relaxed))
+        {
+            char uuid_str[MDV_UUID_STR_LEN];
+            MDV_LOGE("Transaction log records required by peer \'%s\' are truncated: %" PRIu64 "-%" PRIu64,
+                     mdv_uuid_to_str(&syncer->peer, uuid_str),
+                     start,
+                     mdv_trlog_begin(trlog));
+        }
+
+        return false;
+    }
+
+    mdv_list/*<mdv_trlog_data>*/ rows = {};
+
+    size_t count = mdv_trlog_range_read(trlog, start, *end, MDV_CONFIG.datasync.batch_bytes, &rows);
+
+    // Records identifiers may be missed in transaction log. In this case the batch covers the gap.
+    if (!count && *end < top)
+    {
+        *end = top;
+        count = mdv_trlog_range_read(trlog, start, *end, MDV_CONFIG.datasync.batch_bytes, &rows);
+    }
+
+    if (!count)
+        return false;
+
+    *end = mdv_list_back(&rows, mdv_trlog_data)->id + 1;
+
+    // Operations which aren't required by peer and by nodes behind it are emptied
+    mdv_evt_trlog_filter *filter = mdv_evt_trlog_filter_create(&syncer->peer, &rows);
+
+    if (!filter)
+    {
+        MDV_LOGE("Transaction log filtering failed. No memory.");
+        mdv_list_clear(&rows);
+        return false;
+    }
+
+    mdv_errno err = mdv_ebus_publish(syncer->ebus, &filter->base, MDV_EVT_SYNC);
+
+    mdv_evt_trlog_filter_release(filter);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Transaction log filtering failed with error %d", err);
+        mdv_list_clear(&rows);
+        return false;
+    }
+
+    char uuid_str[MDV_UUID_STR_LEN];
+    MDV_LOGI("Sync data for peer \'%s\': %" PRIu64 "-%" PRIu64,
+            mdv_uuid_to_str(&syncer->peer, uuid_str),
+            start,
+            *end);
+
+    bool ret = false;
+
+    mdv_evt_trlog_data *evt = mdv_evt_trlog_data_create(
+                                    mdv_trlog_uuid(trlog),
+                                    &syncer->uuid,
+                                    &syncer->peer,
+                                    start,
+                                    &rows,
+                                    (uint32_t)count);
+
+    if (evt)
+    {
+        ret = mdv_ebus_publish(syncer->ebus, &evt->base, MDV_EVT_SYNC) == MDV_OK;
+        if (!ret)
+            MDV_LOGE("Transaction synchronization failed");
+        mdv_evt_trlog_data_release(evt);
+    }
+    else
+        MDV_LOGE("Transaction synchronization failed");
+
+    mdv_list_clear(&rows);
+
+    return ret;
+}
+
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // Job for data sending
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -57,48 +171,62 @@ typedef struct mdv_syncerlog_data_send_context
 {
     mdv_syncerlog  *syncer;                 ///< Data synchronizer
     mdv_trlog      *trlog;                  ///< TR log for synchronization
-    uint64_t        range[2];               ///< TR log entries range for synchronization
 } mdv_syncerlog_data_send_context;
 
 
 typedef mdv_job(mdv_syncerlog_data_send_context)    mdv_syncerlog_data_send_job;
 
 
+/**
+ * @brief Sends batches while the sending window isn't full
+ * @details Only one sending job is scheduled for the synchronizer. So batches are sent in order.
+ */
 static void mdv_syncerlog_data_send_fn(mdv_job_base *job)
 {
     mdv_syncerlog_data_send_context *ctx = (mdv_syncerlog_data_send_context *)job->data;
     mdv_syncerlog                   *syncer = ctx->syncer;
 
-    mdv_list/*<mdv_trlog_data>*/ rows = {};
+    uint32_t const window = mdv_syncerlog_window();
 
-    size_t const count = mdv_trlog_range_read(
-                            ctx->trlog,
-                            ctx->range[0],
-                            ctx->range[1],
-                            &rows);
-
-    if (count)
+    while (mdv_mutex_lock(&syncer->mutex) == MDV_OK)
     {
-        mdv_evt_trlog_data *evt = mdv_evt_trlog_data_create(
-                                        mdv_trlog_uuid(ctx->trlog),
-                                        &syncer->uuid,
-                                        &syncer->peer,
-                                        &rows,
-                                        (uint32_t)count);
-
-        if (evt)
+        if (!syncer->known
+            || syncer->inflight >= window
+            || syncer->sent >= mdv_trlog_top(ctx->trlog))
         {
-            if (mdv_ebus_publish(syncer->ebus, &evt->base, MDV_EVT_SYNC) != MDV_OK)
-                MDV_LOGE("Transaction synchronization failed");
-            mdv_evt_trlog_data_release(evt);
+            syncer->sending = false;
+            mdv_mutex_unlock(&syncer->mutex);
+            break;
+        }
+
+        uint64_t const start = syncer->sent;
+
+        mdv_mutex_unlock(&syncer->mutex);
+
+        uint64_t end = start;
+
+        bool const sent = mdv_syncerlog_data_send(syncer, ctx->trlog, start, &end);
+
+        if (mdv_mutex_lock(&syncer->mutex) != MDV_OK)
+            break;
+
+        if (sent)
+        {
+            // Sending position may be moved back for retransmission
+            if (syncer->sent == start)
+                syncer->sent = end;
+
+            if (!syncer->inflight++)
+                syncer->ack_time = mdv_gettime();
         }
         else
-            MDV_LOGE("Transaction synchronization failed");
+            syncer->sending = false;
 
-        mdv_list_clear(&rows);
+        mdv_mutex_unlock(&syncer->mutex);
+
+        if (!sent)
+            break;
     }
-    else
-        MDV_LOGE("Transaction synchronization failed");
 }
 
 
@@ -113,7 +241,7 @@ static void mdv_syncerlog_data_send_finalize(mdv_job_base *job)
 }
 
 
-static mdv_errno mdv_syncerlog_data_send_job_emit(mdv_syncerlog *syncerlog, mdv_trlog *trlog, uint64_t lrange, uint64_t rrange)
+static mdv_errno mdv_syncerlog_data_send_job_emit(mdv_syncerlog *syncerlog, mdv_trlog *trlog)
 {
     mdv_syncerlog_data_send_job *job = mdv_alloc(sizeof(mdv_syncerlog_data_send_job));
 
@@ -127,8 +255,6 @@ static mdv_errno mdv_syncerlog_data_send_job_emit(mdv_syncerlog *syncerlog, mdv_
     job->finalize       = mdv_syncerlog_data_send_finalize;
     job->data.syncer    = mdv_syncerlog_retain(syncerlog);
     job->data.trlog     = mdv_trlog_retain(trlog);
-    job->data.range[0]  = lrange;
-    job->data.range[1]  = rrange;
 
     mdv_errno err = mdv_jobber_push(syncerlog->jobber, (mdv_job_base*)job);
 
@@ -146,42 +272,87 @@ static mdv_errno mdv_syncerlog_data_send_job_emit(mdv_syncerlog *syncerlog, mdv_
 }
 
 
-static bool mdv_syncerlog_is_empty(mdv_syncerlog *syncerlog)
+/**
+ * @brief Schedules data sending if the sending window isn't full
+ * @details Synchronizer mutex should be locked.
+ */
+static void mdv_syncerlog_schedule(mdv_syncerlog *syncerlog, mdv_trlog *trlog)
 {
-    mdv_trlog *trlog = mdv_syncerlog_get(syncerlog, false);
+    if (syncerlog->sending
+        || !syncerlog->known
+        || syncerlog->inflight >= mdv_syncerlog_window()
+        || syncerlog->sent >= mdv_trlog_top(trlog))
+        return;
 
-    if(!trlog)
-        return true;
-
-    bool const trlog_is_empty = mdv_trlog_top(trlog) == 0;
-
-    mdv_trlog_release(trlog);
-
-    return trlog_is_empty;
+    syncerlog->sending = mdv_syncerlog_data_send_job_emit(syncerlog, trlog) == MDV_OK;
 }
 
 
 static mdv_errno mdv_syncerlog_start(mdv_syncerlog *syncerlog)
 {
-    if(mdv_syncerlog_is_empty(syncerlog))
+    mdv_trlog *trlog = mdv_syncerlog_get(syncerlog, false);
+
+    if(!trlog)
         return MDV_OK;
 
-    if (atomic_fetch_add_explicit(&syncerlog->requests, 1, memory_order_relaxed) != 0)
+    if (mdv_trlog_top(trlog) == 0)
+    {
+        mdv_trlog_release(trlog);
         return MDV_OK;
+    }
+
+    mdv_errno err = mdv_mutex_lock(&syncerlog->mutex);
+
+    if (err != MDV_OK)
+    {
+        mdv_trlog_release(trlog);
+        return err;
+    }
+
+    size_t const now = mdv_gettime();
+
+    // Peer position is requested again if there is no response for a long time
+    if ((syncerlog->syncing || syncerlog->inflight)
+        && now - syncerlog->ack_time > MDV_SYNCERLOG_ACK_TIMEOUT)
+    {
+        char uuid_str[MDV_UUID_STR_LEN];
+        MDV_LOGW("No response from peer \'%s\'. Transaction log position is requested again.",
+                 mdv_uuid_to_str(&syncerlog->peer, uuid_str));
+        syncerlog->known = false;
+        syncerlog->syncing = false;
+    }
+
+    bool sync = false;
+
+    if (!syncerlog->known)
+    {
+        if (!syncerlog->syncing)
+        {
+            syncerlog->syncing = sync = true;
+            syncerlog->ack_time = now;
+        }
+    }
+    else
+        mdv_syncerlog_schedule(syncerlog, trlog);
 
-    mdv_errno err = MDV_OK;
+    mdv_mutex_unlock(&syncerlog->mutex);
+
+    mdv_trlog_release(trlog);
 
-    mdv_evt_trlog_sync *sync = mdv_evt_trlog_sync_create(
+    if (!sync)
+        return MDV_OK;
+
+    mdv_evt_trlog_sync *evt = mdv_evt_trlog_sync_create(
                                     &syncerlog->trlog,
                                     &syncerlog->uuid,
                                     &syncerlog->peer);
 
-    if (sync)
+    if (evt)
     {
-        err = mdv_ebus_publish(syncerlog->ebus, &sync->base, MDV_EVT_SYNC);
+        err = mdv_ebus_publish(syncerlog->ebus, &evt->base, MDV_EVT_SYNC);
         if (err != MDV_OK)
             MDV_LOGE("Transaction synchronization failed");
-        mdv_evt_trlog_sync_release(sync);
+        mdv_evt_trlog_sync_release(evt);
     }
     else
     {
@@ -189,8 +360,11 @@ static mdv_errno mdv_syncerlog_start(mdv_syncerlog *syncerlog)
         MDV_LOGE("Transaction synchronization failed. No memory.");
     }
 
-    if (err != MDV_OK)
-        atomic_init(&syncerlog->requests, 0);
+    if (err != MDV_OK && mdv_mutex_lock(&syncerlog->mutex) == MDV_OK)
+    {
+        syncerlog->syncing = false;
+        mdv_mutex_unlock(&syncerlog->mutex);
+    }
 
     return err;
 }
@@ -208,75 +382,80 @@ static mdv_errno mdv_syncerlog_evt_changed(void *arg, mdv_event *event)
 }
 
 
-static mdv_errno mdv_syncerlog_schedule(mdv_syncerlog *syncerlog, mdv_trlog *trlog, uint64_t pos)
+static mdv_errno mdv_syncerlog_evt_trlog_state(void *arg, mdv_event *event)
 {
-    size_t requests = atomic_load_explicit(&syncerlog->requests, memory_order_relaxed);
-    uint64_t synced = atomic_load_explicit(&syncerlog->synced, memory_order_relaxed);
-    uint64_t trlog_top, rrange;
+    mdv_syncerlog *syncerlog = arg;
+    mdv_evt_trlog_state *state = (mdv_evt_trlog_state *)event;
+
+    if(mdv_uuid_cmp(&syncerlog->peer, &state->from) != 0
+      || mdv_uuid_cmp(&syncerlog->uuid, &state->to) != 0
+      || mdv_uuid_cmp(&syncerlog->trlog, &state->trlog) != 0)
+        return MDV_OK;
+
+    mdv_trlog *trlog = mdv_syncerlog_get(syncerlog, false);
+
+    if (!trlog)
+    {
+        MDV_LOGE("Transaction log for synchronization not found");
+        return MDV_FAILED;
+    }
 
-    mdv_errno err = MDV_OK;
+    // Position received by peer is saved for the transaction log truncation and tombstones purging
+    if (mdv_trlog_synced_set(trlog, &syncerlog->peer, state->top) != MDV_OK)
+        MDV_LOGE("Transaction log position received by peer wasn't saved");
 
-    if (synced < pos)
-        synced = pos;
+    mdv_errno err = mdv_mutex_lock(&syncerlog->mutex);
 
-    do
+    if (err == MDV_OK)
     {
-        do
+        if (!syncerlog->known)
         {
-            do
+            // Response for the synchronization request
+            atomic_store_explicit(&syncerlog->lost, false, memory_order_relaxed);
+            syncerlog->known = true;
+            syncerlog->syncing = false;
+            syncerlog->sent = state->top;
+            syncerlog->acked = state->top;
+            syncerlog->recover = 0;
+            syncerlog->inflight = 0;
+        }
+        else
+        {
+            // Each batch is acknowledged by the peer transaction log top
+            if (syncerlog->inflight)
+                --syncerlog->inflight;
+
+            if (state->top > syncerlog->acked)
             {
-                rrange = trlog_top = mdv_trlog_top(trlog);
+                syncerlog->acked = state->top;
 
-                if (synced >= trlog_top)
-                    break;
+                if (syncerlog->sent < state->top)
+                    syncerlog->sent = state->top;
 
-                if (rrange > synced + MDV_CONFIG.datasync.batch_size)
-                    rrange = synced + MDV_CONFIG.datasync.batch_size;
+                if (syncerlog->recover <= state->top)
+                    syncerlog->recover = 0;
             }
-            while (!atomic_compare_exchange_weak(&syncerlog->synced, &synced, rrange));
-
-            if (synced < rrange)
+            else if (state->top < syncerlog->sent && !syncerlog->recover)
             {
+                // The peer position isn't moved. So the batch wasn't accepted and
+                // the following batches will be rejected too.
                 char uuid_str[MDV_UUID_STR_LEN];
-                MDV_LOGI("Sync job for peer \'%s\': %" PRId64 "-%" PRId64,
-                        mdv_uuid_to_str(&syncerlog->peer, uuid_str),
-                        synced,
-                        rrange);
-
-                err = mdv_syncerlog_data_send_job_emit(syncerlog, trlog, synced, rrange);
-
-                synced = rrange;
+                MDV_LOGW("Transaction log gap for peer \'%s\'. Records are sent again from %" PRIu64,
+                         mdv_uuid_to_str(&syncerlog->peer, uuid_str),
+                         state->top);
+                syncerlog->recover = syncerlog->sent;
+                syncerlog->sent = state->top;
             }
         }
-        while (rrange < trlog_top);
-    }
-    while (!atomic_compare_exchange_strong(&syncerlog->requests, &requests, 0));
-
-    return err;
-}
-
-
-static mdv_errno mdv_syncerlog_evt_trlog_state(void *arg, mdv_event *event)
-{
-    mdv_syncerlog *syncerlog = arg;
-    mdv_evt_trlog_state *state = (mdv_evt_trlog_state *)event;
-
-    if(mdv_uuid_cmp(&syncerlog->peer, &state->from) != 0
-      || mdv_uuid_cmp(&syncerlog->uuid, &state->to) != 0
-      || mdv_uuid_cmp(&syncerlog->trlog, &state->trlog) != 0)
-        return MDV_OK;
 
-    mdv_errno err = MDV_FAILED;
+        syncerlog->ack_time = mdv_gettime();
 
-    mdv_trlog *trlog = mdv_syncerlog_get(syncerlog, false);
+        mdv_syncerlog_schedule(syncerlog, trlog);
 
-    if (trlog)
-    {
-        err = mdv_syncerlog_schedule(syncerlog, trlog, state->top);
-        mdv_trlog_release(trlog);
+        mdv_mutex_unlock(&syncerlog->mutex);
     }
-    else
-        MDV_LOGE("Transaction log for synchronization not found");
+
+    mdv_trlog_release(trlog);
 
     return err;
 }
@@ -291,7 +470,7 @@ static const mdv_event_handler_type mdv_syncerlog_handlers[] =
 
 mdv_syncerlog * mdv_syncerlog_create(mdv_uuid const *uuid, mdv_uuid const *peer, mdv_uuid const *trlog, mdv_ebus *ebus, mdv_jobber *jobber)
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(4);
 
     mdv_syncerlog *syncerlog = mdv_alloc(sizeof(mdv_syncerlog));
 
@@ -305,13 +484,29 @@ mdv_syncerlog * mdv_syncerlog_create(mdv_uuid const *uuid, mdv_uuid const *peer,
     mdv_rollbacker_push(rollbacker, mdv_free, syncerlog);
 
     atomic_init(&syncerlog->rc, 1);
-    atomic_init(&syncerlog->requests, 0);
     atomic_init(&syncerlog->active_jobs, 0);
-    atomic_init(&syncerlog->synced, 0);
+    atomic_init(&syncerlog->lost, false);
 
     syncerlog->uuid = *uuid;
     syncerlog->peer = *peer;
     syncerlog->trlog = *trlog;
+    syncerlog->known = false;
+    syncerlog->syncing = false;
+    syncerlog->sending = false;
+    syncerlog->sent = 0;
+    syncerlog->acked = 0;
+    syncerlog->recover = 0;
+    syncerlog->inflight = 0;
+    syncerlog->ack_time = 0;
+
+    if (mdv_mutex_create(&syncerlog->mutex) != MDV_OK)
+    {
+        MDV_LOGE("Mutex for sending window not created");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_mutex_free, &syncerlog->mutex);
 
     syncerlog->ebus = mdv_ebus_retain(ebus);
 
@@ -367,6 +562,8 @@ static void mdv_syncerlog_free(mdv_syncerlog *syncerlog)
 
     mdv_jobber_release(syncerlog->jobber);
 
+    mdv_mutex_free(&syncerlog->mutex);
+
     char peer_uuid_str[MDV_UUID_STR_LEN];
     char trlog_uuid_str[MDV_UUID_STR_LEN];
 
@@ -392,3 +589,8 @@ uint32_t mdv_syncerlog_release(mdv_syncerlog *syncerlog)
     return rc;
 }
 
+
+mdv_errno mdv_syncerlog_check(mdv_syncerlog *syncerlog)
+{
+    return mdv_syncerlog_start(syncerlog);
+}
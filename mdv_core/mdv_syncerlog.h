@@ -46,3 +46,15 @@ mdv_syncerlog * mdv_syncerlog_retain(mdv_syncerlog *syncerlog);
  */
 uint32_t mdv_syncerlog_release(mdv_syncerlog *syncerlog);
 
+
+/**
+ * @brief Checks the transaction log synchronization state
+ * @details If the peer doesn't respond for a long time, its position is requested again.
+ *          The check is performed periodically to resume the synchronization of the idle logs.
+ *
+ * @param syncerlog [in] transaction log synchronizer
+ *
+ * @return On success, return MDV_OK
+ * @return On error, return nonzero error code
+ */
+mdv_errno mdv_syncerlog_check(mdv_syncerlog *syncerlog);
@@ -30,6 +30,8 @@ typedef struct
     mdv_ebus               *ebus;           ///< Events bus
     mdv_mutex               topomutex;      ///< Mutex for topology guard
     mdv_safeptr            *topology;       ///< Current network topology
+    mdv_uuid                bulk_table;     ///< Table for bulk rows loading
+    bool                    bulk;           ///< Bulk rows loading is opened
 } mdv_user;
 
 
@@ -221,6 +223,32 @@ static mdv_errno mdv_user_view_data_reply(mdv_user *user, uint16_t id, mdv_msg_r
 }
 
 
+static mdv_errno mdv_user_stream_rowset_reply(mdv_user *user, uint16_t id, mdv_msg_stream_rowset const *msg)
+{
+    binn rowset;
+
+    if (!mdv_msg_stream_rowset_binn(msg, &rowset))
+        return MDV_FAILED;
+
+    mdv_msg message =
+    {
+        .hdr =
+        {
+            .id = mdv_msg_stream_rowset_id,
+            .number = id,
+            .size = binn_size(&rowset)
+        },
+        .payload = binn_ptr(&rowset)
+    };
+
+    mdv_errno err = mdv_user_reply(user, &message);
+
+    binn_free(&rowset);
+
+    return err;
+}
+
+
 static mdv_errno mdv_user_table_info_reply(mdv_user *user, uint16_t id, mdv_msg_table_info const *msg)
 {
     binn table_info;
@@ -464,6 +492,83 @@ static mdv_errno mdv_user_insert_into_handler(mdv_msg const *msg, void *arg)
 }
 
 
+static mdv_errno mdv_user_bulk_open_handler(mdv_msg const *msg, void *arg)
+{
+    MDV_LOGI("<<<<< '%s'", mdv_msg_name(msg->hdr.id));
+
+    mdv_user    *user   = arg;
+
+    binn binn_msg;
+
+    if(!binn_load(msg->payload, &binn_msg))
+    {
+        MDV_LOGW("Message '%s' reading failed", mdv_msg_name(msg->hdr.id));
+        return MDV_FAILED;
+    }
+
+    mdv_msg_bulk_open bulk_open;
+
+    mdv_errno err = MDV_FAILED;
+
+    if (mdv_msg_bulk_open_unbinn(&binn_msg, &bulk_open))
+    {
+        user->bulk_table = bulk_open.table;
+        user->bulk = true;
+        err = MDV_OK;
+    }
+    else
+        MDV_LOGE("Invalid '%s' message", mdv_msg_name(mdv_msg_bulk_open_id));
+
+    binn_free(&binn_msg);
+
+    mdv_msg_status const status =
+    {
+        .err = err,
+        .message = ""
+    };
+
+    return mdv_user_status_reply(user, msg->hdr.number, &status);
+}
+
+
+static mdv_errno mdv_user_bulk_rows_handler(mdv_msg const *msg, void *arg)
+{
+    MDV_LOGI("<<<<< '%s'", mdv_msg_name(msg->hdr.id));
+
+    mdv_user    *user   = arg;
+
+    mdv_errno err = MDV_FAILED;
+
+    int type = 0, count = 0, size = (int)msg->hdr.size;
+
+    // Serialized rows are passed to the transaction log directly from the message payload
+    if (!user->bulk)
+        MDV_LOGE("Bulk rows loading isn't opened");
+    else if (!msg->payload
+             || !binn_is_valid_ex(msg->payload, &type, &count, &size)
+             || type != BINN_LIST)
+        MDV_LOGE("Invalid '%s' message", mdv_msg_name(mdv_msg_bulk_rows_id));
+    else
+    {
+        mdv_evt_rowdata_ins_req *evt = mdv_evt_rowdata_ins_req_create(&user->bulk_table, msg->payload);
+
+        if (evt)
+        {
+            err = mdv_ebus_publish(user->ebus, &evt->base, MDV_EVT_SYNC);
+            mdv_evt_rowdata_ins_req_release(evt);
+        }
+    }
+
+    mdv_msg_status const status =
+    {
+        .err = err,
+        .message = ""
+    };
+
+    return mdv_user_status_reply(user, msg->hdr.number, &status);
+}
+
+
 static mdv_errno mdv_user_delete_from_handler(mdv_msg const *msg, void *arg)
 {
     MDV_LOGI("<<<<< '%s'", mdv_msg_name(msg->hdr.id));
@@ -484,7 +589,13 @@ static mdv_errno mdv_user_delete_from_handler(mdv_msg const *msg, void *arg)
 
     if (mdv_msg_delete_from_unbinn(&binn_msg, &delete_from))
     {
-        // TODO
+        mdv_evt_rowdata_del_req *evt = mdv_evt_rowdata_del_req_create(&delete_from.table, delete_from.filter);
+
+        if (evt)
+        {
+            err = mdv_ebus_publish(user->ebus, &evt->base, MDV_EVT_SYNC);
+            mdv_evt_rowdata_del_req_release(evt);
+        }
     }
     else
         MDV_LOGE("Invalid '%s' message", mdv_msg_name(mdv_msg_delete_from_id));
@@ -611,7 +722,9 @@ static mdv_errno mdv_user_fetch_handler(mdv_msg const *msg, void *arg)
     {
         mdv_evt_view_fetch * evt = mdv_evt_view_fetch_create(&user->session,
                                                              msg->hdr.number,
-                                                             fetch.id);
+                                                             fetch.id,
+                                                             fetch.count,
+                                                             fetch.bytes);
 
         if (evt)
         {
@@ -639,6 +752,67 @@ static mdv_errno mdv_user_fetch_handler(mdv_msg const *msg, void *arg)
 }
 
 
+static mdv_errno mdv_user_stream_handler(mdv_msg const *msg, void *arg)
+{
+    MDV_LOGI("<<<<< '%s'", mdv_msg_name(msg->hdr.id));
+
+    mdv_user    *user   = arg;
+
+    binn binn_msg;
+
+    if(!binn_load(msg->payload, &binn_msg))
+    {
+        MDV_LOGW("Message '%s' reading failed", mdv_msg_name(msg->hdr.id));
+        return MDV_FAILED;
+    }
+
+    mdv_msg_stream stream = {};
+
+    mdv_errno err = MDV_FAILED;
+
+    if (mdv_msg_stream_unbinn(&binn_msg, &stream))
+    {
+        mdv_evt_view_stream * evt = mdv_evt_view_stream_create(&user->session,
+                                                               msg->hdr.number,
+                                                               stream.id,
+                                                               stream.credits,
+                                                               stream.count,
+                                                               stream.bytes);
+
+        if (evt)
+        {
+            err = mdv_ebus_publish(user->ebus, &evt->base, MDV_EVT_DEFAULT);
+            mdv_evt_view_stream_release(evt);
+        }
+    }
+    else
+        MDV_LOGE("Invalid '%s' message", mdv_msg_name(mdv_msg_stream_id));
+
+    binn_free(&binn_msg);
+
+    if (err != MDV_OK)
+    {
+        // Empty rows batch finishes the stream on the client side
+        binn rows;
+
+        if (!binn_create_list(&rows))
+            return MDV_NO_MEM;
+
+        mdv_msg_stream_rowset const rowset =
+        {
+            .id = stream.id,
+            .rows = &rows
+        };
+
+        err = mdv_user_stream_rowset_reply(user, msg->hdr.number, &rowset);
+
+        binn_free(&rows);
+    }
+
+    return err;
+}
+
+
 static mdv_errno mdv_user_evt_topology(void *arg, mdv_event *event)
 {
     mdv_user *user = arg;
@@ -692,6 +866,7 @@ static mdv_errno mdv_user_evt_view_data(void *arg, mdv_event *event)
 
     mdv_msg_rowset const rowset =
     {
+        .bytes = binn_size(evt->rows),
         .rows = evt->rows
     };
 
@@ -699,12 +874,32 @@ static mdv_errno mdv_user_evt_view_data(void *arg, mdv_event *event)
 }
 
 
+static mdv_errno mdv_user_evt_view_stream_data(void *arg, mdv_event *event)
+{
+    mdv_user *user = arg;
+    mdv_evt_view_stream_data *evt = (mdv_evt_view_stream_data *)event;
+
+    if (mdv_uuid_cmp(&evt->session, &user->session) != 0)
+        return MDV_OK;
+
+    mdv_msg_stream_rowset const rowset =
+    {
+        .id = evt->view_id,
+        .bytes = binn_size(evt->rows),
+        .rows = evt->rows
+    };
+
+    return mdv_user_stream_rowset_reply(user, evt->request_id, &rowset);
+}
+
+
 static const mdv_event_handler_type mdv_user_handlers[] =
 {
-    { MDV_EVT_TOPOLOGY,     mdv_user_evt_topology },
-    { MDV_EVT_STATUS,       mdv_user_evt_status },
-    { MDV_EVT_VIEW,         mdv_user_evt_view },
-    { MDV_EVT_VIEW_DATA,    mdv_user_evt_view_data },
+    { MDV_EVT_TOPOLOGY,         mdv_user_evt_topology },
+    { MDV_EVT_STATUS,           mdv_user_evt_status },
+    { MDV_EVT_VIEW,             mdv_user_evt_view },
+    { MDV_EVT_VIEW_DATA,        mdv_user_evt_view_data },
+    { MDV_EVT_VIEW_STREAM_DATA, mdv_user_evt_view_stream_data },
 };
 
 
@@ -744,6 +939,7 @@ mdv_channel * mdv_user_create(mdv_descriptor  fd,
 
     user->session = *session;
     user->uuid = *uuid;
+    user->bulk = false;
 
     user->ebus = mdv_ebus_retain(ebus);
     mdv_rollbacker_push(rollbacker, mdv_ebus_release, user->ebus);
@@ -781,6 +977,9 @@ mdv_channel * mdv_user_create(mdv_descriptor  fd,
         { mdv_message_id(select),        &mdv_user_select_handler,       user },
         { mdv_message_id(fetch),         &mdv_user_fetch_handler,        user },
         { mdv_message_id(delete_from),   &mdv_user_delete_from_handler,  user },
+        { mdv_message_id(stream),        &mdv_user_stream_handler,       user },
+        { mdv_message_id(bulk_open),     &mdv_user_bulk_open_handler,    user },
+        { mdv_message_id(bulk_rows),     &mdv_user_bulk_rows_handler,    user },
 
     };
 
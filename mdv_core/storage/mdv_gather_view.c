@@ -0,0 +1,206 @@
+#include "mdv_gather_view.h"
+#include <mdv_alloc.h>
+#include <mdv_log.h>
+#include <mdv_mutex.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+
+typedef struct
+{
+    mdv_view              base;             ///< Base type for view
+    atomic_uint_fast32_t  rc;               ///< References counter
+    mdv_mutex             mutex;            ///< Mutex for rows reading guard
+    bool                  started;          ///< Partial views reading is started
+    size_t                current;          ///< Partial view which is read next
+    size_t                active;           ///< Unfinished partial views count (they are placed at the beginning)
+    size_t                count;            ///< Partial views count
+    mdv_view             *views[1];         ///< Partial views
+} mdv_gather_view;
+
+
+static void mdv_gather_view_free(mdv_gather_view *view)
+{
+    for(size_t i = 0; i < view->count; ++i)
+        mdv_view_release(view->views[i]);
+    mdv_mutex_free(&view->mutex);
+    mdv_free(view);
+}
+
+
+static mdv_view * mdv_gather_view_retain(mdv_view *base)
+{
+    mdv_gather_view *view = (mdv_gather_view *)base;
+    atomic_fetch_add_explicit(&view->rc, 1, memory_order_acquire);
+    return base;
+}
+
+
+static uint32_t mdv_gather_view_release(mdv_view *base)
+{
+    mdv_gather_view *view = (mdv_gather_view *)base;
+
+    uint32_t rc = 0;
+
+    if (view)
+    {
+        rc = atomic_fetch_sub_explicit(&view->rc, 1, memory_order_release) - 1;
+
+        if (!rc)
+            mdv_gather_view_free(view);
+    }
+
+    return rc;
+}
+
+
+static mdv_table * mdv_gather_view_desc(mdv_view *base)
+{
+    mdv_gather_view *view = (mdv_gather_view *)base;
+    return mdv_view_desc(view->views[0]);
+}
+
+
+static void mdv_gather_view_start(mdv_gather_view *view, size_t count, size_t bytes)
+{
+    for(size_t i = 0; i < view->active; ++i)
+        mdv_view_prefetch(view->views[i], count, bytes);
+}
+
+
+/// Exhausted partial view is moved behind the unfinished ones
+static void mdv_gather_view_finish(mdv_gather_view *view, size_t idx)
+{
+    mdv_view *finished = view->views[idx];
+    view->views[idx] = view->views[--view->active];
+    view->views[view->active] = finished;
+}
+
+
+static mdv_errno mdv_gather_view_read(mdv_gather_view *view, size_t count, size_t bytes, binn *rows)
+{
+    // Partial views are read in parallel while the current one is fetched
+    if (!view->started)
+    {
+        mdv_gather_view_start(view, count, bytes);
+        view->started = true;
+    }
+
+    // Partial views are read round-robin, so the batches requested from the remote nodes are consumed evenly
+    while(view->active)
+    {
+        if (view->current >= view->active)
+            view->current = 0;
+
+        mdv_view *partial = view->views[view->current];
+
+        mdv_errno err = mdv_view_fetch(partial, count, bytes, rows);
+
+        if (err == MDV_OK)
+        {
+            if (binn_count(rows))
+            {
+                // Next batch is read while other partial views are fetched
+                mdv_view_prefetch(partial, count, bytes);
+                view->current++;
+                return MDV_OK;
+            }
+            binn_free(rows);
+        }
+        else if (err != MDV_FAILED)
+            return err;
+
+        // Partial view is exhausted
+        mdv_gather_view_finish(view, view->current);
+    }
+
+    return MDV_FAILED;
+}
+
+
+static mdv_errno mdv_gather_view_fetch(mdv_view *base, size_t count, size_t bytes, binn *rows)
+{
+    mdv_gather_view *view = (mdv_gather_view *)base;
+
+    mdv_errno err = mdv_mutex_lock(&view->mutex);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Mutex lock failed");
+        return err;
+    }
+
+    err = mdv_gather_view_read(view, count, bytes, rows);
+
+    mdv_mutex_unlock(&view->mutex);
+
+    return err;
+}
+
+
+static void mdv_gather_view_prefetch(mdv_view *base, size_t count, size_t bytes)
+{
+    mdv_gather_view *view = (mdv_gather_view *)base;
+
+    if (mdv_mutex_lock(&view->mutex) != MDV_OK)
+    {
+        MDV_LOGE("Mutex lock failed");
+        return;
+    }
+
+    if (!view->started)
+    {
+        mdv_gather_view_start(view, count, bytes);
+        view->started = true;
+    }
+
+    mdv_mutex_unlock(&view->mutex);
+}
+
+
+mdv_view * mdv_gather_view_create(mdv_view **views, size_t count)
+{
+    if (!count)
+    {
+        MDV_LOGE("View creation failed. There are no partial views.");
+        return 0;
+    }
+
+    mdv_gather_view *view = (mdv_gather_view *)mdv_alloc(offsetof(mdv_gather_view, views)
+                                                         + count * sizeof(mdv_view *));
+
+    if (!view)
+    {
+        MDV_LOGE("View creation failed. No memory.");
+        return 0;
+    }
+
+    static mdv_iview const vtbl =
+    {
+        .retain   = mdv_gather_view_retain,
+        .release  = mdv_gather_view_release,
+        .desc     = mdv_gather_view_desc,
+        .fetch    = mdv_gather_view_fetch,
+        .prefetch = mdv_gather_view_prefetch,
+    };
+
+    if (mdv_mutex_create(&view->mutex) != MDV_OK)
+    {
+        MDV_LOGE("View creation failed.");
+        mdv_free(view);
+        return 0;
+    }
+
+    atomic_init(&view->rc, 1);
+
+    view->base.vptr = &vtbl;
+    view->started = false;
+    view->current = 0;
+    view->active = count;
+    view->count = count;
+
+    for(size_t i = 0; i < count; ++i)
+        view->views[i] = mdv_view_retain(views[i]);
+
+    return &view->base;
+}
@@ -0,0 +1,33 @@
+/**
+ * @file mdv_gather_view.h
+ * @author Vladislav Volkov (wwwvladislav@gmail.com)
+ * @brief View which gathers rows from several views
+ * @details Partitioned table rows are read from the nodes which store the partitions.
+ *          Table scan may be split between replicas as well.
+ *          Gather view merges these partial views into one rows stream.
+ * @version 0.1
+ * @date 2020-05-27
+ *
+ * @copyright Copyright (c) 2020, Vladislav Volkov
+ *
+ */
+#pragma once
+#include "mdv_view.h"
+
+
+/**
+ * @brief Creates new gather view
+ * @details Partial views are started together by the first fetching and then
+ *          their rows batches are returned round-robin. The next batch of the partial view
+ *          is prefetched after each read, so every unfinished remote view keeps one request
+ *          in flight. Partial view is exhausted if it returns
+ *          an empty rows list or MDV_FAILED. Other errors are returned to the caller.
+ *          All partial views should have the same table descriptor.
+ *
+ * @param views [in]    Partial views (views are retained by gather view)
+ * @param count [in]    Partial views count
+ *
+ * @return On success, returns non zero pointer to new view
+ * @return On error, return NULL pointer
+ */
+mdv_view * mdv_gather_view_create(mdv_view **views, size_t count);
@@ -0,0 +1,227 @@
+#include "mdv_idmap.h"
+#include <mdv_hashmap.h>
+#include <mdv_rollbacker.h>
+#include <mdv_alloc.h>
+#include <mdv_log.h>
+#include <stdatomic.h>
+
+
+struct mdv_idmap
+{
+    atomic_uint_fast32_t    rc;         ///< References counter
+    mdv_hashmap            *uuids;      ///< Local identifiers (hashmap<mdv_storage_id> by UUID)
+    mdv_hashmap            *ids;        ///< Global identifiers (hashmap<mdv_storage_id> by local identifier)
+};
+
+
+static size_t mdv_u32_hash(uint32_t const *id)                  { return *id; }
+static int mdv_u32_cmp(uint32_t const *a, uint32_t const *b)    { return *a < *b ? -1 : *a > *b; }
+
+
+mdv_idmap * mdv_idmap_create(mdv_storage_id const *ids, size_t count)
+{
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
+
+    mdv_idmap *idmap = mdv_alloc(sizeof(mdv_idmap));
+
+    if (!idmap)
+    {
+        MDV_LOGE("No memory for identifiers map");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_free, idmap);
+
+    atomic_init(&idmap->rc, 1);
+
+    idmap->uuids = mdv_hashmap_create(mdv_storage_id,
+                                      uuid,
+                                      count,
+                                      mdv_uuid_hash,
+                                      mdv_uuid_cmp);
+
+    if (!idmap->uuids)
+    {
+        MDV_LOGE("No memory for identifiers map");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_hashmap_release, idmap->uuids);
+
+    idmap->ids = mdv_hashmap_create(mdv_storage_id,
+                                    id,
+                                    count,
+                                    mdv_u32_hash,
+                                    mdv_u32_cmp);
+
+    if (!idmap->ids)
+    {
+        MDV_LOGE("No memory for identifiers map");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_hashmap_release, idmap->ids);
+
+    for(size_t i = 0; i < count; ++i)
+    {
+        if (!mdv_hashmap_insert(idmap->uuids, ids + i, sizeof *ids)
+            || !mdv_hashmap_insert(idmap->ids, ids + i, sizeof *ids))
+        {
+            MDV_LOGE("No memory for identifiers map");
+            mdv_rollback(rollbacker);
+            return 0;
+        }
+    }
+
+    mdv_rollbacker_free(rollbacker);
+
+    return idmap;
+}
+
+
+mdv_idmap * mdv_idmap_create_by_topology(mdv_topology *topology)
+{
+    mdv_vector *nodes = mdv_topology_nodes(topology);
+
+    size_t const count = mdv_vector_size(nodes);
+
+    mdv_storage_id *ids = mdv_alloc(count * sizeof(mdv_storage_id) + 1);
+
+    if (!ids)
+    {
+        MDV_LOGE("No memory for identifiers map");
+        mdv_vector_release(nodes);
+        return 0;
+    }
+
+    size_t i = 0;
+
+    mdv_vector_foreach(nodes, mdv_toponode, node)
+    {
+        ids[i].uuid = node->uuid;
+        ids[i].id = node->id;
+        ++i;
+    }
+
+    mdv_vector_release(nodes);
+
+    mdv_idmap *idmap = mdv_idmap_create(ids, count);
+
+    mdv_free(ids);
+
+    return idmap;
+}
+
+
+mdv_idmap * mdv_idmap_retain(mdv_idmap *idmap)
+{
+    atomic_fetch_add_explicit(&idmap->rc, 1, memory_order_acquire);
+    return idmap;
+}
+
+
+uint32_t mdv_idmap_release(mdv_idmap *idmap)
+{
+    uint32_t rc = 0;
+
+    if (idmap)
+    {
+        rc = atomic_fetch_sub_explicit(&idmap->rc, 1, memory_order_release) - 1;
+
+        if (!rc)
+        {
+            mdv_hashmap_release(idmap->uuids);
+            mdv_hashmap_release(idmap->ids);
+            mdv_free(idmap);
+        }
+    }
+
+    return rc;
+}
+
+
+size_t mdv_idmap_size(mdv_idmap const *idmap)
+{
+    return mdv_hashmap_size(idmap->uuids);
+}
+
+
+void mdv_idmap_ids(mdv_idmap const *idmap, mdv_storage_id *ids)
+{
+    mdv_hashmap_foreach(idmap->uuids, mdv_storage_id, entry)
+        *ids++ = *entry;
+}
+
+
+bool mdv_idmap_local(mdv_idmap const *idmap, mdv_uuid const *uuid, uint32_t *id)
+{
+    mdv_storage_id const *storage_id = mdv_hashmap_find(idmap->uuids, uuid);
+
+    if (!storage_id)
+        return false;
+
+    *id = storage_id->id;
+
+    return true;
+}
+
+
+bool mdv_idmap_global(mdv_idmap const *idmap, uint32_t id, mdv_uuid *uuid)
+{
+    mdv_storage_id const *storage_id = mdv_hashmap_find(idmap->ids, &id);
+
+    if (!storage_id)
+        return false;
+
+    *uuid = storage_id->uuid;
+
+    return true;
+}
+
+
+bool mdv_idmap_objids_global(mdv_idmap const *idmap, mdv_objid const *ids, size_t count, mdv_gobjid *gids)
+{
+    for(size_t i = 0; i < count; ++i)
+    {
+        mdv_objid const id = ids[i];
+
+        mdv_uuid node;
+
+        if (!mdv_idmap_global(idmap, id.node, &node))
+        {
+            MDV_LOGE("Storage identifier %u not found", id.node);
+            return false;
+        }
+
+        gids[i].node = node;
+        gids[i].id = id.id;
+    }
+
+    return true;
+}
+
+
+bool mdv_idmap_objids_local(mdv_idmap const *idmap, mdv_gobjid const *gids, size_t count, mdv_objid *ids)
+{
+    for(size_t i = 0; i < count; ++i)
+    {
+        mdv_uuid const uuid = gids[i].node;
+
+        uint32_t node;
+
+        if (!mdv_idmap_local(idmap, &uuid, &node))
+        {
+            char uuid_str[MDV_UUID_STR_LEN];
+            MDV_LOGE("Storage identifier %s not found", mdv_uuid_to_str(&uuid, uuid_str));
+            return false;
+        }
+
+        ids[i].node = node;
+        ids[i].id = gids[i].id;
+    }
+
+    return true;
+}
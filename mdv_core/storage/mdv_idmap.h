@@ -0,0 +1,141 @@
+/**
+ * @file mdv_idmap.h
+ * @author Vladislav Volkov (wwwvladislav@gmail.com)
+ * @brief Storage identifiers map
+ * @details Each node assigns own local identifiers to the cluster nodes storages (see mdv_tracker).
+ *          Local identifiers are used in rows identifiers, so they are translated to global
+ *          identifiers when rows identifiers are sent to other nodes.
+ * @version 0.1
+ * @date 2021-04-02
+ *
+ * @copyright Copyright (c) 2021, Vladislav Volkov
+ *
+ */
+#pragma once
+#include <mdv_def.h>
+#include <mdv_uuid.h>
+#include <mdv_objid.h>
+#include <mdv_topology.h>
+
+
+/// Storage identifier
+typedef struct
+{
+    mdv_uuid    uuid;           ///< Global unique storage identifier
+    uint32_t    id;             ///< Local unique storage identifier
+} mdv_storage_id;
+
+
+/// Node independent object identifier
+typedef struct __attribute__((packed))
+{
+    mdv_uuid    node;           ///< Global unique storage identifier
+    uint64_t    id;             ///< Object identifier
+} mdv_gobjid;
+
+
+/// Storage identifiers map
+typedef struct mdv_idmap mdv_idmap;
+
+
+/**
+ * @brief Creates storage identifiers map
+ *
+ * @param ids [in]      Storage identifiers
+ * @param count [in]    Storage identifiers count
+ *
+ * @return On success, returns non zero pointer to new identifiers map
+ * @return On error, return NULL pointer
+ */
+mdv_idmap * mdv_idmap_create(mdv_storage_id const *ids, size_t count);
+
+
+/**
+ * @brief Creates storage identifiers map for network topology nodes
+ *
+ * @param topology [in] Network topology
+ *
+ * @return On success, returns non zero pointer to new identifiers map
+ * @return On error, return NULL pointer
+ */
+mdv_idmap * mdv_idmap_create_by_topology(mdv_topology *topology);
+
+
+/**
+ * @brief Retains storage identifiers map.
+ * @details Reference counter is increased by one.
+ */
+mdv_idmap * mdv_idmap_retain(mdv_idmap *idmap);
+
+
+/**
+ * @brief Releases storage identifiers map.
+ * @details Reference counter is decreased by one.
+ *          When the reference counter reaches zero, the identifiers map is freed.
+ */
+uint32_t mdv_idmap_release(mdv_idmap *idmap);
+
+
+/**
+ * @brief Returns storage identifiers count
+ */
+size_t mdv_idmap_size(mdv_idmap const *idmap);
+
+
+/**
+ * @brief Returns storage identifiers
+ *
+ * @param idmap [in]    Storage identifiers map
+ * @param ids [out]     Buffer for storage identifiers (mdv_idmap_size() items)
+ */
+void mdv_idmap_ids(mdv_idmap const *idmap, mdv_storage_id *ids);
+
+
+/**
+ * @brief Finds local storage identifier by global one
+ *
+ * @param idmap [in]    Storage identifiers map
+ * @param uuid [in]     Global unique storage identifier
+ * @param id [out]      Local unique storage identifier
+ *
+ * @return true if identifier is found
+ */
+bool mdv_idmap_local(mdv_idmap const *idmap, mdv_uuid const *uuid, uint32_t *id);
+
+
+/**
+ * @brief Finds global storage identifier by local one
+ *
+ * @param idmap [in]    Storage identifiers map
+ * @param id [in]       Local unique storage identifier
+ * @param uuid [out]    Global unique storage identifier
+ *
+ * @return true if identifier is found
+ */
+bool mdv_idmap_global(mdv_idmap const *idmap, uint32_t id, mdv_uuid *uuid);
+
+
+/**
+ * @brief Translates object identifiers to node independent ones
+ *
+ * @param idmap [in]    Storage identifiers map
+ * @param ids [in]      Object identifiers
+ * @param count [in]    Object identifiers count
+ * @param gids [out]    Node independent object identifiers
+ *
+ * @return true if all storages are found
+ */
+bool mdv_idmap_objids_global(mdv_idmap const *idmap, mdv_objid const *ids, size_t count, mdv_gobjid *gids);
+
+
+/**
+ * @brief Translates node independent object identifiers to local ones
+ *
+ * @param idmap [in]    Storage identifiers map
+ * @param gids [in]     Node independent object identifiers
+ * @param count [in]    Object identifiers count
+ * @param ids [out]     Object identifiers
+ *
+ * @return true if all storages are found
+ */
+bool mdv_idmap_objids_local(mdv_idmap const *idmap, mdv_gobjid const *gids, size_t count, mdv_objid *ids);
@@ -0,0 +1,303 @@
+#include "mdv_placement.h"
+#include "mdv_rowdata.h"
+#include <mdv_router.h>
+#include <mdv_hashmap.h>
+#include <mdv_alloc.h>
+#include <mdv_hash.h>
+#include <mdv_index.h>
+#include <mdv_log.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+struct mdv_placement
+{
+    atomic_uint_fast32_t    rc;         ///< References counter
+    mdv_uuid                uuid;       ///< Current node UUID
+    uint32_t                replicas;   ///< Number of owners for each partition of new tables (zero if placement is disabled)
+    mdv_hashmap            *nexthops;   ///< Next hops for cluster nodes (hashmap<mdv_nexthop>)
+    uint32_t                neighbours_count;   ///< Directly connected nodes count
+    mdv_uuid               *neighbours; ///< Directly connected nodes
+    uint32_t                members_count;      ///< Cluster nodes count
+    mdv_uuid               *members;    ///< Cluster nodes (sorted)
+};
+
+
+/// Checks whether the node is directly connected to the current node
+bool mdv_placement_neighbour(mdv_placement const *placement, mdv_uuid const *node)
+{
+    mdv_nexthop const *hop = mdv_hashmap_find(placement->nexthops, node);
+    return hop && mdv_uuid_cmp(&hop->hop, node) == 0;
+}
+
+
+static bool mdv_placement_neighbours(mdv_placement *placement)
+{
+    placement->neighbours_count = 0;
+    placement->neighbours = mdv_alloc((mdv_hashmap_size(placement->nexthops) + 1) * sizeof(mdv_uuid));
+
+    if (!placement->neighbours)
+    {
+        MDV_LOGE("No memory for placement");
+        return false;
+    }
+
+    mdv_hashmap_foreach(placement->nexthops, mdv_nexthop, entry)
+    {
+        if (mdv_uuid_cmp(&entry->dst, &entry->hop) == 0
+            && mdv_uuid_cmp(&entry->dst, &placement->uuid) != 0)
+            placement->neighbours[placement->neighbours_count++] = entry->dst;
+    }
+
+    return true;
+}
+
+
+static int mdv_placement_member_cmp(void const *a, void const *b)
+{
+    return mdv_uuid_cmp(a, b);
+}
+
+
+static void mdv_placement_members(mdv_placement *placement, mdv_vector *toponodes)
+{
+    placement->members_count = 0;
+
+    mdv_vector_foreach(toponodes, mdv_toponode, node)
+        placement->members[placement->members_count++] = node->uuid;
+
+    qsort(placement->members, placement->members_count, sizeof(mdv_uuid), mdv_placement_member_cmp);
+}
+
+
+/// Member weight for the partition (rendezvous hashing)
+static uint32_t mdv_placement_weight(mdv_uuid const *member, uint32_t partition)
+{
+    return mdv_hash_murmur2a(member, sizeof *member, partition);
+}
+
+
+/**
+ * @brief Checks whether the table member stores the partition
+ * @details Partition is stored by the members with the highest weights. Ownership depends only on
+ *          the table members list, so it's the same on all cluster nodes and it isn't changed by topology changes.
+ */
+static bool mdv_placement_owner(mdv_table_desc const *desc, uint32_t member, uint32_t partition)
+{
+    uint32_t const weight = mdv_placement_weight(desc->members + member, partition);
+
+    uint32_t rank = 0;
+
+    for(uint32_t i = 0; i < desc->members_size && rank < desc->replicas; ++i)
+    {
+        if (i == member)
+            continue;
+
+        uint32_t const w = mdv_placement_weight(desc->members + i, partition);
+
+        if (w > weight
+            || (w == weight && mdv_uuid_cmp(desc->members + i, desc->members + member) < 0))
+            ++rank;
+    }
+
+    return rank < desc->replicas;
+}
+
+
+mdv_placement * mdv_placement_create(mdv_topology *topology, mdv_uuid const *uuid, uint32_t replicas)
+{
+    mdv_vector *toponodes = mdv_topology_nodes(topology);
+
+    size_t const count = mdv_vector_size(toponodes);
+
+    if (replicas >= count)
+        replicas = 0;
+
+    mdv_placement *placement = mdv_alloc(sizeof(mdv_placement) + count * sizeof(mdv_uuid));
+
+    if (!placement)
+    {
+        MDV_LOGE("No memory for placement");
+        mdv_vector_release(toponodes);
+        return 0;
+    }
+
+    atomic_init(&placement->rc, 1);
+
+    placement->uuid = *uuid;
+    placement->replicas = replicas;
+    placement->neighbours = 0;
+    placement->members = (mdv_uuid *)(placement + 1);
+    placement->nexthops = mdv_nexthops_find(topology, uuid);
+
+    if (!placement->nexthops
+        || !mdv_placement_neighbours(placement))
+    {
+        mdv_free(placement->neighbours);
+        mdv_hashmap_release(placement->nexthops);
+        mdv_free(placement);
+        mdv_vector_release(toponodes);
+        return 0;
+    }
+
+    mdv_placement_members(placement, toponodes);
+
+    mdv_vector_release(toponodes);
+
+    return placement;
+}
+
+
+mdv_placement * mdv_placement_retain(mdv_placement *placement)
+{
+    atomic_fetch_add_explicit(&placement->rc, 1, memory_order_acquire);
+    return placement;
+}
+
+
+uint32_t mdv_placement_release(mdv_placement *placement)
+{
+    uint32_t rc = 0;
+
+    if (placement)
+    {
+        rc = atomic_fetch_sub_explicit(&placement->rc, 1, memory_order_release) - 1;
+
+        if (!rc)
+        {
+            mdv_free(placement->neighbours);
+            mdv_hashmap_release(placement->nexthops);
+            mdv_free(placement);
+        }
+    }
+
+    return rc;
+}
+
+
+void mdv_placement_assign(mdv_placement const *placement, mdv_table_desc *desc)
+{
+    if (desc->partitioned && placement->replicas)
+    {
+        desc->replicas = placement->replicas;
+        desc->members_size = placement->members_count;
+        desc->members = placement->members;
+    }
+    else
+    {
+        desc->replicas = 0;
+        desc->members_size = 0;
+        desc->members = 0;
+    }
+}
+
+
+bool mdv_placement_enabled(mdv_table_desc const *desc)
+{
+    return desc->partitioned && desc->members_size;
+}
+
+
+uint32_t mdv_placement_partition(mdv_table_desc const *desc, binn *row)
+{
+    uint8_t key[MDV_INDEX_KEY_MAX];
+
+    size_t const key_size = mdv_rowdata_field_key(desc, desc->partition_key, row, key);
+
+    return mdv_hash_murmur2a(key, key_size, 0) % MDV_PARTITIONS;
+}
+
+
+uint32_t mdv_placement_row_partition(mdv_objid const *id)
+{
+    // Node identifiers are local for each cluster node, so only the object identifier is hashed
+    uint64_t const obj_id = id->id;
+    return mdv_hash_murmur2a(&obj_id, sizeof obj_id, 0) % MDV_PARTITIONS;
+}
+
+
+bool mdv_placement_owns(mdv_placement const *placement, mdv_table_desc const *desc, uint32_t partition)
+{
+    if (!mdv_placement_enabled(desc))
+        return true;
+
+    partition %= MDV_PARTITIONS;
+
+    for(uint32_t i = 0; i < desc->members_size; ++i)
+    {
+        if (mdv_uuid_cmp(desc->members + i, &placement->uuid) == 0)
+            return mdv_placement_owner(desc, i, partition);
+    }
+
+    return false;
+}
+
+
+bool mdv_placement_reachable(mdv_placement const *placement, mdv_table_desc const *desc, uint32_t partition, mdv_uuid const *peer)
+{
+    if (!mdv_placement_enabled(desc))
+        return true;
+
+    partition %= MDV_PARTITIONS;
+
+    for(uint32_t i = 0; i < desc->members_size; ++i)
+    {
+        if (!mdv_placement_owner(desc, i, partition))
+            continue;
+
+        if (mdv_uuid_cmp(desc->members + i, peer) == 0)
+            return true;
+
+        mdv_nexthop const *hop = mdv_hashmap_find(placement->nexthops, desc->members + i);
+
+        if (hop && mdv_uuid_cmp(&hop->hop, peer) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+
+mdv_uuid const * mdv_placement_reader(mdv_placement const *placement, mdv_table_desc const *desc, uint32_t partition)
+{
+    if (mdv_placement_owns(placement, desc, partition))
+        return &placement->uuid;
+
+    partition %= MDV_PARTITIONS;
+
+    mdv_uuid const *reader = 0;
+
+    // Rows are requested through the peers, so directly connected owners are preferred.
+    // Otherwise the owner which is reachable from the current node is chosen.
+    for(uint32_t i = 0; i < desc->members_size; ++i)
+    {
+        mdv_uuid const *member = desc->members + i;
+
+        if (!mdv_placement_owner(desc, i, partition))
+            continue;
+
+        if (mdv_placement_neighbour(placement, member))
+            return member;
+
+        if (!reader || (!mdv_hashmap_find(placement->nexthops, reader)
+                        && mdv_hashmap_find(placement->nexthops, member)))
+            reader = member;
+    }
+
+    return reader ? reader : &placement->uuid;
+}
+
+
+mdv_uuid const * mdv_placement_scanner(mdv_placement const *placement, uint32_t partition, uint32_t scanners)
+{
+    uint32_t const count = scanners < placement->neighbours_count + 1
+                            ? scanners
+                            : placement->neighbours_count + 1;
+
+    uint32_t const idx = count > 1
+                            ? partition % count
+                            : 0;
+
+    return idx ? placement->neighbours + idx - 1 : &placement->uuid;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file mdv_placement.h
+ * @author Vladislav Volkov (wwwvladislav@gmail.com)
+ * @brief Partitioned tables rows placement between cluster nodes
+ * @details Rows of the partitioned table are divided into MDV_PARTITIONS partitions by the partition key hash.
+ *          Cluster nodes which store the table partitions (table members) are fixed in the table descriptor
+ *          on the table creation. Each partition is stored by the members chosen by rendezvous hashing.
+ *          Partitions aren't rebalanced, so the new cluster nodes don't store partitions of existing tables.
+ *          Placement is rebuilt on each topology change, but only the routes to the owners are changed.
+ * @version 0.1
+ * @date 2020-05-25
+ *
+ * @copyright Copyright (c) 2020, Vladislav Volkov
+ *
+ */
+#pragma once
+#include <mdv_def.h>
+#include <mdv_uuid.h>
+#include <mdv_binn.h>
+#include <mdv_table.h>
+#include <mdv_objid.h>
+#include <mdv_topology.h>
+
+
+enum
+{
+    MDV_PARTITIONS = 256        ///< Number of partitions for each partitioned table
+};
+
+
+/// Partitioned tables rows placement
+typedef struct mdv_placement mdv_placement;
+
+
+/**
+ * @brief Creates rows placement for network topology
+ * @details Placement is disabled for new tables if replicas count is zero or not less than the cluster nodes count.
+ *          In this case all nodes store all partitions of the tables.
+ *
+ * @param topology [in] Network topology
+ * @param uuid [in]     Current node UUID
+ * @param replicas [in] Number of nodes which store each partition
+ *
+ * @return On success, returns non zero pointer to new placement
+ * @return On error, return NULL pointer
+ */
+mdv_placement * mdv_placement_create(mdv_topology *topology, mdv_uuid const *uuid, uint32_t replicas);
+
+
+/**
+ * @brief Retains rows placement.
+ * @details Reference counter is increased by one.
+ */
+mdv_placement * mdv_placement_retain(mdv_placement *placement);
+
+
+/**
+ * @brief Releases rows placement.
+ * @details Reference counter is decreased by one.
+ *          When the reference counter reaches zero, the placement is freed.
+ */
+uint32_t mdv_placement_release(mdv_placement *placement);
+
+
+/**
+ * @brief Fixes the table members for the new partitioned table
+ * @details Members list points to the placement memory. So the placement should be retained until the table is created.
+ *
+ * @param placement [in]    Rows placement
+ * @param desc [in] [out]   New table descriptor
+ */
+void mdv_placement_assign(mdv_placement const *placement, mdv_table_desc *desc);
+
+
+/**
+ * @brief Checks whether the table rows are distributed between cluster nodes
+ */
+bool mdv_placement_enabled(mdv_table_desc const *desc);
+
+
+/**
+ * @brief Calculates the row partition number
+ *
+ * @param desc [in]     Partitioned table descriptor
+ * @param row [in]      Serialized row
+ *
+ * @return partition number (less than MDV_PARTITIONS)
+ */
+uint32_t mdv_placement_partition(mdv_table_desc const *desc, binn *row);
+
+
+/**
+ * @brief Calculates the row partition number by the row identifier
+ * @details Such partitions are used for splitting the rows scan between replicas of the table
+ *          which isn't distributed between cluster nodes. Partition number is the same on all replicas.
+ *
+ * @param id [in]       Row identifier
+ *
+ * @return partition number (less than MDV_PARTITIONS)
+ */
+uint32_t mdv_placement_row_partition(mdv_objid const *id);
+
+
+/**
+ * @brief Checks whether the current node stores the table partition
+ */
+bool mdv_placement_owns(mdv_placement const *placement, mdv_table_desc const *desc, uint32_t partition);
+
+
+/**
+ * @brief Checks whether the partition should be sent to the neighbour node
+ * @details Partition is sent if the neighbour or any node behind it stores the partition.
+ *
+ * @param placement [in]    Rows placement
+ * @param desc [in]         Table descriptor
+ * @param partition [in]    Partition number
+ * @param peer [in]         Neighbour node UUID
+ */
+bool mdv_placement_reachable(mdv_placement const *placement, mdv_table_desc const *desc, uint32_t partition, mdv_uuid const *peer);
+
+
+/**
+ * @brief Checks whether the node is directly connected to the current node
+ */
+bool mdv_placement_neighbour(mdv_placement const *placement, mdv_uuid const *node);
+
+
+/**
+ * @brief Returns the node which is preferred for the table partition reading
+ * @details Current node is preferred if it stores the partition. Otherwise directly connected owners are preferred.
+ */
+mdv_uuid const * mdv_placement_reader(mdv_placement const *placement, mdv_table_desc const *desc, uint32_t partition);
+
+
+/**
+ * @brief Returns the node which scans the partition when all nodes store all rows
+ * @details Partitions are distributed between the current node and directly connected nodes.
+ *
+ * @param placement [in]    Rows placement
+ * @param partition [in]    Partition number
+ * @param scanners [in]     Maximum number of nodes which scan the rows (including the current node)
+ */
+mdv_uuid const * mdv_placement_scanner(mdv_placement const *placement, uint32_t partition, uint32_t scanners);
@@ -0,0 +1,274 @@
+#include "mdv_remote_delete.h"
+#include "../mdv_config.h"
+#include "../event/mdv_evt_types.h"
+#include "../event/mdv_evt_rowdata.h"
+#include <mdv_alloc.h>
+#include <mdv_log.h>
+#include <mdv_mutex.h>
+#include <mdv_condvar.h>
+#include <mdv_vector.h>
+#include <mdv_time.h>
+#include <stdatomic.h>
+#include <string.h>
+
+
+enum
+{
+    MDV_REMOTE_DELETE_WAIT = 10     ///< Maximum interval between the response checks (in milliseconds)
+};
+
+
+struct mdv_remote_delete
+{
+    mdv_ebus       *ebus;           ///< Events bus
+    mdv_uuid        uuid;           ///< Current node UUID
+    uint32_t        id;             ///< Deletion request identifier
+    mdv_uuid        table;          ///< Table identifier
+    char           *filter;         ///< Predicate for rows filtering
+    mdv_mutex       mutex;          ///< Mutex for responses guard
+    mdv_condvar     cv;             ///< Response notification
+    mdv_vector     *owners;         ///< Partitions owners which received the request (vector<mdv_remote_delete_owner>)
+};
+
+
+/// Partitions owner which received the request
+typedef struct
+{
+    mdv_uuid        uuid;           ///< Owner UUID
+    bool            ready;          ///< Flag indicates that the response is received
+    mdv_errno       err;            ///< Rows deletion result
+} mdv_remote_delete_owner;
+
+
+static atomic_uint_fast32_t mdv_remote_delete_idgen = 0;
+
+
+static mdv_errno mdv_remote_delete_evt_status(void *arg, mdv_event *event)
+{
+    mdv_remote_delete *del = arg;
+    mdv_evt_rowdata_del_status *status = (mdv_evt_rowdata_del_status *)event;
+
+    if (status->id != del->id
+        || mdv_uuid_cmp(&status->to, &del->uuid) != 0)
+        return MDV_OK;
+
+    mdv_errno err = mdv_mutex_lock(&del->mutex);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Mutex lock failed");
+        return err;
+    }
+
+    mdv_vector_foreach(del->owners, mdv_remote_delete_owner, owner)
+    {
+        if (mdv_uuid_cmp(&owner->uuid, &status->from) == 0)
+        {
+            owner->ready = true;
+            owner->err = status->err;
+            break;
+        }
+    }
+
+    mdv_mutex_unlock(&del->mutex);
+
+    mdv_condvar_signal(&del->cv);
+
+    return MDV_OK;
+}
+
+
+mdv_remote_delete * mdv_remote_delete_create(mdv_ebus          *ebus,
+                                             mdv_uuid const    *uuid,
+                                             mdv_uuid const    *table,
+                                             char const        *filter)
+{
+    size_t const filter_len = strlen(filter);
+
+    mdv_remote_delete *del = mdv_alloc(sizeof(mdv_remote_delete) + filter_len + 1);
+
+    if (!del)
+    {
+        MDV_LOGE("No memory for remote rows deletion");
+        return 0;
+    }
+
+    del->owners = mdv_vector_create(4, sizeof(mdv_remote_delete_owner), &mdv_default_allocator);
+
+    if (!del->owners)
+    {
+        MDV_LOGE("No memory for remote rows deletion");
+        mdv_free(del);
+        return 0;
+    }
+
+    if (mdv_mutex_create(&del->mutex) != MDV_OK)
+    {
+        MDV_LOGE("Remote rows deletion creation failed");
+        mdv_vector_release(del->owners);
+        mdv_free(del);
+        return 0;
+    }
+
+    if (mdv_condvar_create(&del->cv) != MDV_OK)
+    {
+        MDV_LOGE("Remote rows deletion creation failed");
+        mdv_mutex_free(&del->mutex);
+        mdv_vector_release(del->owners);
+        mdv_free(del);
+        return 0;
+    }
+
+    del->ebus = mdv_ebus_retain(ebus);
+    del->uuid = *uuid;
+    del->id = atomic_fetch_add_explicit(&mdv_remote_delete_idgen, 1, memory_order_relaxed);
+    del->table = *table;
+    del->filter = (char *)(del + 1);
+
+    memcpy(del->filter, filter, filter_len + 1);
+
+    if (mdv_ebus_subscribe(ebus, MDV_EVT_ROWDATA_DELETE_STATUS, del, mdv_remote_delete_evt_status) != MDV_OK)
+    {
+        MDV_LOGE("Remote rows deletion subscription failed");
+        mdv_ebus_release(del->ebus);
+        mdv_condvar_free(&del->cv);
+        mdv_mutex_free(&del->mutex);
+        mdv_vector_release(del->owners);
+        mdv_free(del);
+        return 0;
+    }
+
+    return del;
+}
+
+
+void mdv_remote_delete_free(mdv_remote_delete *del)
+{
+    if (!del)
+        return;
+
+    mdv_ebus_unsubscribe(del->ebus, MDV_EVT_ROWDATA_DELETE_STATUS, del, mdv_remote_delete_evt_status);
+    mdv_ebus_release(del->ebus);
+    mdv_condvar_free(&del->cv);
+    mdv_mutex_free(&del->mutex);
+    mdv_vector_release(del->owners);
+    mdv_free(del);
+}
+
+
+mdv_errno mdv_remote_delete_send(mdv_remote_delete *del, mdv_uuid const *owner, mdv_bitset *partitions)
+{
+    mdv_remote_delete_owner const new_owner =
+    {
+        .uuid = *owner,
+        .ready = false,
+        .err = MDV_OK
+    };
+
+    // Owner is registered before the request because the response may come before the event processing is finished
+    mdv_errno err = mdv_mutex_lock(&del->mutex);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Mutex lock failed");
+        return err;
+    }
+
+    bool const registered = mdv_vector_push_back(del->owners, &new_owner) != 0;
+
+    mdv_mutex_unlock(&del->mutex);
+
+    if (!registered)
+    {
+        MDV_LOGE("No memory for partitions owner");
+        return MDV_NO_MEM;
+    }
+
+    mdv_evt_rowdata_del_remote *evt = mdv_evt_rowdata_del_remote_create(&del->uuid,
+                                                                       owner,
+                                                                       del->id,
+                                                                       &del->table,
+                                                                       partitions,
+                                                                       del->filter);
+
+    if (!evt)
+    {
+        MDV_LOGE("No memory for rows deletion request");
+        err = MDV_NO_MEM;
+    }
+    else
+    {
+        err = mdv_ebus_publish(del->ebus, &evt->base, MDV_EVT_SYNC);
+
+        if (err == MDV_OK && !evt->sent)
+        {
+            char uuid_str[MDV_UUID_STR_LEN];
+            MDV_LOGE("Partitions owner '%s' is unreachable", mdv_uuid_to_str(owner, uuid_str));
+            err = MDV_EAGAIN;
+        }
+
+        mdv_evt_rowdata_del_remote_release(evt);
+    }
+
+    // Response isn't expected from the owner which didn't receive the request
+    if (err != MDV_OK && mdv_mutex_lock(&del->mutex) == MDV_OK)
+    {
+        mdv_vector_resize(del->owners, mdv_vector_size(del->owners) - 1);
+        mdv_mutex_unlock(&del->mutex);
+    }
+
+    return err;
+}
+
+
+mdv_errno mdv_remote_delete_wait(mdv_remote_delete *del)
+{
+    size_t const deadline = mdv_gettime() + MDV_CONFIG.fetcher.remote_timeout;
+
+    for(;;)
+    {
+        if (mdv_mutex_lock(&del->mutex) != MDV_OK)
+        {
+            MDV_LOGE("Mutex lock failed");
+            return MDV_FAILED;
+        }
+
+        mdv_remote_delete_owner const *waiting = 0;
+        mdv_errno err = MDV_OK;
+
+        mdv_vector_foreach(del->owners, mdv_remote_delete_owner, owner)
+        {
+            if (!owner->ready)
+                waiting = owner;
+            else if (err == MDV_OK)
+                err = owner->err;
+        }
+
+        if (!waiting)
+        {
+            mdv_mutex_unlock(&del->mutex);
+
+            if (err != MDV_OK)
+            {
+                char err_msg[128];
+                MDV_LOGE("Remote rows deletion failed with error %d (%s)",
+                         err, mdv_strerror(err, err_msg, sizeof err_msg));
+            }
+
+            return err;
+        }
+
+        if (mdv_gettime() >= deadline)
+        {
+            char uuid_str[MDV_UUID_STR_LEN];
+            MDV_LOGE("Node '%s' doesn't respond", mdv_uuid_to_str(&waiting->uuid, uuid_str));
+            mdv_mutex_unlock(&del->mutex);
+            return MDV_ETIMEDOUT;
+        }
+
+        mdv_mutex_unlock(&del->mutex);
+
+        // Waiting interval is limited because the signal may come before waiting
+        mdv_condvar_timedwait(&del->cv, MDV_REMOTE_DELETE_WAIT);
+    }
+}
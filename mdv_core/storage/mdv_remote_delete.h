@@ -0,0 +1,71 @@
+/**
+ * @file mdv_remote_delete.h
+ * @author Vladislav Volkov (wwwvladislav@gmail.com)
+ * @brief Rows deletion from the partitions stored by other cluster nodes
+ * @details Rows deletion is requested from the partitions owners by MDV_EVT_ROWDATA_DELETE_REMOTE event.
+ *          Each owner deletes the rows of its partitions and responds with MDV_EVT_ROWDATA_DELETE_STATUS event.
+ * @version 0.1
+ * @date 2020-06-08
+ *
+ * @copyright Copyright (c) 2020, Vladislav Volkov
+ *
+ */
+#pragma once
+#include <mdv_def.h>
+#include <mdv_ebus.h>
+#include <mdv_uuid.h>
+#include <mdv_bitset.h>
+
+
+/// Rows deletion from the partitions stored by other cluster nodes
+typedef struct mdv_remote_delete mdv_remote_delete;
+
+
+/**
+ * @brief Creates new remote rows deletion
+ *
+ * @param ebus [in]         Events bus
+ * @param uuid [in]         Current node UUID
+ * @param table [in]        Table identifier
+ * @param filter [in]       Predicate for rows filtering
+ *
+ * @return On success, returns non zero pointer to new remote rows deletion
+ * @return On error, return NULL pointer
+ */
+mdv_remote_delete * mdv_remote_delete_create(mdv_ebus          *ebus,
+                                             mdv_uuid const    *uuid,
+                                             mdv_uuid const    *table,
+                                             char const        *filter);
+
+
+/**
+ * @brief Frees remote rows deletion
+ * @details Late responses of the owners are ignored.
+ */
+void mdv_remote_delete_free(mdv_remote_delete *del);
+
+
+/**
+ * @brief Sends the rows deletion request to the partitions owner
+ *
+ * @param del [in]          Remote rows deletion
+ * @param owner [in]        Directly connected node which stores the partitions
+ * @param partitions [in]   Partitions mask
+ *
+ * @return On success, return MDV_OK
+ * @return If the request isn't sent because the owner is disconnected or doesn't handle such requests, return MDV_EAGAIN
+ * @return On error, return nonzero error code
+ */
+mdv_errno mdv_remote_delete_send(mdv_remote_delete *del, mdv_uuid const *owner, mdv_bitset *partitions);
+
+
+/**
+ * @brief Waits the responses of all owners which received the requests
+ * @details If the owner doesn't respond during the configured timeout (fetcher.remote_timeout), MDV_ETIMEDOUT is returned.
+ *
+ * @param del [in]          Remote rows deletion
+ *
+ * @return On success, return MDV_OK
+ * @return On error, return the first owner error
+ */
+mdv_errno mdv_remote_delete_wait(mdv_remote_delete *del);
@@ -0,0 +1,472 @@
+#include "mdv_remote_view.h"
+#include "../mdv_config.h"
+#include "../event/mdv_evt_types.h"
+#include "../event/mdv_evt_view.h"
+#include <mdv_alloc.h>
+#include <mdv_log.h>
+#include <mdv_mutex.h>
+#include <mdv_condvar.h>
+#include <mdv_time.h>
+#include <stdatomic.h>
+#include <string.h>
+
+
+enum
+{
+    MDV_REMOTE_VIEW_WAIT = 10       ///< Maximum interval between the response checks (in milliseconds)
+};
+
+
+typedef struct
+{
+    mdv_view              base;             ///< Base type for view
+    atomic_uint_fast32_t  rc;               ///< References counter
+    mdv_ebus             *ebus;             ///< Events bus
+    mdv_uuid              uuid;             ///< Current node UUID
+    mdv_uuid              owner;            ///< Node which stores the partitions
+    uint32_t              id;               ///< Remote view identifier
+    mdv_table            *table;            ///< Table descriptor
+    mdv_table            *table_slice;      ///< Table descriptor slice
+    mdv_bitset           *fields;           ///< Fields mask
+    mdv_bitset           *partitions;       ///< Partitions mask
+    char                 *filter;           ///< Predicate for rows filtering
+    mdv_mutex             mutex;            ///< Mutex for rows reading guard
+    bool                  opened;           ///< Flag indicates that the view is opened on the owner node
+    bool                  eof;              ///< Flag indicates that rows are exhausted
+    uint32_t              view_id;          ///< View identifier on the owner node
+    mdv_mutex             response_mutex;   ///< Mutex for response guard
+    mdv_condvar           response_cv;      ///< Response notification
+    bool                  waiting;          ///< Flag indicates that the response is expected
+    bool                  ready;            ///< Flag indicates that the response is received
+    mdv_errno             err;              ///< Rows reading result
+    binn                  rows;             ///< Received rows
+} mdv_remote_view;
+
+
+static atomic_uint_fast32_t mdv_remote_view_idgen = 0;
+
+
+static mdv_errno mdv_remote_view_evt_rows(void *arg, mdv_event *event);
+
+
+static void mdv_remote_view_free(mdv_remote_view *view)
+{
+    mdv_ebus_unsubscribe(view->ebus, MDV_EVT_VIEW_ROWS, view, mdv_remote_view_evt_rows);
+
+    if (view->ready && view->err == MDV_OK)
+        binn_free(&view->rows);
+
+    mdv_condvar_free(&view->response_cv);
+    mdv_mutex_free(&view->response_mutex);
+    mdv_mutex_free(&view->mutex);
+    mdv_ebus_release(view->ebus);
+    mdv_table_release(view->table);
+    mdv_table_release(view->table_slice);
+    mdv_bitset_release(view->fields);
+    mdv_bitset_release(view->partitions);
+    mdv_free(view);
+}
+
+
+static mdv_view * mdv_remote_view_retain(mdv_view *base)
+{
+    mdv_remote_view *view = (mdv_remote_view *)base;
+    atomic_fetch_add_explicit(&view->rc, 1, memory_order_acquire);
+    return base;
+}
+
+
+static uint32_t mdv_remote_view_release(mdv_view *base)
+{
+    mdv_remote_view *view = (mdv_remote_view *)base;
+
+    uint32_t rc = 0;
+
+    if (view)
+    {
+        rc = atomic_fetch_sub_explicit(&view->rc, 1, memory_order_release) - 1;
+
+        if (!rc)
+            mdv_remote_view_free(view);
+    }
+
+    return rc;
+}
+
+
+static mdv_table * mdv_remote_view_desc(mdv_view *base)
+{
+    mdv_remote_view *view = (mdv_remote_view *)base;
+    return mdv_table_retain(view->table_slice);
+}
+
+
+/// Copies rows because the message which holds them is released after the event processing
+static bool mdv_remote_view_rows_copy(binn const *src, binn *dst)
+{
+    if (!binn_create_list(dst))
+        return false;
+
+    if (!src)
+        return true;
+
+    binn_iter iter = {};
+    binn row = {};
+
+    binn_list_foreach((void *)src, row)
+    {
+        if (!binn_list_add_list(dst, binn_ptr(&row)))
+        {
+            binn_free(dst);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static mdv_errno mdv_remote_view_evt_rows(void *arg, mdv_event *event)
+{
+    mdv_remote_view *view = arg;
+    mdv_evt_view_rows *rows = (mdv_evt_view_rows *)event;
+
+    if (rows->id != view->id
+        || mdv_uuid_cmp(&rows->to, &view->uuid) != 0
+        || mdv_uuid_cmp(&rows->from, &view->owner) != 0)
+        return MDV_OK;
+
+    mdv_errno err = mdv_mutex_lock(&view->response_mutex);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Mutex lock failed");
+        return err;
+    }
+
+    if (view->waiting && !view->ready)
+    {
+        view->view_id = rows->view_id;
+        view->err = rows->err;
+
+        if (view->err == MDV_OK
+            && !mdv_remote_view_rows_copy(rows->rows, &view->rows))
+        {
+            MDV_LOGE("No memory for remote rows");
+            view->err = MDV_NO_MEM;
+        }
+
+        view->ready = true;
+    }
+
+    mdv_mutex_unlock(&view->response_mutex);
+
+    mdv_condvar_signal(&view->response_cv);
+
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_remote_view_request(mdv_remote_view *view, size_t count, size_t bytes)
+{
+    mdv_errno err = MDV_NO_MEM;
+
+    if (!view->opened)
+    {
+        mdv_evt_view_open *open = mdv_evt_view_open_create(&view->uuid,
+                                                           &view->owner,
+                                                           view->id,
+                                                           mdv_table_uuid(view->table),
+                                                           view->fields,
+                                                           view->partitions,
+                                                           view->filter,
+                                                           (uint32_t)count,
+                                                           (uint32_t)bytes);
+        if (open)
+        {
+            err = mdv_ebus_publish(view->ebus, &open->base, MDV_EVT_SYNC);
+            mdv_evt_view_open_release(open);
+        }
+    }
+    else
+    {
+        mdv_evt_view_read *read = mdv_evt_view_read_create(&view->uuid,
+                                                           &view->owner,
+                                                           view->id,
+                                                           view->view_id,
+                                                           (uint32_t)count,
+                                                           (uint32_t)bytes);
+        if (read)
+        {
+            err = mdv_ebus_publish(view->ebus, &read->base, MDV_EVT_SYNC);
+            mdv_evt_view_read_release(read);
+        }
+    }
+
+    return err;
+}
+
+
+/// Waits the owner response
+static mdv_errno mdv_remote_view_response(mdv_remote_view *view, binn *rows)
+{
+    size_t const deadline = mdv_gettime() + MDV_CONFIG.fetcher.remote_timeout;
+
+    for(;;)
+    {
+        if (mdv_mutex_lock(&view->response_mutex) != MDV_OK)
+        {
+            MDV_LOGE("Mutex lock failed");
+            return MDV_FAILED;
+        }
+
+        if (view->ready)
+            break;
+
+        if (mdv_gettime() >= deadline)
+        {
+            // Late response can't be matched with the request, so the view isn't read anymore
+            view->waiting = false;
+            view->eof = true;
+            mdv_mutex_unlock(&view->response_mutex);
+
+            char uuid_str[MDV_UUID_STR_LEN];
+            MDV_LOGE("Node '%s' doesn't respond", mdv_uuid_to_str(&view->owner, uuid_str));
+
+            return MDV_ETIMEDOUT;
+        }
+
+        mdv_mutex_unlock(&view->response_mutex);
+
+        // Waiting interval is limited because the signal may come before waiting
+        mdv_condvar_timedwait(&view->response_cv, MDV_REMOTE_VIEW_WAIT);
+    }
+
+    mdv_errno err = view->err;
+
+    if (err == MDV_OK)
+    {
+        *rows = view->rows;
+        view->eof = binn_count(rows) == 0;
+    }
+    else
+        view->eof = true;
+
+    view->opened = true;
+    view->waiting = false;
+    view->ready = false;
+
+    mdv_mutex_unlock(&view->response_mutex);
+
+    if (err != MDV_OK)
+    {
+        char err_msg[128];
+        MDV_LOGE("Remote rows reading failed with error %d (%s)",
+                 err, mdv_strerror(err, err_msg, sizeof err_msg));
+        err = MDV_CLOSED;
+    }
+
+    return err;
+}
+
+
+/**
+ * @brief Sends the next rows batch request if there is no pending request
+ * @details Rows reading mutex should be locked.
+ */
+static mdv_errno mdv_remote_view_request_start(mdv_remote_view *view, size_t count, size_t bytes)
+{
+    if (view->eof)
+        return MDV_OK;
+
+    mdv_errno err = mdv_mutex_lock(&view->response_mutex);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Mutex lock failed");
+        return err;
+    }
+
+    bool const pending = view->waiting;
+
+    view->waiting = true;
+
+    mdv_mutex_unlock(&view->response_mutex);
+
+    if (pending)
+        return MDV_OK;
+
+    err = mdv_remote_view_request(view, count, bytes);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Remote rows request failed");
+
+        if (mdv_mutex_lock(&view->response_mutex) == MDV_OK)
+        {
+            view->waiting = false;
+            mdv_mutex_unlock(&view->response_mutex);
+        }
+    }
+
+    return err;
+}
+
+
+static mdv_errno mdv_remote_view_read(mdv_remote_view *view, size_t count, size_t bytes, binn *rows)
+{
+    if (view->eof)
+        return binn_create_list(rows) ? MDV_OK : MDV_NO_MEM;
+
+    mdv_errno err = mdv_remote_view_request_start(view, count, bytes);
+
+    if (err != MDV_OK)
+        return err;
+
+    err = mdv_remote_view_response(view, rows);
+
+    // Next batch is read by the owner while the current one is processed
+    if (err == MDV_OK)
+        mdv_remote_view_request_start(view, count, bytes);
+
+    return err;
+}
+
+
+static mdv_errno mdv_remote_view_fetch(mdv_view *base, size_t count, size_t bytes, binn *rows)
+{
+    mdv_remote_view *view = (mdv_remote_view *)base;
+
+    mdv_errno err = mdv_mutex_lock(&view->mutex);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Mutex lock failed");
+        return err;
+    }
+
+    err = mdv_remote_view_read(view, count, bytes, rows);
+
+    mdv_mutex_unlock(&view->mutex);
+
+    return err;
+}
+
+
+static void mdv_remote_view_prefetch(mdv_view *base, size_t count, size_t bytes)
+{
+    mdv_remote_view *view = (mdv_remote_view *)base;
+
+    if (mdv_mutex_lock(&view->mutex) != MDV_OK)
+    {
+        MDV_LOGE("Mutex lock failed");
+        return;
+    }
+
+    mdv_remote_view_request_start(view, count, bytes);
+
+    mdv_mutex_unlock(&view->mutex);
+}
+
+
+mdv_view * mdv_remote_view_create(mdv_ebus          *ebus,
+                                  mdv_uuid const    *uuid,
+                                  mdv_uuid const    *owner,
+                                  mdv_table         *table,
+                                  mdv_bitset        *fields,
+                                  mdv_bitset        *partitions,
+                                  char const        *filter)
+{
+    size_t const filter_len = strlen(filter);
+
+    mdv_remote_view *view = (mdv_remote_view *)mdv_alloc(sizeof(mdv_remote_view) + filter_len + 1);
+
+    if (!view)
+    {
+        MDV_LOGE("View creation failed. No memory.");
+        return 0;
+    }
+
+    static mdv_iview const vtbl =
+    {
+        .retain   = mdv_remote_view_retain,
+        .release  = mdv_remote_view_release,
+        .desc     = mdv_remote_view_desc,
+        .fetch    = mdv_remote_view_fetch,
+        .prefetch = mdv_remote_view_prefetch,
+    };
+
+    view->table_slice = mdv_table_slice(table, fields);
+
+    if (!view->table_slice)
+    {
+        MDV_LOGE("View creation failed.");
+        mdv_free(view);
+        return 0;
+    }
+
+    if (mdv_mutex_create(&view->mutex) != MDV_OK)
+    {
+        MDV_LOGE("View creation failed.");
+        mdv_table_release(view->table_slice);
+        mdv_free(view);
+        return 0;
+    }
+
+    if (mdv_mutex_create(&view->response_mutex) != MDV_OK)
+    {
+        MDV_LOGE("View creation failed.");
+        mdv_mutex_free(&view->mutex);
+        mdv_table_release(view->table_slice);
+        mdv_free(view);
+        return 0;
+    }
+
+    if (mdv_condvar_create(&view->response_cv) != MDV_OK)
+    {
+        MDV_LOGE("View creation failed.");
+        mdv_mutex_free(&view->response_mutex);
+        mdv_mutex_free(&view->mutex);
+        mdv_table_release(view->table_slice);
+        mdv_free(view);
+        return 0;
+    }
+
+    atomic_init(&view->rc, 1);
+
+    view->base.vptr = &vtbl;
+
+    view->ebus = mdv_ebus_retain(ebus);
+    view->uuid = *uuid;
+    view->owner = *owner;
+    view->id = atomic_fetch_add_explicit(&mdv_remote_view_idgen, 1, memory_order_relaxed);
+    view->table = mdv_table_retain(table);
+    view->fields = mdv_bitset_retain(fields);
+    view->partitions = mdv_bitset_retain(partitions);
+    view->filter = (char *)(view + 1);
+    view->opened = false;
+    view->eof = false;
+    view->view_id = 0;
+    view->waiting = false;
+    view->ready = false;
+    view->err = MDV_OK;
+
+    memcpy(view->filter, filter, filter_len + 1);
+
+    if (mdv_ebus_subscribe(ebus, MDV_EVT_VIEW_ROWS, view, mdv_remote_view_evt_rows) != MDV_OK)
+    {
+        MDV_LOGE("Remote view subscription failed");
+        mdv_ebus_release(view->ebus);
+        mdv_table_release(view->table);
+        mdv_bitset_release(view->fields);
+        mdv_bitset_release(view->partitions);
+        mdv_condvar_free(&view->response_cv);
+        mdv_mutex_free(&view->response_mutex);
+        mdv_mutex_free(&view->mutex);
+        mdv_table_release(view->table_slice);
+        mdv_free(view);
+        return 0;
+    }
+
+    return &view->base;
+}
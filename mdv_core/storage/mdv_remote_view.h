@@ -0,0 +1,44 @@
+/**
+ * @file mdv_remote_view.h
+ * @author Vladislav Volkov (wwwvladislav@gmail.com)
+ * @brief View implemention for rows stored by another cluster node
+ * @details Rows are requested from the partitions owner by MDV_EVT_VIEW_OPEN and MDV_EVT_VIEW_READ events.
+ *          The owner responds with MDV_EVT_VIEW_ROWS event.
+ *          Next rows batch is requested as soon as the previous one is received.
+ * @version 0.1
+ * @date 2020-05-27
+ *
+ * @copyright Copyright (c) 2020, Vladislav Volkov
+ *
+ */
+#pragma once
+#include "mdv_view.h"
+#include <mdv_ebus.h>
+#include <mdv_uuid.h>
+#include <mdv_bitset.h>
+
+
+/**
+ * @brief Creates new remote view
+ * @details The view is opened on the owner node by the first rows fetching.
+ *          If the owner doesn't respond during the configured timeout, the fetching returns MDV_ETIMEDOUT.
+ *          If the owner fails the rows reading, the fetching returns MDV_CLOSED.
+ *
+ * @param ebus [in]         Events bus
+ * @param uuid [in]         Current node UUID
+ * @param owner [in]        Node which stores the partitions
+ * @param table [in]        Table descriptor
+ * @param fields [in]       Fields mask
+ * @param partitions [in]   Partitions mask
+ * @param filter [in]       Predicate for rows filtering
+ *
+ * @return On success, returns non zero pointer to new view
+ * @return On error, return NULL pointer
+ */
+mdv_view * mdv_remote_view_create(mdv_ebus          *ebus,
+                                  mdv_uuid const    *uuid,
+                                  mdv_uuid const    *owner,
+                                  mdv_table         *table,
+                                  mdv_bitset        *fields,
+                                  mdv_bitset        *partitions,
+                                  char const        *filter);
@@ -1,23 +1,94 @@
 #include "mdv_rowdata.h"
 #include "mdv_2pset.h"
+#include "mdv_placement.h"
+#include "../mdv_node.h"
 #include <mdv_names.h>
 #include <mdv_rollbacker.h>
 #include <mdv_alloc.h>
 #include <mdv_log.h>
 #include <mdv_serialization.h>
+#include <mdv_index.h>
 #include <assert.h>
+#include <string.h>
 
 
 struct mdv_rowdata
 {
     mdv_2pset      *objects;    ///< DB objects storage
-    mdv_uuid        table;      ///< Table identifier
+    mdv_table      *table;      ///< Table descriptor
 };
 
 
-mdv_rowdata * mdv_rowdata_open(char const *dir, mdv_uuid const *table)
+/// Rowdata modifications batch
+struct mdv_rowdata_batch
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(2);
+    mdv_rowdata     *rowdata;   ///< Rowdata storage
+    mdv_2pset_batch *objects;   ///< DB objects modifications batch
+    mdv_uuid         trlog;     ///< Transaction log UUID
+    uint64_t         applied;   ///< Position of the first transaction log record which isn't applied to the table
+};
+
+
+size_t mdv_rowdata_field_key(mdv_table_desc const *desc, uint32_t field_idx, binn *row, uint8_t *key)
+{
+    mdv_field const *field = desc->fields + field_idx;
+    size_t const type_size = mdv_field_type_size(field->type);
+
+    size_t key_size = 0;
+
+    binn value;
+
+    if (binn_list_get_value(row, field_idx + 1, &value))
+    {
+        if (field->limit == 1)
+        {
+            uint64_t data = 0;
+
+            if (mdv_unbinn_field_value(&value, field->type, &data))
+                key_size = mdv_index_key(field->type, &data, type_size, key);
+        }
+        else if (type_size == 1)
+            key_size = mdv_index_key(field->type, binn_ptr(&value), binn_size(&value), key);
+        else
+        {
+            uint8_t items[MDV_INDEX_KEY_MAX];
+            uint32_t count = sizeof items / type_size;
+
+            if (mdv_unbinn_array(&value, field->type, items, &count))
+                key_size = mdv_index_key(field->type, items, count * type_size, key);
+        }
+    }
+    else
+        MDV_LOGE("Field wasn't found in row");
+
+    return key_size;
+}
+
+
+/// Secondary index key generator
+static size_t mdv_rowdata_index_key(void *arg, uint32_t index, mdv_data const *obj, uint8_t *key)
+{
+    mdv_table_desc const *desc = arg;
+
+    binn row;
+
+    if (!binn_load(obj->ptr, &row))
+    {
+        MDV_LOGE("Invalid serialized row");
+        return 0;
+    }
+
+    size_t const key_size = mdv_rowdata_field_key(desc, desc->indexes[index], &row, key);
+
+    binn_free(&row);
+
+    return key_size;
+}
+
+
+mdv_rowdata * mdv_rowdata_open(char const *dir, mdv_table *table)
+{
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
 
     mdv_rowdata *rowdata = mdv_alloc(sizeof(mdv_rowdata));
 
@@ -30,11 +101,24 @@ mdv_rowdata * mdv_rowdata_open(char const *dir, mdv_uuid const *table)
 
     mdv_rollbacker_push(rollbacker, mdv_free, rowdata);
 
-    rowdata->table = *table;
+    rowdata->table = mdv_table_retain(table);
+
+    mdv_rollbacker_push(rollbacker, mdv_table_release, rowdata->table);
+
+    mdv_table_desc const *desc = mdv_table_description(table);
+
+    mdv_2pset_indexes const indexes =
+    {
+        .count = desc->indexes_size,
+        .arg = (void*)desc,
+        .key = mdv_rowdata_index_key
+    };
 
     char storage_name[64];
 
-    rowdata->objects = mdv_2pset_open(dir, MDV_STRG_UUID(table, storage_name, sizeof storage_name));
+    rowdata->objects = mdv_2pset_open_indexed(dir,
+                                              MDV_STRG_UUID(mdv_table_uuid(table), storage_name, sizeof storage_name),
+                                              &indexes);
 
     if (!rowdata->objects)
     {
@@ -68,6 +152,7 @@ uint32_t mdv_rowdata_release(mdv_rowdata *rowdata)
 
     if (!rc)
     {
+        mdv_table_release(rowdata->table);
         mdv_free(rowdata);
     }
 
@@ -149,150 +234,839 @@ mdv_errno mdv_rowdata_add_raw_rowset(mdv_rowdata *rowdata, mdv_objid const *id,
 }
 
 
-static mdv_rowset * mdv_rowdata_slice_impl(mdv_enumerator       *enumerator,
-                                           mdv_table const      *table,
-                                           mdv_bitset const     *fields,
-                                           size_t                count,
-                                           mdv_objid            *rowid,
-                                           mdv_row_filter        filter,
-                                           void                 *arg)
+int mdv_rowdata_predicate_filter(void *arg, mdv_objid const *id, binn const *row)
+{
+    (void)id;
+
+    mdv_rowdata_predicate *ctx = arg;
+
+    mdv_errno err = mdv_predicate_eval(ctx->predicate, ctx->stack, row);
+
+    switch(err)
+    {
+        case MDV_OK:    return 1;
+        case MDV_FALSE: return 0;
+        default:
+            break;
+    }
+
+    char err_msg[128];
+    MDV_LOGE("Predicate evaluation failed with error %d (%s)",
+             err, mdv_strerror(err, err_msg, sizeof err_msg));
+
+    return -1;
+}
 
+
+int mdv_rowdata_partitions_filter(void *arg, mdv_objid const *id, binn const *row)
 {
-    mdv_rowset *rowset = 0;
+    mdv_rowdata_partitions_predicate *ctx = arg;
 
-    mdv_table_desc const *desc = mdv_table_description(table);
+    uint32_t const partition = ctx->desc->partitioned
+                                ? mdv_placement_partition(ctx->desc, (binn *)row)
+                                : mdv_placement_row_partition(id);
+
+    if (!mdv_bitset_test(ctx->partitions, partition))
+        return 0;
+
+    return mdv_rowdata_predicate_filter(&ctx->predicate, id, row);
+}
 
-    mdv_table *table_slice = mdv_table_slice(table, fields);
 
-    if (!table_slice)
+typedef struct
+{
+    mdv_objid const *ids;
+    size_t           count;
+} mdv_rowdata_ids_iterator;
+
+
+static bool mdv_rowdata_ids_next(void *arg, mdv_data *id)
+{
+    mdv_rowdata_ids_iterator *it = arg;
+
+    if (!it->count)
+        return false;
+
+    id->size = sizeof *it->ids;
+    id->ptr = (void*)it->ids;
+
+    ++it->ids;
+    --it->count;
+
+    return true;
+}
+
+
+mdv_errno mdv_rowdata_remove_raw(mdv_rowdata *rowdata, mdv_objid const *op, mdv_objid const *ids, size_t count)
+{
+    mdv_rowdata_ids_iterator it =
+    {
+        .ids = ids,
+        .count = count
+    };
+
+    mdv_data const tombstone = { sizeof *op, (void*)op };
+
+    mdv_errno err = mdv_2pset_remove_batch(rowdata->objects, &tombstone, &it, mdv_rowdata_ids_next);
+
+    if (err != MDV_OK)
     {
-        MDV_LOGE("Table slice failed");
+        char err_msg[128];
+        MDV_LOGE("Rows deletion failed with error %d (%s)",
+                err, mdv_strerror(err, err_msg, sizeof err_msg));
+    }
+
+    return err;
+}
+
+
+mdv_rowdata_batch * mdv_rowdata_batch_begin(mdv_rowdata *rowdata, mdv_uuid const *trlog)
+{
+    mdv_rowdata_batch *batch = mdv_alloc(sizeof(mdv_rowdata_batch));
+
+    if (!batch)
+    {
+        MDV_LOGE("No free space of memory for rowdata batch");
         return 0;
     }
 
-    if ((rowset = mdv_rowset_create(table_slice)))
+    batch->objects = mdv_2pset_batch_begin(rowdata->objects);
+
+    if (!batch->objects)
     {
-        for(size_t i = 0; i < count;)
+        mdv_free(batch);
+        return 0;
+    }
+
+    batch->rowdata = mdv_rowdata_retain(rowdata);
+    batch->trlog = *trlog;
+    batch->applied = 0;
+
+    mdv_data const key = { sizeof batch->trlog, &batch->trlog };
+    mdv_data value = { sizeof batch->applied, &batch->applied };
+
+    if (!mdv_2pset_batch_mark_get(batch->objects, &key, &value))
+        batch->applied = 0;
+
+    return batch;
+}
+
+
+mdv_errno mdv_rowdata_batch_add_rowset(mdv_rowdata_batch *batch, uint64_t pos, mdv_objid const *id, binn *rowset)
+{
+    if (pos < batch->applied)
+        return MDV_OK;
+
+    mdv_rowdata_batch_iterator it =
+    {
+        .rowid =
         {
-            mdv_kvdata const *entry = mdv_enumerator_current(enumerator);
+            .node = id->node,
+            .id = id->id
+        },
+        .id = id->id
+    };
 
-            binn binn_row;
+    binn_iter_init(&it.iter, rowset, BINN_LIST);
 
-            mdv_rowlist_entry *row = 0;
+    mdv_errno err = mdv_2pset_batch_add(batch->objects, &it, mdv_rowdata_batch_next);
 
-            if (binn_load(entry->value.ptr, &binn_row))
-            {
-                row = mdv_unbinn_row_slice(&binn_row, desc, fields);
+    if (err != MDV_OK)
+    {
+        char err_msg[128];
+        MDV_LOGE("Row insertion failed with error %d (%s)",
+                err, mdv_strerror(err, err_msg, sizeof err_msg));
+    }
 
-                binn_free(&binn_row);
+    return err;
+}
 
-                if(!row)
-                {
-                    MDV_LOGE("Invalid serialized row");
-                    break;
-                }
-            }
-            else
-            {
-                MDV_LOGE("Invalid serialized row");
-                break;
-            }
 
-            assert(entry->key.size == sizeof(mdv_objid));
+mdv_errno mdv_rowdata_batch_remove(mdv_rowdata_batch *batch, mdv_objid const *op, mdv_objid const *ids, size_t count)
+{
+    if (op->id < batch->applied)
+        return MDV_OK;
 
-            *rowid = *(mdv_objid const *)entry->key.ptr;
+    mdv_rowdata_ids_iterator it =
+    {
+        .ids = ids,
+        .count = count
+    };
 
-            int const fst = filter(arg, &row->data);
+    mdv_data const tombstone = { sizeof *op, (void*)op };
 
-            if (fst == 1)
-            {
-                mdv_rowset_emplace(rowset, row);
-                ++i;
-            }
-            else if (fst == 0)
-                mdv_free(row);
-            else
-            {
-                MDV_LOGE("Rowdata filter failed");
-                break;
-            }
+    mdv_errno err = mdv_2pset_batch_remove(batch->objects, &tombstone, &it, mdv_rowdata_ids_next);
 
-            if (mdv_enumerator_next(enumerator) != MDV_OK)
-                break;
-        }
+    if (err != MDV_OK)
+    {
+        char err_msg[128];
+        MDV_LOGE("Rows deletion failed with error %d (%s)",
+                err, mdv_strerror(err, err_msg, sizeof err_msg));
     }
 
-    mdv_table_release(table_slice);
+    return err;
+}
+
+
+uint64_t mdv_rowdata_batch_applied(mdv_rowdata_batch const *batch)
+{
+    return batch->applied;
+}
+
+
+mdv_errno mdv_rowdata_batch_commit(mdv_rowdata_batch *batch, uint64_t pos)
+{
+    mdv_data const key = { sizeof batch->trlog, &batch->trlog };
+    mdv_data const value = { sizeof pos, &pos };
+
+    mdv_errno err = mdv_2pset_batch_mark_set(batch->objects, &key, &value);
+
+    if (err == MDV_OK)
+        err = mdv_2pset_batch_commit(batch->objects);
+    else
+        mdv_2pset_batch_abort(batch->objects);
 
-    return rowset;
+    mdv_rowdata_release(batch->rowdata);
+    mdv_free(batch);
+
+    return err;
 }
 
 
-mdv_rowset * mdv_rowdata_slice_from_begin(mdv_rowdata           *rowdata,
-                                          mdv_table const       *table,
-                                          mdv_bitset const      *fields,
-                                          size_t                 count,
-                                          mdv_objid             *rowid,
-                                          mdv_row_filter         filter,
-                                          void                  *arg)
+void mdv_rowdata_batch_abort(mdv_rowdata_batch *batch)
+{
+    mdv_2pset_batch_abort(batch->objects);
+    mdv_rowdata_release(batch->rowdata);
+    mdv_free(batch);
+}
 
+
+typedef struct
 {
-    mdv_rowset *rowset = 0;
+    void *arg;
+    bool (*purgeable)(void *arg, mdv_objid const *op);
+} mdv_rowdata_purge_context;
+
 
+static bool mdv_rowdata_purgeable(void *arg, mdv_data const *tombstone)
+{
+    mdv_rowdata_purge_context *ctx = arg;
+
+    if (tombstone->size != sizeof(mdv_objid))
+        return false;
+
+    mdv_objid op;
+    memcpy(&op, tombstone->ptr, sizeof op);
+
+    return ctx->purgeable(ctx->arg, &op);
+}
+
+
+mdv_errno mdv_rowdata_purge(mdv_rowdata *rowdata, size_t limit, void *arg, bool (*purgeable)(void *arg, mdv_objid const *op), size_t *purged)
+{
+    mdv_rowdata_purge_context ctx =
+    {
+        .arg = arg,
+        .purgeable = purgeable
+    };
+
+    mdv_errno err = mdv_2pset_purge(rowdata->objects, limit, &ctx, mdv_rowdata_purgeable, purged);
+
+    if (err != MDV_OK)
+    {
+        char err_msg[128];
+        MDV_LOGE("Tombstones purging failed with error %d (%s)",
+                err, mdv_strerror(err, err_msg, sizeof err_msg));
+    }
+
+    return err;
+}
+
+
+void mdv_rowdata_compact(mdv_rowdata *rowdata)
+{
+    mdv_2pset_compact(rowdata->objects);
+}
+
+
+mdv_errno mdv_rowdata_copy(mdv_rowdata *rowdata, mdv_descriptor fd)
+{
+    return mdv_2pset_copy(rowdata->objects, fd);
+}
+
+
+typedef struct
+{
+    void     *arg;
+    bool    (*translate)(void *arg, mdv_objid *id);
+    mdv_objid id;           ///< Translated row identifier
+    mdv_objid op;           ///< Translated deletion operation position
+    uint64_t  idgen;        ///< Identifiers generator value required for local rows
+} mdv_rowdata_import_context;
+
+
+static bool mdv_rowdata_import_id(void *arg, mdv_data *id)
+{
+    mdv_rowdata_import_context *ctx = arg;
+
+    if (id->size != sizeof ctx->id)
+        return false;
+
+    memcpy(&ctx->id, id->ptr, sizeof ctx->id);
+
+    if (!ctx->translate(ctx->arg, &ctx->id))
+        return false;
+
+    // Rows inserted by current node are identified by the local identifiers generator
+    if (ctx->id.node == MDV_LOCAL_ID && ctx->id.id >= ctx->idgen)
+        ctx->idgen = ctx->id.id + 1;
+
+    id->ptr = &ctx->id;
+
+    return true;
+}
+
+
+static bool mdv_rowdata_import_tombstone(void *arg, mdv_data *tombstone)
+{
+    mdv_rowdata_import_context *ctx = arg;
+
+    if (tombstone->size != sizeof ctx->op)
+        return false;
+
+    memcpy(&ctx->op, tombstone->ptr, sizeof ctx->op);
+
+    if (!ctx->translate(ctx->arg, &ctx->op))
+        return false;
+
+    tombstone->ptr = &ctx->op;
+
+    return true;
+}
+
+
+static uint64_t mdv_rowdata_import_idgen(void *arg)
+{
+    mdv_rowdata_import_context *ctx = arg;
+    return ctx->idgen;
+}
+
+
+mdv_errno mdv_rowdata_import(mdv_rowdata *rowdata, char const *dir, char const *storage_name, void *arg, bool (*translate)(void *arg, mdv_objid *id))
+{
+    mdv_2pset *src = mdv_2pset_open(dir, storage_name);
+
+    if (!src)
+    {
+        MDV_LOGE("Rowdata storage '%s' wasn't opened", storage_name);
+        return MDV_FAILED;
+    }
+
+    mdv_rowdata_import_context ctx =
+    {
+        .arg = arg,
+        .translate = translate,
+        .idgen = 0
+    };
+
+    mdv_2pset_translator const translator =
+    {
+        .arg = &ctx,
+        .id = mdv_rowdata_import_id,
+        .tombstone = mdv_rowdata_import_tombstone,
+        .idgen = mdv_rowdata_import_idgen
+    };
+
+    mdv_errno err = mdv_2pset_import(rowdata->objects, src, &translator);
+
+    mdv_2pset_release(src);
+
+    if (err != MDV_OK)
+    {
+        char err_msg[128];
+        MDV_LOGE("Rowdata storage '%s' import failed with error %d (%s)",
+                storage_name, err, mdv_strerror(err, err_msg, sizeof err_msg));
+    }
+
+    return err;
+}
+
+
+mdv_errno mdv_rowdata_select_ids(mdv_rowdata *rowdata, mdv_vector *ids, mdv_rowdata_filter filter, void *arg)
+{
     mdv_enumerator *enumerator = mdv_2pset_enumerator(rowdata->objects);
 
-    if (enumerator)
+    if (!enumerator)
+        return MDV_OK;      // There are no rows
+
+    mdv_errno err = MDV_OK;
+
+    do
     {
-        rowset = mdv_rowdata_slice_impl(enumerator, table, fields, count, rowid, filter, arg);
-        mdv_enumerator_release(enumerator);
+        mdv_kvdata const *entry = mdv_enumerator_current(enumerator);
+
+        assert(entry->key.size == sizeof(mdv_objid));
+
+        binn binn_row;
+
+        if (!binn_load(entry->value.ptr, &binn_row))
+        {
+            MDV_LOGE("Invalid serialized row");
+            err = MDV_FAILED;
+            break;
+        }
+
+        int const fst = filter(arg, (mdv_objid const *)entry->key.ptr, &binn_row);
+
+        binn_free(&binn_row);
+
+        if (fst < 0)
+        {
+            MDV_LOGE("Rowdata filter failed");
+            err = MDV_FAILED;
+            break;
+        }
+
+        if (fst == 1 && !mdv_vector_push_back(ids, entry->key.ptr))
+        {
+            MDV_LOGE("No memory for rows identifiers");
+            err = MDV_NO_MEM;
+            break;
+        }
+    }
+    while(mdv_enumerator_next(enumerator) == MDV_OK);
+
+    mdv_enumerator_release(enumerator);
+
+    return err;
+}
+
+
+/// Checks all table fields are requested
+static bool mdv_rowdata_all_fields(mdv_table_desc const *desc, mdv_bitset const *fields)
+{
+    if (!fields)
+        return true;
+
+    for(uint32_t i = 0; i < desc->size; ++i)
+    {
+        if (!mdv_bitset_test(fields, i))
+            return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief Appends the requested fields of serialized row to the rows list
+ * @details Field values are copied as is without deserialization.
+ */
+static bool mdv_rowdata_row_project(binn *rows, binn *row, mdv_bitset const *fields)
+{
+    binn projection;
+
+    if (!binn_create_list(&projection))
+        return false;
+
+    binn_iter iter = {};
+    binn value = {};
+    size_t n = 0;
+    bool res = true;
+
+    binn_list_foreach(row, value)
+    {
+        if (mdv_bitset_test(fields, n++)
+            && !binn_list_add_value(&projection, &value))
+        {
+            res = false;
+            break;
+        }
+    }
+
+    res = res && binn_list_add_list(rows, &projection);
+
+    binn_free(&projection);
+
+    return res;
+}
+
+
+/**
+ * @brief Appends the serialized row to the rows list if the row is accepted by filter
+ * @details Row data points directly to the storage pages, which are valid while the read
+ *          transaction is alive. If all fields are requested, row is forwarded as is, without
+ *          deserialization and further serialization.
+ *
+ * @return 1 if row is appended
+ * @return 0 if row is skipped
+ * @return On error, returns negative value
+ */
+static int mdv_rowdata_row_read(binn                    *rows,
+                                mdv_table_desc const    *desc,
+                                mdv_bitset const        *fields,
+                                mdv_objid const         *id,
+                                mdv_data const          *data,
+                                mdv_rowdata_filter       filter,
+                                void                    *arg)
+{
+    binn binn_row;
+
+    if (!binn_load(data->ptr, &binn_row))
+    {
+        MDV_LOGE("Invalid serialized row");
+        return -1;
+    }
+
+    int const fst = filter(arg, id, &binn_row);
+
+    if (fst == 1)
+    {
+        bool const res = mdv_rowdata_all_fields(desc, fields)
+                            ? binn_list_add_list(rows, data->ptr)
+                            : mdv_rowdata_row_project(rows, &binn_row, fields);
+
+        binn_free(&binn_row);
+
+        if(!res)
+        {
+            MDV_LOGE("Row serialization failed");
+            return -1;
+        }
+
+        return 1;
+    }
+
+    binn_free(&binn_row);
+
+    if (fst != 0)
+    {
+        MDV_LOGE("Rowdata filter failed");
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief Checks whether the serialized rows size limit is reached
+ * @details Row size in the storage is used as an upper bound of its serialized projection.
+ *          At least one row is always read.
+ */
+static bool mdv_rowdata_rows_full(binn *rows, size_t bytes, mdv_data const *row)
+{
+    return binn_count(rows) > 0
+            && (size_t)binn_size(rows) + row->size > bytes;
+}
+
+
+/**
+ * @brief Reads rows starting from the current enumerator position
+ * @details After reading, enumerator points to the next unread row.
+ *
+ * @param eof [out] true if there are no more rows in the enumerator
+ */
+static mdv_errno mdv_rowdata_slice_impl(mdv_enumerator       *enumerator,
+                                        mdv_table const      *table,
+                                        mdv_bitset const     *fields,
+                                        size_t                count,
+                                        size_t                bytes,
+                                        mdv_objid            *rowid,
+                                        mdv_rowdata_filter    filter,
+                                        void                 *arg,
+                                        binn                 *rows,
+                                        bool                 *eof)
+
+{
+    mdv_table_desc const *desc = mdv_table_description(table);
+
+    if (!binn_create_list(rows))
+    {
+        MDV_LOGE("No memory for rows list");
+        return MDV_NO_MEM;
     }
 
-    return rowset;
+    *eof = false;
+
+    for(size_t i = 0; i < count;)
+    {
+        mdv_kvdata const *entry = mdv_enumerator_current(enumerator);
+
+        if (mdv_rowdata_rows_full(rows, bytes, &entry->value))
+            break;
+
+        assert(entry->key.size == sizeof(mdv_objid));
+
+        *rowid = *(mdv_objid const *)entry->key.ptr;
+
+        int const res = mdv_rowdata_row_read(rows, desc, fields, (mdv_objid const *)entry->key.ptr, &entry->value, filter, arg);
+
+        if (res < 0)
+        {
+            *eof = true;
+            break;
+        }
+
+        i += res;
+
+        if (mdv_enumerator_next(enumerator) != MDV_OK)
+        {
+            *eof = true;
+            break;
+        }
+    }
+
+    return MDV_OK;
 }
 
 
-mdv_rowset * mdv_rowdata_slice(mdv_rowdata          *rowdata,
-                               mdv_table const      *table,
-                               mdv_bitset const     *fields,
-                               size_t                count,
-                               mdv_objid            *rowid,
-                               mdv_row_filter        filter,
-                               void                 *arg)
+/**
+ * @brief Reads rows using the cursor
+ * @details If cursor is empty, the new one is created by open_fn. Cursor is released when rows are exhausted.
+ */
+static mdv_errno mdv_rowdata_cursor_slice(mdv_enumerator      **cursor,
+                                          mdv_enumerator      *(*open_fn)(mdv_rowdata *, mdv_objid const *),
+                                          mdv_rowdata          *rowdata,
+                                          mdv_table const      *table,
+                                          mdv_bitset const     *fields,
+                                          size_t                count,
+                                          size_t                bytes,
+                                          mdv_objid            *rowid,
+                                          mdv_rowdata_filter    filter,
+                                          void                 *arg,
+                                          binn                 *rows)
+{
+    mdv_enumerator *enumerator = *cursor;
+
+    if (!enumerator)
+        enumerator = open_fn(rowdata, rowid);
+
+    if (!enumerator)
+        return MDV_FAILED;
+
+    bool eof = true;
+
+    mdv_errno const err = mdv_rowdata_slice_impl(enumerator, table, fields, count, bytes, rowid, filter, arg, rows, &eof);
+
+    if (err != MDV_OK || eof)
+    {
+        mdv_enumerator_release(enumerator);
+        enumerator = 0;
+    }
+
+    *cursor = enumerator;
 
+    return err;
+}
+
+
+/// Opens rows enumerator positioned at the first row
+static mdv_enumerator * mdv_rowdata_enumerator_begin(mdv_rowdata *rowdata, mdv_objid const *rowid)
 {
-    mdv_rowset *rowset = 0;
+    (void)rowid;
+    return mdv_2pset_enumerator(rowdata->objects);
+}
+
 
+/// Opens rows enumerator positioned at the row next to the given one
+static mdv_enumerator * mdv_rowdata_enumerator_next(mdv_rowdata *rowdata, mdv_objid const *rowid)
+{
     mdv_data const key =
     {
         .size = sizeof *rowid,
-        .ptr = rowid
+        .ptr = (void *)rowid
     };
 
     mdv_enumerator *enumerator = mdv_2pset_enumerator_from(rowdata->objects, &key);
 
     if (enumerator)
     {
-        do
+        mdv_kvdata const *entry = mdv_enumerator_current(enumerator);
+
+        assert(entry->key.size == sizeof(mdv_objid));
+
+        mdv_objid const *current_rowid = (mdv_objid const *)entry->key.ptr;
+
+        if (current_rowid->node == rowid->node
+            && current_rowid->id == rowid->id
+            && mdv_enumerator_next(enumerator) != MDV_OK)
         {
-            mdv_kvdata const *entry = mdv_enumerator_current(enumerator);
+            mdv_enumerator_release(enumerator);
+            enumerator = 0;
+        }
+    }
+
+    return enumerator;
+}
+
+
+mdv_errno mdv_rowdata_slice_from_begin(mdv_rowdata           *rowdata,
+                                       mdv_table const       *table,
+                                       mdv_bitset const      *fields,
+                                       size_t                 count,
+                                       size_t                 bytes,
+                                       mdv_objid             *rowid,
+                                       mdv_rowdata_filter     filter,
+                                       void                  *arg,
+                                       mdv_enumerator       **cursor,
+                                       binn                  *rows)
+
+{
+    return mdv_rowdata_cursor_slice(cursor, mdv_rowdata_enumerator_begin,
+                                    rowdata, table, fields, count, bytes, rowid, filter, arg, rows);
+}
+
 
-            assert(entry->key.size == sizeof(mdv_objid));
+mdv_errno mdv_rowdata_slice(mdv_rowdata          *rowdata,
+                            mdv_table const      *table,
+                            mdv_bitset const     *fields,
+                            size_t                count,
+                            size_t                bytes,
+                            mdv_objid            *rowid,
+                            mdv_rowdata_filter    filter,
+                            void                 *arg,
+                            mdv_enumerator      **cursor,
+                            binn                 *rows)
+
+{
+    return mdv_rowdata_cursor_slice(cursor, mdv_rowdata_enumerator_next,
+                                    rowdata, table, fields, count, bytes, rowid, filter, arg, rows);
+}
+
+
+/// Checks the index entry key is in range
+static bool mdv_rowdata_index_key_in_range(mdv_rowdata_range const *range, mdv_data const *key)
+{
+    if (!range->to.size)
+        return true;
 
-            mdv_objid const *current_rowid = (mdv_objid const *)entry->key.ptr;
+    assert(key->size >= sizeof(mdv_objid));
 
-            if (current_rowid->node == rowid->node
-                && current_rowid->id == rowid->id)
+    return mdv_index_key_cmp(key->ptr,
+                             key->size - sizeof(mdv_objid),
+                             range->to.ptr,
+                             range->to.size) <= 0;
+}
+
+
+/// Opens secondary index entries enumerator positioned at the entry next to the given one
+static mdv_enumerator * mdv_rowdata_index_enumerator(mdv_rowdata                *rowdata,
+                                                     mdv_rowdata_range const    *range,
+                                                     mdv_data const             *pos)
+{
+    mdv_data const *start = pos->size ? pos
+                            : range->from.size ? &range->from
+                            : 0;
+
+    mdv_enumerator *enumerator = mdv_2pset_index_enumerator(rowdata->objects, range->index, start);
+
+    if (enumerator && pos->size)
+    {
+        mdv_kvdata const *entry = mdv_enumerator_current(enumerator);
+
+        if (mdv_index_key_cmp(entry->key.ptr, entry->key.size, pos->ptr, pos->size) == 0
+            && mdv_enumerator_next(enumerator) != MDV_OK)
+        {
+            mdv_enumerator_release(enumerator);
+            enumerator = 0;
+        }
+    }
+
+    return enumerator;
+}
+
+
+mdv_errno mdv_rowdata_index_slice(mdv_rowdata                *rowdata,
+                                  mdv_table const            *table,
+                                  mdv_bitset const           *fields,
+                                  size_t                      count,
+                                  size_t                      bytes,
+                                  mdv_rowdata_range const    *range,
+                                  mdv_data                   *pos,
+                                  mdv_rowdata_filter          filter,
+                                  void                       *arg,
+                                  mdv_enumerator            **cursor,
+                                  binn                       *rows)
+{
+    mdv_enumerator *enumerator = *cursor;
+
+    if (!enumerator)
+        enumerator = mdv_rowdata_index_enumerator(rowdata, range, pos);
+
+    if (!enumerator)
+        return MDV_FAILED;
+
+    mdv_errno err = MDV_FAILED;
+
+    bool eof = true;
+
+    do
+    {
+        mdv_kvdata const *entry = mdv_enumerator_current(enumerator);
+
+        if (!mdv_rowdata_index_key_in_range(range, &entry->key))
+            break;
+
+        mdv_table_desc const *desc = mdv_table_description(table);
+
+        if (!binn_create_list(rows))
+        {
+            MDV_LOGE("No memory for rows list");
+            err = MDV_NO_MEM;
+            break;
+        }
+
+        err = MDV_OK;
+        eof = false;
+
+        for(size_t i = 0; i < count;)
+        {
+            if (mdv_rowdata_rows_full(rows, bytes, &entry->value))
+                break;
+
+            assert(entry->key.size <= MDV_INDEX_KEY_MAX + sizeof(mdv_objid));
+
+            memcpy(pos->ptr, entry->key.ptr, entry->key.size);
+            pos->size = entry->key.size;
+
+            // Index entry key ends with the row identifier
+            mdv_objid const *id = (mdv_objid const *)((uint8_t const *)entry->key.ptr + entry->key.size - sizeof(mdv_objid));
+
+            int const res = mdv_rowdata_row_read(rows, desc, fields, id, &entry->value, filter, arg);
+
+            if (res < 0)
+            {
+                eof = true;
+                break;
+            }
+
+            i += res;
+
+            if (mdv_enumerator_next(enumerator) != MDV_OK)
             {
-                if (mdv_enumerator_next(enumerator) != MDV_OK)
-                    break;
+                eof = true;
+                break;
             }
 
-            rowset = mdv_rowdata_slice_impl(enumerator, table, fields, count, rowid, filter, arg);
+            entry = mdv_enumerator_current(enumerator);
+
+            if (!mdv_rowdata_index_key_in_range(range, &entry->key))
+            {
+                eof = true;
+                break;
+            }
         }
-        while(0);
+    }
+    while(0);
 
+    if (eof)
+    {
         mdv_enumerator_release(enumerator);
+        enumerator = 0;
     }
 
-    return rowset;
+    *cursor = enumerator;
+
+    return err;
 }
@@ -15,21 +15,101 @@
 #include <mdv_rowset.h>
 #include <mdv_bitset.h>
 #include <mdv_binn.h>
+#include <mdv_vector.h>
+#include <mdv_predicate.h>
 
 
 /// Rowdata storage
 typedef struct mdv_rowdata mdv_rowdata;
 
 
+/// Rowdata modifications batch which is written within one transaction
+typedef struct mdv_rowdata_batch mdv_rowdata_batch;
+
+
+/**
+ * @brief Serialized rows filter
+ * @details Filter is applied before row deserialization. So skipped rows are not allocated.
+ *
+ * @param arg [in]  Filter argument
+ * @param id [in]   Row identifier
+ * @param row [in]  Serialized row
+ *
+ * @return 1 if row is accepted
+ * @return 0 if row is skipped
+ * @return On error, returns negative value
+ */
+typedef int (*mdv_rowdata_filter)(void *arg, mdv_objid const *id, binn const *row);
+
+
+/// Predicate based rows filter context
+typedef struct
+{
+    mdv_predicate        *predicate;        ///< Predicate for rows filtering
+    mdv_stack_base       *stack;            ///< VM stack
+} mdv_rowdata_predicate;
+
+
+/**
+ * @brief Rows filter which evaluates the predicate (mdv_rowdata_predicate is used as argument)
+ */
+int mdv_rowdata_predicate_filter(void *arg, mdv_objid const *id, binn const *row);
+
+
+/// Partitions and predicate based rows filter context
+typedef struct
+{
+    mdv_rowdata_predicate   predicate;      ///< Predicate based rows filter context
+    mdv_table_desc const   *desc;           ///< Table descriptor
+    mdv_bitset const       *partitions;     ///< Partitions mask
+} mdv_rowdata_partitions_predicate;
+
+
+/**
+ * @brief Rows filter which skips the rows of foreign partitions before the predicate evaluation
+ *        (mdv_rowdata_partitions_predicate is used as argument)
+ * @details Partitioned table rows are divided by the partition key. Other tables rows are divided by the rows identifiers.
+ */
+int mdv_rowdata_partitions_filter(void *arg, mdv_objid const *id, binn const *row);
+
+
+/**
+ * @brief Secondary index keys range
+ * @details Range bounds are inclusive. Empty bound means the range is unbounded on this side.
+ */
+typedef struct
+{
+    uint32_t    index;      ///< Secondary index number
+    mdv_data    from;       ///< Lower bound (index key)
+    mdv_data    to;         ///< Upper bound (index key)
+} mdv_rowdata_range;
+
+
+/**
+ * @brief Generates the canonical binary key for row field value
+ * @details Key is the same as the secondary index key for this field.
+ *
+ * @param desc [in]         Table descriptor
+ * @param field_idx [in]    Field number
+ * @param row [in]          Serialized row
+ * @param key [out]         Buffer for key (MDV_INDEX_KEY_MAX bytes)
+ *
+ * @return key size or zero if field value is invalid
+ */
+size_t mdv_rowdata_field_key(mdv_table_desc const *desc, uint32_t field_idx, binn *row, uint8_t *key);
+
+
 /**
  * @brief Creates new or opens existing rowdata storage
  *
+ * @details Secondary indexes declared in table descriptor are maintained by rowdata storage.
+ *
  * @param dir [in]      directory for rowdata storage
- * @param table [in]    table identifier
+ * @param table [in]    table descriptor
  *
  * @return rowdata storage
  */
-mdv_rowdata * mdv_rowdata_open(char const *dir, mdv_uuid const *table);
+mdv_rowdata * mdv_rowdata_open(char const *dir, mdv_table *table);
 
 
 /**
@@ -92,27 +172,194 @@ mdv_errno mdv_rowdata_add_raw(mdv_rowdata *rowdata, mdv_objid const *id, mdv_dat
 mdv_errno mdv_rowdata_add_raw_rowset(mdv_rowdata *rowdata, mdv_objid const *id, binn *rowset);
 
 
+/**
+ * @brief Removes rows within one transaction
+ * @details Deletion operation position is stored in rows tombstones.
+ *
+ * @param rowdata [in] Rowdata storage
+ * @param op [in]      Deletion operation position (transaction log identifier and record identifier)
+ * @param ids [in]     Rows identifiers
+ * @param count [in]   Rows identifiers count
+ *
+ * @return On success, returns MDV_OK.
+ * @return On error, returns non zero value
+ */
+mdv_errno mdv_rowdata_remove_raw(mdv_rowdata *rowdata, mdv_objid const *op, mdv_objid const *ids, size_t count);
+
+
+/**
+ * @brief Starts new rowdata modifications batch
+ * @details All batch modifications are written within one transaction.
+ *          Batch holds the rowdata storage write transaction, so only one batch per storage can be opened at once.
+ *          Operations of the given transaction log which are already applied to the table are skipped by the batch.
+ *
+ * @param rowdata [in] Rowdata storage
+ * @param trlog [in]   Transaction log UUID
+ *
+ * @return On success, returns nonzero pointer to new batch
+ * @return On error, returns NULL pointer
+ */
+mdv_rowdata_batch * mdv_rowdata_batch_begin(mdv_rowdata *rowdata, mdv_uuid const *trlog);
+
+
+/**
+ * @brief Stores rows set within the batch transaction
+ * @details Rows set is skipped if the operation is already applied to the table.
+ *          On error the batch should be aborted.
+ *
+ * @param batch [in]   Rowdata batch
+ * @param pos [in]     Insertion operation position in transaction log
+ * @param id [in]      First row identifier
+ * @param row [in]     Serialized rows set
+ *
+ * @return On success, returns MDV_OK.
+ * @return On error, returns non zero value
+ */
+mdv_errno mdv_rowdata_batch_add_rowset(mdv_rowdata_batch *batch, uint64_t pos, mdv_objid const *id, binn *rowset);
+
+
+/**
+ * @brief Removes rows within the batch transaction
+ * @details Rows are kept if the operation is already applied to the table.
+ *          On error the batch should be aborted.
+ *
+ * @param batch [in]   Rowdata batch
+ * @param op [in]      Deletion operation position (transaction log identifier and record identifier)
+ * @param ids [in]     Rows identifiers
+ * @param count [in]   Rows identifiers count
+ *
+ * @return On success, returns MDV_OK.
+ * @return On error, returns non zero value
+ */
+mdv_errno mdv_rowdata_batch_remove(mdv_rowdata_batch *batch, mdv_objid const *op, mdv_objid const *ids, size_t count);
+
+
+/**
+ * @brief Returns the transaction log position applied to the rowdata storage
+ *
+ * @param batch [in]   Rowdata batch
+ *
+ * @return position of the first transaction log record which isn't applied yet
+ */
+uint64_t mdv_rowdata_batch_applied(mdv_rowdata_batch const *batch);
+
+
+/**
+ * @brief Commits the rowdata batch and frees it
+ * @details Applied transaction log position is stored within the batch transaction, so it's saved atomically with the rows.
+ *
+ * @param batch [in]   Rowdata batch
+ * @param pos [in]     Position of the first transaction log record which isn't applied yet
+ *
+ * @return On success, returns MDV_OK.
+ * @return On error, returns non zero value
+ */
+mdv_errno mdv_rowdata_batch_commit(mdv_rowdata_batch *batch, uint64_t pos);
+
+
+/**
+ * @brief Discards all batch modifications and frees the batch
+ */
+void mdv_rowdata_batch_abort(mdv_rowdata_batch *batch);
+
+
+/**
+ * @brief Purges tombstones of removed rows
+ *
+ * @param rowdata [in]   Rowdata storage
+ * @param limit [in]     Maximum number of purged tombstones
+ * @param arg [in]       Argument which is passed to purgeable()
+ * @param purgeable [in] Function returns true if the tombstone created by deletion operation can be purged
+ * @param purged [out]   Number of purged tombstones
+ *
+ * @return On success, returns MDV_OK.
+ * @return On error, returns non zero value
+ */
+mdv_errno mdv_rowdata_purge(mdv_rowdata *rowdata, size_t limit, void *arg, bool (*purgeable)(void *arg, mdv_objid const *op), size_t *purged);
+
+
+/**
+ * @brief Requests the rowdata storage file compaction.
+ * @details Storage file is compacted when the rowdata storage is closed.
+ */
+void mdv_rowdata_compact(mdv_rowdata *rowdata);
+
+
+/**
+ * @brief Writes the consistent rowdata storage copy to the file.
+ * @details The copy contains applied transaction logs positions, so it can be used
+ *          as a starting point for the transaction logs replication.
+ *
+ * @param rowdata [in]   Rowdata storage
+ * @param fd [in]        File descriptor opened for writing
+ *
+ * @return On success, returns MDV_OK.
+ * @return On error, returns non zero value
+ */
+mdv_errno mdv_rowdata_copy(mdv_rowdata *rowdata, mdv_descriptor fd);
+
+
+/**
+ * @brief Imports rows, tombstones and applied transaction logs positions from the rowdata storage copy.
+ * @details Rows identifiers and deletion operations positions contain the storage identifiers of
+ *          the copy owner, so they are translated by translate(). Secondary indexes are rebuilt.
+ *
+ * @param rowdata [in]      Rowdata storage
+ * @param dir [in]          Directory of the rowdata storage copy
+ * @param storage_name [in] Rowdata storage copy name
+ * @param arg [in]          Pointer which is provided as argument to translate()
+ * @param translate [in]    Function translates the storage identifier of the object identifier
+ *
+ * @return On success, returns MDV_OK.
+ * @return On error, returns non zero value
+ */
+mdv_errno mdv_rowdata_import(mdv_rowdata *rowdata, char const *dir, char const *storage_name, void *arg, bool (*translate)(void *arg, mdv_objid *id));
+
+
+/**
+ * @brief Selects identifiers of rows accepted by filter
+ *
+ * @param rowdata [in]  Rowdata storage
+ * @param ids [out]     Rows identifiers (vector<mdv_objid>)
+ * @param filter [in]   Predicate for rowdata filtering
+ * @param arg [in]      Argument which is passed to rowdata filtering predicate
+ *
+ * @return On success, returns MDV_OK.
+ * @return On error, returns non zero value
+ */
+mdv_errno mdv_rowdata_select_ids(mdv_rowdata *rowdata, mdv_vector *ids, mdv_rowdata_filter filter, void *arg);
+
+
 /**
  * @brief Rows subset reading
+ * @details Serialized rows are forwarded from the storage pages to the rows list without deserialization.
  *
  * @param rowdata [in]   Rowdata storage
  * @param table [in]     Table descriptor
  * @param fields [in]    Fields mask for reading
  * @param count [in]     Rows amount for reading
+ * @param bytes [in]     Serialized rows size limit. At least one row is read even if it exceeds the limit.
  * @param rowid [out]    Last row identifier (used to continue reading)
  * @param filter [in]    Predicate for rowdata filtering
  * @param arg [in]       Argument which is passed to rowdata filtering predicate
+ * @param cursor [in][out] Rows cursor. If cursor isn't empty, rows are read from its current position
+ *                        within the same storage snapshot. Otherwise new cursor is created.
+ *                        Cursor is released when rows are exhausted.
+ * @param rows [out]     Serialized rows list. Rows contain only fields specified by mask.
  *
- * @return On success, returns nonzero pointer to rows set
- * @return On error, returns zero pointer
+ * @return On success, returns MDV_OK and rows list should be freed by binn_free()
+ * @return On error, returns non zero value
  */
-mdv_rowset * mdv_rowdata_slice_from_begin(mdv_rowdata           *rowdata,
-                                          mdv_table const       *table,
-                                          mdv_bitset const      *fields,
-                                          size_t                 count,
-                                          mdv_objid             *rowid,
-                                          mdv_row_filter         filter,
-                                          void                  *arg);
+mdv_errno mdv_rowdata_slice_from_begin(mdv_rowdata           *rowdata,
+                                       mdv_table const       *table,
+                                       mdv_bitset const      *fields,
+                                       size_t                 count,
+                                       size_t                 bytes,
+                                       mdv_objid             *rowid,
+                                       mdv_rowdata_filter     filter,
+                                       void                  *arg,
+                                       mdv_enumerator       **cursor,
+                                       binn                  *rows);
 
 
 /**
@@ -122,18 +369,59 @@ mdv_rowset * mdv_rowdata_slice_from_begin(mdv_rowdata           *rowdata,
  * @param table [in]      Table descriptor
  * @param fields [in]     Fields mask for reading
  * @param count [in]      Rows amount for reading
+ * @param bytes [in]      Serialized rows size limit. At least one row is read even if it exceeds the limit.
  * @param rowid [in][out] Last row identifier (used to continue reading)
  * @param filter [in]     Predicate for rowdata filtering
  * @param arg [in]        Argument which is passed to rowdata filtering predicate
+ * @param cursor [in][out] Rows cursor. If cursor isn't empty, rows are read from its current position
+ *                        within the same storage snapshot. Otherwise new cursor is created.
+ *                        Cursor is released when rows are exhausted.
+ * @param rows [out]      Serialized rows list. Rows contain only fields specified by mask.
  *
- * @return On success, returns nonzero pointer to rows set
- * @return On error, returns zero pointer
+ * @return On success, returns MDV_OK and rows list should be freed by binn_free()
+ * @return On error, returns non zero value
  */
-mdv_rowset * mdv_rowdata_slice(mdv_rowdata          *rowdata,
-                               mdv_table const      *table,
-                               mdv_bitset const     *fields,
-                               size_t                count,
-                               mdv_objid            *rowid,
-                               mdv_row_filter        filter,
-                               void                 *arg);
+mdv_errno mdv_rowdata_slice(mdv_rowdata          *rowdata,
+                            mdv_table const      *table,
+                            mdv_bitset const     *fields,
+                            size_t                count,
+                            size_t                bytes,
+                            mdv_objid            *rowid,
+                            mdv_rowdata_filter    filter,
+                            void                 *arg,
+                            mdv_enumerator      **cursor,
+                            binn                 *rows);
+
 
+/**
+ * @brief Rows subset reading over secondary index
+ *
+ * @param rowdata [in]    Rowdata storage
+ * @param table [in]      Table descriptor
+ * @param fields [in]     Fields mask for reading
+ * @param count [in]      Rows amount for reading
+ * @param bytes [in]      Serialized rows size limit. At least one row is read even if it exceeds the limit.
+ * @param range [in]      Secondary index keys range
+ * @param pos [in][out]   Last index entry key (used to continue reading). Empty key means reading from range begin.
+ *                        Buffer size should be at least MDV_INDEX_KEY_MAX + sizeof(mdv_objid) bytes.
+ * @param filter [in]     Predicate for rowdata filtering
+ * @param arg [in]        Argument which is passed to rowdata filtering predicate
+ * @param cursor [in][out] Rows cursor. If cursor isn't empty, rows are read from its current position
+ *                        within the same storage snapshot. Otherwise new cursor is created.
+ *                        Cursor is released when rows are exhausted.
+ * @param rows [out]      Serialized rows list. Rows contain only fields specified by mask.
+ *
+ * @return On success, returns MDV_OK and rows list should be freed by binn_free()
+ * @return On error or if there are no more rows, returns non zero value
+ */
+mdv_errno mdv_rowdata_index_slice(mdv_rowdata                *rowdata,
+                                  mdv_table const            *table,
+                                  mdv_bitset const           *fields,
+                                  size_t                      count,
+                                  size_t                      bytes,
+                                  mdv_rowdata_range const    *range,
+                                  mdv_data                   *pos,
+                                  mdv_rowdata_filter          filter,
+                                  void                       *arg,
+                                  mdv_enumerator            **cursor,
+                                  binn                       *rows);
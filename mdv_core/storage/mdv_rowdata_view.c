@@ -3,7 +3,12 @@
 #include <mdv_alloc.h>
 #include <mdv_log.h>
 #include <mdv_vm.h>
+#include <mdv_index.h>
+#include <mdv_mutex.h>
+#include <mdv_time.h>
 #include <stdatomic.h>
+#include <stddef.h>
+#include <string.h>
 
 
 // TODO: Get compiled expressions from cache
@@ -17,19 +22,32 @@ typedef struct
     mdv_table            *table;            ///< Table descriptor
     mdv_table            *table_slice;      ///< Table descriptor slice
     mdv_bitset           *fields;           ///< Fields mask
+    mdv_bitset           *partitions;       ///< Partitions mask (NULL if all partitions are read)
     mdv_predicate        *filter;           ///< Predicate for rows filtering
+    mdv_mutex             mutex;            ///< Mutex for rows reading guard
+    mdv_enumerator       *cursor;           ///< Rows cursor over the storage snapshot
+    size_t                cursor_time;      ///< Cursor creation time (in milliseconds)
     mdv_objid             rowid;            ///< Last read row identifier
     bool                  fetch_from_begin; ///< Flag indicates that data should be fetched from begin
+    bool                  indexed;          ///< Rows are read over secondary index
+    mdv_rowdata_range     range;            ///< Secondary index keys range
+    mdv_data              pos;              ///< Last read secondary index entry key
+    uint8_t               from[MDV_INDEX_KEY_MAX];                      ///< Lower bound buffer
+    uint8_t               to[MDV_INDEX_KEY_MAX];                        ///< Upper bound buffer
+    uint8_t               pos_buf[MDV_INDEX_KEY_MAX + sizeof(mdv_objid)];///< Last read index entry key buffer
 } mdv_rowdata_view;
 
 
 static void mdv_rowdata_view_free(mdv_rowdata_view *view)
 {
+    mdv_enumerator_release(view->cursor);
+    mdv_mutex_free(&view->mutex);
     mdv_predicate_release(view->filter);
     mdv_rowdata_release(view->source);
     mdv_table_release(view->table);
     mdv_table_release(view->table_slice);
     mdv_bitset_release(view->fields);
+    mdv_bitset_release(view->partitions);
     mdv_free(view);
 }
 
@@ -67,16 +85,49 @@ static mdv_table * mdv_rowdata_view_desc(mdv_view *base)
 }
 
 
-static int mdv_rowdata_view_filter(void *arg, mdv_row const *row_slice)
+static mdv_errno mdv_rowdata_view_read(mdv_rowdata_view *view, size_t count, size_t bytes, binn *rows)
 {
-    // TODO
-    return 1;
-}
+    // VM stack is allocated on the stack of fetcher worker thread
+    size_t vm_stack[(offsetof(mdv_stack_base, data) + MDV_CONFIG.fetcher.vm_stack) / sizeof(size_t) + 1];
 
+    mdv_stack_base *stack = (mdv_stack_base *)vm_stack;
+    stack->capacity = MDV_CONFIG.fetcher.vm_stack;
+    stack->size = 0;
 
-static mdv_rowset * mdv_rowdata_view_fetch(mdv_view *base, size_t count)
-{
-    mdv_rowdata_view *view = (mdv_rowdata_view *)base;
+    mdv_rowdata_partitions_predicate ctx =
+    {
+        .predicate =
+        {
+            .predicate = view->filter,
+            .stack = stack
+        },
+        .desc = mdv_table_description(view->table),
+        .partitions = view->partitions
+    };
+
+    mdv_rowdata_filter const filter = view->partitions
+                                        ? mdv_rowdata_partitions_filter
+                                        : mdv_rowdata_predicate_filter;
+
+    void *filter_arg = view->partitions
+                        ? (void *)&ctx
+                        : (void *)&ctx.predicate;
+
+    if (view->indexed)
+    {
+        return mdv_rowdata_index_slice(
+                    view->source,
+                    view->table,
+                    view->fields,
+                    count,
+                    bytes,
+                    &view->range,
+                    &view->pos,
+                    filter,
+                    filter_arg,
+                    &view->cursor,
+                    rows);
+    }
 
     if (view->fetch_from_begin)
     {
@@ -87,9 +138,12 @@ static mdv_rowset * mdv_rowdata_view_fetch(mdv_view *base, size_t count)
                     view->table,
                     view->fields,
                     count,
+                    bytes,
                     &view->rowid,
-                    mdv_rowdata_view_filter,
-                    view);
+                    filter,
+                    filter_arg,
+                    &view->cursor,
+                    rows);
     }
 
     return mdv_rowdata_slice(
@@ -97,16 +151,55 @@ static mdv_rowset * mdv_rowdata_view_fetch(mdv_view *base, size_t count)
                 view->table,
                 view->fields,
                 count,
+                bytes,
                 &view->rowid,
-                mdv_rowdata_view_filter,
-                view);
+                filter,
+                filter_arg,
+                &view->cursor,
+                rows);
 }
 
 
-mdv_view * mdv_rowdata_view_create(mdv_rowdata      *source,
-                                   mdv_table        *table,
-                                   mdv_bitset       *fields,
-                                   mdv_predicate    *predicate)
+static mdv_errno mdv_rowdata_view_fetch(mdv_view *base, size_t count, size_t bytes, binn *rows)
+{
+    mdv_rowdata_view *view = (mdv_rowdata_view *)base;
+
+    mdv_errno err = mdv_mutex_lock(&view->mutex);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Mutex lock failed");
+        return err;
+    }
+
+    size_t const now = mdv_gettime();
+
+    // Storage snapshot isn't held longer than inactive views lifetime.
+    // Expired cursor is reopened from the last read row.
+    if (view->cursor
+        && now - view->cursor_time > MDV_CONFIG.fetcher.views_lifetime * 1000u)
+    {
+        mdv_enumerator_release(view->cursor);
+        view->cursor = 0;
+    }
+
+    if (!view->cursor)
+        view->cursor_time = now;
+
+    err = mdv_rowdata_view_read(view, count, bytes, rows);
+
+    mdv_mutex_unlock(&view->mutex);
+
+    return err;
+}
+
+
+mdv_view * mdv_rowdata_view_create(mdv_rowdata              *source,
+                                   mdv_table                *table,
+                                   mdv_bitset               *fields,
+                                   mdv_bitset               *partitions,
+                                   mdv_predicate            *predicate,
+                                   mdv_rowdata_range const  *range)
 {
     mdv_rowdata_view *view = (mdv_rowdata_view *)mdv_alloc(sizeof(mdv_rowdata_view));
 
@@ -133,6 +226,14 @@ mdv_view * mdv_rowdata_view_create(mdv_rowdata      *source,
         return 0;
     }
 
+    if (mdv_mutex_create(&view->mutex) != MDV_OK)
+    {
+        MDV_LOGE("View creation failed.");
+        mdv_table_release(view->table_slice);
+        mdv_free(view);
+        return 0;
+    }
+
     atomic_init(&view->rc, 1);
 
     view->base.vptr = &vtbl;
@@ -141,7 +242,26 @@ mdv_view * mdv_rowdata_view_create(mdv_rowdata      *source,
     view->source = mdv_rowdata_retain(source);
     view->table  = mdv_table_retain(table);
     view->fields = mdv_bitset_retain(fields);
+    view->partitions = partitions ? mdv_bitset_retain(partitions) : 0;
+    view->cursor = 0;
+    view->cursor_time = 0;
     view->fetch_from_begin = true;
+    view->indexed = range != 0;
+
+    if (range)
+    {
+        view->range.index = range->index;
+        view->range.from.size = range->from.size;
+        view->range.from.ptr = view->from;
+        view->range.to.size = range->to.size;
+        view->range.to.ptr = view->to;
+
+        memcpy(view->from, range->from.ptr, range->from.size);
+        memcpy(view->to, range->to.ptr, range->to.size);
+    }
+
+    view->pos.size = 0;
+    view->pos.ptr = view->pos_buf;
 
     return &view->base;
 }
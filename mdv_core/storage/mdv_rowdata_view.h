@@ -16,8 +16,12 @@
 
 /**
  * @brief Creates new view
+ * @details If secondary index keys range is provided, rows are read over the secondary index.
+ *          If partitions mask is provided, only rows of these partitions are read.
  */
-mdv_view * mdv_rowdata_view_create(mdv_rowdata      *source,
-                                   mdv_table        *table,
-                                   mdv_bitset       *fields,
-                                   mdv_predicate    *predicate);
+mdv_view * mdv_rowdata_view_create(mdv_rowdata              *source,
+                                   mdv_table                *table,
+                                   mdv_bitset               *fields,
+                                   mdv_bitset               *partitions,
+                                   mdv_predicate            *predicate,
+                                   mdv_rowdata_range const  *range);
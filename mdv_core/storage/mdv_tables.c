@@ -148,6 +148,58 @@ mdv_table * mdv_tables_desc(mdv_tables *tables)
 }
 
 
+bool mdv_tables_empty(mdv_tables *tables)
+{
+    return mdv_2pset_empty(tables->objects);
+}
+
+
+mdv_vector * mdv_tables_all(mdv_tables *tables)
+{
+    mdv_vector *descs = mdv_vector_create(8, sizeof(mdv_table*), &mdv_default_allocator);
+
+    if (!descs)
+    {
+        MDV_LOGE("No memory for tables descriptors");
+        return 0;
+    }
+
+    if (mdv_2pset_empty(tables->objects))
+        return descs;
+
+    mdv_enumerator *enumerator = mdv_2pset_enumerator(tables->objects);
+
+    if (!enumerator)
+    {
+        mdv_vector_release(descs);
+        return 0;
+    }
+
+    do
+    {
+        mdv_kvdata const *entry = mdv_enumerator_current(enumerator);
+
+        mdv_table *table = mdv_table_restore(&entry->value);
+
+        if (!table || !mdv_vector_push_back(descs, &table))
+        {
+            MDV_LOGE("Table descriptor reading failed");
+            mdv_table_release(table);
+            mdv_vector_foreach(descs, mdv_table_ptr, desc)
+                mdv_table_release(*desc);
+            mdv_vector_release(descs);
+            descs = 0;
+            break;
+        }
+    }
+    while(mdv_enumerator_next(enumerator) == MDV_OK);
+
+    mdv_enumerator_release(enumerator);
+
+    return descs;
+}
+
+
 static mdv_rowset * mdv_tables_slice_impl(mdv_tables           *tables,
                                           mdv_enumerator       *enumerator,
                                           mdv_bitset const     *fields,
@@ -12,6 +12,7 @@
 #include <mdv_def.h>
 #include <mdv_table.h>
 #include <mdv_rowset.h>
+#include <mdv_vector.h>
 
 
 /// Tables storage
@@ -73,6 +74,24 @@ mdv_table * mdv_tables_get(mdv_tables *tables, mdv_uuid const *uuid);
 mdv_table * mdv_tables_desc(mdv_tables *tables);
 
 
+/**
+ * @brief Checks that there are no tables in storage
+ */
+bool mdv_tables_empty(mdv_tables *tables);
+
+
+/**
+ * @brief Reads all tables descriptors
+ *
+ * @param tables [in]    Tables storage
+ *
+ * @return On success, returns nonzero pointer to tables descriptors vector (vector<mdv_table*>).
+ *         Each descriptor should be released by mdv_table_release().
+ * @return On error, returns zero pointer
+ */
+mdv_vector * mdv_tables_all(mdv_tables *tables);
+
+
 /**
  * @brief Rows subset reading
  *
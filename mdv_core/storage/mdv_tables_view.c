@@ -3,6 +3,7 @@
 #include <mdv_alloc.h>
 #include <mdv_log.h>
 #include <mdv_vm.h>
+#include <mdv_serialization.h>
 #include <stdatomic.h>
 
 
@@ -72,15 +73,19 @@ static int mdv_tables_view_filter(void *arg, mdv_row const *row_slice)
 }
 
 
-static mdv_rowset * mdv_tables_view_fetch(mdv_view *base, size_t count)
+static mdv_errno mdv_tables_view_fetch(mdv_view *base, size_t count, size_t bytes, binn *rows)
 {
     mdv_tables_view *view = (mdv_tables_view *)base;
 
+    (void)bytes;    // Tables descriptions are small, so only rows count is limited
+
+    mdv_rowset *rowset = 0;
+
     if (view->fetch_from_begin)
     {
         view->fetch_from_begin = false;
 
-        return mdv_tables_slice_from_begin(
+        rowset = mdv_tables_slice_from_begin(
                     view->source,
                     view->fields,
                     count,
@@ -88,14 +93,26 @@ static mdv_rowset * mdv_tables_view_fetch(mdv_view *base, size_t count)
                     mdv_tables_view_filter,
                     view);
     }
+    else
+        rowset = mdv_tables_slice(
+                    view->source,
+                    view->fields,
+                    count,
+                    &view->rowid,
+                    mdv_tables_view_filter,
+                    view);
+
+    if (!rowset)
+        return MDV_FAILED;
+
+    mdv_errno const err = mdv_binn_rowset(rowset, rows) ? MDV_OK : MDV_FAILED;
+
+    if (err != MDV_OK)
+        MDV_LOGE("Rowset serialization failed");
+
+    mdv_rowset_release(rowset);
 
-    return mdv_tables_slice(
-                view->source,
-                view->fields,
-                count,
-                &view->rowid,
-                mdv_tables_view_filter,
-                view);
+    return err;
 }
 
 
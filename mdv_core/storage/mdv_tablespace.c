@@ -2,12 +2,16 @@
 #include "mdv_trlog.h"
 #include "mdv_tables.h"
 #include "mdv_rowdata.h"
+#include "mdv_placement.h"
+#include "mdv_idmap.h"
+#include "mdv_remote_delete.h"
 #include "../mdv_config.h"
 #include "../event/mdv_evt_table.h"
 #include "../event/mdv_evt_tables.h"
 #include "../event/mdv_evt_rowdata.h"
 #include "../event/mdv_evt_topology.h"
 #include "../event/mdv_evt_trlog.h"
+#include "../event/mdv_evt_snapshot.h"
 #include "../event/mdv_evt_types.h"
 #include <mdv_objid.h>
 #include <mdv_serialization.h>
@@ -16,7 +20,15 @@
 #include <mdv_hashmap.h>
 #include <mdv_mutex.h>
 #include <mdv_safeptr.h>
+#include <mdv_router.h>
 #include <mdv_systbls.h>
+#include <mdv_condvar.h>
+#include <mdv_jobber.h>
+#include <mdv_filesystem.h>
+#include <mdv_file.h>
+#include <mdv_names.h>
+#include <stdio.h>
+#include <string.h>
 
 
 /// DB tables space
@@ -29,18 +41,12 @@ struct mdv_tablespace
     mdv_hashmap *rowdata;       ///< Rowdata storages map (Table UUID -> mdv_rowdata)
     mdv_uuid     uuid;          ///< Current node UUID
     mdv_ebus    *ebus;          ///< Events bus
-    mdv_safeptr *storage_ids;   ///< Storage identifiers map (hashmap<mdv_storage_id>)
+    mdv_safeptr *storage_ids;   ///< Storage identifiers map (mdv_idmap)
+    mdv_safeptr *placement;     ///< Partitioned tables rows placement (mdv_placement)
+    mdv_safeptr *ackers;        ///< Nodes acknowledging transaction logs records (vector<mdv_nexthop>)
 };
 
 
-/// Stroage identifiers map
-typedef struct
-{
-    mdv_uuid    uuid;           ///< Global unique storage identifier
-    uint32_t    id;             ///< local unique storage identifier
-} mdv_storage_id;
-
-
 /// Transaction log storage reference
 typedef struct
 {
@@ -62,14 +68,24 @@ enum
 {
     MDV_OP_TABLE_CREATE = 0,    ///< Create table
     MDV_OP_TABLE_DROP,          ///< Drop table
-    MDV_OP_ROW_INSERT           ///< Insert data into a table
+    MDV_OP_ROW_INSERT,          ///< Insert data into a table
+    MDV_OP_ROW_DELETE,          ///< Delete data from a table
+    MDV_OP_PARTITION_INSERT,    ///< Insert data into a table partition
+    MDV_OP_NOP                  ///< Operation which isn't required by node
+};
+
+
+enum
+{
+    MDV_TABLESPACE_DELETE_BATCH = 1024  ///< Maximum rows identifiers count in one delete operation
 };
 
 
 /**
  * @brief Applies a transaction log to the data storage.
+ * @details If jobs scheduler is provided, operations for different tables are applied concurrently.
  */
-bool mdv_tablespace_log_apply(mdv_tablespace *tablespace, mdv_uuid const *storage);
+bool mdv_tablespace_log_apply(mdv_tablespace *tablespace, mdv_uuid const *storage, mdv_jobber *jobber);
 
 
 /**
@@ -85,67 +101,33 @@ static mdv_table * mdv_tablespace_log_create_table(mdv_tablespace *tablespace, m
 static mdv_errno mdv_tablespace_log_rowset(mdv_tablespace *tablespace, mdv_uuid const *table_id, binn *rows);
 
 
-static mdv_hashmap/*<mdv_storage_id>*/ * mdv_tablespace_storage_ids(mdv_topology *topology)
-{
-    mdv_vector *nodes = mdv_topology_nodes(topology);
-
-    mdv_hashmap *idmap = mdv_hashmap_create(
-                            mdv_storage_id,
-                            uuid,
-                            mdv_vector_size(nodes),
-                            mdv_uuid_hash,
-                            mdv_uuid_cmp);
-
-    if (!idmap)
-    {
-        MDV_LOGE("No memory for identifiers map");
-        mdv_vector_release(nodes);
-        return 0;
-    }
-
-    mdv_vector_foreach(nodes, mdv_toponode, node)
-    {
-        mdv_storage_id const storage_id =
-        {
-            .uuid = node->uuid,
-            .id = node->id
-        };
-
-        if (!mdv_hashmap_insert(idmap, &storage_id, sizeof storage_id))
-        {
-            MDV_LOGE("No memory for identifiers map");
-            mdv_vector_release(nodes);
-            mdv_hashmap_release(idmap);
-            return 0;
-        }
-    }
+/**
+ * @brief Insert new records into the transaction log for data deletion from the table.
+ * @details Rows of the partitioned table which is distributed between cluster nodes are deleted by the partitions owners.
+ */
+static mdv_errno mdv_tablespace_log_delete(mdv_tablespace *tablespace, mdv_uuid const *table_id, char const *filter);
 
-    mdv_vector_release(nodes);
 
-    return idmap;
-}
+/**
+ * @brief Insert new records into the transaction log for data deletion from the partitions owned by current node.
+ * @details Rows deletion is requested by other cluster node. Foreign partitions are rejected.
+ */
+static mdv_errno mdv_tablespace_log_delete_remote(mdv_tablespace *tablespace, mdv_evt_rowdata_del_remote *del);
 
 
 static bool mdv_tablespace_storage_id(mdv_tablespace *tablespace, mdv_uuid const *uuid, uint32_t *id)
 {
-    bool res = false;
+    mdv_idmap *idmap = mdv_safeptr_get(tablespace->storage_ids);
 
-    mdv_hashmap *idmap = mdv_safeptr_get(tablespace->storage_ids);
+    bool const res = idmap && mdv_idmap_local(idmap, uuid, id);
 
-    mdv_storage_id *storage_id = mdv_hashmap_find(idmap, uuid);
-
-    if (storage_id)
-    {
-        *id = storage_id->id;
-        res = true;
-    }
-    else
+    if (!res)
     {
         char uuid_str[MDV_UUID_STR_LEN];
         MDV_LOGE("Storage idntifier %s not found", mdv_uuid_to_str(uuid, uuid_str));
     }
 
-    mdv_hashmap_release(idmap);
+    mdv_idmap_release(idmap);
 
     return res;
 }
@@ -216,14 +198,18 @@ static mdv_rowdata * mdv_tablespace_rowdata_create(mdv_tablespace *tablespace, m
     {
         mdv_rowdata_ref *ref = mdv_hashmap_find(tablespace->rowdata, table_id);
 
-        if(!ref)
+        mdv_table *table = ref ? 0 : mdv_tables_get(tablespace->tables, table_id);
+
+        if(table)
         {
             mdv_rowdata_ref new_ref =
             {
                 .uuid = *table_id,
-                .rowdata = mdv_rowdata_open(MDV_CONFIG.storage.rowdata, table_id)
+                .rowdata = mdv_rowdata_open(MDV_CONFIG.storage.rowdata, table)
             };
 
+            mdv_table_release(table);
+
             if (new_ref.rowdata)
             {
                 ref = mdv_hashmap_insert(tablespace->rowdata, &new_ref, sizeof new_ref);
@@ -299,6 +285,43 @@ static mdv_errno mdv_tablespace_evt_rowdata_insert(void *arg, mdv_event *event)
 }
 
 
+static mdv_errno mdv_tablespace_evt_rowdata_delete(void *arg, mdv_event *event)
+{
+    mdv_tablespace          *tablespace  = arg;
+    mdv_evt_rowdata_del_req *rowdata_del = (mdv_evt_rowdata_del_req *)event;
+    return mdv_tablespace_log_delete(tablespace, &rowdata_del->table_id, rowdata_del->filter);
+}
+
+
+static mdv_errno mdv_tablespace_evt_rowdata_delete_remote(void *arg, mdv_event *event)
+{
+    mdv_tablespace             *tablespace  = arg;
+    mdv_evt_rowdata_del_remote *rowdata_del = (mdv_evt_rowdata_del_remote *)event;
+
+    if (mdv_uuid_cmp(&rowdata_del->to, &tablespace->uuid) != 0)
+        return MDV_OK;
+
+    mdv_errno err = mdv_tablespace_log_delete_remote(tablespace, rowdata_del);
+
+    mdv_evt_rowdata_del_status *status = mdv_evt_rowdata_del_status_create(&tablespace->uuid,
+                                                                          &rowdata_del->from,
+                                                                          rowdata_del->id,
+                                                                          err);
+
+    if (!status)
+    {
+        MDV_LOGE("No memory for rows deletion status");
+        return MDV_NO_MEM;
+    }
+
+    err = mdv_ebus_publish(tablespace->ebus, &status->base, MDV_EVT_SYNC);
+
+    mdv_evt_rowdata_del_status_release(status);
+
+    return err;
+}
+
+
 static mdv_errno mdv_tablespace_evt_rowdata_get(void *arg, mdv_event *event)
 {
     mdv_tablespace  *tablespace = arg;
@@ -310,6 +333,17 @@ static mdv_errno mdv_tablespace_evt_rowdata_get(void *arg, mdv_event *event)
 }
 
 
+static mdv_errno mdv_tablespace_evt_placement_get(void *arg, mdv_event *event)
+{
+    mdv_tablespace    *tablespace = arg;
+    mdv_evt_placement *get = (mdv_evt_placement *)event;
+
+    get->placement = mdv_safeptr_get(tablespace->placement);
+
+    return get->placement ? MDV_OK : MDV_FAILED;
+}
+
+
 static mdv_errno mdv_tablespace_evt_trlog_get(void *arg, mdv_event *event)
 {
     mdv_tablespace *tablespace = arg;
@@ -326,340 +360,1837 @@ static mdv_errno mdv_tablespace_evt_trlog_apply(void *arg, mdv_event *event)
     mdv_tablespace      *tablespace = arg;
     mdv_evt_trlog_apply *apply      = (mdv_evt_trlog_apply *)event;
 
-    return mdv_tablespace_log_apply(tablespace, &apply->trlog)
+    return mdv_tablespace_log_apply(tablespace, &apply->trlog, apply->jobber)
                 ? MDV_OK
                 : MDV_FAILED;
 }
 
 
-static mdv_errno mdv_tablespace_evt_topology(void *arg, mdv_event *event)
+/// Transaction log position received by all known cluster nodes
+typedef struct
 {
-    mdv_tablespace      *tablespace = arg;
-    mdv_evt_topology    *topo = (mdv_evt_topology *)event;
+    uint32_t    id;             ///< Transaction log local unique identifier
+    uint64_t    pos;            ///< Transaction log position received by all known cluster nodes
+} mdv_tablespace_trlog_synced;
 
-    mdv_hashmap *idmap = mdv_tablespace_storage_ids(topo->topology);
 
-    if (!idmap)
-        return MDV_NO_MEM;
-
-    mdv_errno err = mdv_safeptr_set(tablespace->storage_ids, idmap);
+static bool mdv_tablespace_tombstone_purgeable(void *arg, mdv_objid const *op)
+{
+    mdv_vector *synced = arg;
 
-    mdv_hashmap_release(idmap);
+    mdv_vector_foreach(synced, mdv_tablespace_trlog_synced, trlog)
+    {
+        if (trlog->id == op->node)
+            return op->id < trlog->pos;
+    }
 
-    return err;
+    return false;
 }
 
 
-static const mdv_event_handler_type mdv_tablespace_handlers[] =
+static mdv_vector/*<mdv_trlog_ref>*/ * mdv_tablespace_trlogs(mdv_tablespace *tablespace)
 {
-    { MDV_EVT_TABLE_GET,      mdv_tablespace_evt_table_get },
-    { MDV_EVT_TABLE_CREATE,   mdv_tablespace_evt_table_create },
-    { MDV_EVT_TABLES_GET,     mdv_tablespace_evt_tables_get },
-    { MDV_EVT_ROWDATA_INSERT, mdv_tablespace_evt_rowdata_insert },
-    { MDV_EVT_ROWDATA_GET,    mdv_tablespace_evt_rowdata_get },
-    { MDV_EVT_TRLOG_GET,      mdv_tablespace_evt_trlog_get },
-    { MDV_EVT_TRLOG_APPLY,    mdv_tablespace_evt_trlog_apply },
-    { MDV_EVT_TOPOLOGY,       mdv_tablespace_evt_topology },
-};
+    mdv_vector *trlogs = 0;
 
+    if (mdv_mutex_lock(&tablespace->trlogs_mutex) == MDV_OK)
+    {
+        trlogs = mdv_vector_create(mdv_hashmap_size(tablespace->trlogs) + 1,
+                                   sizeof(mdv_trlog_ref),
+                                   &mdv_default_allocator);
 
-mdv_tablespace * mdv_tablespace_open(mdv_uuid const *uuid, mdv_ebus *ebus, mdv_topology *topology)
-{
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(8);
+        if (trlogs)
+        {
+            mdv_hashmap_foreach(tablespace->trlogs, mdv_trlog_ref, ref)
+            {
+                mdv_trlog_ref const trlog_ref =
+                {
+                    .uuid = ref->uuid,
+                    .trlog = mdv_trlog_retain(ref->trlog)
+                };
 
-    mdv_tablespace *tablespace = mdv_alloc(sizeof(mdv_tablespace));
+                if (!mdv_vector_push_back(trlogs, &trlog_ref))
+                    mdv_trlog_release(trlog_ref.trlog);
+            }
+        }
 
-    if (!tablespace)
-    {
-        MDV_LOGE("No memory for new tablespace");
-        mdv_rollback(rollbacker);
-        return 0;
+        mdv_mutex_unlock(&tablespace->trlogs_mutex);
     }
 
-    mdv_rollbacker_push(rollbacker, mdv_free, tablespace);
+    if (!trlogs)
+        MDV_LOGE("No memory for transaction logs list");
 
-    tablespace->uuid = *uuid;
+    return trlogs;
+}
 
-    mdv_hashmap *idmap = mdv_tablespace_storage_ids(topology);
 
-    if (!idmap)
-    {
-        MDV_LOGE("No memory for new tablespace");
-        mdv_rollback(rollbacker);
+static void mdv_tablespace_trlogs_release(mdv_vector/*<mdv_trlog_ref>*/ *trlogs)
+{
+    mdv_vector_foreach(trlogs, mdv_trlog_ref, ref)
+        mdv_trlog_release(ref->trlog);
+    mdv_vector_release(trlogs);
+}
+
+
+/**
+ * @brief Creates the list of nodes which acknowledge transaction logs records for all known cluster nodes
+ * @details Records are delivered to the cluster node through the next hop. So the next hop acknowledges them.
+ *          Unreachable nodes are acknowledged by themselves, i.e. by the last position received before disconnection.
+ */
+static mdv_vector/*<mdv_nexthop>*/ * mdv_tablespace_ackers_create(mdv_topology *topology, mdv_uuid const *uuid)
+{
+    mdv_vector *toponodes = mdv_topology_nodes(topology);
+
+    if (!toponodes)
         return 0;
-    }
 
-    tablespace->storage_ids = mdv_safeptr_create(idmap,
-                                        (mdv_safeptr_retain_fn)mdv_hashmap_retain,
-                                        (mdv_safeptr_release_fn)mdv_hashmap_release);
+    mdv_hashmap *nexthops = mdv_nexthops_find(topology, uuid);
 
-    if (!tablespace->storage_ids)
+    if (!nexthops)
     {
-        MDV_LOGE("Safe pointer creation failed");
-        mdv_hashmap_release(idmap);
-        mdv_rollback(rollbacker);
+        mdv_vector_release(toponodes);
         return 0;
     }
 
-    mdv_rollbacker_push(rollbacker, mdv_safeptr_free, tablespace->storage_ids);
+    mdv_vector *ackers = mdv_vector_create(mdv_vector_size(toponodes) + 1,
+                                           sizeof(mdv_nexthop),
+                                           &mdv_default_allocator);
 
-    mdv_hashmap_release(idmap);
+    if (ackers)
+    {
+        mdv_vector_foreach(toponodes, mdv_toponode, node)
+        {
+            if (mdv_uuid_cmp(&node->uuid, uuid) == 0)
+                continue;
 
-    tablespace->tables = mdv_tables_open(MDV_CONFIG.storage.path);
+            mdv_nexthop const *hop = mdv_hashmap_find(nexthops, &node->uuid);
 
-    if (!tablespace->tables)
-    {
-        MDV_LOGE("Tables storage creation failed");
-        mdv_rollback(rollbacker);
-        return 0;
+            mdv_nexthop const acker =
+            {
+                .dst = node->uuid,
+                .hop = hop ? hop->hop : node->uuid
+            };
+
+            mdv_vector_push_back(ackers, &acker);
+        }
     }
 
-    mdv_rollbacker_push(rollbacker, mdv_tables_release, tablespace->tables);
+    mdv_hashmap_release(nexthops);
+    mdv_vector_release(toponodes);
 
-    if (mdv_mutex_create(&tablespace->trlogs_mutex) != MDV_OK)
-    {
-        mdv_rollback(rollbacker);
+    return ackers;
+}
+
+
+/**
+ * @brief Returns transaction log position received by all known cluster nodes
+ * @details Acknowledged positions are persistent. So the nodes which are disconnected for now keep the position.
+ */
+static uint64_t mdv_tablespace_trlog_synced_pos(mdv_vector/*<mdv_nexthop>*/ *ackers, mdv_trlog *trlog)
+{
+    if (!ackers)
         return 0;
-    }
 
-    mdv_rollbacker_push(rollbacker, mdv_mutex_free, &tablespace->trlogs_mutex);
+    mdv_uuid const *owner = mdv_trlog_uuid(trlog);
 
-    tablespace->trlogs = mdv_hashmap_create(mdv_trlog_ref,
-                                            uuid,
-                                            64,
-                                            mdv_uuid_hash,
-                                            mdv_uuid_cmp);
+    uint64_t pos = mdv_trlog_top(trlog);
 
-    if (!tablespace->trlogs)
+    mdv_vector_foreach(ackers, mdv_nexthop, acker)
     {
-        mdv_rollback(rollbacker);
-        return 0;
-    }
+        // Transaction log owner has all records
+        if (mdv_uuid_cmp(&acker->dst, owner) == 0
+            || mdv_uuid_cmp(&acker->hop, owner) == 0)
+            continue;
 
-    mdv_rollbacker_push(rollbacker, mdv_hashmap_release, tablespace->trlogs);
+        uint64_t const received = mdv_trlog_synced(trlog, &acker->hop);
 
-    if (mdv_mutex_create(&tablespace->rowdata_mutex) != MDV_OK)
-    {
-        mdv_rollback(rollbacker);
-        return 0;
+        if (pos > received)
+            pos = received;
     }
 
-    mdv_rollbacker_push(rollbacker, mdv_mutex_free, &tablespace->rowdata_mutex);
+    return pos;
+}
 
-    tablespace->rowdata = mdv_hashmap_create(mdv_rowdata_ref,
-                                             uuid,
-                                             64,
-                                             mdv_uuid_hash,
-                                             mdv_uuid_cmp);
 
-    if (!tablespace->rowdata)
-    {
-        mdv_rollback(rollbacker);
-        return 0;
-    }
+static mdv_vector/*<mdv_tablespace_trlog_synced>*/ * mdv_tablespace_trlogs_synced(mdv_tablespace *tablespace)
+{
+    mdv_vector *trlogs = mdv_tablespace_trlogs(tablespace);
 
-    mdv_rollbacker_push(rollbacker, mdv_hashmap_release, tablespace->rowdata);
+    if (!trlogs)
+        return 0;
 
-    tablespace->ebus = mdv_ebus_retain(ebus);
+    mdv_vector *ackers = mdv_safeptr_get(tablespace->ackers);
 
-    mdv_rollbacker_push(rollbacker, mdv_ebus_release, tablespace->ebus);
+    mdv_vector *synced = mdv_vector_create(mdv_vector_size(trlogs) + 1,
+                                           sizeof(mdv_tablespace_trlog_synced),
+                                           &mdv_default_allocator);
 
-    if (mdv_ebus_subscribe_all(tablespace->ebus,
-                               tablespace,
-                               mdv_tablespace_handlers,
-                               sizeof mdv_tablespace_handlers / sizeof *mdv_tablespace_handlers) != MDV_OK)
+    if (synced)
     {
-        MDV_LOGE("Ebus subscription failed");
-        mdv_rollback(rollbacker);
-        return 0;
+        mdv_vector_foreach(trlogs, mdv_trlog_ref, ref)
+        {
+            mdv_tablespace_trlog_synced const trlog_synced =
+            {
+                .id = mdv_trlog_id(ref->trlog),
+                .pos = mdv_tablespace_trlog_synced_pos(ackers, ref->trlog)
+            };
+
+            mdv_vector_push_back(synced, &trlog_synced);
+        }
     }
+    else
+        MDV_LOGE("No memory for transaction logs positions");
 
-    mdv_rollbacker_free(rollbacker);
+    if (ackers)
+        mdv_vector_release(ackers);
+    mdv_tablespace_trlogs_release(trlogs);
 
-    return tablespace;
+    return synced;
 }
 
 
-void mdv_tablespace_close(mdv_tablespace *tablespace)
+/**
+ * @brief Deletes transaction logs records which are applied and received by all known cluster nodes.
+ * @details Last 'keep' records are kept for peers which are not synchronized yet.
+ */
+static mdv_errno mdv_tablespace_trlogs_truncate(mdv_tablespace *tablespace, uint32_t batch_size, uint64_t keep, uint64_t *truncated)
 {
-    if (tablespace)
-    {
-        mdv_ebus_unsubscribe_all(tablespace->ebus,
-                                 tablespace,
-                                 mdv_tablespace_handlers,
-                                 sizeof mdv_tablespace_handlers / sizeof *mdv_tablespace_handlers);
+    *truncated = 0;
 
-        mdv_ebus_release(tablespace->ebus);
+    mdv_vector *trlogs = mdv_tablespace_trlogs(tablespace);
 
-        mdv_tables_release(tablespace->tables);
+    if (!trlogs)
+        return MDV_NO_MEM;
 
-        mdv_hashmap_foreach(tablespace->trlogs, mdv_trlog_ref, ref)
-            mdv_trlog_release(ref->trlog);
-        mdv_hashmap_release(tablespace->trlogs);
-        mdv_mutex_free(&tablespace->trlogs_mutex);
+    mdv_vector *ackers = mdv_safeptr_get(tablespace->ackers);
 
-        mdv_hashmap_foreach(tablespace->rowdata, mdv_rowdata_ref, ref)
-            mdv_rowdata_release(ref->rowdata);
-        mdv_hashmap_release(tablespace->rowdata);
-        mdv_mutex_free(&tablespace->rowdata_mutex);
+    mdv_vector_foreach(trlogs, mdv_trlog_ref, ref)
+    {
+        uint64_t const synced = mdv_tablespace_trlog_synced_pos(ackers, ref->trlog);
 
-        mdv_safeptr_free(tablespace->storage_ids);
+        if (synced <= keep)
+            continue;
 
-        memset(tablespace, 0, sizeof(*tablespace));
-        mdv_free(tablespace);
+        uint32_t n;
+
+        do
+        {
+            n = mdv_trlog_truncate(ref->trlog, synced - keep, batch_size);
+            *truncated += n;
+        }
+        while(n >= batch_size);
     }
+
+    if (ackers)
+        mdv_vector_release(ackers);
+    mdv_tablespace_trlogs_release(trlogs);
+
+    return MDV_OK;
 }
 
 
-static mdv_table * mdv_tablespace_log_create_table(mdv_tablespace *tablespace, mdv_table_desc const *desc)
+/**
+ * @brief Purges tombstones of removed rows in opened rowdata storages.
+ * @details Tombstone is purged when the deletion operation is acknowledged for all known cluster nodes.
+ *          Nodes which are disconnected or never acknowledged the transaction log block the purging.
+ */
+static mdv_errno mdv_tablespace_compact(mdv_tablespace *tablespace, uint32_t limit, bool shrink, uint32_t *purged)
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(4);
+    *purged = 0;
 
-    mdv_trlog *trlog = mdv_tablespace_trlog_create(tablespace, &tablespace->uuid);
+    mdv_vector *synced = mdv_tablespace_trlogs_synced(tablespace);
 
-    if (!trlog)
+    if (!synced)
+        return MDV_NO_MEM;
+
+    mdv_vector *storages = 0;
+
+    if (mdv_mutex_lock(&tablespace->rowdata_mutex) == MDV_OK)
     {
-        mdv_rollback(rollbacker);
-        return 0;
-    }
+        storages = mdv_vector_create(mdv_hashmap_size(tablespace->rowdata) + 1,
+                                     sizeof(mdv_rowdata_ref),
+                                     &mdv_default_allocator);
 
-    mdv_rollbacker_push(rollbacker, mdv_trlog_release, trlog);
+        if (storages)
+        {
+            mdv_hashmap_foreach(tablespace->rowdata, mdv_rowdata_ref, ref)
+            {
+                mdv_rowdata_ref const rowdata_ref =
+                {
+                    .uuid = ref->uuid,
+                    .rowdata = mdv_rowdata_retain(ref->rowdata)
+                };
 
-    mdv_uuid const uuid = mdv_uuid_generate();
+                if (!mdv_vector_push_back(storages, &rowdata_ref))
+                    mdv_rowdata_release(rowdata_ref.rowdata);
+            }
+        }
 
-    mdv_table *table = mdv_table_create(&uuid, desc);
+        mdv_mutex_unlock(&tablespace->rowdata_mutex);
+    }
 
-    if (!table)
+    if (!storages)
     {
-        mdv_rollback(rollbacker);
-        return 0;
+        MDV_LOGE("No memory for rowdata storages list");
+        mdv_vector_release(synced);
+        return MDV_NO_MEM;
     }
 
-    mdv_rollbacker_push(rollbacker, mdv_table_release, table);
-
-    binn obj;
+    mdv_errno err = MDV_OK;
 
-    if (!mdv_binn_table(table, &obj))
+    mdv_vector_foreach(storages, mdv_rowdata_ref, ref)
     {
-        mdv_rollback(rollbacker);
-        return 0;
-    }
+        size_t count = 0;
 
-    mdv_rollbacker_push(rollbacker, binn_free, &obj);
+        if (*purged < limit)
+        {
+            if (mdv_rowdata_purge(ref->rowdata,
+                                  limit - *purged,
+                                  synced,
+                                  mdv_tablespace_tombstone_purgeable,
+                                  &count) != MDV_OK)
+                err = MDV_FAILED;
+        }
 
-    int const binn_obj_size = binn_size(&obj);
+        if (count && shrink)
+            mdv_rowdata_compact(ref->rowdata);
 
-    size_t const op_size = offsetof(mdv_trlog_op, payload)
-                            + binn_obj_size;
+        *purged += count;
+
+        mdv_rowdata_release(ref->rowdata);
+    }
+
+    mdv_vector_release(storages);
+    mdv_vector_release(synced);
+
+    return err;
+}
+
+
+static mdv_errno mdv_tablespace_evt_rowdata_compact(void *arg, mdv_event *event)
+{
+    mdv_tablespace          *tablespace = arg;
+    mdv_evt_rowdata_compact *compact    = (mdv_evt_rowdata_compact *)event;
+    return mdv_tablespace_compact(tablespace, compact->limit, compact->shrink, &compact->purged);
+}
+
+
+static mdv_errno mdv_tablespace_evt_trlog_truncate(void *arg, mdv_event *event)
+{
+    mdv_tablespace         *tablespace = arg;
+    mdv_evt_trlog_truncate *truncate   = (mdv_evt_trlog_truncate *)event;
+    return mdv_tablespace_trlogs_truncate(tablespace, truncate->batch_size, truncate->keep, &truncate->truncated);
+}
+
+
+static mdv_errno mdv_tablespace_evt_topology(void *arg, mdv_event *event)
+{
+    mdv_tablespace      *tablespace = arg;
+    mdv_evt_topology    *topo = (mdv_evt_topology *)event;
+
+    mdv_idmap *idmap = mdv_idmap_create_by_topology(topo->topology);
+
+    if (!idmap)
+        return MDV_NO_MEM;
+
+    mdv_errno err = mdv_safeptr_set(tablespace->storage_ids, idmap);
+
+    mdv_idmap_release(idmap);
+
+    if (err != MDV_OK)
+        return err;
+
+    mdv_placement *placement = mdv_placement_create(topo->topology,
+                                                    &tablespace->uuid,
+                                                    MDV_CONFIG.datasync.replicas);
+
+    if (!placement)
+        return MDV_NO_MEM;
+
+    err = mdv_safeptr_set(tablespace->placement, placement);
+
+    mdv_placement_release(placement);
+
+    if (err != MDV_OK)
+        return err;
+
+    mdv_vector *ackers = mdv_tablespace_ackers_create(topo->topology, &tablespace->uuid);
+
+    if (!ackers)
+        return MDV_NO_MEM;
+
+    err = mdv_safeptr_set(tablespace->ackers, ackers);
+
+    mdv_vector_release(ackers);
+
+    return err;
+}
+
+
+/**
+ * @brief Returns the table descriptor
+ * @details Operations are grouped by tables, so the last requested table is cached.
+ *
+ * @param tablespace [in]   Tables space
+ * @param cached [in] [out] Last requested table (may point to NULL)
+ * @param table_id [in]     Table identifier
+ *
+ * @return table descriptor or NULL if the table isn't found
+ */
+static mdv_table_desc const * mdv_tablespace_table_cached(mdv_tablespace *tablespace, mdv_table **cached, mdv_uuid const *table_id)
+{
+    if (!*cached || mdv_uuid_cmp(mdv_table_uuid(*cached), table_id) != 0)
+    {
+        mdv_table *table = mdv_tables_get(tablespace->tables, table_id);
+
+        if (!table)
+            return 0;
+
+        mdv_table_release(*cached);
+        *cached = table;
+    }
+
+    return mdv_table_description(*cached);
+}
+
+
+static mdv_errno mdv_tablespace_evt_trlog_filter(void *arg, mdv_event *event)
+{
+    mdv_tablespace       *tablespace = arg;
+    mdv_evt_trlog_filter *filter     = (mdv_evt_trlog_filter *)event;
+
+    mdv_placement *placement = mdv_safeptr_get(tablespace->placement);
+
+    if (!placement)
+        return MDV_FAILED;
+
+    mdv_table *table = 0;
+
+    mdv_list_foreach(filter->rows, mdv_trlog_data, entry)
+    {
+        if (entry->op.type != MDV_OP_PARTITION_INSERT)
+            continue;
+
+        mdv_uuid table_id;
+        uint32_t partition;
+        memcpy(&table_id, entry->op.payload + sizeof(uint64_t), sizeof table_id);
+        memcpy(&partition, entry->op.payload + sizeof(uint64_t) + sizeof table_id, sizeof partition);
+
+        // Operations for unknown tables are sent as is
+        mdv_table_desc const *desc = mdv_tablespace_table_cached(tablespace, &table, &table_id);
+
+        // Record is kept to save the transaction log positions continuity
+        if (desc && !mdv_placement_reachable(placement, desc, partition, &filter->to))
+        {
+            entry->op.type = MDV_OP_NOP;
+            entry->op.size = offsetof(mdv_trlog_op, payload);
+        }
+    }
+
+    mdv_table_release(table);
+    mdv_placement_release(placement);
+
+    return MDV_OK;
+}
+
+
+/**
+ * @brief Opens all transaction logs stored on the disk.
+ * @details Transaction logs are opened lazily. But all of them are required for snapshot.
+ */
+static void mdv_tablespace_trlogs_open(mdv_tablespace *tablespace)
+{
+    if (!mdv_mkdir(MDV_CONFIG.storage.trlog))
+        return;
+
+    mdv_enumerator *files = mdv_dir_enumerator(MDV_CONFIG.storage.trlog);
+
+    if (!files)
+        return;
+
+    static char const ext[] = ".mdb";
+
+    while(mdv_enumerator_next(files) == MDV_OK)
+    {
+        char const *name = mdv_enumerator_current(files);
+
+        // Transaction logs storages are named as '<UUID>.mdb'
+        if (strlen(name) != MDV_UUID_STR_LEN - 1 + sizeof ext - 1
+            || strcmp(name + MDV_UUID_STR_LEN - 1, ext) != 0)
+            continue;
+
+        char uuid_str[MDV_UUID_STR_LEN];
+        memcpy(uuid_str, name, MDV_UUID_STR_LEN - 1);
+        uuid_str[MDV_UUID_STR_LEN - 1] = 0;
+
+        mdv_uuid uuid;
+
+        if (mdv_uuid_from_str(&uuid, uuid_str))
+            mdv_trlog_release(mdv_tablespace_trlog_create(tablespace, &uuid));
+    }
+
+    mdv_enumerator_release(files);
+}
+
+
+/**
+ * @brief Returns true if there are no tables and all transaction logs are empty
+ */
+static bool mdv_tablespace_empty(mdv_tablespace *tablespace)
+{
+    if (!mdv_tables_empty(tablespace->tables))
+        return false;
+
+    mdv_tablespace_trlogs_open(tablespace);
+
+    mdv_vector *trlogs = mdv_tablespace_trlogs(tablespace);
+
+    if (!trlogs)
+        return false;
+
+    bool empty = true;
+
+    mdv_vector_foreach(trlogs, mdv_trlog_ref, ref)
+    {
+        if (mdv_trlog_top(ref->trlog))
+        {
+            empty = false;
+            break;
+        }
+    }
+
+    mdv_tablespace_trlogs_release(trlogs);
+
+    return empty;
+}
+
+
+/**
+ * @brief Returns path for received table storage copy
+ */
+static char const * mdv_tablespace_snapshot_path(mdv_uuid const *table, char const *suffix, char *path, size_t size)
+{
+    char storage_name[64];
+    snprintf(path, size, "%s/%s%s",
+             MDV_CONFIG.storage.rowdata,
+             MDV_STRG_UUID(table, storage_name, sizeof storage_name),
+             suffix);
+    return path;
+}
+
+
+static mdv_errno mdv_tablespace_snapshot_create(mdv_tablespace *tablespace, mdv_evt_create_snapshot *snapshot)
+{
+    // I. Transaction logs positions are captured before the tables storages copying.
+    //    Operations applied later are replayed by receiver and skipped by the tables marks.
+    mdv_tablespace_trlogs_open(tablespace);
+
+    mdv_vector *trlogs = mdv_tablespace_trlogs(tablespace);
+
+    if (!trlogs)
+        return MDV_NO_MEM;
+
+    snapshot->positions = mdv_vector_create(mdv_vector_size(trlogs) + 1,
+                                            sizeof(mdv_trlog_pos),
+                                            &mdv_default_allocator);
+
+    if (!snapshot->positions)
+    {
+        MDV_LOGE("No memory for transaction logs positions");
+        mdv_tablespace_trlogs_release(trlogs);
+        return MDV_NO_MEM;
+    }
+
+    mdv_vector_foreach(trlogs, mdv_trlog_ref, ref)
+    {
+        mdv_trlog_pos const pos =
+        {
+            .trlog = ref->uuid,
+            .pos = mdv_trlog_applied(ref->trlog)
+        };
+
+        if (pos.pos && !mdv_vector_push_back(snapshot->positions, &pos))
+        {
+            MDV_LOGE("No memory for transaction logs positions");
+            mdv_tablespace_trlogs_release(trlogs);
+            return MDV_NO_MEM;
+        }
+    }
+
+    mdv_tablespace_trlogs_release(trlogs);
+
+    // II. Tables descriptors
+    snapshot->tables = mdv_tables_all(tablespace->tables);
+
+    if (!snapshot->tables)
+        return MDV_FAILED;
+
+    snapshot->files = mdv_vector_create(mdv_vector_size(snapshot->tables) + 1,
+                                        sizeof(mdv_snapshot_file),
+                                        &mdv_default_allocator);
+
+    if (!snapshot->files)
+    {
+        MDV_LOGE("No memory for tables storages copies");
+        return MDV_NO_MEM;
+    }
+
+    // III. Storage identifiers used in rows identifiers and tombstones
+    mdv_idmap *idmap = mdv_safeptr_get(tablespace->storage_ids);
+
+    if (!idmap)
+        return MDV_FAILED;
+
+    snapshot->ids = mdv_vector_create(mdv_idmap_size(idmap) + 1,
+                                      sizeof(mdv_storage_id),
+                                      &mdv_default_allocator);
+
+    if (!snapshot->ids || !mdv_vector_resize(snapshot->ids, mdv_idmap_size(idmap)))
+    {
+        MDV_LOGE("No memory for storage identifiers");
+        mdv_idmap_release(idmap);
+        return MDV_NO_MEM;
+    }
+
+    mdv_idmap_ids(idmap, mdv_vector_data(snapshot->ids));
+
+    mdv_idmap_release(idmap);
+
+    // IV. Tables storages copies
+    mdv_vector_foreach(snapshot->tables, mdv_table_ptr, table)
+    {
+        mdv_uuid const *table_id = mdv_table_uuid(*table);
+
+        mdv_rowdata *rowdata = mdv_tablespace_rowdata_create(tablespace, table_id);
+
+        if (!rowdata)
+            return MDV_FAILED;
+
+        mdv_snapshot_file file =
+        {
+            .table = *table_id,
+            .fd = mdv_open(MDV_CONFIG.storage.path, MDV_OTMPFILE | MDV_OREAD | MDV_OWRITE),
+            .size = 0
+        };
+
+        if (file.fd == MDV_INVALID_DESCRIPTOR)
+        {
+            mdv_rowdata_release(rowdata);
+            return MDV_FAILED;
+        }
+
+        mdv_errno err = mdv_rowdata_copy(rowdata, file.fd);
+
+        mdv_rowdata_release(rowdata);
+
+        if (err == MDV_OK)
+            err = mdv_file_size_by_fd(file.fd, &file.size);
+
+        if (err != MDV_OK)
+        {
+            mdv_descriptor_close(file.fd);
+            return err;
+        }
+
+        if (!mdv_vector_push_back(snapshot->files, &file))
+        {
+            MDV_LOGE("No memory for tables storages copies");
+            mdv_descriptor_close(file.fd);
+            return MDV_NO_MEM;
+        }
+    }
+
+    return MDV_OK;
+}
+
+
+/**
+ * @brief Saves received chunk of table storage copy.
+ * @details Chunks are written to '<UUID>.mdb.part' file. The file is renamed to '<UUID>.mdb.snapshot'
+ *          when the last chunk is received.
+ */
+static mdv_errno mdv_tablespace_snapshot_save(mdv_evt_snapshot_data const *data)
+{
+    char part[MDV_PATH_MAX];
+    char ready[MDV_PATH_MAX];
+
+    mdv_tablespace_snapshot_path(&data->table, ".part", part, sizeof part);
+    mdv_tablespace_snapshot_path(&data->table, ".snapshot", ready, sizeof ready);
+
+    if (!data->offset)
+    {
+        // Previous transfer might be interrupted
+        if (!mdv_mkdir(MDV_CONFIG.storage.rowdata)
+            || !mdv_remove(part)
+            || !mdv_remove(ready))
+            return MDV_FAILED;
+    }
+
+    mdv_descriptor fd = mdv_open(part, MDV_OCREAT | MDV_OWRITE);
+
+    if (fd == MDV_INVALID_DESCRIPTOR)
+        return MDV_FAILED;
+
+    mdv_errno err = MDV_OK;
+
+    if (data->size)
+        err = mdv_file_write_at(fd, data->data, data->size, data->offset);
+
+    bool const last = data->offset + data->size >= data->total;
+
+    if (err == MDV_OK && last)
+        err = mdv_file_sync(fd);
+
+    mdv_descriptor_close(fd);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Snapshot chunk writing failed");
+        return err;
+    }
+
+    if (last && !mdv_rename(part, ready))
+        return MDV_FAILED;
+
+    return MDV_OK;
+}
+
+
+/// Storage identifiers translator for the received tables storages
+typedef struct
+{
+    mdv_idmap *src;             ///< Storage identifiers of the snapshot sender
+    mdv_idmap *dst;             ///< Local storage identifiers
+} mdv_tablespace_snapshot_ids;
+
+
+static bool mdv_tablespace_snapshot_id_translate(void *arg, mdv_objid *id)
+{
+    mdv_tablespace_snapshot_ids const *ids = arg;
+
+    mdv_uuid uuid;
+    uint32_t node;
+
+    if (!mdv_idmap_global(ids->src, id->node, &uuid))
+    {
+        MDV_LOGE("Snapshot storage identifier %u is unknown", id->node);
+        return false;
+    }
+
+    if (!mdv_idmap_local(ids->dst, &uuid, &node))
+    {
+        char uuid_str[MDV_UUID_STR_LEN];
+        MDV_LOGE("Storage idntifier %s not found", mdv_uuid_to_str(&uuid, uuid_str));
+        return false;
+    }
+
+    id->node = node;
+
+    return true;
+}
+
+
+/**
+ * @brief Imports received table storage.
+ * @details Rows identifiers and tombstones contain the sender storage identifiers.
+ *          They are translated to the local storage identifiers.
+ */
+static mdv_errno mdv_tablespace_snapshot_import(mdv_table *table, mdv_tablespace_snapshot_ids *ids)
+{
+    char path[MDV_PATH_MAX];
+    char lock[MDV_PATH_MAX];
+    char storage_name[64];
+    char snapshot_name[64 + sizeof ".snapshot"];
+
+    mdv_uuid const *table_id = mdv_table_uuid(table);
+
+    mdv_tablespace_snapshot_path(table_id, "", path, sizeof path);
+    mdv_tablespace_snapshot_path(table_id, "-lock", lock, sizeof lock);
+
+    // Previous installation might be interrupted
+    if (!mdv_remove(path) || !mdv_remove(lock))
+        return MDV_FAILED;
+
+    snprintf(snapshot_name, sizeof snapshot_name, "%s.snapshot",
+             MDV_STRG_UUID(table_id, storage_name, sizeof storage_name));
+
+    mdv_rowdata *rowdata = mdv_rowdata_open(MDV_CONFIG.storage.rowdata, table);
+
+    if (!rowdata)
+        return MDV_FAILED;
+
+    mdv_errno err = mdv_rowdata_import(rowdata,
+                                       MDV_CONFIG.storage.rowdata,
+                                       snapshot_name,
+                                       ids,
+                                       mdv_tablespace_snapshot_id_translate);
+
+    mdv_rowdata_release(rowdata);
+
+    if (err != MDV_OK)
+        return err;
+
+    mdv_tablespace_snapshot_path(table_id, ".snapshot", path, sizeof path);
+    mdv_tablespace_snapshot_path(table_id, ".snapshot-lock", lock, sizeof lock);
+
+    mdv_remove(path);
+    mdv_remove(lock);
+
+    return MDV_OK;
+}
+
+
+/**
+ * @brief Installs received snapshot.
+ * @details Tables storages are imported to the rowdata directory first. Then the tables descriptors are
+ *          saved and the transaction logs are moved to the positions covered by snapshot.
+ */
+static mdv_errno mdv_tablespace_snapshot_install(mdv_tablespace *tablespace, mdv_vector *tables, mdv_vector *positions, mdv_vector *ids)
+{
+    if (!mdv_tables_empty(tablespace->tables))
+    {
+        MDV_LOGE("Snapshot can't be installed. Tables storage isn't empty.");
+        return MDV_EEXIST;
+    }
+
+    char ready[MDV_PATH_MAX];
+
+    // I. All tables storages should be received
+    mdv_vector_foreach(tables, mdv_table_ptr, table)
+    {
+        size_t size = 0;
+
+        mdv_tablespace_snapshot_path(mdv_table_uuid(*table), ".snapshot", ready, sizeof ready);
+
+        if (mdv_file_size_by_path(ready, &size) != MDV_OK)
+        {
+            MDV_LOGE("Snapshot can't be installed. Table storage '%s' isn't received.", ready);
+            return MDV_ENOENT;
+        }
+    }
+
+    // II. Tables storages
+    mdv_tablespace_snapshot_ids snapshot_ids =
+    {
+        .src = mdv_idmap_create(mdv_vector_data(ids), mdv_vector_size(ids)),
+        .dst = mdv_safeptr_get(tablespace->storage_ids)
+    };
+
+    mdv_errno err = snapshot_ids.src && snapshot_ids.dst ? MDV_OK : MDV_FAILED;
+
+    if (err == MDV_OK)
+    {
+        mdv_vector_foreach(tables, mdv_table_ptr, table)
+        {
+            err = mdv_tablespace_snapshot_import(*table, &snapshot_ids);
+
+            if (err != MDV_OK)
+                break;
+        }
+    }
+
+    mdv_idmap_release(snapshot_ids.src);
+    mdv_idmap_release(snapshot_ids.dst);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Snapshot can't be installed. Tables storages weren't imported.");
+        return err;
+    }
+
+    // III. Tables descriptors
+    mdv_vector_foreach(tables, mdv_table_ptr, table)
+    {
+        binn obj;
+
+        if (!mdv_binn_table(*table, &obj))
+            return MDV_FAILED;
+
+        mdv_data const data =
+        {
+            .size = binn_size(&obj),
+            .ptr = binn_ptr(&obj)
+        };
+
+        err = mdv_tables_add_raw(tablespace->tables, mdv_table_uuid(*table), &data);
+
+        binn_free(&obj);
+
+        if (err != MDV_OK)
+        {
+            MDV_LOGE("Table descriptor saving failed");
+            return err;
+        }
+    }
+
+    // IV. Transaction logs positions
+    mdv_vector_foreach(positions, mdv_trlog_pos, pos)
+    {
+        mdv_trlog *trlog = mdv_tablespace_trlog_create(tablespace, &pos->trlog);
+
+        err = trlog ? mdv_trlog_reset(trlog, pos->pos) : MDV_FAILED;
+
+        mdv_trlog_release(trlog);
+
+        // Transaction log is replayed from the beginning. Rows which are already in snapshot are skipped.
+        if (err != MDV_OK)
+        {
+            char uuid_str[MDV_UUID_STR_LEN];
+            MDV_LOGW("Transaction log '%s' position wasn't restored from snapshot", mdv_uuid_to_str(&pos->trlog, uuid_str));
+        }
+    }
+
+    MDV_LOGI("Snapshot installed. Tables: %zu, transaction logs: %zu",
+             mdv_vector_size(tables),
+             mdv_vector_size(positions));
+
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_tablespace_evt_snapshot_required(void *arg, mdv_event *event)
+{
+    mdv_tablespace            *tablespace = arg;
+    mdv_evt_snapshot_required *required   = (mdv_evt_snapshot_required *)event;
+    required->required = mdv_tablespace_empty(tablespace);
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_tablespace_evt_snapshot_create(void *arg, mdv_event *event)
+{
+    mdv_tablespace          *tablespace = arg;
+    mdv_evt_create_snapshot *snapshot   = (mdv_evt_create_snapshot *)event;
+    return mdv_tablespace_snapshot_create(tablespace, snapshot);
+}
+
+
+static mdv_errno mdv_tablespace_evt_snapshot_data(void *arg, mdv_event *event)
+{
+    mdv_tablespace        *tablespace = arg;
+    mdv_evt_snapshot_data *data       = (mdv_evt_snapshot_data *)event;
+
+    if (mdv_uuid_cmp(&tablespace->uuid, &data->to) != 0)
+        return MDV_OK;
+
+    return mdv_tablespace_snapshot_save(data);
+}
+
+
+static mdv_errno mdv_tablespace_evt_snapshot_install(void *arg, mdv_event *event)
+{
+    mdv_tablespace           *tablespace = arg;
+    mdv_evt_snapshot_install *install    = (mdv_evt_snapshot_install *)event;
+    return mdv_tablespace_snapshot_install(tablespace, install->tables, install->positions, install->ids);
+}
+
+
+static const mdv_event_handler_type mdv_tablespace_handlers[] =
+{
+    { MDV_EVT_TABLE_GET,              mdv_tablespace_evt_table_get },
+    { MDV_EVT_TABLE_CREATE,           mdv_tablespace_evt_table_create },
+    { MDV_EVT_TABLES_GET,             mdv_tablespace_evt_tables_get },
+    { MDV_EVT_ROWDATA_INSERT,         mdv_tablespace_evt_rowdata_insert },
+    { MDV_EVT_ROWDATA_DELETE,         mdv_tablespace_evt_rowdata_delete },
+    { MDV_EVT_ROWDATA_DELETE_REMOTE,  mdv_tablespace_evt_rowdata_delete_remote },
+    { MDV_EVT_ROWDATA_GET,            mdv_tablespace_evt_rowdata_get },
+    { MDV_EVT_ROWDATA_COMPACT,        mdv_tablespace_evt_rowdata_compact },
+    { MDV_EVT_PLACEMENT_GET,          mdv_tablespace_evt_placement_get },
+    { MDV_EVT_TRLOG_GET,              mdv_tablespace_evt_trlog_get },
+    { MDV_EVT_TRLOG_APPLY,            mdv_tablespace_evt_trlog_apply },
+    { MDV_EVT_TRLOG_TRUNCATE,         mdv_tablespace_evt_trlog_truncate },
+    { MDV_EVT_TRLOG_FILTER,           mdv_tablespace_evt_trlog_filter },
+    { MDV_EVT_TOPOLOGY,               mdv_tablespace_evt_topology },
+    { MDV_EVT_SNAPSHOT_REQUIRED,      mdv_tablespace_evt_snapshot_required },
+    { MDV_EVT_SNAPSHOT_CREATE,        mdv_tablespace_evt_snapshot_create },
+    { MDV_EVT_SNAPSHOT_DATA,          mdv_tablespace_evt_snapshot_data },
+    { MDV_EVT_SNAPSHOT_INSTALL,       mdv_tablespace_evt_snapshot_install },
+};
+
+
+mdv_tablespace * mdv_tablespace_open(mdv_uuid const *uuid, mdv_ebus *ebus, mdv_topology *topology)
+{
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(10);
+
+    mdv_tablespace *tablespace = mdv_alloc(sizeof(mdv_tablespace));
+
+    if (!tablespace)
+    {
+        MDV_LOGE("No memory for new tablespace");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_free, tablespace);
+
+    tablespace->uuid = *uuid;
+
+    mdv_idmap *idmap = mdv_idmap_create_by_topology(topology);
+
+    if (!idmap)
+    {
+        MDV_LOGE("No memory for new tablespace");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    tablespace->storage_ids = mdv_safeptr_create(idmap,
+                                        (mdv_safeptr_retain_fn)mdv_idmap_retain,
+                                        (mdv_safeptr_release_fn)mdv_idmap_release);
+
+    if (!tablespace->storage_ids)
+    {
+        MDV_LOGE("Safe pointer creation failed");
+        mdv_idmap_release(idmap);
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_safeptr_free, tablespace->storage_ids);
+
+    mdv_idmap_release(idmap);
+
+    mdv_placement *placement = mdv_placement_create(topology, uuid, MDV_CONFIG.datasync.replicas);
+
+    if (!placement)
+    {
+        MDV_LOGE("No memory for new tablespace");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    tablespace->placement = mdv_safeptr_create(placement,
+                                        (mdv_safeptr_retain_fn)mdv_placement_retain,
+                                        (mdv_safeptr_release_fn)mdv_placement_release);
+
+    if (!tablespace->placement)
+    {
+        MDV_LOGE("Safe pointer creation failed");
+        mdv_placement_release(placement);
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_safeptr_free, tablespace->placement);
+
+    mdv_placement_release(placement);
+
+    mdv_vector *ackers = mdv_tablespace_ackers_create(topology, uuid);
+
+    if (!ackers)
+    {
+        MDV_LOGE("No memory for new tablespace");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    tablespace->ackers = mdv_safeptr_create(ackers,
+                                        (mdv_safeptr_retain_fn)mdv_vector_retain,
+                                        (mdv_safeptr_release_fn)mdv_vector_release);
+
+    if (!tablespace->ackers)
+    {
+        MDV_LOGE("Safe pointer creation failed");
+        mdv_vector_release(ackers);
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_safeptr_free, tablespace->ackers);
+
+    mdv_vector_release(ackers);
+
+    tablespace->tables = mdv_tables_open(MDV_CONFIG.storage.path);
+
+    if (!tablespace->tables)
+    {
+        MDV_LOGE("Tables storage creation failed");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_tables_release, tablespace->tables);
+
+    if (mdv_mutex_create(&tablespace->trlogs_mutex) != MDV_OK)
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_mutex_free, &tablespace->trlogs_mutex);
+
+    tablespace->trlogs = mdv_hashmap_create(mdv_trlog_ref,
+                                            uuid,
+                                            64,
+                                            mdv_uuid_hash,
+                                            mdv_uuid_cmp);
+
+    if (!tablespace->trlogs)
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_hashmap_release, tablespace->trlogs);
+
+    if (mdv_mutex_create(&tablespace->rowdata_mutex) != MDV_OK)
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_mutex_free, &tablespace->rowdata_mutex);
+
+    tablespace->rowdata = mdv_hashmap_create(mdv_rowdata_ref,
+                                             uuid,
+                                             64,
+                                             mdv_uuid_hash,
+                                             mdv_uuid_cmp);
+
+    if (!tablespace->rowdata)
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_hashmap_release, tablespace->rowdata);
+
+    tablespace->ebus = mdv_ebus_retain(ebus);
+
+    mdv_rollbacker_push(rollbacker, mdv_ebus_release, tablespace->ebus);
+
+    if (mdv_ebus_subscribe_all(tablespace->ebus,
+                               tablespace,
+                               mdv_tablespace_handlers,
+                               sizeof mdv_tablespace_handlers / sizeof *mdv_tablespace_handlers) != MDV_OK)
+    {
+        MDV_LOGE("Ebus subscription failed");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_free(rollbacker);
+
+    return tablespace;
+}
+
+
+void mdv_tablespace_close(mdv_tablespace *tablespace)
+{
+    if (tablespace)
+    {
+        mdv_ebus_unsubscribe_all(tablespace->ebus,
+                                 tablespace,
+                                 mdv_tablespace_handlers,
+                                 sizeof mdv_tablespace_handlers / sizeof *mdv_tablespace_handlers);
+
+        mdv_ebus_release(tablespace->ebus);
+
+        mdv_tables_release(tablespace->tables);
+
+        mdv_hashmap_foreach(tablespace->trlogs, mdv_trlog_ref, ref)
+            mdv_trlog_release(ref->trlog);
+        mdv_hashmap_release(tablespace->trlogs);
+        mdv_mutex_free(&tablespace->trlogs_mutex);
+
+        mdv_hashmap_foreach(tablespace->rowdata, mdv_rowdata_ref, ref)
+            mdv_rowdata_release(ref->rowdata);
+        mdv_hashmap_release(tablespace->rowdata);
+        mdv_mutex_free(&tablespace->rowdata_mutex);
+
+        mdv_safeptr_free(tablespace->storage_ids);
+        mdv_safeptr_free(tablespace->placement);
+        mdv_safeptr_free(tablespace->ackers);
+
+        memset(tablespace, 0, sizeof(*tablespace));
+        mdv_free(tablespace);
+    }
+}
+
+
+static mdv_table * mdv_tablespace_log_create_table(mdv_tablespace *tablespace, mdv_table_desc const *desc)
+{
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(5);
+
+    mdv_trlog *trlog = mdv_tablespace_trlog_create(tablespace, &tablespace->uuid);
+
+    if (!trlog)
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_trlog_release, trlog);
+
+    mdv_placement *placement = mdv_safeptr_get(tablespace->placement);
+
+    if (!placement)
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_placement_release, placement);
+
+    // Partitions owners are chosen from the current cluster nodes and never changed
+    mdv_table_desc table_desc = *desc;
+
+    mdv_placement_assign(placement, &table_desc);
+
+    mdv_uuid const uuid = mdv_uuid_generate();
+
+    mdv_table *table = mdv_table_create(&uuid, &table_desc);
+
+    if (!table)
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_table_release, table);
+
+    binn obj;
+
+    if (!mdv_binn_table(table, &obj))
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, binn_free, &obj);
+
+    int const binn_obj_size = binn_size(&obj);
+
+    size_t const op_size = offsetof(mdv_trlog_op, payload)
+                            + binn_obj_size;
 
     mdv_trlog_op *op = mdv_alloc(op_size);
 
-    if (!op)
+    if (!op)
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_free, op);
+
+    op->size = op_size;
+    op->type = MDV_OP_TABLE_CREATE;
+    memcpy(op->payload, binn_ptr(&obj), binn_obj_size);
+
+    if (!mdv_trlog_add_op(trlog, op, 0))
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_table_retain(table);
+
+    mdv_rollback(rollbacker);
+
+    return table;
+}
+
+
+/// Rowset split by partitions
+typedef struct
+{
+    uint32_t    count;      ///< Rows count in partition
+    binn        rows;       ///< Partition rows
+} mdv_tablespace_partition_rows;
+
+
+static void mdv_tablespace_partition_rows_free(mdv_tablespace_partition_rows *partitions)
+{
+    for(uint32_t i = 0; i < MDV_PARTITIONS; ++i)
     {
-        mdv_rollback(rollbacker);
+        if (partitions[i].count)
+            binn_free(&partitions[i].rows);
+    }
+
+    mdv_free(partitions);
+}
+
+
+static mdv_tablespace_partition_rows * mdv_tablespace_rowset_split(mdv_table_desc const *desc, binn *rowset)
+{
+    mdv_tablespace_partition_rows *partitions = mdv_alloc(MDV_PARTITIONS * sizeof(mdv_tablespace_partition_rows));
+
+    if (!partitions)
+    {
+        MDV_LOGE("No memory for rowset partitions");
         return 0;
     }
 
-    mdv_rollbacker_push(rollbacker, mdv_free, op);
+    memset(partitions, 0, MDV_PARTITIONS * sizeof(mdv_tablespace_partition_rows));
 
-    op->size = op_size;
-    op->type = MDV_OP_TABLE_CREATE;
-    memcpy(op->payload, binn_ptr(&obj), binn_obj_size);
+    binn_iter iter = {};
+    binn item = {};
+
+    binn_list_foreach(rowset, item)
+    {
+        binn row;
+
+        if (!binn_load(binn_ptr(&item), &row))
+        {
+            MDV_LOGE("Invalid serialized row");
+            mdv_tablespace_partition_rows_free(partitions);
+            return 0;
+        }
+
+        mdv_tablespace_partition_rows *partition = partitions + mdv_placement_partition(desc, &row);
+
+        binn_free(&row);
+
+        if (!partition->count && !binn_create_list(&partition->rows))
+        {
+            MDV_LOGE("No memory for rowset partitions");
+            mdv_tablespace_partition_rows_free(partitions);
+            return 0;
+        }
+
+        ++partition->count;
+
+        if (!binn_list_add_list(&partition->rows, binn_ptr(&item)))
+        {
+            MDV_LOGE("No memory for rowset partitions");
+            mdv_tablespace_partition_rows_free(partitions);
+            return 0;
+        }
+    }
+
+    return partitions;
+}
+
+
+/**
+ * @brief Insert new records into the transaction log for data insertion into the table partitions.
+ * @details Rows are grouped by partitions, so each node receives only the partitions it stores.
+ */
+static mdv_errno mdv_tablespace_log_partitions(mdv_trlog *trlog,
+                                               mdv_table_desc const *desc,
+                                               mdv_uuid const *table_id,
+                                               uint64_t id,
+                                               binn *rowset)
+{
+    mdv_tablespace_partition_rows *partitions = mdv_tablespace_rowset_split(desc, rowset);
+
+    if (!partitions)
+        return MDV_FAILED;
+
+    for(uint32_t partition = 0; partition < MDV_PARTITIONS; ++partition)
+    {
+        mdv_tablespace_partition_rows *rows = partitions + partition;
+
+        if (!rows->count)
+            continue;
+
+        mdv_data const payload[] =
+        {
+            { sizeof id,                &id },
+            { sizeof *table_id,         (void*)table_id },
+            { sizeof partition,         &partition },
+            { binn_size(&rows->rows),   binn_ptr(&rows->rows) }
+        };
+
+        if (!mdv_trlog_add_opv(trlog, MDV_OP_PARTITION_INSERT, payload, sizeof payload / sizeof *payload, 0))
+        {
+            mdv_tablespace_partition_rows_free(partitions);
+            return MDV_FAILED;
+        }
+
+        id += rows->count;
+    }
+
+    mdv_tablespace_partition_rows_free(partitions);
+
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_tablespace_log_rowset(mdv_tablespace *tablespace, mdv_uuid const *table_id, binn *rowset)
+{
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(4);
+
+    mdv_trlog *trlog = mdv_tablespace_trlog_create(tablespace, &tablespace->uuid);
 
-    if (!mdv_trlog_add_op(trlog, op))
+    if (!trlog)
     {
         mdv_rollback(rollbacker);
-        return 0;
+        return MDV_FAILED;
     }
 
-    mdv_table_retain(table);
+    mdv_rollbacker_push(rollbacker, mdv_trlog_release, trlog);
+
+    mdv_rowdata *rowdata = mdv_tablespace_rowdata_create(tablespace, table_id);
+
+    if (!rowdata)
+    {
+        mdv_rollback(rollbacker);
+        return MDV_FAILED;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_rowdata_release, rowdata);
+
+    mdv_table *table = mdv_tables_get(tablespace->tables, table_id);
+
+    if (!table)
+    {
+        mdv_rollback(rollbacker);
+        return MDV_FAILED;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_table_release, table);
+
+    uint64_t id = 0;
+
+    mdv_errno err = mdv_rowdata_reserve(rowdata, mdv_binn_list_length(rowset), &id);
+
+    if (err != MDV_OK)
+    {
+        mdv_rollback(rollbacker);
+        return err;
+    }
+
+    mdv_table_desc const *desc = mdv_table_description(table);
+
+    if (mdv_placement_enabled(desc))
+    {
+        err = mdv_tablespace_log_partitions(trlog, desc, table_id, id, rowset);
+        mdv_rollback(rollbacker);
+        return err;
+    }
+
+    // Serialized rows are written to the transaction log as is, without intermediate copying
+    mdv_data const payload[] =
+    {
+        { sizeof id,            &id },
+        { sizeof *table_id,     (void*)table_id },
+        { binn_size(rowset),    binn_ptr(rowset) }
+    };
+
+    if (!mdv_trlog_add_opv(trlog, MDV_OP_ROW_INSERT, payload, sizeof payload / sizeof *payload, 0))
+    {
+        mdv_rollback(rollbacker);
+        return MDV_FAILED;
+    }
 
     mdv_rollback(rollbacker);
 
-    return table;
+    return MDV_OK;
+}
+
+
+/**
+ * @brief Logs the deletion of the rows which are matched by predicate
+ * @details If the partitions mask is given, only the rows of these partitions are deleted.
+ */
+static mdv_errno mdv_tablespace_log_delete_local(mdv_tablespace    *tablespace,
+                                                 mdv_table         *table,
+                                                 mdv_predicate     *predicate,
+                                                 mdv_bitset const  *partitions)
+{
+    mdv_uuid const *table_id = mdv_table_uuid(table);
+
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(4);
+
+    mdv_trlog *trlog = mdv_tablespace_trlog_create(tablespace, &tablespace->uuid);
+
+    if (!trlog)
+    {
+        mdv_rollback(rollbacker);
+        return MDV_FAILED;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_trlog_release, trlog);
+
+    mdv_rowdata *rowdata = mdv_tablespace_rowdata_create(tablespace, table_id);
+
+    if (!rowdata)
+    {
+        mdv_rollback(rollbacker);
+        return MDV_FAILED;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_rowdata_release, rowdata);
+
+    mdv_vector *ids = mdv_vector_create(MDV_TABLESPACE_DELETE_BATCH, sizeof(mdv_objid), &mdv_default_allocator);
+
+    if (!ids)
+    {
+        MDV_LOGE("No memory for rows identifiers");
+        mdv_rollback(rollbacker);
+        return MDV_NO_MEM;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_vector_release, ids);
+
+    // VM stack is allocated on the stack of current thread
+    size_t vm_stack[(offsetof(mdv_stack_base, data) + MDV_CONFIG.fetcher.vm_stack) / sizeof(size_t) + 1];
+
+    mdv_stack_base *stack = (mdv_stack_base *)vm_stack;
+    stack->capacity = MDV_CONFIG.fetcher.vm_stack;
+    stack->size = 0;
+
+    mdv_rowdata_partitions_predicate ctx =
+    {
+        .predicate =
+        {
+            .predicate = predicate,
+            .stack = stack
+        },
+        .desc = mdv_table_description(table),
+        .partitions = partitions
+    };
+
+    mdv_errno err = partitions
+                        ? mdv_rowdata_select_ids(rowdata, ids, mdv_rowdata_partitions_filter, &ctx)
+                        : mdv_rowdata_select_ids(rowdata, ids, mdv_rowdata_predicate_filter, &ctx.predicate);
+
+    if (err != MDV_OK)
+    {
+        mdv_rollback(rollbacker);
+        return err;
+    }
+
+    mdv_idmap *idmap = mdv_safeptr_get(tablespace->storage_ids);
+
+    if (!idmap)
+    {
+        mdv_rollback(rollbacker);
+        return MDV_FAILED;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_idmap_release, idmap);
+
+    mdv_objid const *rowids = mdv_vector_data(ids);
+    size_t const rowids_count = mdv_vector_size(ids);
+
+    for(size_t i = 0; i < rowids_count; i += MDV_TABLESPACE_DELETE_BATCH)
+    {
+        size_t const count = rowids_count - i < MDV_TABLESPACE_DELETE_BATCH
+                                ? rowids_count - i
+                                : MDV_TABLESPACE_DELETE_BATCH;
+
+        size_t const op_size = offsetof(mdv_trlog_op, payload)
+                                + sizeof *table_id
+                                + count * sizeof(mdv_gobjid);
+
+        mdv_trlog_op *op = mdv_alloc(op_size);
+
+        if (!op)
+        {
+            mdv_rollback(rollbacker);
+            return MDV_NO_MEM;
+        }
+
+        op->size = op_size;
+        op->type = MDV_OP_ROW_DELETE;
+
+        uint8_t *payload = op->payload;
+
+        memcpy(payload, table_id, sizeof *table_id);            payload += sizeof *table_id;
+
+        // Local storage identifiers are different on other nodes
+        if (!mdv_idmap_objids_global(idmap, rowids + i, count, (mdv_gobjid *)payload))
+        {
+            mdv_free(op);
+            mdv_rollback(rollbacker);
+            return MDV_FAILED;
+        }
+
+        bool const added = mdv_trlog_add_op(trlog, op, 0);
+
+        mdv_free(op);
+
+        if (!added)
+        {
+            mdv_rollback(rollbacker);
+            return MDV_FAILED;
+        }
+    }
+
+    mdv_rollback(rollbacker);
+
+    return MDV_OK;
+}
+
+
+/**
+ * @brief Logs the deletion of the rows from the table which rows are distributed between cluster nodes
+ * @details Partitions are grouped by the nodes which are preferred for reading (the same way as the rows are selected).
+ *          Rows of the current node partitions are deleted locally, other owners delete the rows of their partitions.
+ *          If some owner isn't directly connected to the current node, the rows deletion is rejected.
+ */
+static mdv_errno mdv_tablespace_log_delete_distributed(mdv_tablespace *tablespace,
+                                                       mdv_table      *table,
+                                                       mdv_predicate  *predicate,
+                                                       char const     *filter)
+{
+    mdv_placement *placement = mdv_safeptr_get(tablespace->placement);
+
+    if (!placement)
+        return MDV_FAILED;
+
+    mdv_uuid    owners[MDV_PARTITIONS];
+    mdv_bitset *partitions[MDV_PARTITIONS];
+
+    size_t count = 0;
+
+    mdv_errno err = MDV_OK;
+
+    for(uint32_t partition = 0; partition < MDV_PARTITIONS; ++partition)
+    {
+        mdv_uuid const *owner = mdv_placement_reader(placement, mdv_table_description(table), partition);
+
+        if (mdv_uuid_cmp(owner, &tablespace->uuid) != 0
+            && !mdv_placement_neighbour(placement, owner))
+        {
+            char uuid_str[MDV_UUID_STR_LEN];
+            MDV_LOGE("Partitions owner '%s' is unreachable", mdv_uuid_to_str(owner, uuid_str));
+            err = MDV_EAGAIN;
+            break;
+        }
+
+        size_t i = 0;
+
+        while(i < count && mdv_uuid_cmp(owners + i, owner) != 0)
+            ++i;
+
+        if (i == count)
+        {
+            partitions[i] = mdv_bitset_create(MDV_PARTITIONS, &mdv_default_allocator);
+
+            if (!partitions[i])
+            {
+                MDV_LOGE("No memory for partitions mask");
+                err = MDV_NO_MEM;
+                break;
+            }
+
+            owners[i] = *owner;
+            ++count;
+        }
+
+        mdv_bitset_set(partitions[i], partition);
+    }
+
+    mdv_placement_release(placement);
+
+    mdv_remote_delete *del = err == MDV_OK
+                                ? mdv_remote_delete_create(tablespace->ebus, &tablespace->uuid, mdv_table_uuid(table), filter)
+                                : 0;
+
+    if (err == MDV_OK && !del)
+        err = MDV_FAILED;
+
+    // Requests are sent before the local rows deletion, so the owners delete the rows concurrently
+    for(size_t i = 0; err == MDV_OK && i < count; ++i)
+    {
+        if (mdv_uuid_cmp(owners + i, &tablespace->uuid) != 0)
+            err = mdv_remote_delete_send(del, owners + i, partitions[i]);
+    }
+
+    for(size_t i = 0; err == MDV_OK && i < count; ++i)
+    {
+        if (mdv_uuid_cmp(owners + i, &tablespace->uuid) == 0)
+            err = mdv_tablespace_log_delete_local(tablespace, table, predicate, partitions[i]);
+    }
+
+    // Owners which received the requests are waited even if the local rows deletion is failed
+    if (del)
+    {
+        mdv_errno const remote_err = mdv_remote_delete_wait(del);
+
+        if (err == MDV_OK)
+            err = remote_err;
+
+        mdv_remote_delete_free(del);
+    }
+
+    for(size_t i = 0; i < count; ++i)
+        mdv_bitset_release(partitions[i]);
+
+    return err;
+}
+
+
+static mdv_errno mdv_tablespace_log_delete(mdv_tablespace *tablespace, mdv_uuid const *table_id, char const *filter)
+{
+    mdv_table *table = mdv_tables_get(tablespace->tables, table_id);
+
+    if (!table)
+    {
+        MDV_LOGE("Table not found");
+        return MDV_FAILED;
+    }
+
+    mdv_predicate *predicate = mdv_predicate_parse(mdv_table_description(table), filter);
+
+    if (!predicate)
+    {
+        mdv_table_release(table);
+        return MDV_INVALID_ARG;
+    }
+
+    mdv_errno const err = mdv_placement_enabled(mdv_table_description(table))
+                            ? mdv_tablespace_log_delete_distributed(tablespace, table, predicate, filter)
+                            : mdv_tablespace_log_delete_local(tablespace, table, predicate, 0);
+
+    mdv_predicate_release(predicate);
+    mdv_table_release(table);
+
+    return err;
 }
 
 
-static mdv_errno mdv_tablespace_log_rowset(mdv_tablespace *tablespace, mdv_uuid const *table_id, binn *rowset)
+static mdv_errno mdv_tablespace_log_delete_remote(mdv_tablespace *tablespace, mdv_evt_rowdata_del_remote *del)
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
-
-    mdv_trlog *trlog = mdv_tablespace_trlog_create(tablespace, &tablespace->uuid);
+    mdv_table *table = mdv_tables_get(tablespace->tables, &del->table);
 
-    if (!trlog)
+    if (!table)
     {
-        mdv_rollback(rollbacker);
+        MDV_LOGE("Table not found");
         return MDV_FAILED;
     }
 
-    mdv_rollbacker_push(rollbacker, mdv_trlog_release, trlog);
-
-    mdv_rowdata *rowdata = mdv_tablespace_rowdata_create(tablespace, table_id);
+    mdv_placement *placement = mdv_safeptr_get(tablespace->placement);
 
-    if (!rowdata)
+    if (!placement)
     {
-        mdv_rollback(rollbacker);
+        mdv_table_release(table);
         return MDV_FAILED;
     }
 
-    mdv_rollbacker_push(rollbacker, mdv_rowdata_release, rowdata);
-
-    uint64_t id = 0;
-
-    mdv_errno err = mdv_rowdata_reserve(rowdata, mdv_binn_list_length(rowset), &id);
+    bool owns = true;
 
-    if (err != MDV_OK)
+    for(uint32_t partition = 0; owns && partition < MDV_PARTITIONS; ++partition)
     {
-        mdv_rollback(rollbacker);
-        return err;
+        if (mdv_bitset_test(del->partitions, partition))
+            owns = mdv_placement_owns(placement, mdv_table_description(table), partition);
     }
 
-    int const binn_rowset_size = binn_size(rowset);
+    mdv_placement_release(placement);
 
-    size_t const op_size = offsetof(mdv_trlog_op, payload)
-                            + sizeof id
-                            + sizeof *table_id
-                            + binn_rowset_size;
+    if (!owns)
+    {
+        MDV_LOGE("Rows deletion from the foreign partitions is rejected");
+        mdv_table_release(table);
+        return MDV_INVALID_ARG;
+    }
 
-    mdv_trlog_op *op = mdv_alloc(op_size);
+    mdv_predicate *predicate = mdv_predicate_parse(mdv_table_description(table), del->filter);
 
-    if (!op)
+    if (!predicate)
     {
-        mdv_rollback(rollbacker);
-        return MDV_NO_MEM;
+        mdv_table_release(table);
+        return MDV_INVALID_ARG;
     }
 
-    mdv_rollbacker_push(rollbacker, mdv_free, op);
+    mdv_errno const err = mdv_tablespace_log_delete_local(tablespace, table, predicate, del->partitions);
 
-    op->size = op_size;
-    op->type = MDV_OP_ROW_INSERT;
+    mdv_predicate_release(predicate);
+    mdv_table_release(table);
 
-    uint8_t *payload = op->payload;
+    return err;
+}
 
-    memcpy(payload, &id, sizeof id);                        payload += sizeof id;
-    memcpy(payload, table_id, sizeof *table_id);            payload += sizeof *table_id;
-    memcpy(payload, binn_ptr(rowset), binn_rowset_size);    payload += binn_rowset_size;
 
-    if (!mdv_trlog_add_op(trlog, op))
-    {
-        mdv_rollback(rollbacker);
-        return MDV_FAILED;
-    }
+/// Row operation which is deferred until the batch commit
+typedef struct
+{
+    uint64_t        pos;        ///< Operation position in transaction log
+    mdv_trlog_op   *op;         ///< DB operation
+} mdv_tablespace_deferred_op;
 
-    mdv_rollback(rollbacker);
 
-    return MDV_OK;
-}
+/// Row operations for one table which are applied within one transaction
+typedef struct
+{
+    mdv_uuid        table_id;   ///< Table identifier
+    mdv_vector     *ops;        ///< Deferred operations (vector<mdv_tablespace_deferred_op>)
+} mdv_tablespace_table_ops;
 
 
 typedef struct
 {
     mdv_tablespace *tablespace;
+    mdv_uuid const *trlog;      ///< Transaction log UUID
     uint32_t        node_id;
+    mdv_jobber     *jobber;     ///< Jobs scheduler for concurrent tables updating (may be NULL)
+    mdv_vector     *tables;     ///< Deferred operations grouped by tables (vector<mdv_tablespace_table_ops>)
+    mdv_placement  *placement;  ///< Partitioned tables rows placement
+    mdv_table      *table;      ///< Last partitioned table (table descriptors lookup cache)
+    mdv_idmap      *idmap;      ///< Storage identifiers map
 } mdv_tablespace_trlog_apply_context;
 
 
-static bool mdv_tablespace_trlog_apply(void *arg, mdv_trlog_op *op)
+static void mdv_tablespace_deferred_ops_clear(mdv_vector/*<mdv_tablespace_table_ops>*/ *tables)
+{
+    mdv_vector_foreach(tables, mdv_tablespace_table_ops, table)
+        mdv_vector_release(table->ops);
+    mdv_vector_clear(tables);
+}
+
+
+static bool mdv_tablespace_op_defer(mdv_tablespace_trlog_apply_context *context,
+                                    mdv_uuid const *table_id,
+                                    uint64_t pos,
+                                    mdv_trlog_op *op)
+{
+    mdv_tablespace_table_ops *table_ops = 0;
+
+    mdv_vector_foreach(context->tables, mdv_tablespace_table_ops, table)
+    {
+        if (mdv_uuid_cmp(&table->table_id, table_id) == 0)
+        {
+            table_ops = table;
+            break;
+        }
+    }
+
+    if (!table_ops)
+    {
+        mdv_tablespace_table_ops new_table_ops =
+        {
+            .table_id = *table_id,
+            .ops = mdv_vector_create(MDV_CONFIG.committer.batch_size,
+                                     sizeof(mdv_tablespace_deferred_op),
+                                     &mdv_default_allocator)
+        };
+
+        if (!new_table_ops.ops)
+        {
+            MDV_LOGE("No memory for deferred operations");
+            return false;
+        }
+
+        table_ops = mdv_vector_push_back(context->tables, &new_table_ops);
+
+        if (!table_ops)
+        {
+            MDV_LOGE("No memory for deferred operations");
+            mdv_vector_release(new_table_ops.ops);
+            return false;
+        }
+    }
+
+    mdv_tablespace_deferred_op const deferred_op =
+    {
+        .pos = pos,
+        .op = op
+    };
+
+    if (!mdv_vector_push_back(table_ops->ops, &deferred_op))
+    {
+        MDV_LOGE("No memory for deferred operation");
+        return false;
+    }
+
+    return true;
+}
+
+
+static bool mdv_tablespace_trlog_apply(void *arg, uint64_t pos, mdv_trlog_op *op)
 {
     mdv_tablespace_trlog_apply_context *context = arg;
     mdv_tablespace *tablespace = context->tablespace;
@@ -700,53 +2231,357 @@ static bool mdv_tablespace_trlog_apply(void *arg, mdv_trlog_op *op)
 
         case MDV_OP_ROW_INSERT:
         {
-            uint8_t *payload = op->payload;
-
-            uint64_t id;
             mdv_uuid table_id;
+            memcpy(&table_id, op->payload + sizeof(uint64_t), sizeof table_id);
+            ret = mdv_tablespace_op_defer(context, &table_id, pos, op);
+            break;
+        }
 
-            memcpy(&id, payload, sizeof id);                payload += sizeof id;
-            memcpy(&table_id, payload, sizeof table_id);    payload += sizeof table_id;
+        case MDV_OP_ROW_DELETE:
+        {
+            mdv_uuid table_id;
+            memcpy(&table_id, op->payload, sizeof table_id);
+            ret = mdv_tablespace_op_defer(context, &table_id, pos, op);
+            break;
+        }
 
-            binn rowset;
+        case MDV_OP_PARTITION_INSERT:
+        {
+            mdv_uuid table_id;
+            uint32_t partition;
+            memcpy(&table_id, op->payload + sizeof(uint64_t), sizeof table_id);
+            memcpy(&partition, op->payload + sizeof(uint64_t) + sizeof table_id, sizeof partition);
 
-            ret = binn_load(payload, &rowset);
+            mdv_table_desc const *desc = mdv_tablespace_table_cached(tablespace, &context->table, &table_id);
 
-            if (!ret)
+            if (!desc)
             {
-                MDV_LOGE("Invalid rowset");
-                break;
+                MDV_LOGE("Table not found");
+                return false;
             }
 
-            mdv_rowdata *rowdata = mdv_tablespace_rowdata_create(tablespace, &table_id);
+            // Partitions which are stored by other nodes are skipped
+            if (mdv_placement_owns(context->placement, desc, partition))
+                ret = mdv_tablespace_op_defer(context, &table_id, pos, op);
+            break;
+        }
 
-            if (rowdata)
-            {
-                mdv_objid const rowid =
-                {
-                    .node = context->node_id,
-                    .id = id
-                };
+        case MDV_OP_NOP:
+            break;
+
+        default:
+            MDV_LOGE("Unsupported DB operation");
+    }
+
+    return ret;
+}
 
-                ret = mdv_rowdata_add_raw_rowset(rowdata, &rowid, &rowset) == MDV_OK;
 
-                mdv_rowdata_release(rowdata);
-            }
+static bool mdv_tablespace_batch_insert(mdv_rowdata_batch *batch, uint32_t node_id, uint64_t pos, mdv_trlog_op *op)
+{
+    uint8_t *payload = op->payload;
 
-            binn_free(&rowset);
+    uint64_t id;
 
-            break;
+    memcpy(&id, payload, sizeof id);                payload += sizeof id;
+    payload += sizeof(mdv_uuid);                    // table_id
+
+    if (op->type == MDV_OP_PARTITION_INSERT)
+        payload += sizeof(uint32_t);                // partition
+
+    binn rowset;
+
+    if (!binn_load(payload, &rowset))
+    {
+        MDV_LOGE("Invalid rowset");
+        return false;
+    }
+
+    mdv_objid const rowid =
+    {
+        .node = node_id,
+        .id = id
+    };
+
+    bool const ret = mdv_rowdata_batch_add_rowset(batch, pos, &rowid, &rowset) == MDV_OK;
+
+    binn_free(&rowset);
+
+    return ret;
+}
+
+
+static bool mdv_tablespace_batch_delete(mdv_rowdata_batch *batch, mdv_idmap const *idmap, uint32_t node_id, uint64_t pos, mdv_trlog_op *op)
+{
+    uint8_t *payload = op->payload + sizeof(mdv_uuid);      // table_id
+
+    size_t const ids_size = op->size - offsetof(mdv_trlog_op, payload) - sizeof(mdv_uuid);
+
+    if (ids_size % sizeof(mdv_gobjid))
+    {
+        MDV_LOGE("Invalid transaction operation");
+        return false;
+    }
+
+    size_t const count = ids_size / sizeof(mdv_gobjid);
+
+    mdv_objid *ids = mdv_alloc(count * sizeof(mdv_objid) + 1);
+
+    if (!ids)
+    {
+        MDV_LOGE("No memory for rows identifiers");
+        return false;
+    }
+
+    // Rows identifiers are logged by coordinator as node independent identifiers
+    if (!mdv_idmap_objids_local(idmap, (mdv_gobjid const *)payload, count, ids))
+    {
+        mdv_free(ids);
+        return false;
+    }
+
+    mdv_objid const op_pos =
+    {
+        .node = node_id,
+        .id = pos
+    };
+
+    bool const ret = mdv_rowdata_batch_remove(batch, &op_pos, ids, count) == MDV_OK;
+
+    mdv_free(ids);
+
+    return ret;
+}
+
+
+/**
+ * @brief Applies deferred row operations of one table within one transaction
+ * @details Transaction log application position is saved in the same transaction.
+ *          Operations which are already applied to the table are skipped.
+ */
+static bool mdv_tablespace_table_ops_apply(mdv_tablespace_trlog_apply_context *context,
+                                           mdv_tablespace_table_ops *table_ops,
+                                           uint64_t applied_pos)
+{
+    mdv_rowdata *rowdata = mdv_tablespace_rowdata_create(context->tablespace, &table_ops->table_id);
+
+    if (!rowdata)
+        return true;
+
+    mdv_rowdata_batch *batch = mdv_rowdata_batch_begin(rowdata, context->trlog);
+
+    mdv_rowdata_release(rowdata);
+
+    if (!batch)
+        return false;
+
+    mdv_vector_foreach(table_ops->ops, mdv_tablespace_deferred_op, deferred)
+    {
+        bool const ok = deferred->op->type != MDV_OP_ROW_DELETE
+                            ? mdv_tablespace_batch_insert(batch, context->node_id, deferred->pos, deferred->op)
+                            : mdv_tablespace_batch_delete(batch, context->idmap, context->node_id, deferred->pos, deferred->op);
+
+        if (!ok)
+        {
+            mdv_rowdata_batch_abort(batch);
+            return false;
         }
+    }
 
-        default:
-            MDV_LOGE("Unsupported DB operation");
+    return mdv_rowdata_batch_commit(batch, applied_pos) == MDV_OK;
+}
+
+
+/**
+ * @brief Tables batches which are applied concurrently
+ * @details Each table batch is applied by one thread, so operations order for each table is kept.
+ *          Batches are distributed between committer jobs and the thread which started the commit.
+ *          Jobs which are started after all batches are taken do nothing.
+ */
+typedef struct
+{
+    atomic_uint                          rc;            ///< References counter
+    mdv_tablespace_trlog_apply_context  *context;       ///< Apply context (valid until all batches are applied)
+    uint64_t                             applied_pos;   ///< New transaction log application position
+    size_t                               count;         ///< Tables batches count
+    atomic_size_t                        next;          ///< Next table batch for applying
+    atomic_size_t                        done;          ///< Applied tables batches count
+    atomic_bool                          failed;        ///< Flag indicates that some table batch wasn't applied
+    mdv_condvar                          cv;            ///< Conditional variable for tables batches applying completion
+} mdv_tablespace_partitions;
+
+
+typedef mdv_job(mdv_tablespace_partitions *)    mdv_tablespace_partitions_job;
+
+
+static mdv_tablespace_partitions * mdv_tablespace_partitions_create(mdv_tablespace_trlog_apply_context *context, uint64_t applied_pos)
+{
+    mdv_tablespace_partitions *partitions = mdv_alloc(sizeof(mdv_tablespace_partitions));
+
+    if (!partitions)
+    {
+        MDV_LOGE("No memory for tables batches");
+        return 0;
+    }
+
+    if (mdv_condvar_create(&partitions->cv) != MDV_OK)
+    {
+        MDV_LOGE("Conditional variable for tables batches not created");
+        mdv_free(partitions);
+        return 0;
+    }
+
+    atomic_init(&partitions->rc, 1);
+    atomic_init(&partitions->next, 0);
+    atomic_init(&partitions->done, 0);
+    atomic_init(&partitions->failed, false);
+
+    partitions->context = context;
+    partitions->applied_pos = applied_pos;
+    partitions->count = mdv_vector_size(context->tables);
+
+    return partitions;
+}
+
+
+static mdv_tablespace_partitions * mdv_tablespace_partitions_retain(mdv_tablespace_partitions *partitions)
+{
+    atomic_fetch_add_explicit(&partitions->rc, 1, memory_order_acquire);
+    return partitions;
+}
+
+
+static void mdv_tablespace_partitions_release(mdv_tablespace_partitions *partitions)
+{
+    if (atomic_fetch_sub_explicit(&partitions->rc, 1, memory_order_release) == 1)
+    {
+        mdv_condvar_free(&partitions->cv);
+        mdv_free(partitions);
+    }
+}
+
+
+static void mdv_tablespace_partitions_apply(mdv_tablespace_partitions *partitions)
+{
+    for(size_t i = atomic_fetch_add_explicit(&partitions->next, 1, memory_order_relaxed);
+        i < partitions->count;
+        i = atomic_fetch_add_explicit(&partitions->next, 1, memory_order_relaxed))
+    {
+        mdv_tablespace_trlog_apply_context *context = partitions->context;
+
+        if (!mdv_tablespace_table_ops_apply(context,
+                                            mdv_vector_at(context->tables, i),
+                                            partitions->applied_pos))
+        {
+            MDV_LOGE("Table operations batch not applied");
+            atomic_store_explicit(&partitions->failed, true, memory_order_relaxed);
+        }
+
+        // Apply context can't be used after the last batch is applied
+        if (atomic_fetch_add_explicit(&partitions->done, 1, memory_order_acq_rel) + 1 == partitions->count)
+            mdv_condvar_signal(&partitions->cv);
+    }
+}
+
+
+static void mdv_tablespace_partitions_fn(mdv_job_base *job)
+{
+    mdv_tablespace_partitions *partitions = *(mdv_tablespace_partitions **)job->data;
+    mdv_tablespace_partitions_apply(partitions);
+}
+
+
+static void mdv_tablespace_partitions_finalize(mdv_job_base *job)
+{
+    mdv_tablespace_partitions *partitions = *(mdv_tablespace_partitions **)job->data;
+    mdv_tablespace_partitions_release(partitions);
+    mdv_free(job);
+}
+
+
+static void mdv_tablespace_partitions_job_emit(mdv_jobber *jobber, mdv_tablespace_partitions *partitions)
+{
+    mdv_tablespace_partitions_job *job = mdv_alloc(sizeof(mdv_tablespace_partitions_job));
+
+    if (!job)
+    {
+        MDV_LOGW("No memory for tables batch job");
+        return;
+    }
+
+    job->fn       = mdv_tablespace_partitions_fn;
+    job->finalize = mdv_tablespace_partitions_finalize;
+    job->data     = mdv_tablespace_partitions_retain(partitions);
+
+    if (mdv_jobber_push(jobber, (mdv_job_base*)job) != MDV_OK)
+    {
+        MDV_LOGW("Tables batch job failed");
+        mdv_tablespace_partitions_release(partitions);
+        mdv_free(job);
+    }
+}
+
+
+/**
+ * @brief Applies tables batches concurrently
+ * @details Current thread applies tables batches too. So the batches are applied even if all jobber threads are busy.
+ */
+static bool mdv_tablespace_partitions_commit(mdv_tablespace_trlog_apply_context *context, uint64_t applied_pos)
+{
+    mdv_tablespace_partitions *partitions = mdv_tablespace_partitions_create(context, applied_pos);
+
+    if (!partitions)
+        return false;
+
+    size_t jobs = partitions->count - 1;
+
+    if (jobs > MDV_CONFIG.committer.workers)
+        jobs = MDV_CONFIG.committer.workers;
+
+    for(size_t i = 0; i < jobs; ++i)
+        mdv_tablespace_partitions_job_emit(context->jobber, partitions);
+
+    mdv_tablespace_partitions_apply(partitions);
+
+    while(atomic_load_explicit(&partitions->done, memory_order_acquire) < partitions->count)
+        mdv_condvar_timedwait(&partitions->cv, 10);
+
+    bool const ret = !atomic_load_explicit(&partitions->failed, memory_order_relaxed);
+
+    mdv_tablespace_partitions_release(partitions);
+
+    return ret;
+}
+
+
+static bool mdv_tablespace_trlog_commit(void *arg, uint64_t applied_pos)
+{
+    mdv_tablespace_trlog_apply_context *context = arg;
+
+    bool ret = true;
+
+    if (context->jobber && mdv_vector_size(context->tables) > 1)
+        ret = mdv_tablespace_partitions_commit(context, applied_pos);
+    else
+    {
+        mdv_vector_foreach(context->tables, mdv_tablespace_table_ops, table_ops)
+        {
+            if (!mdv_tablespace_table_ops_apply(context, table_ops, applied_pos))
+            {
+                MDV_LOGE("Table operations batch not applied");
+                ret = false;
+                break;
+            }
+        }
     }
 
+    mdv_tablespace_deferred_ops_clear(context->tables);
+
     return ret;
 }
 
 
-bool mdv_tablespace_log_apply(mdv_tablespace *tablespace, mdv_uuid const *storage)
+bool mdv_tablespace_log_apply(mdv_tablespace *tablespace, mdv_uuid const *storage, mdv_jobber *jobber)
 {
     mdv_trlog *trlog = mdv_tablespace_trlog(tablespace, storage);
 
@@ -755,18 +2590,41 @@ bool mdv_tablespace_log_apply(mdv_tablespace *tablespace, mdv_uuid const *storag
         mdv_tablespace_trlog_apply_context context =
         {
             .tablespace = tablespace,
-            .node_id = mdv_trlog_id(trlog)
+            .trlog = mdv_trlog_uuid(trlog),
+            .node_id = mdv_trlog_id(trlog),
+            .jobber = jobber,
+            .tables = mdv_vector_create(4,
+                                        sizeof(mdv_tablespace_table_ops),
+                                        &mdv_default_allocator),
+            .placement = mdv_safeptr_get(tablespace->placement),
+            .idmap = mdv_safeptr_get(tablespace->storage_ids)
         };
 
+        if (!context.tables || !context.placement || !context.idmap)
+        {
+            MDV_LOGE("No memory for deferred operations");
+            mdv_vector_release(context.tables);
+            mdv_placement_release(context.placement);
+            mdv_idmap_release(context.idmap);
+            mdv_trlog_release(trlog);
+            return false;
+        }
+
         while(mdv_trlog_apply(trlog,
                               MDV_CONFIG.committer.batch_size,
                               &context,
-                              mdv_tablespace_trlog_apply)
+                              mdv_tablespace_trlog_apply,
+                              mdv_tablespace_trlog_commit)
                 >= MDV_CONFIG.committer.batch_size);
 
+        mdv_tablespace_deferred_ops_clear(context.tables);
+        mdv_vector_release(context.tables);
+        mdv_placement_release(context.placement);
+        mdv_table_release(context.table);
+        mdv_idmap_release(context.idmap);
+
         mdv_trlog_release(trlog);
     }
 
     return true;
 }
-
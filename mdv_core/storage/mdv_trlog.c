@@ -10,11 +10,30 @@
 #include <mdv_limits.h>
 #include <mdv_log.h>
 #include <mdv_filesystem.h>
+#include <mdv_mutex.h>
+#include <mdv_threads.h>
 #include <stdatomic.h>
 #include <assert.h>
+#include <string.h>
+#include <inttypes.h>
 
 
 static const uint32_t MDV_TRLOG_APPLIED_POS_KEY = 0;
+static const uint32_t MDV_TRLOG_BEGIN_POS_KEY = 1;
+
+
+/// Operation which is waiting for the group commit
+typedef struct mdv_trlog_waiter
+{
+    uint32_t                 type;              ///< DB operation type
+    uint32_t                 size;              ///< DB operation size
+    mdv_data const          *parts;             ///< DB operation payload parts
+    size_t                   count;             ///< DB operation payload parts count
+    uint64_t                 id;                ///< Assigned record identifier
+    bool                     done;              ///< Flag indicates that the operation is processed
+    bool                     ok;                ///< Flag indicates that the operation is written
+    struct mdv_trlog_waiter *next;              ///< Next pending operation
+} mdv_trlog_waiter;
 
 
 /// Transaction logs storage
@@ -26,6 +45,12 @@ struct mdv_trlog
     mdv_ebus               *ebus;               ///< Events bus
     atomic_uint_fast64_t    top;                ///< transaction log last insertion position
     atomic_uint_fast64_t    applied;            ///< transaction log application position
+    atomic_uint_fast64_t    begin;              ///< first position which isn't truncated
+    mdv_mutex               commit_mutex;       ///< Mutex for group commit (only one group is written at once)
+    mdv_mutex               queue_mutex;        ///< Mutex for pending operations guard
+    mdv_trlog_waiter       *queue_head;         ///< First pending operation
+    mdv_trlog_waiter       *queue_tail;         ///< Last pending operation
+    size_t                  queue_size;         ///< Pending operations size (in bytes)
 };
 
 
@@ -33,6 +58,7 @@ static void mdv_trlog_init(mdv_trlog *trlog)
 {
     atomic_init(&trlog->top, 0);
     atomic_init(&trlog->applied, 0);
+    atomic_init(&trlog->begin, 0);
 
     // Start transaction
     mdv_transaction transaction = mdv_transaction_start(trlog->storage);
@@ -82,10 +108,21 @@ static void mdv_trlog_init(mdv_trlog *trlog)
         if (mdv_map_get(&map, &transaction, &key, &value))
             atomic_init(&trlog->applied, *(uint64_t*)value.ptr);
 
+        mdv_data const begin_key = { sizeof MDV_TRLOG_BEGIN_POS_KEY, (void*)&MDV_TRLOG_BEGIN_POS_KEY };
+
+        if (mdv_map_get(&map, &transaction, &begin_key, &value))
+            atomic_init(&trlog->begin, *(uint64_t*)value.ptr);
+
         mdv_map_close(&map);
     } while(0);
 
     mdv_transaction_abort(&transaction);
+
+    // Transaction log may be moved forward without records (e.g. after snapshot installation)
+    uint64_t const applied = atomic_load(&trlog->applied);
+
+    if (atomic_load(&trlog->top) < applied)
+        atomic_init(&trlog->top, applied);
 }
 
 
@@ -108,7 +145,7 @@ static const mdv_event_handler_type mdv_trlog_handlers[] =
 
 mdv_trlog * mdv_trlog_open(mdv_ebus *ebus, char const *dir, mdv_uuid const *uuid, uint32_t id)
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(5);
 
     mdv_trlog *trlog = mdv_alloc(sizeof(mdv_trlog));
 
@@ -123,6 +160,27 @@ mdv_trlog * mdv_trlog_open(mdv_ebus *ebus, char const *dir, mdv_uuid const *uuid
 
     trlog->uuid = *uuid;
     trlog->id = id;
+    trlog->queue_head = 0;
+    trlog->queue_tail = 0;
+    trlog->queue_size = 0;
+
+    if (mdv_mutex_create(&trlog->commit_mutex) != MDV_OK)
+    {
+        MDV_LOGE("Mutex for group commit not created");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_mutex_free, &trlog->commit_mutex);
+
+    if (mdv_mutex_create(&trlog->queue_mutex) != MDV_OK)
+    {
+        MDV_LOGE("Mutex for pending operations not created");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_mutex_free, &trlog->queue_mutex);
 
     char storage_name[64];
 
@@ -186,6 +244,8 @@ uint32_t mdv_trlog_release(mdv_trlog *trlog)
                                  sizeof mdv_trlog_handlers / sizeof *mdv_trlog_handlers);
 
         mdv_ebus_release(trlog->ebus);
+        mdv_mutex_free(&trlog->queue_mutex);
+        mdv_mutex_free(&trlog->commit_mutex);
         mdv_free(trlog);
     }
 
@@ -211,6 +271,18 @@ uint64_t mdv_trlog_top(mdv_trlog *trlog)
 }
 
 
+uint64_t mdv_trlog_applied(mdv_trlog *trlog)
+{
+    return atomic_load(&trlog->applied);
+}
+
+
+uint64_t mdv_trlog_begin(mdv_trlog *trlog)
+{
+    return atomic_load(&trlog->begin);
+}
+
+
 static uint64_t mdv_trlog_new_id(mdv_trlog *trlog)
 {
     return atomic_fetch_add_explicit(&trlog->top, 1, memory_order_relaxed);
@@ -272,8 +344,86 @@ static void mdv_trlog_applied_pos_set(mdv_trlog *trlog, uint64_t applied_pos)
 }
 
 
-bool mdv_trlog_add(mdv_trlog *trlog,
-                   mdv_list/*<mdv_trlog_data>*/ const *ops)
+mdv_errno mdv_trlog_reset(mdv_trlog *trlog, uint64_t pos)
+{
+    if (mdv_mutex_lock(&trlog->commit_mutex) != MDV_OK)
+    {
+        MDV_LOGE("TR log commit mutex locking failed");
+        return MDV_FAILED;
+    }
+
+    mdv_errno err = MDV_FAILED;
+
+    do
+    {
+        if (atomic_load(&trlog->top) != 0)
+        {
+            MDV_LOGE("TR log isn't empty and it can't be reset");
+            err = MDV_EEXIST;
+            break;
+        }
+
+        // Start transaction
+        mdv_transaction transaction = mdv_transaction_start(trlog->storage);
+
+        if (!mdv_transaction_ok(transaction))
+        {
+            MDV_LOGE("TR log transaction not started");
+            break;
+        }
+
+        mdv_map map = mdv_map_open(&transaction,
+                                    MDV_MAP_APPLIED,
+                                    MDV_MAP_CREATE | MDV_MAP_INTEGERKEY);
+
+        if (!mdv_map_ok(map))
+        {
+            mdv_transaction_abort(&transaction);
+            break;
+        }
+
+        mdv_data const key = { sizeof MDV_TRLOG_APPLIED_POS_KEY, (void*)&MDV_TRLOG_APPLIED_POS_KEY };
+        mdv_data const begin_key = { sizeof MDV_TRLOG_BEGIN_POS_KEY, (void*)&MDV_TRLOG_BEGIN_POS_KEY };
+        mdv_data value = { sizeof pos, &pos };
+
+        // Records before the position aren't available
+        if (!mdv_map_put(&map, &transaction, &key, &value)
+            || !mdv_map_put(&map, &transaction, &begin_key, &value))
+        {
+            MDV_LOGE("TR log applied posiotion wasn't saved");
+            mdv_map_close(&map);
+            mdv_transaction_abort(&transaction);
+            break;
+        }
+
+        if (!mdv_transaction_commit(&transaction))
+        {
+            MDV_LOGE("Transaction failed.");
+            mdv_map_close(&map);
+            break;
+        }
+
+        mdv_map_close(&map);
+
+        atomic_store(&trlog->applied, pos);
+        atomic_store(&trlog->begin, pos);
+        atomic_store(&trlog->top, pos);
+
+        err = MDV_OK;
+    } while(0);
+
+    mdv_mutex_unlock(&trlog->commit_mutex);
+
+    if (err == MDV_OK)
+        mdv_trlog_changed_notify(trlog);
+
+    return err;
+}
+
+
+mdv_errno mdv_trlog_add(mdv_trlog *trlog,
+                        uint64_t from,
+                        mdv_list/*<mdv_trlog_data>*/ const *ops)
 {
     mdv_rollbacker *rollbacker = mdv_rollbacker_create(2);
 
@@ -284,11 +434,21 @@ bool mdv_trlog_add(mdv_trlog *trlog,
     {
         MDV_LOGE("TR log transaction failed");
         mdv_rollback(rollbacker);
-        return false;
+        return MDV_FAILED;
     }
 
     mdv_rollbacker_push(rollbacker, mdv_transaction_abort, &transaction);
 
+    // Write transactions are serialized. So the top can't be changed by other writers here.
+    uint64_t const top = atomic_load(&trlog->top);
+
+    if (from > top)
+    {
+        MDV_LOGW("TR log gap: records from %" PRIu64 " don't continue the top %" PRIu64, from, top);
+        mdv_rollback(rollbacker);
+        return MDV_EAGAIN;
+    }
+
     // Open transaction log
     mdv_map tr_log = mdv_map_open(&transaction,
                                   MDV_MAP_TRLOG,
@@ -298,7 +458,7 @@ bool mdv_trlog_add(mdv_trlog *trlog,
     {
         MDV_LOGE("Transaction log map '%s' not opened", MDV_MAP_TRLOG);
         mdv_rollback(rollbacker);
-        return false;
+        return MDV_FAILED;
     }
 
     mdv_rollbacker_push(rollbacker, mdv_map_close, &tr_log);
@@ -307,6 +467,9 @@ bool mdv_trlog_add(mdv_trlog *trlog,
 
     mdv_list_foreach(ops, mdv_trlog_data, op)
     {
+        if (op->id < top)           // Record is already in the transaction log
+            continue;
+
         mdv_data k = { sizeof op->id, &op->id };
         mdv_data v = { op->op.size, &op->op };
 
@@ -319,26 +482,122 @@ bool mdv_trlog_add(mdv_trlog *trlog,
             MDV_LOGW("OP insertion failed.");
     }
 
+    if (!changed)
+    {
+        mdv_rollback(rollbacker);
+        return MDV_OK;
+    }
+
     if (!mdv_transaction_commit(&transaction))
     {
         MDV_LOGE("TR log transaction failed");
         mdv_rollback(rollbacker);
-        return false;
+        return MDV_FAILED;
     }
 
     mdv_map_close(&tr_log);
 
     mdv_rollbacker_free(rollbacker);
 
-    if (changed)
-        mdv_trlog_changed_notify(trlog);
+    mdv_trlog_changed_notify(trlog);
 
-    return true;
+    return MDV_OK;
 }
 
 
-bool mdv_trlog_add_op(mdv_trlog *trlog,
-                      mdv_trlog_op const *op)
+static void mdv_trlog_enqueue(mdv_trlog *trlog, mdv_trlog_waiter *waiter)
+{
+    if (trlog->queue_tail)
+        trlog->queue_tail->next = waiter;
+    else
+        trlog->queue_head = waiter;
+
+    trlog->queue_tail = waiter;
+    trlog->queue_size += waiter->size;
+}
+
+
+static void mdv_trlog_dequeue(mdv_trlog *trlog, mdv_trlog_waiter *waiter)
+{
+    for(mdv_trlog_waiter **it = &trlog->queue_head; *it; it = &(*it)->next)
+    {
+        if (*it == waiter)
+        {
+            *it = waiter->next;
+
+            if (trlog->queue_tail == waiter)
+            {
+                trlog->queue_tail = 0;
+
+                for(mdv_trlog_waiter *w = trlog->queue_head; w; w = w->next)
+                    trlog->queue_tail = w;
+            }
+
+            trlog->queue_size -= waiter->size;
+            break;
+        }
+    }
+}
+
+
+/**
+ * @brief Takes pending operations for the group commit.
+ * @details Operations are taken until the group size reaches storage.group_commit_size bytes.
+ *          First operation is always taken.
+ */
+static mdv_trlog_waiter * mdv_trlog_group_take(mdv_trlog *trlog)
+{
+    mdv_trlog_waiter *group = 0;
+
+    if (mdv_mutex_lock(&trlog->queue_mutex) == MDV_OK)
+    {
+        group = trlog->queue_head;
+
+        mdv_trlog_waiter *last = 0;
+        size_t size = 0;
+
+        for(mdv_trlog_waiter *w = group; w; w = w->next)
+        {
+            if (last && size + w->size > MDV_CONFIG.storage.group_commit_size)
+                break;
+            size += w->size;
+            last = w;
+        }
+
+        if (last)
+        {
+            trlog->queue_head = last->next;
+            if (!trlog->queue_head)
+                trlog->queue_tail = 0;
+            trlog->queue_size -= size;
+            last->next = 0;
+        }
+
+        mdv_mutex_unlock(&trlog->queue_mutex);
+    }
+
+    return group;
+}
+
+
+static size_t mdv_trlog_queue_size(mdv_trlog *trlog)
+{
+    size_t size = 0;
+
+    if (mdv_mutex_lock(&trlog->queue_mutex) == MDV_OK)
+    {
+        size = trlog->queue_size;
+        mdv_mutex_unlock(&trlog->queue_mutex);
+    }
+
+    return size;
+}
+
+
+/**
+ * @brief Writes operations group to the transaction log within one transaction.
+ */
+static bool mdv_trlog_group_write(mdv_trlog *trlog, mdv_trlog_waiter *group)
 {
     mdv_rollbacker *rollbacker = mdv_rollbacker_create(2);
 
@@ -368,16 +627,32 @@ bool mdv_trlog_add_op(mdv_trlog *trlog,
 
     mdv_rollbacker_push(rollbacker, mdv_map_close, &tr_log);
 
-    uint64_t id = mdv_trlog_new_id(trlog);
+    for(mdv_trlog_waiter *w = group; w; w = w->next)
+    {
+        w->id = mdv_trlog_new_id(trlog);
 
-    mdv_data k = { sizeof id, &id };
-    mdv_data v = { op->size, (void*)op };
+        mdv_data k = { sizeof w->id, &w->id };
 
-    if (!mdv_map_put_unique(&tr_log, &transaction, &k, &v))
-    {
-        MDV_LOGW("OP insertion failed.");
-        mdv_rollback(rollbacker);
-        return false;
+        // Operation is assembled directly in the storage
+        mdv_trlog_op *op = mdv_map_reserve(&tr_log, &transaction, &k, w->size);
+
+        if (!op)
+        {
+            MDV_LOGW("OP insertion failed.");
+            mdv_rollback(rollbacker);
+            return false;
+        }
+
+        op->size = w->size;
+        op->type = w->type;
+
+        uint8_t *payload = op->payload;
+
+        for(size_t i = 0; i < w->count; ++i)
+        {
+            memcpy(payload, w->parts[i].ptr, w->parts[i].size);
+            payload += w->parts[i].size;
+        }
     }
 
     if (!mdv_transaction_commit(&transaction))
@@ -391,12 +666,110 @@ bool mdv_trlog_add_op(mdv_trlog *trlog,
 
     mdv_rollbacker_free(rollbacker);
 
-    mdv_trlog_changed_notify(trlog);
-
     return true;
 }
 
 
+bool mdv_trlog_add_op(mdv_trlog *trlog,
+                      mdv_trlog_op const *op,
+                      uint64_t *id)
+{
+    mdv_data const payload =
+    {
+        .size = op->size - offsetof(mdv_trlog_op, payload),
+        .ptr = (void*)op->payload
+    };
+
+    return mdv_trlog_add_opv(trlog, op->type, &payload, 1, id);
+}
+
+
+bool mdv_trlog_add_opv(mdv_trlog *trlog,
+                       uint32_t type,
+                       mdv_data const *parts,
+                       size_t count,
+                       uint64_t *id)
+{
+    size_t size = offsetof(mdv_trlog_op, payload);
+
+    for(size_t i = 0; i < count; ++i)
+        size += parts[i].size;
+
+    if (size > UINT32_MAX)
+    {
+        MDV_LOGE("DB operation is too long");
+        return false;
+    }
+
+    mdv_trlog_waiter waiter =
+    {
+        .type = type,
+        .size = (uint32_t)size,
+        .parts = parts,
+        .count = count,
+        .id = 0,
+        .done = false,
+        .ok = false,
+        .next = 0
+    };
+
+    if (mdv_mutex_lock(&trlog->queue_mutex) != MDV_OK)
+        return false;
+
+    mdv_trlog_enqueue(trlog, &waiter);
+
+    mdv_mutex_unlock(&trlog->queue_mutex);
+
+    // Operations are queued while the current group is written.
+    // The next commit mutex owner writes all pending operations.
+    if (mdv_mutex_lock(&trlog->commit_mutex) != MDV_OK)
+    {
+        if (mdv_mutex_lock(&trlog->queue_mutex) == MDV_OK)
+        {
+            mdv_trlog_dequeue(trlog, &waiter);
+            mdv_mutex_unlock(&trlog->queue_mutex);
+        }
+        return false;
+    }
+
+    if (!waiter.done
+        && MDV_CONFIG.storage.group_commit_window
+        && mdv_trlog_queue_size(trlog) < MDV_CONFIG.storage.group_commit_size)
+        mdv_sleep(MDV_CONFIG.storage.group_commit_window);
+
+    bool changed = false;
+
+    while (!waiter.done)
+    {
+        mdv_trlog_waiter *group = mdv_trlog_group_take(trlog);
+
+        if (!group)
+            break;
+
+        bool const ok = mdv_trlog_group_write(trlog, group);
+
+        changed |= ok;
+
+        for(mdv_trlog_waiter *w = group, *next; w; w = next)
+        {
+            next = w->next;             // Waiter can be destroyed right after the 'done' flag setting
+            w->ok = ok;
+            w->done = true;
+        }
+    }
+
+    mdv_mutex_unlock(&trlog->commit_mutex);
+
+    if (changed)
+        mdv_trlog_changed_notify(trlog);
+
+    if (waiter.ok && id)
+        *id = waiter.id;
+
+    return waiter.ok;
+}
+
+
 static size_t mdv_trlog_read(mdv_trlog                    *trlog,
                              uint64_t                      pos,
                              size_t                        size,
@@ -480,6 +853,7 @@ static size_t mdv_trlog_read(mdv_trlog                    *trlog,
 size_t mdv_trlog_range_read(mdv_trlog                    *trlog,
                             uint64_t                      from,
                             uint64_t                      to,
+                            size_t                        size,
                             mdv_list/*<mdv_trlog_data>*/ *ops)
 {
     mdv_rollbacker *rollbacker = mdv_rollbacker_create(2);
@@ -547,6 +921,11 @@ size_t mdv_trlog_range_read(mdv_trlog                    *trlog,
         mdv_list_emplace_back(ops, (mdv_list_entry_base *)op);
 
         ++n;
+
+        if (entry.value.size >= size)
+            mdv_map_foreach_break(entry);
+
+        size -= entry.value.size;
     }
 
     mdv_map_close(&tr_log);
@@ -566,10 +945,11 @@ bool mdv_trlog_changed(mdv_trlog *trlog)
 }
 
 
-uint32_t mdv_trlog_apply(mdv_trlog         *trlog,
-                         uint32_t           batch_size,
-                         void              *arg,
-                         mdv_trlog_apply_fn fn)
+uint32_t mdv_trlog_apply(mdv_trlog          *trlog,
+                         uint32_t            batch_size,
+                         void               *arg,
+                         mdv_trlog_apply_fn  fn,
+                         mdv_trlog_commit_fn commit)
 {
     uint64_t const applied_pos = atomic_load_explicit(&trlog->applied, memory_order_relaxed);
     uint64_t const top         = atomic_load_explicit(&trlog->top, memory_order_relaxed);
@@ -590,7 +970,7 @@ uint32_t mdv_trlog_apply(mdv_trlog         *trlog,
 
     mdv_list_foreach(&ops, mdv_trlog_data, op)
     {
-        if (!fn(arg, &op->op))
+        if (!fn(arg, op->id, &op->op))
         {
             MDV_LOGE("TR Log operation not applied");
             break;
@@ -600,6 +980,12 @@ uint32_t mdv_trlog_apply(mdv_trlog         *trlog,
         ++n;
     }
 
+    if (n && commit && !commit(arg, new_applied_pos))
+    {
+        MDV_LOGE("TR Log operations not committed");
+        n = 0;
+    }
+
     mdv_list_clear(&ops);
 
     if (n)
@@ -609,6 +995,239 @@ uint32_t mdv_trlog_apply(mdv_trlog         *trlog,
 }
 
 
+uint32_t mdv_trlog_truncate(mdv_trlog *trlog,
+                            uint64_t   pos,
+                            uint32_t   batch_size)
+{
+    uint64_t const applied_pos = atomic_load_explicit(&trlog->applied, memory_order_relaxed);
+    uint64_t const top         = atomic_load_explicit(&trlog->top, memory_order_relaxed);
+
+    if (pos > applied_pos)
+        pos = applied_pos;
+
+    if (pos >= top)             // The last record is kept
+        pos = top ? top - 1 : 0;
+
+    if (!pos || !batch_size)
+        return 0;
+
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(4);
+
+    // Start transaction
+    mdv_transaction transaction = mdv_transaction_start(trlog->storage);
+
+    if (!mdv_transaction_ok(transaction))
+    {
+        MDV_LOGE("TR log transaction failed");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_transaction_abort, &transaction);
+
+    // Open transaction log
+    mdv_map tr_log = mdv_map_open(&transaction,
+                                  MDV_MAP_TRLOG,
+                                  MDV_MAP_SILENT | MDV_MAP_INTEGERKEY);
+
+    if (!mdv_map_ok(tr_log))
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_map_close, &tr_log);
+
+    mdv_data key = {}, value = {};
+
+    mdv_cursor cursor = mdv_cursor_open_first(&tr_log, &transaction, &key, &value);
+
+    if (!mdv_cursor_ok(cursor))
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_cursor_close, &cursor);
+
+    uint32_t n = 0;
+    uint64_t begin = 0;
+
+    do
+    {
+        uint64_t id;
+        memcpy(&id, key.ptr, sizeof id);
+
+        if (id >= pos)
+            break;
+
+        begin = id + 1;
+
+        if (!mdv_cursor_del(&cursor))
+        {
+            MDV_LOGE("TR log truncation failed");
+            mdv_rollback(rollbacker);
+            return 0;
+        }
+
+        ++n;
+    }
+    while(n < batch_size
+          && mdv_cursor_get(&cursor, &key, &value, MDV_CURSOR_NEXT));
+
+    mdv_cursor_close(&cursor);
+
+    if (!n)
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    // Truncated records can't be sent to peers anymore
+    mdv_map map = mdv_map_open(&transaction,
+                               MDV_MAP_APPLIED,
+                               MDV_MAP_CREATE | MDV_MAP_INTEGERKEY);
+
+    if (!mdv_map_ok(map))
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_map_close, &map);
+
+    mdv_data const begin_key = { sizeof MDV_TRLOG_BEGIN_POS_KEY, (void*)&MDV_TRLOG_BEGIN_POS_KEY };
+    mdv_data begin_value = { sizeof begin, &begin };
+
+    if (!mdv_map_put(&map, &transaction, &begin_key, &begin_value))
+    {
+        MDV_LOGE("TR log truncation failed");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    if (!mdv_transaction_commit(&transaction))
+    {
+        MDV_LOGE("TR log truncation failed");
+        mdv_map_close(&map);
+        mdv_map_close(&tr_log);
+        mdv_rollbacker_free(rollbacker);
+        return 0;
+    }
+
+    atomic_store(&trlog->begin, begin);
+
+    mdv_map_close(&map);
+    mdv_map_close(&tr_log);
+
+    mdv_rollbacker_free(rollbacker);
+
+    return n;
+}
+
+
+mdv_errno mdv_trlog_synced_set(mdv_trlog *trlog, mdv_uuid const *peer, uint64_t pos)
+{
+    if (!pos)
+        return MDV_OK;
+
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(2);
+
+    // Start transaction
+    mdv_transaction transaction = mdv_transaction_start(trlog->storage);
+
+    if (!mdv_transaction_ok(transaction))
+    {
+        MDV_LOGE("TR log transaction failed");
+        mdv_rollback(rollbacker);
+        return MDV_FAILED;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_transaction_abort, &transaction);
+
+    mdv_map map = mdv_map_open(&transaction, MDV_MAP_SYNCED, MDV_MAP_CREATE);
+
+    if (!mdv_map_ok(map))
+    {
+        MDV_LOGE("Transaction log map '%s' not opened", MDV_MAP_SYNCED);
+        mdv_rollback(rollbacker);
+        return MDV_FAILED;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_map_close, &map);
+
+    mdv_data const key = { sizeof *peer, (void*)peer };
+    mdv_data value = {};
+
+    uint64_t synced = 0;
+
+    if (mdv_map_get(&map, &transaction, &key, &value) && value.size == sizeof synced)
+        memcpy(&synced, value.ptr, sizeof synced);
+
+    // Position received by peer is never moved back
+    if (pos <= synced)
+    {
+        mdv_rollback(rollbacker);
+        return MDV_OK;
+    }
+
+    value.size = sizeof pos;
+    value.ptr = &pos;
+
+    if (!mdv_map_put(&map, &transaction, &key, &value))
+    {
+        MDV_LOGE("Transaction log position received by peer wasn't saved");
+        mdv_rollback(rollbacker);
+        return MDV_FAILED;
+    }
+
+    if (!mdv_transaction_commit(&transaction))
+    {
+        MDV_LOGE("Transaction log position received by peer wasn't saved");
+        mdv_map_close(&map);
+        mdv_rollbacker_free(rollbacker);
+        return MDV_FAILED;
+    }
+
+    mdv_map_close(&map);
+
+    mdv_rollbacker_free(rollbacker);
+
+    return MDV_OK;
+}
+
+
+uint64_t mdv_trlog_synced(mdv_trlog *trlog, mdv_uuid const *peer)
+{
+    mdv_transaction transaction = mdv_transaction_start_rdonly(trlog->storage);
+
+    if (!mdv_transaction_ok(transaction))
+    {
+        MDV_LOGE("TR log transaction failed");
+        return 0;
+    }
+
+    uint64_t synced = 0;
+
+    mdv_map map = mdv_map_open(&transaction, MDV_MAP_SYNCED, MDV_MAP_SILENT);
+
+    if (mdv_map_ok(map))
+    {
+        mdv_data const key = { sizeof *peer, (void*)peer };
+        mdv_data value = {};
+
+        if (mdv_map_get(&map, &transaction, &key, &value) && value.size == sizeof synced)
+            memcpy(&synced, value.ptr, sizeof synced);
+
+        mdv_map_close(&map);
+    }
+
+    mdv_transaction_abort(&transaction);
+
+    return synced;
+}
+
+
 uint32_t mdv_trlog_foreach(mdv_trlog   *trlog,
                            uint64_t     id,
                            uint32_t     batch_size,
@@ -11,6 +11,7 @@
 #pragma once
 #include <mdv_def.h>
 #include <mdv_uuid.h>
+#include <mdv_data.h>
 #include <mdv_list.h>
 #include <mdv_ebus.h>
 
@@ -36,7 +37,16 @@ typedef struct
 } mdv_trlog_data;
 
 
-typedef bool (*mdv_trlog_apply_fn)(void *arg, mdv_trlog_op *op);
+/// Transaction log position
+typedef struct
+{
+    mdv_uuid    trlog;          ///< transaction log UUID
+    uint64_t    pos;            ///< position in transaction log
+} mdv_trlog_pos;
+
+
+typedef bool (*mdv_trlog_apply_fn)(void *arg, uint64_t id, mdv_trlog_op *op);
+typedef bool (*mdv_trlog_commit_fn)(void *arg, uint64_t applied_pos);
 typedef bool (*mdv_trlog_fn)(void *arg, mdv_trlog_data *op);
 
 
@@ -94,31 +104,93 @@ mdv_uuid const * mdv_trlog_uuid(mdv_trlog *trlog);
 uint64_t mdv_trlog_top(mdv_trlog *trlog);
 
 
+/**
+ * @brief Returns transaction log application position
+ */
+uint64_t mdv_trlog_applied(mdv_trlog *trlog);
+
+
+/**
+ * @brief Returns the first transaction log position which isn't truncated
+ * @details Records before this position can't be read anymore.
+ */
+uint64_t mdv_trlog_begin(mdv_trlog *trlog);
+
+
+/**
+ * @brief Moves the empty transaction log to the given position
+ * @details Used when the node is bootstrapped from snapshot. Records before the
+ *          position are already applied to the tables, so both the transaction
+ *          log top and the application position are set to the given position.
+ *
+ * @param trlog [in]            Transaction logs storage
+ * @param pos [in]              New transaction log position
+ *
+ * @return MDV_OK if position was successfully saved
+ * @return MDV_EEXIST if transaction log isn't empty
+ * @return On error, return nonzero error code
+ */
+mdv_errno mdv_trlog_reset(mdv_trlog *trlog, uint64_t pos);
+
+
 /**
  * @brief Writes data to the transaction log.
+ * @details Records are received from other nodes and they should continue the transaction log.
+ *          The records batch covers range [from, last record identifier]. The batch is rejected
+ *          if 'from' is greater than the transaction log top (there is a gap). Records which are
+ *          already in the transaction log are skipped.
  *
  * @param trlog [in]            Transaction logs storage
+ * @param from [in]             First position covered by the records batch
  * @param ops [in]              list of the transaction log records
  *
- * @return true if data was successfully written
- * @return false if error was happened
+ * @return MDV_OK if data was successfully written
+ * @return MDV_EAGAIN if the records don't continue the transaction log
+ * @return On error, return nonzero error code
  */
-bool mdv_trlog_add(mdv_trlog *trlog,
-                   mdv_list/*<mdv_trlog_data>*/ const *ops);
+mdv_errno mdv_trlog_add(mdv_trlog *trlog,
+                        uint64_t from,
+                        mdv_list/*<mdv_trlog_data>*/ const *ops);
 
 
 /**
  * @brief Writes data to the transaction log.
  * @details New identifier is generated for new record.
+ *          Operations of concurrent writers are grouped and written within one transaction (group commit).
+ *          Group is collected during storage.group_commit_window milliseconds or until
+ *          its size reaches storage.group_commit_size bytes.
  *
  * @param trlog [in]            Transaction logs storage
  * @param op [in]               DB operation to be written to the transaction log
+ * @param id [out]              Assigned record identifier (may be NULL)
  *
  * @return true if data was successfully written
  * @return false if error was happened
  */
 bool mdv_trlog_add_op(mdv_trlog *trlog,
-                      mdv_trlog_op const *op);
+                      mdv_trlog_op const *op,
+                      uint64_t *id);
+
+
+/**
+ * @brief Writes DB operation given by payload parts to the transaction log.
+ * @details Operation is assembled directly in the storage, so no intermediate operation buffer is required.
+ *          Otherwise it's the same as mdv_trlog_add_op().
+ *
+ * @param trlog [in]            Transaction logs storage
+ * @param type [in]             DB operation type
+ * @param parts [in]            DB operation payload parts
+ * @param count [in]            DB operation payload parts count
+ * @param id [out]              Assigned record identifier (may be NULL)
+ *
+ * @return true if data was successfully written
+ * @return false if error was happened
+ */
+bool mdv_trlog_add_opv(mdv_trlog *trlog,
+                       uint32_t type,
+                       mdv_data const *parts,
+                       size_t count,
+                       uint64_t *id);
 
 
 /**
@@ -131,12 +203,61 @@ bool mdv_trlog_changed(mdv_trlog *trlog);
 
 /**
  * @brief Applies transaction log
+ * @details fn() is called for each operation in batch. If commit function is provided,
+ *          it's called after all operations with new application position. Operations are
+ *          considered applied only when commit() returns true. It allows to defer and to group
+ *          operations writing.
+ *
+ * @param trlog [in]            Transaction logs storage
+ * @param batch_size [in]       Maximum number of operations in batch
+ * @param arg [in]              Argument which is passed to fn() and commit()
+ * @param fn [in]               Operation handler
+ * @param commit [in]           Batch commit function (may be NULL)
+ *
  * @return number of applied rows
  */
-uint32_t mdv_trlog_apply(mdv_trlog         *trlog,
-                         uint32_t           batch_size,
-                         void              *arg,
-                         mdv_trlog_apply_fn fn);
+uint32_t mdv_trlog_apply(mdv_trlog          *trlog,
+                         uint32_t            batch_size,
+                         void               *arg,
+                         mdv_trlog_apply_fn  fn,
+                         mdv_trlog_commit_fn commit);
+
+
+/**
+ * @brief Deletes transaction log records before the given position
+ * @details Only applied records are deleted. The last record is never deleted because
+ *          it's used for the transaction log top position restoring.
+ *
+ * @param trlog [in]            Transaction logs storage
+ * @param pos [in]              Position before which records are deleted
+ * @param batch_size [in]       Maximum number of records deleted in one transaction
+ *
+ * @return number of deleted records
+ */
+uint32_t mdv_trlog_truncate(mdv_trlog *trlog,
+                            uint64_t   pos,
+                            uint32_t   batch_size);
+
+
+/**
+ * @brief Saves the transaction log position received by peer
+ * @details Saved position is never moved back.
+ *
+ * @param trlog [in]            Transaction logs storage
+ * @param peer [in]             Peer UUID
+ * @param pos [in]              Transaction log top position received by peer
+ *
+ * @return On success, return MDV_OK
+ * @return On error, return nonzero error code
+ */
+mdv_errno mdv_trlog_synced_set(mdv_trlog *trlog, mdv_uuid const *peer, uint64_t pos);
+
+
+/**
+ * @brief Returns the transaction log position received by peer
+ * @details Zero position is returned if the peer never acknowledged the transaction log.
+ */
+uint64_t mdv_trlog_synced(mdv_trlog *trlog, mdv_uuid const *peer);
 
 
 /**
@@ -153,11 +274,14 @@ uint32_t mdv_trlog_foreach(mdv_trlog   *trlog,
 
 /**
  * @brief Transaction log reading
- * @details Transaction log reading from range [from, to)
+ * @details Transaction log reading from range [from, to).
+ *          Reading is stopped when the read records size reaches the size limit.
+ *          At least one record is read.
  *
  * @param trlog [in]            Transaction logs storage
  * @param from [in]             First record identifier
  * @param to [in]               Last record identifier
+ * @param size [in]             Maximum size of read records (in bytes)
  * @param ops [out]             Place for read records
  *
  * @return number of read rows
@@ -165,4 +289,5 @@ uint32_t mdv_trlog_foreach(mdv_trlog   *trlog,
 size_t mdv_trlog_range_read(mdv_trlog                    *trlog,
                             uint64_t                      from,
                             uint64_t                      to,
+                            size_t                        size,
                             mdv_list/*<mdv_trlog_data>*/ *ops);
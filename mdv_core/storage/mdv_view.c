@@ -4,4 +4,5 @@
 mdv_view * mdv_view_retain(mdv_view *view)                  { return view->vptr->retain(view); }
 uint32_t mdv_view_release(mdv_view *view)                   { return view ? view->vptr->release(view) : 0; }
 mdv_table * mdv_view_desc(mdv_view *view)                   { return view->vptr->desc(view); }
-mdv_rowset * mdv_view_fetch(mdv_view *view, size_t count)   { return view->vptr->fetch(view, count); }
+mdv_errno mdv_view_fetch(mdv_view *view, size_t count, size_t bytes, binn *rows) { return view->vptr->fetch(view, count, bytes, rows); }
+void mdv_view_prefetch(mdv_view *view, size_t count, size_t bytes) { if (view->vptr->prefetch) view->vptr->prefetch(view, count, bytes); }
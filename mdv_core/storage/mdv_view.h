@@ -11,6 +11,7 @@
 #pragma once
 #include <mdv_table.h>
 #include <mdv_rowset.h>
+#include <mdv_binn.h>
 
 
 /// Table slice representation
@@ -20,7 +21,8 @@ typedef struct mdv_view mdv_view;
 typedef mdv_view *   (*mdv_view_retain_fn) (mdv_view *);
 typedef uint32_t     (*mdv_view_release_fn)(mdv_view *);
 typedef mdv_table *  (*mdv_view_desc_fn)   (mdv_view *);
-typedef mdv_rowset * (*mdv_view_fetch_fn)  (mdv_view *, size_t);
+typedef mdv_errno    (*mdv_view_fetch_fn)  (mdv_view *, size_t, size_t, binn *);
+typedef void         (*mdv_view_prefetch_fn)(mdv_view *, size_t, size_t);
 
 
 /// Interface for view
@@ -29,7 +31,8 @@ typedef struct
     mdv_view_retain_fn      retain;         ///< Function for view retain
     mdv_view_release_fn     release;        ///< Function for view release
     mdv_view_desc_fn        desc;           ///< Function for table descriptor access
-    mdv_view_fetch_fn       fetch;          ///< function for rowset reading
+    mdv_view_fetch_fn       fetch;          ///< function for serialized rows reading
+    mdv_view_prefetch_fn    prefetch;       ///< function for asynchronous rows reading start (optional)
 } mdv_iview;
 
 
@@ -66,11 +69,26 @@ mdv_table * mdv_view_desc(mdv_view *view);
 
 
 /**
- * @brief Rowset reading from the table
+ * @brief Serialized rows reading from the table
  *
  * @param view [in]     Table slice representation
  * @param count [in]    Rows number to be fetched
+ * @param bytes [in]    Serialized rows size limit (in bytes). At least one row is fetched even if it exceeds the limit.
+ * @param rows [out]    Serialized rows list (binn list of rows serialized by mdv_binn_row())
  *
- * @return Rows set or NULL
+ * @return On success, returns MDV_OK and rows list should be freed by binn_free()
+ * @return On error or if there are no more rows, returns non zero value
  */
-mdv_rowset * mdv_view_fetch(mdv_view *view, size_t count);
+mdv_errno mdv_view_fetch(mdv_view *view, size_t count, size_t bytes, binn *rows);
+
+
+/**
+ * @brief Starts the next rows batch reading in background
+ * @details Views which read rows from remote nodes request the next rows batch without waiting.
+ *          The batch is returned by the next mdv_view_fetch() call. Other views ignore this call.
+ *
+ * @param view [in]     Table slice representation
+ * @param count [in]    Rows number to be fetched
+ * @param bytes [in]    Serialized rows size limit (in bytes)
+ */
+void mdv_view_prefetch(mdv_view *view, size_t count, size_t bytes);
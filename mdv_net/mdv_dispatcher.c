@@ -1,4 +1,5 @@
 #include "mdv_dispatcher.h"
+#include "mdv_socket.h"
 #include <mdv_condvar.h>
 #include <mdv_mutex.h>
 #include <mdv_alloc.h>
@@ -6,13 +7,18 @@
 #include <mdv_hashmap.h>
 #include <mdv_rollbacker.h>
 #include <mdv_stack.h>
+#include <mdv_limits.h>
+#include <mdv_time.h>
 #include <string.h>
 #include <stdatomic.h>
 
 
 enum
 {
-    MDV_DISP_REQS = 4      ///< Number of simultaneously sent requests via single connection
+    MDV_DISP_REQS       = 4,            ///< Number of simultaneously sent requests via single connection
+    MDV_DISP_RBUF_SIZE  = 64 * 1024,    ///< Receive buffer size. Messages which fit into the buffer are handled without allocations.
+    MDV_DISP_EXPIRATION = 100,          ///< Asynchronous requests expiration checking interval (in milliseconds)
+    MDV_DISP_EXPIRED    = 64            ///< Maximum number of expired requests completed at once
 };
 
 
@@ -25,23 +31,46 @@ typedef struct
 {
     mdv_condvar    *cv;                 ///< Condition variable is used by client for response waiting
     mdv_msg        *resp;               ///< Response
+    mdv_dispatcher_response_fn fn;      ///< Response handler for asynchronous request
+    void           *arg;                ///< Response handler argument
+    size_t          deadline;           ///< Asynchronous request deadline (in milliseconds)
     uint16_t        request_id;         ///< Request identifier
     uint16_t        ready:1;            ///< Response is ready
 } mdv_request;
 
 
+/// Message waiting for writing
+typedef struct mdv_outmsg
+{
+    mdv_msg const          *msg;        ///< Message
+    mdv_errno               err;        ///< Writing result
+    bool                    done;       ///< Message is written
+    struct mdv_outmsg      *next;       ///< Next message in queue
+} mdv_outmsg;
+
+
+static void mdv_dispatcher_cancel(mdv_dispatcher *pd, bool expired);
+
+
 /// Messages dispatcher
 struct mdv_dispatcher
 {
     mdv_descriptor volatile fd;                         ///< File descriptor
     mdv_mutex               fd_mutex;                   ///< Mutex for fd guard
-    mdv_msg                 message;                    ///< Current message
+    mdv_mutex               queue_mutex;                ///< Mutex for outgoing messages queue guard
+    mdv_outmsg             *queue_head;                 ///< Outgoing messages queue head
+    mdv_outmsg             *queue_tail;                 ///< Outgoing messages queue tail
+    mdv_msg                 message;                    ///< Current large message which doesn't fit into the receive buffer
+    size_t                  rbuf_begin;                 ///< Unhandled data offset in the receive buffer
+    size_t                  rbuf_end;                   ///< Received data end in the receive buffer
     mdv_hashmap            *handlers;                   ///< Message handlers (id -> mdv_msg_handler)
     mdv_hashmap            *requests;                   ///< Requests map (request_id -> mdv_request)
     mdv_mutex               requests_mutex;             ///< Mutex for requests map guard
     mdv_condvars_pool       cvs;                        ///< unused conditinal variables pointers
     atomic_ushort           id;                         ///< id generator
+    size_t                  expiration;                 ///< Next time for asynchronous requests expiration checking
     mdv_condvar             condvars[MDV_DISP_REQS];    ///< conditinal variables pool
+    uint8_t                 rbuf[MDV_DISP_RBUF_SIZE];   ///< Receive buffer
 };
 
 
@@ -52,7 +81,7 @@ static int mdv_id_cmp(void const *id1, void const *id2) { return (int)*(uint16_t
 
 mdv_dispatcher * mdv_dispatcher_create(mdv_descriptor fd)
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(5);
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(6);
 
     mdv_dispatcher *pd = (mdv_dispatcher *)mdv_alloc(sizeof(mdv_dispatcher));
 
@@ -66,6 +95,9 @@ mdv_dispatcher * mdv_dispatcher_create(mdv_descriptor fd)
     mdv_rollbacker_push(rollbacker, mdv_free, pd);
 
     memset(&pd->message, 0, sizeof pd->message);
+    pd->rbuf_begin = 0;
+    pd->rbuf_end = 0;
+    pd->expiration = 0;
 
     atomic_init(&pd->id, 0);
 
@@ -82,6 +114,19 @@ mdv_dispatcher * mdv_dispatcher_create(mdv_descriptor fd)
     mdv_rollbacker_push(rollbacker, mdv_mutex_free, &pd->fd_mutex);
 
 
+    if (mdv_mutex_create(&pd->queue_mutex) != MDV_OK)
+    {
+        MDV_LOGE("Mutex for messages dispatcher not created");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_mutex_free, &pd->queue_mutex);
+
+    pd->queue_head = 0;
+    pd->queue_tail = 0;
+
+
     if (mdv_mutex_create(&pd->requests_mutex) != MDV_OK)
     {
         MDV_LOGE("Mutex for messages dispatcher not created");
@@ -148,11 +193,13 @@ void mdv_dispatcher_free(mdv_dispatcher *pd)
     if (pd)
     {
         MDV_LOGD("Messages dispatcher %p deleted", pd);
+        mdv_dispatcher_cancel(pd, false);
         for (size_t i = 0; i < sizeof pd->condvars / sizeof *pd->condvars; ++i)
             mdv_condvar_free(pd->condvars + i);
         mdv_hashmap_release(pd->handlers);
         mdv_hashmap_release(pd->requests);
         mdv_mutex_free(&pd->fd_mutex);
+        mdv_mutex_free(&pd->queue_mutex);
         mdv_mutex_free(&pd->requests_mutex);
         memset(pd, 0, sizeof *pd);
         mdv_free(pd);
@@ -183,6 +230,128 @@ mdv_descriptor mdv_dispatcher_fd(mdv_dispatcher *pd)
 }
 
 
+/// Writes queued messages. Fd mutex should be locked.
+static void mdv_dispatcher_flush(mdv_dispatcher *pd, mdv_outmsg *queue)
+{
+    enum { MDV_DISP_BATCH = MDV_IOV_MAX / 2 };
+
+    while(queue)
+    {
+        mdv_outmsg *batch[MDV_DISP_BATCH];
+        mdv_msg const *msgs[MDV_DISP_BATCH];
+        size_t n = 0;
+
+        for(; queue && n < MDV_DISP_BATCH; queue = queue->next)
+        {
+            batch[n] = queue;
+            msgs[n++] = queue->msg;
+        }
+
+        mdv_errno const err = mdv_write_msgs(pd->fd, msgs, n);
+
+        for(size_t i = 0; i < n; ++i)
+        {
+            batch[i]->err = err;
+            batch[i]->done = true;
+        }
+    }
+}
+
+
+/// Removes message from the outgoing messages queue
+static void mdv_dispatcher_dequeue(mdv_dispatcher *pd, mdv_outmsg *outmsg)
+{
+    if (mdv_mutex_lock(&pd->queue_mutex) != MDV_OK)
+        return;
+
+    mdv_outmsg *prev = 0;
+
+    for(mdv_outmsg *entry = pd->queue_head; entry; prev = entry, entry = entry->next)
+    {
+        if (entry == outmsg)
+        {
+            if (prev)
+                prev->next = entry->next;
+            else
+                pd->queue_head = entry->next;
+
+            if (pd->queue_tail == entry)
+                pd->queue_tail = prev;
+
+            break;
+        }
+    }
+
+    mdv_mutex_unlock(&pd->queue_mutex);
+}
+
+
+/**
+ * @brief Writes message to the file descriptor
+ * @details Messages of concurrent writers are queued while the file descriptor is busy.
+ *          The next fd mutex owner writes all queued messages by single vectored writing,
+ *          so the small messages are coalesced.
+ */
+static mdv_errno mdv_dispatcher_write(mdv_dispatcher *pd, mdv_msg const *msg)
+{
+    if (msg->hdr.size > MDV_MSG_SIZE_MAX)
+    {
+        MDV_LOGE("Message is too long");
+        return MDV_FAILED;
+    }
+
+    mdv_outmsg outmsg =
+    {
+        .msg  = msg,
+        .err  = MDV_FAILED,
+        .done = false,
+        .next = 0
+    };
+
+    mdv_errno err = mdv_mutex_lock(&pd->queue_mutex);
+
+    if (err != MDV_OK)
+        return err;
+
+    if (pd->queue_tail)
+        pd->queue_tail->next = &outmsg;
+    else
+        pd->queue_head = &outmsg;
+
+    pd->queue_tail = &outmsg;
+
+    mdv_mutex_unlock(&pd->queue_mutex);
+
+    err = mdv_mutex_lock(&pd->fd_mutex);
+
+    if (err != MDV_OK)
+    {
+        mdv_dispatcher_dequeue(pd, &outmsg);
+        return err;
+    }
+
+    // Message may be already written by the previous fd mutex owner
+    if (!outmsg.done)
+    {
+        mdv_outmsg *queue = 0;
+
+        if (mdv_mutex_lock(&pd->queue_mutex) == MDV_OK)
+        {
+            queue = pd->queue_head;
+            pd->queue_head = 0;
+            pd->queue_tail = 0;
+            mdv_mutex_unlock(&pd->queue_mutex);
+        }
+
+        mdv_dispatcher_flush(pd, queue);
+    }
+
+    mdv_mutex_unlock(&pd->fd_mutex);
+
+    return outmsg.err;
+}
+
+
 mdv_errno mdv_dispatcher_send(mdv_dispatcher *pd, mdv_msg *req, mdv_msg *resp, size_t timeout)
 {
     mdv_errno err = MDV_OK;
@@ -202,6 +371,9 @@ mdv_errno mdv_dispatcher_send(mdv_dispatcher *pd, mdv_msg *req, mdv_msg *resp, s
             {
                 .cv         = *pcv,
                 .resp       = resp,
+                .fn         = 0,
+                .arg        = 0,
+                .deadline   = 0,
                 .request_id = req->hdr.number,
                 .ready      = 0
             };
@@ -225,15 +397,7 @@ mdv_errno mdv_dispatcher_send(mdv_dispatcher *pd, mdv_msg *req, mdv_msg *resp, s
     // Send request
     if (err == MDV_OK)
     {
-        if (mdv_mutex_lock(&pd->fd_mutex) == MDV_OK)
-        {
-            err = mdv_write_msg(pd->fd, req);
-
-            if (err != MDV_OK)
-                MDV_LOGE("Request sending failed");
-
-            mdv_mutex_unlock(&pd->fd_mutex);
-        }
+        err = mdv_dispatcher_write(pd, req);
 
         if (err != MDV_OK)
         {
@@ -298,26 +462,139 @@ mdv_errno mdv_dispatcher_send(mdv_dispatcher *pd, mdv_msg *req, mdv_msg *resp, s
 }
 
 
-mdv_errno mdv_dispatcher_post(mdv_dispatcher *pd, mdv_msg *msg)
+mdv_errno mdv_dispatcher_send_async(mdv_dispatcher *pd, mdv_msg *req, size_t timeout, mdv_dispatcher_response_fn fn, void *arg)
 {
-    msg->hdr.number = atomic_fetch_add_explicit(&pd->id, 1, memory_order_relaxed);
-    return mdv_dispatcher_reply(pd, msg);
+    mdv_dispatcher_expire(pd);
+
+    req->hdr.number = atomic_fetch_add_explicit(&pd->id, 1, memory_order_relaxed);
+
+    mdv_request const mreq =
+    {
+        .cv         = 0,
+        .resp       = 0,
+        .fn         = fn,
+        .arg        = arg,
+        .deadline   = mdv_gettime() + timeout,
+        .request_id = req->hdr.number,
+        .ready      = 0
+    };
+
+    // Register request
+    mdv_errno err = mdv_mutex_lock(&pd->requests_mutex);
+
+    if (err != MDV_OK)
+        return err;
+
+    if (mdv_hashmap_find(pd->requests, &mreq.request_id))
+    {
+        MDV_LOGE("Too many requests in flight");
+        err = MDV_BUSY;
+    }
+    else if (!mdv_hashmap_insert(pd->requests, &mreq, sizeof mreq))
+    {
+        MDV_LOGE("No memory for new request");
+        err = MDV_NO_MEM;
+    }
+
+    mdv_mutex_unlock(&pd->requests_mutex);
+
+    if (err != MDV_OK)
+        return err;
+
+    // Send request
+    err = mdv_dispatcher_write(pd, req);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Request sending failed");
+
+        // Request may be already completed and the response handler called
+        if (mdv_mutex_lock(&pd->requests_mutex) == MDV_OK)
+        {
+            if (mdv_hashmap_find(pd->requests, &mreq.request_id))
+                mdv_hashmap_erase(pd->requests, &mreq.request_id);
+            else
+                err = MDV_OK;
+            mdv_mutex_unlock(&pd->requests_mutex);
+        }
+    }
+
+    return err;
 }
 
 
-mdv_errno mdv_dispatcher_reply(mdv_dispatcher *pd, mdv_msg const *msg)
+/**
+ * @brief Completes asynchronous requests
+ *
+ * @param pd [in]       messages dispatcher
+ * @param expired [in]  if true, only expired requests are completed with MDV_ETIMEDOUT error, \n
+ *                      otherwise all requests are completed with MDV_CLOSED error
+ */
+static void mdv_dispatcher_cancel(mdv_dispatcher *pd, bool expired)
 {
-    mdv_errno err = MDV_FAILED;
+    size_t const now = mdv_gettime();
+    mdv_errno const err = expired ? MDV_ETIMEDOUT : MDV_CLOSED;
 
-    if (mdv_mutex_lock(&pd->fd_mutex) == MDV_OK)
+    for(size_t n = MDV_DISP_EXPIRED; n == MDV_DISP_EXPIRED;)
     {
-        err = mdv_write_msg(pd->fd, msg);
+        mdv_request requests[MDV_DISP_EXPIRED];
 
-        if (err != MDV_OK)
-            MDV_LOGE("Message posting failed");
+        n = 0;
 
-        mdv_mutex_unlock(&pd->fd_mutex);
+        if (mdv_mutex_lock(&pd->requests_mutex) != MDV_OK)
+            return;
+
+        if (expired && now < pd->expiration)
+        {
+            mdv_mutex_unlock(&pd->requests_mutex);
+            return;
+        }
+
+        mdv_hashmap_foreach(pd->requests, mdv_request, entry)
+        {
+            if (n < MDV_DISP_EXPIRED
+                && entry->fn
+                && (!expired || entry->deadline <= now))
+                requests[n++] = *entry;
+        }
+
+        for(size_t i = 0; i < n; ++i)
+            mdv_hashmap_erase(pd->requests, &requests[i].request_id);
+
+        if (n < MDV_DISP_EXPIRED)
+            pd->expiration = now + MDV_DISP_EXPIRATION;
+
+        mdv_mutex_unlock(&pd->requests_mutex);
+
+        for(size_t i = 0; i < n; ++i)
+        {
+            if (expired)
+                MDV_LOGE("Response timeout");
+            requests[i].fn(err, 0, requests[i].arg);
+        }
     }
+}
+
+
+void mdv_dispatcher_expire(mdv_dispatcher *pd)
+{
+    mdv_dispatcher_cancel(pd, true);
+}
+
+
+mdv_errno mdv_dispatcher_post(mdv_dispatcher *pd, mdv_msg *msg)
+{
+    msg->hdr.number = atomic_fetch_add_explicit(&pd->id, 1, memory_order_relaxed);
+    return mdv_dispatcher_reply(pd, msg);
+}
+
+
+mdv_errno mdv_dispatcher_reply(mdv_dispatcher *pd, mdv_msg const *msg)
+{
+    mdv_errno err = mdv_dispatcher_write(pd, msg);
+
+    if (err != MDV_OK)
+        MDV_LOGE("Message posting failed");
 
     return err;
 }
@@ -341,53 +618,198 @@ mdv_errno mdv_dispatcher_write_raw(mdv_dispatcher *pd, void const *data, size_t
 }
 
 
-mdv_errno mdv_dispatcher_read(mdv_dispatcher *pd)
+/**
+ * @brief Handles received message
+ *
+ * @param pd [in]       messages dispatcher
+ * @param msg [in]      received message
+ * @param owned [in]    if true, message payload is allocated and owned by dispatcher, \n
+ *                      otherwise payload is the slice of receive buffer
+ */
+static mdv_errno mdv_dispatcher_handle(mdv_dispatcher *pd, mdv_msg *msg, bool owned)
 {
-    mdv_errno err = mdv_read_msg(pd->fd, &pd->message);
-
-    if (err != MDV_OK)
-        return err;
+    mdv_errno err = MDV_OK;
 
     int msg_is_handled = 0;
 
+    mdv_dispatcher_response_fn fn = 0;
+    void *arg = 0;
+
     if (mdv_mutex_lock(&pd->requests_mutex) == MDV_OK)
     {
-        mdv_request *req = mdv_hashmap_find(pd->requests, &pd->message.hdr.number);
+        mdv_request *req = mdv_hashmap_find(pd->requests, &msg->hdr.number);
 
-        if (req)
+        if (req && req->fn)
+        {
+            // Response for asynchronous request is handled out of the lock
+            msg_is_handled = 2;
+            fn = req->fn;
+            arg = req->arg;
+            mdv_hashmap_erase(pd->requests, &msg->hdr.number);
+        }
+        else if (req)
         {
             msg_is_handled = 1;
-            *req->resp = pd->message;
-            req->ready = 1;
-            memset(&pd->message, 0, sizeof pd->message);
 
-            if (mdv_condvar_signal(req->cv) != MDV_OK)
+            mdv_msg resp = *msg;
+
+            // Response is owned by requester, so receive buffer slice is copied
+            if (!owned && resp.hdr.size)
             {
-                MDV_LOGW("Response is discarded due to conditional signalization fail");
-                mdv_free_msg(req->resp);
-                (void)mdv_stack_push(pd->cvs, req->cv);
-                mdv_hashmap_erase(pd->requests, &req->request_id);
+                resp.payload = mdv_alloc(resp.hdr.size);
+
+                if (resp.payload)
+                    memcpy(resp.payload, msg->payload, resp.hdr.size);
+            }
+            else
+                memset(msg, 0, sizeof *msg);
+
+            if (resp.hdr.size && !resp.payload)
+            {
+                MDV_LOGE("No memory for response");
+                err = MDV_NO_MEM;
+            }
+            else
+            {
+                *req->resp = resp;
+                req->ready = 1;
+
+                if (mdv_condvar_signal(req->cv) != MDV_OK)
+                {
+                    MDV_LOGW("Response is discarded due to conditional signalization fail");
+                    mdv_free_msg(req->resp);
+                    (void)mdv_stack_push(pd->cvs, req->cv);
+                    mdv_hashmap_erase(pd->requests, &req->request_id);
+                }
             }
         }
 
         mdv_mutex_unlock(&pd->requests_mutex);
     }
 
+    if (msg_is_handled == 2)
+    {
+        fn(MDV_OK, msg, arg);
+
+        if (owned)
+            mdv_free_msg(msg);
+    }
+
     // Message not handled
     if (!msg_is_handled)
     {
-        mdv_dispatcher_handler *handler = mdv_hashmap_find(pd->handlers, &pd->message.hdr.id);
+        mdv_dispatcher_handler *handler = mdv_hashmap_find(pd->handlers, &msg->hdr.id);
 
         if (handler)
-            err = handler->fn(&pd->message, handler->arg);
+            err = handler->fn(msg, handler->arg);
         else
         {
             MDV_LOGW("Message is discarded due to appropriate handler not found");
             err = MDV_NO_IMPL;
         }
 
-        mdv_free_msg(&pd->message);
+        if (owned)
+            mdv_free_msg(msg);
     }
 
     return err;
 }
+
+
+mdv_errno mdv_dispatcher_read(mdv_dispatcher *pd)
+{
+    // Large message is read directly into the message payload
+    if (pd->message.available_size)
+    {
+        mdv_errno err = mdv_read_msg(pd->fd, &pd->message);
+
+        if (err != MDV_OK)
+            return err;
+
+        return mdv_dispatcher_handle(pd, &pd->message, true);
+    }
+
+    size_t len = MDV_DISP_RBUF_SIZE - pd->rbuf_end;
+
+    mdv_errno err = mdv_read(pd->fd, pd->rbuf + pd->rbuf_end, &len);
+
+    if (err != MDV_OK)
+        return err;
+
+    pd->rbuf_end += len;
+
+    // Handle all completely received messages
+    while(pd->rbuf_end - pd->rbuf_begin >= sizeof(mdv_msghdr))
+    {
+        uint8_t *data = pd->rbuf + pd->rbuf_begin;
+        size_t const available = pd->rbuf_end - pd->rbuf_begin;
+
+        mdv_msghdr hdr;
+        memcpy(&hdr, data, sizeof hdr);
+
+        mdv_msg msg =
+        {
+            .hdr =
+            {
+                .id     = mdv_ntoh16(hdr.id),
+                .number = mdv_ntoh16(hdr.number),
+                .size   = mdv_ntoh32(hdr.size)
+            }
+        };
+
+        if (msg.hdr.size > MDV_MSG_SIZE_MAX)
+        {
+            MDV_LOGE("Incoming message is too long");
+            pd->rbuf_begin = pd->rbuf_end = 0;
+            return MDV_FAILED;
+        }
+
+        if (sizeof hdr + msg.hdr.size > MDV_DISP_RBUF_SIZE)
+        {
+            // Large message doesn't fit into the receive buffer. Received part is moved into the allocated payload.
+            pd->message.hdr = msg.hdr;
+            pd->message.payload = mdv_alloc(msg.hdr.size);
+
+            if (!pd->message.payload)
+            {
+                MDV_LOGE("No memory for incoming message");
+                memset(&pd->message, 0, sizeof pd->message);
+                pd->rbuf_begin = pd->rbuf_end = 0;
+                return MDV_NO_MEM;
+            }
+
+            memcpy(pd->message.payload, data + sizeof hdr, available - sizeof hdr);
+            pd->message.available_size = available;
+            pd->rbuf_begin = pd->rbuf_end = 0;
+
+            return mdv_dispatcher_read(pd);
+        }
+
+        if (available < sizeof hdr + msg.hdr.size)
+            break;
+
+        msg.available_size = sizeof hdr + msg.hdr.size;
+        msg.payload = msg.hdr.size ? data + sizeof hdr : 0;
+
+        pd->rbuf_begin += msg.available_size;
+
+        err = mdv_dispatcher_handle(pd, &msg, false);
+
+        if (err != MDV_OK)
+            return err;
+    }
+
+    // Incomplete message is moved to the receive buffer beginning
+    if (pd->rbuf_begin == pd->rbuf_end)
+        pd->rbuf_begin = pd->rbuf_end = 0;
+    else if (pd->rbuf_begin)
+    {
+        memmove(pd->rbuf, pd->rbuf + pd->rbuf_begin, pd->rbuf_end - pd->rbuf_begin);
+        pd->rbuf_end -= pd->rbuf_begin;
+        pd->rbuf_begin = 0;
+    }
+
+    mdv_dispatcher_expire(pd);
+
+    return MDV_OK;
+}
@@ -14,6 +14,18 @@ typedef struct mdv_dispatcher mdv_dispatcher;
 typedef mdv_errno (*mdv_dispatcher_handler_fn)(mdv_msg const *msg, void *arg);
 
 
+/**
+ * @brief Response handler function for asynchronous requests
+ *
+ * @param err [in]      MDV_OK if response is received, MDV_ETIMEDOUT if response wasn't received in time,
+ *                      MDV_CLOSED if dispatcher is freed before response receiving
+ * @param resp [in]     received response or NULL pointer if request is failed.
+ *                      Response is valid only during handler call.
+ * @param arg [in]      argument which passed to mdv_dispatcher_send_async()
+ */
+typedef void (*mdv_dispatcher_response_fn)(mdv_errno err, mdv_msg const *resp, void *arg);
+
+
 /// Message handler
 typedef struct mdv_dispatcher_handler
 {
@@ -87,6 +99,34 @@ mdv_descriptor mdv_dispatcher_fd(mdv_dispatcher *pd);
 mdv_errno mdv_dispatcher_send(mdv_dispatcher *pd, mdv_msg *req, mdv_msg *resp, size_t timeout);
 
 
+/**
+ * @brief Send message without response waiting.
+ * @details Response handler is called from the data reading path when the response is received.
+ *          Number of asynchronous requests in flight isn't limited by the responses waiting slots.
+ *          Since the response handler is called by reader, it shouldn't wait responses synchronously.
+ *          Expired requests are completed by mdv_dispatcher_expire() which is called
+ *          during the data reading and new asynchronous requests sending.
+ *
+ * @param pd [in]       messages dispatcher
+ * @param req [in]      request to be sent
+ * @param timeout [in]  timeout for response wait (in milliseconds)
+ * @param fn [in]       response handler
+ * @param arg [in]      argument which passed to response handler
+ *
+ * @return MDV_OK if message is successfully sent. Response handler is called exactly once in this case.
+ * @return On error return nonzero error code and response handler isn't called.
+ */
+mdv_errno mdv_dispatcher_send_async(mdv_dispatcher *pd, mdv_msg *req, size_t timeout, mdv_dispatcher_response_fn fn, void *arg);
+
+
+/**
+ * @brief Completes expired asynchronous requests with MDV_ETIMEDOUT error
+ *
+ * @param pd [in]       messages dispatcher
+ */
+void mdv_dispatcher_expire(mdv_dispatcher *pd);
+
+
 /**
  * @brief Send message but response isn't required.
  *
@@ -126,6 +166,8 @@ mdv_errno mdv_dispatcher_reply(mdv_dispatcher *pd, mdv_msg const *msg);
 
 /**
  * @brief External notification for data reading
+ * @details Data is read by large chunks into the receive buffer and all completely received messages are handled.
+ *          Payloads of the messages which fit into the receive buffer are passed to handlers as buffer slices.
  *
  * @param pd [in]       messages dispatcher
  *
@@ -6,27 +6,61 @@
 #include <string.h>
 
 
+enum { MDV_MSG_BATCH = MDV_IOV_MAX / 2 };     // Maximum number of messages written by single system call
+
+
 mdv_errno mdv_write_msg(mdv_descriptor fd, mdv_msg const *msg)
 {
-    if (msg->hdr.size > MDV_MSG_SIZE_MAX)
-    {
-        MDV_LOGE("Message is too long");
-        return MDV_FAILED;
-    }
+    return mdv_write_msgs(fd, &msg, 1);
+}
+
+
+mdv_errno mdv_write_msgs(mdv_descriptor fd, mdv_msg const * const *msgs, size_t count)
+{
+    mdv_msghdr hdrs[MDV_MSG_BATCH];
+    mdv_iovec iov[MDV_IOV_MAX];
 
-    mdv_msghdr const hdr =
+    while(count)
     {
-        .id     = mdv_hton16(msg->hdr.id),
-        .number = mdv_hton16(msg->hdr.number),
-        .size   = mdv_hton32(msg->hdr.size)
-    };
+        size_t const n = count < MDV_MSG_BATCH ? count : MDV_MSG_BATCH;
+        size_t iov_count = 0;
+
+        for(size_t i = 0; i < n; ++i)
+        {
+            mdv_msg const *msg = msgs[i];
 
-    mdv_errno err = mdv_write_all(fd, &hdr, sizeof hdr);
+            if (msg->hdr.size > MDV_MSG_SIZE_MAX)
+            {
+                MDV_LOGE("Message is too long");
+                return MDV_FAILED;
+            }
 
-    if (err != MDV_OK)
-        return err;
+            hdrs[i].id     = mdv_hton16(msg->hdr.id);
+            hdrs[i].number = mdv_hton16(msg->hdr.number);
+            hdrs[i].size   = mdv_hton32(msg->hdr.size);
 
-    return mdv_write_all(fd, msg->payload, msg->hdr.size);
+            iov[iov_count].ptr = hdrs + i;
+            iov[iov_count].size = sizeof *hdrs;
+            ++iov_count;
+
+            if (msg->hdr.size)
+            {
+                iov[iov_count].ptr = msg->payload;
+                iov[iov_count].size = msg->hdr.size;
+                ++iov_count;
+            }
+        }
+
+        mdv_errno err = mdv_writev_all(fd, iov, iov_count);
+
+        if (err != MDV_OK)
+            return err;
+
+        msgs += n;
+        count -= n;
+    }
+
+    return MDV_OK;
 }
 
 
@@ -36,6 +36,20 @@ typedef struct mdv_msg
 mdv_errno mdv_write_msg(mdv_descriptor fd, mdv_msg const *msg);
 
 
+/**
+ * @brief Function for writing several messages to a file descriptor.
+ * @details Headers and payloads are written by vectored writing, so small messages are coalesced.
+ *
+ * @param fd [in]       file descriptor
+ * @param msgs [in]     messages to be send
+ * @param count [in]    messages count
+ *
+ * @return MDV_OK on success
+ * @return nonzero value on error
+ */
+mdv_errno mdv_write_msgs(mdv_descriptor fd, mdv_msg const * const *msgs, size_t count);
+
+
 /**
  * @brief Function for reading message from a file descriptor.
  *
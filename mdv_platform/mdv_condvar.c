@@ -122,6 +122,12 @@ mdv_errno mdv_condvar_timedwait(mdv_condvar *cv, size_t duration)
     t.tv_sec += duration / 1000;
     t.tv_nsec += (duration % 1000) * 1000000;
 
+    if (t.tv_nsec >= 1000000000)
+    {
+        t.tv_sec += 1;
+        t.tv_nsec -= 1000000000;
+    }
+
     if (pthread_mutex_lock(&cv->mutex) == 0)
     {
         int cv_err = pthread_cond_timedwait(&cv->cv, &cv->mutex, &t);
@@ -1,6 +1,8 @@
 #include "mdv_def.h"
 #include "mdv_log.h"
 #include <unistd.h>
+#include <sys/uio.h>
+#include <string.h>
 
 
 size_t mdv_descriptor_hash(mdv_descriptor const *fd)
@@ -72,6 +74,77 @@ mdv_errno mdv_write_all(mdv_descriptor fd, void const *data, size_t len)
 }
 
 
+mdv_errno mdv_writev(mdv_descriptor fd, mdv_iovec const *iov, size_t count, size_t *len)
+{
+    struct iovec vec[MDV_IOV_MAX];
+
+    if (count > MDV_IOV_MAX)
+        count = MDV_IOV_MAX;
+
+    for(size_t i = 0; i < count; ++i)
+    {
+        vec[i].iov_base = (void *)iov[i].ptr;
+        vec[i].iov_len = iov[i].size;
+    }
+
+    ssize_t res = writev(*(int*)&fd, vec, (int)count);
+
+    if (res == -1)
+        return mdv_error();
+
+    *len = (size_t)res;
+
+    return MDV_OK;
+}
+
+
+mdv_errno mdv_writev_all(mdv_descriptor fd, mdv_iovec const *iov, size_t count)
+{
+    mdv_iovec vec[MDV_IOV_MAX];
+
+    size_t offset = 0;      // Number of bytes written from the first buffer
+
+    while(count)
+    {
+        size_t const n = count < MDV_IOV_MAX ? count : MDV_IOV_MAX;
+
+        memcpy(vec, iov, n * sizeof *iov);
+
+        vec[0].ptr = (char const *)vec[0].ptr + offset;
+        vec[0].size -= offset;
+
+        size_t wlen = 0;
+
+        mdv_errno err = mdv_writev(fd, vec, n, &wlen);
+
+        switch (err)
+        {
+            case MDV_EAGAIN:
+                continue;
+
+            case MDV_OK:
+                break;
+
+            default:
+                return err;
+        }
+
+        // Skip written buffers
+        while(count && wlen >= iov->size - offset)
+        {
+            wlen -= iov->size - offset;
+            offset = 0;
+            ++iov;
+            --count;
+        }
+
+        offset += wlen;
+    }
+
+    return MDV_OK;
+}
+
+
 mdv_errno mdv_read(mdv_descriptor fd, void *data, size_t *len)
 {
     if (!*len)
@@ -22,6 +22,18 @@ typedef void* mdv_descriptor;
 #define MDV_INVALID_DESCRIPTOR 0
 
 
+/// Maximum number of buffers written by single vectored writing call
+#define MDV_IOV_MAX 64
+
+
+/// Data buffer for vectored writing
+typedef struct mdv_iovec
+{
+    void const *ptr;            ///< pointer to the buffer with data
+    size_t      size;           ///< data buffer size in bytes
+} mdv_iovec;
+
+
 /**
  * @brief Function for hash calculation for file descriptor
  *
@@ -80,6 +92,34 @@ mdv_errno mdv_write(mdv_descriptor fd, void const *data, size_t *len);
 mdv_errno mdv_write_all(mdv_descriptor fd, void const *data, size_t len);
 
 
+/**
+ * @brief Function for vectored writing to a file descriptor.
+ * @details Buffers are written by single system call. Only first MDV_IOV_MAX buffers are written.
+ *
+ * @param fd [in]       file descriptor
+ * @param iov [in]      buffers with data
+ * @param count [in]    buffers count
+ * @param len [out]     number of bytes which has been written
+ *
+ * @return MDV_OK on success
+ * @return nonzero value on error
+ */
+mdv_errno mdv_writev(mdv_descriptor fd, mdv_iovec const *iov, size_t count, size_t *len);
+
+
+/**
+ * @brief Function for vectored writing of all buffers to a file descriptor.
+ *
+ * @param fd [in]       file descriptor
+ * @param iov [in]      buffers with data
+ * @param count [in]    buffers count
+ *
+ * @return MDV_OK on success
+ * @return nonzero value on error
+ */
+mdv_errno mdv_writev_all(mdv_descriptor fd, mdv_iovec const *iov, size_t count);
+
+
 /**
  * @brief Function for reading from a file descriptor.
  *
@@ -5,6 +5,8 @@
     #include <sys/types.h>
     #include <sys/stat.h>
     #include <fcntl.h>
+    #include <unistd.h>
+    #include <errno.h>
 #endif
 
 
@@ -32,7 +34,7 @@ static int mdv_oflags2sys(int flags)
 
 mdv_descriptor mdv_open(const char *pathname, int flags)
 {
-    int ret = open(pathname, mdv_oflags2sys(flags));
+    int ret = open(pathname, mdv_oflags2sys(flags), 0664);
 
     if (ret == -1)
     {
@@ -82,3 +84,67 @@ mdv_errno mdv_file_size_by_fd(mdv_descriptor fd, size_t *size)
     return MDV_OK;
 }
 
+
+
+mdv_errno mdv_file_read_at(mdv_descriptor fd, void *data, size_t len, size_t offset)
+{
+    if (fd == MDV_INVALID_DESCRIPTOR)
+        return MDV_INVALID_ARG;
+
+    while(len)
+    {
+        ssize_t res = pread(*(int*)&fd, data, len, (off_t)offset);
+
+        if (res < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return mdv_error();
+        }
+
+        if (res == 0)
+            return MDV_FAILED;          // End of file
+
+        data = (char*)data + res;
+        len -= res;
+        offset += res;
+    }
+
+    return MDV_OK;
+}
+
+
+mdv_errno mdv_file_write_at(mdv_descriptor fd, void const *data, size_t len, size_t offset)
+{
+    if (fd == MDV_INVALID_DESCRIPTOR)
+        return MDV_INVALID_ARG;
+
+    while(len)
+    {
+        ssize_t res = pwrite(*(int*)&fd, data, len, (off_t)offset);
+
+        if (res < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return mdv_error();
+        }
+
+        data = (char const*)data + res;
+        len -= res;
+        offset += res;
+    }
+
+    return MDV_OK;
+}
+
+
+mdv_errno mdv_file_sync(mdv_descriptor fd)
+{
+    if (fd == MDV_INVALID_DESCRIPTOR)
+        return MDV_INVALID_ARG;
+
+    return fdatasync(*(int*)&fd) == 0
+            ? MDV_OK
+            : mdv_error();
+}
@@ -61,3 +61,41 @@ mdv_errno mdv_file_size_by_path(const char *path, size_t *size);
  * @return On success, returns MDV_OK, otherwise error code is returned
  */
 mdv_errno mdv_file_size_by_fd(mdv_descriptor fd, size_t *size);
+
+
+/**
+ * @brief Reads data from the given file offset
+ * @details Function reads exactly len bytes. Reading beyond the end of file is an error.
+ *
+ * @param fd [in]       file descriptor
+ * @param data [out]    buffer for data
+ * @param len [in]      data length
+ * @param offset [in]   file offset
+ *
+ * @return On success, returns MDV_OK, otherwise error code is returned
+ */
+mdv_errno mdv_file_read_at(mdv_descriptor fd, void *data, size_t len, size_t offset);
+
+
+/**
+ * @brief Writes data to the given file offset
+ * @details Function writes exactly len bytes.
+ *
+ * @param fd [in]       file descriptor
+ * @param data [in]     data for writing
+ * @param len [in]      data length
+ * @param offset [in]   file offset
+ *
+ * @return On success, returns MDV_OK, otherwise error code is returned
+ */
+mdv_errno mdv_file_write_at(mdv_descriptor fd, void const *data, size_t len, size_t offset);
+
+
+/**
+ * @brief Flushes the file data to the disk
+ *
+ * @param fd [in]       file descriptor
+ *
+ * @return On success, returns MDV_OK, otherwise error code is returned
+ */
+mdv_errno mdv_file_sync(mdv_descriptor fd);
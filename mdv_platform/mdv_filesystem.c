@@ -234,6 +234,28 @@ bool mdv_rmdir(char const *path)
 }
 
 
+bool mdv_rename(char const *from, char const *to)
+{
+    if (rename(from, to) == -1)
+    {
+        MDV_LOGE("rename failed. File '%s' could not be renamed due the error: %d", from, mdv_error());
+        return false;
+    }
+    return true;
+}
+
+
+bool mdv_remove(char const *path)
+{
+    if (remove(path) == -1 && mdv_error() != MDV_ENOENT)
+    {
+        MDV_LOGE("remove failed. File '%s' could not be removed due the error: %d", path, mdv_error());
+        return false;
+    }
+    return true;
+}
+
+
 typedef struct
 {
     mdv_enumerator base;
@@ -6,4 +6,6 @@
 
 bool mdv_mkdir(char const *path);
 bool mdv_rmdir(char const *path);
+bool mdv_rename(char const *from, char const *to);
+bool mdv_remove(char const *path);
 mdv_enumerator * mdv_dir_enumerator(char const *path);
@@ -52,7 +52,19 @@ static mdv_hashmap * mdv_router_unique_nodes(mdv_vector *topolinks, mdv_vector *
 }
 
 
-mdv_hashmap * mdv_routes_find(mdv_topology *topology, mdv_uuid const *src)
+/// MST edge
+typedef struct
+{
+    mdv_uuid node[2];   ///< Linked nodes
+} mdv_router_edge;
+
+
+/**
+ * @brief Finds the minimum spanning tree edges for the network topology
+ *
+ * @return MST edges (vector<mdv_router_edge>)
+ */
+static mdv_vector * mdv_router_mst(mdv_topology *topology)
 {
     mdv_rollbacker *rollbacker = mdv_rollbacker_create(5);
 
@@ -63,11 +75,7 @@ mdv_hashmap * mdv_routes_find(mdv_topology *topology, mdv_uuid const *src)
     if (mdv_vector_empty(topolinks))
     {
         mdv_rollback(rollbacker);
-        return mdv_hashmap_create(mdv_route,
-                                  uuid,
-                                  0,
-                                  mdv_uuid_hash,
-                                  mdv_uuid_cmp);
+        return mdv_vector_create(0, sizeof(mdv_router_edge), &mdv_default_allocator);
     }
 
     mdv_vector *toponodes = mdv_topology_nodes(topology);
@@ -131,66 +139,152 @@ mdv_hashmap * mdv_routes_find(mdv_topology *topology, mdv_uuid const *src)
     size_t mst_size = mdv_mst_find(mst_nodes, mdv_hashmap_size(unique_nodes),
                                    mst_links, mdv_vector_size(topolinks));
 
-    if (mst_size)
+    mdv_vector *edges = mdv_vector_create(mst_size, sizeof(mdv_router_edge), &mdv_default_allocator);
+
+    if (!edges)
+    {
+        MDV_LOGE("No memory for MST edges");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    for(size_t i = 0; i < mdv_vector_size(topolinks); ++i)
+    {
+        if (mst_links[i].mst)
+        {
+            mdv_toponode const *lnode = mst_links[i].src->data;
+            mdv_toponode const *rnode = mst_links[i].dst->data;
+
+            mdv_router_edge const edge =
+            {
+                .node = { lnode->uuid, rnode->uuid }
+            };
+
+            if (!mdv_vector_push_back(edges, &edge))
+            {
+                MDV_LOGE("No memory for MST edges");
+                mdv_vector_release(edges);
+                mdv_rollback(rollbacker);
+                return 0;
+            }
+        }
+    }
+
+    mdv_rollback(rollbacker);
+
+    return edges;
+}
+
+
+mdv_hashmap * mdv_routes_find(mdv_topology *topology, mdv_uuid const *src)
+{
+    mdv_vector *edges = mdv_router_mst(topology);
+
+    if (!edges)
+        return 0;
+
+    mdv_hashmap *routes = mdv_hashmap_create(mdv_route,
+                                             uuid,
+                                             mdv_vector_size(edges) * 5 / 3,
+                                             mdv_uuid_hash,
+                                             mdv_uuid_cmp);
+
+    if (!routes)
+    {
+        MDV_LOGE("No memory for routes");
+        mdv_vector_release(edges);
+        return 0;
+    }
+
+    mdv_vector_foreach(edges, mdv_router_edge, edge)
     {
-        mdv_hashmap *routes = mdv_hashmap_create(
-                                        mdv_route,
-                                        uuid,
-                                        mst_size * 5 / 3,
-                                        mdv_uuid_hash,
-                                        mdv_uuid_cmp);
-
-        if (!routes)
+        for(int i = 0; i < 2; ++i)
         {
-            MDV_LOGE("No memory for routes");
-            mdv_rollback(rollbacker);
-            return 0;
+            if (mdv_uuid_cmp(src, edge->node + i) != 0)
+                continue;
+
+            mdv_route const route = { edge->node[1 - i] };
+
+            if (!mdv_hashmap_insert(routes, &route, sizeof route))
+            {
+                MDV_LOGE("No memory for routes");
+                mdv_hashmap_release(routes);
+                mdv_vector_release(edges);
+                return 0;
+            }
         }
+    }
+
+    mdv_vector_release(edges);
+
+    return routes;
+}
+
+
+mdv_hashmap * mdv_nexthops_find(mdv_topology *topology, mdv_uuid const *src)
+{
+    mdv_vector *edges = mdv_router_mst(topology);
+
+    if (!edges)
+        return 0;
+
+    mdv_hashmap *hops = mdv_hashmap_create(mdv_nexthop,
+                                           dst,
+                                           mdv_vector_size(edges) * 5 / 3,
+                                           mdv_uuid_hash,
+                                           mdv_uuid_cmp);
 
-        for(size_t i = 0; i < mdv_vector_size(topolinks); ++i)
+    if (!hops)
+    {
+        MDV_LOGE("No memory for next hops");
+        mdv_vector_release(edges);
+        return 0;
+    }
+
+    // Tree is expanded from the source node. Destination inherits the next hop of its parent.
+    for(bool expanded = true; expanded;)
+    {
+        expanded = false;
+
+        mdv_vector_foreach(edges, mdv_router_edge, edge)
         {
-            if (mst_links[i].mst)
+            for(int i = 0; i < 2; ++i)
             {
-                mdv_toponode const *lnode = mst_links[i].src->data;
-                mdv_toponode const *rnode = mst_links[i].dst->data;
+                mdv_uuid const *parent = edge->node + i;
+                mdv_uuid const *child = edge->node + 1 - i;
+
+                if (mdv_uuid_cmp(child, src) == 0
+                    || mdv_hashmap_find(hops, child))
+                    continue;
+
+                mdv_nexthop hop = { .dst = *child };
 
-                if (mdv_uuid_cmp(src, &lnode->uuid) == 0)
+                if (mdv_uuid_cmp(parent, src) == 0)
+                    hop.hop = *child;
+                else
                 {
-                    mdv_route const route = { rnode->uuid };
-
-                    if (!mdv_hashmap_insert(routes, &route, sizeof route))
-                    {
-                        mdv_hashmap_release(routes);
-                        MDV_LOGE("No memory for routes");
-                        mdv_rollback(rollbacker);
-                        return 0;
-                    }
+                    mdv_nexthop const *parent_hop = mdv_hashmap_find(hops, parent);
+
+                    if (!parent_hop)
+                        continue;
+
+                    hop.hop = parent_hop->hop;
                 }
-                else if (mdv_uuid_cmp(src, &rnode->uuid) == 0)
+
+                if (!mdv_hashmap_insert(hops, &hop, sizeof hop))
                 {
-                    mdv_route const route = { lnode->uuid };
-
-                    if (!mdv_hashmap_insert(routes, &route, sizeof route))
-                    {
-                        mdv_hashmap_release(routes);
-                        MDV_LOGE("No memory for routes");
-                        mdv_rollback(rollbacker);
-                        return 0;
-                    }
+                    MDV_LOGE("No memory for next hops");
+                    mdv_hashmap_release(hops);
+                    mdv_vector_release(edges);
+                    return 0;
                 }
+
+                expanded = true;
             }
         }
-
-        mdv_rollback(rollbacker);
-
-        return routes;
     }
 
-    mdv_rollback(rollbacker);
+    mdv_vector_release(edges);
 
-    return mdv_hashmap_create(mdv_route,
-                                uuid,
-                                0,
-                                mdv_uuid_hash,
-                                mdv_uuid_cmp);
+    return hops;
 }
@@ -19,6 +19,14 @@ typedef struct
 } mdv_route;
 
 
+/// Next hop for destination node
+typedef struct
+{
+    mdv_uuid dst;   ///< Destination node uuid
+    mdv_uuid hop;   ///< Next hop uuid
+} mdv_nexthop;
+
+
 /**
  * @brief Find best routes for specified source node
  *
@@ -28,3 +36,16 @@ typedef struct
  * @return Vector of peers identifiers (vector<uuid>).
  */
 mdv_hashmap * mdv_routes_find(mdv_topology *topology, mdv_uuid const *src);
+
+
+/**
+ * @brief Find next hops for all nodes reachable from the source node
+ * @details Data is delivered along the routes returned by mdv_routes_find().
+ *          So the next hop is the source node neighbour through which the destination node is reached.
+ *
+ * @param topology [in] Network topology
+ * @param src [in]      Source node uuid
+ *
+ * @return Next hops for destination nodes (hashmap<mdv_nexthop>).
+ */
+mdv_hashmap * mdv_nexthops_find(mdv_topology *topology, mdv_uuid const *src);
@@ -68,7 +68,196 @@ static mdv_errno mdv_vm_stack_top(mdv_stack_base *stack, mdv_vm_datum *data)
 }
 
 
-mdv_errno mdv_vm_run(mdv_stack_base *stack, mdv_vm_fn const *fns, size_t fns_count, uint8_t const *program)
+static mdv_errno mdv_vm_stack_pop_pair(mdv_stack_base *stack, mdv_vm_datum ops[2])
+{
+    mdv_errno err = mdv_vm_stack_pop(stack, &ops[1]);
+
+    if(err != MDV_OK)
+        return err;
+
+    err = mdv_vm_stack_pop(stack, &ops[0]);
+
+    if(err != MDV_OK)
+        return err;
+
+    return MDV_OK;
+}
+
+
+static mdv_errno mdv_vm_stack_push_bool(mdv_stack_base *stack, bool value)
+{
+    uint32_t const size = sizeof(uint8_t);
+
+    if (mdv_stack_free_space(*stack) < sizeof(uint8_t) + sizeof size + sizeof(bool))
+        return MDV_STACK_OVERFLOW;
+
+    char *top = stack->data + stack->size;
+
+    *(uint8_t *)top = value ? MDV_VM_TRUE : MDV_VM_FALSE;
+    memcpy(top + sizeof(uint8_t), &size, sizeof size);
+    *(bool *)(top + sizeof(uint8_t) + sizeof size) = false;
+
+    stack->size += sizeof(uint8_t) + sizeof size + sizeof(bool);
+
+    return MDV_OK;
+}
+
+
+/// Three-way comparison results
+enum
+{
+    MDV_VM_LESS      = -1,
+    MDV_VM_EQUAL     = 0,
+    MDV_VM_GREATER   = 1,
+    MDV_VM_UNORDERED = 2      ///< NaN was compared
+};
+
+
+/// Typed arrays comparison function
+typedef int (*mdv_vm_cmp_fn)(uint8_t const *lhs, uint32_t lhs_size, uint8_t const *rhs, uint32_t rhs_size);
+
+
+static int mdv_vm_cmp_bytes(uint8_t const *lhs, uint32_t lhs_size, uint8_t const *rhs, uint32_t rhs_size)
+{
+    int const res = memcmp(lhs, rhs, lhs_size < rhs_size ? lhs_size : rhs_size);
+
+    if (res)
+        return res < 0 ? MDV_VM_LESS : MDV_VM_GREATER;
+
+    return lhs_size < rhs_size ? MDV_VM_LESS
+            : lhs_size > rhs_size ? MDV_VM_GREATER
+            : MDV_VM_EQUAL;
+}
+
+
+static int mdv_vm_cmp_bool(uint8_t const *lhs, uint32_t lhs_size, uint8_t const *rhs, uint32_t rhs_size)
+{
+    uint32_t const size = lhs_size < rhs_size ? lhs_size : rhs_size;
+
+    for(uint32_t i = 0; i < size; ++i)
+    {
+        bool const a = lhs[i] != 0;
+        bool const b = rhs[i] != 0;
+
+        if (a != b)
+            return a < b ? MDV_VM_LESS : MDV_VM_GREATER;
+    }
+
+    return lhs_size < rhs_size ? MDV_VM_LESS
+            : lhs_size > rhs_size ? MDV_VM_GREATER
+            : MDV_VM_EQUAL;
+}
+
+
+// Values are loaded using memcpy because row fields may be unaligned.
+#define MDV_VM_CMP_TYPED(name, T)                                                           \
+    static int mdv_vm_cmp_##name(uint8_t const *lhs, uint32_t lhs_size,                     \
+                                 uint8_t const *rhs, uint32_t rhs_size)                     \
+    {                                                                                       \
+        if (lhs_size == sizeof(T) && rhs_size == sizeof(T))                                 \
+        {                                                                                   \
+            T a, b;                                                                         \
+            memcpy(&a, lhs, sizeof a);                                                      \
+            memcpy(&b, rhs, sizeof b);                                                      \
+            return a < b ? MDV_VM_LESS                                                      \
+                    : a > b ? MDV_VM_GREATER                                                \
+                    : a == b ? MDV_VM_EQUAL                                                 \
+                    : MDV_VM_UNORDERED;                                                     \
+        }                                                                                   \
+                                                                                            \
+        uint32_t const lhs_count = lhs_size / sizeof(T);                                    \
+        uint32_t const rhs_count = rhs_size / sizeof(T);                                    \
+        uint32_t const count = lhs_count < rhs_count ? lhs_count : rhs_count;               \
+                                                                                            \
+        for(uint32_t i = 0; i < count; ++i)                                                 \
+        {                                                                                   \
+            T a, b;                                                                         \
+            memcpy(&a, lhs + i * sizeof(T), sizeof a);                                      \
+            memcpy(&b, rhs + i * sizeof(T), sizeof b);                                      \
+            if (a < b)                                                                      \
+                return MDV_VM_LESS;                                                         \
+            if (a > b)                                                                      \
+                return MDV_VM_GREATER;                                                      \
+            if (a != b)                                                                     \
+                return MDV_VM_UNORDERED;                                                    \
+        }                                                                                   \
+                                                                                            \
+        return lhs_count < rhs_count ? MDV_VM_LESS                                          \
+                : lhs_count > rhs_count ? MDV_VM_GREATER                                    \
+                : MDV_VM_EQUAL;                                                             \
+    }
+
+MDV_VM_CMP_TYPED(int8,   int8_t)
+MDV_VM_CMP_TYPED(uint8,  uint8_t)
+MDV_VM_CMP_TYPED(int16,  int16_t)
+MDV_VM_CMP_TYPED(uint16, uint16_t)
+MDV_VM_CMP_TYPED(int32,  int32_t)
+MDV_VM_CMP_TYPED(uint32, uint32_t)
+MDV_VM_CMP_TYPED(int64,  int64_t)
+MDV_VM_CMP_TYPED(uint64, uint64_t)
+MDV_VM_CMP_TYPED(float,  float)
+MDV_VM_CMP_TYPED(double, double)
+
+#undef MDV_VM_CMP_TYPED
+
+
+/// Comparison functions (indices are mdv_vm_type values)
+static mdv_vm_cmp_fn const MDV_VM_CMP_FNS[MDV_VM_TYPES_COUNT] =
+{
+    [MDV_VM_TYPE_BYTES]  = mdv_vm_cmp_bytes,
+    [MDV_VM_TYPE_BOOL]   = mdv_vm_cmp_bool,
+    [MDV_VM_TYPE_INT8]   = mdv_vm_cmp_int8,
+    [MDV_VM_TYPE_UINT8]  = mdv_vm_cmp_uint8,
+    [MDV_VM_TYPE_INT16]  = mdv_vm_cmp_int16,
+    [MDV_VM_TYPE_UINT16] = mdv_vm_cmp_uint16,
+    [MDV_VM_TYPE_INT32]  = mdv_vm_cmp_int32,
+    [MDV_VM_TYPE_UINT32] = mdv_vm_cmp_uint32,
+    [MDV_VM_TYPE_INT64]  = mdv_vm_cmp_int64,
+    [MDV_VM_TYPE_UINT64] = mdv_vm_cmp_uint64,
+    [MDV_VM_TYPE_FLOAT]  = mdv_vm_cmp_float,
+    [MDV_VM_TYPE_DOUBLE] = mdv_vm_cmp_double,
+};
+
+
+static mdv_errno mdv_vm_cmp(mdv_stack_base *stack, uint8_t type, uint8_t op)
+{
+    if (type >= MDV_VM_TYPES_COUNT)
+        return MDV_INVALID_TYPE;
+
+    mdv_vm_datum ops[2];
+
+    mdv_errno err = mdv_vm_stack_pop_pair(stack, ops);
+
+    if(err != MDV_OK)
+        return err;
+
+    // Operands data is still valid here because nothing was pushed after pop
+    int const cmp_res = MDV_VM_CMP_FNS[type](ops[0].data, ops[0].size, ops[1].data, ops[1].size);
+
+    bool res = false;
+
+    switch(op)
+    {
+        case MDV_VM_CMP_EQ: res = cmp_res == MDV_VM_EQUAL;                             break;
+        case MDV_VM_CMP_NE: res = cmp_res != MDV_VM_EQUAL;                             break;
+        case MDV_VM_CMP_GT: res = cmp_res == MDV_VM_GREATER;                           break;
+        case MDV_VM_CMP_GE: res = cmp_res == MDV_VM_GREATER || cmp_res == MDV_VM_EQUAL; break;
+        case MDV_VM_CMP_LT: res = cmp_res == MDV_VM_LESS;                              break;
+        case MDV_VM_CMP_LE: res = cmp_res == MDV_VM_LESS || cmp_res == MDV_VM_EQUAL;    break;
+        default:
+            return MDV_INVALID_ARG;
+    }
+
+    return mdv_vm_stack_push_bool(stack, res);
+}
+
+
+mdv_errno mdv_vm_run(mdv_stack_base     *stack,
+                     mdv_vm_fn const    *fns,
+                     size_t              fns_count,
+                     mdv_vm_datum const *args,
+                     size_t              args_count,
+                     uint8_t const      *program)
 {
     mdv_errno err = MDV_OK;
 
@@ -132,6 +321,47 @@ mdv_errno mdv_vm_run(mdv_stack_base *stack, mdv_vm_fn const *fns, size_t fns_cou
                 break;
             }
 
+            case MDV_VM_ARG:
+            {
+                uint16_t const id = *(uint16_t*)ip;
+                ip += sizeof id;
+
+                if (id >= args_count)
+                {
+                    ip = 0;
+                    err = MDV_INVALID_ARG;
+                    break;
+                }
+
+                mdv_vm_datum const datum =
+                {
+                    .external = true,
+                    .size = args[id].size,
+                    .data = args[id].data
+                };
+
+                err = mdv_vm_stack_push(stack, &datum);
+
+                if (err != MDV_OK)
+                    ip = 0;
+
+                break;
+            }
+
+            case MDV_VM_CMP:
+            {
+                uint8_t const type = ip[0];
+                uint8_t const op = ip[1];
+                ip += 2 * sizeof(uint8_t);
+
+                err = mdv_vm_cmp(stack, type, op);
+
+                if (err != MDV_OK)
+                    ip = 0;
+
+                break;
+            }
+
             default:
             {
                 MDV_LOGE("Unknown instruction type");
@@ -167,22 +397,6 @@ mdv_errno mdv_vm_result_as_bool(mdv_stack_base *stack, bool *res)
 }
 
 
-static mdv_errno mdv_vm_stack_pop_pair(mdv_stack_base *stack, mdv_vm_datum ops[2])
-{
-    mdv_errno err = mdv_vm_stack_pop(stack, &ops[1]);
-
-    if(err != MDV_OK)
-        return err;
-
-    err = mdv_vm_stack_pop(stack, &ops[0]);
-
-    if(err != MDV_OK)
-        return err;
-
-    return MDV_OK;
-}
-
-
 mdv_errno mdv_vmop_equal(mdv_stack_base *stack)
 {
     mdv_vm_datum op[2];
@@ -29,10 +29,43 @@ typedef enum
     MDV_VM_NOP = 0,     /// NOP                                     [0]
     MDV_VM_PUSH,        /// PUSH ExtFlag Size Data (Size is 4 bytes)[1][x][xxxx][...]
     MDV_VM_CALL,        /// CALL FunctionId (FunctionId is 2 bytes) [2][xx]
+    MDV_VM_ARG,         /// ARG ArgumentId (ArgumentId is 2 bytes)  [3][xx]
+    MDV_VM_CMP,         /// CMP Type Operation                      [4][x][x]
     MDV_VM_END = 0xff   /// END                                     [0xFF]
 } mdv_vm_commands;
 
 
+/// Operands types for CMP command
+typedef enum
+{
+    MDV_VM_TYPE_BYTES = 0,  /// Bytes sequence (lexicographical comparison of unsigned bytes)
+    MDV_VM_TYPE_BOOL,       /// bool (any nonzero value is true)
+    MDV_VM_TYPE_INT8,       /// int8
+    MDV_VM_TYPE_UINT8,      /// uint8
+    MDV_VM_TYPE_INT16,      /// int16
+    MDV_VM_TYPE_UINT16,     /// uint16
+    MDV_VM_TYPE_INT32,      /// int32
+    MDV_VM_TYPE_UINT32,     /// uint32
+    MDV_VM_TYPE_INT64,      /// int64
+    MDV_VM_TYPE_UINT64,     /// uint64
+    MDV_VM_TYPE_FLOAT,      /// float
+    MDV_VM_TYPE_DOUBLE,     /// double
+    MDV_VM_TYPES_COUNT
+} mdv_vm_type;
+
+
+/// Comparison operations for CMP command
+typedef enum
+{
+    MDV_VM_CMP_EQ = 0,      /// lhs == rhs
+    MDV_VM_CMP_NE,          /// lhs != rhs
+    MDV_VM_CMP_GT,          /// lhs > rhs
+    MDV_VM_CMP_GE,          /// lhs >= rhs
+    MDV_VM_CMP_LT,          /// lhs < rhs
+    MDV_VM_CMP_LE           /// lhs <= rhs
+} mdv_vm_cmp_op;
+
+
 typedef enum
 {
     MDV_VM_TRUE = 0xFF,
@@ -82,19 +115,26 @@ mdv_errno mdv_vm_stack_pop(mdv_stack_base *stack, mdv_vm_datum *data);
 
 /**
  * @brief VM program interpretation
+ * @details ARG command pushes the program argument to the stack as external data (without copying).
+ *          CMP command pops two operands of given type and pushes the comparison result.
+ *          Operands are arrays of values of given type. Arrays are compared lexicographically.
  *
  * @param stack [in]        VM stack
  * @param fns [in]          Custom commands handlers
  * @param fns_count [in]    Custom commands handlers count
+ * @param args [in]         Program arguments
+ * @param args_count [in]   Program arguments count
  * @param program [in]      Commands sequence
  *
  * @return On success, returns MDV_OK
  * @return On error, returns non zero error code
  */
-mdv_errno mdv_vm_run(mdv_stack_base  *stack,
-                     mdv_vm_fn const *fns,
-                     size_t           fns_count,
-                     uint8_t const   *program);
+mdv_errno mdv_vm_run(mdv_stack_base     *stack,
+                     mdv_vm_fn const    *fns,
+                     size_t              fns_count,
+                     mdv_vm_datum const *args,
+                     size_t              args_count,
+                     uint8_t const      *program);
 
 
 /**
@@ -1,6 +1,7 @@
 #include "mdv_2pset.h"
 #include "mdv_lmdb.h"
 #include "mdv_names.h"
+#include "mdv_index.h"
 #include <mdv_rollbacker.h>
 #include <mdv_alloc.h>
 #include <mdv_mutex.h>
@@ -16,6 +17,7 @@ struct mdv_2pset
     mdv_lmdb        *storage;       ///< objects storage
     mdv_mutex        idgen_mutex;   ///< mutex for objects identifiers generator
     uint64_t         idgen;         ///< last free object identifier
+    mdv_2pset_indexes indexes;      ///< Secondary indexes
 };
 
 
@@ -70,6 +72,12 @@ static bool mdv_objects_idgen_init(mdv_2pset *objs)
 
 
 mdv_2pset * mdv_2pset_open(char const *root_dir, char const *storage_name)
+{
+    return mdv_2pset_open_indexed(root_dir, storage_name, 0);
+}
+
+
+mdv_2pset * mdv_2pset_open_indexed(char const *root_dir, char const *storage_name, mdv_2pset_indexes const *indexes)
 {
     mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
 
@@ -84,10 +92,15 @@ mdv_2pset * mdv_2pset_open(char const *root_dir, char const *storage_name)
 
     mdv_rollbacker_push(rollbacker, mdv_free, objs);
 
+    if (indexes)
+        objs->indexes = *indexes;
+    else
+        memset(&objs->indexes, 0, sizeof objs->indexes);
+
     objs->storage = mdv_storage_open(root_dir,
                                      storage_name,
-                                     MDV_STRG_OBJECTS_MAPS,
-                                     MDV_STRG_NOSUBDIR,
+                                     MDV_STRG_OBJECTS_MAPS + objs->indexes.count,
+                                     MDV_STRG_NOSUBDIR | MDV_STRG_NOTLS,
                                      LMDB_MAP_SIZE);
 
     if (!objs->storage)
@@ -230,79 +243,103 @@ static bool mdv_objects_is_deleted(mdv_2pset     *objs,
 }
 
 
-mdv_errno mdv_2pset_add(mdv_2pset *objs, mdv_data const *id, mdv_data const *obj)
+static void mdv_2pset_indexes_close(mdv_2pset *objs, mdv_map *maps)
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
+    for(uint32_t i = 0; i < objs->indexes.count; ++i)
+        mdv_map_close(maps + i);
+}
 
-    // Start transaction
-    mdv_transaction transaction = mdv_transaction_start(objs->storage);
 
-    if (!mdv_transaction_ok(transaction))
+static bool mdv_2pset_indexes_open(mdv_2pset *objs, mdv_transaction *transaction, mdv_map *maps)
+{
+    for(uint32_t i = 0; i < objs->indexes.count; ++i)
     {
-        MDV_LOGE("CFstorage transaction not started");
-        mdv_rollback(rollbacker);
-        return MDV_FAILED;
-    }
+        char name[32];
 
-    mdv_rollbacker_push(rollbacker, mdv_transaction_abort, &transaction);
+        maps[i] = mdv_map_open(transaction,
+                               MDV_MAP_INDEX(i, name, sizeof name),
+                               MDV_MAP_CREATE);
 
-    // Open objects map
-    mdv_map objs_map = mdv_map_open(&transaction,
-                                    MDV_MAP_OBJECTS,
-                                    MDV_MAP_CREATE);
+        if (!mdv_map_ok(maps[i]))
+        {
+            MDV_LOGE("Table '%s' not opened", name);
 
-    if (!mdv_map_ok(objs_map))
-    {
-        MDV_LOGE("Table '%s' not opened", MDV_MAP_OBJECTS);
-        mdv_rollback(rollbacker);
-        return MDV_FAILED;
+            while(i--)
+                mdv_map_close(maps + i);
+
+            return false;
+        }
     }
 
-    mdv_rollbacker_push(rollbacker, mdv_map_close, &objs_map);
+    return true;
+}
 
-    // Open removed objects table
-    mdv_map rem_map = mdv_map_open(&transaction, MDV_MAP_REMOVED, MDV_MAP_CREATE);
 
-    if (!mdv_map_ok(rem_map))
+static bool mdv_2pset_indexes_add(mdv_2pset       *objs,
+                                  mdv_transaction *transaction,
+                                  mdv_map         *maps,
+                                  mdv_data const  *id,
+                                  mdv_data const  *obj)
+{
+    uint8_t buf[MDV_INDEX_KEY_MAX + id->size];
+
+    for(uint32_t i = 0; i < objs->indexes.count; ++i)
     {
-        MDV_LOGE("Table '%s' not opened", MDV_MAP_REMOVED);
-        mdv_rollback(rollbacker);
-        return MDV_FAILED;
-    }
+        size_t const key_size = objs->indexes.key(objs->indexes.arg, i, obj, buf);
 
-    mdv_rollbacker_push(rollbacker, mdv_map_close, &rem_map);
+        if (!key_size)
+            continue;
 
+        memcpy(buf + key_size, id->ptr, id->size);
 
-    if (!mdv_objects_is_deleted(objs,
-                                &rem_map,
-                                &transaction,
-                                id))    // Delete op has priority
-    {
-        if (!mdv_map_put_unique(&objs_map, &transaction, id, obj))
-            MDV_LOGW("Object is already exist.");
+        mdv_data const key =
+        {
+            .size = key_size + id->size,
+            .ptr = buf
+        };
 
-        if (!mdv_transaction_commit(&transaction))
+        if (!mdv_map_put(maps + i, transaction, &key, id))
         {
-            MDV_LOGE("Object insertion failed.");
-            mdv_rollback(rollbacker);
-            return MDV_FAILED;
+            MDV_LOGE("Secondary index update failed");
+            return false;
         }
     }
-    else
-        mdv_transaction_abort(&transaction);
 
-    mdv_map_close(&objs_map);
-    mdv_map_close(&rem_map);
+    return true;
+}
 
-    mdv_rollbacker_free(rollbacker);
 
-    return MDV_OK;
+static void mdv_2pset_indexes_del(mdv_2pset       *objs,
+                                  mdv_transaction *transaction,
+                                  mdv_map         *maps,
+                                  mdv_data const  *id,
+                                  mdv_data const  *obj)
+{
+    uint8_t buf[MDV_INDEX_KEY_MAX + id->size];
+
+    for(uint32_t i = 0; i < objs->indexes.count; ++i)
+    {
+        size_t const key_size = objs->indexes.key(objs->indexes.arg, i, obj, buf);
+
+        if (!key_size)
+            continue;
+
+        memcpy(buf + key_size, id->ptr, id->size);
+
+        mdv_data const key =
+        {
+            .size = key_size + id->size,
+            .ptr = buf
+        };
+
+        mdv_map_del(maps + i, transaction, &key, 0);
+    }
 }
 
 
-mdv_errno mdv_2pset_add_batch(mdv_2pset *objs, void *arg, bool (*next)(void *arg, mdv_data *id, mdv_data *obj))
+mdv_errno mdv_2pset_add(mdv_2pset *objs, mdv_data const *id, mdv_data const *obj)
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(4);
 
     // Start transaction
     mdv_transaction transaction = mdv_transaction_start(objs->storage);
@@ -342,32 +379,33 @@ mdv_errno mdv_2pset_add_batch(mdv_2pset *objs, void *arg, bool (*next)(void *arg
 
     mdv_rollbacker_push(rollbacker, mdv_map_close, &rem_map);
 
-    bool commit = false;
+    // Open secondary indexes
+    mdv_map index_maps[objs->indexes.count + 1];
 
-    mdv_data id, obj;
+    if (!mdv_2pset_indexes_open(objs, &transaction, index_maps))
+    {
+        mdv_rollback(rollbacker);
+        return MDV_FAILED;
+    }
 
-    while(next(arg, &id, &obj))
+    mdv_rollbacker_push(rollbacker, mdv_2pset_indexes_close, objs, index_maps);
+
+    if (!mdv_objects_is_deleted(objs,
+                                &rem_map,
+                                &transaction,
+                                id))    // Delete op has priority
     {
-        if (!mdv_objects_is_deleted(objs,
-                                    &rem_map,
-                                    &transaction,
-                                    &id))    // Delete op has priority
+        if (!mdv_map_put_unique(&objs_map, &transaction, id, obj))
+            MDV_LOGW("Object is already exist.");
+        else if (!mdv_2pset_indexes_add(objs, &transaction, index_maps, id, obj))
         {
-            if (mdv_map_put_unique(&objs_map, &transaction, &id, &obj))
-                commit = true;
-            else
-                MDV_LOGW("Object is already exist.");
+            mdv_rollback(rollbacker);
+            return MDV_FAILED;
         }
-        else
-            mdv_transaction_abort(&transaction);
-
-    }
 
-    if (commit)
-    {
         if (!mdv_transaction_commit(&transaction))
         {
-            MDV_LOGE("Objects insertion failed.");
+            MDV_LOGE("Object insertion failed.");
             mdv_rollback(rollbacker);
             return MDV_FAILED;
         }
@@ -375,6 +413,7 @@ mdv_errno mdv_2pset_add_batch(mdv_2pset *objs, void *arg, bool (*next)(void *arg
     else
         mdv_transaction_abort(&transaction);
 
+    mdv_2pset_indexes_close(objs, index_maps);
     mdv_map_close(&objs_map);
     mdv_map_close(&rem_map);
 
@@ -384,185 +423,795 @@ mdv_errno mdv_2pset_add_batch(mdv_2pset *objs, void *arg, bool (*next)(void *arg
 }
 
 
-void * mdv_2pset_get(mdv_2pset *objs, mdv_data const *id, void * (*restore)(mdv_data const *))
+/// Batch of DB objects modifications which are written within one transaction
+struct mdv_2pset_batch
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
+    mdv_2pset       *objs;          ///< DB objects storage
+    mdv_transaction  transaction;   ///< Write transaction
+    mdv_map          objs_map;      ///< Objects map
+    mdv_map          rem_map;       ///< Removed objects map
+    mdv_map          marks_map;     ///< Marks map (opened on demand)
+    bool             changed;       ///< Flag indicates that the batch contains modifications
+    mdv_map          index_maps[];  ///< Secondary indexes
+};
 
-    // Start transaction
-    mdv_transaction transaction = mdv_transaction_start(objs->storage);
 
-    if (!mdv_transaction_ok(transaction))
+static void mdv_2pset_batch_free(mdv_2pset_batch *batch)
+{
+    mdv_2pset_indexes_close(batch->objs, batch->index_maps);
+    mdv_map_close(&batch->objs_map);
+    mdv_map_close(&batch->rem_map);
+    mdv_map_close(&batch->marks_map);
+    mdv_free(batch);
+}
+
+
+mdv_2pset_batch * mdv_2pset_batch_begin(mdv_2pset *objs)
+{
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(5);
+
+    mdv_2pset_batch *batch = mdv_alloc(offsetof(mdv_2pset_batch, index_maps)
+                                       + sizeof(mdv_map) * (objs->indexes.count + 1));
+
+    if (!batch)
     {
-        MDV_LOGE("CFstorage transaction not started");
+        MDV_LOGE("No free space of memory for objects batch");
         mdv_rollback(rollbacker);
         return 0;
     }
 
-    mdv_rollbacker_push(rollbacker, mdv_transaction_abort, &transaction);
+    mdv_rollbacker_push(rollbacker, mdv_free, batch);
 
-    // Open objects map
-    mdv_map objs_map = mdv_map_open(&transaction,
-                                    MDV_MAP_OBJECTS,
-                                    MDV_MAP_SILENT);
+    batch->objs = objs;
+    batch->changed = false;
+    memset(&batch->marks_map, 0, sizeof batch->marks_map);
 
-    if (!mdv_map_ok(objs_map))
+    // Start transaction
+    batch->transaction = mdv_transaction_start(objs->storage);
+
+    if (!mdv_transaction_ok(batch->transaction))
     {
-        MDV_LOGE("Table '%s' not opened", MDV_MAP_OBJECTS);
+        MDV_LOGE("CFstorage transaction not started");
         mdv_rollback(rollbacker);
         return 0;
     }
 
-    mdv_rollbacker_push(rollbacker, mdv_map_close, &objs_map);
+    mdv_rollbacker_push(rollbacker, mdv_transaction_abort, &batch->transaction);
 
-    // Open removed objects table
-    mdv_map rem_map = mdv_map_open(&transaction, MDV_MAP_REMOVED, MDV_MAP_SILENT);
+    // Open objects map
+    batch->objs_map = mdv_map_open(&batch->transaction,
+                                   MDV_MAP_OBJECTS,
+                                   MDV_MAP_CREATE);
 
-    if (!mdv_map_ok(rem_map))
+    if (!mdv_map_ok(batch->objs_map))
     {
-        MDV_LOGE("Table '%s' not opened", MDV_MAP_REMOVED);
+        MDV_LOGE("Table '%s' not opened", MDV_MAP_OBJECTS);
         mdv_rollback(rollbacker);
         return 0;
     }
 
-    mdv_rollbacker_push(rollbacker, mdv_map_close, &rem_map);
+    mdv_rollbacker_push(rollbacker, mdv_map_close, &batch->objs_map);
 
-    if (mdv_objects_is_deleted(objs,
-                                &rem_map,
-                                &transaction,
-                                id))
+    // Open removed objects table
+    batch->rem_map = mdv_map_open(&batch->transaction, MDV_MAP_REMOVED, MDV_MAP_CREATE);
+
+    if (!mdv_map_ok(batch->rem_map))
     {
-        MDV_LOGE("Object was deleted");
+        MDV_LOGE("Table '%s' not opened", MDV_MAP_REMOVED);
         mdv_rollback(rollbacker);
         return 0;
     }
 
-    mdv_data value = {};
+    mdv_rollbacker_push(rollbacker, mdv_map_close, &batch->rem_map);
 
-    if (!mdv_map_get(&objs_map, &transaction, id, &value))
+    // Open secondary indexes
+    if (!mdv_2pset_indexes_open(objs, &batch->transaction, batch->index_maps))
     {
-        MDV_LOGW("Object wasn't found.");
         mdv_rollback(rollbacker);
         return 0;
     }
 
-    void *obj = restore(&value);
-
-    mdv_transaction_abort(&transaction);
-    mdv_map_close(&objs_map);
-    mdv_map_close(&rem_map);
-
     mdv_rollbacker_free(rollbacker);
 
-    return obj;
+    return batch;
 }
 
 
-/// Objects set enumerator
-typedef struct
+mdv_errno mdv_2pset_batch_add(mdv_2pset_batch *batch, void *arg, bool (*next)(void *arg, mdv_data *id, mdv_data *obj))
 {
-    mdv_enumerator          base;           ///< Base type for rowset enumerator
-    mdv_2pset              *objects;        ///< Objects storage
-    mdv_map                 map;            ///< Objects map
-    mdv_transaction         transaction;    ///< Transaction
-    mdv_cursor              cursor;         ///< Cursor for objects access
-    mdv_kvdata              current;        ///< Current object key and value
-} mdv_objects_enumerator_impl;
+    mdv_2pset *objs = batch->objs;
 
+    mdv_data id, obj;
 
-static mdv_enumerator * mdv_objects_enumerator_impl_retain(mdv_enumerator *enumerator)
-{
-    atomic_fetch_add_explicit(&enumerator->rc, 1, memory_order_acquire);
-    return enumerator;
+    while(next(arg, &id, &obj))
+    {
+        if (!mdv_objects_is_deleted(objs,
+                                    &batch->rem_map,
+                                    &batch->transaction,
+                                    &id))    // Delete op has priority
+        {
+            if (mdv_map_put_unique(&batch->objs_map, &batch->transaction, &id, &obj))
+            {
+                if (!mdv_2pset_indexes_add(objs, &batch->transaction, batch->index_maps, &id, &obj))
+                    return MDV_FAILED;
+
+                batch->changed = true;
+            }
+            else
+                MDV_LOGW("Object is already exist.");
+        }
+    }
+
+    return MDV_OK;
 }
 
 
-static uint32_t mdv_objects_enumerator_impl_release(mdv_enumerator *enumerator)
+mdv_errno mdv_2pset_batch_remove(mdv_2pset_batch *batch, mdv_data const *tombstone, void *arg, bool (*next)(void *arg, mdv_data *id))
 {
-    uint32_t rc = 0;
+    mdv_2pset *objs = batch->objs;
 
-    if (enumerator)
+    mdv_data id;
+
+    while(next(arg, &id))
     {
-        mdv_objects_enumerator_impl *impl = (mdv_objects_enumerator_impl *)enumerator;
+        if (mdv_objects_is_deleted(objs,
+                                   &batch->rem_map,
+                                   &batch->transaction,
+                                   &id))
+            continue;
 
-        rc = atomic_fetch_sub_explicit(&enumerator->rc, 1, memory_order_release) - 1;
+        mdv_data obj;
 
-        if (!rc)
+        bool const exists = mdv_map_get(&batch->objs_map, &batch->transaction, &id, &obj);
+
+        if (exists)
         {
-            mdv_cursor_close(&impl->cursor);
-            mdv_transaction_abort(&impl->transaction);
-            mdv_map_close(&impl->map);
-            mdv_2pset_release(impl->objects);
-            mdv_free(enumerator);
+            mdv_2pset_indexes_del(objs, &batch->transaction, batch->index_maps, &id, &obj);
+
+            if (!mdv_map_del(&batch->objs_map, &batch->transaction, &id, 0))
+            {
+                MDV_LOGE("Object deletion failed.");
+                return MDV_FAILED;
+            }
+        }
+
+        // Tombstone is stored even if the object isn't received yet.
+        // Such tombstones are empty and they are never purged.
+        mdv_data const empty = { 0, 0 };
+
+        if (!mdv_map_put(&batch->rem_map, &batch->transaction, &id, exists ? tombstone : &empty))
+        {
+            MDV_LOGE("Object deletion failed.");
+            return MDV_FAILED;
         }
+
+        batch->changed = true;
     }
 
-    return rc;
+    return MDV_OK;
 }
 
 
-static mdv_errno mdv_objects_enumerator_impl_reset(mdv_enumerator *enumerator)
+static bool mdv_2pset_batch_marks_open(mdv_2pset_batch *batch)
 {
-    mdv_objects_enumerator_impl *impl = (mdv_objects_enumerator_impl *)enumerator;
-    return mdv_cursor_get(&impl->cursor, &impl->current.key, &impl->current.value, MDV_CURSOR_FIRST)
-                ? MDV_OK
-                : MDV_FAILED;
-}
+    if (mdv_map_ok(batch->marks_map))
+        return true;
 
+    batch->marks_map = mdv_map_open(&batch->transaction, MDV_MAP_MARKS, MDV_MAP_CREATE);
 
-static mdv_errno mdv_objects_enumerator_impl_next(mdv_enumerator *enumerator)
-{
-    mdv_objects_enumerator_impl *impl = (mdv_objects_enumerator_impl *)enumerator;
-    return mdv_cursor_get(&impl->cursor,
-                          &impl->current.key,
-                          &impl->current.value,
-                          MDV_CURSOR_NEXT)
-                ? MDV_OK
-                : MDV_FAILED;
+    if (!mdv_map_ok(batch->marks_map))
+    {
+        MDV_LOGE("Table '%s' not opened", MDV_MAP_MARKS);
+        return false;
+    }
+
+    return true;
 }
 
 
-static void * mdv_objects_enumerator_impl_current(mdv_enumerator *enumerator)
+bool mdv_2pset_batch_mark_get(mdv_2pset_batch *batch, mdv_data const *key, mdv_data *value)
 {
-    mdv_objects_enumerator_impl *impl = (mdv_objects_enumerator_impl *)enumerator;
-    return &impl->current;
+    if (!mdv_2pset_batch_marks_open(batch))
+        return false;
+
+    mdv_data v = {};
+
+    if (!mdv_map_get(&batch->marks_map, &batch->transaction, key, &v)
+        || v.size != value->size)
+        return false;
+
+    memcpy(value->ptr, v.ptr, v.size);
+
+    return true;
 }
 
 
-static mdv_enumerator * mdv_objects_enumerator_impl_create(mdv_2pset *objs, mdv_data const *key, mdv_cursor_op op)
+mdv_errno mdv_2pset_batch_mark_set(mdv_2pset_batch *batch, mdv_data const *key, mdv_data const *value)
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
-
-    mdv_objects_enumerator_impl *enumerator =
-            mdv_alloc(sizeof(mdv_objects_enumerator_impl));
+    if (!mdv_2pset_batch_marks_open(batch))
+        return MDV_FAILED;
 
-    if (!enumerator)
+    if (!mdv_map_put(&batch->marks_map, &batch->transaction, key, value))
     {
-        MDV_LOGE("No memory for objects iterator");
-        return 0;
+        MDV_LOGE("Storage mark wasn't saved");
+        return MDV_FAILED;
     }
 
-    memset(enumerator, 0, sizeof(mdv_objects_enumerator_impl));
+    batch->changed = true;
 
-    if (key)
-        enumerator->current.key = *key;
+    return MDV_OK;
+}
 
-    mdv_rollbacker_push(rollbacker, mdv_free, enumerator);
 
-    atomic_init(&enumerator->base.rc, 1);
+mdv_errno mdv_2pset_batch_commit(mdv_2pset_batch *batch)
+{
+    mdv_errno err = MDV_OK;
 
-    static mdv_ienumerator const vtbl =
+    if (batch->changed)
     {
-        .retain = mdv_objects_enumerator_impl_retain,
-        .release = mdv_objects_enumerator_impl_release,
-        .reset = mdv_objects_enumerator_impl_reset,
-        .next = mdv_objects_enumerator_impl_next,
-        .current = mdv_objects_enumerator_impl_current
-    };
+        if (!mdv_transaction_commit(&batch->transaction))
+        {
+            MDV_LOGE("Objects batch commit failed.");
+            err = MDV_FAILED;
+        }
+    }
+    else
+        mdv_transaction_abort(&batch->transaction);
+
+    mdv_2pset_batch_free(batch);
+
+    return err;
+}
+
+
+void mdv_2pset_batch_abort(mdv_2pset_batch *batch)
+{
+    mdv_transaction_abort(&batch->transaction);
+    mdv_2pset_batch_free(batch);
+}
+
+
+mdv_errno mdv_2pset_add_batch(mdv_2pset *objs, void *arg, bool (*next)(void *arg, mdv_data *id, mdv_data *obj))
+{
+    mdv_2pset_batch *batch = mdv_2pset_batch_begin(objs);
+
+    if (!batch)
+        return MDV_FAILED;
+
+    mdv_errno err = mdv_2pset_batch_add(batch, arg, next);
+
+    if (err != MDV_OK)
+    {
+        mdv_2pset_batch_abort(batch);
+        return err;
+    }
+
+    return mdv_2pset_batch_commit(batch);
+}
+
+
+mdv_errno mdv_2pset_remove_batch(mdv_2pset *objs, mdv_data const *tombstone, void *arg, bool (*next)(void *arg, mdv_data *id))
+{
+    mdv_2pset_batch *batch = mdv_2pset_batch_begin(objs);
+
+    if (!batch)
+        return MDV_FAILED;
+
+    mdv_errno err = mdv_2pset_batch_remove(batch, tombstone, arg, next);
+
+    if (err != MDV_OK)
+    {
+        mdv_2pset_batch_abort(batch);
+        return err;
+    }
+
+    return mdv_2pset_batch_commit(batch);
+}
+
+
+static mdv_errno mdv_2pset_import_objects(mdv_2pset_batch *batch, mdv_transaction *transaction, mdv_2pset_translator const *translator)
+{
+    mdv_map map = mdv_map_open(transaction, MDV_MAP_OBJECTS, MDV_MAP_SILENT);
+
+    if (!mdv_map_ok(map))
+        return MDV_OK;          // There are no objects
+
+    mdv_errno err = MDV_OK;
+
+    mdv_map_foreach(*transaction, map, entry)
+    {
+        mdv_data id = entry.key;
+
+        if (!translator->id(translator->arg, &id))
+        {
+            MDV_LOGE("Object identifier translation failed");
+            err = MDV_FAILED;
+            mdv_map_foreach_break(entry);
+        }
+
+        if (!mdv_map_put_unique(&batch->objs_map, &batch->transaction, &id, &entry.value)
+            || !mdv_2pset_indexes_add(batch->objs, &batch->transaction, batch->index_maps, &id, &entry.value))
+        {
+            MDV_LOGE("Object import failed");
+            err = MDV_FAILED;
+            mdv_map_foreach_break(entry);
+        }
+
+        batch->changed = true;
+    }
+
+    mdv_map_close(&map);
+
+    return err;
+}
+
+
+static mdv_errno mdv_2pset_import_tombstones(mdv_2pset_batch *batch, mdv_transaction *transaction, mdv_2pset_translator const *translator)
+{
+    mdv_map map = mdv_map_open(transaction, MDV_MAP_REMOVED, MDV_MAP_SILENT);
+
+    if (!mdv_map_ok(map))
+        return MDV_OK;          // There are no tombstones
+
+    mdv_errno err = MDV_OK;
+
+    mdv_map_foreach(*transaction, map, entry)
+    {
+        mdv_data id = entry.key;
+        mdv_data tombstone = entry.value;
+
+        if (!translator->id(translator->arg, &id)
+            || (tombstone.size && !translator->tombstone(translator->arg, &tombstone)))
+        {
+            MDV_LOGE("Tombstone translation failed");
+            err = MDV_FAILED;
+            mdv_map_foreach_break(entry);
+        }
+
+        if (!mdv_map_put(&batch->rem_map, &batch->transaction, &id, &tombstone))
+        {
+            MDV_LOGE("Tombstone import failed");
+            err = MDV_FAILED;
+            mdv_map_foreach_break(entry);
+        }
+
+        batch->changed = true;
+    }
+
+    mdv_map_close(&map);
+
+    return err;
+}
+
+
+static mdv_errno mdv_2pset_import_marks(mdv_2pset_batch *batch, mdv_transaction *transaction)
+{
+    mdv_map map = mdv_map_open(transaction, MDV_MAP_MARKS, MDV_MAP_SILENT);
+
+    if (!mdv_map_ok(map))
+        return MDV_OK;          // There are no marks
+
+    mdv_errno err = MDV_OK;
+
+    mdv_map_foreach(*transaction, map, entry)
+    {
+        err = mdv_2pset_batch_mark_set(batch, &entry.key, &entry.value);
+
+        if (err != MDV_OK)
+            mdv_map_foreach_break(entry);
+    }
+
+    mdv_map_close(&map);
+
+    return err;
+}
+
+
+static mdv_errno mdv_2pset_import_idgen(mdv_2pset_batch *batch, mdv_map *idgen_map, uint64_t idgen)
+{
+    if (idgen <= batch->objs->idgen)
+        return MDV_OK;
+
+    *idgen_map = mdv_map_open(&batch->transaction,
+                              MDV_MAP_IDGEN,
+                              MDV_MAP_INTEGERKEY | MDV_MAP_CREATE);
+
+    if (!mdv_map_ok(*idgen_map))
+    {
+        MDV_LOGE("Table '%s' not opened", MDV_MAP_IDGEN);
+        return MDV_FAILED;
+    }
+
+    mdv_data key = { sizeof MDV_OBJECTS_IDGEN, &MDV_OBJECTS_IDGEN };
+    mdv_data value = { sizeof idgen, &idgen };
+
+    if (!mdv_map_put(idgen_map, &batch->transaction, &key, &value))
+    {
+        MDV_LOGE("Identifiers generator wasn't saved");
+        return MDV_FAILED;
+    }
+
+    batch->changed = true;
+
+    return MDV_OK;
+}
+
+
+mdv_errno mdv_2pset_import(mdv_2pset *objs, mdv_2pset *src, mdv_2pset_translator const *translator)
+{
+    mdv_errno err = mdv_mutex_lock(&objs->idgen_mutex);
+
+    if (err != MDV_OK)
+    {
+        MDV_LOGE("Mutex lock failed");
+        return err;
+    }
+
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
+
+    mdv_rollbacker_push(rollbacker, mdv_mutex_unlock, &objs->idgen_mutex);
+
+    mdv_transaction transaction = mdv_transaction_start_rdonly(src->storage);
+
+    if (!mdv_transaction_ok(transaction))
+    {
+        MDV_LOGE("Transaction not started");
+        mdv_rollback(rollbacker);
+        return MDV_FAILED;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_transaction_abort, &transaction);
+
+    mdv_2pset_batch *batch = mdv_2pset_batch_begin(objs);
+
+    if (!batch)
+    {
+        mdv_rollback(rollbacker);
+        return MDV_FAILED;
+    }
+
+    // Identifiers generator map is closed when the batch transaction is finished
+    mdv_map idgen_map = {};
+    uint64_t idgen = 0;
+
+    if ((err = mdv_2pset_import_objects(batch, &transaction, translator)) != MDV_OK
+        || (err = mdv_2pset_import_tombstones(batch, &transaction, translator)) != MDV_OK
+        || (err = mdv_2pset_import_marks(batch, &transaction)) != MDV_OK
+        || (err = mdv_2pset_import_idgen(batch, &idgen_map, idgen = translator->idgen(translator->arg))) != MDV_OK)
+    {
+        mdv_2pset_batch_abort(batch);
+        mdv_map_close(&idgen_map);
+        mdv_rollback(rollbacker);
+        return err;
+    }
+
+    mdv_transaction_abort(&transaction);
+
+    err = mdv_2pset_batch_commit(batch);
+
+    mdv_map_close(&idgen_map);
+
+    if (err == MDV_OK && idgen > objs->idgen)
+        objs->idgen = idgen;
+
+    mdv_mutex_unlock(&objs->idgen_mutex);
+
+    mdv_rollbacker_free(rollbacker);
+
+    return err;
+}
+
+
+mdv_errno mdv_2pset_purge(mdv_2pset *objs, size_t limit, void *arg, bool (*purgeable)(void *arg, mdv_data const *tombstone), size_t *purged)
+{
+    *purged = 0;
+
+    if (!limit)
+        return MDV_OK;
+
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
+
+    // Start transaction
+    mdv_transaction transaction = mdv_transaction_start(objs->storage);
+
+    if (!mdv_transaction_ok(transaction))
+    {
+        MDV_LOGE("CFstorage transaction not started");
+        mdv_rollback(rollbacker);
+        return MDV_FAILED;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_transaction_abort, &transaction);
+
+    // Open removed objects table
+    mdv_map rem_map = mdv_map_open(&transaction, MDV_MAP_REMOVED, MDV_MAP_SILENT);
+
+    if (!mdv_map_ok(rem_map))
+    {
+        // There are no tombstones
+        mdv_rollback(rollbacker);
+        return MDV_OK;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_map_close, &rem_map);
+
+    mdv_data id = {}, tombstone = {};
+
+    mdv_cursor cursor = mdv_cursor_open_first(&rem_map, &transaction, &id, &tombstone);
+
+    if (!mdv_cursor_ok(cursor))
+    {
+        mdv_rollback(rollbacker);
+        return MDV_OK;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_cursor_close, &cursor);
+
+    do
+    {
+        if (!tombstone.size
+            || !purgeable(arg, &tombstone))
+            continue;
+
+        if (!mdv_cursor_del(&cursor))
+        {
+            MDV_LOGE("Tombstone purging failed");
+            mdv_rollback(rollbacker);
+            return MDV_FAILED;
+        }
+
+        ++*purged;
+    }
+    while(*purged < limit
+          && mdv_cursor_get(&cursor, &id, &tombstone, MDV_CURSOR_NEXT));
+
+    mdv_cursor_close(&cursor);
+
+    if (*purged)
+    {
+        if (!mdv_transaction_commit(&transaction))
+        {
+            MDV_LOGE("Tombstones purging failed");
+            *purged = 0;
+            mdv_map_close(&rem_map);
+            mdv_rollbacker_free(rollbacker);
+            return MDV_FAILED;
+        }
+    }
+    else
+        mdv_transaction_abort(&transaction);
+
+    mdv_map_close(&rem_map);
+
+    mdv_rollbacker_free(rollbacker);
+
+    return MDV_OK;
+}
+
+
+void mdv_2pset_compact(mdv_2pset *objs)
+{
+    mdv_storage_compact(objs->storage);
+}
+
+
+mdv_errno mdv_2pset_copy(mdv_2pset *objs, mdv_descriptor fd)
+{
+    return mdv_storage_copy(objs->storage, fd);
+}
+
+
+bool mdv_2pset_empty(mdv_2pset *objs)
+{
+    mdv_transaction transaction = mdv_transaction_start_rdonly(objs->storage);
+
+    if (!mdv_transaction_ok(transaction))
+    {
+        MDV_LOGE("Transaction not started");
+        return false;
+    }
+
+    bool empty = true;
+
+    // Objects map isn't created until the first object is added
+    mdv_map map = mdv_map_open(&transaction, MDV_MAP_OBJECTS, MDV_MAP_SILENT);
+
+    if (mdv_map_ok(map))
+    {
+        mdv_map_foreach(transaction, map, entry)
+        {
+            empty = false;
+            mdv_map_foreach_break(entry);
+        }
+
+        mdv_map_close(&map);
+    }
+
+    mdv_transaction_abort(&transaction);
+
+    return empty;
+}
+
+
+void * mdv_2pset_get(mdv_2pset *objs, mdv_data const *id, void * (*restore)(mdv_data const *))
+{
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
+
+    // Start transaction
+    mdv_transaction transaction = mdv_transaction_start(objs->storage);
+
+    if (!mdv_transaction_ok(transaction))
+    {
+        MDV_LOGE("CFstorage transaction not started");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_transaction_abort, &transaction);
+
+    // Open objects map
+    mdv_map objs_map = mdv_map_open(&transaction,
+                                    MDV_MAP_OBJECTS,
+                                    MDV_MAP_SILENT);
+
+    if (!mdv_map_ok(objs_map))
+    {
+        MDV_LOGE("Table '%s' not opened", MDV_MAP_OBJECTS);
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_map_close, &objs_map);
+
+    // Open removed objects table
+    mdv_map rem_map = mdv_map_open(&transaction, MDV_MAP_REMOVED, MDV_MAP_SILENT);
+
+    if (!mdv_map_ok(rem_map))
+    {
+        MDV_LOGE("Table '%s' not opened", MDV_MAP_REMOVED);
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_map_close, &rem_map);
+
+    if (mdv_objects_is_deleted(objs,
+                                &rem_map,
+                                &transaction,
+                                id))
+    {
+        MDV_LOGE("Object was deleted");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_data value = {};
+
+    if (!mdv_map_get(&objs_map, &transaction, id, &value))
+    {
+        MDV_LOGW("Object wasn't found.");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    void *obj = restore(&value);
+
+    mdv_transaction_abort(&transaction);
+    mdv_map_close(&objs_map);
+    mdv_map_close(&rem_map);
+
+    mdv_rollbacker_free(rollbacker);
+
+    return obj;
+}
+
+
+/// Objects set enumerator
+typedef struct
+{
+    mdv_enumerator          base;           ///< Base type for rowset enumerator
+    mdv_2pset              *objects;        ///< Objects storage
+    mdv_map                 map;            ///< Objects map
+    mdv_transaction         transaction;    ///< Transaction
+    mdv_cursor              cursor;         ///< Cursor for objects access
+    mdv_kvdata              current;        ///< Current object key and value
+} mdv_objects_enumerator_impl;
+
+
+static mdv_enumerator * mdv_objects_enumerator_impl_retain(mdv_enumerator *enumerator)
+{
+    atomic_fetch_add_explicit(&enumerator->rc, 1, memory_order_acquire);
+    return enumerator;
+}
+
+
+static uint32_t mdv_objects_enumerator_impl_release(mdv_enumerator *enumerator)
+{
+    uint32_t rc = 0;
+
+    if (enumerator)
+    {
+        mdv_objects_enumerator_impl *impl = (mdv_objects_enumerator_impl *)enumerator;
+
+        rc = atomic_fetch_sub_explicit(&enumerator->rc, 1, memory_order_release) - 1;
+
+        if (!rc)
+        {
+            mdv_cursor_close(&impl->cursor);
+            mdv_transaction_abort(&impl->transaction);
+            mdv_map_close(&impl->map);
+            mdv_2pset_release(impl->objects);
+            mdv_free(enumerator);
+        }
+    }
+
+    return rc;
+}
+
+
+static mdv_errno mdv_objects_enumerator_impl_reset(mdv_enumerator *enumerator)
+{
+    mdv_objects_enumerator_impl *impl = (mdv_objects_enumerator_impl *)enumerator;
+    return mdv_cursor_get(&impl->cursor, &impl->current.key, &impl->current.value, MDV_CURSOR_FIRST)
+                ? MDV_OK
+                : MDV_FAILED;
+}
+
+
+static mdv_errno mdv_objects_enumerator_impl_next(mdv_enumerator *enumerator)
+{
+    mdv_objects_enumerator_impl *impl = (mdv_objects_enumerator_impl *)enumerator;
+    return mdv_cursor_get(&impl->cursor,
+                          &impl->current.key,
+                          &impl->current.value,
+                          MDV_CURSOR_NEXT)
+                ? MDV_OK
+                : MDV_FAILED;
+}
+
+
+static void * mdv_objects_enumerator_impl_current(mdv_enumerator *enumerator)
+{
+    mdv_objects_enumerator_impl *impl = (mdv_objects_enumerator_impl *)enumerator;
+    return &impl->current;
+}
+
+
+static mdv_enumerator * mdv_objects_enumerator_impl_create(mdv_2pset *objs, mdv_data const *key, mdv_cursor_op op)
+{
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
+
+    mdv_objects_enumerator_impl *enumerator =
+            mdv_alloc(sizeof(mdv_objects_enumerator_impl));
+
+    if (!enumerator)
+    {
+        MDV_LOGE("No memory for objects iterator");
+        return 0;
+    }
+
+    memset(enumerator, 0, sizeof(mdv_objects_enumerator_impl));
+
+    if (key)
+        enumerator->current.key = *key;
+
+    mdv_rollbacker_push(rollbacker, mdv_free, enumerator);
+
+    atomic_init(&enumerator->base.rc, 1);
+
+    static mdv_ienumerator const vtbl =
+    {
+        .retain = mdv_objects_enumerator_impl_retain,
+        .release = mdv_objects_enumerator_impl_release,
+        .reset = mdv_objects_enumerator_impl_reset,
+        .next = mdv_objects_enumerator_impl_next,
+        .current = mdv_objects_enumerator_impl_current
+    };
 
     enumerator->base.vptr = &vtbl;
 
     // Start transaction
-    enumerator->transaction = mdv_transaction_start(objs->storage);
+    enumerator->transaction = mdv_transaction_start_rdonly(objs->storage);
 
     if (!mdv_transaction_ok(enumerator->transaction))
     {
@@ -618,3 +1267,199 @@ mdv_enumerator * mdv_2pset_enumerator_from(mdv_2pset *objs, mdv_data const *id)
 {
     return mdv_objects_enumerator_impl_create(objs, id, MDV_CURSOR_SET_RANGE);
 }
+
+
+/// Secondary index enumerator
+typedef struct
+{
+    mdv_enumerator          base;           ///< Base type for index enumerator
+    mdv_2pset              *objects;        ///< Objects storage
+    mdv_map                 map;            ///< Objects map
+    mdv_map                 index;          ///< Secondary index map
+    mdv_transaction         transaction;    ///< Transaction
+    mdv_cursor              cursor;         ///< Cursor for index entries access
+    mdv_kvdata              current;        ///< Current index key and object
+} mdv_index_enumerator_impl;
+
+
+static mdv_enumerator * mdv_index_enumerator_impl_retain(mdv_enumerator *enumerator)
+{
+    atomic_fetch_add_explicit(&enumerator->rc, 1, memory_order_acquire);
+    return enumerator;
+}
+
+
+static uint32_t mdv_index_enumerator_impl_release(mdv_enumerator *enumerator)
+{
+    uint32_t rc = 0;
+
+    if (enumerator)
+    {
+        mdv_index_enumerator_impl *impl = (mdv_index_enumerator_impl *)enumerator;
+
+        rc = atomic_fetch_sub_explicit(&enumerator->rc, 1, memory_order_release) - 1;
+
+        if (!rc)
+        {
+            mdv_cursor_close(&impl->cursor);
+            mdv_transaction_abort(&impl->transaction);
+            mdv_map_close(&impl->index);
+            mdv_map_close(&impl->map);
+            mdv_2pset_release(impl->objects);
+            mdv_free(enumerator);
+        }
+    }
+
+    return rc;
+}
+
+
+/**
+ * @brief Reads the object for current index entry.
+ * @details Index entries for missing objects are skipped.
+ */
+static bool mdv_index_enumerator_impl_fetch(mdv_index_enumerator_impl *impl, mdv_cursor_op op)
+{
+    mdv_data id;
+
+    for(bool found = mdv_cursor_get(&impl->cursor, &impl->current.key, &id, op);
+        found;
+        found = mdv_cursor_get(&impl->cursor, &impl->current.key, &id, MDV_CURSOR_NEXT))
+    {
+        if (mdv_map_get(&impl->map, &impl->transaction, &id, &impl->current.value))
+            return true;
+    }
+
+    return false;
+}
+
+
+static mdv_errno mdv_index_enumerator_impl_reset(mdv_enumerator *enumerator)
+{
+    mdv_index_enumerator_impl *impl = (mdv_index_enumerator_impl *)enumerator;
+    return mdv_index_enumerator_impl_fetch(impl, MDV_CURSOR_FIRST)
+                ? MDV_OK
+                : MDV_FAILED;
+}
+
+
+static mdv_errno mdv_index_enumerator_impl_next(mdv_enumerator *enumerator)
+{
+    mdv_index_enumerator_impl *impl = (mdv_index_enumerator_impl *)enumerator;
+    return mdv_index_enumerator_impl_fetch(impl, MDV_CURSOR_NEXT)
+                ? MDV_OK
+                : MDV_FAILED;
+}
+
+
+static void * mdv_index_enumerator_impl_current(mdv_enumerator *enumerator)
+{
+    mdv_index_enumerator_impl *impl = (mdv_index_enumerator_impl *)enumerator;
+    return &impl->current;
+}
+
+
+mdv_enumerator * mdv_2pset_index_enumerator(mdv_2pset *objs, uint32_t index, mdv_data const *key)
+{
+    if (index >= objs->indexes.count)
+    {
+        MDV_LOGE("Invalid secondary index number: %u", index);
+        return 0;
+    }
+
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(5);
+
+    mdv_index_enumerator_impl *enumerator =
+            mdv_alloc(sizeof(mdv_index_enumerator_impl));
+
+    if (!enumerator)
+    {
+        MDV_LOGE("No memory for index iterator");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    memset(enumerator, 0, sizeof(mdv_index_enumerator_impl));
+
+    if (key)
+        enumerator->current.key = *key;
+
+    mdv_rollbacker_push(rollbacker, mdv_free, enumerator);
+
+    atomic_init(&enumerator->base.rc, 1);
+
+    static mdv_ienumerator const vtbl =
+    {
+        .retain = mdv_index_enumerator_impl_retain,
+        .release = mdv_index_enumerator_impl_release,
+        .reset = mdv_index_enumerator_impl_reset,
+        .next = mdv_index_enumerator_impl_next,
+        .current = mdv_index_enumerator_impl_current
+    };
+
+    enumerator->base.vptr = &vtbl;
+
+    // Start transaction
+    enumerator->transaction = mdv_transaction_start_rdonly(objs->storage);
+
+    if (!mdv_transaction_ok(enumerator->transaction))
+    {
+        MDV_LOGE("Transaction not started");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_transaction_abort, &enumerator->transaction);
+
+    // Open objects map
+    enumerator->map = mdv_map_open(&enumerator->transaction, MDV_MAP_OBJECTS, 0);
+
+    if (!mdv_map_ok(enumerator->map))
+    {
+        MDV_LOGE("Table '%s' not opened", MDV_MAP_OBJECTS);
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_map_close, &enumerator->map);
+
+    // Open secondary index map
+    char name[32];
+
+    enumerator->index = mdv_map_open(&enumerator->transaction,
+                                     MDV_MAP_INDEX(index, name, sizeof name),
+                                     0);
+
+    if (!mdv_map_ok(enumerator->index))
+    {
+        MDV_LOGE("Table '%s' not opened", name);
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_map_close, &enumerator->index);
+
+    // Create cursor for index entries iteration
+    enumerator->cursor = mdv_cursor_open(&enumerator->index, &enumerator->transaction);
+
+    if (!mdv_cursor_ok(enumerator->cursor))
+    {
+        MDV_LOGE("Table '%s' cursor not opened", name);
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_cursor_close, &enumerator->cursor);
+
+    if (!mdv_index_enumerator_impl_fetch(enumerator, key ? MDV_CURSOR_SET_RANGE : MDV_CURSOR_FIRST))
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    enumerator->objects = mdv_2pset_retain(objs);
+
+    mdv_rollbacker_free(rollbacker);
+
+    return &enumerator->base;
+}
@@ -18,6 +18,67 @@
 typedef struct mdv_2pset mdv_2pset;
 
 
+/**
+ * @brief Secondary indexes for DB objects
+ * @details Each secondary index is stored in separate map. Index entry key is the
+ *          object key followed by object identifier. Index entry value is object identifier.
+ */
+typedef struct
+{
+    uint32_t    count;      ///< Secondary indexes count
+    void       *arg;        ///< Argument which is passed to index key generator
+
+    /**
+     * @brief Index key generator
+     *
+     * @param arg [in]      Argument
+     * @param index [in]    Secondary index number
+     * @param obj [in]      Serialized object
+     * @param key [out]     Buffer for index key (MDV_INDEX_KEY_MAX bytes)
+     *
+     * @return Index key size. Zero size means the object isn't indexed.
+     */
+    size_t    (*key)(void *arg, uint32_t index, mdv_data const *obj, uint8_t *key);
+} mdv_2pset_indexes;
+
+
+/**
+ * @brief Translator for objects imported from other storage
+ * @details Objects identifiers and tombstones may contain values which are meaningful only for
+ *          the source storage owner. Such values are translated during the import.
+ */
+typedef struct
+{
+    void       *arg;        ///< Argument which is passed to translators
+
+    /**
+     * @brief Object identifier translator
+     *
+     * @param arg [in]      Argument
+     * @param id [in, out]  Object identifier. Translated identifier may point to the memory owned by translator.
+     *
+     * @return true if the identifier is translated
+     */
+    bool      (*id)(void *arg, mdv_data *id);
+
+    /**
+     * @brief Tombstone translator. Empty tombstones aren't translated.
+     *
+     * @param arg [in]              Argument
+     * @param tombstone [in, out]   Tombstone. Translated tombstone may point to the memory owned by translator.
+     *
+     * @return true if the tombstone is translated
+     */
+    bool      (*tombstone)(void *arg, mdv_data *tombstone);
+
+    /**
+     * @brief Returns the identifiers generator value required for imported objects.
+     * @details It's called when all objects are translated. Identifiers below this value aren't generated anymore.
+     */
+    uint64_t  (*idgen)(void *arg);
+} mdv_2pset_translator;
+
+
 /**
  * @brief Creates new or opens existing DB objects storage
  *
@@ -29,6 +90,19 @@ typedef struct mdv_2pset mdv_2pset;
 mdv_2pset * mdv_2pset_open(char const *root_dir, char const *storage_name);
 
 
+/**
+ * @brief Creates new or opens existing DB objects storage with secondary indexes
+ * @details Secondary indexes are maintained within the same transactions as objects.
+ *
+ * @param root_dir [in]     Root directory for DB objects storage
+ * @param storage_name [in] storage name
+ * @param indexes [in]      Secondary indexes
+ *
+ * @return DB objects storage
+ */
+mdv_2pset * mdv_2pset_open_indexed(char const *root_dir, char const *storage_name, mdv_2pset_indexes const *indexes);
+
+
 /**
  * @brief Add reference counter
  *
@@ -88,6 +162,177 @@ mdv_errno mdv_2pset_add(mdv_2pset *objs, mdv_data const *id, mdv_data const *obj
 mdv_errno mdv_2pset_add_batch(mdv_2pset *objs, void *arg, bool (*next)(void *arg, mdv_data *id, mdv_data *obj));
 
 
+/**
+ * @brief Removes objects batch.
+ * @details Identifiers of removed objects are stored in the removed objects set (tombstones).
+ *          Objects with such identifiers will never be added again. Tombstones are stored
+ *          even if the objects aren't received yet. Such tombstones are empty and they are never purged.
+ *
+ * @param objs [in]      DB objects storage
+ * @param tombstone [in] Tombstone value (e.g. deletion operation position) which is checked before tombstones purging
+ * @param arg [in]       Pointer which is provided as argument to batch items generator
+ * @param next [in]      batch items (objects identifiers) generator
+ *
+ * @return On success, return MDV_OK.
+ * @return On error, return non zero value
+ */
+mdv_errno mdv_2pset_remove_batch(mdv_2pset *objs, mdv_data const *tombstone, void *arg, bool (*next)(void *arg, mdv_data *id));
+
+
+/// Batch of DB objects modifications which are written within one transaction
+typedef struct mdv_2pset_batch mdv_2pset_batch;
+
+
+/**
+ * @brief Starts new batch of DB objects modifications.
+ * @details Batch holds the write transaction. Therefore only one batch can be opened at once.
+ *          Batch should be finished by mdv_2pset_batch_commit() or mdv_2pset_batch_abort().
+ *
+ * @param objs [in]     DB objects storage
+ *
+ * @return On success, returns nonzero pointer to new batch
+ * @return On error, returns NULL pointer
+ */
+mdv_2pset_batch * mdv_2pset_batch_begin(mdv_2pset *objs);
+
+
+/**
+ * @brief Stores objects within the batch transaction.
+ * @details On error the batch should be aborted.
+ *
+ * @param batch [in]    Objects batch
+ * @param arg [in]      Pointer which is provided as argument to batch items generator
+ * @param next [in]     batch items generator
+ *
+ * @return On success, return MDV_OK.
+ * @return On error, return non zero value
+ */
+mdv_errno mdv_2pset_batch_add(mdv_2pset_batch *batch, void *arg, bool (*next)(void *arg, mdv_data *id, mdv_data *obj));
+
+
+/**
+ * @brief Removes objects within the batch transaction.
+ * @details Tombstones are stored in the same way as mdv_2pset_remove_batch() does. On error the batch should be aborted.
+ *
+ * @param batch [in]     Objects batch
+ * @param tombstone [in] Tombstone value
+ * @param arg [in]       Pointer which is provided as argument to batch items generator
+ * @param next [in]      batch items (objects identifiers) generator
+ *
+ * @return On success, return MDV_OK.
+ * @return On error, return non zero value
+ */
+mdv_errno mdv_2pset_batch_remove(mdv_2pset_batch *batch, mdv_data const *tombstone, void *arg, bool (*next)(void *arg, mdv_data *id));
+
+
+/**
+ * @brief Reads the storage mark within the batch transaction.
+ * @details Marks are arbitrary key-value pairs stored atomically with objects (e.g. applied transaction logs positions).
+ *
+ * @param batch [in]     Objects batch
+ * @param key [in]       Mark key
+ * @param value [out]    Mark value. value->size is the expected value size.
+ *
+ * @return true if the mark is found
+ */
+bool mdv_2pset_batch_mark_get(mdv_2pset_batch *batch, mdv_data const *key, mdv_data *value);
+
+
+/**
+ * @brief Stores the storage mark within the batch transaction.
+ *
+ * @param batch [in]     Objects batch
+ * @param key [in]       Mark key
+ * @param value [in]     Mark value
+ *
+ * @return On success, return MDV_OK.
+ * @return On error, return non zero value
+ */
+mdv_errno mdv_2pset_batch_mark_set(mdv_2pset_batch *batch, mdv_data const *key, mdv_data const *value);
+
+
+/**
+ * @brief Commits all batch modifications and frees the batch.
+ *
+ * @param batch [in]     Objects batch
+ *
+ * @return On success, return MDV_OK.
+ * @return On error, return non zero value
+ */
+mdv_errno mdv_2pset_batch_commit(mdv_2pset_batch *batch);
+
+
+/**
+ * @brief Discards all batch modifications and frees the batch.
+ *
+ * @param batch [in]     Objects batch
+ */
+void mdv_2pset_batch_abort(mdv_2pset_batch *batch);
+
+
+/**
+ * @brief Imports objects, tombstones and marks from other storage.
+ * @details Objects identifiers and tombstones are translated. Secondary indexes are rebuilt.
+ *          All modifications are written within one transaction.
+ *
+ * @param objs [in]         DB objects storage
+ * @param src [in]          Source DB objects storage
+ * @param translator [in]   Identifiers and tombstones translator
+ *
+ * @return On success, return MDV_OK.
+ * @return On error, return non zero value
+ */
+mdv_errno mdv_2pset_import(mdv_2pset *objs, mdv_2pset *src, mdv_2pset_translator const *translator);
+
+
+/**
+ * @brief Purges tombstones of removed objects.
+ * @details Purged identifiers aren't protected from insertion anymore. Therefore tombstones
+ *          must be purged only when the objects can't be received again.
+ *
+ * @param objs [in]      DB objects storage
+ * @param limit [in]     Maximum number of tombstones purged in one transaction
+ * @param arg [in]       Pointer which is provided as argument to purgeable()
+ * @param purgeable [in] Function returns true if the tombstone can be purged
+ * @param purged [out]   Number of purged tombstones
+ *
+ * @return On success, return MDV_OK.
+ * @return On error, return non zero value
+ */
+mdv_errno mdv_2pset_purge(mdv_2pset *objs, size_t limit, void *arg, bool (*purgeable)(void *arg, mdv_data const *tombstone), size_t *purged);
+
+
+/**
+ * @brief Requests the storage file compaction.
+ * @details Storage file is compacted when the storage is closed.
+ *
+ * @param objs [in]      DB objects storage
+ */
+void mdv_2pset_compact(mdv_2pset *objs);
+
+
+/**
+ * @brief Writes the consistent storage copy to the file.
+ *
+ * @param objs [in]      DB objects storage
+ * @param fd [in]        file descriptor opened for writing
+ *
+ * @return On success, returns MDV_OK
+ * @return On error, returns non zero value
+ */
+mdv_errno mdv_2pset_copy(mdv_2pset *objs, mdv_descriptor fd);
+
+
+/**
+ * @brief Checks that the storage contains no objects.
+ *
+ * @param objs [in]      DB objects storage
+ *
+ * @return true if there are no objects in storage
+ */
+bool mdv_2pset_empty(mdv_2pset *objs);
+
+
 /**
  * @brief Reads and returns the stored object
  *
@@ -120,3 +365,17 @@ mdv_enumerator * mdv_2pset_enumerator(mdv_2pset *objs);
  * @return objects iterator
  */
 mdv_enumerator * mdv_2pset_enumerator_from(mdv_2pset *objs, mdv_data const *id);
+
+
+/**
+ * @brief Creates objects iterator over secondary index
+ * @details Enumerator entries are the mdv_kvdata where key is the index entry key
+ *          (object key followed by object identifier) and value is the object.
+ *
+ * @param objs [in]     DB objects storage
+ * @param index [in]    Secondary index number
+ * @param key [in]      Index entry key for iteration start (if NULL, iteration is started from first entry)
+ *
+ * @return objects iterator
+ */
+mdv_enumerator * mdv_2pset_index_enumerator(mdv_2pset *objs, uint32_t index, mdv_data const *key);
@@ -0,0 +1,172 @@
+#include "mdv_index.h"
+#include <string.h>
+
+
+/// Key prefix. Empty keys aren't allowed by LMDB.
+static const uint8_t MDV_INDEX_KEY_PREFIX = 1;
+
+
+static void mdv_index_key_be(uint64_t value, size_t size, uint8_t *key)
+{
+    for(size_t i = 0; i < size; ++i)
+        key[i] = (uint8_t)(value >> (8 * (size - i - 1)));
+}
+
+
+static uint64_t mdv_index_key_item(mdv_field_type type, uint8_t const *item)
+{
+    switch(type)
+    {
+        case MDV_FLD_TYPE_BOOL:
+            return *item != 0;
+
+        case MDV_FLD_TYPE_CHAR:
+        case MDV_FLD_TYPE_BYTE:
+        case MDV_FLD_TYPE_UINT8:
+            return *item;
+
+        case MDV_FLD_TYPE_INT8:
+            return *item ^ 0x80u;
+
+        case MDV_FLD_TYPE_UINT16:
+        {
+            uint16_t v; memcpy(&v, item, sizeof v);
+            return v;
+        }
+
+        case MDV_FLD_TYPE_INT16:
+        {
+            uint16_t v; memcpy(&v, item, sizeof v);
+            return v ^ 0x8000u;
+        }
+
+        case MDV_FLD_TYPE_UINT32:
+        {
+            uint32_t v; memcpy(&v, item, sizeof v);
+            return v;
+        }
+
+        case MDV_FLD_TYPE_INT32:
+        {
+            uint32_t v; memcpy(&v, item, sizeof v);
+            return v ^ 0x80000000u;
+        }
+
+        case MDV_FLD_TYPE_UINT64:
+        {
+            uint64_t v; memcpy(&v, item, sizeof v);
+            return v;
+        }
+
+        case MDV_FLD_TYPE_INT64:
+        {
+            uint64_t v; memcpy(&v, item, sizeof v);
+            return v ^ 0x8000000000000000ull;
+        }
+
+        case MDV_FLD_TYPE_FLOAT:
+        {
+            float f; memcpy(&f, item, sizeof f);
+            if (f == 0)
+                f = 0;          // -0.0 == 0.0
+            uint32_t v; memcpy(&v, &f, sizeof v);
+            return v & 0x80000000u ? ~v : v ^ 0x80000000u;
+        }
+
+        case MDV_FLD_TYPE_DOUBLE:
+        {
+            double d; memcpy(&d, item, sizeof d);
+            if (d == 0)
+                d = 0;          // -0.0 == 0.0
+            uint64_t v; memcpy(&v, &d, sizeof v);
+            return v & 0x8000000000000000ull ? ~v : v ^ 0x8000000000000000ull;
+        }
+    }
+
+    return 0;
+}
+
+
+enum
+{
+    /// Maximum size of encoded value. Each byte is escaped by two bytes at most.
+    MDV_INDEX_VALUE_MAX = (MDV_INDEX_KEY_MAX - 3) / 2
+};
+
+
+/// Key terminators. Terminators are less than escaped zero, so keys are prefix-free.
+static const uint8_t MDV_INDEX_KEY_END = 1;             ///< Complete value
+static const uint8_t MDV_INDEX_KEY_TRUNCATED = 2;       ///< Truncated value is greater than complete values with the same prefix
+
+
+static size_t mdv_index_key_escape(uint8_t const *value, size_t size, uint8_t *key)
+{
+    size_t key_size = 0;
+
+    for(size_t i = 0; i < size; ++i)
+    {
+        key[key_size++] = value[i];
+
+        if (!value[i])
+            key[key_size++] = 0xFF;
+    }
+
+    return key_size;
+}
+
+
+size_t mdv_index_key(mdv_field_type type, void const *data, size_t size, uint8_t *key)
+{
+    size_t const item_size = mdv_field_type_size(type);
+
+    uint8_t const *items = data;
+
+    size_t const max_size = MDV_INDEX_VALUE_MAX / item_size * item_size;
+
+    bool const truncated = size > max_size;
+
+    if (truncated)
+        size = max_size;
+
+    uint8_t value[MDV_INDEX_VALUE_MAX];
+    size_t value_size = 0;
+
+    if (item_size == 1 && type != MDV_FLD_TYPE_BOOL && type != MDV_FLD_TYPE_INT8)
+    {
+        // Strings and byte arrays
+        memcpy(value, items, size);
+        value_size = size;
+    }
+    else
+    {
+        for(size_t i = 0; i + item_size <= size; i += item_size)
+        {
+            mdv_index_key_be(mdv_index_key_item(type, items + i), item_size, value + value_size);
+            value_size += item_size;
+        }
+    }
+
+    key[0] = MDV_INDEX_KEY_PREFIX;
+
+    size_t key_size = sizeof MDV_INDEX_KEY_PREFIX;
+
+    key_size += mdv_index_key_escape(value, value_size, key + key_size);
+
+    key[key_size++] = 0;
+    key[key_size++] = truncated ? MDV_INDEX_KEY_TRUNCATED : MDV_INDEX_KEY_END;
+
+    return key_size;
+}
+
+
+int mdv_index_key_cmp(uint8_t const *a, size_t a_size, uint8_t const *b, size_t b_size)
+{
+    int const res = memcmp(a, b, a_size < b_size ? a_size : b_size);
+
+    if (res)
+        return res;
+
+    return a_size < b_size ? -1
+            : a_size > b_size ? 1
+            : 0;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file mdv_index.h
+ * @author Vladislav Volkov (wwwvladislav@gmail.com)
+ * @brief Secondary index keys
+ * @details Secondary index keys are binary comparable. It means the memcmp() ordering of keys
+ *          matches the ordering of field values. Therefore the LMDB default keys comparison
+ *          can be used for range scans. Keys are prefix-free, so the ordering is kept
+ *          when the row identifier is appended to the key.
+ * @version 0.1
+ * @date 2021-03-20
+ * @copyright Copyright (c) 2021, Vladislav Volkov
+ */
+#pragma once
+#include <mdv_def.h>
+#include <mdv_field.h>
+
+
+enum
+{
+    MDV_INDEX_KEY_MAX = 256     ///< Maximum size of secondary index key
+};
+
+
+/**
+ * @brief Encodes field value as secondary index key
+ * @details Integers are encoded in big endian byte order with inverted sign bit.
+ *          Floating point values are encoded as integers which have the same ordering.
+ *          Strings and byte arrays are copied as is. Arrays are encoded item by item.
+ *          Zero bytes of encoded value are escaped as 0x00 0xFF and the value is terminated by 0x00 0x01.
+ *          Too long values are truncated and terminated by 0x00 0x02. Keys truncation keeps the keys ordering,
+ *          but different values can produce equal keys.
+ *
+ * @param type [in]     Field type
+ * @param data [in]     Field items (native representation)
+ * @param size [in]     Field items size in bytes
+ * @param key [out]     Buffer for key (MDV_INDEX_KEY_MAX bytes)
+ *
+ * @return key size
+ */
+size_t mdv_index_key(mdv_field_type type, void const *data, size_t size, uint8_t *key);
+
+
+/**
+ * @brief Compares two secondary index keys
+ *
+ * @return negative value if a < b
+ * @return 0 if a == b
+ * @return positive value if a > b
+ */
+int mdv_index_key_cmp(uint8_t const *a, size_t a_size, uint8_t const *b, size_t b_size);
@@ -5,6 +5,7 @@
 #include <mdv_filesystem.h>
 #include <stdatomic.h>
 #include <string.h>
+#include <stdio.h>
 #include <assert.h>
 
 #ifndef _LMDB_H_
@@ -20,6 +21,7 @@
 struct mdv_lmdb
 {
     atomic_uint_fast32_t    ref_counter;
+    atomic_bool             compact;
     MDB_env                *env;
 };
 
@@ -106,12 +108,61 @@ mdv_lmdb * mdv_storage_open(char const *path, char const *name, uint32_t dbs_num
     }
 
     atomic_init(&pstorage->ref_counter, 1);
+    atomic_init(&pstorage->compact, false);
     pstorage->env = env;
 
     return pstorage;
 }
 
 
+static void mdv_storage_shrink(MDB_env *env)
+{
+    char const *path = 0;
+
+    mdv_stack(char, 1024) mpool;
+    mdv_stack_clear(mpool);
+
+    mdv_string db_path = mdv_str_null;
+    mdv_string tmp_path = mdv_str_null;
+
+    if (mdb_env_get_path(env, &path) == MDB_SUCCESS)
+    {
+        mdv_string const suffix = mdv_str_static(".compact");
+
+        db_path = mdv_str_pdup(mpool, path);
+        tmp_path = mdv_str_pdup(mpool, path);
+        tmp_path = mdv_str_pcat(mpool, tmp_path, suffix);
+    }
+
+    if (mdv_str_empty(db_path) || mdv_str_empty(tmp_path))
+    {
+        MDV_LOGE("Storage compaction failed. Storage path is too long.");
+        mdb_env_close(env);
+        return;
+    }
+
+    int rc = mdb_env_copy2(env, tmp_path.ptr, MDB_CP_COMPACT);
+
+    mdb_env_close(env);
+
+    if (rc != MDB_SUCCESS)
+    {
+        MDV_LOGE("Storage compaction failed: '%s' (%d)", mdb_strerror(rc), rc);
+        remove(tmp_path.ptr);
+        return;
+    }
+
+    if (rename(tmp_path.ptr, db_path.ptr) != 0)
+    {
+        MDV_LOGE("Compacted storage '%s' wasn't renamed", tmp_path.ptr);
+        remove(tmp_path.ptr);
+        return;
+    }
+
+    MDV_LOGI("Storage '%s' compacted", db_path.ptr);
+}
+
+
 mdv_lmdb * mdv_storage_retain(mdv_lmdb *pstorage)
 {
     if (pstorage)
@@ -130,7 +181,10 @@ uint32_t mdv_storage_release(mdv_lmdb *pstorage)
 
         if (!rc)
         {
-            mdb_env_close(pstorage->env);
+            if (atomic_load_explicit(&pstorage->compact, memory_order_relaxed))
+                mdv_storage_shrink(pstorage->env);
+            else
+                mdb_env_close(pstorage->env);
             mdv_free(pstorage);
         }
     }
@@ -139,11 +193,31 @@ uint32_t mdv_storage_release(mdv_lmdb *pstorage)
 }
 
 
-mdv_transaction mdv_transaction_start(mdv_lmdb *pstorage)
+void mdv_storage_compact(mdv_lmdb *pstorage)
+{
+    atomic_store_explicit(&pstorage->compact, true, memory_order_relaxed);
+}
+
+
+mdv_errno mdv_storage_copy(mdv_lmdb *pstorage, mdv_descriptor fd)
+{
+    int rc = mdb_env_copyfd2(pstorage->env, *(int*)&fd, MDB_CP_COMPACT);
+
+    if (rc != MDB_SUCCESS)
+    {
+        MDV_LOGE("Storage copying failed: '%s' (%d)", mdb_strerror(rc), rc);
+        return MDV_FAILED;
+    }
+
+    return MDV_OK;
+}
+
+
+static mdv_transaction mdv_transaction_begin(mdv_lmdb *pstorage, unsigned int flags)
 {
     MDB_txn *txn;
 
-    int rc = mdb_txn_begin(pstorage->env, 0, 0, &txn);
+    int rc = mdb_txn_begin(pstorage->env, 0, flags, &txn);
 
     if(rc != MDB_SUCCESS)
     {
@@ -155,6 +229,18 @@ mdv_transaction mdv_transaction_start(mdv_lmdb *pstorage)
 }
 
 
+mdv_transaction mdv_transaction_start(mdv_lmdb *pstorage)
+{
+    return mdv_transaction_begin(pstorage, 0);
+}
+
+
+mdv_transaction mdv_transaction_start_rdonly(mdv_lmdb *pstorage)
+{
+    return mdv_transaction_begin(pstorage, MDB_RDONLY);
+}
+
+
 bool mdv_transaction_commit(mdv_transaction *ptransaction)
 {
     MDB_txn *txn = (MDB_txn*)ptransaction->ptransaction;
@@ -304,6 +390,40 @@ bool mdv_map_put_unique(mdv_map *pmap, mdv_transaction *ptransaction, mdv_data c
 }
 
 
+/**
+ * @brief Reserves space for the value with unique key. Caller should fill the returned space before transaction commit.
+ */
+void * mdv_map_reserve(mdv_map *pmap, mdv_transaction *ptransaction, mdv_data const *key, size_t size)
+{
+    MDB_txn *txn = (MDB_txn*)ptransaction->ptransaction;
+    MDB_dbi dbi = (MDB_dbi)pmap->dbmap;
+
+    if (!txn)
+    {
+        MDV_LOGE("Invalid operation. The data should be inserted in transaction.");
+        return 0;
+    }
+
+    MDB_val k = { key->size, key->ptr };
+    MDB_val v = { size, 0 };
+
+    int rc = mdb_put(txn, dbi, &k, &v, MDB_NOOVERWRITE | MDB_RESERVE);
+
+    if(rc != MDB_SUCCESS)
+    {
+        char hexstr[MDV_HEXSTR_LEN];
+
+        MDV_LOGE("Unable to reserve space for data with key \'%s\' in the LMDB database: '%s' (%d)",
+                        mdv_array_to_hexstr(key->ptr, key->size, hexstr),
+                        mdb_strerror(rc),
+                        rc);
+        return 0;
+    }
+
+    return v.mv_data;
+}
+
+
 bool mdv_map_get(mdv_map *pmap, mdv_transaction *ptransaction, mdv_data const *key, mdv_data *value)
 {
     MDB_txn *txn = (MDB_txn*)ptransaction->ptransaction;
@@ -442,6 +562,22 @@ bool mdv_cursor_get(mdv_cursor *pcursor, mdv_data *key, mdv_data *value, mdv_cur
 }
 
 
+bool mdv_cursor_del(mdv_cursor *pcursor)
+{
+    MDB_cursor *cursor = (MDB_cursor *)pcursor->pcursor;
+
+    int rc = mdb_cursor_del(cursor, 0);
+
+    if (rc != MDB_SUCCESS)
+    {
+        MDV_LOGE("Unable to delete data by cursor: '%s' (%d)", mdb_strerror(rc), rc);
+        return false;
+    }
+
+    return true;
+}
+
+
 void mdv_map_read(mdv_map *pmap, mdv_transaction *ptransaction, void *map_fields)
 {
     for(mdv_map_field_desc *field = (mdv_map_field_desc *)map_fields;
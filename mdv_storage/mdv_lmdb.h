@@ -66,6 +66,31 @@ mdv_lmdb * mdv_storage_retain(mdv_lmdb *pstorage);
 uint32_t mdv_storage_release(mdv_lmdb *pstorage);
 
 
+/**
+ * @brief Requests the storage file compaction.
+ * @details LMDB never returns free pages to the file system. The compacted copy of the storage
+ *          (without free pages) is written when the last reference to the storage is released.
+ *          After that the compacted copy replaces the storage file.
+ *
+ * @param pstorage [in] storage
+ */
+void mdv_storage_compact(mdv_lmdb *pstorage);
+
+
+/**
+ * @brief Writes the consistent storage copy to the file.
+ * @details Copy is made within the read-only transaction, so writers are not blocked.
+ *          Free pages are omitted in the copy.
+ *
+ * @param pstorage [in] storage
+ * @param fd [in]       file descriptor opened for writing
+ *
+ * @return On success, returns MDV_OK
+ * @return On error, returns non zero value
+ */
+mdv_errno mdv_storage_copy(mdv_lmdb *pstorage, mdv_descriptor fd);
+
+
 /// Transaction descriptor
 typedef struct
 {
@@ -84,6 +109,19 @@ typedef struct
 mdv_transaction mdv_transaction_start(mdv_lmdb *pstorage);
 
 
+/**
+ * @brief Start new read-only transaction
+ * @details Read-only transaction holds the storage snapshot which doesn't see any later modifications.
+ *          Several read-only transactions might be active concurrently with one write transaction.
+ *          Read-only transaction can be passed between threads if storage is opened with MDV_STRG_NOTLS flag.
+ *
+ * @param pstorage [in] storage opened with mdv_storage_open()
+ *
+ * @return On success return valid filled transaction descriptor. Validity can be checked with mdv_transaction_ok() macro.
+ */
+mdv_transaction mdv_transaction_start_rdonly(mdv_lmdb *pstorage);
+
+
 /**
  * @brief Commit transaction. After the successfully commit all data modifications are stored in DB.
  *
@@ -138,6 +176,7 @@ mdv_map mdv_map_open       (mdv_transaction *ptransaction, char const *name, uin
 void    mdv_map_close      (mdv_map *pmap);
 bool    mdv_map_put        (mdv_map *pmap, mdv_transaction *ptransaction, mdv_data const *key, mdv_data const *value);
 bool    mdv_map_put_unique (mdv_map *pmap, mdv_transaction *ptransaction, mdv_data const *key, mdv_data const *value);
+void *  mdv_map_reserve    (mdv_map *pmap, mdv_transaction *ptransaction, mdv_data const *key, size_t size);
 bool    mdv_map_get        (mdv_map *pmap, mdv_transaction *ptransaction, mdv_data const *key, mdv_data *value);
 bool    mdv_map_del        (mdv_map *pmap, mdv_transaction *ptransaction, mdv_data const *key, mdv_data const *value);
 #define mdv_map_ok(m)      ((m).pstorage != 0 && (m).dbmap != 0)
@@ -183,6 +222,7 @@ mdv_cursor  mdv_cursor_open_explicit    (mdv_map *pmap, mdv_transaction *ptransa
 mdv_cursor  mdv_cursor_open_first       (mdv_map *pmap, mdv_transaction *ptransaction, mdv_data *key, mdv_data *value);
 bool        mdv_cursor_close            (mdv_cursor *pcursor);
 bool        mdv_cursor_get              (mdv_cursor *pcursor, mdv_data *key, mdv_data *value, mdv_cursor_op op);
+bool        mdv_cursor_del              (mdv_cursor *pcursor);
 
 
 /**
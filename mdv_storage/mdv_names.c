@@ -8,3 +8,10 @@ char const * MDV_STRG_UUID(mdv_uuid const *uuid, char *name, size_t size)
     snprintf(name, size, "%s.mdb", mdv_uuid_to_str(uuid, uuid_str));
     return name;
 }
+
+
+char const * MDV_MAP_INDEX(uint32_t index, char *name, size_t size)
+{
+    snprintf(name, size, "INDEX%u", index);
+    return name;
+}
@@ -11,13 +11,16 @@
 
 
 #define MDV_STRG_TABLES                 "tables.mdb"
-#define MDV_STRG_OBJECTS_MAPS           3
+#define MDV_STRG_OBJECTS_MAPS           4
 #define MDV_MAP_OBJECTS                 "OBJECTS"           /// DB objects: tables, views, etc
 #define MDV_MAP_REMOVED                 "REMOVED"           /// Removed objects identifiers
 #define MDV_MAP_IDGEN                   "IDGEN"             /// Identifiers generator for objects
+#define MDV_MAP_MARKS                   "MARKS"             /// Objects storage marks (e.g. applied transaction logs positions)
+char const *MDV_MAP_INDEX(uint32_t index, char *name, size_t size); /// Secondary index
 
 
 char const *MDV_STRG_UUID(mdv_uuid const *uuid, char *name, size_t size);
-#define MDV_STRG_TRLOG_MAPS             2
+#define MDV_STRG_TRLOG_MAPS             3
 #define MDV_MAP_TRLOG                   "TRLOG"             /// Transaction log
 #define MDV_MAP_APPLIED                 "APPLIED"           /// Transaction logs applied position
+#define MDV_MAP_SYNCED                  "SYNCED"            /// Transaction log positions received by peers
@@ -2,18 +2,45 @@
 #include <mdv_log.h>
 #include <mdv_alloc.h>
 #include <mdv_rollbacker.h>
+#include <mdv_serialization.h>
 #include <stdatomic.h>
+#include <string.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <ctype.h>
+#include <errno.h>
 
 
 struct mdv_predicate
 {
     atomic_uint_fast32_t    rc;             ///< References counter
     mdv_vector             *expr;           ///< Compiled VM expression
+    mdv_vector             *args;           ///< Expression arguments (vector<mdv_predicate_arg>)
+    mdv_vector             *conds;          ///< Top level conjunctive conditions (vector<mdv_predicate_cond>)
     mdv_vm_fn const        *fns;            ///< Custom function handlers
     size_t                  fns_count;      ///< Custom function handlers count
 };
 
 
+/// Expression argument (table field)
+typedef struct
+{
+    bool                    used;           ///< Field is referenced in expression
+    mdv_field_type          type;           ///< Field type
+    uint32_t                limit;          ///< Field items limit
+} mdv_predicate_arg;
+
+
+/// Comparison of field with literal which should be satisfied by all matched rows
+typedef struct
+{
+    uint32_t                field;          ///< Field index
+    mdv_vm_cmp_op           op;             ///< Comparison operation (field is left operand)
+    uint32_t                size;           ///< Literal size
+    size_t                  offset;         ///< Literal offset in compiled expression
+} mdv_predicate_cond;
+
+
 static const uint8_t MDV_EMPTY_PREDICATE[] =
 {
     MDV_VM_PUSH, 0, 1, 0, 0, 0, MDV_VM_TRUE,
@@ -23,21 +50,957 @@ static const uint8_t MDV_EMPTY_PREDICATE[] =
 
 static mdv_vm_fn const MDV_PREDICATE_FNS[] =
 {
-    mdv_vmop_equal,
-    mdv_vmop_not_equal,
-    mdv_vmop_greater,
-    mdv_vmop_greater_or_equal,
-    mdv_vmop_less,
-    mdv_vmop_less_or_equal,
     mdv_vmop_and,
     mdv_vmop_or,
     mdv_vmop_not
 };
 
 
-mdv_predicate * mdv_predicate_parse(char const *expression)
+/// Function identifiers (indices in MDV_PREDICATE_FNS)
+enum
+{
+    MDV_PREDICATE_FN_AND = 0,
+    MDV_PREDICATE_FN_OR,
+    MDV_PREDICATE_FN_NOT
+};
+
+
+/// Expression tokens
+typedef enum
+{
+    MDV_TOK_END = 0,    ///< End of expression
+    MDV_TOK_ERROR,      ///< Invalid token
+    MDV_TOK_IDENT,      ///< Field name
+    MDV_TOK_QIDENT,     ///< Quoted field name
+    MDV_TOK_INT,        ///< Integer literal
+    MDV_TOK_REAL,       ///< Real literal
+    MDV_TOK_STRING,     ///< String literal
+    MDV_TOK_TRUE,       ///< TRUE
+    MDV_TOK_FALSE,      ///< FALSE
+    MDV_TOK_AND,        ///< AND
+    MDV_TOK_OR,         ///< OR
+    MDV_TOK_NOT,        ///< NOT
+    MDV_TOK_LB,         ///< (
+    MDV_TOK_RB,         ///< )
+    MDV_TOK_EQ,         ///< = or ==
+    MDV_TOK_NE,         ///< != or <>
+    MDV_TOK_LT,         ///< <
+    MDV_TOK_LE,         ///< <=
+    MDV_TOK_GT,         ///< >
+    MDV_TOK_GE,         ///< >=
+} mdv_predicate_token;
+
+
+/// Operand kind
+typedef enum
+{
+    MDV_OPND_FIELD,     ///< Field reference
+    MDV_OPND_INT,       ///< Integer literal
+    MDV_OPND_REAL,      ///< Real literal
+    MDV_OPND_STRING,    ///< String literal
+    MDV_OPND_BOOL,      ///< Boolean literal
+} mdv_predicate_operand_kind;
+
+
+/// Comparison operand
+typedef struct
+{
+    mdv_predicate_operand_kind  kind;       ///< Operand kind
+    char const                 *pos;        ///< Operand position in expression
+    union
+    {
+        uint32_t                field;      ///< Field index
+        struct
+        {
+            bool                neg;        ///< Integer is negative
+            uint64_t            abs;        ///< Absolute value of integer
+        }                       integer;    ///< Integer literal
+        double                  real;       ///< Real literal
+        bool                    boolean;    ///< Boolean literal
+        struct
+        {
+            char const         *ptr;        ///< Quoted string (including quotes)
+            size_t              len;        ///< Quoted string length
+        }                       string;     ///< String literal
+    };
+} mdv_predicate_operand;
+
+
+/// Expression parser
+typedef struct
+{
+    mdv_table_desc const   *desc;           ///< Table description
+    char const             *expression;     ///< Expression
+    char const             *pos;            ///< Current position
+    mdv_predicate_token     tok;            ///< Current token
+    char const             *tok_ptr;        ///< Current token begin
+    size_t                  tok_len;        ///< Current token length
+    mdv_vector             *code;           ///< Compiled program
+    mdv_vector             *args;           ///< Referenced fields (vector<mdv_predicate_arg>)
+    mdv_vector             *conds;          ///< Top level conjunctive conditions (vector<mdv_predicate_cond>)
+    uint32_t                depth;          ///< Nesting depth of NOT and parentheses
+    bool                    disjunction;    ///< Top level OR was found
+    size_t                  literal;        ///< Last pushed literal offset in compiled program
+    bool                    failed;         ///< Error flag
+} mdv_predicate_parser;
+
+
+static void mdv_predicate_error(mdv_predicate_parser *parser, char const *pos, char const *msg)
+{
+    if (!parser->failed)
+    {
+        MDV_LOGE("Expression '%s' parsing failed at position %zu: %s",
+                    parser->expression,
+                    (size_t)(pos - parser->expression),
+                    msg);
+        parser->failed = true;
+    }
+}
+
+
+static char const * mdv_predicate_skip_quoted(char const *str, char quote)
+{
+    for(++str; *str; ++str)
+    {
+        if (*str == quote)
+        {
+            if (str[1] != quote)
+                return str + 1;
+            ++str;
+        }
+    }
+    return 0;
+}
+
+
+static size_t mdv_predicate_unquote(char const *str, size_t len, char *buf)
+{
+    char const quote = *str;
+    size_t n = 0;
+
+    for(size_t i = 1; i + 1 < len; ++i)
+    {
+        buf[n++] = str[i];
+        if (str[i] == quote)
+            ++i;
+    }
+
+    return n;
+}
+
+
+static bool mdv_predicate_keyword(mdv_predicate_parser const *parser, char const *keyword)
+{
+    size_t const len = strlen(keyword);
+    return parser->tok_len == len
+            && strncasecmp(parser->tok_ptr, keyword, len) == 0;
+}
+
+
+static void mdv_predicate_next(mdv_predicate_parser *parser)
+{
+    char const *p = parser->pos;
+
+    while(isspace((unsigned char)*p))
+        ++p;
+
+    parser->tok_ptr = p;
+    parser->tok_len = 0;
+
+    if (!*p)
+    {
+        parser->tok = MDV_TOK_END;
+        parser->pos = p;
+        return;
+    }
+
+    mdv_predicate_token tok = MDV_TOK_ERROR;
+    char const *end = p + 1;
+
+    switch(*p)
+    {
+        case '(':   tok = MDV_TOK_LB;   break;
+        case ')':   tok = MDV_TOK_RB;   break;
+
+        case '=':
+        {
+            tok = MDV_TOK_EQ;
+            if (p[1] == '=')
+                ++end;
+            break;
+        }
+
+        case '!':
+        {
+            if (p[1] == '=')
+            {
+                tok = MDV_TOK_NE;
+                ++end;
+            }
+            break;
+        }
+
+        case '<':
+        {
+            tok = MDV_TOK_LT;
+            if (p[1] == '=')
+            {
+                tok = MDV_TOK_LE;
+                ++end;
+            }
+            else if (p[1] == '>')
+            {
+                tok = MDV_TOK_NE;
+                ++end;
+            }
+            break;
+        }
+
+        case '>':
+        {
+            tok = MDV_TOK_GT;
+            if (p[1] == '=')
+            {
+                tok = MDV_TOK_GE;
+                ++end;
+            }
+            break;
+        }
+
+        case '\'':
+        case '"':
+        {
+            end = mdv_predicate_skip_quoted(p, *p);
+            if (end)
+                tok = *p == '\'' ? MDV_TOK_STRING : MDV_TOK_QIDENT;
+            else
+                end = p + strlen(p);
+            break;
+        }
+
+        default:
+        {
+            if (isdigit((unsigned char)*p)
+                || ((*p == '-' || *p == '+') && isdigit((unsigned char)p[1])))
+            {
+                end = p + 1;
+
+                while(isdigit((unsigned char)*end))
+                    ++end;
+
+                tok = MDV_TOK_INT;
+
+                if (*end == '.' && isdigit((unsigned char)end[1]))
+                {
+                    tok = MDV_TOK_REAL;
+                    for(++end; isdigit((unsigned char)*end); ++end);
+                }
+
+                if ((*end == 'e' || *end == 'E')
+                    && (isdigit((unsigned char)end[1])
+                        || ((end[1] == '-' || end[1] == '+') && isdigit((unsigned char)end[2]))))
+                {
+                    tok = MDV_TOK_REAL;
+                    for(end += 2; isdigit((unsigned char)*end); ++end);
+                }
+            }
+            else if (isalpha((unsigned char)*p) || *p == '_')
+            {
+                while(isalnum((unsigned char)*end) || *end == '_')
+                    ++end;
+
+                tok = MDV_TOK_IDENT;
+
+                parser->tok_len = end - p;
+
+                if (mdv_predicate_keyword(parser, "AND"))          tok = MDV_TOK_AND;
+                else if (mdv_predicate_keyword(parser, "OR"))      tok = MDV_TOK_OR;
+                else if (mdv_predicate_keyword(parser, "NOT"))     tok = MDV_TOK_NOT;
+                else if (mdv_predicate_keyword(parser, "TRUE"))    tok = MDV_TOK_TRUE;
+                else if (mdv_predicate_keyword(parser, "FALSE"))   tok = MDV_TOK_FALSE;
+            }
+            break;
+        }
+    }
+
+    parser->tok = tok;
+    parser->tok_len = end - p;
+    parser->pos = end;
+}
+
+
+static void mdv_predicate_emit(mdv_predicate_parser *parser, void const *code, size_t size)
+{
+    if (!parser->failed
+        && !mdv_vector_append(parser->code, code, size))
+    {
+        MDV_LOGE("No memory for compiled expression");
+        parser->failed = true;
+    }
+}
+
+
+static void mdv_predicate_emit_push(mdv_predicate_parser *parser, void const *data, uint32_t size)
+{
+    uint8_t const hdr[] = { MDV_VM_PUSH, 0 };
+    parser->literal = mdv_vector_size(parser->code) + sizeof hdr + sizeof size;
+    mdv_predicate_emit(parser, hdr, sizeof hdr);
+    mdv_predicate_emit(parser, &size, sizeof size);
+    mdv_predicate_emit(parser, data, size);
+}
+
+
+static void mdv_predicate_emit_call(mdv_predicate_parser *parser, uint16_t fn)
+{
+    uint8_t const op = MDV_VM_CALL;
+    mdv_predicate_emit(parser, &op, sizeof op);
+    mdv_predicate_emit(parser, &fn, sizeof fn);
+}
+
+
+static void mdv_predicate_emit_arg(mdv_predicate_parser *parser, uint16_t arg)
+{
+    uint8_t const op = MDV_VM_ARG;
+    mdv_predicate_emit(parser, &op, sizeof op);
+    mdv_predicate_emit(parser, &arg, sizeof arg);
+}
+
+
+static mdv_vm_type mdv_predicate_vm_type(mdv_field_type type)
+{
+    switch(type)
+    {
+        case MDV_FLD_TYPE_BOOL:     return MDV_VM_TYPE_BOOL;
+        case MDV_FLD_TYPE_CHAR:     return MDV_VM_TYPE_BYTES;
+        case MDV_FLD_TYPE_BYTE:     return MDV_VM_TYPE_BYTES;
+        case MDV_FLD_TYPE_INT8:     return MDV_VM_TYPE_INT8;
+        case MDV_FLD_TYPE_UINT8:    return MDV_VM_TYPE_UINT8;
+        case MDV_FLD_TYPE_INT16:    return MDV_VM_TYPE_INT16;
+        case MDV_FLD_TYPE_UINT16:   return MDV_VM_TYPE_UINT16;
+        case MDV_FLD_TYPE_INT32:    return MDV_VM_TYPE_INT32;
+        case MDV_FLD_TYPE_UINT32:   return MDV_VM_TYPE_UINT32;
+        case MDV_FLD_TYPE_INT64:    return MDV_VM_TYPE_INT64;
+        case MDV_FLD_TYPE_UINT64:   return MDV_VM_TYPE_UINT64;
+        case MDV_FLD_TYPE_FLOAT:    return MDV_VM_TYPE_FLOAT;
+        case MDV_FLD_TYPE_DOUBLE:   return MDV_VM_TYPE_DOUBLE;
+    }
+    return MDV_VM_TYPE_BYTES;
+}
+
+
+static void mdv_predicate_emit_cmp(mdv_predicate_parser *parser, mdv_field_type type, mdv_vm_cmp_op op)
+{
+    uint8_t const code[] = { MDV_VM_CMP, mdv_predicate_vm_type(type), op };
+    mdv_predicate_emit(parser, code, sizeof code);
+}
+
+
+static void mdv_predicate_emit_bool(mdv_predicate_parser *parser, bool value)
+{
+    uint8_t const res = value ? MDV_VM_TRUE : MDV_VM_FALSE;
+    mdv_predicate_emit_push(parser, &res, sizeof res);
+}
+
+
+static bool mdv_predicate_field_find(mdv_predicate_parser *parser, mdv_predicate_operand *opnd)
+{
+    char name[parser->tok_len + 1];
+    size_t len = parser->tok_len;
+
+    if (parser->tok == MDV_TOK_QIDENT)
+        len = mdv_predicate_unquote(parser->tok_ptr, parser->tok_len, name);
+    else
+        memcpy(name, parser->tok_ptr, len);
+
+    name[len] = 0;
+
+    if (parser->desc)
+    {
+        for(uint32_t i = 0; i < parser->desc->size; ++i)
+        {
+            if (strcmp(parser->desc->fields[i].name, name) == 0)
+            {
+                if (i > UINT16_MAX)
+                    break;
+
+                if (mdv_vector_size(parser->args) <= i
+                    && !mdv_vector_resize(parser->args, i + 1))
+                {
+                    MDV_LOGE("No memory for expression arguments");
+                    parser->failed = true;
+                    return false;
+                }
+
+                mdv_predicate_arg *arg = mdv_vector_at(parser->args, i);
+
+                arg->used = true;
+                arg->type = parser->desc->fields[i].type;
+                arg->limit = parser->desc->fields[i].limit;
+
+                opnd->kind = MDV_OPND_FIELD;
+                opnd->field = i;
+                return true;
+            }
+        }
+    }
+
+    mdv_predicate_error(parser, parser->tok_ptr, "unknown field");
+
+    return false;
+}
+
+
+static bool mdv_predicate_operand_parse(mdv_predicate_parser *parser, mdv_predicate_operand *opnd)
+{
+    opnd->pos = parser->tok_ptr;
+
+    switch(parser->tok)
+    {
+        case MDV_TOK_IDENT:
+        case MDV_TOK_QIDENT:
+        {
+            if (!mdv_predicate_field_find(parser, opnd))
+                return false;
+            break;
+        }
+
+        case MDV_TOK_INT:
+        {
+            char const *digits = parser->tok_ptr;
+
+            opnd->kind = MDV_OPND_INT;
+            opnd->integer.neg = *digits == '-';
+
+            if (*digits == '-' || *digits == '+')
+                ++digits;
+
+            errno = 0;
+            opnd->integer.abs = strtoull(digits, 0, 10);
+
+            if (errno == ERANGE)
+            {
+                mdv_predicate_error(parser, parser->tok_ptr, "integer is out of range");
+                return false;
+            }
+
+            if (!opnd->integer.abs)
+                opnd->integer.neg = false;
+
+            break;
+        }
+
+        case MDV_TOK_REAL:
+        {
+            opnd->kind = MDV_OPND_REAL;
+            opnd->real = strtod(parser->tok_ptr, 0);
+            break;
+        }
+
+        case MDV_TOK_STRING:
+        {
+            opnd->kind = MDV_OPND_STRING;
+            opnd->string.ptr = parser->tok_ptr;
+            opnd->string.len = parser->tok_len;
+            break;
+        }
+
+        case MDV_TOK_TRUE:
+        case MDV_TOK_FALSE:
+        {
+            opnd->kind = MDV_OPND_BOOL;
+            opnd->boolean = parser->tok == MDV_TOK_TRUE;
+            break;
+        }
+
+        case MDV_TOK_END:
+        {
+            mdv_predicate_error(parser, parser->tok_ptr, "unexpected end of expression");
+            return false;
+        }
+
+        default:
+        {
+            mdv_predicate_error(parser, parser->tok_ptr, "operand expected");
+            return false;
+        }
+    }
+
+    mdv_predicate_next(parser);
+
+    return true;
+}
+
+
+static bool mdv_predicate_int_fits(mdv_predicate_operand const *opnd, int64_t min, uint64_t max)
+{
+    return opnd->integer.neg
+            ? opnd->integer.abs <= (uint64_t)-(min + 1) + 1
+            : opnd->integer.abs <= max;
+}
+
+
+static int64_t mdv_predicate_int_value(mdv_predicate_operand const *opnd)
+{
+    return opnd->integer.neg
+            ? (int64_t)(0 - opnd->integer.abs)
+            : (int64_t)opnd->integer.abs;
+}
+
+
+/**
+ * @brief Emits literal converted to the given field type
+ */
+static bool mdv_predicate_emit_literal_as(mdv_predicate_parser *parser,
+                                          mdv_predicate_operand const *opnd,
+                                          mdv_field const *field)
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(2);
+    union
+    {
+        bool        b;
+        int8_t      i8;
+        uint8_t     u8;
+        int16_t     i16;
+        uint16_t    u16;
+        int32_t     i32;
+        uint32_t    u32;
+        int64_t     i64;
+        uint64_t    u64;
+        float       f;
+        double      d;
+    } value;
+
+    uint32_t const size = mdv_field_type_size(field->type);
+
+    #define MDV_INT_LITERAL(member, T, min, max)                                    \
+        if (opnd->kind != MDV_OPND_INT)                                             \
+            break;                                                                  \
+        if (!mdv_predicate_int_fits(opnd, min, max))                                \
+        {                                                                           \
+            mdv_predicate_error(parser, opnd->pos, "integer is out of field range");\
+            return false;                                                           \
+        }                                                                           \
+        value.member = (T)mdv_predicate_int_value(opnd);                            \
+        mdv_predicate_emit_push(parser, &value, size);                              \
+        return true;
+
+    switch(field->type)
+    {
+        case MDV_FLD_TYPE_BOOL:
+        {
+            if (opnd->kind != MDV_OPND_BOOL)
+                break;
+            value.b = opnd->boolean;
+            mdv_predicate_emit_push(parser, &value, size);
+            return true;
+        }
+
+        case MDV_FLD_TYPE_CHAR:
+        case MDV_FLD_TYPE_BYTE:
+        {
+            if (opnd->kind == MDV_OPND_STRING)
+            {
+                char str[opnd->string.len];
+                size_t const len = mdv_predicate_unquote(opnd->string.ptr, opnd->string.len, str);
+
+                if ((field->limit && len > field->limit)
+                    || (field->limit == 1 && len != 1))
+                {
+                    mdv_predicate_error(parser, opnd->pos, "string length doesn't match the field size");
+                    return false;
+                }
+
+                mdv_predicate_emit_push(parser, str, len);
+                return true;
+            }
+
+            if (field->type == MDV_FLD_TYPE_BYTE)
+            {
+                MDV_INT_LITERAL(u8, uint8_t, 0, UINT8_MAX);
+            }
+
+            break;
+        }
+
+        case MDV_FLD_TYPE_INT8:     { MDV_INT_LITERAL(i8,  int8_t,   INT8_MIN,  INT8_MAX);   }
+        case MDV_FLD_TYPE_UINT8:    { MDV_INT_LITERAL(u8,  uint8_t,  0,         UINT8_MAX);  }
+        case MDV_FLD_TYPE_INT16:    { MDV_INT_LITERAL(i16, int16_t,  INT16_MIN, INT16_MAX);  }
+        case MDV_FLD_TYPE_UINT16:   { MDV_INT_LITERAL(u16, uint16_t, 0,         UINT16_MAX); }
+        case MDV_FLD_TYPE_INT32:    { MDV_INT_LITERAL(i32, int32_t,  INT32_MIN, INT32_MAX);  }
+        case MDV_FLD_TYPE_UINT32:   { MDV_INT_LITERAL(u32, uint32_t, 0,         UINT32_MAX); }
+        case MDV_FLD_TYPE_INT64:    { MDV_INT_LITERAL(i64, int64_t,  INT64_MIN, INT64_MAX);  }
+        case MDV_FLD_TYPE_UINT64:   { MDV_INT_LITERAL(u64, uint64_t, 0,         UINT64_MAX); }
+
+        case MDV_FLD_TYPE_FLOAT:
+        case MDV_FLD_TYPE_DOUBLE:
+        {
+            double real = 0;
+
+            if (opnd->kind == MDV_OPND_REAL)
+                real = opnd->real;
+            else if (opnd->kind == MDV_OPND_INT)
+                real = opnd->integer.neg
+                        ? -(double)opnd->integer.abs
+                        : (double)opnd->integer.abs;
+            else
+                break;
+
+            if (field->type == MDV_FLD_TYPE_FLOAT)
+                value.f = (float)real;
+            else
+                value.d = real;
+
+            mdv_predicate_emit_push(parser, &value, size);
+            return true;
+        }
+    }
+
+    #undef MDV_INT_LITERAL
+
+    mdv_predicate_error(parser, opnd->pos, "literal type doesn't match the field type");
+
+    return false;
+}
+
+
+/**
+ * @brief Emits literal which is compared with other literal
+ */
+static bool mdv_predicate_emit_literal(mdv_predicate_parser *parser,
+                                       mdv_predicate_operand const *opnd,
+                                       mdv_predicate_operand_kind other,
+                                       mdv_field_type *type)
+{
+    mdv_field field = { .limit = 1 };
+
+    switch(opnd->kind)
+    {
+        case MDV_OPND_BOOL:
+            field.type = MDV_FLD_TYPE_BOOL;
+            break;
+
+        case MDV_OPND_STRING:
+            field.type = MDV_FLD_TYPE_CHAR;
+            field.limit = 0;
+            break;
+
+        case MDV_OPND_INT:
+            field.type = other == MDV_OPND_REAL
+                            ? MDV_FLD_TYPE_DOUBLE
+                            : MDV_FLD_TYPE_INT64;
+            break;
+
+        case MDV_OPND_REAL:
+            field.type = MDV_FLD_TYPE_DOUBLE;
+            break;
+
+        default:
+            return false;
+    }
+
+    *type = field.type;
+
+    return mdv_predicate_emit_literal_as(parser, opnd, &field);
+}
+
+
+/**
+ * @brief Emits comparison operands and returns the type used for comparison
+ */
+static bool mdv_predicate_emit_operands(mdv_predicate_parser *parser,
+                                        mdv_predicate_operand const *lhs,
+                                        mdv_predicate_operand const *rhs,
+                                        mdv_field_type *type)
+{
+    mdv_field const *fields = parser->desc ? parser->desc->fields : 0;
+
+    if (lhs->kind == MDV_OPND_FIELD && rhs->kind == MDV_OPND_FIELD)
+    {
+        if (fields[lhs->field].type != fields[rhs->field].type)
+        {
+            mdv_predicate_error(parser, rhs->pos, "fields types mismatch");
+            return false;
+        }
+
+        *type = fields[lhs->field].type;
+        mdv_predicate_emit_arg(parser, lhs->field);
+        mdv_predicate_emit_arg(parser, rhs->field);
+        return true;
+    }
+
+    if (lhs->kind == MDV_OPND_FIELD)
+    {
+        *type = fields[lhs->field].type;
+        mdv_predicate_emit_arg(parser, lhs->field);
+        return mdv_predicate_emit_literal_as(parser, rhs, fields + lhs->field);
+    }
+
+    if (rhs->kind == MDV_OPND_FIELD)
+    {
+        *type = fields[rhs->field].type;
+        if (!mdv_predicate_emit_literal_as(parser, lhs, fields + rhs->field))
+            return false;
+        mdv_predicate_emit_arg(parser, rhs->field);
+        return true;
+    }
+
+    bool const compatible = lhs->kind == rhs->kind
+                            || (lhs->kind == MDV_OPND_INT && rhs->kind == MDV_OPND_REAL)
+                            || (lhs->kind == MDV_OPND_REAL && rhs->kind == MDV_OPND_INT);
+
+    if (!compatible)
+    {
+        mdv_predicate_error(parser, rhs->pos, "literals types mismatch");
+        return false;
+    }
+
+    return mdv_predicate_emit_literal(parser, lhs, rhs->kind, type)
+            && mdv_predicate_emit_literal(parser, rhs, lhs->kind, type);
+}
+
+
+static bool mdv_predicate_expr_parse(mdv_predicate_parser *parser);
+
+
+/**
+ * @brief Saves the comparison of field with literal if it is the top level conjunctive condition
+ * @details Such conditions are used for rows ranges selection (e.g. by secondary indexes).
+ */
+static void mdv_predicate_cond_add(mdv_predicate_parser *parser,
+                                   mdv_predicate_operand const *lhs,
+                                   mdv_predicate_operand const *rhs,
+                                   mdv_vm_cmp_op op)
+{
+    if (parser->depth || parser->disjunction || parser->failed)
+        return;
+
+    static mdv_vm_cmp_op const flipped[] =
+    {
+        [MDV_VM_CMP_EQ] = MDV_VM_CMP_EQ,
+        [MDV_VM_CMP_NE] = MDV_VM_CMP_NE,
+        [MDV_VM_CMP_GT] = MDV_VM_CMP_LT,
+        [MDV_VM_CMP_GE] = MDV_VM_CMP_LE,
+        [MDV_VM_CMP_LT] = MDV_VM_CMP_GT,
+        [MDV_VM_CMP_LE] = MDV_VM_CMP_GE,
+    };
+
+    uint32_t size;
+    memcpy(&size, (uint8_t const *)mdv_vector_data(parser->code) + parser->literal - sizeof size, sizeof size);
+
+    mdv_predicate_cond const cond =
+    {
+        .field = lhs->kind == MDV_OPND_FIELD ? lhs->field : rhs->field,
+        .op = lhs->kind == MDV_OPND_FIELD ? op : flipped[op],
+        .size = size,
+        .offset = parser->literal
+    };
+
+    if (!mdv_vector_push_back(parser->conds, &cond))
+    {
+        MDV_LOGE("No memory for expression conditions");
+        parser->failed = true;
+    }
+}
+
+
+static bool mdv_predicate_cmp_parse(mdv_predicate_parser *parser)
+{
+    mdv_predicate_operand lhs;
+
+    if (!mdv_predicate_operand_parse(parser, &lhs))
+        return false;
+
+    mdv_vm_cmp_op op = MDV_VM_CMP_EQ;
+
+    switch(parser->tok)
+    {
+        case MDV_TOK_EQ:    op = MDV_VM_CMP_EQ; break;
+        case MDV_TOK_NE:    op = MDV_VM_CMP_NE; break;
+        case MDV_TOK_LT:    op = MDV_VM_CMP_LT; break;
+        case MDV_TOK_LE:    op = MDV_VM_CMP_LE; break;
+        case MDV_TOK_GT:    op = MDV_VM_CMP_GT; break;
+        case MDV_TOK_GE:    op = MDV_VM_CMP_GE; break;
+
+        default:
+        {
+            // Single operand should be boolean
+            if (lhs.kind == MDV_OPND_BOOL)
+            {
+                mdv_predicate_emit_bool(parser, lhs.boolean);
+                return true;
+            }
+
+            if (lhs.kind == MDV_OPND_FIELD
+                && parser->desc->fields[lhs.field].type == MDV_FLD_TYPE_BOOL
+                && parser->desc->fields[lhs.field].limit == 1)
+            {
+                bool const value = true;
+                mdv_predicate_emit_arg(parser, lhs.field);
+                mdv_predicate_emit_push(parser, &value, sizeof value);
+                mdv_predicate_emit_cmp(parser, MDV_FLD_TYPE_BOOL, MDV_VM_CMP_EQ);
+                return true;
+            }
+
+            mdv_predicate_error(parser, lhs.pos, "boolean expression expected");
+            return false;
+        }
+    }
+
+    mdv_predicate_next(parser);
+
+    mdv_predicate_operand rhs;
+
+    if (!mdv_predicate_operand_parse(parser, &rhs))
+        return false;
+
+    mdv_field_type type = MDV_FLD_TYPE_BYTE;
+
+    if (!mdv_predicate_emit_operands(parser, &lhs, &rhs, &type))
+        return false;
+
+    mdv_predicate_emit_cmp(parser, type, op);
+
+    if ((lhs.kind == MDV_OPND_FIELD) != (rhs.kind == MDV_OPND_FIELD))
+        mdv_predicate_cond_add(parser, &lhs, &rhs, op);
+
+    return true;
+}
+
+
+static bool mdv_predicate_not_parse(mdv_predicate_parser *parser)
+{
+    if (parser->tok == MDV_TOK_NOT)
+    {
+        mdv_predicate_next(parser);
+
+        ++parser->depth;
+
+        if (!mdv_predicate_not_parse(parser))
+            return false;
+
+        --parser->depth;
+
+        mdv_predicate_emit_call(parser, MDV_PREDICATE_FN_NOT);
+
+        return true;
+    }
+
+    if (parser->tok == MDV_TOK_LB)
+    {
+        mdv_predicate_next(parser);
+
+        ++parser->depth;
+
+        if (!mdv_predicate_expr_parse(parser))
+            return false;
+
+        --parser->depth;
+
+        if (parser->tok != MDV_TOK_RB)
+        {
+            mdv_predicate_error(parser, parser->tok_ptr, "')' expected");
+            return false;
+        }
+
+        mdv_predicate_next(parser);
+
+        return true;
+    }
+
+    return mdv_predicate_cmp_parse(parser);
+}
+
+
+static bool mdv_predicate_and_parse(mdv_predicate_parser *parser)
+{
+    if (!mdv_predicate_not_parse(parser))
+        return false;
+
+    while(parser->tok == MDV_TOK_AND)
+    {
+        mdv_predicate_next(parser);
+
+        if (!mdv_predicate_not_parse(parser))
+            return false;
+
+        mdv_predicate_emit_call(parser, MDV_PREDICATE_FN_AND);
+    }
+
+    return true;
+}
+
+
+static bool mdv_predicate_expr_parse(mdv_predicate_parser *parser)
+{
+    if (!mdv_predicate_and_parse(parser))
+        return false;
+
+    while(parser->tok == MDV_TOK_OR)
+    {
+        if (!parser->depth)
+        {
+            // Conditions aren't satisfied by all matched rows
+            parser->disjunction = true;
+            mdv_vector_clear(parser->conds);
+        }
+
+        mdv_predicate_next(parser);
+
+        if (!mdv_predicate_and_parse(parser))
+            return false;
+
+        mdv_predicate_emit_call(parser, MDV_PREDICATE_FN_OR);
+    }
+
+    return true;
+}
+
+
+static bool mdv_predicate_compile(mdv_table_desc const *desc,
+                                  char const *expression,
+                                  mdv_vector *code,
+                                  mdv_vector *args,
+                                  mdv_vector *conds)
+{
+    mdv_predicate_parser parser =
+    {
+        .desc = desc,
+        .expression = expression,
+        .pos = expression,
+        .code = code,
+        .args = args,
+        .conds = conds,
+        .failed = false
+    };
+
+    mdv_predicate_next(&parser);
+
+    if (parser.tok == MDV_TOK_END)
+    {
+        // Empty expression is always true
+        mdv_predicate_emit(&parser, MDV_EMPTY_PREDICATE, sizeof MDV_EMPTY_PREDICATE);
+        return !parser.failed;
+    }
+
+    if (!mdv_predicate_expr_parse(&parser))
+        return false;
+
+    if (parser.tok != MDV_TOK_END)
+    {
+        mdv_predicate_error(&parser, parser.tok_ptr, "unexpected token");
+        return false;
+    }
+
+    uint8_t const end = MDV_VM_END;
+
+    mdv_predicate_emit(&parser, &end, sizeof end);
+
+    return !parser.failed;
+}
+
+
+mdv_predicate * mdv_predicate_parse(mdv_table_desc const *desc, char const *expression)
+{
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(4);
 
     mdv_predicate *predicate = mdv_alloc(sizeof(mdv_predicate));
 
@@ -66,10 +1029,37 @@ mdv_predicate * mdv_predicate_parse(char const *expression)
 
     mdv_rollbacker_push(rollbacker, mdv_vector_release, predicate->expr);
 
-    if (expression && *expression)
-        MDV_LOGW("Expression '%s' wasn't parsed. Default expression is used.", expression);
+    predicate->args = mdv_vector_create(desc ? desc->size : 0, sizeof(mdv_predicate_arg), &mdv_default_allocator);
+
+    if (!predicate->args)
+    {
+        MDV_LOGE("No memory for predicate");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_vector_release, predicate->args);
 
-    mdv_vector_append(predicate->expr, MDV_EMPTY_PREDICATE, sizeof MDV_EMPTY_PREDICATE);
+    predicate->conds = mdv_vector_create(4, sizeof(mdv_predicate_cond), &mdv_default_allocator);
+
+    if (!predicate->conds)
+    {
+        MDV_LOGE("No memory for predicate");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_vector_release, predicate->conds);
+
+    if (!mdv_predicate_compile(desc,
+                               expression ? expression : "",
+                               predicate->expr,
+                               predicate->args,
+                               predicate->conds))
+    {
+        mdv_rollback(rollbacker);
+        return 0;
+    }
 
     mdv_rollbacker_free(rollbacker);
 
@@ -87,6 +1077,8 @@ mdv_predicate * mdv_predicate_retain(mdv_predicate *predicate)
 static void mdv_predicate_free(mdv_predicate *predicate)
 {
     mdv_vector_release(predicate->expr);
+    mdv_vector_release(predicate->args);
+    mdv_vector_release(predicate->conds);
     mdv_free(predicate);
 }
 
@@ -123,3 +1115,163 @@ size_t mdv_predicate_fns_count(mdv_predicate const *predicate)
 {
     return predicate->fns_count;
 }
+
+
+size_t mdv_predicate_args_count(mdv_predicate const *predicate)
+{
+    return mdv_vector_size(predicate->args);
+}
+
+
+static mdv_errno mdv_predicate_bind(mdv_stack_base *stack,
+                                    mdv_predicate_arg const *field,
+                                    binn *value,
+                                    mdv_vm_datum *arg)
+{
+    uint32_t const type_size = mdv_field_type_size(field->type);
+
+    arg->external = true;
+
+    if (field->limit == 1)
+    {
+        uint64_t data = 0;
+
+        if (!mdv_unbinn_field_value(value, field->type, &data))
+            return MDV_INVALID_TYPE;
+
+        arg->size = type_size;
+        arg->data = mdv_stack_push(*stack, (char const *)&data, type_size);
+    }
+    else if (type_size == 1)
+    {
+        // Strings and byte arrays are used without copying
+        arg->size = binn_size(value);
+        arg->data = binn_ptr(value);
+    }
+    else
+    {
+        uint32_t count = 0;
+
+        if (!mdv_unbinn_array_size(value, field->type, &count))
+            return MDV_INVALID_TYPE;
+
+        if (stack->size + (size_t)count * type_size > stack->capacity)
+            return MDV_STACK_OVERFLOW;
+
+        char *items = stack->data + stack->size;
+
+        if (!mdv_unbinn_array(value, field->type, items, &count))
+            return MDV_INVALID_TYPE;
+
+        stack->size += (size_t)count * type_size;
+
+        arg->size = count * type_size;
+        arg->data = items;
+    }
+
+    return arg->data ? MDV_OK : MDV_STACK_OVERFLOW;
+}
+
+
+mdv_errno mdv_predicate_eval(mdv_predicate const *predicate, mdv_stack_base *stack, binn const *row)
+{
+    size_t const args_count = mdv_vector_size(predicate->args);
+    mdv_predicate_arg const *fields = mdv_vector_data(predicate->args);
+
+    mdv_vm_datum args[args_count ? args_count : 1];
+
+    stack->size = 0;
+
+    if (args_count)
+    {
+        binn_iter iter = {};
+        binn value = {};
+        size_t n = 0;
+
+        binn_list_foreach((binn *)row, value)
+        {
+            if (n >= args_count)
+                break;
+
+            if (fields[n].used)
+            {
+                mdv_errno err = mdv_predicate_bind(stack, fields + n, &value, args + n);
+
+                if (err != MDV_OK)
+                    return err;
+            }
+
+            ++n;
+        }
+
+        if (n < args_count)
+        {
+            MDV_LOGE("Row doesn't contain all fields required by predicate");
+            return MDV_INVALID_ARG;
+        }
+    }
+
+    mdv_errno err = mdv_vm_run(stack,
+                               predicate->fns,
+                               predicate->fns_count,
+                               args,
+                               args_count,
+                               mdv_vector_data(predicate->expr));
+
+    if (err != MDV_OK)
+        return err;
+
+    bool res = false;
+
+    err = mdv_vm_result_as_bool(stack, &res);
+
+    if (err != MDV_OK)
+        return err;
+
+    return res ? MDV_OK : MDV_FALSE;
+}
+
+
+bool mdv_predicate_field_range(mdv_predicate const *predicate, uint32_t field, mdv_predicate_range *range)
+{
+    uint8_t const *code = mdv_vector_data(predicate->expr);
+
+    memset(range, 0, sizeof *range);
+
+    mdv_vector_foreach(predicate->conds, mdv_predicate_cond, cond)
+    {
+        if (cond->field != field)
+            continue;
+
+        mdv_data const value =
+        {
+            .size = cond->size,
+            .ptr = (void*)(code + cond->offset)
+        };
+
+        switch(cond->op)
+        {
+            case MDV_VM_CMP_EQ:
+                range->from = value;
+                range->to = value;
+                return true;
+
+            case MDV_VM_CMP_GT:
+            case MDV_VM_CMP_GE:
+                if (!range->from.ptr)
+                    range->from = value;
+                break;
+
+            case MDV_VM_CMP_LT:
+            case MDV_VM_CMP_LE:
+                if (!range->to.ptr)
+                    range->to = value;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return range->from.ptr || range->to.ptr;
+}
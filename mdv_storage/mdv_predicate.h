@@ -9,17 +9,43 @@
 #pragma once
 #include <mdv_vector.h>
 #include <mdv_vm.h>
+#include <mdv_table_desc.h>
+#include <mdv_data.h>
+#include <mdv_binn.h>
 
 
 /// Predicate
 typedef struct mdv_predicate mdv_predicate;
 
 
+/// Field values range
+typedef struct
+{
+    mdv_data    from;       ///< Lower bound (field native representation). NULL pointer means the range is unbounded.
+    mdv_data    to;         ///< Upper bound (field native representation). NULL pointer means the range is unbounded.
+} mdv_predicate_range;
+
+
 /**
  * @brief Creates predicate.
- * @details Expression is parsed and compiled for VM
+ * @details Expression is parsed and compiled for VM.
+ *          Following grammar is supported:
+ *              expr    := and_expr { OR and_expr }
+ *              and_expr:= not_expr { AND not_expr }
+ *              not_expr:= NOT not_expr | '(' expr ')' | operand [ cmp operand ]
+ *              cmp     := '=' | '==' | '!=' | '<>' | '<' | '<=' | '>' | '>='
+ *              operand := field | integer | real | 'string' | TRUE | FALSE
+ *          Fields are referenced by names (identifiers or "quoted names").
+ *          Field with index N is passed to the VM program as argument N.
+ *          Empty expression is always true.
+ *
+ * @param desc [in]         Table description (used for field references resolving)
+ * @param expression [in]   Expression
+ *
+ * @return On success, returns non zero pointer to new predicate
+ * @return On error, returns NULL pointer
  */
-mdv_predicate * mdv_predicate_parse(char const *expression);
+mdv_predicate * mdv_predicate_parse(mdv_table_desc const *desc, char const *expression);
 
 
 /**
@@ -53,3 +79,42 @@ mdv_vm_fn const * mdv_predicate_fns(mdv_predicate const *predicate);
  * @brief Returns custom handlers count assigned with predicate
  */
 size_t mdv_predicate_fns_count(mdv_predicate const *predicate);
+
+
+/**
+ * @brief Returns arguments count required by compiled expression
+ * @details Argument N is the value of table field N.
+ */
+size_t mdv_predicate_args_count(mdv_predicate const *predicate);
+
+
+/**
+ * @brief Evaluates predicate for serialized row
+ * @details Only fields referenced by the expression are bound as external VM arguments.
+ *          Strings and byte arrays point directly to the serialized row data.
+ *          Other fields are decoded into the bottom of the VM stack, so no heap allocations are performed.
+ *
+ * @param predicate [in]    Predicate
+ * @param stack [in]        VM stack
+ * @param row [in]          Serialized row (binn list)
+ *
+ * @return MDV_OK if the row satisfies the predicate
+ * @return MDV_FALSE if the row doesn't satisfy the predicate
+ * @return On error, returns negative error code
+ */
+mdv_errno mdv_predicate_eval(mdv_predicate const *predicate, mdv_stack_base *stack, binn const *row);
+
+
+/**
+ * @brief Returns field values range for rows satisfying the predicate
+ * @details Only top level conjunctive comparisons of the field with literals are considered.
+ *          The range is not exact. All rows satisfying the predicate are in range,
+ *          but rows in range can fail the predicate. Range bounds are inclusive.
+ *
+ * @param predicate [in]    Predicate
+ * @param field [in]        Field index
+ * @param range [out]       Field values range
+ *
+ * @return true if at least one range bound is found
+ */
+bool mdv_predicate_field_range(mdv_predicate const *predicate, uint32_t field, mdv_predicate_range *range);
@@ -3,6 +3,7 @@
 #include <mdv_log.h>
 #include <string.h>
 #include <stdatomic.h>
+#include <stddef.h>
 
 
 typedef struct
@@ -11,6 +12,7 @@ typedef struct
     atomic_uint_fast32_t    ref_counter;
     mdv_op                 *src;
     mdv_predicate          *predicate;
+    mdv_stack_base          stack;          ///< VM stack (should be the last member)
 } mdv_select_t;
 
 
@@ -56,23 +58,41 @@ static mdv_errno mdv_select_next(mdv_op *op, mdv_kvdata *kvdata)
 {
     mdv_select_t *select = (mdv_select_t *)op;
 
-    mdv_kvdata current;
+    for(;;)
+    {
+        mdv_kvdata current;
+
+        mdv_errno err = mdv_op_next(select->src, &current);
+        if (err != MDV_OK)
+            return err;
+
+        binn row;
 
-    mdv_errno err = mdv_op_next(select->src, &current);
-    if (err != MDV_OK)
-        return err;
+        if (!binn_load(current.value.ptr, &row))
+        {
+            MDV_LOGE("Invalid serialized row");
+            return MDV_FAILED;
+        }
 
-    // TODO: use predicate for DB entries selection
+        err = mdv_predicate_eval(select->predicate, &select->stack, &row);
 
-    *kvdata = current;
+        binn_free(&row);
 
-    return MDV_OK;
+        if (err == MDV_OK)
+        {
+            *kvdata = current;
+            return MDV_OK;
+        }
+
+        if (err != MDV_FALSE)
+            return err;
+    }
 }
 
 
-mdv_op * mdv_select(mdv_op *src, mdv_predicate *predicate)
+mdv_op * mdv_select(mdv_op *src, mdv_predicate *predicate, size_t vm_stack)
 {
-    mdv_select_t *select = mdv_alloc(sizeof(mdv_select_t));
+    mdv_select_t *select = mdv_alloc(offsetof(mdv_select_t, stack.data) + vm_stack);
 
     if (!select)
     {
@@ -83,6 +103,8 @@ mdv_op * mdv_select(mdv_op *src, mdv_predicate *predicate)
     atomic_init(&select->ref_counter, 1);
     select->src = mdv_op_retain(src);
     select->predicate = mdv_predicate_retain(predicate);
+    select->stack.capacity = vm_stack;
+    select->stack.size = 0;
 
     static mdv_iop const vtbl =
     {
@@ -15,9 +15,12 @@
 
 /**
  * @brief Create DB entries filter
+ * @details Entries are serialized rows. Entries which don't satisfy the predicate are skipped.
  *
- * @param src [in] Source operation
+ * @param src [in]          Source operation
+ * @param predicate [in]    Predicate for entries filtering
+ * @param vm_stack [in]     VM stack size for predicate evaluation
  *
  * @return DB entries filter
  */
-mdv_op * mdv_select(mdv_op *src, mdv_predicate *predicate);
+mdv_op * mdv_select(mdv_op *src, mdv_predicate *predicate, size_t vm_stack);
@@ -18,6 +18,7 @@ int main(int argc, char *argv[])
     MU_RUN_SUITE(types);
     MU_RUN_SUITE(crypto);
     MU_RUN_SUITE(storage);
+    MU_RUN_SUITE(core);
     MU_REPORT();
 
     return minunit_status;
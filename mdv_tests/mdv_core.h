@@ -0,0 +1,16 @@
+#pragma once
+#include "mdv_core/mdv_rowdata.h"
+#include "mdv_core/mdv_idmap.h"
+#include "mdv_core/mdv_placement.h"
+#include "mdv_core/mdv_gather_view.h"
+
+
+MU_TEST_SUITE(core)
+{
+    MU_RUN_TEST(core_rowdata_batch_replay);
+    MU_RUN_TEST(core_rowdata_import);
+    MU_RUN_TEST(core_idmap);
+    MU_RUN_TEST(core_placement);
+    MU_RUN_TEST(core_placement_scanner);
+    MU_RUN_TEST(core_gather_view);
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <minunit.h>
+#include <storage/mdv_gather_view.h>
+
+
+/// Partial view stub which returns the given number of batches
+typedef struct
+{
+    mdv_view    base;
+    int32_t     id;             ///< Partial view identifier
+    int32_t     batches;        ///< Batches count
+    int32_t     fetched;        ///< Fetched batches count
+    bool        requested;      ///< Flag indicates that the next batch is requested
+} mdv_test_stub_view;
+
+
+static mdv_view * mdv_test_stub_view_retain(mdv_view *base)
+{
+    return base;
+}
+
+
+static uint32_t mdv_test_stub_view_release(mdv_view *base)
+{
+    (void)base;
+    return 1;
+}
+
+
+static mdv_table * mdv_test_stub_view_desc(mdv_view *base)
+{
+    (void)base;
+    return 0;
+}
+
+
+static mdv_errno mdv_test_stub_view_fetch(mdv_view *base, size_t count, size_t bytes, binn *rows)
+{
+    (void)count;
+    (void)bytes;
+
+    mdv_test_stub_view *view = (mdv_test_stub_view *)base;
+
+    view->requested = false;
+
+    if (view->fetched >= view->batches)
+        return MDV_FAILED;
+
+    if (!binn_create_list(rows))
+        return MDV_NO_MEM;
+
+    binn_list_add_int32(rows, view->id * 10 + view->fetched++);
+
+    return MDV_OK;
+}
+
+
+static void mdv_test_stub_view_prefetch(mdv_view *base, size_t count, size_t bytes)
+{
+    (void)count;
+    (void)bytes;
+
+    mdv_test_stub_view *view = (mdv_test_stub_view *)base;
+
+    if (view->fetched < view->batches)
+        view->requested = true;
+}
+
+
+static mdv_iview const mdv_test_stub_view_vtbl =
+{
+    .retain   = mdv_test_stub_view_retain,
+    .release  = mdv_test_stub_view_release,
+    .desc     = mdv_test_stub_view_desc,
+    .fetch    = mdv_test_stub_view_fetch,
+    .prefetch = mdv_test_stub_view_prefetch,
+};
+
+
+MU_TEST(core_gather_view)
+{
+    mdv_test_stub_view stubs[] =
+    {
+        { .base = { &mdv_test_stub_view_vtbl }, .id = 1, .batches = 2 },
+        { .base = { &mdv_test_stub_view_vtbl }, .id = 2, .batches = 1 },
+        { .base = { &mdv_test_stub_view_vtbl }, .id = 3, .batches = 3 },
+    };
+
+    size_t const stubs_count = sizeof stubs / sizeof *stubs;
+
+    mdv_view *views[] = { &stubs[0].base, &stubs[1].base, &stubs[2].base };
+
+    mdv_view *view = mdv_gather_view_create(views, stubs_count);
+    mu_check(view);
+
+    // Partial views are read round-robin
+    int32_t const expected[] = { 10, 20, 30, 11, 31, 32 };
+
+    for(size_t i = 0; i < sizeof expected / sizeof *expected; ++i)
+    {
+        binn rows;
+
+        mu_check(mdv_view_fetch(view, 16, 1024, &rows) == MDV_OK);
+        mu_check(binn_count(&rows) == 1);
+
+        int32_t value = 0;
+        mu_check(binn_list_get_int32(&rows, 1, &value));
+        mu_check(value == expected[i]);
+
+        binn_free(&rows);
+
+        // Every unfinished partial view has the request in flight
+        for(size_t j = 0; j < stubs_count; ++j)
+            mu_check(stubs[j].fetched == stubs[j].batches || stubs[j].requested);
+    }
+
+    binn rows;
+    mu_check(mdv_view_fetch(view, 16, 1024, &rows) == MDV_FAILED);
+
+    mdv_view_release(view);
+}
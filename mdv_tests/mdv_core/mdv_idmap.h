@@ -0,0 +1,93 @@
+#pragma once
+#include <minunit.h>
+#include <storage/mdv_idmap.h>
+#include <mdv_vector.h>
+#include <mdv_alloc.h>
+
+
+static mdv_idmap * mdv_test_idmap_create(mdv_toponode *nodes, size_t size)
+{
+    mdv_vector *toponodes = mdv_vector_create(size, sizeof(mdv_toponode), &mdv_default_allocator);
+    mdv_vector_append(toponodes, nodes, size);
+
+    mdv_topology *topology = mdv_topology_create(toponodes, &mdv_empty_vector, &mdv_empty_vector);
+
+    mdv_vector_release(toponodes);
+
+    mdv_idmap *idmap = mdv_idmap_create_by_topology(topology);
+
+    mdv_topology_release(topology);
+
+    return idmap;
+}
+
+
+MU_TEST(core_idmap)
+{
+    mdv_uuid const a = { .a = 1 }, b = { .a = 2 }, c = { .a = 3 }, d = { .a = 4 };
+
+    // Nodes are discovered in different order, so local identifiers are different
+    mdv_toponode nodes_a[] =
+    {
+        { .id = 0, .uuid = a, .addr = "a" },
+        { .id = 1, .uuid = b, .addr = "b" },
+        { .id = 2, .uuid = c, .addr = "c" },
+    };
+
+    mdv_toponode nodes_b[] =
+    {
+        { .id = 0, .uuid = b, .addr = "b" },
+        { .id = 1, .uuid = c, .addr = "c" },
+        { .id = 2, .uuid = a, .addr = "a" },
+    };
+
+    mdv_idmap *idmap_a = mdv_test_idmap_create(nodes_a, sizeof nodes_a / sizeof *nodes_a);
+    mdv_idmap *idmap_b = mdv_test_idmap_create(nodes_b, sizeof nodes_b / sizeof *nodes_b);
+
+    mu_check(idmap_a && idmap_b);
+    mu_check(mdv_idmap_size(idmap_a) == 3);
+
+    uint32_t id = 42;
+    mu_check(mdv_idmap_local(idmap_b, &a, &id) && id == 2);
+    mu_check(!mdv_idmap_local(idmap_b, &d, &id));
+
+    mdv_uuid uuid = {};
+    mu_check(mdv_idmap_global(idmap_a, 1, &uuid) && mdv_uuid_cmp(&uuid, &b) == 0);
+    mu_check(!mdv_idmap_global(idmap_a, 3, &uuid));
+
+    // Rows identifiers are translated from node A identifiers to node B identifiers
+    mdv_objid const rows_a[] =
+    {
+        { .node = 0, .id = 10 },    // a
+        { .node = 1, .id = 11 },    // b
+        { .node = 2, .id = 12 },    // c
+    };
+
+    mdv_gobjid gids[3];
+    mu_check(mdv_idmap_objids_global(idmap_a, rows_a, 3, gids));
+
+    mdv_uuid const expected[] = { a, b, c };
+
+    for(size_t i = 0; i < 3; ++i)
+    {
+        mdv_uuid const node = gids[i].node;
+        mu_check(mdv_uuid_cmp(&node, expected + i) == 0 && gids[i].id == 10 + i);
+    }
+
+    mdv_objid rows_b[3];
+    mu_check(mdv_idmap_objids_local(idmap_b, gids, 3, rows_b));
+
+    mu_check(rows_b[0].node == 2 && rows_b[0].id == 10);
+    mu_check(rows_b[1].node == 0 && rows_b[1].id == 11);
+    mu_check(rows_b[2].node == 1 && rows_b[2].id == 12);
+
+    // Rows of unknown nodes aren't translated
+    gids[1].node = d;
+    mu_check(!mdv_idmap_objids_local(idmap_b, gids, 3, rows_b));
+
+    mdv_objid const unknown = { .node = 7, .id = 1 };
+    mu_check(!mdv_idmap_objids_global(idmap_a, &unknown, 1, gids));
+
+    mu_check(mdv_idmap_release(idmap_a) == 0);
+    mu_check(mdv_idmap_release(idmap_b) == 0);
+}
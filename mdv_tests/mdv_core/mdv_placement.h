@@ -0,0 +1,193 @@
+#pragma once
+#include <minunit.h>
+#include <storage/mdv_placement.h>
+#include <mdv_router.h>
+#include <mdv_vector.h>
+#include <mdv_alloc.h>
+
+
+static mdv_topology * mdv_test_placement_topology(mdv_toponode *nodes, size_t nsize,
+                                                  mdv_topolink *links, size_t lsize)
+{
+    mdv_vector *toponodes = mdv_vector_create(nsize, sizeof(mdv_toponode), &mdv_default_allocator);
+    mdv_vector_append(toponodes, nodes, nsize);
+
+    mdv_vector *topolinks = mdv_vector_create(lsize, sizeof(mdv_topolink), &mdv_default_allocator);
+    mdv_vector_append(topolinks, links, lsize);
+
+    mdv_topology *topology = mdv_topology_create(toponodes, topolinks, &mdv_empty_vector);
+
+    mdv_vector_release(toponodes);
+    mdv_vector_release(topolinks);
+
+    return topology;
+}
+
+
+MU_TEST(core_placement)
+{
+    /*
+        Topology:
+            0 - 1 - 2 - 3 (- 4 joins later)
+    */
+
+    mdv_toponode nodes[] =
+    {
+        { .id = 0, .uuid = { .a = 10 }, .addr = "0" },
+        { .id = 1, .uuid = { .a = 11 }, .addr = "1" },
+        { .id = 2, .uuid = { .a = 12 }, .addr = "2" },
+        { .id = 3, .uuid = { .a = 13 }, .addr = "3" },
+        { .id = 4, .uuid = { .a = 14 }, .addr = "4" },
+    };
+
+    mdv_topolink links[] =
+    {
+        { .node = { 0, 1 }, .weight = 1 },
+        { .node = { 1, 2 }, .weight = 1 },
+        { .node = { 2, 3 }, .weight = 1 },
+        { .node = { 3, 4 }, .weight = 1 },
+    };
+
+    mdv_topology *topology = mdv_test_placement_topology(nodes, 4, links, 3);
+    mdv_topology *extended = mdv_test_placement_topology(nodes, 5, links, 4);
+    mu_check(topology && extended);
+
+    mdv_placement *placements[4];
+
+    for(size_t i = 0; i < 4; ++i)
+    {
+        placements[i] = mdv_placement_create(topology, &nodes[i].uuid, 2);
+        mu_check(placements[i]);
+    }
+
+    // Not partitioned tables are stored by all nodes
+    mdv_table_desc desc = { .name = "table" };
+
+    mdv_placement_assign(placements[0], &desc);
+    mu_check(!mdv_placement_enabled(&desc));
+    mu_check(mdv_placement_owns(placements[0], &desc, 0));
+
+    // Members of the partitioned table are fixed on the table creation
+    desc.partitioned = true;
+
+    mdv_placement_assign(placements[0], &desc);
+    mu_check(mdv_placement_enabled(&desc));
+    mu_check(desc.replicas == 2);
+    mu_check(desc.members_size == 4);
+
+    mdv_placement *joined = mdv_placement_create(extended, &nodes[0].uuid, 2);
+    mdv_placement *newcomer = mdv_placement_create(extended, &nodes[4].uuid, 2);
+    mu_check(joined && newcomer);
+
+    for(uint32_t partition = 0; partition < MDV_PARTITIONS; ++partition)
+    {
+        uint32_t owners = 0;
+
+        for(size_t i = 0; i < 4; ++i)
+            owners += mdv_placement_owns(placements[i], &desc, partition);
+
+        mu_check(owners == 2);
+
+        // Topology changes don't move partitions
+        mu_check(mdv_placement_owns(joined, &desc, partition) == mdv_placement_owns(placements[0], &desc, partition));
+        mu_check(!mdv_placement_owns(newcomer, &desc, partition));
+
+        // Other owners are reachable through the only neighbour
+        mu_check(mdv_placement_reachable(placements[0], &desc, partition, &nodes[1].uuid));
+
+        mdv_uuid const *reader = mdv_placement_reader(placements[0], &desc, partition);
+
+        if (mdv_placement_owns(placements[0], &desc, partition))
+            mu_check(mdv_uuid_cmp(reader, &nodes[0].uuid) == 0);
+        else
+        {
+            size_t i = 1;
+
+            while(i < 4 && mdv_uuid_cmp(reader, &nodes[i].uuid) != 0)
+                ++i;
+
+            mu_check(i < 4 && mdv_placement_owns(placements[i], &desc, partition));
+        }
+    }
+
+    mdv_placement_release(joined);
+    mdv_placement_release(newcomer);
+
+    for(size_t i = 0; i < 4; ++i)
+        mdv_placement_release(placements[i]);
+
+    mdv_topology_release(topology);
+    mdv_topology_release(extended);
+}
+
+
+MU_TEST(core_placement_scanner)
+{
+    /*
+        Topology:
+            0 - 1 - 2
+    */
+
+    mdv_toponode nodes[] =
+    {
+        { .id = 0, .uuid = { .a = 10 }, .addr = "0" },
+        { .id = 1, .uuid = { .a = 11 }, .addr = "1" },
+        { .id = 2, .uuid = { .a = 12 }, .addr = "2" },
+    };
+
+    mdv_topolink links[] =
+    {
+        { .node = { 0, 1 }, .weight = 1 },
+        { .node = { 1, 2 }, .weight = 1 },
+    };
+
+    mdv_topology *topology = mdv_test_placement_topology(nodes, 3, links, 2);
+    mu_check(topology);
+
+    mdv_placement *placement = mdv_placement_create(topology, &nodes[1].uuid, 0);
+    mu_check(placement);
+
+    // Scanners count is limited by the current node and its neighbours
+    uint32_t const scanners[] = { 0, 1, 2, 3, 5 };
+    uint32_t const expected[] = { 1, 1, 2, 3, 3 };
+
+    for(size_t n = 0; n < sizeof scanners / sizeof *scanners; ++n)
+    {
+        uint32_t partitions[3] = {};
+
+        for(uint32_t partition = 0; partition < MDV_PARTITIONS; ++partition)
+        {
+            mdv_uuid const *scanner = mdv_placement_scanner(placement, partition, scanners[n]);
+
+            size_t i = 0;
+
+            while(i < 3 && mdv_uuid_cmp(scanner, &nodes[i].uuid) != 0)
+                ++i;
+
+            mu_check(i < 3);
+
+            // Scan is split between directly connected nodes only
+            mu_check(i == 1 || mdv_placement_neighbour(placement, scanner));
+
+            partitions[i]++;
+        }
+
+        uint32_t used = 0;
+
+        for(size_t i = 0; i < 3; ++i)
+        {
+            if (!partitions[i])
+                continue;
+
+            // Partitions are distributed evenly
+            mu_check(partitions[i] >= MDV_PARTITIONS / expected[n]);
+            ++used;
+        }
+
+        mu_check(used == expected[n]);
+        mu_check(partitions[1] > 0);
+    }
+
+    mdv_placement_release(placement);
+    mdv_topology_release(topology);
+}
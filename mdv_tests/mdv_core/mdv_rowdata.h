@@ -0,0 +1,265 @@
+#pragma once
+#include <minunit.h>
+#include <storage/mdv_rowdata.h>
+#include <mdv_filesystem.h>
+#include <mdv_names.h>
+#include <mdv_vector.h>
+#include <mdv_alloc.h>
+
+
+static int mdv_test_rowdata_all(void *arg, mdv_objid const *id, binn const *row)
+{
+    (void)arg;
+    (void)id;
+    (void)row;
+    return 1;
+}
+
+
+static size_t mdv_test_rowdata_count(mdv_rowdata *rowdata)
+{
+    mdv_vector *ids = mdv_vector_create(8, sizeof(mdv_objid), &mdv_default_allocator);
+
+    size_t count = 0;
+
+    if (mdv_rowdata_select_ids(rowdata, ids, mdv_test_rowdata_all, 0) == MDV_OK)
+        count = mdv_vector_size(ids);
+
+    mdv_vector_release(ids);
+
+    return count;
+}
+
+
+static void mdv_test_rowdata_rowset(binn *rowset, int32_t const *values, size_t count)
+{
+    binn_create_list(rowset);
+
+    for(size_t i = 0; i < count; ++i)
+    {
+        binn *row = binn_list();
+        binn_list_add_int32(row, values[i]);
+        binn_list_add_list(rowset, row);
+        binn_free(row);
+    }
+}
+
+
+MU_TEST(core_rowdata_batch_replay)
+{
+    mdv_field const fields[] =
+    {
+        { MDV_FLD_TYPE_INT32, 1, "Col1" }
+    };
+
+    mdv_table_desc const desc =
+    {
+        .name = "ReplayTable",
+        .size = 1,
+        .fields = fields
+    };
+
+    mdv_uuid const table_id = { .a = 42 };
+    mdv_uuid const trlog = { .a = 1, .b = 2 };
+
+    mdv_table *table = mdv_table_create(&table_id, &desc);
+    mu_check(table);
+
+    mdv_rowdata *rowdata = mdv_rowdata_open("./test_rowdata", table);
+    mu_check(rowdata);
+
+    int32_t const values[] = { 1, 2, 3 };
+
+    binn rowset;
+    mdv_test_rowdata_rowset(&rowset, values, sizeof values / sizeof *values);
+
+    // Batch applies transaction log records [0, 10)
+    mdv_rowdata_batch *batch = mdv_rowdata_batch_begin(rowdata, &trlog);
+    mu_check(batch);
+    mu_check(mdv_rowdata_batch_applied(batch) == 0);
+
+    mdv_objid const first = { .node = 0, .id = 0 };
+    mu_check(mdv_rowdata_batch_add_rowset(batch, 5, &first, &rowset) == MDV_OK);
+    mu_check(mdv_rowdata_batch_commit(batch, 10) == MDV_OK);
+
+    mu_check(mdv_test_rowdata_count(rowdata) == 3);
+
+    // Deletion below the table mark is replayed and skipped
+    batch = mdv_rowdata_batch_begin(rowdata, &trlog);
+    mu_check(batch);
+    mu_check(mdv_rowdata_batch_applied(batch) == 10);
+
+    mdv_objid const removed[] = { { .node = 0, .id = 0 }, { .node = 0, .id = 1 } };
+    mdv_objid const old_op = { .node = 0, .id = 7 };
+    mu_check(mdv_rowdata_batch_remove(batch, &old_op, removed, 2) == MDV_OK);
+
+    // Insertion below the table mark is replayed and skipped
+    mdv_objid const next = { .node = 0, .id = 3 };
+    mu_check(mdv_rowdata_batch_add_rowset(batch, 9, &next, &rowset) == MDV_OK);
+    mu_check(mdv_rowdata_batch_commit(batch, 10) == MDV_OK);
+
+    mu_check(mdv_test_rowdata_count(rowdata) == 3);
+
+    // Operations at or above the table mark are applied
+    batch = mdv_rowdata_batch_begin(rowdata, &trlog);
+    mu_check(batch);
+
+    mdv_objid const new_op = { .node = 0, .id = 10 };
+    mu_check(mdv_rowdata_batch_remove(batch, &new_op, removed, 2) == MDV_OK);
+    mu_check(mdv_rowdata_batch_add_rowset(batch, 11, &next, &rowset) == MDV_OK);
+    mu_check(mdv_rowdata_batch_commit(batch, 12) == MDV_OK);
+
+    mu_check(mdv_test_rowdata_count(rowdata) == 4);
+
+    // Aborted batch keeps the table mark
+    batch = mdv_rowdata_batch_begin(rowdata, &trlog);
+    mu_check(batch);
+    mu_check(mdv_rowdata_batch_applied(batch) == 12);
+    mdv_rowdata_batch_abort(batch);
+
+    // Other transaction logs have their own marks
+    mdv_uuid const other = { .a = 3, .b = 4 };
+    batch = mdv_rowdata_batch_begin(rowdata, &other);
+    mu_check(batch);
+    mu_check(mdv_rowdata_batch_applied(batch) == 0);
+    mdv_rowdata_batch_abort(batch);
+
+    binn_free(&rowset);
+
+    mu_check(mdv_rowdata_release(rowdata) == 0);
+    mu_check(mdv_table_release(table) == 0);
+
+    mdv_rmdir("./test_rowdata");
+}
+
+
+static bool mdv_test_rowdata_translate(void *arg, mdv_objid *id)
+{
+    (void)arg;
+
+    switch(id->node)
+    {
+        case 0: id->node = 5; return true;      // sender rows
+        case 3: id->node = 0; return true;      // receiver rows
+    }
+
+    return false;
+}
+
+
+static bool mdv_test_rowdata_no_translate(void *arg, mdv_objid *id)
+{
+    (void)arg;
+    return id->node != 3;
+}
+
+
+static bool mdv_test_rowdata_purgeable(void *arg, mdv_objid const *op)
+{
+    (void)arg;
+    return op->node == 0 && op->id == 7;
+}
+
+
+static bool mdv_test_rowdata_contains(mdv_vector *ids, uint32_t node, uint64_t id)
+{
+    mdv_vector_foreach(ids, mdv_objid, entry)
+    {
+        if (entry->node == node && entry->id == id)
+            return true;
+    }
+
+    return false;
+}
+
+
+MU_TEST(core_rowdata_import)
+{
+    mdv_field const fields[] =
+    {
+        { MDV_FLD_TYPE_INT32, 1, "Col1" }
+    };
+
+    mdv_table_desc const desc =
+    {
+        .name = "ImportTable",
+        .size = 1,
+        .fields = fields
+    };
+
+    mdv_uuid const table_id = { .a = 43 };
+    mdv_uuid const trlog = { .a = 1, .b = 2 };
+
+    mdv_table *table = mdv_table_create(&table_id, &desc);
+    mu_check(table);
+
+    char storage_name[64];
+    MDV_STRG_UUID(&table_id, storage_name, sizeof storage_name);
+
+    int32_t const values[] = { 1, 2, 3 };
+
+    binn rowset;
+    mdv_test_rowdata_rowset(&rowset, values, sizeof values / sizeof *values);
+
+    // Source storage contains rows of the sender (node 0) and the receiver (node 3)
+    mdv_rowdata *src = mdv_rowdata_open("./test_rowdata_src", table);
+    mu_check(src);
+
+    mdv_rowdata_batch *batch = mdv_rowdata_batch_begin(src, &trlog);
+    mu_check(batch);
+
+    mdv_objid const sender_rows = { .node = 0, .id = 0 };
+    mdv_objid const receiver_rows = { .node = 3, .id = 100 };
+    mdv_objid const removed = { .node = 0, .id = 1 };
+    mdv_objid const op = { .node = 3, .id = 7 };
+
+    mu_check(mdv_rowdata_batch_add_rowset(batch, 0, &sender_rows, &rowset) == MDV_OK);
+    mu_check(mdv_rowdata_batch_add_rowset(batch, 1, &receiver_rows, &rowset) == MDV_OK);
+    mu_check(mdv_rowdata_batch_remove(batch, &op, &removed, 1) == MDV_OK);
+    mu_check(mdv_rowdata_batch_commit(batch, 10) == MDV_OK);
+
+    mu_check(mdv_rowdata_release(src) == 0);
+
+    // Import fails if a storage identifier is unknown
+    mdv_rowdata *rowdata = mdv_rowdata_open("./test_rowdata", table);
+    mu_check(rowdata);
+    mu_check(mdv_rowdata_import(rowdata, "./test_rowdata_src", storage_name, 0, mdv_test_rowdata_no_translate) != MDV_OK);
+    mu_check(mdv_test_rowdata_count(rowdata) == 0);
+
+    // Rows identifiers and tombstones are translated
+    mu_check(mdv_rowdata_import(rowdata, "./test_rowdata_src", storage_name, 0, mdv_test_rowdata_translate) == MDV_OK);
+
+    mdv_vector *ids = mdv_vector_create(8, sizeof(mdv_objid), &mdv_default_allocator);
+    mu_check(ids);
+    mu_check(mdv_rowdata_select_ids(rowdata, ids, mdv_test_rowdata_all, 0) == MDV_OK);
+    mu_check(mdv_vector_size(ids) == 5);
+    mu_check(mdv_test_rowdata_contains(ids, 5, 0));
+    mu_check(!mdv_test_rowdata_contains(ids, 5, 1));
+    mu_check(mdv_test_rowdata_contains(ids, 5, 2));
+    mu_check(mdv_test_rowdata_contains(ids, 0, 100));
+    mu_check(mdv_test_rowdata_contains(ids, 0, 102));
+    mdv_vector_release(ids);
+
+    size_t purged = 0;
+    mu_check(mdv_rowdata_purge(rowdata, 16, 0, mdv_test_rowdata_purgeable, &purged) == MDV_OK);
+    mu_check(purged == 1);
+
+    // Applied transaction logs positions are imported
+    batch = mdv_rowdata_batch_begin(rowdata, &trlog);
+    mu_check(batch);
+    mu_check(mdv_rowdata_batch_applied(batch) == 10);
+    mdv_rowdata_batch_abort(batch);
+
+    // Local identifiers generator skips the imported local rows
+    uint64_t id = 0;
+    mu_check(mdv_rowdata_reserve(rowdata, 1, &id) == MDV_OK);
+    mu_check(id == 103);
+
+    binn_free(&rowset);
+
+    mu_check(mdv_rowdata_release(rowdata) == 0);
+    mu_check(mdv_table_release(table) == 0);
+
+    mdv_rmdir("./test_rowdata_src");
+    mdv_rmdir("./test_rowdata");
+}
@@ -15,6 +15,7 @@
 #include "mdv_platform/mdv_threadpool.h"
 #include "mdv_platform/mdv_chaman.h"
 #include "mdv_platform/mdv_dispatcher.h"
+#include "mdv_platform/mdv_writev.h"
 #include "mdv_platform/mdv_jobber.h"
 #include "mdv_platform/mdv_ebus.h"
 #include "mdv_platform/mdv_algorithm.h"
@@ -46,6 +47,8 @@ MU_TEST_SUITE(platform)
     MU_RUN_TEST(platform_threadpool);
     MU_RUN_TEST(platform_chaman);
     MU_RUN_TEST(platform_dispatcher);
+    MU_RUN_TEST(platform_dispatcher_frames);
+    MU_RUN_TEST(platform_writev_all);
     MU_RUN_TEST(platform_jobber);
     MU_RUN_TEST(platform_ebus);
     MU_RUN_TEST(platform_algorithm);
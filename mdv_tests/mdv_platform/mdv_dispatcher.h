@@ -3,7 +3,10 @@
 #include <mdv_eventfd.h>
 #include <mdv_dispatcher.h>
 #include <mdv_threads.h>
+#include <mdv_socket.h>
+#include <mdv_alloc.h>
 #include <stdio.h>
+#include "mdv_socketpair.h"
 
 
 static volatile int mdv_dispatcher_handler_1_state = 0;
@@ -36,6 +39,13 @@ static mdv_errno mdv_dispatcher_handler_3(mdv_msg const *msg, void *arg)
 }
 
 
+static void mdv_dispatcher_response(mdv_errno err, mdv_msg const *resp, void *arg)
+{
+    int *state = arg;
+    *state = err == MDV_OK ? resp->hdr.id : err;
+}
+
+
 void *mdv_dispatcher_thread_test(void *arg)
 {
     mdv_dispatcher *pd = (mdv_dispatcher *)arg;
@@ -107,8 +117,212 @@ MU_TEST(platform_dispatcher)
 
     mdv_thread_join(thread);
 
+    int async_state = 0;
+    mu_check(mdv_dispatcher_send_async(pd, &msg, 1000, mdv_dispatcher_response, &async_state) == MDV_OK);
+    mu_check(mdv_dispatcher_read(pd) == MDV_OK);
+    mu_check(async_state == 42);
+
+    async_state = 0;
+    mu_check(mdv_dispatcher_send_async(pd, &msg, 0, mdv_dispatcher_response, &async_state) == MDV_OK);
+    mdv_sleep(150);
+    mdv_dispatcher_expire(pd);
+    mu_check(async_state == MDV_ETIMEDOUT);
+
+    mu_check(mdv_dispatcher_read(pd) == MDV_NO_IMPL);       // late response is discarded
+
+    async_state = 0;
+    mu_check(mdv_dispatcher_send_async(pd, &msg, 1000, mdv_dispatcher_response, &async_state) == MDV_OK);
+
     mdv_dispatcher_free(pd);
 
+    mu_check(async_state == MDV_CLOSED);
+
     mdv_eventfd_close(fd);
 }
 
+
+
+enum
+{
+    MDV_TEST_FRAME_ID    = 7,
+    MDV_TEST_FRAME_LARGE = 200 * 1024       // Doesn't fit into the dispatcher receive buffer
+};
+
+
+static size_t mdv_dispatcher_frames_count = 0;
+static bool   mdv_dispatcher_frames_valid = true;
+static size_t mdv_dispatcher_frames_sizes[8];
+
+
+static uint8_t mdv_test_frame_byte(size_t size, size_t i)
+{
+    return (uint8_t)(i * 7 + size);
+}
+
+
+static size_t mdv_test_frame(uint8_t *buf, uint16_t number, uint32_t size)
+{
+    mdv_msghdr const hdr =
+    {
+        .id     = mdv_hton16(MDV_TEST_FRAME_ID),
+        .number = mdv_hton16(number),
+        .size   = mdv_hton32(size)
+    };
+
+    memcpy(buf, &hdr, sizeof hdr);
+
+    for(size_t i = 0; i < size; ++i)
+        buf[sizeof hdr + i] = mdv_test_frame_byte(size, i);
+
+    return sizeof hdr + size;
+}
+
+
+static mdv_errno mdv_dispatcher_frame_handler(mdv_msg const *msg, void *arg)
+{
+    (void)arg;
+
+    uint8_t const *payload = msg->payload;
+
+    for(size_t i = 0; i < msg->hdr.size; ++i)
+    {
+        if (payload[i] != mdv_test_frame_byte(msg->hdr.size, i))
+        {
+            mdv_dispatcher_frames_valid = false;
+            break;
+        }
+    }
+
+    if (mdv_dispatcher_frames_count < sizeof mdv_dispatcher_frames_sizes / sizeof *mdv_dispatcher_frames_sizes)
+        mdv_dispatcher_frames_sizes[mdv_dispatcher_frames_count] = msg->hdr.size;
+
+    mdv_dispatcher_frames_count++;
+
+    return MDV_OK;
+}
+
+
+typedef struct
+{
+    mdv_descriptor  fd;
+    uint8_t const  *data;
+    size_t          size;
+} mdv_test_frames_writer;
+
+
+static void * mdv_test_frames_write(void *arg)
+{
+    mdv_test_frames_writer *writer = arg;
+    mdv_write_all(writer->fd, writer->data, writer->size);
+    return 0;
+}
+
+
+static void mdv_test_frames_reset()
+{
+    mdv_dispatcher_frames_count = 0;
+    mdv_dispatcher_frames_valid = true;
+    memset(mdv_dispatcher_frames_sizes, 0, sizeof mdv_dispatcher_frames_sizes);
+}
+
+
+MU_TEST(platform_dispatcher_frames)
+{
+    static const mdv_dispatcher_handler handler = { MDV_TEST_FRAME_ID, &mdv_dispatcher_frame_handler, 0 };
+
+    mdv_descriptor fds[2];
+    mu_check(mdv_test_socketpair(fds));
+
+    mdv_dispatcher *pd = mdv_dispatcher_create(fds[1]);
+    mu_check(pd);
+    mu_check(mdv_dispatcher_reg(pd, &handler) == MDV_OK);
+
+    size_t const buf_size = 2 * (sizeof(mdv_msghdr) + MDV_TEST_FRAME_LARGE);
+    uint8_t *buf = mdv_alloc(buf_size);
+    mu_check(buf);
+
+    // Header is split between reads
+    mdv_test_frames_reset();
+
+    size_t size = mdv_test_frame(buf, 1, 5);
+
+    mu_check(mdv_write_all(fds[0], buf, 3) == MDV_OK);
+    mu_check(mdv_dispatcher_read(pd) == MDV_OK);
+    mu_check(mdv_dispatcher_frames_count == 0);
+
+    mu_check(mdv_write_all(fds[0], buf + 3, size - 3) == MDV_OK);
+    mu_check(mdv_dispatcher_read(pd) == MDV_OK);
+    mu_check(mdv_dispatcher_frames_count == 1);
+    mu_check(mdv_dispatcher_frames_sizes[0] == 5);
+
+    // Several frames are received by one read, the last one is incomplete
+    mdv_test_frames_reset();
+
+    size = mdv_test_frame(buf, 2, 10);
+    size += mdv_test_frame(buf + size, 3, 0);
+    size += mdv_test_frame(buf + size, 4, 1000);
+
+    size_t const tail = size;
+
+    size += mdv_test_frame(buf + size, 5, 300);
+
+    mu_check(mdv_write_all(fds[0], buf, tail + 100) == MDV_OK);
+    mu_check(mdv_dispatcher_read(pd) == MDV_OK);
+    mu_check(mdv_dispatcher_frames_count == 3);
+
+    mu_check(mdv_write_all(fds[0], buf + tail + 100, size - tail - 100) == MDV_OK);
+    mu_check(mdv_dispatcher_read(pd) == MDV_OK);
+    mu_check(mdv_dispatcher_frames_count == 4);
+
+    mu_check(mdv_dispatcher_frames_sizes[0] == 10);
+    mu_check(mdv_dispatcher_frames_sizes[1] == 0);
+    mu_check(mdv_dispatcher_frames_sizes[2] == 1000);
+    mu_check(mdv_dispatcher_frames_sizes[3] == 300);
+
+    // Large frame received part is moved into the allocated payload
+    mdv_test_frames_reset();
+
+    size = mdv_test_frame(buf, 6, 20);
+    size += mdv_test_frame(buf + size, 7, MDV_TEST_FRAME_LARGE);
+
+    mdv_test_frames_writer writer =
+    {
+        .fd = fds[0],
+        .data = buf,
+        .size = size
+    };
+
+    mdv_thread_attrs attrs =
+    {
+        .stack_size = MDV_THREAD_STACK_SIZE
+    };
+
+    mdv_thread thread;
+    mu_check(mdv_thread_create(&thread, &attrs, &mdv_test_frames_write, &writer) == MDV_OK);
+
+    for(size_t i = 0; i < 64 && mdv_dispatcher_frames_count < 2; ++i)
+        mu_check(mdv_dispatcher_read(pd) == MDV_OK);
+
+    mdv_thread_join(thread);
+
+    mu_check(mdv_dispatcher_frames_count == 2);
+    mu_check(mdv_dispatcher_frames_sizes[0] == 20);
+    mu_check(mdv_dispatcher_frames_sizes[1] == MDV_TEST_FRAME_LARGE);
+
+    // Receive buffer is reused after the large frame
+    size = mdv_test_frame(buf, 8, 42);
+
+    mu_check(mdv_write_all(fds[0], buf, size) == MDV_OK);
+    mu_check(mdv_dispatcher_read(pd) == MDV_OK);
+    mu_check(mdv_dispatcher_frames_count == 3);
+    mu_check(mdv_dispatcher_frames_sizes[2] == 42);
+
+    mu_check(mdv_dispatcher_frames_valid);
+
+    mdv_free(buf);
+
+    mdv_dispatcher_free(pd);
+
+    mdv_descriptor_close(fds[0]);
+    mdv_descriptor_close(fds[1]);
+}
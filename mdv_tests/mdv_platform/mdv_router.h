@@ -147,9 +147,80 @@ void mdv_platform_router_test_2()
 }
 
 
+void mdv_platform_router_test_3()
+{
+    /*
+        Topology:
+              1   4
+             / \ /
+            0   3
+             \ / \
+              2   5
+    */
+
+    mdv_toponode nodes[] =
+    {
+        { .id = 0, .uuid = { .a = 0 }, .addr = "0" },
+        { .id = 1, .uuid = { .a = 1 }, .addr = "1" },
+        { .id = 2, .uuid = { .a = 2 }, .addr = "2" },
+        { .id = 3, .uuid = { .a = 3 }, .addr = "3" },
+        { .id = 4, .uuid = { .a = 4 }, .addr = "4" },
+        { .id = 5, .uuid = { .a = 5 }, .addr = "5" },
+    };
+
+    mdv_topolink links[] =
+    {
+        { .node = { 0, 1 }, .weight = 1 },
+        { .node = { 0, 2 }, .weight = 1 },
+        { .node = { 1, 3 }, .weight = 1 },
+        { .node = { 2, 3 }, .weight = 1 },
+        { .node = { 3, 4 }, .weight = 1 },
+        { .node = { 3, 5 }, .weight = 1 },
+    };
+
+    // Next hops from each node to each destination
+    uint32_t const hops[][6] =
+    {
+        { 0xff, 1, 2, 1, 1, 1 },    // 0 -> { 1, 2, 3, 4, 5 }
+        { 0, 0xff, 0, 3, 3, 3 },    // 1 -> { 0, 2, 3, 4, 5 }
+        { 0, 0, 0xff, 0, 0, 0 },    // 2 -> { 0, 1, 3, 4, 5 }
+        { 1, 1, 1, 0xff, 4, 5 },    // 3 -> { 0, 1, 2, 4, 5 }
+        { 3, 3, 3, 3, 0xff, 3 },    // 4 -> { 0, 1, 2, 3, 5 }
+        { 3, 3, 3, 3, 3, 0xff },    // 5 -> { 0, 1, 2, 3, 4 }
+    };
+
+    size_t const nsize = sizeof nodes / sizeof *nodes;
+
+    mdv_topology *topology = mdv_test_router_topology_create(nodes, nsize,
+                                                             links, sizeof links / sizeof *links);
+
+    for(size_t i = 0; i < nsize; ++i)
+    {
+        mdv_hashmap *nexthops = mdv_nexthops_find(topology, &nodes[i].uuid);
+
+        mu_check(mdv_hashmap_size(nexthops) == nsize - 1);
+
+        for(size_t j = 0; j < nsize; ++j)
+        {
+            mdv_nexthop const *hop = mdv_hashmap_find(nexthops, &nodes[j].uuid);
+
+            if (hops[i][j] == 0xff)
+                mu_check(!hop);
+            else
+                mu_check(hop && mdv_uuid_cmp(&hop->hop, &nodes[hops[i][j]].uuid) == 0);
+        }
+
+        mdv_hashmap_release(nexthops);
+    }
+
+    mdv_topology_release(topology);
+}
+
+
 MU_TEST(platform_router)
 {
     mdv_platform_router_test_1();
     mdv_platform_router_test_2();
+    mdv_platform_router_test_3();
 }
 
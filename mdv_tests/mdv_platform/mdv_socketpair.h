@@ -0,0 +1,31 @@
+#pragma once
+#include <mdv_def.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string.h>
+
+
+/// Creates connected pair of local stream sockets
+static bool mdv_test_socketpair(mdv_descriptor fds[2])
+{
+    int sv[2];
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0)
+        return false;
+
+    for(int i = 0; i < 2; ++i)
+    {
+        fds[i] = 0;
+        memcpy(&fds[i], sv + i, sizeof *sv);
+    }
+
+    return true;
+}
+
+
+static int mdv_test_socket(mdv_descriptor fd)
+{
+    int s;
+    memcpy(&s, &fd, sizeof s);
+    return s;
+}
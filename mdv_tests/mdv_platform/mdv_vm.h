@@ -1,6 +1,7 @@
 #pragma once
 #include <minunit.h>
 #include <mdv_vm.h>
+#include <math.h>
 
 
 static void mdv_platform_vmop_equal()
@@ -541,6 +542,114 @@ static void mdv_platform_vmop_not()
 }
 
 
+static void mdv_platform_vm_run_args()
+{
+    mdv_stack(char, 256) st;
+
+    mdv_stack_base *stack = (mdv_stack_base *)&st;
+
+    mdv_vm_fn const fns[] = { mdv_vmop_equal };
+
+    mdv_vm_datum const args[] =
+    {
+        { .size = 4, .data = "1234" },
+        { .size = 4, .data = "1234" },
+    };
+
+    uint8_t const program[] =
+    {
+        MDV_VM_ARG, 0, 0,
+        MDV_VM_ARG, 1, 0,
+        MDV_VM_CALL, 0, 0,
+        MDV_VM_END
+    };
+
+    uint8_t const invalid_program[] =
+    {
+        MDV_VM_ARG, 2, 0,
+        MDV_VM_END
+    };
+
+    bool res = false;
+
+    mdv_stack_clear(st);
+    mu_check(mdv_vm_run(stack, fns, 1, args, 2, program) == MDV_OK);
+    mu_check(mdv_vm_result_as_bool(stack, &res) == MDV_OK && res == true);
+
+    mdv_stack_clear(st);
+    mu_check(mdv_vm_run(stack, fns, 1, args, 2, invalid_program) == MDV_INVALID_ARG);
+}
+
+
+/// Runs the comparison program and checks whether it succeeds with the expected result
+static bool mdv_platform_vm_cmp(mdv_vm_type type, mdv_vm_cmp_op op,
+                                void const *lhs, uint32_t lhs_size,
+                                void const *rhs, uint32_t rhs_size,
+                                bool expected)
+{
+    mdv_stack(char, 256) st;
+    mdv_stack_clear(st);
+
+    mdv_stack_base *stack = (mdv_stack_base *)&st;
+
+    mdv_vm_datum const args[] =
+    {
+        { .size = lhs_size, .data = lhs },
+        { .size = rhs_size, .data = rhs },
+    };
+
+    uint8_t const program[] =
+    {
+        MDV_VM_ARG, 0, 0,
+        MDV_VM_ARG, 1, 0,
+        MDV_VM_CMP, type, op,
+        MDV_VM_END
+    };
+
+    bool res = !expected;
+
+    return mdv_vm_run(stack, 0, 0, args, 2, program) == MDV_OK
+            && mdv_vm_result_as_bool(stack, &res) == MDV_OK
+            && res == expected;
+}
+
+
+static void mdv_platform_vm_run_cmp()
+{
+    int32_t const i32[] = { -1, 256, 1 };
+    uint32_t const u32[] = { 1, 256 };
+    int64_t const i64[] = { INT64_MIN, 0 };
+    float const f[] = { -0.5f, 0.25f, NAN };
+    double const d[] = { 1e-3, 1e3 };
+    bool const b[] = { true, false };
+    uint8_t const true_value = 0xFF;
+
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_INT32,  MDV_VM_CMP_LT, i32,     4, i32 + 2, 4, true));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_INT32,  MDV_VM_CMP_GT, i32 + 1, 4, i32 + 2, 4, true));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_INT32,  MDV_VM_CMP_LE, i32 + 2, 4, i32 + 2, 4, true));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_UINT32, MDV_VM_CMP_LT, u32,     4, u32 + 1, 4, true));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_UINT32, MDV_VM_CMP_GE, u32 + 1, 4, u32,     4, true));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_INT64,  MDV_VM_CMP_LT, i64,     8, i64 + 1, 8, true));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_FLOAT,  MDV_VM_CMP_LT, f,       4, f + 1,   4, true));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_DOUBLE, MDV_VM_CMP_GT, d + 1,   8, d,       8, true));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_DOUBLE, MDV_VM_CMP_NE, d + 1,   8, d,       8, true));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_BOOL,   MDV_VM_CMP_EQ, b,       1, &true_value, 1, true));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_BOOL,   MDV_VM_CMP_GT, b,       1, b + 1,   1, true));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_BYTES,  MDV_VM_CMP_LT, "ab",    2, "abc",   3, true));
+
+    // NaN is unordered
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_FLOAT,  MDV_VM_CMP_EQ, f + 2, 4, f + 2, 4, false));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_FLOAT,  MDV_VM_CMP_GE, f + 2, 4, f,     4, false));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_FLOAT,  MDV_VM_CMP_LE, f + 2, 4, f,     4, false));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_FLOAT,  MDV_VM_CMP_NE, f + 2, 4, f,     4, true));
+
+    // Arrays are compared lexicographically
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_INT32,  MDV_VM_CMP_LT, i32,     8, i32,     12, true));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_INT32,  MDV_VM_CMP_LT, i32,     12, i32 + 1, 4, true));
+    mu_check(mdv_platform_vm_cmp(MDV_VM_TYPE_INT32,  MDV_VM_CMP_EQ, i32,     12, i32,    12, true));
+}
+
+
 MU_TEST(platform_vm)
 {
     mdv_platform_vmop_equal();              // "a" == "b"
@@ -552,4 +661,6 @@ MU_TEST(platform_vm)
     mdv_platform_vmop_and();                // a & b
     mdv_platform_vmop_or();                 // a | b
     mdv_platform_vmop_not();                // !a
+    mdv_platform_vm_run_args();             // ARG 0, ARG 1, CALL ==
+    mdv_platform_vm_run_cmp();              // ARG 0, ARG 1, CMP Type Op
 }
@@ -0,0 +1,105 @@
+#pragma once
+#include <minunit.h>
+#include <mdv_def.h>
+#include <mdv_threads.h>
+#include <mdv_alloc.h>
+#include "mdv_socketpair.h"
+
+
+enum
+{
+    MDV_TEST_WRITEV_BUFS = 3 * MDV_IOV_MAX + 5,     // More buffers than writev() takes at once
+    MDV_TEST_WRITEV_SIZE = 1024 * 1024
+};
+
+
+typedef struct
+{
+    mdv_descriptor  fd;
+    uint8_t        *data;
+    size_t          size;
+} mdv_test_writev_reader;
+
+
+static void * mdv_test_writev_read(void *arg)
+{
+    mdv_test_writev_reader *reader = arg;
+
+    for(;;)
+    {
+        size_t len = 333;           // Odd chunks size splits the buffers in the middle
+
+        if (reader->size + len > MDV_TEST_WRITEV_SIZE)
+            len = MDV_TEST_WRITEV_SIZE - reader->size;
+
+        if (!len || mdv_read(reader->fd, reader->data + reader->size, &len) != MDV_OK)
+            break;
+
+        reader->size += len;
+    }
+
+    return 0;
+}
+
+
+MU_TEST(platform_writev_all)
+{
+    mdv_descriptor fds[2];
+    mu_check(mdv_test_socketpair(fds));
+
+    mdv_descriptor const wfd = fds[0], rfd = fds[1];
+
+    // Small socket buffer makes writev() write buffers partially
+    int const sndbuf = 4096;
+    mu_check(setsockopt(mdv_test_socket(wfd), SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof sndbuf) == 0);
+
+    uint8_t *src = mdv_alloc(MDV_TEST_WRITEV_SIZE);
+    uint8_t *dst = mdv_alloc(MDV_TEST_WRITEV_SIZE);
+    mu_check(src && dst);
+
+    for(size_t i = 0; i < MDV_TEST_WRITEV_SIZE; ++i)
+        src[i] = (uint8_t)(i * 31 + i / 251);
+
+    mdv_iovec iov[MDV_TEST_WRITEV_BUFS];
+    size_t total = 0;
+
+    for(size_t i = 0; i < MDV_TEST_WRITEV_BUFS; ++i)
+    {
+        size_t const size = i % 7 == 3 ? 0 : 1 + (i * 2711) % 5003;     // Empty buffers are skipped
+        iov[i].ptr = src + total;
+        iov[i].size = size;
+        total += size;
+    }
+
+    mu_check(total <= MDV_TEST_WRITEV_SIZE);
+
+    mdv_test_writev_reader reader =
+    {
+        .fd = rfd,
+        .data = dst,
+        .size = 0
+    };
+
+    mdv_thread_attrs attrs =
+    {
+        .stack_size = MDV_THREAD_STACK_SIZE
+    };
+
+    mdv_thread thread;
+    mu_check(mdv_thread_create(&thread, &attrs, &mdv_test_writev_read, &reader) == MDV_OK);
+
+    mu_check(mdv_writev_all(wfd, iov, MDV_TEST_WRITEV_BUFS) == MDV_OK);
+
+    shutdown(mdv_test_socket(wfd), SHUT_WR);
+
+    mdv_thread_join(thread);
+
+    mu_check(reader.size == total);
+    mu_check(memcmp(src, dst, total) == 0);
+
+    mdv_free(src);
+    mdv_free(dst);
+
+    mdv_descriptor_close(wfd);
+    mdv_descriptor_close(rfd);
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include "mdv_storage/mdv_predicate.h"
 #include "mdv_storage/mdv_paginator.h"
+#include "mdv_storage/mdv_index.h"
+#include "mdv_storage/mdv_2pset.h"
 #include "mdv_storage/ops/mdv_scan_seq.h"
 #include "mdv_storage/ops/mdv_project.h"
 #include "mdv_storage/ops/mdv_select.h"
@@ -10,6 +12,9 @@ MU_TEST_SUITE(storage)
 {
     MU_RUN_TEST(storage_predicate);
     MU_RUN_TEST(storage_paginator);
+    MU_RUN_TEST(storage_index);
+    MU_RUN_TEST(storage_2pset_tombstones);
+    MU_RUN_TEST(storage_2pset_marks);
     MU_RUN_TEST(op_scan_seq);
     MU_RUN_TEST(op_project_range);
     MU_RUN_TEST(op_project_by_indices);
@@ -0,0 +1,164 @@
+#pragma once
+#include <minunit.h>
+#include <mdv_index.h>
+#include <mdv_2pset.h>
+#include <mdv_filesystem.h>
+#include <string.h>
+
+
+static size_t mdv_test_2pset_key(void *arg, uint32_t index, mdv_data const *obj, uint8_t *key)
+{
+    (void)arg;
+    (void)index;
+    return mdv_index_key(MDV_FLD_TYPE_INT32, obj->ptr, obj->size, key);
+}
+
+
+static bool mdv_test_2pset_removed_next(void *arg, mdv_data *id)
+{
+    uint32_t const **removed = arg;
+
+    if (!*removed)
+        return false;
+
+    id->size = sizeof **removed;
+    id->ptr = (void*)*removed;
+
+    *removed = 0;               // only one object is removed
+
+    return true;
+}
+
+
+static bool mdv_test_2pset_purgeable(void *arg, mdv_data const *tombstone)
+{
+    (void)arg;
+    return tombstone->size == sizeof(uint64_t)
+            && *(uint64_t const *)tombstone->ptr == 1;
+}
+
+
+static bool mdv_test_2pset_not_purgeable(void *arg, mdv_data const *tombstone)
+{
+    (void)arg;
+    (void)tombstone;
+    return false;
+}
+
+
+static size_t mdv_test_2pset_index_count(mdv_2pset *objs, mdv_data const *start)
+{
+    size_t n = 0;
+
+    mdv_enumerator *enumerator = mdv_2pset_index_enumerator(objs, 0, start);
+
+    if (enumerator)
+    {
+        do ++n;
+        while(mdv_enumerator_next(enumerator) == MDV_OK);
+
+        mdv_enumerator_release(enumerator);
+    }
+
+    return n;
+}
+
+
+MU_TEST(storage_2pset_tombstones)
+{
+    mdv_2pset_indexes const indexes =
+    {
+        .count = 1,
+        .arg = 0,
+        .key = mdv_test_2pset_key
+    };
+
+    mdv_2pset *objs = mdv_2pset_open_indexed("./test_2pset", "2pset", &indexes);
+    mu_check(objs);
+
+    int32_t const values[] = { 5, -3, 42 };
+
+    for(uint32_t i = 0; i < sizeof values / sizeof *values; ++i)
+    {
+        mdv_data const id = { sizeof i, (void*)&i };
+        mdv_data const obj = { sizeof *values, (void*)(values + i) };
+        mu_check(mdv_2pset_add(objs, &id, &obj) == MDV_OK);
+    }
+
+    int32_t const from = INT32_MIN;
+    uint8_t key[MDV_INDEX_KEY_MAX];
+
+    mdv_data const start =
+    {
+        .size = mdv_index_key(MDV_FLD_TYPE_INT32, &from, sizeof from, key),
+        .ptr = key
+    };
+
+    mu_check(mdv_test_2pset_index_count(objs, &start) == 3);
+
+    // Removed objects are never added again
+    uint32_t const removed_id = 2;
+    uint32_t const *removed = &removed_id;
+    uint64_t const removed_pos = 1;
+    mdv_data const tombstone = { sizeof removed_pos, (void*)&removed_pos };
+    mu_check(mdv_2pset_remove_batch(objs, &tombstone, &removed, mdv_test_2pset_removed_next) == MDV_OK);
+
+    mu_check(mdv_test_2pset_index_count(objs, &start) == 2);
+
+    mdv_data const id = { sizeof removed_id, (void*)&removed_id };
+    mdv_data const obj = { sizeof *values, (void*)(values + removed_id) };
+    mu_check(mdv_2pset_add(objs, &id, &obj) == MDV_OK);
+
+    mu_check(mdv_test_2pset_index_count(objs, &start) == 2);
+
+    // Object can be added again after the tombstone purging
+    size_t purged = 0;
+    mu_check(mdv_2pset_purge(objs, 16, 0, mdv_test_2pset_not_purgeable, &purged) == MDV_OK);
+    mu_check(purged == 0);
+    mu_check(mdv_2pset_purge(objs, 16, 0, mdv_test_2pset_purgeable, &purged) == MDV_OK);
+    mu_check(purged == 1);
+    mu_check(mdv_2pset_add(objs, &id, &obj) == MDV_OK);
+
+    mu_check(mdv_test_2pset_index_count(objs, &start) == 3);
+
+    mdv_2pset_release(objs);
+    mdv_rmdir("./test_2pset");
+}
+
+
+MU_TEST(storage_2pset_marks)
+{
+    mdv_2pset *objs = mdv_2pset_open("./test_2pset", "2pset");
+    mu_check(objs);
+
+    // Marks are saved within the batch transaction
+    uint64_t const mark_key = 42;
+    uint64_t mark = 0;
+
+    mdv_data const mkey = { sizeof mark_key, (void*)&mark_key };
+    mdv_data mvalue = { sizeof mark, &mark };
+
+    mdv_2pset_batch *batch = mdv_2pset_batch_begin(objs);
+    mu_check(batch);
+    mu_check(!mdv_2pset_batch_mark_get(batch, &mkey, &mvalue));
+    mark = 100;
+    mu_check(mdv_2pset_batch_mark_set(batch, &mkey, &mvalue) == MDV_OK);
+    mdv_2pset_batch_abort(batch);
+
+    batch = mdv_2pset_batch_begin(objs);
+    mu_check(batch);
+    mu_check(!mdv_2pset_batch_mark_get(batch, &mkey, &mvalue));
+    mark = 200;
+    mu_check(mdv_2pset_batch_mark_set(batch, &mkey, &mvalue) == MDV_OK);
+    mu_check(mdv_2pset_batch_commit(batch) == MDV_OK);
+
+    mark = 0;
+    batch = mdv_2pset_batch_begin(objs);
+    mu_check(batch);
+    mu_check(mdv_2pset_batch_mark_get(batch, &mkey, &mvalue));
+    mu_check(mark == 200);
+    mdv_2pset_batch_abort(batch);
+
+    mdv_2pset_release(objs);
+    mdv_rmdir("./test_2pset");
+}
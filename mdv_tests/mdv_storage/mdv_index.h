@@ -0,0 +1,228 @@
+#pragma once
+#include <minunit.h>
+#include <mdv_index.h>
+#include <mdv_2pset.h>
+#include <mdv_filesystem.h>
+#include <string.h>
+
+
+static int mdv_test_index_key_cmp(mdv_field_type type, void const *a, void const *b, size_t size)
+{
+    uint8_t key_a[MDV_INDEX_KEY_MAX], key_b[MDV_INDEX_KEY_MAX];
+
+    size_t const a_size = mdv_index_key(type, a, size, key_a);
+    size_t const b_size = mdv_index_key(type, b, size, key_b);
+
+    return mdv_index_key_cmp(key_a, a_size, key_b, b_size);
+}
+
+
+static void mdv_storage_index_keys()
+{
+    int32_t const i32[] = { INT32_MIN, -100, -1, 0, 1, 100, INT32_MAX };
+
+    for(size_t i = 1; i < sizeof i32 / sizeof *i32; ++i)
+        mu_check(mdv_test_index_key_cmp(MDV_FLD_TYPE_INT32, i32 + i - 1, i32 + i, sizeof *i32) < 0);
+
+    uint16_t const u16[] = { 0, 1, 255, 256, UINT16_MAX };
+
+    for(size_t i = 1; i < sizeof u16 / sizeof *u16; ++i)
+        mu_check(mdv_test_index_key_cmp(MDV_FLD_TYPE_UINT16, u16 + i - 1, u16 + i, sizeof *u16) < 0);
+
+    double const d[] = { -1e300, -2.5, -0.5, 0.0, 0.5, 2.5, 1e300 };
+
+    for(size_t i = 1; i < sizeof d / sizeof *d; ++i)
+        mu_check(mdv_test_index_key_cmp(MDV_FLD_TYPE_DOUBLE, d + i - 1, d + i, sizeof *d) < 0);
+
+    double const zero = 0.0, neg_zero = -0.0;
+    mu_check(mdv_test_index_key_cmp(MDV_FLD_TYPE_DOUBLE, &zero, &neg_zero, sizeof zero) == 0);
+
+    uint8_t key_a[MDV_INDEX_KEY_MAX], key_b[MDV_INDEX_KEY_MAX];
+    size_t const a_size = mdv_index_key(MDV_FLD_TYPE_CHAR, "bear", 4, key_a);
+    size_t const b_size = mdv_index_key(MDV_FLD_TYPE_CHAR, "bee", 3, key_b);
+    mu_check(mdv_index_key_cmp(key_a, a_size, key_b, b_size) < 0);
+    mu_check(mdv_index_key_cmp(key_a, a_size - 1, key_a, a_size) < 0);
+
+    // Keys are prefix-free
+    char const *strs[] = { "ab", "ab\0", "ab\0\0", "ab\x01", "ab\x03", "abc", "ab\xff" };
+    size_t const strs_size[] = { 2, 3, 4, 3, 3, 3, 3 };
+
+    for(size_t i = 1; i < sizeof strs / sizeof *strs; ++i)
+    {
+        size_t const prev_size = mdv_index_key(MDV_FLD_TYPE_CHAR, strs[i - 1], strs_size[i - 1], key_a);
+        size_t const next_size = mdv_index_key(MDV_FLD_TYPE_CHAR, strs[i], strs_size[i], key_b);
+        mu_check(mdv_index_key_cmp(key_a, prev_size, key_b, next_size) < 0);
+        mu_check(memcmp(key_a, key_b, prev_size < next_size ? prev_size : next_size) != 0);
+    }
+
+    int32_t const arr_a[] = { 1 }, arr_b[] = { 1, -1 };
+    mu_check(mdv_test_index_key_cmp(MDV_FLD_TYPE_INT32, arr_a, arr_b, sizeof arr_a) == 0);
+    size_t const arr_a_size = mdv_index_key(MDV_FLD_TYPE_INT32, arr_a, sizeof arr_a, key_a);
+    size_t const arr_b_size = mdv_index_key(MDV_FLD_TYPE_INT32, arr_b, sizeof arr_b, key_b);
+    mu_check(memcmp(key_a, key_b, arr_a_size) != 0);
+    mu_check(mdv_index_key_cmp(key_a, arr_a_size, key_b, arr_b_size) < 0);
+
+    // Truncated keys keep the ordering
+    char long_a[512], long_b[512];
+    memset(long_a, 'x', sizeof long_a);
+    memset(long_b, 'x', sizeof long_b);
+    long_b[sizeof long_b - 1] = 'y';
+
+    size_t const long_a_size = mdv_index_key(MDV_FLD_TYPE_CHAR, long_a, sizeof long_a, key_a);
+    size_t const long_b_size = mdv_index_key(MDV_FLD_TYPE_CHAR, long_b, sizeof long_b, key_b);
+    mu_check(long_a_size <= MDV_INDEX_KEY_MAX);
+    mu_check(mdv_index_key_cmp(key_a, long_a_size, key_b, long_b_size) == 0);
+
+    for(size_t n = 100; n < sizeof long_a; n += 7)
+    {
+        size_t const short_size = mdv_index_key(MDV_FLD_TYPE_CHAR, long_a, n, key_b);
+        mu_check(mdv_index_key_cmp(key_b, short_size, key_a, long_a_size) <= 0);
+    }
+
+    long_b[50] = 'w';
+    size_t const less_size = mdv_index_key(MDV_FLD_TYPE_CHAR, long_b, 60, key_b);
+    mu_check(mdv_index_key_cmp(key_b, less_size, key_a, long_a_size) < 0);
+}
+
+
+static size_t mdv_test_index_key(void *arg, uint32_t index, mdv_data const *obj, uint8_t *key)
+{
+    (void)arg;
+    (void)index;
+    return mdv_index_key(MDV_FLD_TYPE_INT32, obj->ptr, obj->size, key);
+}
+
+
+static void mdv_storage_index_scan()
+{
+    mdv_2pset_indexes const indexes =
+    {
+        .count = 1,
+        .arg = 0,
+        .key = mdv_test_index_key
+    };
+
+    mdv_2pset *objs = mdv_2pset_open_indexed("./test_index", "index", &indexes);
+    mu_check(objs);
+
+    int32_t const values[] = { 5, -3, 42, 0, -3, 7 };
+
+    for(uint32_t i = 0; i < sizeof values / sizeof *values; ++i)
+    {
+        mdv_data const id = { sizeof i, (void*)&i };
+        mdv_data const obj = { sizeof *values, (void*)(values + i) };
+        mu_check(mdv_2pset_add(objs, &id, &obj) == MDV_OK);
+    }
+
+    int32_t const from = 0;
+    uint8_t key[MDV_INDEX_KEY_MAX];
+
+    mdv_data const start =
+    {
+        .size = mdv_index_key(MDV_FLD_TYPE_INT32, &from, sizeof from, key),
+        .ptr = key
+    };
+
+    int32_t const expected[] = { 0, 5, 7, 42 };
+    size_t n = 0;
+
+    mdv_enumerator *enumerator = mdv_2pset_index_enumerator(objs, 0, &start);
+    mu_check(enumerator);
+
+    do
+    {
+        mdv_kvdata const *entry = mdv_enumerator_current(enumerator);
+        mu_check(n < sizeof expected / sizeof *expected);
+        mu_check(*(int32_t const *)entry->value.ptr == expected[n++]);
+    }
+    while(mdv_enumerator_next(enumerator) == MDV_OK);
+
+    mu_check(n == sizeof expected / sizeof *expected);
+
+    mdv_enumerator_release(enumerator);
+
+    mdv_2pset_release(objs);
+    mdv_rmdir("./test_index");
+}
+
+
+static size_t mdv_test_index_str_key(void *arg, uint32_t index, mdv_data const *obj, uint8_t *key)
+{
+    (void)arg;
+    (void)index;
+    return mdv_index_key(MDV_FLD_TYPE_CHAR, obj->ptr, obj->size, key);
+}
+
+
+static void mdv_storage_index_str_scan()
+{
+    mdv_2pset_indexes const indexes =
+    {
+        .count = 1,
+        .arg = 0,
+        .key = mdv_test_index_str_key
+    };
+
+    mdv_2pset *objs = mdv_2pset_open_indexed("./test_index", "index", &indexes);
+    mu_check(objs);
+
+    // Identifiers first bytes are greater than the string extension
+    struct { uint32_t id; char const *str; size_t size; } const rows[] =
+    {
+        { 0x10, "ab\x03", 3 },
+        { 0xF0, "ab",     2 },
+        { 0xF1, "ab\x03", 3 },
+        { 0xF2, "ab",     2 },
+        { 0x04, "ab",     2 },
+        { 0xF3, "a",      1 },
+    };
+
+    for(size_t i = 0; i < sizeof rows / sizeof *rows; ++i)
+    {
+        mdv_data const id = { sizeof rows[i].id, (void*)&rows[i].id };
+        mdv_data const obj = { rows[i].size, (void*)rows[i].str };
+        mu_check(mdv_2pset_add(objs, &id, &obj) == MDV_OK);
+    }
+
+    // Equality scan finds all rows with the given value
+    uint8_t key[MDV_INDEX_KEY_MAX];
+
+    mdv_data const start =
+    {
+        .size = mdv_index_key(MDV_FLD_TYPE_CHAR, "ab", 2, key),
+        .ptr = key
+    };
+
+    size_t const expected_sizes[] = { 2, 2, 2, 3, 3 };
+    size_t n = 0, equal = 0;
+
+    mdv_enumerator *enumerator = mdv_2pset_index_enumerator(objs, 0, &start);
+    mu_check(enumerator);
+
+    do
+    {
+        mdv_kvdata const *entry = mdv_enumerator_current(enumerator);
+        mu_check(n < sizeof expected_sizes / sizeof *expected_sizes);
+        mu_check(entry->value.size == expected_sizes[n++]);
+
+        if (mdv_index_key_cmp(entry->key.ptr, entry->key.size - sizeof(uint32_t), start.ptr, start.size) == 0)
+            ++equal;
+    }
+    while(mdv_enumerator_next(enumerator) == MDV_OK);
+
+    mu_check(n == sizeof expected_sizes / sizeof *expected_sizes);
+    mu_check(equal == 3);
+
+    mdv_enumerator_release(enumerator);
+
+    mdv_2pset_release(objs);
+    mdv_rmdir("./test_index");
+}
+
+
+MU_TEST(storage_index)
+{
+    mdv_storage_index_keys();
+    mdv_storage_index_scan();
+    mdv_storage_index_str_scan();
+}
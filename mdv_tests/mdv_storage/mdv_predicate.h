@@ -4,9 +4,74 @@
 #include <mdv_vm.h>
 
 
+static mdv_field const mdv_test_predicate_fields[] =
+{
+    { MDV_FLD_TYPE_INT32,  1, "id" },
+    { MDV_FLD_TYPE_CHAR,   0, "name" },
+    { MDV_FLD_TYPE_BOOL,   1, "active" },
+    { MDV_FLD_TYPE_DOUBLE, 1, "score" },
+    { MDV_FLD_TYPE_INT32,  1, "parent id" },
+};
+
+
+static mdv_table_desc const mdv_test_predicate_desc =
+{
+    .name = "predicate_test",
+    .size = sizeof mdv_test_predicate_fields / sizeof *mdv_test_predicate_fields,
+    .fields = mdv_test_predicate_fields
+};
+
+
+typedef struct
+{
+    int32_t     id;
+    char const *name;
+    bool        active;
+    double      score;
+    int32_t     parent_id;
+} mdv_test_predicate_row;
+
+
+static int mdv_test_predicate_eval(char const *expression, mdv_test_predicate_row const *row)
+{
+    mdv_predicate *predicate = mdv_predicate_parse(&mdv_test_predicate_desc, expression);
+
+    if (!predicate)
+        return -1;
+
+    mdv_vm_datum const args[] =
+    {
+        { .size = sizeof row->id,           .data = &row->id },
+        { .size = strlen(row->name),        .data = row->name },
+        { .size = sizeof row->active,       .data = &row->active },
+        { .size = sizeof row->score,        .data = &row->score },
+        { .size = sizeof row->parent_id,    .data = &row->parent_id },
+    };
+
+    mdv_stack(uint8_t, 256) stack;
+    mdv_stack_clear(stack);
+
+    bool res = false;
+
+    mdv_errno err = mdv_vm_run((mdv_stack_base*)&stack,
+                               mdv_predicate_fns(predicate),
+                               mdv_predicate_fns_count(predicate),
+                               args,
+                               sizeof args / sizeof *args,
+                               mdv_predicate_expr(predicate));
+
+    if (err == MDV_OK)
+        err = mdv_vm_result_as_bool((mdv_stack_base*)&stack, &res);
+
+    mdv_predicate_release(predicate);
+
+    return err == MDV_OK ? res : -1;
+}
+
+
 static void mdv_storage_predicate_test_0()
 {
-    mdv_predicate *predicate = mdv_predicate_parse("");
+    mdv_predicate *predicate = mdv_predicate_parse(0, "");
     mu_check(predicate);
 
     mdv_stack(uint8_t, 64) stack;
@@ -15,6 +80,7 @@ static void mdv_storage_predicate_test_0()
     mu_check(mdv_vm_run((mdv_stack_base*)&stack,
                         mdv_predicate_fns(predicate),
                         mdv_predicate_fns_count(predicate),
+                        0, 0,
                         mdv_predicate_expr(predicate)) == MDV_OK);
 
     bool res = false;
@@ -25,7 +91,155 @@ static void mdv_storage_predicate_test_0()
 }
 
 
+static void mdv_storage_predicate_test_1()
+{
+    mdv_test_predicate_row const row =
+    {
+        .id = 42,
+        .name = "bear",
+        .active = true,
+        .score = 0.5,
+        .parent_id = 42
+    };
+
+    // Comparisons
+    mu_check(mdv_test_predicate_eval("id = 42", &row) == 1);
+    mu_check(mdv_test_predicate_eval("id == 43", &row) == 0);
+    mu_check(mdv_test_predicate_eval("42 = id", &row) == 1);
+    mu_check(mdv_test_predicate_eval("id != 42", &row) == 0);
+    mu_check(mdv_test_predicate_eval("id <> 41", &row) == 1);
+    mu_check(mdv_test_predicate_eval("name = 'bear'", &row) == 1);
+    mu_check(mdv_test_predicate_eval("name = 'bea'", &row) == 0);
+    mu_check(mdv_test_predicate_eval("name < 'beas'", &row) == 1);
+    mu_check(mdv_test_predicate_eval("name > 'bea'", &row) == 1);
+    mu_check(mdv_test_predicate_eval("name >= 'bear'", &row) == 1);
+    mu_check(mdv_test_predicate_eval("name <= 'bear'", &row) == 1);
+    mu_check(mdv_test_predicate_eval("score = 0.5", &row) == 1);
+    mu_check(mdv_test_predicate_eval("score = 5e-1", &row) == 1);
+    mu_check(mdv_test_predicate_eval("id > -1", &row) == 1);
+    mu_check(mdv_test_predicate_eval("id < 256", &row) == 1);
+    mu_check(mdv_test_predicate_eval("id >= 300", &row) == 0);
+    mu_check(mdv_test_predicate_eval("score > 0.25", &row) == 1);
+    mu_check(mdv_test_predicate_eval("score < 2", &row) == 1);
+    mu_check(mdv_test_predicate_eval("score <= -1", &row) == 0);
+    mu_check(mdv_test_predicate_eval("-1.5 < 2", &row) == 1);
+    mu_check(mdv_test_predicate_eval("id = \"parent id\"", &row) == 1);
+    mu_check(mdv_test_predicate_eval("1 = 1", &row) == 1);
+    mu_check(mdv_test_predicate_eval("'a''b' = 'a''b'", &row) == 1);
+
+    // Boolean fields and literals
+    mu_check(mdv_test_predicate_eval("active", &row) == 1);
+    mu_check(mdv_test_predicate_eval("NOT active", &row) == 0);
+    mu_check(mdv_test_predicate_eval("active = TRUE", &row) == 1);
+    mu_check(mdv_test_predicate_eval("true", &row) == 1);
+    mu_check(mdv_test_predicate_eval("FALSE", &row) == 0);
+
+    // Logical operations
+    mu_check(mdv_test_predicate_eval("id = 42 AND name = 'bear'", &row) == 1);
+    mu_check(mdv_test_predicate_eval("id = 42 and name = 'wolf'", &row) == 0);
+    mu_check(mdv_test_predicate_eval("id = 1 OR name = 'bear'", &row) == 1);
+    mu_check(mdv_test_predicate_eval("id = 1 or name = 'wolf'", &row) == 0);
+    mu_check(mdv_test_predicate_eval("not (id = 1 or name = 'wolf')", &row) == 1);
+    mu_check(mdv_test_predicate_eval("id = 1 OR id = 42 AND NOT active", &row) == 0);
+    mu_check(mdv_test_predicate_eval("(id = 1 OR id = 42) AND active", &row) == 1);
+    mu_check(mdv_test_predicate_eval("NOT NOT active", &row) == 1);
+}
+
+
+static void mdv_storage_predicate_test_2()
+{
+    mdv_test_predicate_row const row = { .name = "" };
+
+    // Invalid expressions
+    mu_check(mdv_test_predicate_eval("id", &row) == -1);
+    mu_check(mdv_test_predicate_eval("id =", &row) == -1);
+    mu_check(mdv_test_predicate_eval("id = 1 AND", &row) == -1);
+    mu_check(mdv_test_predicate_eval("(id = 1", &row) == -1);
+    mu_check(mdv_test_predicate_eval("id = 1)", &row) == -1);
+    mu_check(mdv_test_predicate_eval("unknown = 1", &row) == -1);
+    mu_check(mdv_test_predicate_eval("id = 'abc'", &row) == -1);
+    mu_check(mdv_test_predicate_eval("id = 1.5", &row) == -1);
+    mu_check(mdv_test_predicate_eval("id = 4294967296", &row) == -1);
+    mu_check(mdv_test_predicate_eval("id = name", &row) == -1);
+    mu_check(mdv_test_predicate_eval("name = 'abc", &row) == -1);
+    mu_check(mdv_test_predicate_eval("1 = 'a'", &row) == -1);
+    mu_check(mdv_test_predicate_eval("id = 1 # 2", &row) == -1);
+
+    mu_check(mdv_predicate_parse(0, "id = 1") == 0);
+}
+
+
+static void mdv_storage_predicate_test_3()
+{
+    binn *row = binn_list();
+    binn_list_add_int32(row, 42);
+    binn_list_add_blob(row, "bear", 4);
+    binn_list_add_bool(row, true);
+    binn_list_add_double(row, 0.5);
+    binn_list_add_int32(row, 7);
+
+    binn obj;
+    mu_check(binn_load(binn_ptr(row), &obj));
+
+    mdv_stack(char, 256) stack;
+    mdv_stack_clear(stack);
+
+    char const *expressions[] =
+    {
+        "id = 42 AND name = 'bear'",
+        "active AND score = 0.5",
+        "\"parent id\" = 7",
+        "name = 'wolf' OR id = 1",
+    };
+
+    mdv_errno const results[] = { MDV_OK, MDV_OK, MDV_OK, MDV_FALSE };
+
+    for(size_t i = 0; i < sizeof expressions / sizeof *expressions; ++i)
+    {
+        mdv_predicate *predicate = mdv_predicate_parse(&mdv_test_predicate_desc, expressions[i]);
+        mu_check(predicate);
+        mu_check(mdv_predicate_eval(predicate, (mdv_stack_base*)&stack, &obj) == results[i]);
+        mdv_predicate_release(predicate);
+    }
+
+    binn_free(&obj);
+    binn_free(row);
+}
+
+
+static void mdv_storage_predicate_test_4()
+{
+    mdv_predicate_range range;
+
+    mdv_predicate *predicate = mdv_predicate_parse(&mdv_test_predicate_desc, "id >= 10 AND 20 > id AND active");
+    mu_check(predicate);
+    mu_check(mdv_predicate_field_range(predicate, 0, &range));
+    mu_check(range.from.size == sizeof(int32_t) && *(int32_t const *)range.from.ptr == 10);
+    mu_check(range.to.size == sizeof(int32_t) && *(int32_t const *)range.to.ptr == 20);
+    mu_check(!mdv_predicate_field_range(predicate, 4, &range));
+    mdv_predicate_release(predicate);
+
+    predicate = mdv_predicate_parse(&mdv_test_predicate_desc, "(id = 1 OR id = 2) AND name = 'bear'");
+    mu_check(predicate);
+    mu_check(!mdv_predicate_field_range(predicate, 0, &range));
+    mu_check(mdv_predicate_field_range(predicate, 1, &range));
+    mu_check(range.from.ptr == range.to.ptr && range.from.size == 4);
+    mu_check(memcmp(range.from.ptr, "bear", 4) == 0);
+    mdv_predicate_release(predicate);
+
+    predicate = mdv_predicate_parse(&mdv_test_predicate_desc, "id = 1 OR name = 'bear'");
+    mu_check(predicate);
+    mu_check(!mdv_predicate_field_range(predicate, 0, &range));
+    mu_check(!mdv_predicate_field_range(predicate, 1, &range));
+    mdv_predicate_release(predicate);
+}
+
+
 MU_TEST(storage_predicate)
 {
     mdv_storage_predicate_test_0();
+    mdv_storage_predicate_test_1();
+    mdv_storage_predicate_test_2();
+    mdv_storage_predicate_test_3();
+    mdv_storage_predicate_test_4();
 }
@@ -10,16 +10,70 @@
 #include <string.h>
 
 
+static void mdv_op_select_predicate()
+{
+    static mdv_field const fields[] =
+    {
+        { MDV_FLD_TYPE_UINT32, 1, "c0" },
+        { MDV_FLD_TYPE_UINT32, 1, "c1" },
+        { MDV_FLD_TYPE_UINT32, 1, "c2" },
+    };
+
+    static mdv_table_desc const desc =
+    {
+        .name = "select_test",
+        .size = sizeof fields / sizeof *fields,
+        .fields = fields
+    };
+
+    mdv_list table = {};
+
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        binn *row = create_test_row(3, i);
+        mdv_list_push_back_data(&table, binn_ptr(row), binn_size(row));
+        binn_free(row);
+    }
+
+    mdv_op *scanner = mdv_scan_list(&table);
+    mu_check(scanner);
+
+    mdv_predicate *predicate = mdv_predicate_parse(&desc, "c0 = 3 OR c2 = 9");
+    mu_check(predicate);
+
+    mdv_op * select = mdv_select(scanner, predicate, 256);
+    mu_check(select);
+
+    mdv_predicate_release(predicate);
+    mdv_op_release(scanner);
+
+    mdv_kvdata kvdata;
+
+    size_t const expected[] = { 3, 7 };
+
+    for(size_t i = 0; i < sizeof expected / sizeof *expected; ++i)
+    {
+        mu_check(mdv_op_next(select, &kvdata) == MDV_OK);
+        mu_check(*(size_t*)kvdata.key.ptr == expected[i]);
+    }
+
+    mu_check(mdv_op_next(select, &kvdata) == MDV_FALSE);
+
+    mdv_list_clear(&table);
+    mdv_op_release(select);
+}
+
+
 MU_TEST(op_select)
 {
     mdv_list table = create_test_rows_list(10, 10);
     mdv_op *scanner = mdv_scan_list(&table);
     mu_check(scanner);
 
-    mdv_predicate *predicate = mdv_predicate_parse("");
+    mdv_predicate *predicate = mdv_predicate_parse(0, "");
     mu_check(predicate);
 
-    mdv_op * select = mdv_select(scanner, predicate);
+    mdv_op * select = mdv_select(scanner, predicate, 256);
     mu_check(select);
 
     mdv_predicate_release(predicate);
@@ -58,5 +112,7 @@ MU_TEST(op_select)
 
     mdv_list_clear(&table);
     mdv_op_release(select);
+
+    mdv_op_select_predicate();
 }
 
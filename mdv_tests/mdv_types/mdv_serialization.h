@@ -33,7 +33,12 @@ static void test_table_serialization()
     {
         .name = "my_table",
         .size = 3,
-        .fields = fields
+        .fields = fields,
+        .partitioned = true,
+        .partition_key = 2,
+        .replicas = 1,
+        .members_size = 2,
+        .members = (mdv_uuid[]) { { .u64 = { 3, 4 } }, { .u64 = { 5, 6 } } }
     };
 
     mdv_uuid uuid = { .u64 = { 1, 2 } };
@@ -52,6 +57,13 @@ static void test_table_serialization()
 
     mu_check(deserialized_desc->size == desc.size);
     mu_check(strcmp(deserialized_desc->name, desc.name) == 0);
+    mu_check(deserialized_desc->partitioned);
+    mu_check(deserialized_desc->partition_key == desc.partition_key);
+    mu_check(deserialized_desc->replicas == desc.replicas);
+    mu_check(deserialized_desc->members_size == desc.members_size);
+
+    for(uint32_t i = 0; i < desc.members_size; ++i)
+        mu_check(mdv_uuid_cmp(deserialized_desc->members + i, desc.members + i) == 0);
 
     for(uint32_t i = 0; i < desc.size; ++i)
     {
@@ -183,10 +195,89 @@ static void test_row_slice_serialization()
 }
 
 
+static void test_row_arrays_serialization()
+{
+    mdv_field fields[] =
+    {
+        { MDV_FLD_TYPE_INT32,  0, "col1" },
+        { MDV_FLD_TYPE_UINT64, 2, "col2" }
+    };
+
+    mdv_table_desc desc =
+    {
+        .name = "MyTable",
+        .size = 2,
+        .fields = fields
+    };
+
+    int32_t const i32[] = { -1, 2, 0x01020304 };
+    uint64_t const u64[] = { 0x1122334455667788, 42 };
+
+    mdv_data const row[] = { { sizeof i32, (void*)i32 }, { sizeof u64, (void*)u64 } };
+
+    // Packed arrays
+    binn serialized_row;
+
+    mu_check(mdv_binn_row((mdv_row const *)row, &desc, &serialized_row));
+
+    binn value;
+    mu_check(binn_list_get_value(&serialized_row, 1, &value));
+    mu_check(value.type == BINN_BLOB);
+    mu_check(binn_size(&value) == 1 + sizeof i32);
+
+    mdv_rowlist_entry *rowlist_entry = mdv_unbinn_row(&serialized_row, &desc);
+    mu_check(rowlist_entry);
+
+    for(uint32_t i = 0; i < desc.size; ++i)
+    {
+        mu_check(rowlist_entry->data.fields[i].size == row[i].size);
+        mu_check(memcmp(rowlist_entry->data.fields[i].ptr, row[i].ptr, row[i].size) == 0);
+    }
+
+    uint32_t items[2] = {};
+    uint32_t count = 2;
+    mu_check(mdv_unbinn_array(&value, MDV_FLD_TYPE_INT32, items, &count));
+    mu_check(count == 2);
+    mu_check(memcmp(items, i32, sizeof items) == 0);
+
+    mdv_free(rowlist_entry);
+    binn_free(&serialized_row);
+
+    // Rows serialized as lists of values are still supported
+    binn *legacy_row = binn_list();
+    binn *arr1 = binn_list();
+    binn *arr2 = binn_list();
+
+    for(size_t i = 0; i < sizeof i32 / sizeof *i32; ++i)
+        mu_check(binn_list_add_int32(arr1, i32[i]));
+
+    for(size_t i = 0; i < sizeof u64 / sizeof *u64; ++i)
+        mu_check(binn_list_add_uint64(arr2, u64[i]));
+
+    mu_check(binn_list_add_list(legacy_row, arr1));
+    mu_check(binn_list_add_list(legacy_row, arr2));
+
+    rowlist_entry = mdv_unbinn_row(legacy_row, &desc);
+    mu_check(rowlist_entry);
+
+    for(uint32_t i = 0; i < desc.size; ++i)
+    {
+        mu_check(rowlist_entry->data.fields[i].size == row[i].size);
+        mu_check(memcmp(rowlist_entry->data.fields[i].ptr, row[i].ptr, row[i].size) == 0);
+    }
+
+    mdv_free(rowlist_entry);
+    binn_free(arr1);
+    binn_free(arr2);
+    binn_free(legacy_row);
+}
+
+
 MU_TEST(types_serialization)
 {
     test_uuid_serialization();
     test_table_serialization();
     test_rowset_serialization();
     test_row_slice_serialization();
+    test_row_arrays_serialization();
 }
@@ -19,5 +19,10 @@ MU_TEST(types_table_desc)
     mu_check(mdv_table_desc_append(desc, fields + 1));
     mu_check(mdv_table_desc_append(desc, fields + 2));
 
+    mu_check(!desc->partitioned);
+    mu_check(!mdv_table_desc_partition(desc, 3));
+    mu_check(mdv_table_desc_partition(desc, 1));
+    mu_check(desc->partitioned && desc->partition_key == 1);
+
     mdv_table_desc_free(desc);
 }
@@ -210,6 +210,93 @@ bool mdv_binn_table_desc(mdv_table_desc const *table, binn *obj)
 
     binn_free(&fields);
 
+    if (table->indexes_size)
+    {
+        binn indexes;
+
+        if (!binn_create_list(&indexes))
+        {
+            MDV_LOGE("binn_table_desc failed");
+            binn_free(obj);
+            return false;
+        }
+
+        for(uint32_t i = 0; i < table->indexes_size; ++i)
+        {
+            if (!binn_list_add_uint32(&indexes, table->indexes[i]))
+            {
+                MDV_LOGE("binn_table_desc failed");
+                binn_free(&indexes);
+                binn_free(obj);
+                return false;
+            }
+        }
+
+        if (!binn_object_set_list(obj, "I", &indexes))
+        {
+            MDV_LOGE("binn_table_desc failed");
+            binn_free(&indexes);
+            binn_free(obj);
+            return false;
+        }
+
+        binn_free(&indexes);
+    }
+
+    if (table->partitioned
+        && !binn_object_set_uint32(obj, "K", table->partition_key))
+    {
+        MDV_LOGE("binn_table_desc failed");
+        binn_free(obj);
+        return false;
+    }
+
+    if (table->members_size)
+    {
+        binn members;
+
+        if (!binn_create_list(&members))
+        {
+            MDV_LOGE("binn_table_desc failed");
+            binn_free(obj);
+            return false;
+        }
+
+        for(uint32_t i = 0; i < table->members_size; ++i)
+        {
+            binn member;
+
+            if (!mdv_binn_uuid(table->members + i, &member))
+            {
+                binn_free(&members);
+                binn_free(obj);
+                return false;
+            }
+
+            if (!binn_list_add_object(&members, &member))
+            {
+                MDV_LOGE("binn_table_desc failed");
+                binn_free(&member);
+                binn_free(&members);
+                binn_free(obj);
+                return false;
+            }
+
+            binn_free(&member);
+        }
+
+        if (!binn_object_set_uint32(obj, "R", table->replicas)
+            || !binn_object_set_list(obj, "M", &members))
+        {
+            MDV_LOGE("binn_table_desc failed");
+            binn_free(&members);
+            binn_free(obj);
+            return false;
+        }
+
+        binn_free(&members);
+    }
+
     return true;
 }
 
@@ -232,11 +319,38 @@ mdv_table_desc * mdv_unbinn_table_desc(binn const *obj)
 
     size_t const table_name_size = strlen(name) + 1;
 
+    // Secondary indexes are optional
+    binn *binn_indexes = 0;
+    uint32_t indexes_count = 0;
+
+    if (binn_object_get_list((void*)obj, "I", (void**)&binn_indexes))
+        indexes_count = mdv_binn_list_length(binn_indexes);
+
+    // Placement members are optional
+    binn *binn_members = 0;
+    uint32_t members_count = 0;
+    uint32_t replicas = 0;
+
+    if (binn_object_get_list((void*)obj, "M", (void**)&binn_members))
+    {
+        members_count = mdv_binn_list_length(binn_members);
+
+        if (!binn_object_get_uint32((void*)obj, "R", &replicas)
+            || !replicas
+            || replicas >= members_count)
+        {
+            MDV_LOGE("unbinn_table_desc failed");
+            return 0;
+        }
+    }
+
     binn_iter iter = {};
     binn value = {};
 
     // Calculate size
     uint32_t size = sizeof(mdv_table_desc) + fields_count * sizeof(mdv_field)
+                    + members_count * sizeof(mdv_uuid)
+                    + indexes_count * sizeof(uint32_t)
                     + table_name_size;
 
     binn_list_foreach(binn_fields, value)
@@ -262,12 +376,63 @@ mdv_table_desc * mdv_unbinn_table_desc(binn const *obj)
     }
 
     table->size = fields_count;
+    table->dynamic_alloc = false;
 
     mdv_field *fields = (mdv_field *)(table + 1);
 
     table->fields = fields;
 
-    char *buff = (char *)(fields + table->size);
+    mdv_uuid *members = (mdv_uuid *)(fields + table->size);
+
+    table->replicas = replicas;
+    table->members_size = members_count;
+    table->members = members;
+
+    if (members_count)
+    {
+        uint32_t n = 0;
+
+        binn_list_foreach(binn_members, value)
+        {
+            if (n >= members_count
+                || !mdv_unbinn_uuid(&value, members + n++))
+            {
+                MDV_LOGE("unbinn_table_desc failed");
+                mdv_free(table);
+                return 0;
+            }
+        }
+    }
+
+    uint32_t *indexes = (uint32_t *)(members + members_count);
+
+    table->indexes_size = indexes_count;
+    table->indexes = indexes;
+
+    for(uint32_t i = 0; i < indexes_count; ++i)
+    {
+        if (!binn_list_get_uint32(binn_indexes, i + 1, indexes + i)
+            || indexes[i] >= fields_count)
+        {
+            MDV_LOGE("unbinn_table_desc failed");
+            mdv_free(table);
+            return 0;
+        }
+    }
+
+    // Partition key is optional
+    table->partitioned = binn_object_get_uint32((void*)obj, "K", &table->partition_key);
+
+    if (!table->partitioned)
+        table->partition_key = 0;
+    else if (table->partition_key >= fields_count)
+    {
+        MDV_LOGE("unbinn_table_desc failed");
+        mdv_free(table);
+        return 0;
+    }
+
+    char *buff = (char *)(indexes + indexes_count);
 
     memcpy(buff, name, table_name_size);
     table->name = buff;
@@ -520,6 +685,139 @@ bool mdv_unbinn_table_uuid(binn const *obj, mdv_uuid *uuid)
 }
 
 
+/// Packed array format version
+#define MDV_PACKED_ARRAY_V1 1
+
+
+/// Copies array items converting them from host to little-endian order and vice versa.
+static void mdv_packed_array_copy(void *dst, void const *src, uint32_t type_size, uint32_t count)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    uint8_t *d = dst;
+    uint8_t const *s = src;
+
+    for(uint32_t i = 0; i < count; ++i, d += type_size, s += type_size)
+    {
+        for(uint32_t j = 0; j < type_size; ++j)
+            d[j] = s[type_size - j - 1];
+    }
+#else
+    memcpy(dst, src, (size_t)type_size * count);
+#endif
+}
+
+
+/// Serializes array of fixed size items as blob [version:1][items in little-endian order]
+static bool mdv_binn_packed_array(binn *list, void const *items, uint32_t type_size, uint32_t count)
+{
+    size_t const size = 1 + (size_t)type_size * count;
+
+    uint8_t buf[256];
+    uint8_t *packed = size <= sizeof buf ? buf : mdv_alloc(size);
+
+    if (!packed)
+    {
+        MDV_LOGE("No memory for packed array");
+        return false;
+    }
+
+    packed[0] = MDV_PACKED_ARRAY_V1;
+    mdv_packed_array_copy(packed + 1, items, type_size, count);
+
+    bool const res = binn_list_add_blob(list, packed, (int)size);
+
+    if (packed != buf)
+        mdv_free(packed);
+
+    return res;
+}
+
+
+bool mdv_unbinn_array_size(binn *value, mdv_field_type type, uint32_t *count)
+{
+    uint32_t const type_size = mdv_field_type_size(type);
+
+    switch(value->type)
+    {
+        case BINN_BLOB:
+        {
+            int const size = binn_size(value);
+            uint8_t const *packed = binn_ptr(value);
+
+            if (size < 1
+                || !packed
+                || packed[0] != MDV_PACKED_ARRAY_V1
+                || !type_size
+                || (size - 1) % type_size)
+            {
+                MDV_LOGE("Invalid packed array");
+                return false;
+            }
+
+            *count = (size - 1) / type_size;
+            return true;
+        }
+
+        case BINN_LIST:
+        {
+            // Rows serialized before the packed format was introduced
+            *count = mdv_binn_list_length(value);
+            return true;
+        }
+
+        default:
+            break;
+    }
+
+    MDV_LOGE("Invalid array type: %d", value->type);
+
+    return false;
+}
+
+
+bool mdv_unbinn_array(binn *value, mdv_field_type type, void *items, uint32_t *count)
+{
+    uint32_t const type_size = mdv_field_type_size(type);
+
+    uint32_t size = 0;
+
+    if (!mdv_unbinn_array_size(value, type, &size))
+        return false;
+
+    if (size > *count)
+        size = *count;
+
+    if (value->type == BINN_BLOB)
+    {
+        mdv_packed_array_copy(items, (uint8_t const *)binn_ptr(value) + 1, type_size, size);
+        *count = size;
+        return true;
+    }
+
+    binn_iter iter = {};
+    binn item = {};
+    uint32_t n = 0;
+
+    binn_list_foreach(value, item)
+    {
+        if (n >= size)
+            break;
+
+        if (!binn_get(&item, type, (char *)items + n * type_size))
+        {
+            MDV_LOGE("Invalid array item");
+            return false;
+        }
+
+        ++n;
+    }
+
+    *count = n;
+
+    return true;
+}
+
+
 bool mdv_binn_row(mdv_row const *row, mdv_table_desc const *table_desc, binn *list)
 {
     if (!binn_create_list(list))
@@ -564,24 +862,7 @@ bool mdv_binn_row(mdv_row const *row, mdv_table_desc const *table_desc, binn *li
         else if (field_type_size == 1)
             res = binn_list_add_blob(list, row->fields[i].ptr, arr_size);
         else
-        {
-            binn *field_items = binn_list();
-
-            if (!field_items)
-            {
-                MDV_LOGE("binn_row failed");
-                binn_free(list);
-                return false;
-            }
-
-            for(uint32_t j = 0; res && j < arr_size; ++j)
-                res = binn_add_to_list(field_items, fields[i].type, (char const *)row->fields[i].ptr + j * field_type_size);
-
-            if (res)
-                res = binn_list_add_list(list, field_items);
-
-            binn_free(field_items);
-        }
+            res = mdv_binn_packed_array(list, row->fields[i].ptr, field_type_size, arr_size);
 
         if(!res)
         {
@@ -638,7 +919,14 @@ static size_t mdv_calc_row_size(binn const           *list,
             row_size += blob_size;
         }
         else
-            row_size += field_type_size * mdv_binn_list_length(&value);
+        {
+            uint32_t arr_size = 0;
+
+            if (!mdv_unbinn_array_size(&value, fields[n].type, &arr_size))
+                return 0;
+
+            row_size += field_type_size * arr_size;
+        }
 
         ++n;
         ++*fields_count;
@@ -658,6 +946,12 @@ static size_t mdv_calc_row_size(binn const           *list,
 }
 
 
+bool mdv_unbinn_field_value(binn *value, mdv_field_type type, void *data)
+{
+    return binn_get(value, type, data);
+}
+
+
 mdv_rowlist_entry * mdv_unbinn_row(binn const *list, mdv_table_desc const *table_desc)
 {
     return mdv_unbinn_row_slice(list, table_desc, 0);
@@ -731,28 +1025,18 @@ mdv_rowlist_entry * mdv_unbinn_row_slice(binn const *list,
         }
         else
         {
-            binn_iter arr_iter = {};
-            binn arr_value = {};
-            uint32_t arr_len = 0;
+            uint32_t arr_len = UINT32_MAX;
 
-            row->fields[field_idx].ptr = dataspace;
-
-            binn_iter_init(&arr_iter, &value, BINN_LIST);
-
-            while (binn_list_next(&arr_iter, &arr_value))
+            if (!mdv_unbinn_array(&value, fields[n].type, dataspace, &arr_len))
             {
-                if (!binn_get(&arr_value, fields[n].type, dataspace))
-                {
-                    MDV_LOGE("unbinn_table failed");
-                    mdv_free(row);
-                    return 0;
-                }
-
-                ++arr_len;
-                dataspace += field_type_size;
+                MDV_LOGE("unbinn_table failed");
+                mdv_free(entry);
+                return 0;
             }
 
             row->fields[field_idx].size = field_type_size * arr_len;
+            row->fields[field_idx].ptr = dataspace;
+            dataspace += field_type_size * arr_len;
         }
 
         ++n;
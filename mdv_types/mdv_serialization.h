@@ -20,6 +20,36 @@ bool                mdv_unbinn_table_uuid(binn const *obj, mdv_uuid *uuid);
 bool                mdv_binn_row(mdv_row const *row, mdv_table_desc const *table_desc, binn *list);
 mdv_rowlist_entry * mdv_unbinn_row(binn const *list, mdv_table_desc const *table_desc);
 mdv_rowlist_entry * mdv_unbinn_row_slice(binn const *list, mdv_table_desc const *table_desc, mdv_bitset const *mask);
+bool                mdv_unbinn_field_value(binn *value, mdv_field_type type, void *data);
+
+
+/**
+ * @brief Returns the number of items in serialized array of fixed size items.
+ * @details Both packed (little-endian blob) and legacy (list of values) array formats are supported.
+ *
+ * @param value [in]    serialized array
+ * @param type [in]     array items type
+ * @param count [out]   number of items
+ *
+ * @return On success returns true.
+ * @return On error returns false.
+ */
+bool                mdv_unbinn_array_size(binn *value, mdv_field_type type, uint32_t *count);
+
+
+/**
+ * @brief Deserializes array of fixed size items.
+ * @details Packed arrays are copied by single memcpy on little-endian hosts.
+ *
+ * @param value [in]        serialized array
+ * @param type [in]         array items type
+ * @param items [out]       destination buffer
+ * @param count [in, out]   destination buffer capacity (in items) on input and number of deserialized items on output
+ *
+ * @return On success returns true.
+ * @return On error returns false.
+ */
+bool                mdv_unbinn_array(binn *value, mdv_field_type type, void *items, uint32_t *count);
 
 bool                mdv_binn_rowset(mdv_rowset *rowset, binn *list);
 mdv_rowset *        mdv_unbinn_rowset(binn const *list, mdv_table *table);
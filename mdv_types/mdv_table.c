@@ -36,6 +36,11 @@ static size_t mdv_table_size(mdv_table_desc const *desc, mdv_bitset const *mask,
             + strlen(desc->name) + 1
             + *fields_count * sizeof(mdv_field);
 
+    // Secondary indexes and placement members are not copied into table slices
+    if (!mask)
+        size += desc->indexes_size * sizeof(uint32_t)
+                + desc->members_size * sizeof(mdv_uuid);
+
     return size;
 }
 
@@ -60,10 +65,35 @@ static mdv_table * mdv_table_create_impl(mdv_uuid const       *id,
 
     mdv_field *fields = (mdv_field *)(table + 1);
 
-    char *strings = (char*)(fields + fields_count);
+    mdv_uuid *members = (mdv_uuid *)(fields + fields_count);
+
+    uint32_t const members_size = mask ? 0 : desc->members_size;
+
+    uint32_t *indexes = (uint32_t *)(members + members_size);
+
+    uint32_t const indexes_size = mask ? 0 : desc->indexes_size;
+
+    char *strings = (char*)(indexes + indexes_size);
 
     table->id = *id;
 
+    table->desc.dynamic_alloc = false;
+    table->desc.indexes_size = indexes_size;
+    table->desc.indexes = indexes;
+
+    // Fields are renumbered in table slices, so the partition key is kept only for the whole table
+    table->desc.partitioned = mask ? false : desc->partitioned;
+    table->desc.partition_key = mask ? 0 : desc->partition_key;
+    table->desc.replicas = mask ? 0 : desc->replicas;
+    table->desc.members_size = members_size;
+    table->desc.members = members;
+
+    if (members_size)
+        memcpy(members, desc->members, members_size * sizeof(mdv_uuid));
+
+    if (indexes_size)
+        memcpy(indexes, desc->indexes, indexes_size * sizeof(uint32_t));
+
     size_t const table_name_size = strlen(desc->name) + 1;
     memcpy(strings, desc->name, table_name_size);
     table->desc.name = strings;
@@ -18,6 +18,10 @@
 typedef struct mdv_table mdv_table;
 
 
+/// Table descriptor pointer (used for the descriptors vectors)
+typedef mdv_table * mdv_table_ptr;
+
+
 /**
  * @brief Create new table desriptor
  *
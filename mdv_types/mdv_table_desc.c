@@ -8,11 +8,12 @@
 
 mdv_table_desc * mdv_table_desc_create(char const *name)
 {
-    mdv_rollbacker *rollbacker = mdv_rollbacker_create(2);
+    mdv_rollbacker *rollbacker = mdv_rollbacker_create(3);
 
     size_t const desc_size = sizeof(mdv_table_desc)
                                 + sizeof(mdv_vector*)
-                                + sizeof(mdv_list);
+                                + sizeof(mdv_list)
+                                + sizeof(mdv_vector*);
 
     mdv_table_desc *desc = mdv_alloc(desc_size);
 
@@ -42,6 +43,19 @@ mdv_table_desc * mdv_table_desc_create(char const *name)
 
     mdv_list *strings = (mdv_list *)(ppfields + 1);
 
+    mdv_vector **ppindexes = (mdv_vector**)(strings + 1);
+
+    *ppindexes = mdv_vector_create(2, sizeof(uint32_t), &mdv_default_allocator);
+
+    if (!*ppindexes)
+    {
+        MDV_LOGE("No memory for indexes vector");
+        mdv_rollback(rollbacker);
+        return 0;
+    }
+
+    mdv_rollbacker_push(rollbacker, mdv_vector_release, *ppindexes);
+
     mdv_list_entry_base *tbl_name = mdv_list_push_back_data(strings, name, strlen(name) + 1);
 
     if(!tbl_name)
@@ -57,6 +71,13 @@ mdv_table_desc * mdv_table_desc_create(char const *name)
     desc->size          = 0;
     desc->dynamic_alloc = true;
     desc->fields        = mdv_vector_data(*ppfields);
+    desc->indexes_size  = 0;
+    desc->indexes       = mdv_vector_data(*ppindexes);
+    desc->partitioned   = false;
+    desc->partition_key = 0;
+    desc->replicas      = 0;
+    desc->members_size  = 0;
+    desc->members       = 0;
 
     return desc;
 }
@@ -68,7 +89,9 @@ void mdv_table_desc_free(mdv_table_desc *desc)
     {
         mdv_vector **ppfields = (mdv_vector**)(desc + 1);
         mdv_list *strings = (mdv_list *)(ppfields + 1);
+        mdv_vector **ppindexes = (mdv_vector**)(strings + 1);
         mdv_vector_release(*ppfields);
+        mdv_vector_release(*ppindexes);
         mdv_list_clear(strings);
         mdv_free(desc);
     }
@@ -110,3 +133,61 @@ bool mdv_table_desc_append(mdv_table_desc *desc, mdv_field const *field)
 
     return true;
 }
+
+
+bool mdv_table_desc_index(mdv_table_desc *desc, uint32_t field)
+{
+    if (!desc->dynamic_alloc)
+    {
+        MDV_LOGE("Table description isn't extendable");
+        return false;
+    }
+
+    if (field >= desc->size)
+    {
+        MDV_LOGE("Invalid field for index");
+        return false;
+    }
+
+    mdv_vector **ppfields = (mdv_vector**)(desc + 1);
+    mdv_list *strings = (mdv_list *)(ppfields + 1);
+    mdv_vector **ppindexes = (mdv_vector**)(strings + 1);
+
+    for(uint32_t i = 0; i < desc->indexes_size; ++i)
+    {
+        if (desc->indexes[i] == field)
+            return true;
+    }
+
+    if (!mdv_vector_push_back(*ppindexes, &field))
+    {
+        MDV_LOGE("No memory for new index");
+        return false;
+    }
+
+    desc->indexes_size = (uint32_t)mdv_vector_size(*ppindexes);
+    desc->indexes = mdv_vector_data(*ppindexes);
+
+    return true;
+}
+
+
+bool mdv_table_desc_partition(mdv_table_desc *desc, uint32_t field)
+{
+    if (!desc->dynamic_alloc)
+    {
+        MDV_LOGE("Table description isn't extendable");
+        return false;
+    }
+
+    if (field >= desc->size)
+    {
+        MDV_LOGE("Invalid field for partition key");
+        return false;
+    }
+
+    desc->partitioned = true;
+    desc->partition_key = field;
+
+    return true;
+}
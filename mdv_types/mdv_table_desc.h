@@ -10,6 +10,7 @@
  */
 #pragma once
 #include "mdv_field.h"
+#include <mdv_uuid.h>
 
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -21,6 +22,13 @@ typedef struct mdv_table_desc
     uint32_t         size;          ///< Fields count
     bool             dynamic_alloc; ///< Flag indicates dynamic allocation
     mdv_field const *fields;        ///< Fields
+    uint32_t         indexes_size;  ///< Secondary indexes count
+    uint32_t const  *indexes;       ///< Secondary indexes (indexed fields numbers)
+    bool             partitioned;   ///< Flag indicates that rows are distributed between cluster nodes by partition key
+    uint32_t         partition_key; ///< Partition key field number
+    uint32_t         replicas;      ///< Number of members which store each partition
+    uint32_t         members_size;  ///< Placement members count (zero if all nodes store all rows)
+    mdv_uuid const  *members;       ///< Nodes which store the table partitions (fixed on the table creation)
 } mdv_table_desc;
 
 
@@ -40,3 +48,15 @@ void mdv_table_desc_free(mdv_table_desc *desc);
  * @brief Appends new fields to the end of fields array
   */
 bool mdv_table_desc_append(mdv_table_desc *desc, mdv_field const *field);
+
+
+/**
+ * @brief Appends new secondary index for given field
+ */
+bool mdv_table_desc_index(mdv_table_desc *desc, uint32_t field);
+
+
+/**
+ * @brief Sets partition key. Table rows are distributed between cluster nodes by hash of the partition key.
+ */
+bool mdv_table_desc_partition(mdv_table_desc *desc, uint32_t field);